@@ -0,0 +1,268 @@
+/**
+ * @file catalog_generator.h
+ * @brief TMS Tape Management System - Synthetic catalog generator
+ * @version 3.4.0
+ * @author Bennie Shearer
+ * @copyright Copyright (c) 2025 Bennie Shearer
+ * @license MIT License
+ *
+ * Builds reproducible catalogs for benchmarks. Owners, pools and tags are
+ * drawn from Zipf distributions so a few values dominate, as they do in
+ * production catalogs; expiration dates follow a selectable model. The
+ * random source and the samplers are implemented here rather than taken
+ * from <random>, whose distributions differ between standard libraries,
+ * so a given seed yields the same catalog on every platform.
+ */
+
+#ifndef TMS_CATALOG_GENERATOR_H
+#define TMS_CATALOG_GENERATOR_H
+
+#include "tms_tape_mgmt.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace tms {
+namespace bench {
+
+// ============================================================================
+// Deterministic Sampling
+// ============================================================================
+
+/**
+ * @brief SplitMix64 pseudo-random generator
+ */
+class SplitMix64 {
+public:
+    explicit SplitMix64(uint64_t seed) : state_(seed) {}
+    
+    uint64_t next() {
+        uint64_t z = (state_ += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+    
+    /// Uniform double in [0, 1)
+    double uniform() { return static_cast<double>(next() >> 11) * 0x1.0p-53; }
+    
+    /// Uniform integer in [0, n)
+    size_t below(size_t n) { return n > 0 ? static_cast<size_t>(next() % n) : 0; }
+    
+private:
+    uint64_t state_;
+};
+
+/**
+ * @brief Zipf sampler over ranks [0, n); exponent 0 is uniform
+ */
+class ZipfSampler {
+public:
+    ZipfSampler(size_t n, double exponent) : cdf_(std::max<size_t>(n, 1)) {
+        double total = 0.0;
+        for (size_t i = 0; i < cdf_.size(); i++) {
+            total += 1.0 / std::pow(static_cast<double>(i + 1), exponent);
+            cdf_[i] = total;
+        }
+        for (auto& c : cdf_) c /= total;
+    }
+    
+    size_t sample(SplitMix64& rng) const {
+        auto it = std::upper_bound(cdf_.begin(), cdf_.end(), rng.uniform());
+        return std::min(static_cast<size_t>(it - cdf_.begin()), cdf_.size() - 1);
+    }
+    
+private:
+    std::vector<double> cdf_;
+};
+
+// ============================================================================
+// Catalog Specification
+// ============================================================================
+
+/**
+ * @brief How expiration dates are spread over the catalog
+ */
+enum class ExpirationModel {
+    NONE,           ///< Leave unset (TMSSystem applies its one-year default)
+    UNIFORM,        ///< Uniform over expiration_days
+    EXPONENTIAL,    ///< Exponential with mean expiration_days
+    BIMODAL         ///< Short-term backups plus long-term archives
+};
+
+inline const char* expiration_model_name(ExpirationModel model) {
+    switch (model) {
+        case ExpirationModel::NONE: return "none";
+        case ExpirationModel::UNIFORM: return "uniform";
+        case ExpirationModel::EXPONENTIAL: return "exponential";
+        case ExpirationModel::BIMODAL: return "bimodal";
+    }
+    return "none";
+}
+
+inline ExpirationModel parse_expiration_model(const std::string& name) {
+    if (name == "uniform") return ExpirationModel::UNIFORM;
+    if (name == "exponential") return ExpirationModel::EXPONENTIAL;
+    if (name == "bimodal") return ExpirationModel::BIMODAL;
+    return ExpirationModel::NONE;
+}
+
+/**
+ * @brief Shape of a synthetic catalog
+ */
+struct CatalogSpec {
+    size_t volumes = 10000;
+    size_t datasets = 20000;
+    size_t owners = 50;
+    size_t pools = 8;
+    size_t tags = 20;
+    size_t max_tags_per_volume = 3;
+    double owner_skew = 1.0;                ///< Zipf exponent (0 = uniform)
+    double pool_skew = 0.8;
+    double tag_skew = 1.2;
+    double scratch_fraction = 0.3;          ///< Volumes left in SCRATCH
+    ExpirationModel expiration = ExpirationModel::EXPONENTIAL;
+    int expiration_days = 365;              ///< Mean or range of the model
+    double expired_fraction = 0.05;         ///< Records already past expiration
+    uint64_t seed = 42;
+    std::chrono::system_clock::time_point epoch = std::chrono::system_clock::now();
+};
+
+// ============================================================================
+// Catalog Generator
+// ============================================================================
+
+/**
+ * @brief Generates volumes and datasets for a CatalogSpec
+ *
+ * Record contents depend only on the spec; timestamps are offsets from
+ * spec.epoch.
+ */
+class CatalogGenerator {
+public:
+    explicit CatalogGenerator(CatalogSpec spec)
+        : spec_(std::move(spec)),
+          owners_(spec_.owners, spec_.owner_skew),
+          pools_(spec_.pools, spec_.pool_skew),
+          tags_(spec_.tags, spec_.tag_skew) {}
+    
+    const CatalogSpec& spec() const { return spec_; }
+    
+    /// Volume serial for index @p i: 'V' plus five base-36 digits
+    static std::string volser(size_t i) {
+        static constexpr char DIGITS[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+        std::string out(6, '0');
+        out[0] = 'V';
+        for (size_t pos = 5; pos > 0; pos--) {
+            out[pos] = DIGITS[i % 36];
+            i /= 36;
+        }
+        return out;
+    }
+    
+    static std::string owner_name(size_t rank) { return "OWN" + std::to_string(rank); }
+    static std::string pool_name(size_t rank) { return "POOL" + std::to_string(rank); }
+    static std::string tag_name(size_t rank) { return "tag" + std::to_string(rank); }
+    
+    std::vector<TapeVolume> volumes() const {
+        SplitMix64 rng(spec_.seed);
+        std::vector<TapeVolume> out;
+        out.reserve(spec_.volumes);
+        for (size_t i = 0; i < spec_.volumes; i++) {
+            TapeVolume vol;
+            vol.volser = volser(i);
+            vol.owner = owner_name(owners_.sample(rng));
+            vol.pool = pool_name(pools_.sample(rng));
+            vol.location = "SLOT" + std::to_string(rng.below(5000));
+            vol.density = static_cast<TapeDensity>(
+                static_cast<int>(TapeDensity::DENSITY_LTO3) + static_cast<int>(rng.below(5)));
+            vol.status = rng.uniform() < spec_.scratch_fraction ? VolumeStatus::SCRATCH
+                                                                : VolumeStatus::PRIVATE;
+            vol.creation_date = spec_.epoch - std::chrono::hours(24 * static_cast<int64_t>(rng.below(1095)));
+            vol.expiration_date = expiration(rng);
+            vol.mount_count = static_cast<int>(rng.below(500));
+            size_t tag_count = rng.below(spec_.max_tags_per_volume + 1);
+            for (size_t t = 0; t < tag_count && spec_.tags > 0; t++) {
+                vol.tags.insert(tag_name(tags_.sample(rng)));
+            }
+            out.push_back(std::move(vol));
+        }
+        return out;
+    }
+    
+    /// Datasets spread over the PRIVATE volumes of @p volumes
+    std::vector<Dataset> datasets(const std::vector<TapeVolume>& volumes) const {
+        std::vector<const TapeVolume*> owned;
+        for (const auto& vol : volumes) {
+            if (vol.status == VolumeStatus::PRIVATE) owned.push_back(&vol);
+        }
+        
+        SplitMix64 rng(spec_.seed ^ 0x5DEECE66DULL);
+        std::vector<Dataset> out;
+        if (owned.empty()) return out;
+        out.reserve(spec_.datasets);
+        for (size_t i = 0; i < spec_.datasets; i++) {
+            const TapeVolume& vol = *owned[rng.below(owned.size())];
+            Dataset ds;
+            ds.name = vol.owner + ".BENCH.D" + std::to_string(i);
+            ds.volser = vol.volser;
+            ds.owner = vol.owner;
+            ds.job_name = "JOB" + std::to_string(rng.below(1000));
+            ds.size_bytes = static_cast<size_t>(1 + rng.below(1ULL << 30));
+            ds.record_format = "FB";
+            ds.block_size = 32760;
+            ds.record_length = 80;
+            ds.creation_date = vol.creation_date;
+            ds.expiration_date = expiration(rng);
+            if (spec_.tags > 0 && rng.below(4) == 0) ds.tags.insert(tag_name(tags_.sample(rng)));
+            out.push_back(std::move(ds));
+        }
+        return out;
+    }
+    
+    /**
+     * @brief Load a generated catalog through the bulk insert path
+     * @return Number of records added
+     */
+    size_t populate(TMSSystem& sys) const {
+        auto vols = volumes();
+        auto dsns = datasets(vols);
+        return sys.bulk_add_volumes(vols).succeeded + sys.bulk_add_datasets(dsns).succeeded;
+    }
+    
+private:
+    std::chrono::system_clock::time_point expiration(SplitMix64& rng) const {
+        using hours = std::chrono::hours;
+        double u = rng.uniform();
+        if (rng.uniform() < spec_.expired_fraction) {
+            return spec_.epoch - hours(1 + static_cast<int64_t>(u * 24 * 30));
+        }
+        double days = static_cast<double>(std::max(spec_.expiration_days, 1));
+        switch (spec_.expiration) {
+            case ExpirationModel::NONE:
+                return {};
+            case ExpirationModel::UNIFORM:
+                return spec_.epoch + hours(1 + static_cast<int64_t>(u * days * 24));
+            case ExpirationModel::EXPONENTIAL:
+                return spec_.epoch + hours(1 + static_cast<int64_t>(-std::log1p(-u) * days * 24));
+            case ExpirationModel::BIMODAL:
+                // Two thirds short-lived backups, one third seven-year archives
+                if (u < 2.0 / 3.0) return spec_.epoch + hours(1 + static_cast<int64_t>(u * 1.5 * 30 * 24));
+                return spec_.epoch + hours(24 * 7 * 365 + static_cast<int64_t>((u - 2.0 / 3.0) * 3 * days * 24));
+        }
+        return {};
+    }
+    
+    CatalogSpec spec_;
+    ZipfSampler owners_;
+    ZipfSampler pools_;
+    ZipfSampler tags_;
+};
+
+} // namespace bench
+} // namespace tms
+
+#endif // TMS_CATALOG_GENERATOR_H
@@ -0,0 +1,315 @@
+/**
+ * @file json_benchmark.cpp
+ * @brief TMS Tape Management System - JSON representation benchmark
+ * @version 3.4.0
+ * @author Bennie Shearer
+ * @copyright Copyright (c) 2025 Bennie Shearer
+ * @license MIT License
+ *
+ * Compares memory use and parse/serialise throughput of the pre-3.4.0
+ * JsonValue layout against the compact tagged-union JsonValue, the
+ * arena-backed JsonDocument and the streaming JsonReader/JsonWriter,
+ * all on the same exported catalog.
+ *
+ * Memory figures are heap bytes still held after the operation, i.e. the
+ * size of the resulting tree (or zero for streaming paths).
+ *
+ * Usage: json_benchmark [volume_count]
+ */
+
+#include "tms_json.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <malloc.h>
+
+// ============================================================================
+// Allocation Counting
+// ============================================================================
+
+static std::atomic<size_t> g_live_bytes{0};
+static std::atomic<size_t> g_alloc_count{0};
+
+static void* counted(void* p) {
+    if (!p) throw std::bad_alloc();
+    g_live_bytes += malloc_usable_size(p);
+    g_alloc_count++;
+    return p;
+}
+
+static void uncounted(void* p) noexcept {
+    if (p) g_live_bytes -= malloc_usable_size(p);
+    std::free(p);
+}
+
+void* operator new(size_t size) { return counted(std::malloc(size ? size : 1)); }
+void* operator new(size_t size, std::align_val_t align) {
+    size_t a = static_cast<size_t>(align);
+    return counted(std::aligned_alloc(a, (size + a - 1) / a * a));
+}
+void operator delete(void* p) noexcept { uncounted(p); }
+void operator delete(void* p, size_t) noexcept { uncounted(p); }
+void operator delete(void* p, std::align_val_t) noexcept { uncounted(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { uncounted(p); }
+
+// ============================================================================
+// Legacy Representation (v3.3.0 layout, kept for comparison)
+// ============================================================================
+
+namespace legacy {
+
+class Value;
+using Object = std::map<std::string, Value>;
+using Array = std::vector<Value>;
+
+class Value {
+public:
+    enum class Type { Null, Boolean, Number, String, Array, Object };
+    Type type_ = Type::Null;
+    bool bool_val_ = false;
+    double num_val_ = 0.0;
+    std::string str_val_;
+    legacy::Array arr_val_;
+    legacy::Object obj_val_;
+};
+
+static void skip_ws(const std::string& s, size_t& pos) {
+    while (pos < s.size() && std::isspace(static_cast<unsigned char>(s[pos]))) pos++;
+}
+
+static Value parse_value(const std::string& s, size_t& pos);
+
+static std::string parse_string(const std::string& s, size_t& pos) {
+    pos++;
+    std::string out;
+    while (pos < s.size() && s[pos] != '"') {
+        if (s[pos] == '\\') {
+            pos++;
+            switch (s[pos]) {
+                case 'n': out += '\n'; break;
+                case 't': out += '\t'; break;
+                case 'r': out += '\r'; break;
+                default: out += s[pos];
+            }
+        } else {
+            out += s[pos];
+        }
+        pos++;
+    }
+    pos++;
+    return out;
+}
+
+static Value parse_value(const std::string& s, size_t& pos) {
+    skip_ws(s, pos);
+    Value v;
+    char c = s[pos];
+    if (c == '{') {
+        v.type_ = Value::Type::Object;
+        pos++;
+        skip_ws(s, pos);
+        if (s[pos] == '}') { pos++; return v; }
+        while (true) {
+            skip_ws(s, pos);
+            std::string key = parse_string(s, pos);
+            skip_ws(s, pos);
+            pos++;  // ':'
+            v.obj_val_[key] = parse_value(s, pos);
+            skip_ws(s, pos);
+            if (s[pos++] == '}') break;
+        }
+    } else if (c == '[') {
+        v.type_ = Value::Type::Array;
+        pos++;
+        skip_ws(s, pos);
+        if (s[pos] == ']') { pos++; return v; }
+        while (true) {
+            v.arr_val_.push_back(parse_value(s, pos));
+            skip_ws(s, pos);
+            if (s[pos++] == ']') break;
+        }
+    } else if (c == '"') {
+        v.type_ = Value::Type::String;
+        v.str_val_ = parse_string(s, pos);
+    } else if (c == 't' || c == 'f') {
+        v.type_ = Value::Type::Boolean;
+        v.bool_val_ = (c == 't');
+        pos += v.bool_val_ ? 4 : 5;
+    } else if (c == 'n') {
+        pos += 4;
+    } else {
+        size_t start = pos;
+        while (pos < s.size() && (std::isdigit(static_cast<unsigned char>(s[pos])) ||
+               s[pos] == '-' || s[pos] == '.' || s[pos] == 'e' || s[pos] == 'E' || s[pos] == '+')) pos++;
+        v.type_ = Value::Type::Number;
+        v.num_val_ = std::stod(s.substr(start, pos - start));
+    }
+    return v;
+}
+
+static void serialize(std::ostream& os, const Value& v) {
+    switch (v.type_) {
+        case Value::Type::Null: os << "null"; break;
+        case Value::Type::Boolean: os << (v.bool_val_ ? "true" : "false"); break;
+        case Value::Type::Number: os << v.num_val_; break;
+        case Value::Type::String: os << '"' << v.str_val_ << '"'; break;
+        case Value::Type::Array: {
+            os << '[';
+            bool first = true;
+            for (const auto& e : v.arr_val_) { if (!first) os << ','; first = false; serialize(os, e); }
+            os << ']';
+            break;
+        }
+        case Value::Type::Object: {
+            os << '{';
+            bool first = true;
+            for (const auto& [k, e] : v.obj_val_) {
+                if (!first) os << ',';
+                first = false;
+                os << '"' << k << "\":";
+                serialize(os, e);
+            }
+            os << '}';
+            break;
+        }
+    }
+}
+
+} // namespace legacy
+
+// ============================================================================
+// Benchmark Driver
+// ============================================================================
+
+using namespace tms;
+using Clock = std::chrono::steady_clock;
+
+struct Measurement {
+    double seconds = 0.0;
+    size_t bytes_retained = 0;   ///< Heap still held when fn() returns
+    size_t allocations = 0;
+};
+
+template<typename Fn>
+static Measurement measure(Fn&& fn) {
+    size_t bytes_before = g_live_bytes.load();
+    size_t count_before = g_alloc_count.load();
+    auto start = Clock::now();
+    fn();
+    Measurement m;
+    m.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    size_t bytes_after = g_live_bytes.load();
+    m.bytes_retained = bytes_after > bytes_before ? bytes_after - bytes_before : 0;
+    m.allocations = g_alloc_count.load() - count_before;
+    return m;
+}
+
+static void report(const std::string& name, const Measurement& m, size_t input_bytes) {
+    double mb = static_cast<double>(input_bytes) / (1024.0 * 1024.0);
+    std::cout << "  " << std::left << std::setw(30) << name
+              << std::right << std::setw(10) << std::fixed << std::setprecision(1)
+              << (m.seconds > 0 ? mb / m.seconds : 0.0) << " MB/s"
+              << std::setw(14) << format_bytes(m.bytes_retained)
+              << std::setw(12) << m.allocations << " allocs\n";
+}
+
+int main(int argc, char* argv[]) {
+    size_t volume_count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20000;
+    
+    std::vector<TapeVolume> volumes;
+    std::vector<Dataset> datasets;
+    volumes.reserve(volume_count);
+    datasets.reserve(volume_count * 2);
+    for (size_t i = 0; i < volume_count; i++) {
+        TapeVolume v;
+        v.volser = "V" + std::to_string(100000 + i).substr(1);
+        v.pool = (i % 3 == 0) ? "PRODPOOL" : "TESTPOOL";
+        v.owner = "OWNER" + std::to_string(i % 50);
+        v.location = "VAULT-" + std::to_string(i % 7);
+        v.capacity_bytes = 12000ULL * 1024 * 1024 * 1024;
+        v.used_bytes = (i * 7919) % v.capacity_bytes;
+        v.mount_count = static_cast<int>(i % 400);
+        v.tags = {"backup", "tier" + std::to_string(i % 4)};
+        for (int d = 0; d < 2; d++) {
+            Dataset ds;
+            ds.name = "PROD.DATA.D" + std::to_string(i) + ".F" + std::to_string(d);
+            ds.volser = v.volser;
+            ds.size_bytes = 1024 * (i + 1);
+            ds.owner = v.owner;
+            ds.job_name = "JOB" + std::to_string(i % 100);
+            v.datasets.push_back(ds.name);
+            datasets.push_back(std::move(ds));
+        }
+        volumes.push_back(std::move(v));
+    }
+    
+    std::ostringstream exported;
+    {
+        JsonWriter writer(exported);
+        TmsJsonConverter::write_catalog(writer, volumes, datasets);
+    }
+    const std::string text = exported.str();
+    
+    std::cout << "TMS JSON Benchmark\n"
+              << "  Catalog: " << volume_count << " volumes, " << datasets.size()
+              << " datasets, " << format_bytes(text.size()) << " of JSON\n"
+              << "  sizeof(legacy JsonValue) = " << sizeof(legacy::Value)
+              << ", sizeof(JsonValue) = " << sizeof(JsonValue) << "\n\n";
+    
+    std::cout << "Parse:\n";
+    {
+        legacy::Value root;
+        auto m = measure([&] { size_t pos = 0; root = legacy::parse_value(text, pos); });
+        report("legacy DOM", m, text.size());
+    }
+    {
+        JsonValue root;
+        auto m = measure([&] { root = JsonSerializer::parse(text); });
+        report("compact DOM (heap)", m, text.size());
+    }
+    {
+        JsonDocument doc;
+        auto m = measure([&] { doc.parse(text); });
+        report("compact DOM (arena)", m, text.size());
+        std::cout << "    arena used " << format_bytes(doc.memory_used())
+                  << " of " << format_bytes(doc.memory_reserved()) << " reserved\n";
+    }
+    {
+        size_t records = 0;
+        auto m = measure([&] {
+            JsonReader reader{std::string_view(text)};
+            TmsJsonConverter::read_catalog(reader,
+                [&](TapeVolume&&) { records++; },
+                [&](Dataset&&) { records++; });
+        });
+        report("streaming reader -> records", m, text.size());
+    }
+    
+    std::cout << "\nSerialise:\n";
+    {
+        size_t pos = 0;
+        legacy::Value root = legacy::parse_value(text, pos);
+        auto m = measure([&] { std::ostringstream os; legacy::serialize(os, root); });
+        report("legacy DOM", m, text.size());
+    }
+    {
+        JsonDocument doc;
+        doc.parse(text);
+        JsonSerializer::Options opts;
+        opts.pretty_print = false;
+        auto m = measure([&] { std::string out = JsonSerializer::serialize(doc.root(), opts); });
+        report("compact DOM", m, text.size());
+    }
+    {
+        auto m = measure([&] {
+            std::ostringstream os;
+            JsonWriter writer(os);
+            TmsJsonConverter::write_catalog(writer, volumes, datasets);
+        });
+        report("streaming writer <- records", m, text.size());
+    }
+    
+    return 0;
+}
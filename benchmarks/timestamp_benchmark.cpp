@@ -0,0 +1,151 @@
+/**
+ * @file timestamp_benchmark.cpp
+ * @brief TMS Tape Management System - Timestamp codec benchmark
+ * @version 3.4.0
+ * @author Bennie Shearer
+ * @copyright Copyright (c) 2025 Bennie Shearer
+ * @license MIT License
+ *
+ * Compares the pre-3.4.0 format_time/parse_time implementation
+ * (localtime_r + std::put_time / std::get_time + mktime through string
+ * streams) with TimestampCodec, then times catalog save/load, which
+ * format and parse four timestamps per volume/dataset pair.
+ *
+ * Usage: timestamp_benchmark [volume_count]
+ */
+
+#include "tms_tape_mgmt.h"
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+
+using namespace tms;
+using Clock = std::chrono::steady_clock;
+
+// ============================================================================
+// Legacy Implementation (v3.3.0, kept for comparison)
+// ============================================================================
+
+namespace legacy {
+
+std::string format_time(const std::chrono::system_clock::time_point& tp) {
+    auto time_t_val = std::chrono::system_clock::to_time_t(tp);
+    std::tm tm_buf{};
+    localtime_r(&time_t_val, &tm_buf);
+    std::ostringstream oss;
+    oss << std::put_time(&tm_buf, "%Y-%m-%d %H:%M:%S");
+    return oss.str();
+}
+
+std::chrono::system_clock::time_point parse_time(const std::string& str) {
+    std::tm tm = {};
+    std::istringstream ss(str);
+    ss >> std::get_time(&tm, "%Y-%m-%d %H:%M:%S");
+    if (ss.fail()) {
+        return std::chrono::system_clock::time_point{};
+    }
+    return std::chrono::system_clock::from_time_t(std::mktime(&tm));
+}
+
+} // namespace legacy
+
+// ============================================================================
+// Benchmark Driver
+// ============================================================================
+
+template<typename Fn>
+static double seconds(Fn&& fn) {
+    auto start = Clock::now();
+    fn();
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+static void report(const std::string& name, double secs, size_t ops) {
+    std::cout << "  " << std::left << std::setw(28) << name << std::right
+              << std::setw(10) << std::fixed << std::setprecision(1)
+              << (secs * 1e9 / static_cast<double>(ops)) << " ns/op"
+              << std::setw(12) << std::setprecision(2)
+              << (static_cast<double>(ops) / secs / 1e6) << " M/s\n";
+}
+
+int main(int argc, char* argv[]) {
+    size_t volume_count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    
+    // Timestamps spread over three years, in the order a catalog holds them
+    const size_t ops = 1000000;
+    auto now = std::chrono::system_clock::now();
+    std::vector<std::chrono::system_clock::time_point> stamps;
+    stamps.reserve(ops);
+    for (size_t i = 0; i < ops; i++) {
+        stamps.push_back(now - std::chrono::seconds((i * 7919) % (3 * 365 * 86400)));
+    }
+    std::vector<std::string> texts;
+    texts.reserve(ops);
+    for (const auto& tp : stamps) texts.push_back(format_time(tp));
+    
+    std::cout << "TMS Timestamp Benchmark (" << ops << " timestamps)\n\nFormat:\n";
+    size_t sink = 0;
+    report("legacy format_time", seconds([&] {
+        for (const auto& tp : stamps) sink += legacy::format_time(tp).size();
+    }), ops);
+    report("TimestampCodec::format", seconds([&] {
+        for (const auto& tp : stamps) sink += format_time(tp).size();
+    }), ops);
+    report("TimestampCodec::append", seconds([&] {
+        std::string out;
+        for (const auto& tp : stamps) {
+            out.clear();
+            TimestampCodec::append(out, tp);
+            sink += out.size();
+        }
+    }), ops);
+    
+    std::cout << "\nParse:\n";
+    int64_t total = 0;
+    report("legacy parse_time", seconds([&] {
+        for (const auto& s : texts) total += legacy::parse_time(s).time_since_epoch().count();
+    }), ops);
+    report("TimestampCodec::parse", seconds([&] {
+        for (const auto& s : texts) total += parse_time(s).time_since_epoch().count();
+    }), ops);
+    
+    // Catalog round trip through the text catalog files
+    std::string dir = (std::filesystem::temp_directory_path() / "tms_timestamp_bench").string();
+    std::filesystem::remove_all(dir);
+    {
+        Logger::instance().set_level(Logger::Level::WARNING);
+        TMSSystem sys(dir);
+        std::vector<TapeVolume> volumes;
+        std::vector<Dataset> datasets;
+        for (size_t i = 0; i < volume_count; i++) {
+            TapeVolume v;
+            v.volser = std::to_string(100000 + i);
+            v.volser[0] = 'T';
+            v.pool = "POOL" + std::to_string(i % 8);
+            v.owner = "OWNER" + std::to_string(i % 50);
+            v.creation_date = stamps[i % ops];
+            volumes.push_back(std::move(v));
+            Dataset ds;
+            ds.name = "BENCH.DS" + std::to_string(i);
+            ds.volser = volumes.back().volser;
+            ds.creation_date = stamps[(i * 3) % ops];
+            datasets.push_back(std::move(ds));
+        }
+        sys.bulk_add_volumes(volumes);
+        sys.bulk_add_datasets(datasets);
+        
+        std::cout << "\nCatalog (" << volume_count << " volumes, " << volume_count << " datasets):\n";
+        double save = seconds([&] { sys.save_catalog(); });
+        double load = seconds([&] { sys.load_catalog(); });
+        std::cout << "  save_catalog  " << std::fixed << std::setw(10) << std::setprecision(1)
+                  << (static_cast<double>(volume_count * 2) / save / 1000.0) << " K records/s\n"
+                  << "  load_catalog  " << std::setw(10)
+                  << (static_cast<double>(volume_count * 2) / load / 1000.0) << " K records/s\n";
+    }
+    std::filesystem::remove_all(dir);
+    
+    return (sink == 0 && total == 0) ? 1 : 0;
+}
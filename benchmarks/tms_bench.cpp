@@ -0,0 +1,644 @@
+/**
+ * @file tms_bench.cpp
+ * @brief TMS Tape Management System - Catalog benchmark suite
+ * @version 3.4.0
+ * @author Bennie Shearer
+ * @copyright Copyright (c) 2025 Bennie Shearer
+ * @license MIT License
+ *
+ * Microbenchmarks for the hot catalog operations and end-to-end scenarios
+ * over a synthetic catalog from CatalogGenerator. Every run with the same
+ * options works on the same catalog, so results can be compared across
+ * commits. Each benchmark reports throughput and latency percentiles; the
+ * default output is one JSON object per line. Memory benchmarks count live
+ * heap bytes through replaced global operator new/delete, which also give
+ * every benchmark its heap allocations per operation; scaling benchmarks
+ * run the same lookup from several threads at once.
+ *
+ * Usage: tms_bench [--volumes N] [--datasets N] [--ops N] [--seed N]
+ *                  [--owners N] [--pools N] [--tags N] [--skew X]
+ *                  [--expiration none|uniform|exponential|bimodal]
+ *                  [--filter TEXT] [--format json|text] [--out FILE]
+ */
+
+#include "tms_tape_mgmt.h"
+#include "catalog_generator.h"
+#include <chrono>
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <thread>
+
+using namespace tms;
+using namespace tms::bench;
+using Clock = std::chrono::steady_clock;
+
+// ============================================================================
+// Heap Accounting
+// ============================================================================
+
+// Each block carries its size in a header so delete can subtract it
+static std::atomic<int64_t> g_live_bytes{0};
+static std::atomic<uint64_t> g_allocations{0};
+static constexpr size_t HEAP_HEADER = alignof(std::max_align_t);
+
+void* operator new(std::size_t n) {
+    void* block = std::malloc(n + HEAP_HEADER);
+    if (!block) throw std::bad_alloc();
+    *static_cast<std::size_t*>(block) = n;
+    g_live_bytes.fetch_add(static_cast<int64_t>(n), std::memory_order_relaxed);
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return static_cast<char*>(block) + HEAP_HEADER;
+}
+
+void operator delete(void* p) noexcept {
+    if (!p) return;
+    void* block = static_cast<char*>(p) - HEAP_HEADER;
+    g_live_bytes.fetch_sub(static_cast<int64_t>(*static_cast<std::size_t*>(block)), std::memory_order_relaxed);
+    std::free(block);
+}
+
+void operator delete(void* p, std::size_t) noexcept { operator delete(p); }
+
+static int64_t live_heap_bytes() { return g_live_bytes.load(std::memory_order_relaxed); }
+static uint64_t heap_allocations() { return g_allocations.load(std::memory_order_relaxed); }
+
+// ============================================================================
+// Measurement
+// ============================================================================
+
+/**
+ * @brief Per-operation latency samples for one benchmark
+ */
+class LatencyRecorder {
+public:
+    explicit LatencyRecorder(size_t expected) { samples_.reserve(expected); }
+    
+    template<typename Fn>
+    void time(Fn&& fn) {
+        auto start = Clock::now();
+        fn();
+        samples_.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+    }
+    
+    size_t count() const { return samples_.size(); }
+    
+    void merge(const LatencyRecorder& other) {
+        samples_.insert(samples_.end(), other.samples_.begin(), other.samples_.end());
+        sorted_ = false;
+    }
+    
+    /// Nearest-rank percentile; sorts the samples on first use
+    int64_t percentile(double q) {
+        if (samples_.empty()) return 0;
+        if (!sorted_) {
+            std::sort(samples_.begin(), samples_.end());
+            sorted_ = true;
+        }
+        size_t rank = static_cast<size_t>(std::ceil(q / 100.0 * static_cast<double>(samples_.size())));
+        return samples_[std::clamp<size_t>(rank, 1, samples_.size()) - 1];
+    }
+    
+private:
+    std::vector<int64_t> samples_;
+    bool sorted_ = false;
+};
+
+struct BenchResult {
+    std::string name;
+    std::string kind;           // "micro", "scaling" or "scenario"
+    size_t ops = 0;
+    size_t records = 0;         // Records processed, for bulk benchmarks
+    double seconds = 0.0;
+    int64_t p50_ns = 0;
+    int64_t p90_ns = 0;
+    int64_t p99_ns = 0;
+    int64_t max_ns = 0;
+    double bytes_per_record = 0.0;  // Memory benchmarks only
+    double allocs_per_op = 0.0;     // Heap allocations, including setup inside the timed call
+};
+
+struct BenchOptions {
+    CatalogSpec spec;
+    size_t ops = 10000;
+    std::string filter;
+    std::string format = "json";
+    std::string out_path;
+};
+
+// ============================================================================
+// Output
+// ============================================================================
+
+static void write_json(std::ostream& os, const BenchOptions& opts, const BenchResult& r) {
+    double secs = std::max(r.seconds, 1e-9);
+    {
+        JsonWriter w(os);
+        w.begin_object()
+            .field("benchmark", r.name)
+            .field("kind", r.kind)
+            .field("version", VERSION_STRING)
+            .field("volumes", opts.spec.volumes)
+            .field("datasets", opts.spec.datasets)
+            .field("seed", opts.spec.seed)
+            .field("ops", r.ops)
+            .field("seconds", r.seconds)
+            .field("ops_per_sec", static_cast<double>(r.ops) / secs);
+        if (r.records > 0) w.field("records_per_sec", static_cast<double>(r.records) / secs);
+        w.field("p50_ns", r.p50_ns)
+            .field("p90_ns", r.p90_ns)
+            .field("p99_ns", r.p99_ns)
+            .field("max_ns", r.max_ns)
+            .field("allocs_per_op", r.allocs_per_op);
+        if (r.bytes_per_record > 0) w.field("bytes_per_record", r.bytes_per_record);
+        w.end_object();
+    }
+    os << "\n";
+}
+
+static void write_text_header(std::ostream& os, const BenchOptions& opts) {
+    os << "TMS Catalog Benchmark (" << opts.spec.volumes << " volumes, "
+       << opts.spec.datasets << " datasets, seed " << opts.spec.seed << ")\n\n"
+       << std::left << std::setw(28) << "benchmark" << std::right
+       << std::setw(10) << "ops" << std::setw(14) << "ops/s"
+       << std::setw(12) << "p50 us" << std::setw(12) << "p90 us"
+       << std::setw(12) << "p99 us" << std::setw(12) << "max us" << std::setw(12) << "allocs/op" << "\n";
+}
+
+static void write_text(std::ostream& os, const BenchResult& r) {
+    auto us = [](int64_t ns) { return static_cast<double>(ns) / 1000.0; };
+    os << std::left << std::setw(28) << r.name << std::right
+       << std::setw(10) << r.ops << std::setw(14) << std::fixed << std::setprecision(0)
+       << static_cast<double>(r.ops) / std::max(r.seconds, 1e-9) << std::setprecision(1)
+       << std::setw(12) << us(r.p50_ns) << std::setw(12) << us(r.p90_ns)
+       << std::setw(12) << us(r.p99_ns) << std::setw(12) << us(r.max_ns)
+       << std::setw(12) << r.allocs_per_op;
+    if (r.bytes_per_record > 0) os << "  " << std::setprecision(0) << r.bytes_per_record << " B/record";
+    os << "\n";
+}
+
+// ============================================================================
+// Benchmark Registry
+// ============================================================================
+
+/**
+ * @brief Shared state: one populated catalog reused by read-mostly benchmarks
+ */
+class BenchContext {
+public:
+    explicit BenchContext(const BenchOptions& opts)
+        : opts_(opts), generator_(opts.spec),
+          root_((std::filesystem::temp_directory_path() / "tms_bench").string()) {
+        std::filesystem::remove_all(root_);
+    }
+    
+    ~BenchContext() {
+        catalog_.reset();
+        std::filesystem::remove_all(root_);
+    }
+    
+    const BenchOptions& options() const { return opts_; }
+    const CatalogGenerator& generator() const { return generator_; }
+    
+    /// Populated catalog, built on first use
+    TMSSystem& catalog() {
+        if (!catalog_) {
+            catalog_ = std::make_unique<TMSSystem>(root_ + "/catalog");
+            generator_.populate(*catalog_);
+        }
+        return *catalog_;
+    }
+    
+    /// Fresh, empty catalog for write benchmarks
+    std::unique_ptr<TMSSystem> empty_catalog(const std::string& name) {
+        std::filesystem::remove_all(root_ + "/" + name);
+        return std::make_unique<TMSSystem>(root_ + "/" + name);
+    }
+    
+    SplitMix64 rng(uint64_t stream) const { return SplitMix64(opts_.spec.seed * 31 + stream); }
+    
+private:
+    const BenchOptions& opts_;
+    CatalogGenerator generator_;
+    std::string root_;
+    std::unique_ptr<TMSSystem> catalog_;
+};
+
+struct Benchmark {
+    const char* name;
+    const char* kind;
+    std::function<BenchResult(BenchContext&)> run;
+};
+
+/// Time @p ops calls of @p op(i) individually
+template<typename Fn>
+static BenchResult measure(const char* name, const char* kind, size_t ops, Fn&& op) {
+    LatencyRecorder latencies(ops);
+    uint64_t allocations = heap_allocations();
+    auto start = Clock::now();
+    for (size_t i = 0; i < ops; i++) latencies.time([&] { op(i); });
+    BenchResult r;
+    r.name = name;
+    r.kind = kind;
+    r.ops = latencies.count();
+    r.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    // The recorder reserved its samples up front, so this is the operations' own count
+    r.allocs_per_op = r.ops > 0 ? static_cast<double>(heap_allocations() - allocations) / static_cast<double>(r.ops) : 0.0;
+    r.p50_ns = latencies.percentile(50);
+    r.p90_ns = latencies.percentile(90);
+    r.p99_ns = latencies.percentile(99);
+    r.max_ns = latencies.percentile(100);
+    return r;
+}
+
+/// Run @p ops calls of @p op(i) on each of @p threads threads at once
+template<typename Fn>
+static BenchResult measure_threads(const char* name, const char* kind, size_t threads, size_t ops, Fn&& op) {
+    std::vector<LatencyRecorder> latencies(threads, LatencyRecorder(ops));
+    std::vector<std::thread> workers;
+    std::atomic<bool> go{false};
+    for (size_t t = 0; t < threads; t++) {
+        workers.emplace_back([&, t] {
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            for (size_t i = 0; i < ops; i++) latencies[t].time([&] { op(t * ops + i); });
+        });
+    }
+    auto start = Clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& w : workers) w.join();
+    BenchResult r;
+    r.name = name;
+    r.kind = kind;
+    r.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    for (size_t t = 1; t < threads; t++) latencies[0].merge(latencies[t]);
+    r.ops = latencies[0].count();
+    r.p50_ns = latencies[0].percentile(50);
+    r.p90_ns = latencies[0].percentile(90);
+    r.p99_ns = latencies[0].percentile(99);
+    r.max_ns = latencies[0].percentile(100);
+    return r;
+}
+
+/// Iterations for whole-catalog operations (search, query, fuzzy, save)
+static size_t scan_ops(const BenchContext& ctx, size_t cap) {
+    size_t scaled = ctx.options().ops / 50;
+    return std::clamp<size_t>(scaled, 3, cap);
+}
+
+static std::vector<Benchmark> make_benchmarks() {
+    std::vector<Benchmark> list;
+    
+    // ---------------------------------------------------------------- micro
+    
+    list.push_back({"add_volume", "micro", [](BenchContext& ctx) {
+        auto sys = ctx.empty_catalog("add_volume");
+        CatalogSpec spec = ctx.options().spec;
+        spec.volumes = ctx.options().ops;
+        auto volumes = CatalogGenerator(spec).volumes();
+        return measure("add_volume", "micro", volumes.size(),
+                       [&](size_t i) { sys->add_volume(volumes[i]); });
+    }});
+    
+    list.push_back({"get_volume", "micro", [](BenchContext& ctx) {
+        TMSSystem& sys = ctx.catalog();
+        auto rng = ctx.rng(1);
+        size_t n = ctx.options().spec.volumes;
+        std::vector<std::string> keys;
+        for (size_t i = 0; i < ctx.options().ops; i++) keys.push_back(CatalogGenerator::volser(rng.below(n)));
+        return measure("get_volume", "micro", keys.size(), [&](size_t i) { sys.get_volume(keys[i]); });
+    }});
+    
+    list.push_back({"read_volume", "micro", [](BenchContext& ctx) {
+        TMSSystem& sys = ctx.catalog();
+        auto rng = ctx.rng(1);
+        size_t n = ctx.options().spec.volumes;
+        std::vector<std::string> keys;
+        for (size_t i = 0; i < ctx.options().ops; i++) keys.push_back(CatalogGenerator::volser(rng.below(n)));
+        uint64_t used = 0;
+        return measure("read_volume", "micro", keys.size(), [&](size_t i) {
+            sys.read_volume(keys[i], [&used](const TapeVolume& vol) { used += vol.used_bytes; });
+        });
+    }});
+    
+    list.push_back({"update_volume", "micro", [](BenchContext& ctx) {
+        // Read-modify-write of one field through whole-record copies
+        TMSSystem& sys = ctx.catalog();
+        auto rng = ctx.rng(9);
+        size_t n = ctx.options().spec.volumes;
+        return measure("update_volume", "micro", ctx.options().ops, [&](size_t i) {
+            auto vol = sys.get_volume(CatalogGenerator::volser(rng.below(n)));
+            if (!vol.is_success()) return;
+            TapeVolume updated = vol.value();
+            updated.notes = "touched " + std::to_string(i);
+            sys.update_volume(std::move(updated));
+        });
+    }});
+    
+    list.push_back({"patch_volume", "micro", [](BenchContext& ctx) {
+        TMSSystem& sys = ctx.catalog();
+        auto rng = ctx.rng(9);
+        size_t n = ctx.options().spec.volumes;
+        return measure("patch_volume", "micro", ctx.options().ops, [&](size_t i) {
+            VolumePatch patch;
+            patch.notes = "touched " + std::to_string(i);
+            sys.patch_volume(CatalogGenerator::volser(rng.below(n)), patch);
+        });
+    }});
+    
+    list.push_back({"search_volumes_pool", "micro", [](BenchContext& ctx) {
+        TMSSystem& sys = ctx.catalog();
+        auto rng = ctx.rng(2);
+        ZipfSampler pools(ctx.options().spec.pools, ctx.options().spec.pool_skew);
+        return measure("search_volumes_pool", "micro", scan_ops(ctx, 500), [&](size_t) {
+            SearchCriteria criteria;
+            criteria.pool = CatalogGenerator::pool_name(pools.sample(rng));
+            sys.search_volumes(criteria);
+        });
+    }});
+    
+    list.push_back({"search_volumes_wildcard", "micro", [](BenchContext& ctx) {
+        TMSSystem& sys = ctx.catalog();
+        auto rng = ctx.rng(3);
+        return measure("search_volumes_wildcard", "micro", scan_ops(ctx, 500), [&](size_t) {
+            SearchCriteria criteria;
+            criteria.pattern = "V0" + std::string(1, "0123456789"[rng.below(10)]) + "*";
+            criteria.mode = SearchMode::WILDCARD;
+            criteria.status = VolumeStatus::PRIVATE;
+            sys.search_volumes(criteria);
+        });
+    }});
+    
+    list.push_back({"allocate_scratch_volume", "micro", [](BenchContext& ctx) {
+        // Own catalog: allocation consumes the scratch pool
+        auto sys = ctx.empty_catalog("allocate");
+        ctx.generator().populate(*sys);
+        size_t ops = std::min(ctx.options().ops, sys->get_scratch_pool_stats().first);
+        return measure("allocate_scratch_volume", "micro", ops,
+                       [&](size_t) { sys->allocate_scratch_volume(); });
+    }});
+    
+    list.push_back({"query_volumes", "micro", [](BenchContext& ctx) {
+        TMSSystem& sys = ctx.catalog();
+        auto rng = ctx.rng(4);
+        ZipfSampler owners(ctx.options().spec.owners, ctx.options().spec.owner_skew);
+        QueryEngine engine;
+        return measure("query_volumes", "micro", scan_ops(ctx, 200), [&](size_t) {
+            std::string query = "owner:eq:" + CatalogGenerator::owner_name(owners.sample(rng));
+            engine.query_volumes(query, [&] { return sys.list_volumes(); });
+        });
+    }});
+    
+    list.push_back({"fuzzy_search_volumes", "micro", [](BenchContext& ctx) {
+        TMSSystem& sys = ctx.catalog();
+        auto rng = ctx.rng(5);
+        size_t n = ctx.options().spec.volumes;
+        return measure("fuzzy_search_volumes", "micro", scan_ops(ctx, 200), [&](size_t) {
+            std::string target = CatalogGenerator::volser(rng.below(n));
+            target[3] = target[3] == 'X' ? 'Y' : 'X';
+            sys.fuzzy_search_volumes(target, 1);
+        });
+    }});
+    
+    list.push_back({"fuzzy_search_datasets", "micro", [](BenchContext& ctx) {
+        TMSSystem& sys = ctx.catalog();
+        auto rng = ctx.rng(6);
+        return measure("fuzzy_search_datasets", "micro", scan_ops(ctx, 100), [&](size_t) {
+            std::string target = "OWN1.BENCH.D" + std::to_string(rng.below(ctx.options().spec.datasets));
+            target.back() = target.back() == '0' ? '1' : '0';
+            sys.fuzzy_search_datasets(target, 1);
+        });
+    }});
+    
+    list.push_back({"get_statistics", "micro", [](BenchContext& ctx) {
+        TMSSystem& sys = ctx.catalog();
+        auto r = measure("get_statistics", "micro", scan_ops(ctx, 200), [&](size_t) { sys.get_statistics(); });
+        r.records = r.ops * ctx.options().spec.volumes;
+        return r;
+    }});
+    
+    list.push_back({"pool_statistics", "micro", [](BenchContext& ctx) {
+        TMSSystem& sys = ctx.catalog();
+        auto r = measure("pool_statistics", "micro", scan_ops(ctx, 200),
+                         [&](size_t) { sys.get_all_pool_statistics(); });
+        r.records = r.ops * ctx.options().spec.volumes;
+        return r;
+    }});
+    
+    list.push_back({"scratch_pool_stats", "micro", [](BenchContext& ctx) {
+        TMSSystem& sys = ctx.catalog();
+        auto rng = ctx.rng(8);
+        ZipfSampler pools(ctx.options().spec.pools, ctx.options().spec.pool_skew);
+        auto r = measure("scratch_pool_stats", "micro", scan_ops(ctx, 200), [&](size_t) {
+            sys.get_scratch_pool_stats(CatalogGenerator::pool_name(pools.sample(rng)));
+        });
+        r.records = r.ops * ctx.options().spec.volumes;
+        return r;
+    }});
+    
+    list.push_back({"save_catalog", "micro", [](BenchContext& ctx) {
+        TMSSystem& sys = ctx.catalog();
+        auto r = measure("save_catalog", "micro", scan_ops(ctx, 10), [&](size_t) { sys.save_catalog(); });
+        r.records = r.ops * (ctx.options().spec.volumes + ctx.options().spec.datasets);
+        return r;
+    }});
+    
+    list.push_back({"load_catalog", "micro", [](BenchContext& ctx) {
+        TMSSystem& sys = ctx.catalog();
+        sys.save_catalog();
+        auto r = measure("load_catalog", "micro", scan_ops(ctx, 10), [&](size_t) { sys.load_catalog(); });
+        r.records = r.ops * (ctx.options().spec.volumes + ctx.options().spec.datasets);
+        return r;
+    }});
+    
+    list.push_back({"integrity_check", "micro", [](BenchContext& ctx) {
+        TMSSystem& sys = ctx.catalog();
+        IntegrityChecker checker;
+        auto r = measure("integrity_check", "micro", scan_ops(ctx, 10), [&](size_t) {
+            checker.check_integrity([&] { return sys.list_volumes(); }, [&] { return sys.list_datasets(); });
+        });
+        r.records = r.ops * (ctx.options().spec.volumes + ctx.options().spec.datasets);
+        return r;
+    }});
+    
+    // -------------------------------------------------------------- scaling
+    
+    // volume_exists from 1-8 threads, under the shared catalog lock and
+    // lock-free; ops/s should grow with threads up to the core count
+    struct ScalingCase { const char* name; size_t threads; bool lock_free; };
+    static constexpr ScalingCase scaling[] = {
+        {"read_scaling_locked_t1", 1, false}, {"read_scaling_rcu_t1", 1, true},
+        {"read_scaling_locked_t2", 2, false}, {"read_scaling_rcu_t2", 2, true},
+        {"read_scaling_locked_t4", 4, false}, {"read_scaling_rcu_t4", 4, true},
+        {"read_scaling_locked_t8", 8, false}, {"read_scaling_rcu_t8", 8, true},
+    };
+    for (const auto& c : scaling) {
+        list.push_back({c.name, "scaling", [c](BenchContext& ctx) {
+            TMSSystem& sys = ctx.catalog();
+            auto rng = ctx.rng(10);
+            size_t n = ctx.options().spec.volumes;
+            size_t ops = ctx.options().ops;
+            std::vector<std::string> keys;
+            for (size_t i = 0; i < ops * c.threads; i++) keys.push_back(CatalogGenerator::volser(rng.below(n)));
+            if (c.lock_free) sys.enable_lock_free_reads();
+            auto r = measure_threads(c.name, "scaling", c.threads, ops,
+                                     [&](size_t i) { sys.volume_exists(keys[i]); });
+            sys.disable_lock_free_reads();
+            return r;
+        }});
+    }
+    
+    // ------------------------------------------------------------- scenario
+    
+    list.push_back({"ingest", "scenario", [](BenchContext& ctx) {
+        auto sys = ctx.empty_catalog("ingest");
+        auto volumes = ctx.generator().volumes();
+        auto datasets = ctx.generator().datasets(volumes);
+        size_t records = 0;
+        auto r = measure("ingest", "scenario", 1, [&](size_t) {
+            records += sys->bulk_add_volumes(volumes).succeeded;
+            records += sys->bulk_add_datasets(datasets).succeeded;
+        });
+        r.records = records;
+        return r;
+    }});
+    
+    list.push_back({"mixed_workload", "scenario", [](BenchContext& ctx) {
+        // 70% lookups, 15% updates, 10% owner searches, 5% scratch allocations
+        auto sys = ctx.empty_catalog("mixed");
+        ctx.generator().populate(*sys);
+        auto rng = ctx.rng(7);
+        ZipfSampler owners(ctx.options().spec.owners, ctx.options().spec.owner_skew);
+        size_t n = ctx.options().spec.volumes;
+        return measure("mixed_workload", "scenario", ctx.options().ops, [&](size_t i) {
+            size_t dice = rng.below(100);
+            std::string volser = CatalogGenerator::volser(rng.below(n));
+            if (dice < 70) {
+                sys->get_volume(volser);
+            } else if (dice < 85) {
+                auto vol = sys->get_volume(volser);
+                if (vol.is_success()) {
+                    TapeVolume updated = vol.value();
+                    updated.notes = "touched " + std::to_string(i);
+                    sys->update_volume(updated);
+                }
+            } else if (dice < 95) {
+                SearchCriteria criteria;
+                criteria.owner = CatalogGenerator::owner_name(owners.sample(rng));
+                criteria.limit = 100;
+                sys->search_volumes(criteria);
+            } else {
+                sys->allocate_scratch_volume();
+            }
+        });
+    }});
+    
+    list.push_back({"volume_memory", "scenario", [](BenchContext& ctx) {
+        // Live heap per catalogued volume, record plus index entries
+        int64_t before = live_heap_bytes();
+        auto sys = ctx.empty_catalog("memory");
+        size_t added = 0;
+        auto r = measure("volume_memory", "scenario", 1, [&](size_t) {
+            auto volumes = ctx.generator().volumes();
+            added = sys->bulk_add_volumes(volumes).succeeded;
+        });
+        r.records = added;
+        r.bytes_per_record = added > 0 ? static_cast<double>(live_heap_bytes() - before) / static_cast<double>(added) : 0.0;
+        return r;
+    }});
+    
+    list.push_back({"expiration_scan", "scenario", [](BenchContext& ctx) {
+        TMSSystem& sys = ctx.catalog();
+        auto r = measure("expiration_scan", "scenario", scan_ops(ctx, 20),
+                         [&](size_t) { sys.process_expirations(true); });
+        r.records = r.ops * ctx.options().spec.volumes;
+        return r;
+    }});
+    
+    return list;
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+static void usage() {
+    std::cerr << "Usage: tms_bench [--volumes N] [--datasets N] [--ops N] [--seed N]\n"
+              << "                 [--owners N] [--pools N] [--tags N] [--skew X]\n"
+              << "                 [--expiration none|uniform|exponential|bimodal]\n"
+              << "                 [--filter TEXT] [--format json|text] [--out FILE] [--list]\n";
+}
+
+int main(int argc, char* argv[]) {
+    BenchOptions opts;
+    bool list_only = false;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        auto next = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                usage();
+                std::exit(2);
+            }
+            return argv[++i];
+        };
+        if (arg == "--volumes") opts.spec.volumes = std::strtoull(next().c_str(), nullptr, 10);
+        else if (arg == "--datasets") opts.spec.datasets = std::strtoull(next().c_str(), nullptr, 10);
+        else if (arg == "--ops") opts.ops = std::strtoull(next().c_str(), nullptr, 10);
+        else if (arg == "--seed") opts.spec.seed = std::strtoull(next().c_str(), nullptr, 10);
+        else if (arg == "--owners") opts.spec.owners = std::strtoull(next().c_str(), nullptr, 10);
+        else if (arg == "--pools") opts.spec.pools = std::strtoull(next().c_str(), nullptr, 10);
+        else if (arg == "--tags") opts.spec.tags = std::strtoull(next().c_str(), nullptr, 10);
+        else if (arg == "--skew") {
+            double skew = std::strtod(next().c_str(), nullptr);
+            opts.spec.owner_skew = opts.spec.pool_skew = opts.spec.tag_skew = skew;
+        }
+        else if (arg == "--expiration") opts.spec.expiration = parse_expiration_model(next());
+        else if (arg == "--filter") opts.filter = next();
+        else if (arg == "--format") opts.format = next();
+        else if (arg == "--out") opts.out_path = next();
+        else if (arg == "--list") list_only = true;
+        else {
+            usage();
+            return 2;
+        }
+    }
+    
+    auto benchmarks = make_benchmarks();
+    if (list_only) {
+        for (const auto& b : benchmarks) std::cout << b.name << " (" << b.kind << ")\n";
+        return 0;
+    }
+    
+    std::ofstream file;
+    if (!opts.out_path.empty()) {
+        file.open(opts.out_path, std::ios::app);
+        if (!file) {
+            std::cerr << "Cannot open " << opts.out_path << "\n";
+            return 1;
+        }
+    }
+    std::ostream& out = opts.out_path.empty() ? std::cout : file;
+    bool text = opts.format == "text";
+    
+    // Catalog limits must not cap the synthetic catalog
+    Logger::instance().set_level(Logger::Level::WARNING);
+    auto& config = Configuration::instance();
+    config.set_string("General", "max_volumes", std::to_string(opts.spec.volumes + opts.ops + 1));
+    config.set_string("General", "max_datasets", std::to_string(opts.spec.datasets + 1));
+    
+    if (text) write_text_header(out, opts);
+    BenchContext ctx(opts);
+    for (const auto& bench : benchmarks) {
+        if (!opts.filter.empty() && std::string(bench.name).find(opts.filter) == std::string::npos) continue;
+        BenchResult result = bench.run(ctx);
+        if (text) write_text(out, result);
+        else write_json(out, opts, result);
+        out.flush();
+    }
+    return 0;
+}
@@ -0,0 +1,267 @@
+/**
+ * @file tms_loadgen.cpp
+ * @brief TMS Tape Management System - RPC load generator
+ * @version 3.4.0
+ * @author Bennie Shearer
+ * @copyright Copyright (c) 2025 Bennie Shearer
+ * @license MIT License
+ *
+ * Drives a catalog daemon (tms --daemon) through RpcClient and reports
+ * throughput and round-trip latency. Each connection thread keeps
+ * --pipeline frames in flight per round, and each frame carries --batch
+ * operations (a BATCH frame when --batch > 1). Reads are GET_VOLUME and
+ * writes are PATCH_VOLUME on volumes named by CatalogGenerator. Without
+ * --socket or --tcp, the tool serves a generated catalog in-process on a
+ * temporary socket.
+ *
+ * Usage: tms_loadgen [--socket PATH | --tcp PORT] [--volumes N] [--ops N]
+ *                    [--connections N] [--pipeline N] [--batch N]
+ *                    [--writes PCT] [--workers N] [--seed N]
+ *                    [--format text|json]
+ */
+
+#include "tms_tape_mgmt.h"
+#include "tms_rpc.h"
+#include "catalog_generator.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+using namespace tms;
+using namespace tms::bench;
+using Clock = std::chrono::steady_clock;
+
+struct LoadOptions {
+    std::string socket_path;
+    int tcp_port = -1;
+    size_t volumes = 10000;
+    size_t ops = 200000;
+    size_t connections = 4;
+    size_t pipeline = 16;
+    size_t batch = 1;
+    double write_percent = 10.0;
+    size_t workers = 4;
+    uint64_t seed = 42;
+    std::string format = "text";
+};
+
+struct ConnectionResult {
+    size_t ops = 0;
+    size_t errors = 0;
+    std::vector<int64_t> latencies_ns;          ///< One per frame, send to response
+    std::string failure;
+};
+
+static void usage() {
+    std::cerr << "Usage: tms_loadgen [--socket PATH | --tcp PORT] [--volumes N] [--ops N]\n"
+              << "                   [--connections N] [--pipeline N] [--batch N]\n"
+              << "                   [--writes PCT] [--workers N] [--seed N]\n"
+              << "                   [--format text|json]\n";
+}
+
+/// Nearest-rank percentile of sorted samples
+static int64_t percentile(const std::vector<int64_t>& sorted, double q) {
+    if (sorted.empty()) return 0;
+    size_t rank = static_cast<size_t>(std::ceil(q / 100.0 * static_cast<double>(sorted.size())));
+    return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+static void run_connection(const LoadOptions& opts, size_t index, size_t ops, ConnectionResult& result) {
+    RpcClient client;
+    auto connected = opts.tcp_port >= 0
+        ? client.connect_tcp("127.0.0.1", static_cast<uint16_t>(opts.tcp_port))
+        : client.connect_unix(opts.socket_path);
+    if (!connected) {
+        result.failure = connected.error().message;
+        return;
+    }
+    
+    SplitMix64 rng(opts.seed * 31 + index);
+    VolumePatch patch;
+    // Picks the next operation and hands (op, argument writer) to emit
+    auto next_op = [&](auto&& emit) {
+        std::string volser = CatalogGenerator::volser(rng.below(opts.volumes));
+        if (rng.uniform() * 100.0 < opts.write_percent) {
+            patch.notes = std::to_string(rng.next() % 1000) + " loadgen";
+            emit(RpcOp::PATCH_VOLUME, [&](RpcWriter& w) {
+                w.put_string(volser);
+                RpcCodec::write_volume_patch(w, patch);
+            });
+        } else {
+            emit(RpcOp::GET_VOLUME, [&](RpcWriter& w) { w.put_string(volser); });
+        }
+    };
+    
+    RpcBatch batch;
+    while (result.ops < ops) {
+        size_t frames = 0;
+        for (; frames < opts.pipeline && result.ops < ops; frames++) {
+            size_t n = std::min(opts.batch, ops - result.ops);
+            if (opts.batch > 1) {
+                batch.clear();
+                for (size_t i = 0; i < n; i++) {
+                    next_op([&](RpcOp op, auto&& args) { batch.add(op, args); });
+                }
+                client.enqueue(batch);
+            } else {
+                next_op([&](RpcOp op, auto&& args) { client.enqueue(op, args); });
+            }
+            result.ops += n;
+        }
+        Clock::time_point start = Clock::now();
+        auto flushed = client.flush();
+        if (!flushed) {
+            result.failure = flushed.error().message;
+            return;
+        }
+        for (size_t f = 0; f < frames; f++) {
+            auto response = client.receive();
+            if (!response) {
+                result.failure = response.error().message;
+                return;
+            }
+            result.latencies_ns.push_back(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+            if (response.value().op == RpcOp::BATCH) {
+                auto items = response.value().batch_items();
+                if (!items) {
+                    result.errors += 1;
+                    continue;
+                }
+                for (const auto& item : items.value()) result.errors += item.is_success() ? 0 : 1;
+            } else if (!response.value().is_success()) {
+                result.errors++;
+            }
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    LoadOptions opts;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        auto next = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                usage();
+                std::exit(2);
+            }
+            return argv[++i];
+        };
+        if (arg == "--socket") opts.socket_path = next();
+        else if (arg == "--tcp") opts.tcp_port = std::atoi(next().c_str());
+        else if (arg == "--volumes") opts.volumes = std::strtoull(next().c_str(), nullptr, 10);
+        else if (arg == "--ops") opts.ops = std::strtoull(next().c_str(), nullptr, 10);
+        else if (arg == "--connections") opts.connections = std::strtoull(next().c_str(), nullptr, 10);
+        else if (arg == "--pipeline") opts.pipeline = std::strtoull(next().c_str(), nullptr, 10);
+        else if (arg == "--batch") opts.batch = std::strtoull(next().c_str(), nullptr, 10);
+        else if (arg == "--writes") opts.write_percent = std::strtod(next().c_str(), nullptr);
+        else if (arg == "--workers") opts.workers = std::strtoull(next().c_str(), nullptr, 10);
+        else if (arg == "--seed") opts.seed = std::strtoull(next().c_str(), nullptr, 10);
+        else if (arg == "--format") opts.format = next();
+        else {
+            usage();
+            return 2;
+        }
+    }
+    opts.connections = std::max<size_t>(opts.connections, 1);
+    opts.pipeline = std::max<size_t>(opts.pipeline, 1);
+    opts.batch = std::max<size_t>(opts.batch, 1);
+    opts.volumes = std::max<size_t>(opts.volumes, 1);
+    
+    // Self-hosted catalog when no daemon was named
+    Logger::instance().set_level(Logger::Level::WARNING);
+    std::filesystem::path root = std::filesystem::temp_directory_path() / "tms_loadgen";
+    std::unique_ptr<TMSSystem> catalog;
+    std::unique_ptr<RpcServer> server;
+    if (opts.socket_path.empty() && opts.tcp_port < 0) {
+        std::filesystem::remove_all(root);
+        CatalogSpec spec;
+        spec.volumes = opts.volumes;
+        spec.datasets = 0;
+        spec.seed = opts.seed;
+        catalog = std::make_unique<TMSSystem>((root / "catalog").string());
+        CatalogGenerator(spec).populate(*catalog);
+        server = std::make_unique<RpcServer>(*catalog);
+        RpcServerOptions server_options;
+        server_options.socket_path = (root / "tms.sock").string();
+        server_options.workers = opts.workers;
+        auto started = server->start(server_options);
+        if (!started) {
+            std::cerr << started.error().message << "\n";
+            return 1;
+        }
+        opts.socket_path = server_options.socket_path;
+    }
+    
+    std::vector<ConnectionResult> results(opts.connections);
+    std::vector<std::thread> threads;
+    auto start = Clock::now();
+    for (size_t c = 0; c < opts.connections; c++) {
+        size_t share = opts.ops / opts.connections + (c < opts.ops % opts.connections ? 1 : 0);
+        threads.emplace_back([&, c, share] { run_connection(opts, c, share, results[c]); });
+    }
+    for (auto& t : threads) t.join();
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    
+    size_t ops = 0;
+    size_t errors = 0;
+    std::vector<int64_t> latencies;
+    for (const auto& r : results) {
+        if (!r.failure.empty()) {
+            std::cerr << "Connection failed: " << r.failure << "\n";
+            return 1;
+        }
+        ops += r.ops;
+        errors += r.errors;
+        latencies.insert(latencies.end(), r.latencies_ns.begin(), r.latencies_ns.end());
+    }
+    std::sort(latencies.begin(), latencies.end());
+    double ops_per_sec = static_cast<double>(ops) / std::max(seconds, 1e-9);
+    
+    if (server) server->stop();
+    catalog.reset();
+    std::filesystem::remove_all(root);
+    
+    if (opts.format == "json") {
+        {
+            JsonWriter w(std::cout);
+            w.begin_object()
+                .field("benchmark", "rpc_load")
+                .field("version", VERSION_STRING)
+                .field("connections", opts.connections)
+                .field("pipeline", opts.pipeline)
+                .field("batch", opts.batch)
+                .field("write_percent", opts.write_percent)
+                .field("ops", ops)
+                .field("errors", errors)
+                .field("seconds", seconds)
+                .field("ops_per_sec", ops_per_sec)
+                .field("frames", latencies.size())
+                .field("p50_ns", percentile(latencies, 50))
+                .field("p90_ns", percentile(latencies, 90))
+                .field("p99_ns", percentile(latencies, 99))
+                .field("max_ns", percentile(latencies, 100))
+                .end_object();
+        }
+        std::cout << "\n";
+    } else {
+        auto us = [](int64_t ns) { return static_cast<double>(ns) / 1000.0; };
+        std::cout << "TMS RPC load (" << opts.connections << " connections, pipeline " << opts.pipeline
+                  << ", batch " << opts.batch << ", " << opts.write_percent << "% writes)\n"
+                  << std::fixed << std::setprecision(0)
+                  << "  ops:        " << ops << " (" << errors << " errors)\n"
+                  << "  ops/s:      " << ops_per_sec << "\n"
+                  << std::setprecision(1)
+                  << "  frame p50:  " << us(percentile(latencies, 50)) << " us\n"
+                  << "  frame p90:  " << us(percentile(latencies, 90)) << " us\n"
+                  << "  frame p99:  " << us(percentile(latencies, 99)) << " us\n"
+                  << "  frame max:  " << us(percentile(latencies, 100)) << " us\n";
+    }
+    return 0;
+}
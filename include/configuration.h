@@ -16,15 +16,82 @@
 #include <mutex>
 #include <functional>
 #include <optional>
+#include <memory>
+#include <atomic>
+#include <cstdint>
 
 namespace tms {
 
+/**
+ * @brief v3.4.0: Immutable view of the configuration
+ *
+ * Every change builds a new snapshot with the well-known keys already
+ * parsed, then publishes it atomically. Readers never lock; a snapshot
+ * obtained from Configuration::snapshot() stays valid and consistent
+ * for as long as it is held.
+ */
+struct ConfigSnapshot {
+    using SectionMap = std::map<std::string, std::map<std::string, std::string>>;
+    
+    SectionMap sections;
+    std::string config_path;
+    uint64_t generation = 0;
+    
+    // General
+    std::string data_directory;
+    size_t max_volumes = 0;
+    size_t max_datasets = 0;
+    bool auto_save = false;
+    int auto_save_interval = 0;
+    bool strict_validation = false;
+    
+    // Catalog
+    bool enable_compression = false;
+    bool enable_backup = false;
+    int backup_retention_days = 0;
+    std::string backup_directory;
+    
+    // Logging
+    std::string log_level;
+    bool log_to_file = false;
+    std::string log_file;
+    bool log_to_console = false;
+    size_t log_max_size = 0;
+    size_t log_max_files = 0;
+    
+    // Audit
+    bool enable_audit = false;
+    int audit_retention_days = 0;
+    std::string audit_file;
+    
+    // Performance
+    int lock_timeout_ms = 0;
+    int retry_count = 0;
+    int retry_delay_ms = 0;
+    size_t batch_size = 0;
+    int clock_resolution_ms = 0;    ///< Coarse clock period; 0 reads the system clock directly
+    bool lock_free_reads = false;   ///< Serve point lookups from published records
+    
+    // Daemon
+    std::string daemon_socket_path;
+    int daemon_tcp_port = -1;       ///< Loopback TCP port; -1 disables TCP
+    size_t daemon_workers = 0;
+    
+    /// Raw value lookup; nullptr if the key is not set
+    const std::string* find(const std::string& section, const std::string& key) const;
+};
+
 /**
  * @brief Configuration management with INI file support
+ *
+ * v3.4.0: Reads go through the current ConfigSnapshot (RCU-style) and
+ * never take a lock; writers serialize on a mutex, publish a new
+ * snapshot and notify callbacks after publishing.
  */
 class Configuration {
 public:
     using ChangeCallback = std::function<void(const std::string&, const std::string&)>;
+    using SectionMap = ConfigSnapshot::SectionMap;
     
     static Configuration& instance() {
         static Configuration config;
@@ -35,7 +102,10 @@ public:
     bool load_from_file(const std::string& path);
     bool save_to_file(const std::string& path) const;
     bool reload();
-    std::string get_config_path() const { return config_path_; }
+    std::string get_config_path() const;
+    
+    /// v3.4.0: Current snapshot, for several reads that must agree
+    std::shared_ptr<const ConfigSnapshot> snapshot() const { return snapshot_.load(std::memory_order_acquire); }
     
     // Getters - General
     std::string get_data_directory() const;
@@ -69,6 +139,13 @@ public:
     int get_retry_count() const;
     int get_retry_delay_ms() const;
     size_t get_batch_size() const;
+    int get_clock_resolution_ms() const;
+    bool get_lock_free_reads() const;
+    
+    // Getters - Daemon
+    std::string get_daemon_socket_path() const;
+    int get_daemon_tcp_port() const;
+    size_t get_daemon_workers() const;
     
     // Generic getters
     std::string get_string(const std::string& section, const std::string& key,
@@ -111,11 +188,15 @@ private:
     Configuration& operator=(const Configuration&) = delete;
     
     std::string expand_env_vars(const std::string& value) const;
-    void notify_change(const std::string& key, const std::string& value);
     
-    mutable std::mutex mutex_;
-    std::map<std::string, std::map<std::string, std::string>> sections_;
-    std::string config_path_;
+    // v3.4.0: Snapshot publication
+    const ConfigSnapshot& current() const;
+    void publish(SectionMap sections, std::string config_path);
+    bool update(const std::function<bool(SectionMap&, std::string&)>& edit);
+    
+    std::mutex mutex_;                              // Serializes writers only
+    std::atomic<std::shared_ptr<const ConfigSnapshot>> snapshot_;
+    std::atomic<uint64_t> generation_{0};
     std::map<std::string, std::vector<ChangeCallback>> callbacks_;
 };
 
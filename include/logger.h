@@ -201,6 +201,12 @@ public:
         counters_[name]++;
     }
     
+    // v3.4.0: Bulk operations add their whole count in one step
+    void increment_counter(const std::string& name, size_t amount) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        counters_[name] += amount;
+    }
+    
     void set_gauge(const std::string& name, long long value) {
         std::lock_guard<std::mutex> lock(mutex_);
         gauges_[name] = value;
@@ -0,0 +1,883 @@
+/**
+ * @file tms_async.h
+ * @brief TMS Tape Management System - Coroutine Tasks and Async Executor
+ * @version 3.4.0
+ * @author Bennie Shearer
+ * @copyright Copyright (c) 2025 Bennie Shearer
+ * @license MIT License
+ *
+ * The TMSSystem calls block their caller: catalog saves and backups wait on
+ * the disk and retry_operation() sleeps between attempts. Task<T> is a lazy
+ * C++20 coroutine, so a job can instead write co_await sys.save_catalog_async()
+ * and give its thread back while it waits. AsyncExecutor resumes coroutines
+ * on a small worker pool. Sleeps are timers, not sleeping threads. Whole-file
+ * reads and writes go through io_uring on Linux when the kernel allows it,
+ * and through a separate I/O thread pool otherwise. Calls that have no
+ * asynchronous form run on the I/O pool too, so they never hold a worker.
+ * A coroutine resumes with the OperationContext that was installed when
+ * it suspended.
+ */
+
+#ifndef TMS_ASYNC_H
+#define TMS_ASYNC_H
+
+#include "error_codes.h"
+#include "logger.h"
+#include "tms_context.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+    #define TMS_HAS_IO_URING 1
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <linux/io_uring.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <sys/syscall.h>
+    #include <sys/uio.h>
+    #include <unistd.h>
+#else
+    #define TMS_HAS_IO_URING 0
+#endif
+
+namespace tms {
+
+template<typename T = void> class Task;
+
+// ============================================================================
+// Task
+// ============================================================================
+
+namespace detail {
+
+struct TaskPromiseBase {
+    std::coroutine_handle<> continuation;
+    std::exception_ptr error;
+    
+    // Resumes whoever awaited the task, without growing the stack
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+        template<typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> h) const noexcept {
+            auto next = h.promise().continuation;
+            return next ? next : std::noop_coroutine();
+        }
+        void await_resume() const noexcept {}
+    };
+    
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+    void unhandled_exception() { error = std::current_exception(); }
+};
+
+template<typename T>
+struct TaskPromise : TaskPromiseBase {
+    std::optional<T> value;
+    
+    Task<T> get_return_object();
+    
+    template<typename U>
+    void return_value(U&& v) { value.emplace(std::forward<U>(v)); }
+    
+    T take() {
+        if (error) std::rethrow_exception(error);
+        return std::move(*value);
+    }
+};
+
+template<>
+struct TaskPromise<void> : TaskPromiseBase {
+    Task<void> get_return_object();
+    void return_void() {}
+    
+    void take() {
+        if (error) std::rethrow_exception(error);
+    }
+};
+
+}
+
+/**
+ * @brief Lazily started coroutine producing a T
+ *
+ * The body does not run until the task is awaited (or handed to
+ * sync_wait() or AsyncExecutor::spawn()). Exceptions thrown by the body
+ * are rethrown to the awaiter. A task can be awaited once.
+ */
+template<typename T>
+class [[nodiscard]] Task {
+public:
+    using promise_type = detail::TaskPromise<T>;
+    using handle_type = std::coroutine_handle<promise_type>;
+    
+    Task() = default;
+    explicit Task(handle_type handle) : handle_(handle) {}
+    Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (handle_) handle_.destroy();
+            handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    ~Task() {
+        if (handle_) handle_.destroy();
+    }
+    
+    bool valid() const { return static_cast<bool>(handle_); }
+    bool done() const { return handle_ && handle_.done(); }
+    
+    auto operator co_await() noexcept {
+        struct Awaiter {
+            handle_type handle;
+            bool await_ready() const noexcept { return handle.done(); }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+                handle.promise().continuation = awaiting;
+                return handle;
+            }
+            T await_resume() { return handle.promise().take(); }
+        };
+        return Awaiter{handle_};
+    }
+    
+private:
+    handle_type handle_;
+};
+
+namespace detail {
+
+template<typename T>
+Task<T> TaskPromise<T>::get_return_object() {
+    return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() {
+    return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+// Eagerly started coroutine that frees itself when it finishes
+struct DetachedCoroutine {
+    struct promise_type {
+        DetachedCoroutine get_return_object() const noexcept { return {}; }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+};
+
+template<typename T>
+struct SyncWaitState {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool done = false;
+    std::optional<std::conditional_t<std::is_void_v<T>, bool, T>> value;
+    std::exception_ptr error;
+};
+
+template<typename T>
+DetachedCoroutine sync_wait_runner(Task<T>& task, SyncWaitState<T>& state) {
+    try {
+        if constexpr (std::is_void_v<T>) {
+            co_await task;
+            state.value.emplace(true);
+        } else {
+            state.value.emplace(co_await task);
+        }
+    } catch (...) {
+        state.error = std::current_exception();
+    }
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.done = true;
+    state.cv.notify_all();
+}
+
+}
+
+/**
+ * @brief Run @p task to completion, blocking the calling thread
+ *
+ * For callers outside any coroutine (tests, the CLI). Never call it from
+ * an executor worker: the worker would wait on work queued behind it.
+ */
+template<typename T>
+T sync_wait(Task<T> task) {
+    detail::SyncWaitState<T> state;
+    detail::sync_wait_runner(task, state);
+    std::unique_lock<std::mutex> lock(state.mutex);
+    state.cv.wait(lock, [&state] { return state.done; });
+    if (state.error) std::rethrow_exception(state.error);
+    if constexpr (!std::is_void_v<T>) return std::move(*state.value);
+}
+
+// ============================================================================
+// io_uring
+// ============================================================================
+
+#if TMS_HAS_IO_URING
+
+namespace detail {
+
+/**
+ * @brief Minimal io_uring ring over the raw system calls
+ *
+ * submit() is called under the executor's submit lock and wait() only by
+ * its completion thread. Reads and writes use the vectored opcodes, which
+ * every io_uring kernel supports.
+ */
+class IoUring {
+public:
+    IoUring() = default;
+    IoUring(const IoUring&) = delete;
+    IoUring& operator=(const IoUring&) = delete;
+    
+    ~IoUring() {
+        if (sqes_) munmap(sqes_, sqes_size_);
+        if (cq_ring_ && cq_ring_ != sq_ring_) munmap(cq_ring_, cq_ring_size_);
+        if (sq_ring_) munmap(sq_ring_, sq_ring_size_);
+        if (fd_ >= 0) close(fd_);
+    }
+    
+    /// False when the kernel or a sandbox refuses io_uring
+    bool init(unsigned entries) {
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        fd_ = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+        if (fd_ < 0) return false;
+        
+        sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single_mmap) sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+        
+        sq_ring_ = map(sq_ring_size_, IORING_OFF_SQ_RING);
+        if (!sq_ring_) return false;
+        cq_ring_ = single_mmap ? sq_ring_ : map(cq_ring_size_, IORING_OFF_CQ_RING);
+        if (!cq_ring_) return false;
+        sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+        sqes_ = static_cast<io_uring_sqe*>(map(sqes_size_, IORING_OFF_SQES));
+        if (!sqes_) return false;
+        
+        auto* sq = static_cast<char*>(sq_ring_);
+        sq_head_ = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sq_mask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        auto* cq = static_cast<char*>(cq_ring_);
+        cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cq_mask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        entries_ = params.sq_entries;
+        return true;
+    }
+    
+    unsigned entries() const { return entries_; }
+    
+    /// Queue one operation and enter the kernel; false if it was not accepted
+    bool submit(uint8_t opcode, int fd, const iovec* iov, uint64_t offset, uint64_t user_data) {
+        unsigned tail = *sq_tail_;
+        unsigned head = std::atomic_ref<unsigned>(*sq_head_).load(std::memory_order_acquire);
+        if (tail - head >= entries_) return false;
+        
+        unsigned index = tail & sq_mask_;
+        io_uring_sqe& sqe = sqes_[index];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = opcode;
+        sqe.fd = fd;
+        sqe.addr = reinterpret_cast<uint64_t>(iov);
+        sqe.len = iov ? 1 : 0;
+        sqe.off = offset;
+        sqe.user_data = user_data;
+        sq_array_[index] = index;
+        std::atomic_ref<unsigned>(*sq_tail_).store(tail + 1, std::memory_order_release);
+        
+        // Enter until the kernel has taken everything up to the new tail, so
+        // nothing is left in the ring for a later call to push
+        while (true) {
+            unsigned queued = tail + 1 - std::atomic_ref<unsigned>(*sq_head_).load(std::memory_order_acquire);
+            if (queued == 0) return true;
+            long rc = syscall(__NR_io_uring_enter, fd_, queued, 0, 0, nullptr, 0);
+            if (rc > 0 || (rc < 0 && errno == EINTR)) continue;
+            // Refused (EAGAIN or EBUSY included) before reaching this entry:
+            // withdraw it so the caller can do the transfer another way
+            std::atomic_ref<unsigned>(*sq_tail_).store(tail, std::memory_order_release);
+            return false;
+        }
+    }
+    
+    /// Block for at least one completion, then hand each to fn(user_data, res)
+    template<typename Fn>
+    void wait(Fn&& fn) {
+        long rc = syscall(__NR_io_uring_enter, fd_, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+        if (rc < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY) return;
+        unsigned head = *cq_head_;
+        unsigned tail = std::atomic_ref<unsigned>(*cq_tail_).load(std::memory_order_acquire);
+        for (; head != tail; head++) {
+            const io_uring_cqe& cqe = cqes_[head & cq_mask_];
+            fn(cqe.user_data, cqe.res);
+        }
+        std::atomic_ref<unsigned>(*cq_head_).store(head, std::memory_order_release);
+    }
+    
+private:
+    void* map(size_t size, uint64_t offset) {
+        void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_,
+                       static_cast<off_t>(offset));
+        return p == MAP_FAILED ? nullptr : p;
+    }
+    
+    int fd_ = -1;
+    unsigned entries_ = 0;
+    void* sq_ring_ = nullptr;
+    void* cq_ring_ = nullptr;
+    size_t sq_ring_size_ = 0;
+    size_t cq_ring_size_ = 0;
+    io_uring_sqe* sqes_ = nullptr;
+    size_t sqes_size_ = 0;
+    unsigned* sq_head_ = nullptr;
+    unsigned* sq_tail_ = nullptr;
+    unsigned* sq_array_ = nullptr;
+    unsigned sq_mask_ = 0;
+    unsigned* cq_head_ = nullptr;
+    unsigned* cq_tail_ = nullptr;
+    unsigned cq_mask_ = 0;
+    io_uring_cqe* cqes_ = nullptr;
+};
+
+}
+
+#endif // TMS_HAS_IO_URING
+
+// ============================================================================
+// Executor
+// ============================================================================
+
+struct AsyncExecutorOptions {
+    size_t workers = 4;                 ///< Threads that resume coroutines
+    size_t io_threads = 2;              ///< Threads for blocking calls and fallback file I/O
+    bool use_io_uring = true;           ///< Ignored where io_uring is unavailable
+    unsigned io_queue_depth = 64;
+};
+
+struct AsyncExecutorStats {
+    std::string io_backend;             ///< "io_uring" or "thread_pool"
+    size_t workers = 0;
+    size_t io_threads = 0;
+    uint64_t resumptions = 0;           ///< Coroutine resumptions run by workers
+    uint64_t timers = 0;
+    uint64_t blocking_calls = 0;
+    uint64_t file_operations = 0;
+    uint64_t file_bytes = 0;
+};
+
+/**
+ * @brief Worker pool, timer queue and file I/O for Task coroutines
+ *
+ * Awaiting schedule(), sleep_for(), blocking(), read_file() or write_file()
+ * suspends the coroutine; it resumes on one of the executor's workers.
+ * The destructor ends pending sleeps early and waits until every suspended
+ * coroutine has been resumed, so objects those coroutines use must outlive
+ * the executor or the coroutines themselves.
+ */
+class AsyncExecutor {
+public:
+    using Clock = std::chrono::steady_clock;
+    
+    explicit AsyncExecutor(AsyncExecutorOptions options = AsyncExecutorOptions())
+        : options_(options) {
+        options_.workers = std::max<size_t>(options_.workers, 1);
+        options_.io_threads = std::max<size_t>(options_.io_threads, 1);
+#if TMS_HAS_IO_URING
+        if (options_.use_io_uring) {
+            auto ring = std::make_unique<detail::IoUring>();
+            if (ring->init(std::max(options_.io_queue_depth, 1u))) {
+                ring_ = std::move(ring);
+            } else {
+                TMS_LOG_INFO("AsyncExecutor", "io_uring unavailable; file I/O uses the thread pool");
+            }
+        }
+        if (ring_) completion_thread_ = std::thread([this] { completion_loop(); });
+#endif
+        for (size_t i = 0; i < options_.workers; i++) {
+            threads_.emplace_back([this] { worker_loop(workers_); });
+        }
+        for (size_t i = 0; i < options_.io_threads; i++) {
+            threads_.emplace_back([this] { worker_loop(io_pool_); });
+        }
+        timer_thread_ = std::thread([this] { timer_loop(); });
+    }
+    
+    ~AsyncExecutor() {
+        {
+            std::lock_guard<std::mutex> lock(timer_mutex_);
+            stopping_ = true;
+        }
+        timer_cv_.notify_all();
+        {
+            std::unique_lock<std::mutex> lock(idle_mutex_);
+            idle_cv_.wait(lock, [this] { return pending_.load(std::memory_order_acquire) == 0; });
+        }
+        timer_thread_.join();
+        workers_.stop();
+        io_pool_.stop();
+        for (auto& t : threads_) t.join();
+#if TMS_HAS_IO_URING
+        if (ring_) {
+            {
+                std::lock_guard<std::mutex> lock(ring_mutex_);
+                ring_->submit(IORING_OP_NOP, -1, nullptr, 0, 0);
+            }
+            completion_thread_.join();
+        }
+#endif
+    }
+    
+    AsyncExecutor(const AsyncExecutor&) = delete;
+    AsyncExecutor& operator=(const AsyncExecutor&) = delete;
+    
+    /// Process-wide executor with the default options
+    static std::shared_ptr<AsyncExecutor> shared() {
+        static std::shared_ptr<AsyncExecutor> instance = std::make_shared<AsyncExecutor>();
+        return instance;
+    }
+    
+    const AsyncExecutorOptions& options() const { return options_; }
+    bool uses_io_uring() const {
+#if TMS_HAS_IO_URING
+        return ring_ != nullptr;
+#else
+        return false;
+#endif
+    }
+    
+    AsyncExecutorStats stats() const {
+        AsyncExecutorStats s;
+        s.io_backend = uses_io_uring() ? "io_uring" : "thread_pool";
+        s.workers = options_.workers;
+        s.io_threads = options_.io_threads;
+        s.resumptions = resumptions_.load(std::memory_order_relaxed);
+        s.timers = timers_.load(std::memory_order_relaxed);
+        s.blocking_calls = blocking_calls_.load(std::memory_order_relaxed);
+        s.file_operations = file_operations_.load(std::memory_order_relaxed);
+        s.file_bytes = file_bytes_.load(std::memory_order_relaxed);
+        return s;
+    }
+    
+    /// Resume @p handle on a worker, with @p context installed if given
+    void post(std::coroutine_handle<> handle, std::shared_ptr<const OperationContext> context = nullptr) {
+        begin_work();
+        workers_.push([this, handle, context = std::move(context)]() mutable {
+            resumptions_.fetch_add(1, std::memory_order_relaxed);
+            if (!context) {
+                handle.resume();
+                return;
+            }
+            OperationScope scope(std::move(context));
+            handle.resume();
+        });
+    }
+    
+    /// Continue the awaiting coroutine on a worker
+    auto schedule() {
+        struct Awaiter {
+            AsyncExecutor* executor;
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> h) { executor->post(h, capture_operation_context()); }
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{this};
+    }
+    
+    /// Suspend for @p delay without holding a thread; ends early on shutdown
+    auto sleep_for(std::chrono::milliseconds delay) {
+        struct Awaiter {
+            AsyncExecutor* executor;
+            Clock::time_point deadline;
+            bool await_ready() const noexcept { return deadline <= Clock::now(); }
+            void await_suspend(std::coroutine_handle<> h) {
+                executor->add_timer(deadline, h, capture_operation_context());
+            }
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{this, Clock::now() + delay};
+    }
+    
+    /**
+     * @brief Run a blocking callable on the I/O pool
+     *
+     * The awaiting coroutine resumes on a worker with fn's result;
+     * exceptions thrown by fn are rethrown there. GCC 12 mishandles a
+     * lambda temporary that captures a std::string by value inside a
+     * co_await expression; capture by reference or name the lambda first.
+     */
+    template<typename Fn>
+    auto blocking(Fn fn) {
+        using R = std::invoke_result_t<Fn&>;
+        struct Awaiter {
+            AsyncExecutor* executor;
+            Fn fn;
+            std::optional<std::conditional_t<std::is_void_v<R>, bool, R>> value;
+            std::exception_ptr error;
+            
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> h) {
+                executor->blocking_calls_.fetch_add(1, std::memory_order_relaxed);
+                executor->run_on_io_pool([this, h, context = capture_operation_context()] {
+                    std::optional<OperationScope> scope;
+                    if (context) scope.emplace(context);
+                    try {
+                        if constexpr (std::is_void_v<R>) {
+                            fn();
+                            value.emplace(true);
+                        } else {
+                            value.emplace(fn());
+                        }
+                    } catch (...) {
+                        error = std::current_exception();
+                    }
+                    scope.reset();
+                    executor->post(h, context);
+                });
+            }
+            R await_resume() {
+                if (error) std::rethrow_exception(error);
+                if constexpr (!std::is_void_v<R>) return std::move(*value);
+            }
+        };
+        return Awaiter{this, std::move(fn), std::nullopt, nullptr};
+    }
+    
+    /// Start @p task on a worker without waiting for it; exceptions are logged
+    void spawn(Task<void> task) { run_detached(this, std::move(task)); }
+    
+    /**
+     * @brief Read a whole file
+     *
+     * Open and close are ordinary calls; the reads go through io_uring
+     * when the ring is up and through the I/O pool otherwise.
+     */
+    Task<Result<std::string>> read_file(std::string path) {
+#if TMS_HAS_IO_URING
+        if (ring_) {
+            int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) {
+                co_return Result<std::string>::err(errno == ENOENT ? TMSError::FILE_NOT_FOUND
+                                                                   : TMSError::FILE_OPEN_ERROR,
+                                                   "Cannot open: " + path);
+            }
+            struct stat st;
+            std::string data;
+            if (fstat(fd, &st) == 0 && st.st_size > 0) data.reserve(static_cast<size_t>(st.st_size) + 1);
+            int res = 0;
+            while (true) {
+                size_t offset = data.size();
+                data.resize(offset + IO_CHUNK_BYTES);
+                res = co_await io(IORING_OP_READV, fd, data.data() + offset, data.size() - offset, offset);
+                if (res <= 0) {
+                    data.resize(offset);
+                    break;
+                }
+                data.resize(offset + static_cast<size_t>(res));
+            }
+            ::close(fd);
+            if (res < 0) {
+                co_return Result<std::string>::err(TMSError::FILE_READ_ERROR,
+                                                   "Read failed: " + path + ": " + std::strerror(-res));
+            }
+            file_operations_.fetch_add(1, std::memory_order_relaxed);
+            file_bytes_.fetch_add(data.size(), std::memory_order_relaxed);
+            co_return Result<std::string>::ok(std::move(data));
+        }
+#endif
+        auto result = co_await blocking([&path]() -> Result<std::string> {
+            std::ifstream in(path, std::ios::binary);
+            if (!in.is_open()) return Result<std::string>::err(TMSError::FILE_NOT_FOUND, "Cannot open: " + path);
+            std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+            if (in.bad()) return Result<std::string>::err(TMSError::FILE_READ_ERROR, "Read failed: " + path);
+            return Result<std::string>::ok(std::move(data));
+        });
+        if (result.is_success()) {
+            file_operations_.fetch_add(1, std::memory_order_relaxed);
+            file_bytes_.fetch_add(result.value().size(), std::memory_order_relaxed);
+        }
+        co_return result;
+    }
+    
+    /// Create or replace @p path with @p data
+    Task<OperationResult> write_file(std::string path, std::string data) {
+#if TMS_HAS_IO_URING
+        if (ring_) {
+            int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+            if (fd < 0) co_return OperationResult::err(TMSError::FILE_OPEN_ERROR, "Cannot create: " + path);
+            size_t offset = 0;
+            int res = 0;
+            while (offset < data.size()) {
+                size_t length = std::min(data.size() - offset, IO_CHUNK_BYTES);
+                res = co_await io(IORING_OP_WRITEV, fd, data.data() + offset, length, offset);
+                if (res <= 0) break;
+                offset += static_cast<size_t>(res);
+            }
+            bool closed = ::close(fd) == 0;
+            if (offset < data.size() || !closed) {
+                co_return OperationResult::err(TMSError::FILE_WRITE_ERROR,
+                    "Write failed: " + path + (res < 0 ? std::string(": ") + std::strerror(-res) : ""));
+            }
+            file_operations_.fetch_add(1, std::memory_order_relaxed);
+            file_bytes_.fetch_add(data.size(), std::memory_order_relaxed);
+            co_return OperationResult::ok();
+        }
+#endif
+        size_t size = data.size();
+        auto result = co_await blocking([&path, &data]() -> OperationResult {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            if (!out.is_open()) return OperationResult::err(TMSError::FILE_OPEN_ERROR, "Cannot create: " + path);
+            out.write(data.data(), static_cast<std::streamsize>(data.size()));
+            out.close();
+            if (!out) return OperationResult::err(TMSError::FILE_WRITE_ERROR, "Write failed: " + path);
+            return OperationResult::ok();
+        });
+        if (result.is_success()) {
+            file_operations_.fetch_add(1, std::memory_order_relaxed);
+            file_bytes_.fetch_add(size, std::memory_order_relaxed);
+        }
+        co_return result;
+    }
+    
+private:
+    static constexpr size_t IO_CHUNK_BYTES = 1 << 20;
+    
+    // FIFO of work items served by one group of threads
+    class WorkQueue {
+    public:
+        void push(std::function<void()> fn) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                queue_.push_back(std::move(fn));
+            }
+            cv_.notify_one();
+        }
+        
+        /// False once stopped and drained
+        bool pop(std::function<void()>& fn) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+            if (queue_.empty()) return false;
+            fn = std::move(queue_.front());
+            queue_.pop_front();
+            return true;
+        }
+        
+        void stop() {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stop_ = true;
+            }
+            cv_.notify_all();
+        }
+    
+    private:
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        std::deque<std::function<void()>> queue_;
+        bool stop_ = false;
+    };
+    
+    struct Timer {
+        Clock::time_point deadline;
+        uint64_t sequence;
+        std::coroutine_handle<> handle;
+        std::shared_ptr<const OperationContext> context;
+        bool operator>(const Timer& other) const {
+            return deadline != other.deadline ? deadline > other.deadline : sequence > other.sequence;
+        }
+    };
+    
+    // Every suspended coroutine the executor owes a resumption is counted
+    // in pending_; the destructor waits for it to drain
+    void begin_work() { pending_.fetch_add(1, std::memory_order_acq_rel); }
+    void end_work() {
+        if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard<std::mutex> lock(idle_mutex_);
+            idle_cv_.notify_all();
+        }
+    }
+    
+    void worker_loop(WorkQueue& queue) {
+        std::function<void()> fn;
+        while (queue.pop(fn)) {
+            fn();
+            fn = nullptr;
+            end_work();
+        }
+    }
+    
+    void run_on_io_pool(std::function<void()> fn) {
+        begin_work();
+        io_pool_.push(std::move(fn));
+    }
+    
+    void add_timer(Clock::time_point deadline, std::coroutine_handle<> handle,
+                   std::shared_ptr<const OperationContext> context) {
+        begin_work();
+        timers_.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(timer_mutex_);
+            timer_queue_.push(Timer{deadline, timer_sequence_++, handle, std::move(context)});
+        }
+        timer_cv_.notify_one();
+    }
+    
+    void timer_loop() {
+        std::unique_lock<std::mutex> lock(timer_mutex_);
+        while (true) {
+            if (timer_queue_.empty()) {
+                if (stopping_ && pending_.load(std::memory_order_acquire) == 0) return;
+                // Sleeps started during shutdown still need this thread
+                timer_cv_.wait_for(lock, std::chrono::milliseconds(stopping_ ? 10 : 1000));
+                continue;
+            }
+            Timer next = timer_queue_.top();
+            if (!stopping_ && next.deadline > Clock::now()) {
+                timer_cv_.wait_until(lock, next.deadline);
+                continue;
+            }
+            timer_queue_.pop();
+            lock.unlock();
+            post(next.handle, std::move(next.context));
+            end_work();
+            lock.lock();
+        }
+    }
+
+#if TMS_HAS_IO_URING
+    // One read or write; user_data points at the awaiter
+    struct IoAwaiter {
+        AsyncExecutor* executor;
+        uint8_t opcode;
+        int fd;
+        iovec iov;
+        uint64_t offset;
+        int result = 0;
+        std::coroutine_handle<> handle;
+        std::shared_ptr<const OperationContext> context;
+        
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> h) {
+            handle = h;
+            context = capture_operation_context();
+            executor->begin_work();
+            bool submitted = false;
+            {
+                std::lock_guard<std::mutex> lock(executor->ring_mutex_);
+                if (executor->in_flight_ < executor->ring_->entries()) {
+                    submitted = executor->ring_->submit(opcode, fd, &iov, offset,
+                                                        reinterpret_cast<uint64_t>(this));
+                    if (submitted) executor->in_flight_++;
+                }
+            }
+            if (submitted) return;
+            // Ring full or refused: do this one transfer on the I/O pool.
+            // The coroutine may resume (and free this awaiter) before
+            // run_on_io_pool returns.
+            AsyncExecutor* exec = executor;
+            exec->run_on_io_pool([this] {
+                ssize_t n = opcode == IORING_OP_READV ? ::preadv(fd, &iov, 1, static_cast<off_t>(offset))
+                                                      : ::pwritev(fd, &iov, 1, static_cast<off_t>(offset));
+                result = n < 0 ? -errno : static_cast<int>(n);
+                executor->post(handle, std::move(context));
+            });
+            exec->end_work();
+        }
+        int await_resume() const noexcept { return result; }
+    };
+    
+    IoAwaiter io(uint8_t opcode, int fd, char* buffer, size_t length, uint64_t offset) {
+        return IoAwaiter{this, opcode, fd, iovec{buffer, length}, offset, 0, {}, nullptr};
+    }
+    
+    void completion_loop() {
+        bool running = true;
+        while (running) {
+            ring_->wait([this, &running](uint64_t user_data, int res) {
+                if (user_data == 0) {
+                    running = false;
+                    return;
+                }
+                // Taking ring_mutex_ orders this after the submitter's writes
+                auto* op = reinterpret_cast<IoAwaiter*>(user_data);
+                {
+                    std::lock_guard<std::mutex> lock(ring_mutex_);
+                    in_flight_--;
+                }
+                op->result = res;
+                post(op->handle, std::move(op->context));
+                end_work();
+            });
+        }
+    }
+    
+    std::unique_ptr<detail::IoUring> ring_;
+    std::mutex ring_mutex_;
+    unsigned in_flight_ = 0;                    // Guarded by ring_mutex_
+    std::thread completion_thread_;
+#endif
+    
+    static detail::DetachedCoroutine run_detached(AsyncExecutor* executor, Task<void> task) {
+        co_await executor->schedule();
+        try {
+            co_await task;
+        } catch (const std::exception& e) {
+            TMS_LOG_ERROR("AsyncExecutor", std::string("Spawned task failed: ") + e.what());
+        } catch (...) {
+            TMS_LOG_ERROR("AsyncExecutor", "Spawned task failed");
+        }
+    }
+    
+    AsyncExecutorOptions options_;
+    WorkQueue workers_;
+    WorkQueue io_pool_;
+    std::vector<std::thread> threads_;
+    
+    std::mutex timer_mutex_;
+    std::condition_variable timer_cv_;
+    std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> timer_queue_;
+    uint64_t timer_sequence_ = 0;
+    bool stopping_ = false;                     // Guarded by timer_mutex_
+    std::thread timer_thread_;
+    
+    std::atomic<int64_t> pending_{0};
+    std::mutex idle_mutex_;
+    std::condition_variable idle_cv_;
+    
+    std::atomic<uint64_t> resumptions_{0};
+    std::atomic<uint64_t> timers_{0};
+    std::atomic<uint64_t> blocking_calls_{0};
+    std::atomic<uint64_t> file_operations_{0};
+    std::atomic<uint64_t> file_bytes_{0};
+};
+
+} // namespace tms
+
+#endif // TMS_ASYNC_H
@@ -54,7 +54,7 @@ struct BackupInfo {
     std::string checksum;
     
     bool is_expired(std::chrono::hours max_age) const {
-        auto age = std::chrono::system_clock::now() - timestamp;
+        auto age = current_time() - timestamp;
         return age > max_age;
     }
 };
@@ -362,7 +362,7 @@ inline bool BackupManager::should_create_daily_backup() const {
     auto latest = get_latest_backup();
     if (!latest.has_value()) return true;
     
-    auto age = std::chrono::system_clock::now() - latest->timestamp;
+    auto age = current_time() - latest->timestamp;
     return age >= std::chrono::hours(24);
 }
 
@@ -375,7 +375,7 @@ inline bool BackupManager::should_create_weekly_backup() const {
             return a.timestamp < b.timestamp;
         });
     
-    auto age = std::chrono::system_clock::now() - latest->timestamp;
+    auto age = current_time() - latest->timestamp;
     return age >= std::chrono::hours(24 * 7) && is_weekly_backup_day();
 }
 
@@ -388,12 +388,12 @@ inline bool BackupManager::should_create_monthly_backup() const {
             return a.timestamp < b.timestamp;
         });
     
-    auto age = std::chrono::system_clock::now() - latest->timestamp;
+    auto age = current_time() - latest->timestamp;
     return age >= std::chrono::hours(24 * 28) && is_monthly_backup_day();
 }
 
 inline std::string BackupManager::generate_backup_filename(const std::string& type) const {
-    auto now = std::chrono::system_clock::now();
+    auto now = current_time();
     auto time_t_now = std::chrono::system_clock::to_time_t(now);
     std::tm tm_buf{};
 #if defined(_WIN32)
@@ -470,7 +470,7 @@ inline std::vector<BackupInfo> BackupManager::get_backups_to_delete() const {
         }
         
         case RotationScheme::DAILY: {
-            auto threshold = std::chrono::system_clock::now() -
+            auto threshold = current_time() -
                 std::chrono::hours(24 * config_.daily_retention_days);
             for (const auto& b : backups) {
                 if (b.timestamp < threshold) {
@@ -508,7 +508,7 @@ inline std::vector<BackupInfo> BackupManager::get_backups_to_delete() const {
 }
 
 inline bool BackupManager::is_weekly_backup_day() const {
-    auto now = std::chrono::system_clock::now();
+    auto now = current_time();
     auto time_t_now = std::chrono::system_clock::to_time_t(now);
     std::tm tm_buf{};
 #if defined(_WIN32)
@@ -520,7 +520,7 @@ inline bool BackupManager::is_weekly_backup_day() const {
 }
 
 inline bool BackupManager::is_monthly_backup_day() const {
-    auto now = std::chrono::system_clock::now();
+    auto now = current_time();
     auto time_t_now = std::chrono::system_clock::to_time_t(now);
     std::tm tm_buf{};
 #if defined(_WIN32)
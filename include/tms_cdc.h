@@ -0,0 +1,775 @@
+/**
+ * @file tms_cdc.h
+ * @brief TMS Tape Management System - Change Data Capture
+ * @version 3.4.0
+ * @author Bennie Shearer
+ * @copyright Copyright (c) 2025 Bennie Shearer
+ * @license MIT License
+ *
+ * TMSSystem hands every committed record change to a ChangeLog while it
+ * still holds the catalog write lock, so sequence numbers follow commit
+ * order. The log only queues the record on that path; a flusher thread
+ * appends batches to JSON Lines segment files, delivers them to
+ * subscribers and republishes them on the EventBus. Segments are bounded
+ * (oldest dropped first) and named consumers have their offsets persisted,
+ * so a consumer that restarts resumes where it left off.
+ */
+
+#ifndef TMS_CDC_H
+#define TMS_CDC_H
+
+#include "tms_types.h"
+#include "tms_json.h"
+#include "tms_events.h"
+#include "error_codes.h"
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <optional>
+#include <functional>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iterator>
+#include <string_view>
+
+namespace tms {
+
+// ============================================================================
+// Change Records
+// ============================================================================
+
+enum class ChangeEntity { VOLUME, DATASET, CATALOG };
+
+enum class ChangeOperation {
+    INSERT,
+    UPDATE,
+    DELETE,
+    RESYNC          ///< Changes were lost or the catalog was replaced; re-read it rather than apply changes
+};
+
+inline const char* change_entity_to_string(ChangeEntity entity) {
+    switch (entity) {
+        case ChangeEntity::VOLUME: return "volume";
+        case ChangeEntity::DATASET: return "dataset";
+        case ChangeEntity::CATALOG: return "catalog";
+    }
+    return "volume";
+}
+
+inline ChangeEntity string_to_change_entity(std::string_view s) {
+    if (s == "dataset") return ChangeEntity::DATASET;
+    if (s == "catalog") return ChangeEntity::CATALOG;
+    return ChangeEntity::VOLUME;
+}
+
+inline const char* change_operation_to_string(ChangeOperation op) {
+    switch (op) {
+        case ChangeOperation::INSERT: return "INSERT";
+        case ChangeOperation::UPDATE: return "UPDATE";
+        case ChangeOperation::DELETE: return "DELETE";
+        case ChangeOperation::RESYNC: return "RESYNC";
+    }
+    return "UPDATE";
+}
+
+inline ChangeOperation string_to_change_operation(std::string_view s) {
+    if (s == "INSERT") return ChangeOperation::INSERT;
+    if (s == "DELETE") return ChangeOperation::DELETE;
+    if (s == "RESYNC") return ChangeOperation::RESYNC;
+    return ChangeOperation::UPDATE;
+}
+
+/**
+ * @brief One committed change to a volume or dataset, or a RESYNC marker
+ *        (entity CATALOG, no key) written when the whole catalog is replaced
+ *        or handed to a subscriber whose changes were already deleted
+ */
+struct ChangeRecord {
+    uint64_t sequence = 0;                          ///< Monotonic across restarts
+    std::chrono::system_clock::time_point timestamp;///< Commit time
+    ChangeEntity entity = ChangeEntity::VOLUME;
+    ChangeOperation operation = ChangeOperation::UPDATE;
+    std::string key;                                ///< Volser or dataset name
+    EventType event = EventType::CUSTOM;            ///< Closest EventBus type
+    std::optional<TapeVolume> volume;               ///< After image (not for deletes)
+    std::optional<Dataset> dataset;                 ///< After image (not for deletes)
+    std::string user;                               ///< From the writer's OperationContext
+    std::string session_id;
+    std::string request_id;
+};
+
+using ChangeHandler = std::function<void(const std::vector<ChangeRecord>&)>;
+using ChangeSubscriptionId = uint64_t;
+
+/**
+ * @brief Change log settings
+ */
+struct ChangeLogOptions {
+    std::string directory;                          ///< Empty: <data directory>/cdc
+    size_t segment_records = 10000;                 ///< Records per segment file
+    size_t max_segments = 16;                       ///< Oldest segments beyond this are deleted
+    std::chrono::milliseconds flush_interval{5};    ///< Longest a change waits for its batch
+    size_t max_batch = 4096;                        ///< Flush early once this many are queued
+    bool publish_events = true;                     ///< Republish on EventBus::instance()
+};
+
+struct ChangeLogStats {
+    uint64_t first_sequence = 0;    ///< Oldest retained (0 when empty)
+    uint64_t last_sequence = 0;     ///< Newest appended
+    uint64_t written = 0;           ///< Records written this session
+    uint64_t batches = 0;           ///< Flushes this session
+    size_t segments = 0;
+    size_t subscribers = 0;
+};
+
+/**
+ * @brief Catalog image as of a change sequence, for seeding a replica
+ */
+struct CatalogSnapshot {
+    uint64_t sequence = 0;          ///< Newest change the image includes
+    std::vector<TapeVolume> volumes;
+    std::vector<Dataset> datasets;
+};
+
+// ============================================================================
+// Change Log
+// ============================================================================
+
+class ChangeLog {
+public:
+    ChangeLog() = default;
+    ~ChangeLog() { close(); }
+    
+    ChangeLog(const ChangeLog&) = delete;
+    ChangeLog& operator=(const ChangeLog&) = delete;
+    
+    /// Open (or reopen) the log in options.directory and start the flusher
+    OperationResult open(const ChangeLogOptions& options);
+    
+    /// Flush outstanding changes and stop the flusher
+    void close();
+    
+    bool is_open() const { return running_.load(); }
+    const ChangeLogOptions& options() const { return options_; }
+    
+    /// Queue a change; assigns and returns its sequence number
+    uint64_t append(ChangeRecord record);
+    
+    /// Block until everything appended so far is written and delivered
+    void flush();
+    
+    /// Sequence of the newest appended change (0 if none)
+    uint64_t last_sequence() const;
+    
+    /**
+     * @brief Deliver changes to @p handler on the flusher thread, in order
+     *
+     * Delivery starts at @p from if given, else after the consumer's
+     * committed offset, else with the next change. For a named consumer
+     * the offset is committed (and persisted) after each batch the handler
+     * returns from; a batch whose handler throws is redelivered. If changes
+     * the subscriber still needs were dropped with old segments, it gets a
+     * RESYNC marker whose sequence is the last one lost, then the rest.
+     */
+    ChangeSubscriptionId subscribe(const std::string& consumer, ChangeHandler handler,
+                                   std::optional<uint64_t> from = std::nullopt);
+    void unsubscribe(ChangeSubscriptionId id);
+    
+    /// Retained changes with sequence >= @p from, at most @p max
+    std::vector<ChangeRecord> read(uint64_t from, size_t max = 1000) const;
+    
+    /// Last sequence a consumer has processed (0 if none)
+    uint64_t committed_offset(const std::string& consumer) const;
+    void commit_offset(const std::string& consumer, uint64_t sequence);
+    
+    ChangeLogStats get_stats() const;
+    
+    static std::string to_json_line(const ChangeRecord& record);
+    static ChangeRecord from_json(const JsonValue& json);
+    
+private:
+    static ChangeRecord resync_marker(uint64_t through);
+    static JsonValue volume_to_json(const TapeVolume& vol);
+    static TapeVolume json_to_volume(const JsonValue& json);
+    static JsonValue dataset_to_json(const Dataset& ds);
+    static Dataset json_to_dataset(const JsonValue& json);
+    
+    struct Subscriber {
+        ChangeSubscriptionId id = 0;
+        std::string consumer;
+        ChangeHandler handler;
+        uint64_t next = 0;      ///< Next sequence to deliver
+    };
+    
+    void run();
+    void write_batch(const std::vector<ChangeRecord>& batch);
+    void deliver(const std::vector<ChangeRecord>& batch);
+    void publish_events(const std::vector<ChangeRecord>& batch) const;
+    void save_offsets();
+    void load_offsets();
+    std::string segment_path(uint64_t first) const;
+    std::vector<std::pair<uint64_t, std::string>> list_segments() const;
+    
+    ChangeLogOptions options_;
+    
+    // Queue: appenders and the flusher
+    mutable std::mutex queue_mutex_;
+    std::condition_variable queue_cv_;
+    std::condition_variable flushed_cv_;
+    std::vector<ChangeRecord> pending_;
+    uint64_t next_sequence_ = 1;
+    uint64_t delivered_through_ = 0;
+    bool stopping_ = false;
+    bool wake_ = false;
+    
+    // Flusher state: segments, subscribers, offsets
+    mutable std::mutex log_mutex_;
+    std::ofstream segment_;
+    size_t segment_count_ = 0;
+    std::vector<Subscriber> subscribers_;
+    std::map<std::string, uint64_t> offsets_;
+    ChangeSubscriptionId next_subscriber_ = 1;
+    uint64_t written_ = 0;
+    uint64_t batches_ = 0;
+    
+    std::thread flusher_;
+    std::atomic<bool> running_{false};
+};
+
+// ============================================================================
+// Implementation
+// ============================================================================
+
+inline std::string ChangeLog::to_json_line(const ChangeRecord& record) {
+    std::ostringstream oss;
+    {
+        JsonWriter w(oss);
+        w.begin_object()
+            .field("seq", record.sequence)
+            .field("ts", std::chrono::duration_cast<std::chrono::microseconds>(
+                record.timestamp.time_since_epoch()).count())
+            .field("entity", change_entity_to_string(record.entity))
+            .field("op", change_operation_to_string(record.operation))
+            .field("key", record.key)
+            .field("event", event_type_to_string(record.event));
+        if (!record.user.empty()) w.field("user", record.user);
+        if (!record.session_id.empty()) w.field("session", record.session_id);
+        if (!record.request_id.empty()) w.field("request", record.request_id);
+        if (record.volume) w.key("volume").value(volume_to_json(*record.volume));
+        if (record.dataset) w.key("dataset").value(dataset_to_json(*record.dataset));
+        w.end_object();
+    }
+    return oss.str();
+}
+
+inline ChangeRecord ChangeLog::from_json(const JsonValue& json) {
+    ChangeRecord record;
+    record.sequence = json["seq"].as_uint64();
+    record.timestamp = std::chrono::system_clock::time_point(
+        std::chrono::microseconds(json["ts"].as_int64()));
+    record.entity = string_to_change_entity(json["entity"].as_string());
+    record.operation = string_to_change_operation(json["op"].as_string());
+    record.key = json["key"].as_string();
+    record.event = string_to_event_type(json["event"].as_string());
+    if (json.contains("user")) record.user = json["user"].as_string();
+    if (json.contains("session")) record.session_id = json["session"].as_string();
+    if (json.contains("request")) record.request_id = json["request"].as_string();
+    if (json.contains("volume")) record.volume = json_to_volume(json["volume"]);
+    if (json.contains("dataset")) record.dataset = json_to_dataset(json["dataset"]);
+    return record;
+}
+
+// After images are the exchange format plus the server-kept state it leaves
+// out, so a record read back from a segment (by a follower catching up, for
+// one) restores the whole record
+inline JsonValue ChangeLog::volume_to_json(const TapeVolume& vol) {
+    JsonValue json = TmsJsonConverter::volume_to_json(vol);
+    json["storage_tier"] = storage_tier_to_string(vol.storage_tier);
+    json["media_type"] = vol.media_type.str();
+    json["reservation_expires"] = format_time(vol.reservation_expires);
+    json["last_access_date"] = format_time(vol.last_access_date);
+    json["last_health_check"] = format_time(vol.last_health_check);
+    json["read_error_count"] = vol.read_error_count;
+    json["write_error_count"] = vol.write_error_count;
+    
+    JsonArray moves;
+    for (const auto& entry : vol.location_history) {
+        JsonObject move;
+        move["location"] = entry.location.str();
+        move["timestamp"] = format_time(entry.timestamp);
+        move["moved_by"] = entry.moved_by;
+        move["reason"] = entry.reason;
+        moves.push_back(JsonValue(std::move(move)));
+    }
+    json["location_history"] = std::move(moves);
+    
+    const VolumeHealthScore& health = vol.health_score;
+    JsonObject score;
+    score["overall"] = health.overall_score;
+    score["status"] = health_status_to_string(health.status);
+    score["error_rate"] = health.error_rate_score;
+    score["age"] = health.age_score;
+    score["usage"] = health.usage_score;
+    score["capacity"] = health.capacity_score;
+    score["last_calculated"] = format_time(health.last_calculated);
+    JsonArray recommendations;
+    for (const auto& text : health.recommendations) recommendations.push_back(text);
+    score["recommendations"] = std::move(recommendations);
+    json["health"] = JsonValue(std::move(score));
+    
+    JsonObject encryption;
+    encryption["encrypted"] = vol.encryption.encrypted;
+    encryption["algorithm"] = encryption_algorithm_to_string(vol.encryption.algorithm);
+    encryption["key_id"] = vol.encryption.key_id;
+    encryption["key_label"] = vol.encryption.key_label;
+    encryption["encrypted_date"] = format_time(vol.encryption.encrypted_date);
+    encryption["encrypted_by"] = vol.encryption.encrypted_by;
+    json["encryption"] = JsonValue(std::move(encryption));
+    return json;
+}
+
+inline TapeVolume ChangeLog::json_to_volume(const JsonValue& json) {
+    TapeVolume vol = TmsJsonConverter::json_to_volume(json);
+    auto time = [&](const JsonValue& value) { return parse_time(std::string(value.as_string())); };
+    if (json.contains("last_used")) vol.last_used = time(json["last_used"]);
+    if (json.contains("storage_tier")) vol.storage_tier = string_to_storage_tier(std::string(json["storage_tier"].as_string()));
+    if (json.contains("media_type")) vol.media_type = json["media_type"].as_string();
+    if (json.contains("reservation_expires")) vol.reservation_expires = time(json["reservation_expires"]);
+    if (json.contains("last_access_date")) vol.last_access_date = time(json["last_access_date"]);
+    if (json.contains("last_health_check")) vol.last_health_check = time(json["last_health_check"]);
+    if (json.contains("read_error_count")) vol.read_error_count = json["read_error_count"].as_int();
+    if (json.contains("write_error_count")) vol.write_error_count = json["write_error_count"].as_int();
+    
+    if (json.contains("location_history")) {
+        const JsonValue& moves = json["location_history"];
+        for (size_t i = 0; i < moves.size(); i++) {
+            LocationHistoryEntry entry;
+            entry.location = moves[i]["location"].as_string();
+            entry.timestamp = time(moves[i]["timestamp"]);
+            entry.moved_by = moves[i]["moved_by"].as_string();
+            entry.reason = moves[i]["reason"].as_string();
+            vol.location_history.push_back(std::move(entry));
+        }
+    }
+    if (json.contains("health")) {
+        const JsonValue& score = json["health"];
+        VolumeHealthScore& health = vol.health_score;
+        health.overall_score = score["overall"].as_number();
+        health.status = string_to_health_status(std::string(score["status"].as_string()));
+        health.error_rate_score = score["error_rate"].as_number();
+        health.age_score = score["age"].as_number();
+        health.usage_score = score["usage"].as_number();
+        health.capacity_score = score["capacity"].as_number();
+        health.last_calculated = time(score["last_calculated"]);
+        for (size_t i = 0; i < score["recommendations"].size(); i++) {
+            health.recommendations.emplace_back(score["recommendations"][i].as_string());
+        }
+    }
+    if (json.contains("encryption")) {
+        const JsonValue& encryption = json["encryption"];
+        vol.encryption.encrypted = encryption["encrypted"].as_bool();
+        vol.encryption.algorithm = string_to_encryption_algorithm(std::string(encryption["algorithm"].as_string()));
+        vol.encryption.key_id = encryption["key_id"].as_string();
+        vol.encryption.key_label = encryption["key_label"].as_string();
+        vol.encryption.encrypted_date = time(encryption["encrypted_date"]);
+        vol.encryption.encrypted_by = encryption["encrypted_by"].as_string();
+    }
+    return vol;
+}
+
+inline JsonValue ChangeLog::dataset_to_json(const Dataset& ds) {
+    JsonValue json = TmsJsonConverter::dataset_to_json(ds);
+    json["compressed"] = ds.compressed;
+    json["compression_type"] = ds.compression_type;
+    json["original_size_bytes"] = ds.original_size_bytes;
+    json["access_count"] = ds.access_count;
+    return json;
+}
+
+inline Dataset ChangeLog::json_to_dataset(const JsonValue& json) {
+    Dataset ds = TmsJsonConverter::json_to_dataset(json);
+    if (json.contains("compressed")) ds.compressed = json["compressed"].as_bool();
+    if (json.contains("compression_type")) ds.compression_type = json["compression_type"].as_string();
+    if (json.contains("original_size_bytes")) ds.original_size_bytes = json["original_size_bytes"].as_uint64();
+    if (json.contains("access_count")) ds.access_count = json["access_count"].as_int();
+    return ds;
+}
+
+inline std::string ChangeLog::segment_path(uint64_t first) const {
+    char name[40];
+    std::snprintf(name, sizeof(name), "changes-%020llu.jsonl", static_cast<unsigned long long>(first));
+    return (std::filesystem::path(options_.directory) / name).string();
+}
+
+// Segments as (first sequence, path), oldest first
+inline std::vector<std::pair<uint64_t, std::string>> ChangeLog::list_segments() const {
+    std::vector<std::pair<uint64_t, std::string>> segments;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(options_.directory, ec)) {
+        std::string name = entry.path().filename().string();
+        if (name.rfind("changes-", 0) != 0 || entry.path().extension() != ".jsonl") continue;
+        segments.emplace_back(std::strtoull(name.c_str() + 8, nullptr, 10), entry.path().string());
+    }
+    std::sort(segments.begin(), segments.end());
+    return segments;
+}
+
+inline OperationResult ChangeLog::open(const ChangeLogOptions& options) {
+    close();
+    options_ = options;
+    options_.segment_records = std::max<size_t>(options_.segment_records, 1);
+    options_.max_segments = std::max<size_t>(options_.max_segments, 1);
+    
+    std::error_code ec;
+    std::filesystem::create_directories(options_.directory, ec);
+    if (ec) {
+        return OperationResult::err(TMSError::FILE_WRITE_ERROR,
+                                    "Cannot create change log directory: " + options_.directory);
+    }
+    
+    // Continue numbering after the newest retained record. A torn final
+    // write is cut off at the last newline so appends start on a clean line.
+    uint64_t last = 0;
+    auto segments = list_segments();
+    if (!segments.empty()) {
+        const std::string& path = segments.back().second;
+        std::string content;
+        {
+            std::ifstream in(path, std::ios::binary);
+            content.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        }
+        size_t complete = content.rfind('\n');
+        complete = complete == std::string::npos ? 0 : complete + 1;
+        if (complete < content.size()) {
+            std::filesystem::resize_file(path, complete, ec);
+            if (ec) {
+                return OperationResult::err(TMSError::FILE_WRITE_ERROR,
+                                            "Cannot repair change log segment: " + path);
+            }
+        }
+        
+        size_t lines = 0;
+        for (size_t pos = 0; pos < complete;) {
+            size_t end = content.find('\n', pos);
+            std::string_view line(content.data() + pos, end - pos);
+            pos = end + 1;
+            if (line.empty()) continue;
+            try {
+                last = std::max(last, JsonSerializer::parse(line)["seq"].as_uint64());
+                lines++;
+            } catch (const std::exception&) {
+                // Damaged line; read() skips it as well
+            }
+        }
+        last = std::max(last, segments.back().first - 1);
+        segment_count_ = lines;
+        segment_.open(path, std::ios::app);
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(log_mutex_);
+        load_offsets();
+        subscribers_.clear();
+        written_ = 0;
+        batches_ = 0;
+    }
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        pending_.clear();
+        next_sequence_ = last + 1;
+        delivered_through_ = last;
+        stopping_ = false;
+        wake_ = false;
+    }
+    running_.store(true);
+    flusher_ = std::thread([this] { run(); });
+    return OperationResult::ok();
+}
+
+inline void ChangeLog::close() {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        stopping_ = true;
+    }
+    queue_cv_.notify_all();
+    if (flusher_.joinable()) flusher_.join();
+    running_.store(false);
+    
+    std::lock_guard<std::mutex> lock(log_mutex_);
+    if (segment_.is_open()) segment_.close();
+    segment_count_ = 0;
+}
+
+inline uint64_t ChangeLog::append(ChangeRecord record) {
+    std::unique_lock<std::mutex> lock(queue_mutex_);
+    record.sequence = next_sequence_++;
+    pending_.push_back(std::move(record));
+    bool full = pending_.size() >= options_.max_batch;
+    uint64_t sequence = next_sequence_ - 1;
+    lock.unlock();
+    if (full) queue_cv_.notify_one();
+    return sequence;
+}
+
+inline void ChangeLog::flush() {
+    std::unique_lock<std::mutex> lock(queue_mutex_);
+    if (!running_.load()) return;
+    uint64_t target = next_sequence_ - 1;
+    wake_ = true;
+    queue_cv_.notify_one();
+    flushed_cv_.wait(lock, [&] { return delivered_through_ >= target || !running_.load(); });
+}
+
+inline void ChangeLog::run() {
+    std::vector<ChangeRecord> batch;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex_);
+            queue_cv_.wait_for(lock, options_.flush_interval, [this] {
+                return stopping_ || wake_ || pending_.size() >= options_.max_batch;
+            });
+            wake_ = false;
+            batch.swap(pending_);
+            if (batch.empty() && stopping_) break;
+        }
+        
+        write_batch(batch);
+        deliver(batch);
+        if (options_.publish_events) publish_events(batch);
+        
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            if (!batch.empty()) delivered_through_ = batch.back().sequence;
+        }
+        flushed_cv_.notify_all();
+        batch.clear();
+    }
+    flushed_cv_.notify_all();
+}
+
+inline void ChangeLog::write_batch(const std::vector<ChangeRecord>& batch) {
+    if (batch.empty()) return;
+    std::lock_guard<std::mutex> lock(log_mutex_);
+    for (const auto& record : batch) {
+        if (!segment_.is_open() || segment_count_ >= options_.segment_records) {
+            if (segment_.is_open()) segment_.close();
+            segment_.open(segment_path(record.sequence), std::ios::app);
+            segment_count_ = 0;
+            
+            auto segments = list_segments();
+            for (size_t i = 0; i + options_.max_segments < segments.size(); i++) {
+                std::error_code ec;
+                std::filesystem::remove(segments[i].second, ec);
+            }
+        }
+        segment_ << to_json_line(record) << '\n';
+        segment_count_++;
+    }
+    segment_.flush();
+    written_ += batch.size();
+    batches_++;
+}
+
+// Runs on the flusher thread, so subscribers see batches in sequence order;
+// a subscriber behind the batch is first caught up from the segments
+inline void ChangeLog::deliver(const std::vector<ChangeRecord>& batch) {
+    std::vector<Subscriber> subscribers;
+    {
+        std::lock_guard<std::mutex> lock(log_mutex_);
+        subscribers = subscribers_;
+    }
+    uint64_t batch_first = batch.empty() ? 0 : batch.front().sequence;
+    uint64_t batch_last = batch.empty() ? 0 : batch.back().sequence;
+    
+    bool offsets_changed = false;
+    for (auto& sub : subscribers) {
+        uint64_t next = sub.next;
+        try {
+            // Catch up from disk until reaching the live batch
+            uint64_t limit = batch.empty() ? UINT64_MAX : batch_first;
+            while (next < limit) {
+                auto backlog = read(next, options_.max_batch);
+                while (!backlog.empty() && backlog.back().sequence >= limit) backlog.pop_back();
+                // Changes from `next` went with deleted segments; say so rather
+                // than skip them, so the subscriber knows to re-read the catalog
+                uint64_t held = backlog.empty() ? limit : backlog.front().sequence;
+                if (held != UINT64_MAX && held > std::max<uint64_t>(next, 1)) {
+                    sub.handler({resync_marker(held - 1)});
+                    next = held;
+                }
+                if (backlog.empty()) break;
+                sub.handler(backlog);
+                next = backlog.back().sequence + 1;
+            }
+            if (!batch.empty() && next <= batch_last) {
+                if (next <= batch_first) {
+                    sub.handler(batch);
+                } else {
+                    sub.handler(std::vector<ChangeRecord>(
+                        batch.begin() + static_cast<std::ptrdiff_t>(next - batch_first), batch.end()));
+                }
+                next = batch_last + 1;
+            }
+        } catch (...) {
+            // Redelivered from `next` on the next flush
+        }
+        if (next == sub.next) continue;
+        
+        std::lock_guard<std::mutex> lock(log_mutex_);
+        for (auto& live : subscribers_) {
+            if (live.id == sub.id) live.next = next;
+        }
+        if (!sub.consumer.empty()) {
+            offsets_[sub.consumer] = next - 1;
+            offsets_changed = true;
+        }
+    }
+    if (offsets_changed) {
+        std::lock_guard<std::mutex> lock(log_mutex_);
+        save_offsets();
+    }
+}
+
+inline ChangeRecord ChangeLog::resync_marker(uint64_t through) {
+    ChangeRecord marker;
+    marker.sequence = through;
+    marker.timestamp = std::chrono::system_clock::now();
+    marker.entity = ChangeEntity::CATALOG;
+    marker.operation = ChangeOperation::RESYNC;
+    marker.event = EventType::CATALOG_LOADED;
+    return marker;
+}
+
+inline void ChangeLog::publish_events(const std::vector<ChangeRecord>& batch) const {
+    auto& bus = EventBus::instance();
+    for (const auto& record : batch) {
+        Event event(record.event, "TMSSystem", record.key, change_operation_to_string(record.operation));
+        event.timestamp = record.timestamp;
+        event.with_data("cdc_sequence", std::to_string(record.sequence));
+        bus.publish(event);
+    }
+}
+
+inline ChangeSubscriptionId ChangeLog::subscribe(const std::string& consumer, ChangeHandler handler,
+                                                 std::optional<uint64_t> from) {
+    uint64_t next_live;
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        next_live = next_sequence_;
+    }
+    ChangeSubscriptionId id;
+    {
+        std::lock_guard<std::mutex> lock(log_mutex_);
+        Subscriber sub;
+        sub.id = id = next_subscriber_++;
+        sub.consumer = consumer;
+        sub.handler = std::move(handler);
+        auto committed = offsets_.find(consumer);
+        if (from) sub.next = *from;
+        else if (!consumer.empty() && committed != offsets_.end()) sub.next = committed->second + 1;
+        else sub.next = next_live;
+        subscribers_.push_back(std::move(sub));
+    }
+    // Let the flusher deliver any backlog without waiting for new changes
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        wake_ = true;
+    }
+    queue_cv_.notify_one();
+    return id;
+}
+
+inline void ChangeLog::unsubscribe(ChangeSubscriptionId id) {
+    std::lock_guard<std::mutex> lock(log_mutex_);
+    subscribers_.erase(std::remove_if(subscribers_.begin(), subscribers_.end(),
+        [id](const Subscriber& s) { return s.id == id; }), subscribers_.end());
+}
+
+inline std::vector<ChangeRecord> ChangeLog::read(uint64_t from, size_t max) const {
+    std::vector<ChangeRecord> result;
+    auto segments = list_segments();
+    for (size_t i = 0; i < segments.size() && result.size() < max; i++) {
+        // Skip segments that end before `from`
+        if (i + 1 < segments.size() && segments[i + 1].first <= from) continue;
+        std::ifstream in(segments[i].second);
+        std::string line;
+        while (result.size() < max && std::getline(in, line)) {
+            if (line.empty()) continue;
+            try {
+                JsonValue json = JsonSerializer::parse(line);
+                if (json["seq"].as_uint64() < from) continue;
+                result.push_back(from_json(json));
+            } catch (const std::exception&) {
+                continue;  // Damaged line; later records are still readable
+            }
+        }
+    }
+    return result;
+}
+
+inline uint64_t ChangeLog::committed_offset(const std::string& consumer) const {
+    std::lock_guard<std::mutex> lock(log_mutex_);
+    auto it = offsets_.find(consumer);
+    return it != offsets_.end() ? it->second : 0;
+}
+
+inline void ChangeLog::commit_offset(const std::string& consumer, uint64_t sequence) {
+    std::lock_guard<std::mutex> lock(log_mutex_);
+    offsets_[consumer] = sequence;
+    save_offsets();
+}
+
+// Written to a temporary file and renamed so a crash never leaves a torn file
+inline void ChangeLog::save_offsets() {
+    auto path = std::filesystem::path(options_.directory) / "offsets.dat";
+    auto tmp = path;
+    tmp += ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::trunc);
+        for (const auto& [consumer, offset] : offsets_) out << consumer << ' ' << offset << '\n';
+        if (!out.good()) return;
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, path, ec);
+}
+
+inline void ChangeLog::load_offsets() {
+    offsets_.clear();
+    std::ifstream in(std::filesystem::path(options_.directory) / "offsets.dat");
+    std::string consumer;
+    uint64_t offset = 0;
+    while (in >> consumer >> offset) offsets_[consumer] = offset;
+}
+
+inline uint64_t ChangeLog::last_sequence() const {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    return next_sequence_ - 1;
+}
+
+inline ChangeLogStats ChangeLog::get_stats() const {
+    ChangeLogStats stats;
+    auto segments = list_segments();
+    stats.segments = segments.size();
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        stats.last_sequence = next_sequence_ - 1;
+    }
+    if (!segments.empty()) stats.first_sequence = segments.front().first;
+    std::lock_guard<std::mutex> lock(log_mutex_);
+    stats.written = written_;
+    stats.batches = batches_;
+    stats.subscribers = subscribers_.size();
+    return stats;
+}
+
+} // namespace tms
+
+#endif // TMS_CDC_H
@@ -0,0 +1,234 @@
+/**
+ * @file tms_clock.h
+ * @brief TMS Tape Management System - Clock Abstraction
+ * @version 3.4.0
+ * @author Bennie Shearer
+ * @copyright Copyright (c) 2025 Bennie Shearer
+ * @license MIT License
+ *
+ * All catalog time reads (expiration, reservations, ages, health, retention,
+ * backup rotation, statistics history) go through current_time(), which
+ * reads the installed TimeSource or falls back to the system clock.
+ * Installing a SimulatedClock lets lifecycle behaviour spanning years be
+ * exercised in seconds. The clock is process-wide because record predicates such as
+ * TapeVolume::is_expired() have no system to consult; loops over many
+ * records read it once and pass the time point to the explicit overloads.
+ * Where per-call precision is not needed, enable_coarse_clock() swaps the
+ * system clock for one refreshed by a background ticker.
+ */
+
+#ifndef TMS_CLOCK_H
+#define TMS_CLOCK_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+namespace tms {
+
+// ============================================================================
+// Clocks
+// ============================================================================
+
+/**
+ * @brief Source of wall-clock time for catalog logic
+ */
+class TimeSource {
+public:
+    using time_point = std::chrono::system_clock::time_point;
+    using duration = std::chrono::system_clock::duration;
+    
+    virtual ~TimeSource() = default;
+    virtual time_point now() const = 0;
+};
+
+namespace detail {
+inline std::atomic<const TimeSource*> installed_clock{nullptr};
+
+/// Uninstall @p clock if it is the installed one
+inline void uninstall_clock(const TimeSource* clock) {
+    installed_clock.compare_exchange_strong(clock, nullptr, std::memory_order_acq_rel);
+}
+}
+
+/**
+ * @brief The real system clock
+ */
+class SystemTimeSource final : public TimeSource {
+public:
+    time_point now() const override { return std::chrono::system_clock::now(); }
+};
+
+/**
+ * @brief Manually driven clock for simulation and tests
+ *
+ * Time only moves when advance() or set() is called; both are safe to call
+ * while other threads read the clock.
+ */
+class SimulatedClock final : public TimeSource {
+public:
+    explicit SimulatedClock(time_point start = std::chrono::system_clock::now())
+        : ticks_(start.time_since_epoch().count()) {}
+    
+    time_point now() const override {
+        return time_point(duration(ticks_.load(std::memory_order_acquire)));
+    }
+    
+    /// Move time forward by @p delta and return the new time
+    time_point advance(duration delta) {
+        auto ticks = ticks_.fetch_add(delta.count(), std::memory_order_acq_rel) + delta.count();
+        return time_point(duration(ticks));
+    }
+    
+    void set(time_point when) {
+        ticks_.store(when.time_since_epoch().count(), std::memory_order_release);
+    }
+
+private:
+    std::atomic<duration::rep> ticks_;
+};
+
+/**
+ * @brief System time sampled by a background ticker
+ *
+ * now() is a single atomic load and may lag the system clock by up to one
+ * resolution period; use it where millisecond precision is plenty, such as
+ * expiration and reservation checks.
+ */
+class CoarseClock final : public TimeSource {
+public:
+    CoarseClock() { tick(); }
+    ~CoarseClock() {
+        detail::uninstall_clock(this);
+        stop();
+    }
+    
+    CoarseClock(const CoarseClock&) = delete;
+    CoarseClock& operator=(const CoarseClock&) = delete;
+    
+    time_point now() const override {
+        return time_point(duration(ticks_.load(std::memory_order_acquire)));
+    }
+    
+    /// Start (or restart) ticking every @p resolution
+    void start(std::chrono::milliseconds resolution) {
+        stop();
+        std::lock_guard<std::mutex> lock(mutex_);
+        resolution_ = std::max(resolution, std::chrono::milliseconds(1));
+        stopping_ = false;
+        tick();
+        ticker_ = std::thread([this] {
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (!cv_.wait_for(lock, resolution_, [this] { return stopping_; })) {
+                tick();
+            }
+        });
+    }
+    
+    void stop() {
+        std::thread ticker;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+            ticker = std::move(ticker_);
+        }
+        cv_.notify_all();
+        if (ticker.joinable()) ticker.join();
+    }
+    
+    bool running() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return ticker_.joinable();
+    }
+    
+    std::chrono::milliseconds resolution() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return resolution_;
+    }
+
+private:
+    void tick() {
+        ticks_.store(std::chrono::system_clock::now().time_since_epoch().count(),
+                     std::memory_order_release);
+    }
+    
+    std::atomic<duration::rep> ticks_{0};
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::thread ticker_;
+    std::chrono::milliseconds resolution_{10};
+    bool stopping_ = false;
+};
+
+// ============================================================================
+// Installed Clock
+// ============================================================================
+
+/**
+ * @brief Install @p clock for all catalog time reads; nullptr restores the system clock
+ *
+ * The clock is not owned and must outlive its installation.
+ * @return The previously installed clock (nullptr for the system clock)
+ */
+inline const TimeSource* set_clock(const TimeSource* clock) {
+    return detail::installed_clock.exchange(clock, std::memory_order_acq_rel);
+}
+
+inline const TimeSource* get_clock() {
+    return detail::installed_clock.load(std::memory_order_acquire);
+}
+
+/**
+ * @brief Current time from the installed clock
+ */
+inline std::chrono::system_clock::time_point current_time() {
+    const TimeSource* clock = detail::installed_clock.load(std::memory_order_acquire);
+    return clock ? clock->now() : std::chrono::system_clock::now();
+}
+
+/**
+ * @brief The process-wide coarse clock used by enable_coarse_clock()
+ */
+inline CoarseClock& coarse_clock() {
+    static CoarseClock clock;
+    return clock;
+}
+
+/**
+ * @brief Serve current_time() from the coarse clock, refreshed every @p resolution
+ */
+inline void enable_coarse_clock(std::chrono::milliseconds resolution) {
+    coarse_clock().start(resolution);
+    set_clock(&coarse_clock());
+}
+
+/**
+ * @brief Return to the system clock (no-op if another clock is installed)
+ */
+inline void disable_coarse_clock() {
+    detail::uninstall_clock(&coarse_clock());
+    coarse_clock().stop();
+}
+
+/**
+ * @brief Installs a clock for the lifetime of the scope
+ */
+class ScopedClock {
+public:
+    explicit ScopedClock(const TimeSource& clock) : previous_(set_clock(&clock)) {}
+    ~ScopedClock() { set_clock(previous_); }
+    
+    ScopedClock(const ScopedClock&) = delete;
+    ScopedClock& operator=(const ScopedClock&) = delete;
+
+private:
+    const TimeSource* previous_;
+};
+
+} // namespace tms
+
+#endif // TMS_CLOCK_H
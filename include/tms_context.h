@@ -0,0 +1,125 @@
+/**
+ * @file tms_context.h
+ * @brief TMS Tape Management System - Operation Context
+ * @version 3.4.0
+ * @author Bennie Shearer
+ * @copyright Copyright (c) 2025 Bennie Shearer
+ * @license MIT License
+ *
+ * One TMSSystem serves many clients at once, so "who is calling" is a
+ * property of the call, not of the system. An OperationContext names the
+ * user, session, source and request behind a call and may carry a
+ * deadline. OperationScope installs a context for the calling thread for
+ * the length of a block. Audit records, change records and retries read
+ * it from there, so the mutation APIs keep their signatures. Coroutines
+ * on an AsyncExecutor carry the context of the code that suspended them.
+ */
+
+#ifndef TMS_CONTEXT_H
+#define TMS_CONTEXT_H
+
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace tms {
+
+// ============================================================================
+// Operation Context
+// ============================================================================
+
+/**
+ * @brief Who is behind a call, and until when its result is useful
+ */
+struct OperationContext {
+    using Clock = std::chrono::steady_clock;
+    
+    std::string user;                       ///< Empty: the system's default user
+    std::string session_id;
+    std::string source;                     ///< Client address or calling component
+    std::string request_id;
+    std::optional<Clock::time_point> deadline;
+    
+    static OperationContext for_user(std::string user, std::string session_id = "") {
+        OperationContext ctx;
+        ctx.user = std::move(user);
+        ctx.session_id = std::move(session_id);
+        return ctx;
+    }
+    
+    OperationContext& with_timeout(std::chrono::milliseconds timeout) & {
+        deadline = Clock::now() + timeout;
+        return *this;
+    }
+    OperationContext&& with_timeout(std::chrono::milliseconds timeout) && {
+        return std::move(with_timeout(timeout));
+    }
+    
+    bool expired(Clock::time_point now = Clock::now()) const { return deadline && *deadline <= now; }
+    
+    /// Time left before the deadline (zero once expired); nullopt without one
+    std::optional<std::chrono::milliseconds> remaining(Clock::time_point now = Clock::now()) const {
+        if (!deadline) return std::nullopt;
+        if (*deadline <= now) return std::chrono::milliseconds(0);
+        return std::chrono::duration_cast<std::chrono::milliseconds>(*deadline - now);
+    }
+};
+
+namespace detail {
+
+inline const OperationContext*& current_context_slot() {
+    thread_local const OperationContext* current = nullptr;
+    return current;
+}
+
+}
+
+/// The context installed on this thread, or nullptr
+inline const OperationContext* current_operation_context() {
+    return detail::current_context_slot();
+}
+
+/**
+ * @brief Installs a context on the calling thread until destroyed
+ *
+ * Scopes nest; destruction restores the previous context. An lvalue is
+ * not copied, so it must outlive the scope; a temporary is moved into
+ * the scope. Do not hold a scope across co_await: a coroutine may resume
+ * on another thread.
+ */
+class OperationScope {
+public:
+    explicit OperationScope(const OperationContext& context)
+        : previous_(detail::current_context_slot()) {
+        detail::current_context_slot() = &context;
+    }
+    
+    explicit OperationScope(OperationContext&& context)
+        : OperationScope(std::make_shared<const OperationContext>(std::move(context))) {}
+    
+    explicit OperationScope(std::shared_ptr<const OperationContext> context)
+        : previous_(detail::current_context_slot()), owned_(std::move(context)) {
+        detail::current_context_slot() = owned_.get();
+    }
+    
+    ~OperationScope() { detail::current_context_slot() = previous_; }
+    
+    OperationScope(const OperationScope&) = delete;
+    OperationScope& operator=(const OperationScope&) = delete;
+
+private:
+    const OperationContext* previous_;
+    std::shared_ptr<const OperationContext> owned_;
+};
+
+/// Copy of this thread's context for work resumed elsewhere; null if none
+inline std::shared_ptr<const OperationContext> capture_operation_context() {
+    const OperationContext* current = current_operation_context();
+    return current ? std::make_shared<const OperationContext>(*current) : nullptr;
+}
+
+} // namespace tms
+
+#endif // TMS_CONTEXT_H
@@ -0,0 +1,599 @@
+/**
+ * @file tms_csv.h
+ * @brief TMS Tape Management System - CSV Parsing and Bulk Import Pipeline
+ * @version 3.4.0
+ * @author Bennie Shearer
+ * @copyright Copyright (c) 2025 Bennie Shearer
+ * @license MIT License
+ *
+ * Provides an RFC 4180 CSV parser, a large-block file reader that splits
+ * input on record boundaries, and a multithreaded import pipeline:
+ * read -> parallel parse/validate -> ordered batched commit.
+ */
+
+#ifndef TMS_CSV_H
+#define TMS_CSV_H
+
+#include "error_codes.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <map>
+#include <deque>
+#include <istream>
+#include <fstream>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <chrono>
+#include <charconv>
+#include <algorithm>
+#include <cctype>
+
+namespace tms {
+
+// ============================================================================
+// CSV Parser
+// ============================================================================
+
+/**
+ * @brief Result of reading one CSV record
+ */
+enum class CsvRecordStatus {
+    END,        ///< No more records
+    OK,         ///< Record parsed
+    MALFORMED   ///< Record parsed but contained an invalid quoted field
+};
+
+/**
+ * @brief RFC 4180 CSV record parser
+ *
+ * Works in place on a mutable buffer: quoted fields are unescaped by
+ * compacting the buffer, and fields are returned as views into it.
+ * Accepts LF and CRLF line endings and quoted fields containing commas,
+ * doubled quotes and line breaks.
+ */
+class CsvParser {
+public:
+    static CsvRecordStatus next_record(char* data, size_t size, size_t& pos,
+                                       std::vector<std::string_view>& fields);
+    
+    /**
+     * @brief Offset just past the last complete record in [0, size)
+     *
+     * Scans quote-aware from a record boundary; returns 0 if no record
+     * terminator is found. @p records receives the number of records.
+     */
+    static size_t last_record_boundary(std::string_view data, size_t& records);
+    
+    /**
+     * @brief Convenience: split a single line into owned fields
+     */
+    static std::vector<std::string> split(std::string_view line);
+    
+    /**
+     * @brief Quote a field if it contains a delimiter, quote or line break
+     */
+    static std::string escape(std::string_view field);
+};
+
+// ============================================================================
+// Block Reader
+// ============================================================================
+
+/**
+ * @brief Reads a CSV stream in large blocks that end on record boundaries
+ */
+class CsvBlockReader {
+public:
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 1024 * 1024;
+    
+    explicit CsvBlockReader(std::istream& in, size_t block_size = DEFAULT_BLOCK_SIZE)
+        : in_(in), block_size_(block_size == 0 ? DEFAULT_BLOCK_SIZE : block_size) {}
+    
+    /**
+     * @brief Read the next block of whole records
+     * @param block Receives the block contents
+     * @param records Receives the number of records in the block
+     * @return false at end of input
+     */
+    bool next_block(std::string& block, size_t& records);
+    
+    uint64_t bytes_read() const { return bytes_read_; }
+    
+private:
+    std::istream& in_;
+    size_t block_size_;
+    std::string carry_;
+    bool eof_ = false;
+    uint64_t bytes_read_ = 0;
+};
+
+// ============================================================================
+// Import Pipeline
+// ============================================================================
+
+/**
+ * @brief Header-indexed view of one CSV record
+ */
+class CsvRow {
+public:
+    CsvRow(const std::map<std::string, size_t>& columns,
+           const std::vector<std::string_view>& fields, size_t number)
+        : columns_(columns), fields_(fields), number_(number) {}
+    
+    /// Field by normalized column name (see normalize()); empty when absent
+    std::string_view get(const std::string& column) const {
+        auto it = columns_.find(column);
+        if (it == columns_.end() || it->second >= fields_.size()) return {};
+        return fields_[it->second];
+    }
+    
+    bool has(const std::string& column) const { return columns_.count(column) > 0; }
+    
+    /// Lower-cases and drops spaces/underscores: "Mount_Count" -> "mountcount"
+    static std::string normalize(std::string_view name) {
+        std::string out;
+        out.reserve(name.size());
+        for (unsigned char c : name) {
+            if (std::isspace(c) || c == '_') continue;
+            out += static_cast<char>(std::tolower(c));
+        }
+        return out;
+    }
+    
+    size_t number() const { return number_; }   ///< 1-based record number (header is 1)
+    size_t field_count() const { return fields_.size(); }
+    
+private:
+    const std::map<std::string, size_t>& columns_;
+    const std::vector<std::string_view>& fields_;
+    size_t number_;
+};
+
+/**
+ * @brief Failure for a single input row
+ */
+struct CsvRowError {
+    size_t row = 0;          ///< 1-based record number
+    std::string key;         ///< Record key when known (volser, dataset name)
+    std::string message;
+};
+
+/**
+ * @brief Import pipeline tuning
+ */
+struct CsvImportOptions {
+    size_t threads = 0;                                     ///< Parse workers (0 = hardware)
+    size_t block_size = CsvBlockReader::DEFAULT_BLOCK_SIZE; ///< Bytes per work unit
+    size_t max_in_flight = 0;                               ///< Blocks buffered (0 = 2 x threads)
+    size_t max_errors = 10000;                              ///< Row errors kept in the report
+};
+
+/**
+ * @brief Outcome of a bulk import
+ */
+struct CsvImportReport {
+    size_t rows = 0;                       ///< Data rows read (excluding header)
+    size_t imported = 0;                   ///< Rows committed
+    size_t failed = 0;                     ///< Rows rejected in validation or commit
+    uint64_t bytes = 0;                    ///< Input bytes
+    std::vector<CsvRowError> errors;       ///< First max_errors failures, by row
+    std::chrono::milliseconds duration{0};
+    
+    double rows_per_second() const {
+        double secs = std::chrono::duration<double>(duration).count();
+        return secs > 0 ? static_cast<double>(rows) / secs : static_cast<double>(rows);
+    }
+    
+    double mb_per_second() const {
+        double secs = std::chrono::duration<double>(duration).count();
+        double mb = static_cast<double>(bytes) / (1024.0 * 1024.0);
+        return secs > 0 ? mb / secs : mb;
+    }
+};
+
+/**
+ * @brief Read -> parallel parse/validate -> ordered commit pipeline
+ *
+ * One reader thread cuts the input into record-aligned blocks, a pool of
+ * workers turns rows into records via the parse function, and the calling
+ * thread hands each block's records to the commit function in input
+ * order. At most max_in_flight blocks are buffered at any time.
+ *
+ * @tparam Record Type produced per row (e.g. TapeVolume)
+ */
+template<typename Record>
+class CsvImportPipeline {
+public:
+    /// Fill @p out from @p row; return false and set @p error to reject the row
+    using ParseFn = std::function<bool(const CsvRow& row, Record& out, std::string& error)>;
+    
+    /// Commit a batch; report rejected entries through reject(index, message)
+    using RejectFn = std::function<void(size_t index, const std::string& message)>;
+    using CommitFn = std::function<void(std::vector<Record>& batch, const RejectFn& reject)>;
+    
+    /// Key used in error reports for a parsed record
+    using KeyFn = std::function<std::string(const Record&)>;
+    
+    CsvImportPipeline(ParseFn parse, CommitFn commit, KeyFn key,
+                      CsvImportOptions options = CsvImportOptions())
+        : parse_(std::move(parse)), commit_(std::move(commit)),
+          key_(std::move(key)), options_(options) {}
+    
+    Result<CsvImportReport> run_file(const std::string& path);
+    Result<CsvImportReport> run(std::istream& in);
+    
+private:
+    struct Block {
+        size_t id = 0;
+        size_t first_row = 0;
+        std::string data;
+    };
+    
+    struct ParsedBlock {
+        std::vector<Record> records;
+        std::vector<size_t> rows;
+        std::vector<CsvRowError> errors;
+        size_t row_count = 0;
+    };
+    
+    ParsedBlock parse_block(Block& block) const;
+    void add_error(CsvImportReport& report, CsvRowError&& error) const {
+        report.failed++;
+        if (report.errors.size() < options_.max_errors) {
+            report.errors.push_back(std::move(error));
+        }
+    }
+    
+    ParseFn parse_;
+    CommitFn commit_;
+    KeyFn key_;
+    CsvImportOptions options_;
+    std::map<std::string, size_t> columns_;
+};
+
+// ============================================================================
+// Implementation
+// ============================================================================
+
+inline CsvRecordStatus CsvParser::next_record(char* data, size_t size, size_t& pos,
+                                              std::vector<std::string_view>& fields) {
+    fields.clear();
+    if (pos >= size) return CsvRecordStatus::END;
+    
+    bool malformed = false;
+    while (true) {
+        if (pos < size && data[pos] == '"') {
+            size_t start = ++pos;
+            size_t out = start;
+            bool closed = false;
+            while (pos < size) {
+                if (data[pos] == '"') {
+                    if (pos + 1 < size && data[pos + 1] == '"') {
+                        data[out++] = '"';
+                        pos += 2;
+                        continue;
+                    }
+                    pos++;
+                    closed = true;
+                    break;
+                }
+                data[out++] = data[pos++];
+            }
+            if (!closed) malformed = true;
+            fields.emplace_back(data + start, out - start);
+            // Anything between the closing quote and the delimiter is invalid
+            if (pos < size && data[pos] != ',' && data[pos] != '\n' && data[pos] != '\r') {
+                malformed = true;
+                while (pos < size && data[pos] != ',' && data[pos] != '\n') pos++;
+            }
+        } else {
+            size_t start = pos;
+            while (pos < size && data[pos] != ',' && data[pos] != '\n' && data[pos] != '\r') pos++;
+            fields.emplace_back(data + start, pos - start);
+        }
+        
+        if (pos >= size) break;
+        char c = data[pos++];
+        if (c == ',') {
+            if (pos >= size) {
+                fields.emplace_back();
+                break;
+            }
+            continue;
+        }
+        if (c == '\r' && pos < size && data[pos] == '\n') pos++;
+        break;
+    }
+    return malformed ? CsvRecordStatus::MALFORMED : CsvRecordStatus::OK;
+}
+
+inline size_t CsvParser::last_record_boundary(std::string_view data, size_t& records) {
+    records = 0;
+    size_t boundary = 0;
+    bool quoted = false;
+    for (size_t i = 0; i < data.size(); i++) {
+        char c = data[i];
+        if (c == '"') {
+            quoted = !quoted;   // a doubled quote toggles twice
+        } else if (c == '\n' && !quoted) {
+            boundary = i + 1;
+            records++;
+        }
+    }
+    return boundary;
+}
+
+inline std::vector<std::string> CsvParser::split(std::string_view line) {
+    std::string buf(line);
+    std::vector<std::string_view> views;
+    size_t pos = 0;
+    next_record(buf.data(), buf.size(), pos, views);
+    return std::vector<std::string>(views.begin(), views.end());
+}
+
+inline std::string CsvParser::escape(std::string_view field) {
+    if (field.find_first_of(",\"\r\n") == std::string_view::npos) {
+        return std::string(field);
+    }
+    std::string out;
+    out.reserve(field.size() + 2);
+    out += '"';
+    for (char c : field) {
+        if (c == '"') out += '"';
+        out += c;
+    }
+    out += '"';
+    return out;
+}
+
+inline bool CsvBlockReader::next_block(std::string& block, size_t& records) {
+    block.clear();
+    records = 0;
+    while (true) {
+        if (!eof_) {
+            size_t old_size = carry_.size();
+            carry_.resize(old_size + block_size_);
+            in_.read(carry_.data() + old_size, static_cast<std::streamsize>(block_size_));
+            size_t got = static_cast<size_t>(in_.gcount());
+            carry_.resize(old_size + got);
+            bytes_read_ += got;
+            if (got < block_size_) eof_ = true;
+        }
+        
+        if (eof_) {
+            if (carry_.empty()) return false;
+            size_t complete = 0;
+            CsvParser::last_record_boundary(carry_, complete);
+            // A final record without a trailing newline still counts
+            bool unterminated = carry_.back() != '\n';
+            records = complete + (unterminated ? 1 : 0);
+            block.swap(carry_);
+            carry_.clear();
+            return true;
+        }
+        
+        size_t boundary = CsvParser::last_record_boundary(carry_, records);
+        if (boundary == 0) continue;  // one record larger than a block: read more
+        block.assign(carry_, 0, boundary);
+        carry_.erase(0, boundary);
+        return true;
+    }
+}
+
+template<typename Record>
+Result<CsvImportReport> CsvImportPipeline<Record>::run_file(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        return Result<CsvImportReport>::err(TMSError::FILE_NOT_FOUND, "Cannot open: " + path);
+    }
+    return run(in);
+}
+
+template<typename Record>
+typename CsvImportPipeline<Record>::ParsedBlock
+CsvImportPipeline<Record>::parse_block(Block& block) const {
+    ParsedBlock out;
+    std::vector<std::string_view> fields;
+    char* data = block.data.data();
+    size_t size = block.data.size();
+    size_t pos = 0;
+    size_t row = block.first_row;
+    
+    while (true) {
+        CsvRecordStatus status = CsvParser::next_record(data, size, pos, fields);
+        if (status == CsvRecordStatus::END) break;
+        if (fields.size() == 1 && fields[0].empty()) {
+            row++;
+            continue;  // blank line
+        }
+        out.row_count++;
+        
+        if (status == CsvRecordStatus::MALFORMED) {
+            out.errors.push_back({row, "", "Malformed quoted field"});
+        } else {
+            CsvRow csv_row(columns_, fields, row);
+            Record record{};
+            std::string error;
+            try {
+                if (parse_(csv_row, record, error)) {
+                    out.records.push_back(std::move(record));
+                    out.rows.push_back(row);
+                } else {
+                    out.errors.push_back({row, key_ ? key_(record) : "", error});
+                }
+            } catch (const std::exception& e) {
+                out.errors.push_back({row, "", e.what()});
+            }
+        }
+        row++;
+    }
+    return out;
+}
+
+template<typename Record>
+Result<CsvImportReport> CsvImportPipeline<Record>::run(std::istream& in) {
+    auto start = std::chrono::steady_clock::now();
+    CsvImportReport report;
+    CsvBlockReader reader(in, options_.block_size);
+    
+    // Header: first record of the first block
+    Block first;
+    size_t first_records = 0;
+    if (!reader.next_block(first.data, first_records)) {
+        return Result<CsvImportReport>::err(TMSError::INVALID_PARAMETER, "CSV input is empty");
+    }
+    {
+        std::vector<std::string_view> header;
+        size_t pos = 0;
+        CsvParser::next_record(first.data.data(), first.data.size(), pos, header);
+        columns_.clear();
+        for (size_t i = 0; i < header.size(); i++) {
+            columns_.emplace(CsvRow::normalize(header[i]), i);
+        }
+        first.data.erase(0, pos);
+        first.first_row = 2;
+        first_records = first_records > 0 ? first_records - 1 : 0;
+    }
+    
+    size_t threads = options_.threads;
+    if (threads == 0) threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    size_t max_in_flight = options_.max_in_flight ? options_.max_in_flight : threads * 2;
+    
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<Block> queue;
+    std::map<size_t, ParsedBlock> done;
+    size_t in_flight = 0;
+    size_t blocks_total = 0;
+    bool reader_done = false;
+    bool abort = false;
+    std::exception_ptr failure;
+    
+    std::thread reader_thread([&] {
+        try {
+            Block block = std::move(first);
+            size_t records = first_records;
+            size_t next_row = block.first_row;
+            size_t id = 0;
+            bool have = true;
+            while (have) {
+                block.id = id++;
+                block.first_row = next_row;
+                next_row += records;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    cv.wait(lock, [&] { return in_flight < max_in_flight || abort; });
+                    if (abort) break;
+                    in_flight++;
+                    queue.push_back(std::move(block));
+                }
+                cv.notify_all();
+                block = Block();
+                have = reader.next_block(block.data, records);
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            blocks_total = id;
+            reader_done = true;
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            failure = std::current_exception();
+            reader_done = true;
+            abort = true;
+        }
+        cv.notify_all();
+    });
+    
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; t++) {
+        workers.emplace_back([&] {
+            while (true) {
+                Block block;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    cv.wait(lock, [&] { return !queue.empty() || reader_done || abort; });
+                    if (abort || queue.empty()) return;
+                    block = std::move(queue.front());
+                    queue.pop_front();
+                }
+                ParsedBlock parsed = parse_block(block);
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    done.emplace(block.id, std::move(parsed));
+                }
+                cv.notify_all();
+            }
+        });
+    }
+    
+    // Commit stage: in input order, on the calling thread
+    for (size_t next = 0;; next++) {
+        ParsedBlock parsed;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [&] {
+                return done.count(next) > 0 || abort || (reader_done && next >= blocks_total);
+            });
+            if (abort || (done.count(next) == 0)) break;
+            parsed = std::move(done[next]);
+            done.erase(next);
+        }
+        
+        report.rows += parsed.row_count;
+        for (auto& e : parsed.errors) add_error(report, std::move(e));
+        
+        size_t rejected = 0;
+        try {
+            commit_(parsed.records, [&](size_t index, const std::string& message) {
+                rejected++;
+                std::string key = (key_ && index < parsed.records.size()) ? key_(parsed.records[index]) : "";
+                size_t row = index < parsed.rows.size() ? parsed.rows[index] : 0;
+                add_error(report, {row, key, message});
+            });
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            failure = std::current_exception();
+            abort = true;
+        }
+        report.imported += parsed.records.size() - std::min(rejected, parsed.records.size());
+        
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            in_flight--;
+        }
+        cv.notify_all();
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (failure) abort = true;
+    }
+    cv.notify_all();
+    reader_thread.join();
+    for (auto& w : workers) w.join();
+    
+    if (failure) {
+        try {
+            std::rethrow_exception(failure);
+        } catch (const std::exception& e) {
+            return Result<CsvImportReport>::err(TMSError::FILE_READ_ERROR,
+                std::string("CSV import failed: ") + e.what());
+        } catch (...) {
+            return Result<CsvImportReport>::err(TMSError::FILE_READ_ERROR, "CSV import failed");
+        }
+    }
+    
+    std::sort(report.errors.begin(), report.errors.end(),
+              [](const CsvRowError& a, const CsvRowError& b) { return a.row < b.row; });
+    report.bytes = reader.bytes_read();
+    report.duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+    return Result<CsvImportReport>::ok(std::move(report));
+}
+
+} // namespace tms
+
+#endif // TMS_CSV_H
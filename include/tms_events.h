@@ -45,6 +45,7 @@ enum class EventType {
     VOLUME_RELEASED,
     VOLUME_TAGGED,
     VOLUME_UNTAGGED,
+    VOLUME_UPDATED,     ///< Any other committed volume change
     
     // Dataset events
     DATASET_ADDED,
@@ -53,6 +54,7 @@ enum class EventType {
     DATASET_RECALLED,
     DATASET_EXPIRED,
     DATASET_TAGGED,
+    DATASET_UPDATED,    ///< Any other committed dataset change
     
     // System events
     CATALOG_SAVED,
@@ -93,10 +95,10 @@ struct Event {
     std::map<std::string, std::string> data;  ///< Additional data
     uint64_t sequence_number = 0;
     
-    Event() : type(EventType::CUSTOM), timestamp(std::chrono::system_clock::now()) {}
+    Event() : type(EventType::CUSTOM), timestamp(current_time()) {}
     
     Event(EventType t, const std::string& src, const std::string& tgt, const std::string& msg)
-        : type(t), timestamp(std::chrono::system_clock::now()),
+        : type(t), timestamp(current_time()),
           source(src), target(tgt), message(msg) {}
     
     /// Add data field
@@ -240,12 +242,14 @@ inline std::string event_type_to_string(EventType type) {
         case EventType::VOLUME_RELEASED: return "VOLUME_RELEASED";
         case EventType::VOLUME_TAGGED: return "VOLUME_TAGGED";
         case EventType::VOLUME_UNTAGGED: return "VOLUME_UNTAGGED";
+        case EventType::VOLUME_UPDATED: return "VOLUME_UPDATED";
         case EventType::DATASET_ADDED: return "DATASET_ADDED";
         case EventType::DATASET_DELETED: return "DATASET_DELETED";
         case EventType::DATASET_MIGRATED: return "DATASET_MIGRATED";
         case EventType::DATASET_RECALLED: return "DATASET_RECALLED";
         case EventType::DATASET_EXPIRED: return "DATASET_EXPIRED";
         case EventType::DATASET_TAGGED: return "DATASET_TAGGED";
+        case EventType::DATASET_UPDATED: return "DATASET_UPDATED";
         case EventType::CATALOG_SAVED: return "CATALOG_SAVED";
         case EventType::CATALOG_LOADED: return "CATALOG_LOADED";
         case EventType::BACKUP_CREATED: return "BACKUP_CREATED";
@@ -259,6 +263,17 @@ inline std::string event_type_to_string(EventType type) {
     }
 }
 
+/**
+ * @brief Convert string to EventType (CUSTOM if unknown)
+ */
+inline EventType string_to_event_type(std::string_view name) {
+    for (int i = 0; i <= static_cast<int>(EventType::CUSTOM); i++) {
+        auto type = static_cast<EventType>(i);
+        if (event_type_to_string(type) == name) return type;
+    }
+    return EventType::CUSTOM;
+}
+
 /**
  * @brief Convert EventSeverity to string
  */
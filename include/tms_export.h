@@ -0,0 +1,680 @@
+/**
+ * @file tms_export.h
+ * @brief TMS Tape Management System - Parallel Export Engine
+ * @version 3.4.0
+ * @author Bennie Shearer
+ * @copyright Copyright (c) 2025 Bennie Shearer
+ * @license MIT License
+ *
+ * Formats catalog records as CSV, JSON Lines or a compact binary format.
+ * Records are split into partitions that worker threads format into
+ * reusable buffers; the calling thread writes finished partitions in
+ * order as large sequential blocks. Only the selected columns are
+ * formatted, and callers pass a pre-filtered record list.
+ */
+
+#ifndef TMS_EXPORT_H
+#define TMS_EXPORT_H
+
+#include "tms_types.h"
+#include "tms_utils.h"
+#include "tms_csv.h"
+#include "error_codes.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <istream>
+#include <ostream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception>
+#include <stdexcept>
+#include <chrono>
+#include <charconv>
+#include <cstring>
+#include <algorithm>
+#include <type_traits>
+
+namespace tms {
+
+// ============================================================================
+// Export Types
+// ============================================================================
+
+/**
+ * @brief Output format
+ */
+enum class ExportFormat {
+    CSV,        ///< RFC 4180 CSV with header row
+    JSON_LINES, ///< One JSON object per line
+    BINARY      ///< Self-describing little-endian records (see BinaryExportReader)
+};
+
+/**
+ * @brief Column value type
+ */
+enum class ExportColumnType : uint8_t {
+    TEXT = 1,
+    INTEGER = 2,
+    UNSIGNED = 3,
+    TIMESTAMP = 4,  ///< Text formats: "YYYY-MM-DD HH:MM:SS" local; binary: epoch seconds
+    BOOLEAN = 5
+};
+
+/**
+ * @brief Scratch value filled by a column accessor
+ *
+ * Text accessors point @c text at the record when possible and use
+ * @c owned only for computed strings, so formatting a row does not
+ * allocate once the scratch has warmed up.
+ */
+struct ExportField {
+    std::string_view text;
+    std::string owned;
+    int64_t integer = 0;
+    uint64_t uinteger = 0;
+    std::chrono::system_clock::time_point time;
+    bool flag = false;
+    
+    void set_owned(std::string value) {
+        owned = std::move(value);
+        text = owned;
+    }
+};
+
+/**
+ * @brief One exportable column of a record type
+ */
+template<typename Record>
+struct ExportColumn {
+    const char* header;                         ///< CSV header name
+    const char* key;                            ///< JSON / binary field name
+    ExportColumnType type;
+    void (*get)(const Record& record, ExportField& field);
+};
+
+/**
+ * @brief Export tuning and column selection
+ */
+struct ExportOptions {
+    ExportFormat format = ExportFormat::CSV;
+    std::vector<std::string> columns;       ///< Subset by header or key, any case (empty = all)
+    size_t threads = 0;                     ///< Formatting workers (0 = hardware)
+    size_t partition_records = 4096;        ///< Records per work unit
+    size_t max_in_flight = 0;               ///< Buffered partitions (0 = 2 x threads)
+    bool header = true;                     ///< Emit CSV header row
+};
+
+/**
+ * @brief Outcome of an export
+ */
+struct ExportReport {
+    size_t records = 0;
+    size_t partitions = 0;
+    uint64_t bytes = 0;
+    std::chrono::milliseconds duration{0};
+    
+    double records_per_second() const {
+        double secs = std::chrono::duration<double>(duration).count();
+        return secs > 0 ? static_cast<double>(records) / secs : static_cast<double>(records);
+    }
+    
+    double mb_per_second() const {
+        double secs = std::chrono::duration<double>(duration).count();
+        double mb = static_cast<double>(bytes) / (1024.0 * 1024.0);
+        return secs > 0 ? mb / secs : mb;
+    }
+};
+
+// ============================================================================
+// Formatting Buffer
+// ============================================================================
+
+/**
+ * @brief Append-only output buffer with fast number formatting
+ */
+class ExportBuffer {
+public:
+    explicit ExportBuffer(size_t reserve = 0) { data_.reserve(reserve); }
+    
+    void clear() { data_.clear(); }
+    size_t size() const { return data_.size(); }
+    const char* data() const { return data_.data(); }
+    
+    void put(char c) { data_ += c; }
+    void put(std::string_view s) { data_.append(s.data(), s.size()); }
+    
+    template<typename T>
+    void put_number(T value) {
+        char buf[24];
+        auto [ptr, ec] = std::to_chars(buf, buf + sizeof(buf), value);
+        (void)ec;
+        data_.append(buf, static_cast<size_t>(ptr - buf));
+    }
+    
+    void put_time(std::chrono::system_clock::time_point tp) { TimestampCodec::append(data_, tp); }
+    void put_csv(std::string_view s);
+    void put_json(std::string_view s);
+    
+    /// Fixed-width little-endian integer (binary format)
+    template<typename T>
+    void put_le(T value) {
+        auto u = static_cast<std::make_unsigned_t<T>>(value);
+        for (size_t i = 0; i < sizeof(T); i++) {
+            data_ += static_cast<char>((u >> (8 * i)) & 0xFF);
+        }
+    }
+    
+private:
+    std::string data_;
+};
+
+// ============================================================================
+// Export Engine
+// ============================================================================
+
+/**
+ * @brief Partitioned, multithreaded record exporter
+ *
+ * The record list is cut into partitions of options.partition_records.
+ * Workers format partitions into a ring of max_in_flight buffers and the
+ * calling thread writes them in input order, so memory is bounded by the
+ * ring regardless of catalog size. The records must stay valid and
+ * unmodified for the duration of run() (callers hold the catalog lock).
+ *
+ * @tparam Record Record type (TapeVolume, Dataset)
+ */
+template<typename Record>
+class ExportEngine {
+public:
+    using Column = ExportColumn<Record>;
+    
+    explicit ExportEngine(const std::vector<Column>& schema) : schema_(schema) {}
+    
+    Result<ExportReport> run(const std::vector<const Record*>& records, std::ostream& out,
+                             const ExportOptions& options) const;
+    
+    /// Resolve options.columns against the schema; empty selection means all
+    Result<std::vector<const Column*>> select(const std::vector<std::string>& names) const;
+    
+private:
+    void write_header(ExportBuffer& buf, const std::vector<const Column*>& cols,
+                      const ExportOptions& options) const;
+    void write_record(ExportBuffer& buf, ExportField& field, const Record& record,
+                      const std::vector<const Column*>& cols, ExportFormat format) const;
+    
+    const std::vector<Column>& schema_;
+};
+
+// ============================================================================
+// Binary Reader
+// ============================================================================
+
+/**
+ * @brief Reads files produced with ExportFormat::BINARY
+ *
+ * Layout: "TMSX", u8 version, u16 column count, then per column u8 type,
+ * u16 key length and key bytes. Each record is a 0x01 tag followed by its
+ * fields (TEXT: u32 length + bytes, INTEGER/TIMESTAMP: i64, UNSIGNED: u64,
+ * BOOLEAN: u8). A 0x00 tag and u64 record count end the stream.
+ */
+class BinaryExportReader {
+public:
+    struct ColumnInfo {
+        std::string key;
+        ExportColumnType type;
+    };
+    
+    /// Reads the header; throws std::runtime_error on bad input
+    explicit BinaryExportReader(std::istream& in);
+    
+    const std::vector<ColumnInfo>& columns() const { return columns_; }
+    
+    /// Read the next record into @p fields (text is held in ExportField::owned)
+    bool next(std::vector<ExportField>& fields);
+    
+    /// Record count from the trailer (valid once next() returned false)
+    uint64_t record_count() const { return count_; }
+    
+private:
+    template<typename T>
+    T read_le();
+    void read_bytes(char* dst, size_t n);
+    
+    std::istream& in_;
+    std::vector<ColumnInfo> columns_;
+    uint64_t count_ = 0;
+    bool done_ = false;
+};
+
+// ============================================================================
+// Catalog Schemas
+// ============================================================================
+
+/**
+ * @brief Exportable TapeVolume columns; the first 11 match export_to_csv
+ */
+inline const std::vector<ExportColumn<TapeVolume>>& volume_export_columns() {
+    using T = ExportColumnType;
+    static const std::vector<ExportColumn<TapeVolume>> columns = {
+        {"Volser", "volser", T::TEXT, [](const TapeVolume& v, ExportField& f) { f.text = v.volser; }},
+        {"Status", "status", T::TEXT,
+         [](const TapeVolume& v, ExportField& f) { f.set_owned(volume_status_to_string(v.status)); }},
+        {"Density", "density", T::TEXT,
+         [](const TapeVolume& v, ExportField& f) { f.set_owned(density_to_string(v.density)); }},
+        {"Location", "location", T::TEXT, [](const TapeVolume& v, ExportField& f) { f.text = v.location.view(); }},
+        {"Pool", "pool", T::TEXT, [](const TapeVolume& v, ExportField& f) { f.text = v.pool.view(); }},
+        {"Owner", "owner", T::TEXT, [](const TapeVolume& v, ExportField& f) { f.text = v.owner.view(); }},
+        {"MountCount", "mount_count", T::INTEGER,
+         [](const TapeVolume& v, ExportField& f) { f.integer = v.mount_count; }},
+        {"Capacity", "capacity_bytes", T::UNSIGNED,
+         [](const TapeVolume& v, ExportField& f) { f.uinteger = v.capacity_bytes; }},
+        {"Used", "used_bytes", T::UNSIGNED,
+         [](const TapeVolume& v, ExportField& f) { f.uinteger = v.used_bytes; }},
+        {"Created", "creation_date", T::TIMESTAMP,
+         [](const TapeVolume& v, ExportField& f) { f.time = v.creation_date; }},
+        {"Expires", "expiration_date", T::TIMESTAMP,
+         [](const TapeVolume& v, ExportField& f) { f.time = v.expiration_date; }},
+        {"LastUsed", "last_used", T::TIMESTAMP,
+         [](const TapeVolume& v, ExportField& f) { f.time = v.last_used; }},
+        {"WriteProtected", "write_protected", T::BOOLEAN,
+         [](const TapeVolume& v, ExportField& f) { f.flag = v.write_protected; }},
+        {"ErrorCount", "error_count", T::INTEGER,
+         [](const TapeVolume& v, ExportField& f) { f.integer = v.error_count; }},
+        {"MediaType", "media_type", T::TEXT, [](const TapeVolume& v, ExportField& f) { f.text = v.media_type.view(); }},
+        {"ReservedBy", "reserved_by", T::TEXT,
+         [](const TapeVolume& v, ExportField& f) { f.text = v.reserved_by; }},
+        {"Notes", "notes", T::TEXT, [](const TapeVolume& v, ExportField& f) { f.text = v.notes; }},
+    };
+    return columns;
+}
+
+/**
+ * @brief Exportable Dataset columns; the first 9 match export_to_csv
+ */
+inline const std::vector<ExportColumn<Dataset>>& dataset_export_columns() {
+    using T = ExportColumnType;
+    static const std::vector<ExportColumn<Dataset>> columns = {
+        {"Name", "name", T::TEXT, [](const Dataset& d, ExportField& f) { f.text = d.name; }},
+        {"Volser", "volser", T::TEXT, [](const Dataset& d, ExportField& f) { f.text = d.volser; }},
+        {"Status", "status", T::TEXT,
+         [](const Dataset& d, ExportField& f) { f.set_owned(dataset_status_to_string(d.status)); }},
+        {"Size", "size_bytes", T::UNSIGNED, [](const Dataset& d, ExportField& f) { f.uinteger = d.size_bytes; }},
+        {"Owner", "owner", T::TEXT, [](const Dataset& d, ExportField& f) { f.text = d.owner.view(); }},
+        {"JobName", "job_name", T::TEXT, [](const Dataset& d, ExportField& f) { f.text = d.job_name.view(); }},
+        {"FileSeq", "file_sequence", T::INTEGER,
+         [](const Dataset& d, ExportField& f) { f.integer = d.file_sequence; }},
+        {"Created", "creation_date", T::TIMESTAMP,
+         [](const Dataset& d, ExportField& f) { f.time = d.creation_date; }},
+        {"Expires", "expiration_date", T::TIMESTAMP,
+         [](const Dataset& d, ExportField& f) { f.time = d.expiration_date; }},
+        {"Generation", "generation", T::INTEGER, [](const Dataset& d, ExportField& f) { f.integer = d.generation; }},
+        {"Version", "version", T::INTEGER, [](const Dataset& d, ExportField& f) { f.integer = d.version; }},
+        {"RecordFormat", "record_format", T::TEXT,
+         [](const Dataset& d, ExportField& f) { f.text = d.record_format; }},
+        {"BlockSize", "block_size", T::UNSIGNED, [](const Dataset& d, ExportField& f) { f.uinteger = d.block_size; }},
+        {"RecordLength", "record_length", T::UNSIGNED,
+         [](const Dataset& d, ExportField& f) { f.uinteger = d.record_length; }},
+        {"LastAccessed", "last_accessed", T::TIMESTAMP,
+         [](const Dataset& d, ExportField& f) { f.time = d.last_accessed; }},
+        {"Compressed", "compressed", T::BOOLEAN, [](const Dataset& d, ExportField& f) { f.flag = d.compressed; }},
+        {"Notes", "notes", T::TEXT, [](const Dataset& d, ExportField& f) { f.text = d.notes; }},
+    };
+    return columns;
+}
+
+// ============================================================================
+// Implementation
+// ============================================================================
+
+inline void ExportBuffer::put_csv(std::string_view s) {
+    if (s.find_first_of(",\"\r\n") == std::string_view::npos) {
+        put(s);
+        return;
+    }
+    data_ += '"';
+    for (char c : s) {
+        if (c == '"') data_ += '"';
+        data_ += c;
+    }
+    data_ += '"';
+}
+
+inline void ExportBuffer::put_json(std::string_view s) {
+    static const char* hex = "0123456789abcdef";
+    data_ += '"';
+    size_t run = 0;
+    for (size_t i = 0; i < s.size(); i++) {
+        unsigned char c = static_cast<unsigned char>(s[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') continue;
+        data_.append(s.data() + run, i - run);
+        run = i + 1;
+        switch (c) {
+            case '"': data_ += "\\\""; break;
+            case '\\': data_ += "\\\\"; break;
+            case '\n': data_ += "\\n"; break;
+            case '\r': data_ += "\\r"; break;
+            case '\t': data_ += "\\t"; break;
+            default:
+                data_ += "\\u00";
+                data_ += hex[(c >> 4) & 0x0F];
+                data_ += hex[c & 0x0F];
+        }
+    }
+    data_.append(s.data() + run, s.size() - run);
+    data_ += '"';
+}
+
+template<typename Record>
+Result<std::vector<const ExportColumn<Record>*>>
+ExportEngine<Record>::select(const std::vector<std::string>& names) const {
+    std::vector<const Column*> cols;
+    if (names.empty()) {
+        for (const auto& c : schema_) cols.push_back(&c);
+        return Result<std::vector<const Column*>>::ok(std::move(cols));
+    }
+    for (const auto& name : names) {
+        std::string wanted = CsvRow::normalize(name);
+        const Column* match = nullptr;
+        for (const auto& c : schema_) {
+            if (CsvRow::normalize(c.header) == wanted || CsvRow::normalize(c.key) == wanted) {
+                match = &c;
+                break;
+            }
+        }
+        if (!match) {
+            return Result<std::vector<const Column*>>::err(TMSError::INVALID_PARAMETER,
+                                                           "Unknown export column: " + name);
+        }
+        cols.push_back(match);
+    }
+    return Result<std::vector<const Column*>>::ok(std::move(cols));
+}
+
+template<typename Record>
+void ExportEngine<Record>::write_header(ExportBuffer& buf, const std::vector<const Column*>& cols,
+                                        const ExportOptions& options) const {
+    if (options.format == ExportFormat::CSV) {
+        if (!options.header) return;
+        for (size_t i = 0; i < cols.size(); i++) {
+            if (i > 0) buf.put(',');
+            buf.put_csv(cols[i]->header);
+        }
+        buf.put('\n');
+    } else if (options.format == ExportFormat::BINARY) {
+        buf.put("TMSX");
+        buf.put_le<uint8_t>(1);
+        buf.put_le<uint16_t>(static_cast<uint16_t>(cols.size()));
+        for (const Column* c : cols) {
+            std::string_view key(c->key);
+            buf.put_le<uint8_t>(static_cast<uint8_t>(c->type));
+            buf.put_le<uint16_t>(static_cast<uint16_t>(key.size()));
+            buf.put(key);
+        }
+    }
+}
+
+template<typename Record>
+void ExportEngine<Record>::write_record(ExportBuffer& buf, ExportField& field, const Record& record,
+                                        const std::vector<const Column*>& cols,
+                                        ExportFormat format) const {
+    if (format == ExportFormat::BINARY) {
+        buf.put_le<uint8_t>(1);
+        for (const Column* c : cols) {
+            c->get(record, field);
+            switch (c->type) {
+                case ExportColumnType::TEXT:
+                    buf.put_le<uint32_t>(static_cast<uint32_t>(field.text.size()));
+                    buf.put(field.text);
+                    break;
+                case ExportColumnType::INTEGER: buf.put_le<int64_t>(field.integer); break;
+                case ExportColumnType::UNSIGNED: buf.put_le<uint64_t>(field.uinteger); break;
+                case ExportColumnType::TIMESTAMP: buf.put_le<int64_t>(TimestampCodec::to_epoch(field.time)); break;
+                case ExportColumnType::BOOLEAN: buf.put_le<uint8_t>(field.flag ? 1 : 0); break;
+            }
+        }
+        return;
+    }
+    
+    bool json = format == ExportFormat::JSON_LINES;
+    if (json) buf.put('{');
+    for (size_t i = 0; i < cols.size(); i++) {
+        const Column* c = cols[i];
+        if (i > 0) buf.put(',');
+        if (json) {
+            buf.put('"');
+            buf.put(c->key);
+            buf.put("\":");
+        }
+        c->get(record, field);
+        switch (c->type) {
+            case ExportColumnType::TEXT:
+                if (json) buf.put_json(field.text); else buf.put_csv(field.text);
+                break;
+            case ExportColumnType::INTEGER: buf.put_number(field.integer); break;
+            case ExportColumnType::UNSIGNED: buf.put_number(field.uinteger); break;
+            case ExportColumnType::TIMESTAMP:
+                if (json) buf.put('"');
+                buf.put_time(field.time);
+                if (json) buf.put('"');
+                break;
+            case ExportColumnType::BOOLEAN: buf.put(field.flag ? "true" : "false"); break;
+        }
+    }
+    if (json) buf.put('}');
+    buf.put('\n');
+}
+
+template<typename Record>
+Result<ExportReport> ExportEngine<Record>::run(const std::vector<const Record*>& records,
+                                               std::ostream& out,
+                                               const ExportOptions& options) const {
+    auto start = std::chrono::steady_clock::now();
+    auto selected = select(options.columns);
+    if (!selected.is_success()) {
+        return Result<ExportReport>::err(selected.error().code, selected.error().message);
+    }
+    const std::vector<const Column*>& cols = selected.value();
+    
+    ExportReport report;
+    report.records = records.size();
+    const size_t per_partition = options.partition_records ? options.partition_records : 4096;
+    const size_t partitions = (records.size() + per_partition - 1) / per_partition;
+    report.partitions = partitions;
+    
+    size_t threads = options.threads;
+    if (threads == 0) threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    threads = std::min(threads, std::max<size_t>(1, partitions));
+    const size_t ring = options.max_in_flight ? options.max_in_flight : threads * 2;
+    
+    auto emit = [&](const ExportBuffer& buf) {
+        out.write(buf.data(), static_cast<std::streamsize>(buf.size()));
+        report.bytes += buf.size();
+    };
+    auto format_partition = [&](size_t p, ExportBuffer& buf, ExportField& field) {
+        size_t end = std::min(records.size(), (p + 1) * per_partition);
+        for (size_t i = p * per_partition; i < end; i++) {
+            write_record(buf, field, *records[i], cols, options.format);
+        }
+    };
+    
+    ExportBuffer head;
+    write_header(head, cols, options);
+    emit(head);
+    
+    if (threads <= 1) {
+        ExportBuffer buf;
+        ExportField field;
+        for (size_t p = 0; p < partitions && out.good(); p++) {
+            buf.clear();
+            format_partition(p, buf, field);
+            emit(buf);
+        }
+    } else {
+        struct Slot {
+            ExportBuffer buffer;
+            bool ready = false;
+        };
+        std::vector<Slot> slots(ring);
+        std::atomic<size_t> next_partition{0};
+        std::mutex mutex;
+        std::condition_variable cv;
+        size_t written = 0;
+        bool abort = false;
+        std::exception_ptr failure;
+        
+        std::vector<std::thread> workers;
+        for (size_t t = 0; t < threads; t++) {
+            workers.emplace_back([&] {
+                ExportField field;
+                while (true) {
+                    size_t p = next_partition.fetch_add(1);
+                    if (p >= partitions) return;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        cv.wait(lock, [&] { return p < written + ring || abort; });
+                        if (abort) return;
+                    }
+                    Slot& slot = slots[p % ring];
+                    try {
+                        slot.buffer.clear();
+                        format_partition(p, slot.buffer, field);
+                    } catch (...) {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        if (!failure) failure = std::current_exception();
+                        abort = true;
+                        cv.notify_all();
+                        return;
+                    }
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        slot.ready = true;
+                    }
+                    cv.notify_all();
+                }
+            });
+        }
+        
+        for (size_t p = 0; p < partitions; p++) {
+            Slot& slot = slots[p % ring];
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cv.wait(lock, [&] { return slot.ready || abort; });
+                if (abort) break;
+            }
+            emit(slot.buffer);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                slot.ready = false;
+                written++;
+                if (!out.good()) abort = true;
+            }
+            cv.notify_all();
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (written < partitions) abort = true;
+        }
+        cv.notify_all();
+        for (auto& w : workers) w.join();
+        
+        if (failure) {
+            try {
+                std::rethrow_exception(failure);
+            } catch (const std::exception& e) {
+                return Result<ExportReport>::err(TMSError::FILE_WRITE_ERROR,
+                                                 std::string("Export failed: ") + e.what());
+            } catch (...) {
+                return Result<ExportReport>::err(TMSError::FILE_WRITE_ERROR, "Export failed");
+            }
+        }
+    }
+    
+    if (options.format == ExportFormat::BINARY) {
+        ExportBuffer tail;
+        tail.put_le<uint8_t>(0);
+        tail.put_le<uint64_t>(records.size());
+        emit(tail);
+    }
+    out.flush();
+    if (!out.good()) {
+        return Result<ExportReport>::err(TMSError::FILE_WRITE_ERROR, "Export write failed");
+    }
+    
+    report.duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+    return Result<ExportReport>::ok(std::move(report));
+}
+
+inline BinaryExportReader::BinaryExportReader(std::istream& in) : in_(in) {
+    char magic[4];
+    read_bytes(magic, sizeof(magic));
+    if (std::memcmp(magic, "TMSX", 4) != 0) {
+        throw std::runtime_error("Not a TMS binary export");
+    }
+    if (read_le<uint8_t>() != 1) {
+        throw std::runtime_error("Unsupported binary export version");
+    }
+    uint16_t count = read_le<uint16_t>();
+    columns_.reserve(count);
+    for (uint16_t i = 0; i < count; i++) {
+        ColumnInfo info;
+        info.type = static_cast<ExportColumnType>(read_le<uint8_t>());
+        info.key.resize(read_le<uint16_t>());
+        read_bytes(info.key.data(), info.key.size());
+        columns_.push_back(std::move(info));
+    }
+}
+
+inline bool BinaryExportReader::next(std::vector<ExportField>& fields) {
+    if (done_) return false;
+    if (read_le<uint8_t>() == 0) {
+        count_ = read_le<uint64_t>();
+        done_ = true;
+        return false;
+    }
+    fields.resize(columns_.size());
+    for (size_t i = 0; i < columns_.size(); i++) {
+        ExportField& f = fields[i];
+        switch (columns_[i].type) {
+            case ExportColumnType::TEXT:
+                f.owned.resize(read_le<uint32_t>());
+                read_bytes(f.owned.data(), f.owned.size());
+                f.text = f.owned;
+                break;
+            case ExportColumnType::INTEGER: f.integer = read_le<int64_t>(); break;
+            case ExportColumnType::UNSIGNED: f.uinteger = read_le<uint64_t>(); break;
+            case ExportColumnType::TIMESTAMP:
+                f.time = TimestampCodec::from_epoch(read_le<int64_t>());
+                break;
+            case ExportColumnType::BOOLEAN: f.flag = read_le<uint8_t>() != 0; break;
+            default: throw std::runtime_error("Unknown column type in binary export");
+        }
+    }
+    return true;
+}
+
+template<typename T>
+T BinaryExportReader::read_le() {
+    unsigned char bytes[sizeof(T)];
+    read_bytes(reinterpret_cast<char*>(bytes), sizeof(T));
+    std::make_unsigned_t<T> u = 0;
+    for (size_t i = 0; i < sizeof(T); i++) {
+        u |= static_cast<std::make_unsigned_t<T>>(bytes[i]) << (8 * i);
+    }
+    return static_cast<T>(u);
+}
+
+inline void BinaryExportReader::read_bytes(char* dst, size_t n) {
+    if (n == 0) return;
+    in_.read(dst, static_cast<std::streamsize>(n));
+    if (static_cast<size_t>(in_.gcount()) != n) {
+        throw std::runtime_error("Truncated binary export");
+    }
+}
+
+} // namespace tms
+
+#endif // TMS_EXPORT_H
@@ -172,7 +172,7 @@ inline OperationResult VolumeGroupManager::create_group(const VolumeGroup& group
     }
     
     VolumeGroup g = group;
-    g.created = std::chrono::system_clock::now();
+    g.created = current_time();
     g.modified = g.created;
     
     groups_[g.name] = g;
@@ -237,7 +237,7 @@ inline OperationResult VolumeGroupManager::update_group(const VolumeGroup& group
     
     VolumeGroup updated = group;
     updated.created = it->second.created;
-    updated.modified = std::chrono::system_clock::now();
+    updated.modified = current_time();
     it->second = updated;
     
     return OperationResult::ok();
@@ -293,7 +293,7 @@ inline OperationResult VolumeGroupManager::add_volume(const std::string& group_n
     }
     
     it->second.volumes.insert(volser);
-    it->second.modified = std::chrono::system_clock::now();
+    it->second.modified = current_time();
     volume_to_groups_[volser].insert(group_name);
     
     return OperationResult::ok();
@@ -313,7 +313,7 @@ inline OperationResult VolumeGroupManager::remove_volume(const std::string& grou
     }
     
     it->second.volumes.erase(volser);
-    it->second.modified = std::chrono::system_clock::now();
+    it->second.modified = current_time();
     
     volume_to_groups_[volser].erase(group_name);
     if (volume_to_groups_[volser].empty()) {
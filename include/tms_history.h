@@ -229,7 +229,7 @@ inline std::vector<StatisticsSnapshot> StatisticsHistory::get_snapshots(
 }
 
 inline std::vector<StatisticsSnapshot> StatisticsHistory::get_recent_snapshots(int days) const {
-    auto end = std::chrono::system_clock::now();
+    auto end = current_time();
     auto start = end - std::chrono::hours(24 * days);
     return get_snapshots(start, end);
 }
@@ -296,7 +296,7 @@ inline TrendAnalysis StatisticsHistory::analyze_custom_metric(
 
 inline CapacityProjection StatisticsHistory::project_capacity(int days_ahead) const {
     CapacityProjection result;
-    result.projection_date = std::chrono::system_clock::now() + 
+    result.projection_date = current_time() + 
         std::chrono::hours(24 * days_ahead);
     
     auto snapshots = get_recent_snapshots(30);  // Use 30 days of history
@@ -414,7 +414,7 @@ inline OperationResult StatisticsHistory::export_to_csv(const std::string& path)
 inline size_t StatisticsHistory::cleanup_old_snapshots(int days_to_keep) {
     std::lock_guard<std::mutex> lock(mutex_);
     
-    auto cutoff = std::chrono::system_clock::now() - std::chrono::hours(24 * days_to_keep);
+    auto cutoff = current_time() - std::chrono::hours(24 * days_to_keep);
     size_t original_size = snapshots_.size();
     
     snapshots_.erase(
@@ -437,7 +437,7 @@ inline void StatisticsHistory::clear_history() {
 
 inline StatisticsSnapshot StatisticsHistory::stats_to_snapshot(const SystemStatistics& stats) const {
     StatisticsSnapshot s;
-    s.timestamp = std::chrono::system_clock::now();
+    s.timestamp = current_time();
     s.total_volumes = stats.total_volumes;
     s.scratch_volumes = stats.scratch_volumes;
     s.private_volumes = stats.private_volumes;
@@ -16,10 +16,15 @@
 #include "tms_types.h"
 #include "tms_utils.h"
 #include "error_codes.h"
+#include "tms_memory.h"
 #include <string>
 #include <vector>
 #include <map>
 #include <set>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <memory_resource>
 #include <functional>
 #include <chrono>
 
@@ -69,12 +74,12 @@ struct IntegrityIssue {
     
     IntegrityIssue() : category(IssueCategory::INVALID_DATA),
                        severity(IssueSeverity::WARNING),
-                       detected(std::chrono::system_clock::now()) {}
+                       detected(current_time()) {}
     
     IntegrityIssue(IssueCategory cat, IssueSeverity sev, 
                    const std::string& tgt, const std::string& desc)
         : category(cat), severity(sev), target(tgt), description(desc),
-          detected(std::chrono::system_clock::now()) {}
+          detected(current_time()) {}
 };
 
 /**
@@ -233,6 +238,24 @@ private:
                    const std::string& target, const std::string& desc,
                    const std::string& fix = "", bool auto_fix = false);
     
+    // v3.4.0: Checks over one fetch of the catalog. Indexes hold views of
+    // the fetched records and live in the caller's scratch arena.
+    using VolumeIndex = std::pmr::unordered_map<std::string_view, const TapeVolume*>;
+    static VolumeIndex index_volumes(const std::vector<TapeVolume>& volumes,
+                                     std::pmr::memory_resource* resource);
+    void scan_dataset(const Dataset& dataset, const VolumeIndex& volumes,
+                      std::vector<IntegrityIssue>& issues);
+    void scan_cross_references(const std::vector<TapeVolume>& volumes, const std::vector<Dataset>& datasets,
+                               const VolumeIndex& index, std::pmr::memory_resource* resource,
+                               std::vector<IntegrityIssue>& issues);
+    void scan_capacity(const std::vector<TapeVolume>& volumes, const std::vector<Dataset>& datasets,
+                       std::pmr::memory_resource* resource, std::vector<IntegrityIssue>& issues);
+    void scan_duplicates(const std::vector<TapeVolume>& volumes, const std::vector<Dataset>& datasets,
+                         std::pmr::memory_resource* resource, std::vector<IntegrityIssue>& issues);
+    void scan_expirations(const std::vector<TapeVolume>& volumes, const std::vector<Dataset>& datasets,
+                          std::vector<IntegrityIssue>& issues);
+    static std::string checksum_of(const std::vector<TapeVolume>& volumes, const std::vector<Dataset>& datasets);
+    
     bool check_checksums_ = true;
     bool verbose_ = false;
 };
@@ -247,7 +270,7 @@ inline IntegrityCheckResult IntegrityChecker::check_integrity(
     
     auto start = std::chrono::steady_clock::now();
     IntegrityCheckResult result;
-    result.check_time = std::chrono::system_clock::now();
+    result.check_time = current_time();
     
     auto volumes = get_volumes();
     auto datasets = get_datasets();
@@ -255,6 +278,10 @@ inline IntegrityCheckResult IntegrityChecker::check_integrity(
     result.volumes_checked = volumes.size();
     result.datasets_checked = datasets.size();
     
+    // v3.4.0: Every check reads this one fetch; their indexes share an arena
+    ScratchArena arena(ArenaKind::INTEGRITY);
+    auto index = index_volumes(volumes, arena.resource());
+    
     // Check each volume
     for (const auto& vol : volumes) {
         auto vol_issues = check_volume(vol);
@@ -263,29 +290,17 @@ inline IntegrityCheckResult IntegrityChecker::check_integrity(
     
     // Check each dataset
     for (const auto& ds : datasets) {
-        auto ds_issues = check_dataset(ds, get_volumes);
-        result.issues.insert(result.issues.end(), ds_issues.begin(), ds_issues.end());
+        scan_dataset(ds, index, result.issues);
     }
     
-    // Check cross-references
-    auto xref_issues = check_cross_references(get_volumes, get_datasets);
-    result.issues.insert(result.issues.end(), xref_issues.begin(), xref_issues.end());
-    
-    // Check capacity consistency
-    auto cap_issues = check_capacity_consistency(get_volumes, get_datasets);
-    result.issues.insert(result.issues.end(), cap_issues.begin(), cap_issues.end());
-    
-    // Check duplicates
-    auto dup_issues = check_duplicates(get_volumes, get_datasets);
-    result.issues.insert(result.issues.end(), dup_issues.begin(), dup_issues.end());
-    
-    // Check expirations
-    auto exp_issues = check_expirations(get_volumes, get_datasets);
-    result.issues.insert(result.issues.end(), exp_issues.begin(), exp_issues.end());
+    scan_cross_references(volumes, datasets, index, arena.resource(), result.issues);
+    scan_capacity(volumes, datasets, arena.resource(), result.issues);
+    scan_duplicates(volumes, datasets, arena.resource(), result.issues);
+    scan_expirations(volumes, datasets, result.issues);
     
     // Calculate checksum
     if (check_checksums_) {
-        result.checksum = calculate_checksum(get_volumes, get_datasets);
+        result.checksum = checksum_of(volumes, datasets);
     }
     
     // Count by severity
@@ -366,12 +381,31 @@ inline std::vector<IntegrityIssue> IntegrityChecker::check_dataset(
     const Dataset& dataset, VolumeListCallback get_volumes) {
     
     std::vector<IntegrityIssue> issues;
+    auto volumes = get_volumes();
+    ScratchArena arena(ArenaKind::INTEGRITY);
+    scan_dataset(dataset, index_volumes(volumes, arena.resource()), issues);
+    return issues;
+}
+
+inline IntegrityChecker::VolumeIndex IntegrityChecker::index_volumes(
+    const std::vector<TapeVolume>& volumes, std::pmr::memory_resource* resource) {
+    
+    VolumeIndex index(resource);
+    index.reserve(volumes.size());
+    for (const auto& vol : volumes) {
+        index[vol.volser] = &vol;
+    }
+    return index;
+}
+
+inline void IntegrityChecker::scan_dataset(
+    const Dataset& dataset, const VolumeIndex& volumes, std::vector<IntegrityIssue>& issues) {
     
     // Check name
     if (dataset.name.empty()) {
         add_issue(issues, IssueCategory::MISSING_REQUIRED, IssueSeverity::CRITICAL,
             "", "Dataset has empty name", "Delete invalid dataset entry", true);
-        return issues;
+        return;
     }
     
     if (dataset.name.length() > 44) {
@@ -385,14 +419,7 @@ inline std::vector<IntegrityIssue> IntegrityChecker::check_dataset(
             dataset.name, "Dataset has no volume reference");
     } else {
         // Verify volume exists
-        bool found = false;
-        for (const auto& vol : get_volumes()) {
-            if (vol.volser == dataset.volser) {
-                found = true;
-                break;
-            }
-        }
-        if (!found) {
+        if (volumes.find(dataset.volser) == volumes.end()) {
             add_issue(issues, IssueCategory::ORPHAN_DATASET, IssueSeverity::ERROR,
                 dataset.name, "References non-existent volume: " + dataset.volser,
                 "Delete orphan dataset", true);
@@ -404,8 +431,6 @@ inline std::vector<IntegrityIssue> IntegrityChecker::check_dataset(
         add_issue(issues, IssueCategory::EXPIRATION_ISSUE, IssueSeverity::WARNING,
             dataset.name, "Expiration date before creation date");
     }
-    
-    return issues;
 }
 
 inline std::vector<IntegrityIssue> IntegrityChecker::check_cross_references(
@@ -414,9 +439,18 @@ inline std::vector<IntegrityIssue> IntegrityChecker::check_cross_references(
     std::vector<IntegrityIssue> issues;
     auto volumes = get_volumes();
     auto datasets = get_datasets();
+    ScratchArena arena(ArenaKind::INTEGRITY);
+    scan_cross_references(volumes, datasets, index_volumes(volumes, arena.resource()), arena.resource(), issues);
+    return issues;
+}
+
+inline void IntegrityChecker::scan_cross_references(
+    const std::vector<TapeVolume>& volumes, const std::vector<Dataset>& datasets,
+    const VolumeIndex& index, std::pmr::memory_resource* resource, std::vector<IntegrityIssue>& issues) {
     
     // Build dataset set
-    std::set<std::string> dataset_names;
+    std::pmr::unordered_set<std::string_view> dataset_names(resource);
+    dataset_names.reserve(datasets.size());
     for (const auto& ds : datasets) {
         dataset_names.insert(ds.name);
     }
@@ -433,30 +467,17 @@ inline std::vector<IntegrityIssue> IntegrityChecker::check_cross_references(
     }
     
     // Check dataset volume references
-    std::map<std::string, TapeVolume> vol_map;
-    for (const auto& vol : volumes) {
-        vol_map[vol.volser] = vol;
-    }
-    
     for (const auto& ds : datasets) {
-        auto it = vol_map.find(ds.volser);
-        if (it != vol_map.end()) {
-            bool found = false;
-            for (const auto& name : it->second.datasets) {
-                if (name == ds.name) {
-                    found = true;
-                    break;
-                }
-            }
-            if (!found) {
+        auto it = index.find(ds.volser);
+        if (it != index.end()) {
+            const auto& names = it->second->datasets;
+            if (std::find(names.begin(), names.end(), ds.name) == names.end()) {
                 add_issue(issues, IssueCategory::CROSS_REFERENCE, IssueSeverity::WARNING,
                     ds.name, "Not in volume " + ds.volser + "'s dataset list",
                     "Add to volume's dataset list", true);
             }
         }
     }
-    
-    return issues;
 }
 
 inline std::vector<IntegrityIssue> IntegrityChecker::check_capacity_consistency(
@@ -465,9 +486,18 @@ inline std::vector<IntegrityIssue> IntegrityChecker::check_capacity_consistency(
     std::vector<IntegrityIssue> issues;
     auto volumes = get_volumes();
     auto datasets = get_datasets();
+    ScratchArena arena(ArenaKind::INTEGRITY);
+    scan_capacity(volumes, datasets, arena.resource(), issues);
+    return issues;
+}
+
+inline void IntegrityChecker::scan_capacity(
+    const std::vector<TapeVolume>& volumes, const std::vector<Dataset>& datasets,
+    std::pmr::memory_resource* resource, std::vector<IntegrityIssue>& issues) {
     
     // Calculate actual used bytes per volume
-    std::map<std::string, uint64_t> calculated_usage;
+    std::pmr::unordered_map<std::string_view, uint64_t> calculated_usage(resource);
+    calculated_usage.reserve(volumes.size());
     for (const auto& ds : datasets) {
         calculated_usage[ds.volser] += ds.size_bytes;
     }
@@ -484,45 +514,57 @@ inline std::vector<IntegrityIssue> IntegrityChecker::check_capacity_consistency(
                 "Update to calculated value: " + std::to_string(calc_used), true);
         }
     }
-    
-    return issues;
 }
 
 inline std::vector<IntegrityIssue> IntegrityChecker::check_duplicates(
     VolumeListCallback get_volumes, DatasetListCallback get_datasets) {
     
     std::vector<IntegrityIssue> issues;
+    ScratchArena arena(ArenaKind::INTEGRITY);
+    scan_duplicates(get_volumes(), get_datasets(), arena.resource(), issues);
+    return issues;
+}
+
+inline void IntegrityChecker::scan_duplicates(
+    const std::vector<TapeVolume>& volumes, const std::vector<Dataset>& datasets,
+    std::pmr::memory_resource* resource, std::vector<IntegrityIssue>& issues) {
     
     // Check duplicate volumes
-    std::set<std::string> seen_volsers;
-    for (const auto& vol : get_volumes()) {
-        if (seen_volsers.count(vol.volser) > 0) {
+    std::pmr::unordered_set<std::string_view> seen_volsers(resource);
+    seen_volsers.reserve(volumes.size());
+    for (const auto& vol : volumes) {
+        if (!seen_volsers.insert(vol.volser).second) {
             add_issue(issues, IssueCategory::DUPLICATE_ENTRY, IssueSeverity::CRITICAL,
                 vol.volser, "Duplicate volume serial");
         }
-        seen_volsers.insert(vol.volser);
     }
     
     // Check duplicate datasets
-    std::set<std::string> seen_datasets;
-    for (const auto& ds : get_datasets()) {
-        if (seen_datasets.count(ds.name) > 0) {
+    std::pmr::unordered_set<std::string_view> seen_datasets(resource);
+    seen_datasets.reserve(datasets.size());
+    for (const auto& ds : datasets) {
+        if (!seen_datasets.insert(ds.name).second) {
             add_issue(issues, IssueCategory::DUPLICATE_ENTRY, IssueSeverity::ERROR,
                 ds.name, "Duplicate dataset name");
         }
-        seen_datasets.insert(ds.name);
     }
-    
-    return issues;
 }
 
 inline std::vector<IntegrityIssue> IntegrityChecker::check_expirations(
     VolumeListCallback get_volumes, DatasetListCallback get_datasets) {
     
     std::vector<IntegrityIssue> issues;
-    auto now = std::chrono::system_clock::now();
+    scan_expirations(get_volumes(), get_datasets(), issues);
+    return issues;
+}
+
+inline void IntegrityChecker::scan_expirations(
+    const std::vector<TapeVolume>& volumes, const std::vector<Dataset>& datasets,
+    std::vector<IntegrityIssue>& issues) {
+    
+    auto now = current_time();
     
-    for (const auto& vol : get_volumes()) {
+    for (const auto& vol : volumes) {
         if (vol.status != VolumeStatus::EXPIRED && vol.expiration_date < now) {
             add_issue(issues, IssueCategory::EXPIRATION_ISSUE, IssueSeverity::INFO,
                 vol.volser, "Volume is past expiration date but not marked expired",
@@ -530,29 +572,33 @@ inline std::vector<IntegrityIssue> IntegrityChecker::check_expirations(
         }
     }
     
-    for (const auto& ds : get_datasets()) {
+    for (const auto& ds : datasets) {
         if (ds.status != DatasetStatus::EXPIRED && ds.expiration_date < now) {
             add_issue(issues, IssueCategory::EXPIRATION_ISSUE, IssueSeverity::INFO,
                 ds.name, "Dataset is past expiration date but not marked expired",
                 "Run expiration processing", false);
         }
     }
-    
-    return issues;
 }
 
 inline std::string IntegrityChecker::calculate_checksum(
     VolumeListCallback get_volumes, DatasetListCallback get_datasets) {
     
+    return checksum_of(get_volumes(), get_datasets());
+}
+
+inline std::string IntegrityChecker::checksum_of(
+    const std::vector<TapeVolume>& volumes, const std::vector<Dataset>& datasets) {
+    
     uint32_t checksum = 0;
     
-    for (const auto& vol : get_volumes()) {
+    for (const auto& vol : volumes) {
         for (char c : vol.volser) checksum += static_cast<unsigned char>(c);
         checksum += static_cast<uint32_t>(vol.status);
         checksum += static_cast<uint32_t>(vol.capacity_bytes & 0xFFFFFFFF);
     }
     
-    for (const auto& ds : get_datasets()) {
+    for (const auto& ds : datasets) {
         for (char c : ds.name) checksum += static_cast<unsigned char>(c);
         for (char c : ds.volser) checksum += static_cast<unsigned char>(c);
         checksum += static_cast<uint32_t>(ds.size_bytes & 0xFFFFFFFF);
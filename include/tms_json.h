@@ -23,6 +23,17 @@
 #include <fstream>
 #include <variant>
 #include <stdexcept>
+#include <string_view>
+#include <charconv>
+#include <istream>
+#include <functional>
+#include <type_traits>
+#include <cmath>
+#include <limits>
+#include <memory_resource>
+#include <algorithm>
+#include <cstring>
+#include <new>
 
 namespace tms {
 
@@ -31,29 +42,57 @@ namespace tms {
 // ============================================================================
 
 class JsonValue;
-using JsonObject = std::map<std::string, JsonValue>;
-using JsonArray = std::vector<JsonValue>;
+class JsonObject;
+using JsonArray = std::pmr::vector<JsonValue>;
 
 /**
- * @brief Lightweight JSON value representation
+ * @brief Compact JSON value (tagged union)
+ *
+ * v3.4.0: A value is 24 bytes regardless of type. Strings of up to
+ * SMALL_STRING_CAPACITY bytes are stored inline; longer strings, arrays and
+ * objects live behind a single pointer. Nodes are heap allocated unless they
+ * were built inside a JsonDocument arena, in which case they must not
+ * outlive the document. Moves are pointer steals; copies are deep and always
+ * produce heap-owned values.
  */
 class JsonValue {
 public:
-    enum class Type { Null, Boolean, Number, String, Array, Object };
-    
-    JsonValue() : type_(Type::Null) {}
-    JsonValue(std::nullptr_t) : type_(Type::Null) {}
-    JsonValue(bool b) : type_(Type::Boolean), bool_val_(b) {}
-    JsonValue(int n) : type_(Type::Number), num_val_(static_cast<double>(n)) {}
-    JsonValue(long n) : type_(Type::Number), num_val_(static_cast<double>(n)) {}
-    JsonValue(long long n) : type_(Type::Number), num_val_(static_cast<double>(n)) {}
-    JsonValue(unsigned long n) : type_(Type::Number), num_val_(static_cast<double>(n)) {}
-    JsonValue(unsigned long long n) : type_(Type::Number), num_val_(static_cast<double>(n)) {}
-    JsonValue(double n) : type_(Type::Number), num_val_(n) {}
-    JsonValue(const char* s) : type_(Type::String), str_val_(s) {}
-    JsonValue(const std::string& s) : type_(Type::String), str_val_(s) {}
-    JsonValue(const JsonArray& arr) : type_(Type::Array), arr_val_(arr) {}
-    JsonValue(const JsonObject& obj) : type_(Type::Object), obj_val_(obj) {}
+    enum class Type : uint8_t { Null, Boolean, Number, String, Array, Object };
+    
+    static constexpr size_t SMALL_STRING_CAPACITY = 16;
+    
+    JsonValue() noexcept { u_.number = 0.0; }
+    JsonValue(std::nullptr_t) noexcept : JsonValue() {}
+    JsonValue(bool b) noexcept : type_(Type::Boolean) { u_.boolean = b; }
+    JsonValue(int n) noexcept : type_(Type::Number) { u_.number = static_cast<double>(n); }
+    JsonValue(long n) noexcept : type_(Type::Number) { u_.number = static_cast<double>(n); }
+    JsonValue(long long n) noexcept : type_(Type::Number) { u_.number = static_cast<double>(n); }
+    JsonValue(unsigned long n) noexcept : type_(Type::Number) { u_.number = static_cast<double>(n); }
+    JsonValue(unsigned long long n) noexcept : type_(Type::Number) { u_.number = static_cast<double>(n); }
+    JsonValue(double n) noexcept : type_(Type::Number) { u_.number = n; }
+    JsonValue(const char* s) : JsonValue(std::string_view(s)) {}
+    JsonValue(const std::string& s) : JsonValue(std::string_view(s)) {}
+    JsonValue(std::string_view s, std::pmr::memory_resource* arena = nullptr) { init_string(s, arena); }
+    JsonValue(const JsonArray& arr);
+    JsonValue(JsonArray&& arr);
+    JsonValue(const JsonObject& obj);
+    JsonValue(JsonObject&& obj);
+    
+    JsonValue(const JsonValue& other);
+    JsonValue(JsonValue&& other) noexcept { steal(other); }
+    JsonValue& operator=(const JsonValue& other);
+    JsonValue& operator=(JsonValue&& other) noexcept;
+    ~JsonValue() { release(); }
+    
+    /**
+     * @brief Create an empty array, optionally inside an arena
+     */
+    static JsonValue make_array(std::pmr::memory_resource* arena = nullptr);
+    
+    /**
+     * @brief Create an empty object, optionally inside an arena
+     */
+    static JsonValue make_object(std::pmr::memory_resource* arena = nullptr);
     
     Type type() const { return type_; }
     bool is_null() const { return type_ == Type::Null; }
@@ -63,52 +102,236 @@ public:
     bool is_array() const { return type_ == Type::Array; }
     bool is_object() const { return type_ == Type::Object; }
     
-    bool as_bool() const { return bool_val_; }
-    double as_number() const { return num_val_; }
-    int as_int() const { return static_cast<int>(num_val_); }
-    int64_t as_int64() const { return static_cast<int64_t>(num_val_); }
-    uint64_t as_uint64() const { return static_cast<uint64_t>(num_val_); }
-    const std::string& as_string() const { return str_val_; }
-    const JsonArray& as_array() const { return arr_val_; }
-    const JsonObject& as_object() const { return obj_val_; }
-    JsonArray& as_array() { return arr_val_; }
-    JsonObject& as_object() { return obj_val_; }
+    bool as_bool() const { return type_ == Type::Boolean && u_.boolean; }
+    double as_number() const { return type_ == Type::Number ? u_.number : 0.0; }
+    int as_int() const { return static_cast<int>(as_number()); }
+    int64_t as_int64() const { return static_cast<int64_t>(as_number()); }
+    uint64_t as_uint64() const { return static_cast<uint64_t>(as_number()); }
+    std::string_view as_string() const;
+    const JsonArray& as_array() const;
+    const JsonObject& as_object() const;
+    JsonArray& as_array();     ///< Converts null to an empty array
+    JsonObject& as_object();   ///< Converts null to an empty object
     
     // Object access
-    JsonValue& operator[](const std::string& key) { return obj_val_[key]; }
-    const JsonValue& operator[](const std::string& key) const {
-        static JsonValue null_val;
-        auto it = obj_val_.find(key);
-        return it != obj_val_.end() ? it->second : null_val;
-    }
+    JsonValue& operator[](std::string_view key);
+    const JsonValue& operator[](std::string_view key) const;
     
     // Array access
-    JsonValue& operator[](size_t idx) { return arr_val_[idx]; }
-    const JsonValue& operator[](size_t idx) const { return arr_val_[idx]; }
+    JsonValue& operator[](size_t idx) { return as_array()[idx]; }
+    const JsonValue& operator[](size_t idx) const { return as_array()[idx]; }
+    
+    size_t size() const;
+    bool contains(std::string_view key) const;
+    
+    /// True when the payload lives in a JsonDocument arena
+    bool in_arena() const { return (flags_ & FLAG_ARENA) != 0; }
+    
+private:
+    static constexpr uint8_t FLAG_ARENA = 0x01;
+    static constexpr uint8_t FLAG_LONG_STRING = 0x02;
+    
+    struct LongString {
+        char* data;
+        size_t size;
+    };
+    
+    union Payload {
+        bool boolean;
+        double number;
+        char small[SMALL_STRING_CAPACITY];
+        LongString str;
+        JsonArray* array;
+        JsonObject* object;
+    };
+    
+    void init_string(std::string_view s, std::pmr::memory_resource* arena);
+    void release() noexcept;
+    void steal(JsonValue& other) noexcept {
+        type_ = other.type_;
+        flags_ = other.flags_;
+        small_size_ = other.small_size_;
+        u_ = other.u_;
+        other.type_ = Type::Null;
+        other.flags_ = 0;
+    }
+    
+    Type type_ = Type::Null;
+    uint8_t flags_ = 0;
+    uint8_t small_size_ = 0;
+    Payload u_;
+};
+
+/**
+ * @brief JSON object stored as a key-sorted flat vector
+ *
+ * v3.4.0: Replaces std::map. Lookups are binary searches over contiguous
+ * members and iteration order is by key, as before.
+ */
+class JsonObject {
+public:
+    using value_type = std::pair<std::pmr::string, JsonValue>;
+    using storage_type = std::pmr::vector<value_type>;
+    using iterator = storage_type::iterator;
+    using const_iterator = storage_type::const_iterator;
+    
+    JsonObject() = default;
+    explicit JsonObject(std::pmr::memory_resource* mr) : members_(mr) {}
+    JsonObject(const JsonObject& other, std::pmr::memory_resource* mr) : members_(other.members_, mr) {}
+    
+    JsonValue& operator[](std::string_view key) {
+        auto it = lower_bound(key);
+        if (it == members_.end() || it->first != key) {
+            it = members_.emplace(it, key, JsonValue());
+        }
+        return it->second;
+    }
+    
+    iterator find(std::string_view key) {
+        auto it = lower_bound(key);
+        return (it != members_.end() && it->first == key) ? it : members_.end();
+    }
+    
+    const_iterator find(std::string_view key) const {
+        auto it = std::lower_bound(members_.begin(), members_.end(), key,
+            [](const value_type& m, std::string_view k) { return std::string_view(m.first) < k; });
+        return (it != members_.end() && it->first == key) ? it : members_.end();
+    }
+    
+    size_t count(std::string_view key) const { return find(key) != members_.end() ? 1 : 0; }
+    bool contains(std::string_view key) const { return count(key) > 0; }
+    
+    size_t erase(std::string_view key) {
+        auto it = find(key);
+        if (it == members_.end()) return 0;
+        members_.erase(it);
+        return 1;
+    }
+    
+    /**
+     * @brief Append without ordering; call sort_members() when done
+     *
+     * Used by the parser to build objects in O(n log n) instead of
+     * repeated sorted inserts.
+     */
+    void append_unsorted(std::string_view key, JsonValue&& value) {
+        members_.emplace_back(key, std::move(value));
+    }
+    
+    /**
+     * @brief Restore key order after append_unsorted(); later duplicates win
+     */
+    void sort_members();
     
-    size_t size() const {
-        if (type_ == Type::Array) return arr_val_.size();
-        if (type_ == Type::Object) return obj_val_.size();
-        return 0;
+    size_t size() const { return members_.size(); }
+    bool empty() const { return members_.empty(); }
+    void clear() { members_.clear(); }
+    void reserve(size_t n) { members_.reserve(n); }
+    std::pmr::memory_resource* resource() const { return members_.get_allocator().resource(); }
+    
+    iterator begin() { return members_.begin(); }
+    iterator end() { return members_.end(); }
+    const_iterator begin() const { return members_.begin(); }
+    const_iterator end() const { return members_.end(); }
+    
+private:
+    iterator lower_bound(std::string_view key) {
+        return std::lower_bound(members_.begin(), members_.end(), key,
+            [](const value_type& m, std::string_view k) { return std::string_view(m.first) < k; });
     }
     
-    bool contains(const std::string& key) const {
-        return type_ == Type::Object && obj_val_.count(key) > 0;
+    storage_type members_;
+};
+
+// ============================================================================
+// v3.4.0: Document Arena
+// ============================================================================
+
+/**
+ * @brief Monotonic bump allocator backing a JsonDocument
+ *
+ * Individual deallocations are no-ops; all memory is returned at once
+ * when the arena is destroyed.
+ */
+class JsonArena : public std::pmr::memory_resource {
+public:
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+    
+    explicit JsonArena(size_t block_size = DEFAULT_BLOCK_SIZE) : block_size_(block_size) {}
+    ~JsonArena() override { release(); }
+    
+    JsonArena(const JsonArena&) = delete;
+    JsonArena& operator=(const JsonArena&) = delete;
+    
+    void release() {
+        for (const auto& b : blocks_) {
+            ::operator delete(b.data, std::align_val_t(alignof(std::max_align_t)));
+        }
+        blocks_.clear();
+        cur_ = nullptr;
+        remaining_ = 0;
+        used_ = 0;
+        reserved_ = 0;
     }
     
+    size_t bytes_used() const { return used_; }          ///< Bytes handed out
+    size_t bytes_reserved() const { return reserved_; }  ///< Bytes obtained from the heap
+    size_t block_count() const { return blocks_.size(); }
+    
+private:
+    struct Block {
+        void* data;
+        size_t size;
+    };
+    
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void*, size_t, size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+    
+    size_t block_size_;
+    std::vector<Block> blocks_;
+    char* cur_ = nullptr;
+    size_t remaining_ = 0;
+    size_t used_ = 0;
+    size_t reserved_ = 0;
+};
+
+/**
+ * @brief Parsed JSON document whose nodes share one arena
+ *
+ * Parsing into a document performs no per-node heap allocation. The tree is
+ * owned by the document; copy root() to obtain a detached heap value.
+ */
+class JsonDocument {
+public:
+    explicit JsonDocument(size_t block_size = JsonArena::DEFAULT_BLOCK_SIZE) : arena_(block_size) {}
+    
+    JsonDocument(const JsonDocument&) = delete;
+    JsonDocument& operator=(const JsonDocument&) = delete;
+    
+    void parse(std::string_view json);
+    void parse(std::istream& in);
+    
+    const JsonValue& root() const { return root_; }
+    JsonValue& root() { return root_; }
+    std::pmr::memory_resource* resource() { return &arena_; }
+    size_t memory_used() const { return arena_.bytes_used(); }
+    size_t memory_reserved() const { return arena_.bytes_reserved(); }
+    
 private:
-    Type type_;
-    bool bool_val_ = false;
-    double num_val_ = 0.0;
-    std::string str_val_;
-    JsonArray arr_val_;
-    JsonObject obj_val_;
+    JsonArena arena_;   // declared first: the tree is destroyed before its arena
+    JsonValue root_;
 };
 
 // ============================================================================
 // JSON Serializer
 // ============================================================================
 
+class JsonReader;
+enum class JsonToken;
+
 /**
  * @brief JSON serialization utilities
  */
@@ -145,26 +368,24 @@ public:
     /**
      * @brief Parse JSON string to JsonValue
      */
-    static JsonValue parse(const std::string& json) {
-        size_t pos = 0;
-        skip_whitespace(json, pos);
-        return parse_value(json, pos);
-    }
+    static JsonValue parse(std::string_view json);
     
     /**
      * @brief Parse JSON file to JsonValue
      */
-    static JsonValue parse_file(const std::string& path) {
-        std::ifstream file(path);
-        if (!file.is_open()) {
-            throw std::runtime_error("Cannot open file: " + path);
-        }
-        std::stringstream buffer;
-        buffer << file.rdbuf();
-        return parse(buffer.str());
-    }
+    static JsonValue parse_file(const std::string& path);
+    
+    /**
+     * @brief Build one value from a reader positioned on its first token
+     *
+     * Nodes are allocated from @p arena when given, otherwise on the heap.
+     */
+    static JsonValue build_value(JsonReader& reader, JsonToken token,
+                                 std::pmr::memory_resource* arena = nullptr);
     
 private:
+    struct TreeBuilder;
+    
     static void serialize_value(std::ostream& os, const JsonValue& val,
                                 const Options& opts, int depth) {
         switch (val.type()) {
@@ -231,169 +452,301 @@ private:
         os << '}';
     }
     
-    static std::string escape_string(const std::string& s) {
-        std::ostringstream oss;
+    static std::string escape_string(std::string_view s) {
+        static const char* hex = "0123456789abcdef";
+        std::string out;
+        out.reserve(s.size());
         for (char c : s) {
             switch (c) {
-                case '"': oss << "\\\""; break;
-                case '\\': oss << "\\\\"; break;
-                case '\b': oss << "\\b"; break;
-                case '\f': oss << "\\f"; break;
-                case '\n': oss << "\\n"; break;
-                case '\r': oss << "\\r"; break;
-                case '\t': oss << "\\t"; break;
+                case '"': out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\b': out += "\\b"; break;
+                case '\f': out += "\\f"; break;
+                case '\n': out += "\\n"; break;
+                case '\r': out += "\\r"; break;
+                case '\t': out += "\\t"; break;
                 default:
                     if (static_cast<unsigned char>(c) < 0x20) {
-                        oss << "\\u" << std::hex << std::setw(4) << std::setfill('0')
-                            << static_cast<int>(c);
+                        out += "\\u00";
+                        out += hex[(c >> 4) & 0x0F];
+                        out += hex[c & 0x0F];
                     } else {
-                        oss << c;
+                        out += c;
                     }
             }
         }
-        return oss.str();
+        return out;
+    }
+};
+
+// ============================================================================
+// v3.4.0: Streaming JSON Writer
+// ============================================================================
+
+/**
+ * @brief Buffered, forward-only JSON writer
+ *
+ * Emits tokens straight to an output stream through a fixed-size buffer,
+ * so documents of any size can be produced without building a JsonValue
+ * tree. Numbers are formatted with std::to_chars.
+ */
+class JsonWriter {
+public:
+    static constexpr size_t DEFAULT_BUFFER_SIZE = 64 * 1024;
+    
+    explicit JsonWriter(std::ostream& os, bool pretty_print = false,
+                        int indent_size = 2, size_t buffer_size = DEFAULT_BUFFER_SIZE)
+        : os_(os), pretty_(pretty_print), indent_size_(indent_size),
+          buffer_limit_(buffer_size) {
+        buffer_.reserve(buffer_limit_ + 64);
     }
     
-    static void skip_whitespace(const std::string& json, size_t& pos) {
-        while (pos < json.size() && std::isspace(json[pos])) pos++;
+    ~JsonWriter() { flush(); }
+    
+    JsonWriter(const JsonWriter&) = delete;
+    JsonWriter& operator=(const JsonWriter&) = delete;
+    
+    JsonWriter& begin_object() { open('{', true); return *this; }
+    JsonWriter& end_object() { close('}'); return *this; }
+    JsonWriter& begin_array() { open('[', false); return *this; }
+    JsonWriter& end_array() { close(']'); return *this; }
+    
+    /**
+     * @brief Write an object member name; the next call must write its value
+     */
+    JsonWriter& key(std::string_view name) {
+        before_value();
+        write_string(name);
+        put(':');
+        if (pretty_) put(' ');
+        after_key_ = true;
+        return *this;
     }
     
-    static JsonValue parse_value(const std::string& json, size_t& pos) {
-        skip_whitespace(json, pos);
-        if (pos >= json.size()) return JsonValue();
-        
-        char c = json[pos];
-        if (c == 'n') return parse_null(json, pos);
-        if (c == 't' || c == 'f') return parse_bool(json, pos);
-        if (c == '"') return parse_string(json, pos);
-        if (c == '[') return parse_array(json, pos);
-        if (c == '{') return parse_object(json, pos);
-        if (c == '-' || std::isdigit(c)) return parse_number(json, pos);
-        
-        throw std::runtime_error("Invalid JSON at position " + std::to_string(pos));
-    }
-    
-    static JsonValue parse_null(const std::string& json, size_t& pos) {
-        if (json.substr(pos, 4) == "null") {
-            pos += 4;
-            return JsonValue();
-        }
-        throw std::runtime_error("Expected 'null'");
-    }
-    
-    static JsonValue parse_bool(const std::string& json, size_t& pos) {
-        if (json.substr(pos, 4) == "true") {
-            pos += 4;
-            return JsonValue(true);
-        }
-        if (json.substr(pos, 5) == "false") {
-            pos += 5;
-            return JsonValue(false);
-        }
-        throw std::runtime_error("Expected 'true' or 'false'");
-    }
-    
-    static JsonValue parse_string(const std::string& json, size_t& pos) {
-        pos++; // skip opening quote
-        std::string result;
-        while (pos < json.size() && json[pos] != '"') {
-            if (json[pos] == '\\') {
-                pos++;
-                if (pos >= json.size()) break;
-                switch (json[pos]) {
-                    case '"': result += '"'; break;
-                    case '\\': result += '\\'; break;
-                    case '/': result += '/'; break;
-                    case 'b': result += '\b'; break;
-                    case 'f': result += '\f'; break;
-                    case 'n': result += '\n'; break;
-                    case 'r': result += '\r'; break;
-                    case 't': result += '\t'; break;
-                    case 'u': {
-                        pos++;
-                        if (pos + 4 <= json.size()) {
-                            int code = std::stoi(json.substr(pos, 4), nullptr, 16);
-                            if (code < 0x80) {
-                                result += static_cast<char>(code);
-                            }
-                            pos += 3;
-                        }
-                        break;
-                    }
-                    default: result += json[pos];
-                }
-            } else {
-                result += json[pos];
-            }
-            pos++;
+    JsonWriter& value(std::string_view s) { before_value(); write_string(s); return *this; }
+    JsonWriter& value(const char* s) { return value(std::string_view(s)); }
+    JsonWriter& value(const std::string& s) { return value(std::string_view(s)); }
+    JsonWriter& value(bool b) { before_value(); raw(b ? "true" : "false"); return *this; }
+    JsonWriter& value(double d);
+    JsonWriter& null_value() { before_value(); raw("null"); return *this; }
+    
+    template<typename T>
+        requires (std::is_integral_v<T> && !std::is_same_v<T, bool>)
+    JsonWriter& value(T n) {
+        before_value();
+        char tmp[24];
+        auto res = std::to_chars(tmp, tmp + sizeof(tmp), n);
+        raw(std::string_view(tmp, static_cast<size_t>(res.ptr - tmp)));
+        return *this;
+    }
+    
+    /**
+     * @brief Write a complete "name": value member
+     */
+    template<typename T>
+    JsonWriter& field(std::string_view name, const T& v) {
+        key(name);
+        return value(v);
+    }
+    
+    /**
+     * @brief Write an existing JsonValue subtree at the current position
+     */
+    JsonWriter& value(const JsonValue& v);
+    
+    /**
+     * @brief Push buffered output to the underlying stream
+     */
+    void flush() {
+        if (!buffer_.empty()) {
+            os_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+            buffer_.clear();
         }
-        pos++; // skip closing quote
-        return JsonValue(result);
+        os_.flush();
     }
     
-    static JsonValue parse_number(const std::string& json, size_t& pos) {
-        size_t start = pos;
-        if (json[pos] == '-') pos++;
-        while (pos < json.size() && std::isdigit(json[pos])) pos++;
-        if (pos < json.size() && json[pos] == '.') {
-            pos++;
-            while (pos < json.size() && std::isdigit(json[pos])) pos++;
+    size_t bytes_written() const { return bytes_written_ + buffer_.size(); }
+    size_t depth() const { return stack_.size(); }
+    bool good() const { return os_.good(); }
+    
+private:
+    struct Frame {
+        bool is_object;
+        bool empty;
+    };
+    
+    void put(char c) {
+        buffer_.push_back(c);
+        if (buffer_.size() >= buffer_limit_) drain();
+    }
+    
+    void raw(std::string_view s) {
+        buffer_.append(s.data(), s.size());
+        if (buffer_.size() >= buffer_limit_) drain();
+    }
+    
+    void drain() {
+        os_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+        bytes_written_ += buffer_.size();
+        buffer_.clear();
+    }
+    
+    void newline_indent() {
+        put('\n');
+        for (size_t i = 0; i < stack_.size() * static_cast<size_t>(indent_size_); i++) put(' ');
+    }
+    
+    void before_value() {
+        if (after_key_) {
+            after_key_ = false;
+            return;
         }
-        if (pos < json.size() && (json[pos] == 'e' || json[pos] == 'E')) {
-            pos++;
-            if (pos < json.size() && (json[pos] == '+' || json[pos] == '-')) pos++;
-            while (pos < json.size() && std::isdigit(json[pos])) pos++;
+        if (stack_.empty()) {
+            // Successive top-level values are newline separated (JSON Lines)
+            if (top_level_written_) put('\n');
+            top_level_written_ = true;
+            return;
         }
-        return JsonValue(std::stod(json.substr(start, pos - start)));
+        Frame& f = stack_.back();
+        if (!f.empty) put(',');
+        f.empty = false;
+        if (pretty_) newline_indent();
     }
     
-    static JsonValue parse_array(const std::string& json, size_t& pos) {
-        pos++; // skip [
-        JsonArray arr;
-        skip_whitespace(json, pos);
-        if (json[pos] == ']') {
-            pos++;
-            return JsonValue(arr);
-        }
-        while (true) {
-            arr.push_back(parse_value(json, pos));
-            skip_whitespace(json, pos);
-            if (json[pos] == ']') {
-                pos++;
-                break;
-            }
-            if (json[pos] != ',') throw std::runtime_error("Expected ',' or ']'");
-            pos++;
+    void open(char c, bool is_object) {
+        before_value();
+        put(c);
+        stack_.push_back({is_object, true});
+    }
+    
+    void close(char c) {
+        if (stack_.empty()) {
+            throw std::runtime_error("JsonWriter: unbalanced container close");
         }
-        return JsonValue(arr);
+        bool was_empty = stack_.back().empty;
+        stack_.pop_back();
+        if (pretty_ && !was_empty) newline_indent();
+        put(c);
     }
     
-    static JsonValue parse_object(const std::string& json, size_t& pos) {
-        pos++; // skip {
-        JsonObject obj;
-        skip_whitespace(json, pos);
-        if (json[pos] == '}') {
-            pos++;
-            return JsonValue(obj);
-        }
-        while (true) {
-            skip_whitespace(json, pos);
-            if (json[pos] != '"') throw std::runtime_error("Expected string key");
-            std::string key = parse_string(json, pos).as_string();
-            skip_whitespace(json, pos);
-            if (json[pos] != ':') throw std::runtime_error("Expected ':'");
-            pos++;
-            obj[key] = parse_value(json, pos);
-            skip_whitespace(json, pos);
-            if (json[pos] == '}') {
-                pos++;
-                break;
-            }
-            if (json[pos] != ',') throw std::runtime_error("Expected ',' or '}'");
-            pos++;
+    void write_string(std::string_view s);
+    
+    std::ostream& os_;
+    bool pretty_;
+    int indent_size_;
+    size_t buffer_limit_;
+    std::string buffer_;
+    std::vector<Frame> stack_;
+    bool after_key_ = false;
+    bool top_level_written_ = false;
+    size_t bytes_written_ = 0;
+};
+
+// ============================================================================
+// v3.4.0: Streaming JSON Reader
+// ============================================================================
+
+/**
+ * @brief Token kinds produced by JsonReader
+ */
+enum class JsonToken {
+    BeginObject,
+    EndObject,
+    BeginArray,
+    EndArray,
+    Key,
+    String,
+    Number,
+    Boolean,
+    Null,
+    EndOfInput
+};
+
+/**
+ * @brief Pull parser over an in-memory buffer or an input stream
+ *
+ * Each call to next() returns one token. String and key tokens are exposed
+ * as std::string_view into the reader's window and stay valid until the
+ * following next() call. When reading from a stream only the current token
+ * plus one chunk is held in memory. Multiple top-level values are accepted
+ * in sequence, which makes the reader usable for JSON Lines input.
+ * Malformed input throws std::runtime_error, as JsonSerializer::parse does.
+ */
+class JsonReader {
+public:
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+    
+    explicit JsonReader(std::string_view json) : data_(json) {}
+    
+    explicit JsonReader(std::istream& is, size_t chunk_size = DEFAULT_CHUNK_SIZE)
+        : in_(&is), chunk_size_(chunk_size == 0 ? DEFAULT_CHUNK_SIZE : chunk_size) {}
+    
+    JsonReader(const JsonReader&) = delete;
+    JsonReader& operator=(const JsonReader&) = delete;
+    
+    /**
+     * @brief Advance to the next token
+     */
+    JsonToken next();
+    
+    /**
+     * @brief Look at the next token without consuming it
+     */
+    JsonToken peek() {
+        if (!peeked_) {
+            next();
+            peeked_ = true;
         }
-        return JsonValue(obj);
+        return token_;
     }
+    
+    /**
+     * @brief Skip the next complete value (scalar, object or array)
+     */
+    void skip_value();
+    
+    JsonToken token() const { return token_; }
+    std::string_view string_value() const { return str_; }
+    std::string_view raw_number() const { return str_; }
+    bool bool_value() const { return bool_; }
+    double number_value() const;
+    int64_t int_value() const;
+    uint64_t uint_value() const;
+    
+    size_t depth() const { return stack_.size(); }
+    size_t position() const { return consumed_ + pos_; }
+    
+private:
+    struct Frame {
+        bool is_object;
+        bool need_comma;
+    };
+    
+    bool refill();
+    bool ensure(size_t n);
+    void skip_whitespace();
+    JsonToken read_value();
+    void read_string();
+    void read_number();
+    void read_literal(std::string_view word);
+    [[noreturn]] void fail(const std::string& what) const {
+        throw std::runtime_error("JSON error at position " + std::to_string(position()) + ": " + what);
+    }
+    
+    std::string_view data_;
+    size_t pos_ = 0;
+    std::istream* in_ = nullptr;
+    size_t chunk_size_ = DEFAULT_CHUNK_SIZE;
+    std::string buffer_;
+    size_t consumed_ = 0;
+    
+    std::vector<Frame> stack_;
+    bool expect_value_ = false;
+    JsonToken token_ = JsonToken::EndOfInput;
+    std::string_view str_;
+    std::string scratch_;
+    bool bool_ = false;
+    bool peeked_ = false;
 };
 
 // ============================================================================
@@ -411,9 +764,9 @@ public:
         obj["volser"] = vol.volser;
         obj["status"] = volume_status_to_string(vol.status);
         obj["density"] = density_to_string(vol.density);
-        obj["location"] = vol.location;
-        obj["pool"] = vol.pool;
-        obj["owner"] = vol.owner;
+        obj["location"] = vol.location.str();
+        obj["pool"] = vol.pool.str();
+        obj["owner"] = vol.owner.str();
         obj["mount_count"] = vol.mount_count;
         obj["write_protected"] = vol.write_protected;
         obj["capacity_bytes"] = vol.capacity_bytes;
@@ -427,24 +780,24 @@ public:
         
         JsonArray tags;
         for (const auto& tag : vol.tags) {
-            tags.push_back(tag);
+            tags.push_back(tag.str());
         }
-        obj["tags"] = tags;
+        obj["tags"] = std::move(tags);
         
         JsonArray datasets;
         for (const auto& ds : vol.datasets) {
             datasets.push_back(ds);
         }
-        obj["datasets"] = datasets;
+        obj["datasets"] = std::move(datasets);
         
-        return JsonValue(obj);
+        return JsonValue(std::move(obj));
     }
     
     static TapeVolume json_to_volume(const JsonValue& json) {
         TapeVolume vol;
         if (json.contains("volser")) vol.volser = json["volser"].as_string();
-        if (json.contains("status")) vol.status = string_to_volume_status(json["status"].as_string());
-        if (json.contains("density")) vol.density = string_to_density(json["density"].as_string());
+        if (json.contains("status")) vol.status = string_to_volume_status(std::string(json["status"].as_string()));
+        if (json.contains("density")) vol.density = string_to_density(std::string(json["density"].as_string()));
         if (json.contains("location")) vol.location = json["location"].as_string();
         if (json.contains("pool")) vol.pool = json["pool"].as_string();
         if (json.contains("owner")) vol.owner = json["owner"].as_string();
@@ -453,20 +806,20 @@ public:
         if (json.contains("capacity_bytes")) vol.capacity_bytes = json["capacity_bytes"].as_uint64();
         if (json.contains("used_bytes")) vol.used_bytes = json["used_bytes"].as_uint64();
         if (json.contains("error_count")) vol.error_count = json["error_count"].as_int();
-        if (json.contains("creation_date")) vol.creation_date = parse_time(json["creation_date"].as_string());
-        if (json.contains("expiration_date")) vol.expiration_date = parse_time(json["expiration_date"].as_string());
+        if (json.contains("creation_date")) vol.creation_date = parse_time(std::string(json["creation_date"].as_string()));
+        if (json.contains("expiration_date")) vol.expiration_date = parse_time(std::string(json["expiration_date"].as_string()));
         if (json.contains("notes")) vol.notes = json["notes"].as_string();
         if (json.contains("reserved_by")) vol.reserved_by = json["reserved_by"].as_string();
         
         if (json.contains("tags")) {
             for (size_t i = 0; i < json["tags"].size(); i++) {
-                vol.tags.insert(json["tags"][i].as_string());
+                vol.tags.emplace(json["tags"][i].as_string());
             }
         }
         
         if (json.contains("datasets")) {
             for (size_t i = 0; i < json["datasets"].size(); i++) {
-                vol.datasets.push_back(json["datasets"][i].as_string());
+                vol.datasets.emplace_back(json["datasets"][i].as_string());
             }
         }
         
@@ -480,8 +833,8 @@ public:
         obj["volser"] = ds.volser;
         obj["status"] = dataset_status_to_string(ds.status);
         obj["size_bytes"] = ds.size_bytes;
-        obj["owner"] = ds.owner;
-        obj["job_name"] = ds.job_name;
+        obj["owner"] = ds.owner.str();
+        obj["job_name"] = ds.job_name.str();
         obj["file_sequence"] = ds.file_sequence;
         obj["generation"] = ds.generation;
         obj["version"] = ds.version;
@@ -495,18 +848,18 @@ public:
         
         JsonArray tags;
         for (const auto& tag : ds.tags) {
-            tags.push_back(tag);
+            tags.push_back(tag.str());
         }
-        obj["tags"] = tags;
+        obj["tags"] = std::move(tags);
         
-        return JsonValue(obj);
+        return JsonValue(std::move(obj));
     }
     
     static Dataset json_to_dataset(const JsonValue& json) {
         Dataset ds;
         if (json.contains("name")) ds.name = json["name"].as_string();
         if (json.contains("volser")) ds.volser = json["volser"].as_string();
-        if (json.contains("status")) ds.status = string_to_dataset_status(json["status"].as_string());
+        if (json.contains("status")) ds.status = string_to_dataset_status(std::string(json["status"].as_string()));
         if (json.contains("size_bytes")) ds.size_bytes = json["size_bytes"].as_uint64();
         if (json.contains("owner")) ds.owner = json["owner"].as_string();
         if (json.contains("job_name")) ds.job_name = json["job_name"].as_string();
@@ -516,13 +869,13 @@ public:
         if (json.contains("record_format")) ds.record_format = json["record_format"].as_string();
         if (json.contains("block_size")) ds.block_size = json["block_size"].as_uint64();
         if (json.contains("record_length")) ds.record_length = json["record_length"].as_uint64();
-        if (json.contains("creation_date")) ds.creation_date = parse_time(json["creation_date"].as_string());
-        if (json.contains("expiration_date")) ds.expiration_date = parse_time(json["expiration_date"].as_string());
+        if (json.contains("creation_date")) ds.creation_date = parse_time(std::string(json["creation_date"].as_string()));
+        if (json.contains("expiration_date")) ds.expiration_date = parse_time(std::string(json["expiration_date"].as_string()));
         if (json.contains("notes")) ds.notes = json["notes"].as_string();
         
         if (json.contains("tags")) {
             for (size_t i = 0; i < json["tags"].size(); i++) {
-                ds.tags.insert(json["tags"][i].as_string());
+                ds.tags.emplace(json["tags"][i].as_string());
             }
         }
         
@@ -537,18 +890,20 @@ public:
         catalog["generated"] = get_timestamp();
         
         JsonArray vol_arr;
+        vol_arr.reserve(volumes.size());
         for (const auto& vol : volumes) {
             vol_arr.push_back(volume_to_json(vol));
         }
-        catalog["volumes"] = vol_arr;
+        catalog["volumes"] = std::move(vol_arr);
         
         JsonArray ds_arr;
+        ds_arr.reserve(datasets.size());
         for (const auto& ds : datasets) {
             ds_arr.push_back(dataset_to_json(ds));
         }
-        catalog["datasets"] = ds_arr;
+        catalog["datasets"] = std::move(ds_arr);
         
-        return JsonValue(catalog);
+        return JsonValue(std::move(catalog));
     }
     
     // Statistics serialization
@@ -574,12 +929,905 @@ public:
         for (const auto& [name, count] : stats.pool_counts) {
             pools[name] = count;
         }
-        obj["pool_counts"] = pools;
+        obj["pool_counts"] = std::move(pools);
         
-        return JsonValue(obj);
+        return JsonValue(std::move(obj));
+    }
+    
+    // ========================================================================
+    // v3.4.0: Streaming serialization
+    // ========================================================================
+    
+    /**
+     * @brief Write a volume as one JSON object without building a JsonValue
+     */
+    static void write_volume(JsonWriter& w, const TapeVolume& vol) {
+        w.begin_object();
+        w.field("volser", vol.volser);
+        w.field("status", volume_status_to_string(vol.status));
+        w.field("density", density_to_string(vol.density));
+        w.field("location", vol.location);
+        w.field("pool", vol.pool);
+        w.field("owner", vol.owner);
+        w.field("mount_count", vol.mount_count);
+        w.field("write_protected", vol.write_protected);
+        w.field("capacity_bytes", vol.capacity_bytes);
+        w.field("used_bytes", vol.used_bytes);
+        w.field("error_count", vol.error_count);
+        w.field("creation_date", format_time(vol.creation_date));
+        w.field("expiration_date", format_time(vol.expiration_date));
+        w.field("last_used", format_time(vol.last_used));
+        w.field("notes", vol.notes);
+        w.field("reserved_by", vol.reserved_by);
+        w.key("tags").begin_array();
+        for (const auto& tag : vol.tags) w.value(tag);
+        w.end_array();
+        w.key("datasets").begin_array();
+        for (const auto& ds : vol.datasets) w.value(ds);
+        w.end_array();
+        w.end_object();
+    }
+    
+    /**
+     * @brief Write a dataset as one JSON object without building a JsonValue
+     */
+    static void write_dataset(JsonWriter& w, const Dataset& ds) {
+        w.begin_object();
+        w.field("name", ds.name);
+        w.field("volser", ds.volser);
+        w.field("status", dataset_status_to_string(ds.status));
+        w.field("size_bytes", ds.size_bytes);
+        w.field("owner", ds.owner);
+        w.field("job_name", ds.job_name);
+        w.field("file_sequence", ds.file_sequence);
+        w.field("generation", ds.generation);
+        w.field("version", ds.version);
+        w.field("record_format", ds.record_format);
+        w.field("block_size", ds.block_size);
+        w.field("record_length", ds.record_length);
+        w.field("creation_date", format_time(ds.creation_date));
+        w.field("expiration_date", format_time(ds.expiration_date));
+        w.field("last_accessed", format_time(ds.last_accessed));
+        w.field("notes", ds.notes);
+        w.key("tags").begin_array();
+        for (const auto& tag : ds.tags) w.value(tag);
+        w.end_array();
+        w.end_object();
+    }
+    
+    /**
+     * @brief Stream a catalog document with the same layout as catalog_to_json
+     *
+     * Accepts any ranges yielding TapeVolume and Dataset, e.g. the values of
+     * the TMSSystem catalog maps, so nothing is copied or materialised.
+     */
+    template<typename VolumeRange, typename DatasetRange>
+    static void write_catalog(JsonWriter& w, const VolumeRange& volumes,
+                              const DatasetRange& datasets) {
+        w.begin_object();
+        w.field("version", "3.3.0");
+        w.field("generated", get_timestamp());
+        w.key("volumes").begin_array();
+        for (const TapeVolume& vol : volumes) write_volume(w, vol);
+        w.end_array();
+        w.key("datasets").begin_array();
+        for (const Dataset& ds : datasets) write_dataset(w, ds);
+        w.end_array();
+        w.end_object();
+    }
+    
+    /**
+     * @brief Read one volume object from the reader
+     */
+    static TapeVolume read_volume(JsonReader& r) {
+        TapeVolume vol;
+        expect(r, JsonToken::BeginObject, "volume object");
+        while (r.next() == JsonToken::Key) {
+            std::string_view k = r.string_value();
+            if (k == "volser") vol.volser = read_string(r);
+            else if (k == "status") vol.status = string_to_volume_status(read_string(r));
+            else if (k == "density") vol.density = string_to_density(read_string(r));
+            else if (k == "location") vol.location = read_string(r);
+            else if (k == "pool") vol.pool = read_string(r);
+            else if (k == "owner") vol.owner = read_string(r);
+            else if (k == "mount_count") vol.mount_count = read_int32(r);
+            else if (k == "write_protected") vol.write_protected = read_bool(r);
+            else if (k == "capacity_bytes") vol.capacity_bytes = read_uint(r);
+            else if (k == "used_bytes") vol.used_bytes = read_uint(r);
+            else if (k == "error_count") vol.error_count = read_int32(r);
+            else if (k == "creation_date") vol.creation_date = parse_time(read_string(r));
+            else if (k == "expiration_date") vol.expiration_date = parse_time(read_string(r));
+            else if (k == "last_used") vol.last_used = parse_time(read_string(r));
+            else if (k == "notes") vol.notes = read_string(r);
+            else if (k == "reserved_by") vol.reserved_by = read_string(r);
+            else if (k == "tags") {
+                read_string_array(r, [&vol](std::string_view t) { vol.tags.emplace(t); });
+            } else if (k == "datasets") {
+                read_string_array(r, [&vol](std::string_view d) { vol.datasets.emplace_back(d); });
+            } else {
+                r.skip_value();
+            }
+        }
+        if (r.token() != JsonToken::EndObject) {
+            throw std::runtime_error("Expected '}' after volume members");
+        }
+        return vol;
+    }
+    
+    /**
+     * @brief Read one dataset object from the reader
+     */
+    static Dataset read_dataset(JsonReader& r) {
+        Dataset ds;
+        expect(r, JsonToken::BeginObject, "dataset object");
+        while (r.next() == JsonToken::Key) {
+            std::string_view k = r.string_value();
+            if (k == "name") ds.name = read_string(r);
+            else if (k == "volser") ds.volser = read_string(r);
+            else if (k == "status") ds.status = string_to_dataset_status(read_string(r));
+            else if (k == "size_bytes") ds.size_bytes = static_cast<size_t>(read_uint(r));
+            else if (k == "owner") ds.owner = read_string(r);
+            else if (k == "job_name") ds.job_name = read_string(r);
+            else if (k == "file_sequence") ds.file_sequence = read_int32(r);
+            else if (k == "generation") ds.generation = read_int32(r);
+            else if (k == "version") ds.version = read_int32(r);
+            else if (k == "record_format") ds.record_format = read_string(r);
+            else if (k == "block_size") ds.block_size = static_cast<size_t>(read_uint(r));
+            else if (k == "record_length") ds.record_length = static_cast<size_t>(read_uint(r));
+            else if (k == "creation_date") ds.creation_date = parse_time(read_string(r));
+            else if (k == "expiration_date") ds.expiration_date = parse_time(read_string(r));
+            else if (k == "last_accessed") ds.last_accessed = parse_time(read_string(r));
+            else if (k == "notes") ds.notes = read_string(r);
+            else if (k == "tags") {
+                read_string_array(r, [&ds](std::string_view t) { ds.tags.emplace(t); });
+            } else {
+                r.skip_value();
+            }
+        }
+        if (r.token() != JsonToken::EndObject) {
+            throw std::runtime_error("Expected '}' after dataset members");
+        }
+        return ds;
+    }
+    
+    /**
+     * @brief Stream a catalog document, handing each record to a callback
+     *
+     * Memory use is bounded by one record regardless of catalog size.
+     */
+    static void read_catalog(JsonReader& r,
+                             const std::function<void(TapeVolume&&)>& on_volume,
+                             const std::function<void(Dataset&&)>& on_dataset) {
+        expect(r, JsonToken::BeginObject, "catalog object");
+        while (r.next() == JsonToken::Key) {
+            std::string_view k = r.string_value();
+            if (k == "volumes") {
+                expect(r, JsonToken::BeginArray, "volumes array");
+                while (!at_array_end(r)) {
+                    TapeVolume vol = read_volume(r);
+                    if (on_volume) on_volume(std::move(vol));
+                }
+            } else if (k == "datasets") {
+                expect(r, JsonToken::BeginArray, "datasets array");
+                while (!at_array_end(r)) {
+                    Dataset ds = read_dataset(r);
+                    if (on_dataset) on_dataset(std::move(ds));
+                }
+            } else {
+                r.skip_value();
+            }
+        }
+    }
+    
+private:
+    static void expect(JsonReader& r, JsonToken t, const char* what) {
+        if (r.next() != t) {
+            throw std::runtime_error(std::string("Expected ") + what);
+        }
+    }
+    
+    // Consumes ']' when the array is finished, otherwise leaves the next
+    // element pending in the reader's one-token lookahead
+    static bool at_array_end(JsonReader& r) {
+        if (r.peek() != JsonToken::EndArray) return false;
+        r.next();
+        return true;
+    }
+    
+    static std::string read_string(JsonReader& r) {
+        JsonToken t = r.next();
+        if (t == JsonToken::Null) return std::string();
+        if (t != JsonToken::String) throw std::runtime_error("Expected string value");
+        return std::string(r.string_value());
+    }
+    
+    static int64_t read_int(JsonReader& r) {
+        if (r.next() != JsonToken::Number) throw std::runtime_error("Expected number value");
+        return r.int_value();
+    }
+    
+    static int read_int32(JsonReader& r) {
+        int64_t n = read_int(r);
+        if (n < std::numeric_limits<int>::min() || n > std::numeric_limits<int>::max()) {
+            throw std::runtime_error("Integer out of range: " + std::to_string(n));
+        }
+        return static_cast<int>(n);
+    }
+    
+    static uint64_t read_uint(JsonReader& r) {
+        if (r.next() != JsonToken::Number) throw std::runtime_error("Expected number value");
+        return r.uint_value();
+    }
+    
+    static bool read_bool(JsonReader& r) {
+        if (r.next() != JsonToken::Boolean) throw std::runtime_error("Expected boolean value");
+        return r.bool_value();
+    }
+    
+    template<typename Fn>
+    static void read_string_array(JsonReader& r, Fn&& fn) {
+        expect(r, JsonToken::BeginArray, "string array");
+        while (r.next() == JsonToken::String) {
+            fn(r.string_value());
+        }
+        if (r.token() != JsonToken::EndArray) {
+            throw std::runtime_error("Expected string array element");
+        }
+    }
+};
+
+// ============================================================================
+// Implementation
+// ============================================================================
+
+inline void JsonValue::init_string(std::string_view s, std::pmr::memory_resource* arena) {
+    type_ = Type::String;
+    if (s.size() <= SMALL_STRING_CAPACITY) {
+        std::memcpy(u_.small, s.data(), s.size());
+        small_size_ = static_cast<uint8_t>(s.size());
+        return;
+    }
+    char* data = arena ? static_cast<char*>(arena->allocate(s.size(), 1)) : new char[s.size()];
+    std::memcpy(data, s.data(), s.size());
+    u_.str = {data, s.size()};
+    flags_ = static_cast<uint8_t>(FLAG_LONG_STRING | (arena ? FLAG_ARENA : 0));
+}
+
+inline void JsonValue::release() noexcept {
+    bool arena = in_arena();
+    switch (type_) {
+        case Type::String:
+            if ((flags_ & FLAG_LONG_STRING) && !arena) delete[] u_.str.data;
+            break;
+        case Type::Array:
+            // Arena nodes still run their destructor so heap-owned children
+            // moved into them are freed; only the node storage is skipped
+            if (arena) u_.array->~JsonArray();
+            else delete u_.array;
+            break;
+        case Type::Object:
+            if (arena) u_.object->~JsonObject();
+            else delete u_.object;
+            break;
+        default:
+            break;
+    }
+    type_ = Type::Null;
+    flags_ = 0;
+}
+
+inline JsonValue::JsonValue(const JsonArray& arr) : type_(Type::Array) {
+    u_.array = new JsonArray(arr, std::pmr::new_delete_resource());
+}
+
+inline JsonValue::JsonValue(JsonArray&& arr) : type_(Type::Array) {
+    u_.array = new JsonArray(std::move(arr));
+}
+
+inline JsonValue::JsonValue(const JsonObject& obj) : type_(Type::Object) {
+    u_.object = new JsonObject(obj, std::pmr::new_delete_resource());
+}
+
+inline JsonValue::JsonValue(JsonObject&& obj) : type_(Type::Object) {
+    u_.object = new JsonObject(std::move(obj));
+}
+
+inline JsonValue::JsonValue(const JsonValue& other) {
+    switch (other.type_) {
+        case Type::String:
+            init_string(other.as_string(), nullptr);
+            break;
+        case Type::Array:
+            type_ = Type::Array;
+            u_.array = new JsonArray(*other.u_.array, std::pmr::new_delete_resource());
+            break;
+        case Type::Object:
+            type_ = Type::Object;
+            u_.object = new JsonObject(*other.u_.object, std::pmr::new_delete_resource());
+            break;
+        default:
+            type_ = other.type_;
+            u_ = other.u_;
+            break;
+    }
+}
+
+inline JsonValue& JsonValue::operator=(const JsonValue& other) {
+    if (this != &other) {
+        JsonValue copy(other);
+        release();
+        steal(copy);
+    }
+    return *this;
+}
+
+inline JsonValue& JsonValue::operator=(JsonValue&& other) noexcept {
+    if (this != &other) {
+        release();
+        steal(other);
+    }
+    return *this;
+}
+
+inline JsonValue JsonValue::make_array(std::pmr::memory_resource* arena) {
+    JsonValue v;
+    v.type_ = Type::Array;
+    if (arena) {
+        v.u_.array = new (arena->allocate(sizeof(JsonArray), alignof(JsonArray))) JsonArray(arena);
+        v.flags_ = FLAG_ARENA;
+    } else {
+        v.u_.array = new JsonArray(std::pmr::new_delete_resource());
+    }
+    return v;
+}
+
+inline JsonValue JsonValue::make_object(std::pmr::memory_resource* arena) {
+    JsonValue v;
+    v.type_ = Type::Object;
+    if (arena) {
+        v.u_.object = new (arena->allocate(sizeof(JsonObject), alignof(JsonObject))) JsonObject(arena);
+        v.flags_ = FLAG_ARENA;
+    } else {
+        v.u_.object = new JsonObject(std::pmr::new_delete_resource());
+    }
+    return v;
+}
+
+inline std::string_view JsonValue::as_string() const {
+    if (type_ != Type::String) return {};
+    if (flags_ & FLAG_LONG_STRING) return std::string_view(u_.str.data, u_.str.size);
+    return std::string_view(u_.small, small_size_);
+}
+
+inline const JsonArray& JsonValue::as_array() const {
+    static const JsonArray empty;
+    return type_ == Type::Array ? *u_.array : empty;
+}
+
+inline const JsonObject& JsonValue::as_object() const {
+    static const JsonObject empty;
+    return type_ == Type::Object ? *u_.object : empty;
+}
+
+inline JsonArray& JsonValue::as_array() {
+    if (type_ == Type::Null) *this = make_array();
+    if (type_ != Type::Array) throw std::runtime_error("JSON value is not an array");
+    return *u_.array;
+}
+
+inline JsonObject& JsonValue::as_object() {
+    if (type_ == Type::Null) *this = make_object();
+    if (type_ != Type::Object) throw std::runtime_error("JSON value is not an object");
+    return *u_.object;
+}
+
+inline JsonValue& JsonValue::operator[](std::string_view key) {
+    return as_object()[key];
+}
+
+inline const JsonValue& JsonValue::operator[](std::string_view key) const {
+    static const JsonValue null_val;
+    if (type_ != Type::Object) return null_val;
+    auto it = u_.object->find(key);
+    return it != u_.object->end() ? it->second : null_val;
+}
+
+inline size_t JsonValue::size() const {
+    if (type_ == Type::Array) return u_.array->size();
+    if (type_ == Type::Object) return u_.object->size();
+    return 0;
+}
+
+inline bool JsonValue::contains(std::string_view key) const {
+    return type_ == Type::Object && u_.object->contains(key);
+}
+
+inline void JsonObject::sort_members() {
+    std::stable_sort(members_.begin(), members_.end(),
+        [](const value_type& a, const value_type& b) { return a.first < b.first; });
+    // Keep the last occurrence of a duplicated key, matching map assignment
+    auto out = members_.begin();
+    for (auto it = members_.begin(); it != members_.end(); ++it) {
+        auto next = it + 1;
+        if (next != members_.end() && next->first == it->first) continue;
+        if (out != it) *out = std::move(*it);
+        ++out;
+    }
+    members_.erase(out, members_.end());
+}
+
+inline void* JsonArena::do_allocate(size_t bytes, size_t alignment) {
+    size_t pad = cur_ ? (alignment - reinterpret_cast<uintptr_t>(cur_) % alignment) % alignment : 0;
+    if (!cur_ || bytes + pad > remaining_) {
+        size_t size = std::max(block_size_, bytes + alignment);
+        void* data = ::operator new(size, std::align_val_t(alignof(std::max_align_t)));
+        blocks_.push_back({data, size});
+        cur_ = static_cast<char*>(data);
+        remaining_ = size;
+        reserved_ += size;
+        pad = (alignment - reinterpret_cast<uintptr_t>(cur_) % alignment) % alignment;
+    }
+    char* p = cur_ + pad;
+    cur_ = p + bytes;
+    remaining_ -= bytes + pad;
+    used_ += bytes;
+    return p;
+}
+
+inline void JsonDocument::parse(std::string_view json) {
+    root_ = JsonValue();
+    JsonReader reader(json);
+    root_ = JsonSerializer::build_value(reader, reader.next(), &arena_);
+}
+
+inline void JsonDocument::parse(std::istream& in) {
+    root_ = JsonValue();
+    JsonReader reader(in);
+    root_ = JsonSerializer::build_value(reader, reader.next(), &arena_);
+}
+
+inline JsonValue JsonSerializer::parse(std::string_view json) {
+    JsonReader reader(json);
+    return build_value(reader, reader.next());
+}
+
+inline JsonValue JsonSerializer::parse_file(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open file: " + path);
+    }
+    JsonReader reader(file);
+    return build_value(reader, reader.next());
+}
+
+/**
+ * @brief Tree construction state shared across one parse
+ *
+ * Children are staged on reusable scratch stacks and moved into a container
+ * reserved to its exact size when the container closes, so arena documents
+ * hold no vector growth slack.
+ */
+struct JsonSerializer::TreeBuilder {
+    JsonReader& reader;
+    std::pmr::memory_resource* arena;
+    std::vector<JsonValue> values;
+    std::vector<std::string> keys;
+    
+    JsonValue build(JsonToken token) {
+        switch (token) {
+            case JsonToken::EndOfInput:
+            case JsonToken::Null:
+                return JsonValue();
+            case JsonToken::Boolean:
+                return JsonValue(reader.bool_value());
+            case JsonToken::Number:
+                return JsonValue(reader.number_value());
+            case JsonToken::String:
+                return JsonValue(reader.string_value(), arena);
+            case JsonToken::BeginArray: {
+                size_t base = values.size();
+                for (JsonToken t = reader.next(); t != JsonToken::EndArray; t = reader.next()) {
+                    JsonValue item = build(t);
+                    values.push_back(std::move(item));
+                }
+                JsonValue v = JsonValue::make_array(arena);
+                JsonArray& arr = v.as_array();
+                arr.reserve(values.size() - base);
+                for (size_t i = base; i < values.size(); i++) {
+                    arr.push_back(std::move(values[i]));
+                }
+                values.resize(base);
+                return v;
+            }
+            case JsonToken::BeginObject: {
+                size_t base = values.size();
+                size_t key_base = keys.size();
+                while (reader.next() == JsonToken::Key) {
+                    // The key view is only valid until the value is read
+                    keys.emplace_back(reader.string_value());
+                    JsonValue member = build(reader.next());
+                    values.push_back(std::move(member));
+                }
+                JsonValue v = JsonValue::make_object(arena);
+                JsonObject& obj = v.as_object();
+                obj.reserve(values.size() - base);
+                for (size_t i = 0; i < values.size() - base; i++) {
+                    obj.append_unsorted(keys[key_base + i], std::move(values[base + i]));
+                }
+                obj.sort_members();
+                values.resize(base);
+                keys.resize(key_base);
+                return v;
+            }
+            default:
+                throw std::runtime_error("Unexpected JSON token");
+        }
     }
 };
 
+inline JsonValue JsonSerializer::build_value(JsonReader& reader, JsonToken token,
+                                             std::pmr::memory_resource* arena) {
+    TreeBuilder builder{reader, arena, {}, {}};
+    return builder.build(token);
+}
+
+inline JsonWriter& JsonWriter::value(double d) {
+    before_value();
+    if (!std::isfinite(d)) {
+        raw("null");
+        return *this;
+    }
+    char tmp[32];
+    std::to_chars_result res;
+    if (std::abs(d) < 9.0e15 && d == static_cast<double>(static_cast<int64_t>(d))) {
+        res = std::to_chars(tmp, tmp + sizeof(tmp), static_cast<int64_t>(d));
+    } else {
+        res = std::to_chars(tmp, tmp + sizeof(tmp), d);
+    }
+    raw(std::string_view(tmp, static_cast<size_t>(res.ptr - tmp)));
+    return *this;
+}
+
+inline JsonWriter& JsonWriter::value(const JsonValue& v) {
+    switch (v.type()) {
+        case JsonValue::Type::Null: return null_value();
+        case JsonValue::Type::Boolean: return value(v.as_bool());
+        case JsonValue::Type::Number: return value(v.as_number());
+        case JsonValue::Type::String: return value(std::string_view(v.as_string()));
+        case JsonValue::Type::Array:
+            begin_array();
+            for (const auto& item : v.as_array()) value(item);
+            return end_array();
+        case JsonValue::Type::Object:
+            begin_object();
+            for (const auto& [k, item] : v.as_object()) {
+                key(k);
+                value(item);
+            }
+            return end_object();
+    }
+    return *this;
+}
+
+inline void JsonWriter::write_string(std::string_view s) {
+    static const char* hex = "0123456789abcdef";
+    put('"');
+    size_t run = 0;
+    for (size_t i = 0; i < s.size(); i++) {
+        unsigned char c = static_cast<unsigned char>(s[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') continue;
+        raw(s.substr(run, i - run));
+        run = i + 1;
+        switch (c) {
+            case '"': raw("\\\""); break;
+            case '\\': raw("\\\\"); break;
+            case '\b': raw("\\b"); break;
+            case '\f': raw("\\f"); break;
+            case '\n': raw("\\n"); break;
+            case '\r': raw("\\r"); break;
+            case '\t': raw("\\t"); break;
+            default: {
+                char esc[6] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 0x0F]};
+                raw(std::string_view(esc, sizeof(esc)));
+            }
+        }
+    }
+    raw(s.substr(run));
+    put('"');
+}
+
+inline bool JsonReader::refill() {
+    if (!in_) return false;
+    // Keep everything from the start of the current token onwards
+    if (pos_ > 0) {
+        buffer_.erase(0, pos_);
+        consumed_ += pos_;
+        pos_ = 0;
+    }
+    size_t old_size = buffer_.size();
+    buffer_.resize(old_size + chunk_size_);
+    in_->read(buffer_.data() + old_size, static_cast<std::streamsize>(chunk_size_));
+    size_t got = static_cast<size_t>(in_->gcount());
+    buffer_.resize(old_size + got);
+    data_ = buffer_;
+    if (got == 0) {
+        in_ = nullptr;
+        return false;
+    }
+    return true;
+}
+
+inline bool JsonReader::ensure(size_t n) {
+    while (data_.size() - pos_ < n) {
+        if (!refill()) return false;
+    }
+    return true;
+}
+
+inline void JsonReader::skip_whitespace() {
+    while (true) {
+        while (pos_ < data_.size()) {
+            char c = data_[pos_];
+            if (c != ' ' && c != '\n' && c != '\r' && c != '\t') return;
+            pos_++;
+        }
+        if (!refill()) return;
+    }
+}
+
+inline JsonToken JsonReader::next() {
+    if (peeked_) {
+        peeked_ = false;
+        return token_;
+    }
+    
+    skip_whitespace();
+    
+    if (expect_value_) {
+        expect_value_ = false;
+        if (pos_ >= data_.size()) fail("unexpected end of input, expected value");
+        return token_ = read_value();
+    }
+    
+    if (pos_ >= data_.size()) {
+        if (!stack_.empty()) fail("unexpected end of input");
+        return token_ = JsonToken::EndOfInput;
+    }
+    
+    if (stack_.empty()) {
+        return token_ = read_value();
+    }
+    
+    Frame& frame = stack_.back();
+    char c = data_[pos_];
+    
+    if (c == (frame.is_object ? '}' : ']')) {
+        pos_++;
+        bool is_object = frame.is_object;
+        stack_.pop_back();
+        return token_ = is_object ? JsonToken::EndObject : JsonToken::EndArray;
+    }
+    
+    if (frame.need_comma) {
+        if (c != ',') fail(frame.is_object ? "expected ',' or '}'" : "expected ',' or ']'");
+        pos_++;
+        skip_whitespace();
+        if (pos_ >= data_.size()) fail("unexpected end of input");
+        c = data_[pos_];
+    }
+    frame.need_comma = true;
+    
+    if (frame.is_object) {
+        if (c != '"') fail("expected string key");
+        read_string();
+        // The key view may point into the window, so copy it aside before
+        // any refill needed to reach the ':' separator
+        while (pos_ < data_.size() && std::isspace(static_cast<unsigned char>(data_[pos_]))) pos_++;
+        if (pos_ >= data_.size() && in_) {
+            scratch_.assign(str_.data(), str_.size());
+            str_ = scratch_;
+            skip_whitespace();
+        }
+        if (pos_ >= data_.size() || data_[pos_] != ':') fail("expected ':'");
+        pos_++;
+        expect_value_ = true;
+        return token_ = JsonToken::Key;
+    }
+    
+    return token_ = read_value();
+}
+
+inline JsonToken JsonReader::read_value() {
+    char c = data_[pos_];
+    switch (c) {
+        case '{':
+            pos_++;
+            stack_.push_back({true, false});
+            return JsonToken::BeginObject;
+        case '[':
+            pos_++;
+            stack_.push_back({false, false});
+            return JsonToken::BeginArray;
+        case '"':
+            read_string();
+            return JsonToken::String;
+        case 't':
+            read_literal("true");
+            bool_ = true;
+            return JsonToken::Boolean;
+        case 'f':
+            read_literal("false");
+            bool_ = false;
+            return JsonToken::Boolean;
+        case 'n':
+            read_literal("null");
+            return JsonToken::Null;
+        default:
+            if (c == '-' || (c >= '0' && c <= '9')) {
+                read_number();
+                return JsonToken::Number;
+            }
+            fail(std::string("unexpected character '") + c + "'");
+    }
+}
+
+inline void JsonReader::read_literal(std::string_view word) {
+    if (!ensure(word.size()) || data_.substr(pos_, word.size()) != word) {
+        fail("expected '" + std::string(word) + "'");
+    }
+    pos_ += word.size();
+}
+
+inline void JsonReader::read_number() {
+    size_t len = 0;
+    while (true) {
+        while (pos_ + len < data_.size()) {
+            char c = data_[pos_ + len];
+            if ((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E') {
+                len++;
+            } else {
+                str_ = data_.substr(pos_, len);
+                pos_ += len;
+                return;
+            }
+        }
+        if (!refill()) break;
+    }
+    str_ = data_.substr(pos_, len);
+    pos_ += len;
+}
+
+inline void JsonReader::read_string() {
+    // pos_ stays on the opening quote until the whole string is in the window
+    size_t i = pos_ + 1;
+    bool escaped = false;
+    while (true) {
+        while (i < data_.size() && data_[i] != '"') {
+            if (data_[i] == '\\') {
+                escaped = true;
+                i += 2;
+            } else {
+                i++;
+            }
+        }
+        if (i < data_.size()) break;
+        size_t offset = i - pos_;
+        if (!refill()) fail("unterminated string");
+        i = pos_ + offset;
+    }
+    
+    std::string_view body = data_.substr(pos_ + 1, i - pos_ - 1);
+    pos_ = i + 1;
+    
+    if (!escaped) {
+        str_ = body;
+        return;
+    }
+    
+    scratch_.clear();
+    scratch_.reserve(body.size());
+    for (size_t j = 0; j < body.size(); j++) {
+        char c = body[j];
+        if (c != '\\') {
+            scratch_ += c;
+            continue;
+        }
+        if (++j >= body.size()) fail("invalid escape");
+        switch (body[j]) {
+            case '"': scratch_ += '"'; break;
+            case '\\': scratch_ += '\\'; break;
+            case '/': scratch_ += '/'; break;
+            case 'b': scratch_ += '\b'; break;
+            case 'f': scratch_ += '\f'; break;
+            case 'n': scratch_ += '\n'; break;
+            case 'r': scratch_ += '\r'; break;
+            case 't': scratch_ += '\t'; break;
+            case 'u': {
+                auto hex4 = [&](size_t at) {
+                    unsigned v = 0;
+                    if (at + 4 > body.size() ||
+                        std::from_chars(body.data() + at, body.data() + at + 4, v, 16).ptr !=
+                            body.data() + at + 4) {
+                        fail("invalid \\u escape");
+                    }
+                    return v;
+                };
+                unsigned cp = hex4(j + 1);
+                j += 4;
+                if (cp >= 0xD800 && cp <= 0xDBFF && j + 6 < body.size() &&
+                    body.substr(j + 1, 2) == "\\u") {
+                    unsigned lo = hex4(j + 3);
+                    if (lo >= 0xDC00 && lo <= 0xDFFF) {
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+                        j += 6;
+                    }
+                }
+                // Encode as UTF-8
+                if (cp < 0x80) {
+                    scratch_ += static_cast<char>(cp);
+                } else if (cp < 0x800) {
+                    scratch_ += static_cast<char>(0xC0 | (cp >> 6));
+                    scratch_ += static_cast<char>(0x80 | (cp & 0x3F));
+                } else if (cp < 0x10000) {
+                    scratch_ += static_cast<char>(0xE0 | (cp >> 12));
+                    scratch_ += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                    scratch_ += static_cast<char>(0x80 | (cp & 0x3F));
+                } else {
+                    scratch_ += static_cast<char>(0xF0 | (cp >> 18));
+                    scratch_ += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+                    scratch_ += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                    scratch_ += static_cast<char>(0x80 | (cp & 0x3F));
+                }
+                break;
+            }
+            default: fail("invalid escape");
+        }
+    }
+    str_ = scratch_;
+}
+
+inline void JsonReader::skip_value() {
+    JsonToken t = next();
+    if (t != JsonToken::BeginObject && t != JsonToken::BeginArray) return;
+    size_t target = stack_.size() - 1;
+    while (stack_.size() > target) {
+        if (next() == JsonToken::EndOfInput) fail("unexpected end of input");
+    }
+}
+
+inline double JsonReader::number_value() const {
+    double d = 0.0;
+    auto res = std::from_chars(str_.data(), str_.data() + str_.size(), d);
+    if (res.ec != std::errc() || res.ptr != str_.data() + str_.size()) {
+        throw std::runtime_error("Invalid number: " + std::string(str_));
+    }
+    return d;
+}
+
+// Exponent or fraction forms ("1e3", "2.0") are accepted only when they
+// name an integer the type can hold; anything else would be UB to cast
+inline int64_t JsonReader::int_value() const {
+    int64_t n = 0;
+    auto res = std::from_chars(str_.data(), str_.data() + str_.size(), n);
+    if (res.ec == std::errc() && res.ptr == str_.data() + str_.size()) return n;
+    double d = number_value();
+    if (!(d >= -0x1p63 && d < 0x1p63) || d != std::trunc(d)) {
+        throw std::runtime_error("Integer out of range: " + std::string(str_));
+    }
+    return static_cast<int64_t>(d);
+}
+
+inline uint64_t JsonReader::uint_value() const {
+    uint64_t n = 0;
+    auto res = std::from_chars(str_.data(), str_.data() + str_.size(), n);
+    if (res.ec == std::errc() && res.ptr == str_.data() + str_.size()) return n;
+    double d = number_value();
+    if (!(d >= 0.0 && d < 0x1p64) || d != std::trunc(d)) {
+        throw std::runtime_error("Unsigned integer out of range: " + std::string(str_));
+    }
+    return static_cast<uint64_t>(d);
+}
+
 } // namespace tms
 
 #endif // TMS_JSON_H
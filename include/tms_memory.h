@@ -0,0 +1,222 @@
+/**
+ * @file tms_memory.h
+ * @brief TMS Tape Management System - Memory Arenas
+ * @version 3.4.0
+ * @author Bennie Shearer
+ * @copyright Copyright (c) 2025 Bennie Shearer
+ * @license MIT License
+ *
+ * The catalog maps allocate one node per record and the load, query and
+ * integrity pipelines build millions of short-lived strings, views and
+ * index nodes. CatalogArena pools the catalog's map nodes so inserts and
+ * erases stop going to the global heap one node at a time, and a
+ * ScratchArena gives a pipeline a monotonic buffer that is released in one
+ * step when the pipeline finishes. Both count the requests they serve and
+ * the blocks they take from the heap, so reductions can be confirmed with
+ * get_arena_stats().
+ */
+
+#ifndef TMS_MEMORY_H
+#define TMS_MEMORY_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+namespace tms {
+
+// ============================================================================
+// Allocation Counters
+// ============================================================================
+
+/**
+ * @brief Allocation counts for one arena or one kind of arena
+ *
+ * allocations/bytes are requests served by the arena; the upstream
+ * counters are blocks taken from the global heap to serve them.
+ */
+struct ArenaStats {
+    std::string name;
+    uint64_t arenas = 0;                ///< Arenas opened (transient pipelines)
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+    uint64_t upstream_allocations = 0;
+    uint64_t upstream_bytes = 0;
+    uint64_t bytes_in_use = 0;          ///< Heap bytes held now (catalog arenas)
+};
+
+/**
+ * @brief memory_resource that counts what passes through to @p upstream
+ */
+class CountingResource final : public std::pmr::memory_resource {
+public:
+    explicit CountingResource(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : upstream_(upstream) {}
+    
+    uint64_t allocations() const { return allocations_.load(std::memory_order_relaxed); }
+    uint64_t bytes() const { return bytes_.load(std::memory_order_relaxed); }
+    uint64_t bytes_in_use() const { return in_use_.load(std::memory_order_relaxed); }
+    
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        void* p = upstream_->allocate(bytes, alignment);
+        allocations_.fetch_add(1, std::memory_order_relaxed);
+        bytes_.fetch_add(bytes, std::memory_order_relaxed);
+        in_use_.fetch_add(bytes, std::memory_order_relaxed);
+        return p;
+    }
+    
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        upstream_->deallocate(p, bytes, alignment);
+        in_use_.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+    
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+    
+    std::pmr::memory_resource* upstream_;
+    std::atomic<uint64_t> allocations_{0};
+    std::atomic<uint64_t> bytes_{0};
+    std::atomic<uint64_t> in_use_{0};
+};
+
+// ============================================================================
+// Scratch Arenas
+// ============================================================================
+
+enum class ArenaKind {
+    LOAD,           ///< Catalog load parse buffers
+    QUERY,          ///< Query evaluation state
+    INTEGRITY,      ///< Integrity check indexes
+    COUNT
+};
+
+inline const char* arena_kind_to_string(ArenaKind kind) {
+    switch (kind) {
+        case ArenaKind::LOAD: return "load";
+        case ArenaKind::QUERY: return "query";
+        case ArenaKind::INTEGRITY: return "integrity";
+        default: return "unknown";
+    }
+}
+
+namespace detail {
+
+struct ArenaTotals {
+    std::atomic<uint64_t> arenas{0};
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> bytes{0};
+    std::atomic<uint64_t> upstream_allocations{0};
+    std::atomic<uint64_t> upstream_bytes{0};
+};
+
+inline ArenaTotals& arena_totals(ArenaKind kind) {
+    static std::array<ArenaTotals, static_cast<size_t>(ArenaKind::COUNT)> totals;
+    return totals[static_cast<size_t>(kind)];
+}
+
+}
+
+/**
+ * @brief Monotonic arena for one run of a pipeline
+ *
+ * The first @c INLINE_BYTES come from the arena object itself, so small
+ * runs never touch the heap; later blocks grow geometrically and are all
+ * freed when the arena is destroyed. Not thread-safe. Counts are added to
+ * the process-wide totals for its kind on destruction.
+ */
+class ScratchArena {
+public:
+    static constexpr size_t INLINE_BYTES = 2048;
+    
+    explicit ScratchArena(ArenaKind kind)
+        : kind_(kind), buffer_(inline_, sizeof(inline_), &upstream_), counted_(&buffer_) {}
+    
+    ~ScratchArena() {
+        auto& totals = detail::arena_totals(kind_);
+        totals.arenas.fetch_add(1, std::memory_order_relaxed);
+        totals.allocations.fetch_add(counted_.allocations(), std::memory_order_relaxed);
+        totals.bytes.fetch_add(counted_.bytes(), std::memory_order_relaxed);
+        totals.upstream_allocations.fetch_add(upstream_.allocations(), std::memory_order_relaxed);
+        totals.upstream_bytes.fetch_add(upstream_.bytes(), std::memory_order_relaxed);
+    }
+    
+    ScratchArena(const ScratchArena&) = delete;
+    ScratchArena& operator=(const ScratchArena&) = delete;
+    
+    std::pmr::memory_resource* resource() { return &counted_; }
+    
+private:
+    ArenaKind kind_;
+    alignas(std::max_align_t) std::byte inline_[INLINE_BYTES];
+    CountingResource upstream_;
+    std::pmr::monotonic_buffer_resource buffer_;
+    CountingResource counted_;
+};
+
+// ============================================================================
+// Catalog Arena
+// ============================================================================
+
+/**
+ * @brief Pooled node storage for a catalog's record maps
+ *
+ * Freed nodes are reused by later inserts and the pool's blocks are
+ * returned to the heap together when the catalog is destroyed. Not
+ * thread-safe; TMSSystem only allocates from it under its exclusive lock.
+ */
+class CatalogArena {
+public:
+    CatalogArena() : pool_(&upstream_), counted_(&pool_) {}
+    
+    CatalogArena(const CatalogArena&) = delete;
+    CatalogArena& operator=(const CatalogArena&) = delete;
+    
+    std::pmr::memory_resource* resource() { return &counted_; }
+    
+    ArenaStats stats() const {
+        ArenaStats s;
+        s.name = "catalog";
+        s.arenas = 1;
+        s.allocations = counted_.allocations();
+        s.bytes = counted_.bytes();
+        s.upstream_allocations = upstream_.allocations();
+        s.upstream_bytes = upstream_.bytes();
+        s.bytes_in_use = upstream_.bytes_in_use();
+        return s;
+    }
+    
+private:
+    CountingResource upstream_;
+    std::pmr::unsynchronized_pool_resource pool_;
+    CountingResource counted_;
+};
+
+/**
+ * @brief Process-wide totals for the scratch arenas of every pipeline
+ */
+inline std::vector<ArenaStats> get_scratch_arena_stats() {
+    std::vector<ArenaStats> out;
+    for (size_t i = 0; i < static_cast<size_t>(ArenaKind::COUNT); i++) {
+        auto kind = static_cast<ArenaKind>(i);
+        const auto& totals = detail::arena_totals(kind);
+        ArenaStats s;
+        s.name = arena_kind_to_string(kind);
+        s.arenas = totals.arenas.load(std::memory_order_relaxed);
+        s.allocations = totals.allocations.load(std::memory_order_relaxed);
+        s.bytes = totals.bytes.load(std::memory_order_relaxed);
+        s.upstream_allocations = totals.upstream_allocations.load(std::memory_order_relaxed);
+        s.upstream_bytes = totals.upstream_bytes.load(std::memory_order_relaxed);
+        out.push_back(std::move(s));
+    }
+    return out;
+}
+
+} // namespace tms
+
+#endif // TMS_MEMORY_H
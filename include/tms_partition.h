@@ -0,0 +1,714 @@
+/**
+ * @file tms_partition.h
+ * @brief TMS Tape Management System - Range-Partitioned Catalog
+ * @version 3.4.0
+ * @author Bennie Shearer
+ * @copyright Copyright (c) 2025 Bennie Shearer
+ * @license MIT License
+ *
+ * Spreads one logical catalog over several TMS daemons, each owning a
+ * range of volsers and the datasets on those volumes. PartitionMap names
+ * the ranges. PartitionRouter sends each volume operation to the daemon
+ * that owns the volser. A dataset is added on its volume's daemon; other
+ * dataset operations go to every daemon and the one holding the dataset
+ * answers. List, search and query calls go to every daemon at once, and
+ * the router merges the sorted replies and keeps the first results, so
+ * each daemon returns only its own top K. Statistics are summed. Attached
+ * to an RpcServer, the router serves the ordinary RPC protocol, so
+ * existing clients can use a partitioned catalog unchanged. Each routed
+ * request carries the caller's user, session and remaining time, so the
+ * partitions audit and time it as if the caller had sent it. The router
+ * remembers which partition last held each dataset name and asks that
+ * one first. Partitions are ordinary daemons; the router, not the
+ * daemons, keeps records in their ranges. Linux-only, like the RPC server.
+ */
+
+#ifndef TMS_PARTITION_H
+#define TMS_PARTITION_H
+
+#include "tms_rpc.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <optional>
+#include <unordered_map>
+
+namespace tms {
+
+// ============================================================================
+// Partition Map
+// ============================================================================
+
+/**
+ * @brief One partition: volsers from @c lower up to the next partition's
+ */
+struct Partition {
+    std::string lower;          ///< First volser owned; empty for the first partition
+    std::string socket_path;    ///< The owning daemon's Unix socket
+};
+
+/**
+ * @brief Volser ranges and the daemons that own them
+ */
+class PartitionMap {
+public:
+    /**
+     * @brief Parse "PATH[,LOWER=PATH...]"
+     *
+     * The first partition owns every volser below the second's lower
+     * bound, e.g. "/tmp/p0.sock,M=/tmp/p1.sock" splits the catalog at "M".
+     */
+    static Result<PartitionMap> parse(const std::string& spec) {
+        PartitionMap map;
+        size_t start = 0;
+        while (start <= spec.size()) {
+            size_t end = std::min(spec.find(',', start), spec.size());
+            std::string entry = trim(spec.substr(start, end - start));
+            size_t eq = entry.find('=');
+            auto added = eq == std::string::npos ? map.add("", entry)
+                                                 : map.add(trim(entry.substr(0, eq)), trim(entry.substr(eq + 1)));
+            if (!added) return Result<PartitionMap>::err(added.error_code(), added.error().message);
+            start = end + 1;
+        }
+        return Result<PartitionMap>::ok(std::move(map));
+    }
+    
+    /// Append a partition; lower bounds must increase and only the first is empty
+    OperationResult add(std::string lower, std::string socket_path) {
+        lower = to_upper(std::move(lower));
+        if (socket_path.empty()) {
+            return OperationResult::err(TMSError::INVALID_PARAMETER, "Partition has no socket path");
+        }
+        if (partitions_.empty() != lower.empty()) {
+            return OperationResult::err(TMSError::INVALID_PARAMETER,
+                partitions_.empty() ? "The first partition takes no lower bound"
+                                    : "Partition " + socket_path + " needs a lower bound");
+        }
+        if (!partitions_.empty() && lower <= partitions_.back().lower) {
+            return OperationResult::err(TMSError::INVALID_PARAMETER,
+                                        "Partition bounds must increase: " + lower);
+        }
+        partitions_.push_back(Partition{std::move(lower), std::move(socket_path)});
+        return OperationResult::ok();
+    }
+    
+    /// Index of the partition owning @p volser
+    size_t owner_of(std::string_view volser) const {
+        auto it = std::upper_bound(partitions_.begin(), partitions_.end(), volser,
+            [](std::string_view v, const Partition& p) { return v < p.lower; });
+        return it == partitions_.begin() ? 0 : static_cast<size_t>(it - partitions_.begin()) - 1;
+    }
+    
+    size_t size() const { return partitions_.size(); }
+    bool empty() const { return partitions_.empty(); }
+    const Partition& operator[](size_t i) const { return partitions_[i]; }
+    const std::vector<Partition>& partitions() const { return partitions_; }
+    
+    /// Back to the parse() format
+    std::string to_string() const {
+        std::string spec;
+        for (const auto& p : partitions_) {
+            if (!spec.empty()) spec += ",";
+            if (!p.lower.empty()) spec += p.lower + "=";
+            spec += p.socket_path;
+        }
+        return spec;
+    }
+
+private:
+    std::vector<Partition> partitions_;
+};
+
+#if TMS_HAS_RPC
+
+// ============================================================================
+// Router
+// ============================================================================
+
+struct PartitionRouterOptions {
+    std::chrono::milliseconds timeout{5000};    ///< Longest wait for one partition's reply
+    size_t idle_connections = 8;                ///< Connections kept open per partition
+    size_t cached_names = 65536;                ///< Dataset names whose partition is remembered
+};
+
+/**
+ * @brief Sends catalog operations to the partitions that own them
+ *
+ * Thread-safe: each call borrows a connection per partition it needs from
+ * a small pool. A SET_SESSION frame carrying the current OperationContext
+ * goes out ahead of every routed request on the same write, so pooled
+ * connections never act for an earlier caller. A partition that cannot be
+ * reached fails the call with its index and socket in the message;
+ * nothing is retried.
+ */
+class PartitionRouter {
+public:
+    explicit PartitionRouter(PartitionMap map, PartitionRouterOptions options = {})
+        : map_(std::move(map)), options_(options) {
+        for (size_t i = 0; i < map_.size(); i++) pools_.push_back(std::make_unique<Pool>());
+    }
+    
+    PartitionRouter(const PartitionRouter&) = delete;
+    PartitionRouter& operator=(const PartitionRouter&) = delete;
+    
+    const PartitionMap& map() const { return map_; }
+    
+    // Volumes: sent to the owning partition
+    
+    Result<bool> volume_exists(const std::string& volser) {
+        return value_of<bool>(forward(owner(volser), RpcOp::VOLUME_EXISTS, key_args(volser)),
+                              [](RpcReader& r) { return r.get_bool(); });
+    }
+    Result<TapeVolume> get_volume(const std::string& volser) {
+        return value_of<TapeVolume>(forward(owner(volser), RpcOp::GET_VOLUME, key_args(volser)),
+                                    RpcCodec::read_volume);
+    }
+    OperationResult add_volume(const TapeVolume& volume) {
+        return status_of(forward(owner(volume.volser), RpcOp::ADD_VOLUME,
+                                 encode([&](RpcWriter& w) { RpcCodec::write_volume(w, volume); })));
+    }
+    OperationResult patch_volume(const std::string& volser, const VolumePatch& patch) {
+        return status_of(forward(owner(volser), RpcOp::PATCH_VOLUME, encode([&](RpcWriter& w) {
+            w.put_string(volser);
+            RpcCodec::write_volume_patch(w, patch);
+        })));
+    }
+    OperationResult delete_volume(const std::string& volser, bool force = false) {
+        return status_of(forward(owner(volser), RpcOp::DELETE_VOLUME, encode([&](RpcWriter& w) {
+            w.put_string(volser);
+            w.put_bool(force);
+        })));
+    }
+    OperationResult mount_volume(const std::string& volser) {
+        return status_of(forward(owner(volser), RpcOp::MOUNT_VOLUME, key_args(volser)));
+    }
+    OperationResult dismount_volume(const std::string& volser) {
+        return status_of(forward(owner(volser), RpcOp::DISMOUNT_VOLUME, key_args(volser)));
+    }
+    OperationResult scratch_volume(const std::string& volser) {
+        return status_of(forward(owner(volser), RpcOp::SCRATCH_VOLUME, key_args(volser)));
+    }
+    
+    /// Tries partitions in turn, starting one further along each call
+    Result<std::string> allocate_scratch_volume(const std::string& pool = "",
+                                                std::optional<TapeDensity> density = std::nullopt) {
+        return value_of<std::string>(allocate(encode([&](RpcWriter& w) {
+            w.put_string(pool);
+            w.put_le<uint8_t>(density ? static_cast<uint8_t>(*density) : 0xFF);
+        })), [](RpcReader& r) { return std::string(r.get_string()); });
+    }
+    
+    // Datasets: added beside their volume, found by asking every partition
+    
+    Result<bool> dataset_exists(const std::string& name) {
+        return value_of<bool>(any_exists(key_args(name)), [](RpcReader& r) { return r.get_bool(); });
+    }
+    Result<Dataset> get_dataset(const std::string& name) {
+        return value_of<Dataset>(on_holder(RpcOp::GET_DATASET, key_args(name)), RpcCodec::read_dataset);
+    }
+    OperationResult add_dataset(const Dataset& dataset) {
+        return status_of(add_dataset_args(dataset.name, dataset.volser,
+                                          encode([&](RpcWriter& w) { RpcCodec::write_dataset(w, dataset); })));
+    }
+    OperationResult patch_dataset(const std::string& name, const DatasetPatch& patch) {
+        return status_of(on_holder(RpcOp::PATCH_DATASET, encode([&](RpcWriter& w) {
+            w.put_string(name);
+            RpcCodec::write_dataset_patch(w, patch);
+        })));
+    }
+    OperationResult delete_dataset(const std::string& name) {
+        return status_of(on_holder(RpcOp::DELETE_DATASET, key_args(name)));
+    }
+    
+    // Every partition, merged
+    
+    /// Volumes after @p after in volser order, at most @p limit (0: all)
+    Result<std::vector<TapeVolume>> list_volumes(std::optional<VolumeStatus> status = std::nullopt,
+                                                 const std::string& after = "", size_t limit = 0) {
+        return gather_volumes(RpcOp::LIST_VOLUMES, encode([&](RpcWriter& w) {
+            w.put_le<uint8_t>(status ? static_cast<uint8_t>(*status) : 0xFF);
+            w.put_string(after);
+            w.put_le<uint32_t>(static_cast<uint32_t>(limit));
+        }), VolumeOrder::VOLSER, false, limit);
+    }
+    Result<std::vector<TapeVolume>> search_volumes(const SearchCriteria& criteria) {
+        return gather_volumes(RpcOp::SEARCH_VOLUMES,
+                              encode([&](RpcWriter& w) { RpcCodec::write_criteria(w, criteria); }),
+                              VolumeOrder::VOLSER, false, criteria.limit);
+    }
+    /// The first @p limit matches by @p order across all partitions
+    Result<std::vector<TapeVolume>> query_volumes(const std::string& query, VolumeOrder order = VolumeOrder::VOLSER,
+                                                  bool descending = false, size_t limit = 0) {
+        return gather_volumes(RpcOp::QUERY_VOLUMES, encode([&](RpcWriter& w) {
+            w.put_string(query);
+            w.put_le<uint8_t>(static_cast<uint8_t>(order));
+            w.put_bool(descending);
+            w.put_le<uint32_t>(static_cast<uint32_t>(limit));
+        }), order, descending, limit);
+    }
+    Result<std::vector<Dataset>> query_datasets(const std::string& query, size_t limit = 0) {
+        return gather_datasets(encode([&](RpcWriter& w) {
+            w.put_string(query);
+            w.put_le<uint32_t>(static_cast<uint32_t>(limit));
+        }), limit);
+    }
+    Result<SystemStatistics> get_statistics();
+    OperationResult save_catalog();
+    
+    /// Serve the catalog operations on @p server from the partitions;
+    /// call before server.start()
+    void attach(RpcServer& server);
+
+private:
+    struct Pool {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<RpcClient>> idle;
+    };
+    using Client = std::unique_ptr<RpcClient>;
+    
+    template<typename Fn>
+    static std::string encode(Fn&& write) {
+        RpcWriter w;
+        write(w);
+        return w.data();
+    }
+    static std::string key_args(const std::string& key) {
+        return encode([&](RpcWriter& w) { w.put_string(key); });
+    }
+    
+    static OperationResult status_of(const Result<RpcResponse>& response) {
+        if (!response) return OperationResult::err(response.error().code, response.error().message);
+        return response.value().result();
+    }
+    template<typename T, typename Fn>
+    static Result<T> value_of(const Result<RpcResponse>& response, Fn&& read) {
+        if (!response) return Result<T>::err(response.error().code, response.error().message);
+        return response.value().template decode<T>(std::forward<Fn>(read));
+    }
+    
+    size_t owner(const std::string& volser) const { return map_.owner_of(to_upper(volser)); }
+    std::string where(size_t partition) const {
+        return "Partition " + std::to_string(partition) + " (" + map_[partition].socket_path + ")";
+    }
+    
+    Result<Client> acquire(size_t partition);
+    void release(size_t partition, Client client);
+    static Result<std::string> session_args();
+    static void send(RpcClient& client, std::string_view session, RpcOp op, std::string_view args);
+    static Result<RpcResponse> take(RpcClient& client);
+    Result<RpcResponse> forward(size_t partition, RpcOp op, std::string_view args);
+    Result<std::vector<RpcResponse>> scatter(RpcOp op, std::string_view args);
+    
+    Result<RpcResponse> allocate(std::string_view args);
+    Result<RpcResponse> any_exists(std::string_view args);
+    Result<RpcResponse> on_holder(RpcOp op, std::string_view args);
+    static std::string name_of(std::string_view args);
+    std::optional<size_t> holder_of(const std::string& name);
+    void remember(const std::string& name, size_t partition);
+    void forget(const std::string& name);
+    Result<RpcResponse> add_dataset_args(const std::string& name, const std::string& volser, std::string_view args);
+    Result<std::vector<TapeVolume>> gather_volumes(RpcOp op, std::string_view args, VolumeOrder order,
+                                                   bool descending, size_t limit);
+    Result<std::vector<Dataset>> gather_datasets(std::string_view args, size_t limit);
+    
+    PartitionMap map_;
+    PartitionRouterOptions options_;
+    std::vector<std::unique_ptr<Pool>> pools_;
+    std::atomic<size_t> next_scratch_{0};
+    std::mutex holders_mutex_;
+    std::unordered_map<std::string, size_t> holders_;  ///< Dataset name -> partition that last held it
+};
+
+// ============================================================================
+// Router Implementation
+// ============================================================================
+
+inline Result<PartitionRouter::Client> PartitionRouter::acquire(size_t partition) {
+    {
+        std::lock_guard<std::mutex> lock(pools_[partition]->mutex);
+        auto& idle = pools_[partition]->idle;
+        if (!idle.empty()) {
+            Client client = std::move(idle.back());
+            idle.pop_back();
+            return Result<Client>::ok(std::move(client));
+        }
+    }
+    auto client = std::make_unique<RpcClient>();
+    auto connected = client->connect_unix(map_[partition].socket_path);
+    if (connected) connected = client->set_receive_timeout(options_.timeout);
+    if (!connected) {
+        return Result<Client>::err(connected.error_code(), where(partition) + ": " + connected.error().message);
+    }
+    return Result<Client>::ok(std::move(client));
+}
+
+// A connection that failed or still owes a response is not reused
+inline void PartitionRouter::release(size_t partition, Client client) {
+    if (!client->is_connected() || client->outstanding() > 0) return;
+    std::lock_guard<std::mutex> lock(pools_[partition]->mutex);
+    if (pools_[partition]->idle.size() < options_.idle_connections) {
+        pools_[partition]->idle.push_back(std::move(client));
+    }
+}
+
+// SET_SESSION arguments naming the caller's user and session, bounded by
+// the time the caller has left
+inline Result<std::string> PartitionRouter::session_args() {
+    const OperationContext* ctx = current_operation_context();
+    uint32_t timeout_ms = 0;
+    if (ctx && ctx->deadline) {
+        if (ctx->expired()) {
+            return Result<std::string>::err(TMSError::OPERATION_TIMEOUT, "Deadline exceeded before routing");
+        }
+        // 0 would mean no deadline at all
+        timeout_ms = static_cast<uint32_t>(std::clamp<int64_t>(ctx->remaining()->count(), 1, UINT32_MAX));
+    }
+    return Result<std::string>::ok(encode([&](RpcWriter& w) {
+        w.put_string(ctx ? ctx->user : std::string());
+        w.put_le<uint32_t>(timeout_ms);
+        w.put_string(ctx ? ctx->session_id : std::string());
+    }));
+}
+
+inline void PartitionRouter::send(RpcClient& client, std::string_view session, RpcOp op, std::string_view args) {
+    client.enqueue(RpcOp::SET_SESSION, [&](RpcWriter& w) { w.put_bytes(session); });
+    client.enqueue(op, [&](RpcWriter& w) { w.put_bytes(args); });
+}
+
+// The reply to a request queued by send(); both replies are always read
+inline Result<RpcResponse> PartitionRouter::take(RpcClient& client) {
+    auto session = client.receive();
+    if (!session) return session;
+    auto response = client.receive();
+    if (response && !session.value().is_success()) {
+        return Result<RpcResponse>::err(session.value().status, session.value().message());
+    }
+    return response;
+}
+
+inline Result<RpcResponse> PartitionRouter::forward(size_t partition, RpcOp op, std::string_view args) {
+    if (map_.empty()) return Result<RpcResponse>::err(TMSError::INVALID_STATE, "No partitions configured");
+    auto session = session_args();
+    if (!session) return Result<RpcResponse>::err(session.error().code, session.error().message);
+    auto client = acquire(partition);
+    if (!client) return Result<RpcResponse>::err(client.error().code, client.error().message);
+    send(*client.value(), session.value(), op, args);
+    auto response = take(*client.value());
+    release(partition, std::move(client.value()));
+    if (!response) {
+        return Result<RpcResponse>::err(response.error().code, where(partition) + ": " + response.error().message);
+    }
+    return response;
+}
+
+// Requests go out to every partition before any reply is read, so the
+// partitions work at the same time
+inline Result<std::vector<RpcResponse>> PartitionRouter::scatter(RpcOp op, std::string_view args) {
+    if (map_.empty()) return Result<std::vector<RpcResponse>>::err(TMSError::INVALID_STATE, "No partitions configured");
+    auto session = session_args();
+    if (!session) return Result<std::vector<RpcResponse>>::err(session.error().code, session.error().message);
+    std::vector<Client> clients(map_.size());
+    std::optional<ErrorInfo> failure;
+    for (size_t i = 0; i < map_.size() && !failure; i++) {
+        auto client = acquire(i);
+        if (!client) {
+            failure = client.error();
+            break;
+        }
+        clients[i] = std::move(client.value());
+        send(*clients[i], session.value(), op, args);
+        auto sent = clients[i]->flush();
+        if (!sent) failure = ErrorInfo(sent.error_code(), where(i) + ": " + sent.error().message);
+    }
+    std::vector<RpcResponse> responses(map_.size());
+    for (size_t i = 0; i < map_.size(); i++) {
+        if (!clients[i]) continue;
+        if (clients[i]->outstanding() > 0 && clients[i]->is_connected()) {
+            auto response = take(*clients[i]);
+            if (response) {
+                responses[i] = std::move(response.value());
+            } else if (!failure) {
+                failure = ErrorInfo(response.error().code, where(i) + ": " + response.error().message);
+            }
+        }
+        release(i, std::move(clients[i]));
+    }
+    if (failure) return Result<std::vector<RpcResponse>>::err(failure->code, failure->message);
+    return Result<std::vector<RpcResponse>>::ok(std::move(responses));
+}
+
+inline Result<RpcResponse> PartitionRouter::allocate(std::string_view args) {
+    size_t start = next_scratch_.fetch_add(1, std::memory_order_relaxed);
+    Result<RpcResponse> last = Result<RpcResponse>::err(TMSError::NO_SCRATCH_AVAILABLE, "No partitions");
+    for (size_t n = 0; n < map_.size(); n++) {
+        last = forward((start + n) % map_.size(), RpcOp::ALLOCATE_SCRATCH, args);
+        if (!last) return last;
+        TMSError status = last.value().status;
+        if (status != TMSError::NO_SCRATCH_AVAILABLE && status != TMSError::POOL_NOT_FOUND) return last;
+    }
+    return last;
+}
+
+// Every dataset request starts with the name; empty if malformed, which
+// leaves the partitions to report it
+inline std::string PartitionRouter::name_of(std::string_view args) {
+    RpcReader r(args);
+    std::string name(r.get_string());
+    return r.ok() ? name : std::string();
+}
+
+inline std::optional<size_t> PartitionRouter::holder_of(const std::string& name) {
+    if (name.empty()) return std::nullopt;
+    std::lock_guard<std::mutex> lock(holders_mutex_);
+    auto it = holders_.find(name);
+    if (it == holders_.end()) return std::nullopt;
+    return it->second;
+}
+
+inline void PartitionRouter::remember(const std::string& name, size_t partition) {
+    if (name.empty() || options_.cached_names == 0) return;
+    std::lock_guard<std::mutex> lock(holders_mutex_);
+    if (holders_.size() >= options_.cached_names && !holders_.count(name)) holders_.clear();
+    holders_[name] = partition;
+}
+
+inline void PartitionRouter::forget(const std::string& name) {
+    std::lock_guard<std::mutex> lock(holders_mutex_);
+    holders_.erase(name);
+}
+
+// A cached holder that still has the name answers alone; otherwise every
+// partition is asked and the holder, if any, is remembered
+inline Result<RpcResponse> PartitionRouter::any_exists(std::string_view args) {
+    std::string name = name_of(args);
+    if (auto cached = holder_of(name)) {
+        auto response = forward(*cached, RpcOp::DATASET_EXISTS, args);
+        if (!response) return response;
+        RpcReader r(response.value().payload);
+        if (response.value().is_success() && r.get_bool()) return response;
+        forget(name);
+    }
+    auto responses = scatter(RpcOp::DATASET_EXISTS, args);
+    if (!responses) return Result<RpcResponse>::err(responses.error().code, responses.error().message);
+    for (size_t i = 0; i < responses.value().size(); i++) {
+        auto& response = responses.value()[i];
+        RpcReader r(response.payload);
+        if (!response.is_success()) return Result<RpcResponse>::ok(std::move(response));
+        if (r.get_bool()) {
+            remember(name, i);
+            return Result<RpcResponse>::ok(std::move(response));
+        }
+    }
+    return Result<RpcResponse>::ok(std::move(responses.value().front()));
+}
+
+// Names are unique across partitions, so at most one succeeds; otherwise
+// the most telling failure is returned. A cached holder is tried alone
+// first and dropped once it no longer has the name.
+inline Result<RpcResponse> PartitionRouter::on_holder(RpcOp op, std::string_view args) {
+    std::string name = name_of(args);
+    if (auto cached = holder_of(name)) {
+        auto response = forward(*cached, op, args);
+        if (!response || response.value().status != TMSError::DATASET_NOT_FOUND) {
+            if (response && response.value().is_success() && op == RpcOp::DELETE_DATASET) forget(name);
+            return response;
+        }
+        forget(name);
+    }
+    auto responses = scatter(op, args);
+    if (!responses) return Result<RpcResponse>::err(responses.error().code, responses.error().message);
+    auto& all = responses.value();
+    auto rank = [](const RpcResponse& r) {
+        return r.is_success() ? 0 : r.status != TMSError::DATASET_NOT_FOUND ? 1 : 2;
+    };
+    auto best = std::min_element(all.begin(), all.end(),
+        [&](const RpcResponse& a, const RpcResponse& b) { return rank(a) < rank(b); });
+    if (best->is_success() && op != RpcOp::DELETE_DATASET) remember(name, static_cast<size_t>(best - all.begin()));
+    return Result<RpcResponse>::ok(std::move(*best));
+}
+
+// Checked, not locked: two routers adding one name on two partitions at
+// once can both succeed
+inline Result<RpcResponse> PartitionRouter::add_dataset_args(const std::string& name, const std::string& volser,
+                                                             std::string_view args) {
+    auto exists = any_exists(key_args(name));
+    if (!exists || !exists.value().is_success()) return exists;
+    RpcReader r(exists.value().payload);
+    if (r.get_bool()) {
+        RpcResponse taken;
+        taken.op = RpcOp::ADD_DATASET;
+        taken.status = TMSError::DATASET_ALREADY_EXISTS;
+        taken.payload = encode([&](RpcWriter& w) { w.put_string("Dataset already exists: " + name); });
+        return Result<RpcResponse>::ok(std::move(taken));
+    }
+    size_t partition = owner(volser);
+    auto added = forward(partition, RpcOp::ADD_DATASET, args);
+    if (added && added.value().is_success()) remember(name, partition);
+    return added;
+}
+
+inline Result<std::vector<TapeVolume>> PartitionRouter::gather_volumes(RpcOp op, std::string_view args,
+                                                                       VolumeOrder order, bool descending,
+                                                                       size_t limit) {
+    auto responses = scatter(op, args);
+    if (!responses) return Result<std::vector<TapeVolume>>::err(responses.error().code, responses.error().message);
+    std::vector<TapeVolume> merged;
+    for (const auto& response : responses.value()) {
+        auto part = response.decode<std::vector<TapeVolume>>(RpcCodec::read_volumes);
+        if (!part) return part;
+        std::move(part.value().begin(), part.value().end(), std::back_inserter(merged));
+    }
+    rpc_sort_and_limit(merged, limit, [order, descending](const TapeVolume& a, const TapeVolume& b) {
+        return volume_order_before(a, b, order, descending);
+    });
+    return Result<std::vector<TapeVolume>>::ok(std::move(merged));
+}
+
+inline Result<std::vector<Dataset>> PartitionRouter::gather_datasets(std::string_view args, size_t limit) {
+    auto responses = scatter(RpcOp::QUERY_DATASETS, args);
+    if (!responses) return Result<std::vector<Dataset>>::err(responses.error().code, responses.error().message);
+    std::vector<Dataset> merged;
+    for (const auto& response : responses.value()) {
+        auto part = response.decode<std::vector<Dataset>>(RpcCodec::read_datasets);
+        if (!part) return part;
+        std::move(part.value().begin(), part.value().end(), std::back_inserter(merged));
+    }
+    rpc_sort_and_limit(merged, limit, [](const Dataset& a, const Dataset& b) { return a.name < b.name; });
+    return Result<std::vector<Dataset>>::ok(std::move(merged));
+}
+
+inline Result<SystemStatistics> PartitionRouter::get_statistics() {
+    auto responses = scatter(RpcOp::GET_STATISTICS, {});
+    if (!responses) return Result<SystemStatistics>::err(responses.error().code, responses.error().message);
+    SystemStatistics total;
+    for (const auto& response : responses.value()) {
+        auto part = response.decode<SystemStatistics>(RpcCodec::read_statistics);
+        if (!part) return part;
+        const SystemStatistics& s = part.value();
+        total.total_volumes += s.total_volumes;
+        total.scratch_volumes += s.scratch_volumes;
+        total.private_volumes += s.private_volumes;
+        total.mounted_volumes += s.mounted_volumes;
+        total.expired_volumes += s.expired_volumes;
+        total.reserved_volumes += s.reserved_volumes;
+        total.total_datasets += s.total_datasets;
+        total.active_datasets += s.active_datasets;
+        total.migrated_datasets += s.migrated_datasets;
+        total.expired_datasets += s.expired_datasets;
+        total.total_capacity += s.total_capacity;
+        total.used_capacity += s.used_capacity;
+        for (const auto& [pool, count] : s.pool_counts) total.pool_counts[pool] += count;
+    }
+    return Result<SystemStatistics>::ok(std::move(total));
+}
+
+inline OperationResult PartitionRouter::save_catalog() {
+    auto responses = scatter(RpcOp::SAVE_CATALOG, {});
+    if (!responses) return OperationResult::err(responses.error().code, responses.error().message);
+    for (size_t i = 0; i < responses.value().size(); i++) {
+        const auto& response = responses.value()[i];
+        if (!response.is_success()) return OperationResult::err(response.status, where(i) + ": " + response.message());
+    }
+    return OperationResult::ok();
+}
+
+inline void PartitionRouter::attach(RpcServer& server) {
+    // A reply passes through unchanged; a failure is re-encoded by the server
+    auto relay = [](const Result<RpcResponse>& response, RpcWriter& out) {
+        if (!response) return OperationResult::err(response.error().code, response.error().message);
+        if (!response.value().is_success()) return response.value().result();
+        out.put_bytes(response.value().payload);
+        return OperationResult::ok();
+    };
+    
+    for (RpcOp op : {RpcOp::VOLUME_EXISTS, RpcOp::GET_VOLUME, RpcOp::ADD_VOLUME, RpcOp::PATCH_VOLUME,
+                     RpcOp::DELETE_VOLUME, RpcOp::MOUNT_VOLUME, RpcOp::DISMOUNT_VOLUME, RpcOp::SCRATCH_VOLUME}) {
+        // Every one of these starts with the volser
+        server.handle(op, [this, op, relay](RpcReader& args, RpcWriter& out) {
+            RpcReader key = args;
+            std::string volser(key.get_string());
+            if (!key.ok()) return OperationResult::err(TMSError::INVALID_FORMAT, "Missing volser");
+            return relay(forward(owner(volser), op, args.get_rest()), out);
+        });
+    }
+    server.handle(RpcOp::ALLOCATE_SCRATCH, [this, relay](RpcReader& args, RpcWriter& out) {
+        return relay(allocate(args.get_rest()), out);
+    });
+    server.handle(RpcOp::DATASET_EXISTS, [this, relay](RpcReader& args, RpcWriter& out) {
+        return relay(any_exists(args.get_rest()), out);
+    });
+    for (RpcOp op : {RpcOp::GET_DATASET, RpcOp::PATCH_DATASET, RpcOp::DELETE_DATASET}) {
+        server.handle(op, [this, op, relay](RpcReader& args, RpcWriter& out) {
+            return relay(on_holder(op, args.get_rest()), out);
+        });
+    }
+    server.handle(RpcOp::ADD_DATASET, [this, relay](RpcReader& args, RpcWriter& out) {
+        RpcReader key = args;
+        std::string name(key.get_string());
+        std::string volser(key.get_string());
+        if (!key.ok()) return OperationResult::err(TMSError::INVALID_FORMAT, "Missing dataset name or volser");
+        return relay(add_dataset_args(name, volser, args.get_rest()), out);
+    });
+    
+    server.handle(RpcOp::LIST_VOLUMES, [this](RpcReader& args, RpcWriter& out) {
+        RpcReader peek = args;
+        peek.get_le<uint8_t>();
+        peek.get_string();
+        uint32_t limit = peek.get_le<uint32_t>();
+        if (!peek.ok()) return OperationResult::err(TMSError::INVALID_FORMAT, "Malformed LIST_VOLUMES request");
+        auto volumes = gather_volumes(RpcOp::LIST_VOLUMES, args.get_rest(), VolumeOrder::VOLSER, false, limit);
+        if (!volumes) return OperationResult::err(volumes.error().code, volumes.error().message);
+        RpcCodec::write_volumes(out, volumes.value());
+        return OperationResult::ok();
+    });
+    server.handle(RpcOp::SEARCH_VOLUMES, [this](RpcReader& args, RpcWriter& out) {
+        RpcReader peek = args;
+        SearchCriteria criteria = RpcCodec::read_criteria(peek);
+        if (!peek.ok()) return OperationResult::err(TMSError::INVALID_FORMAT, "Malformed SEARCH_VOLUMES request");
+        auto volumes = gather_volumes(RpcOp::SEARCH_VOLUMES, args.get_rest(), VolumeOrder::VOLSER, false,
+                                      criteria.limit);
+        if (!volumes) return OperationResult::err(volumes.error().code, volumes.error().message);
+        RpcCodec::write_volumes(out, volumes.value());
+        return OperationResult::ok();
+    });
+    server.handle(RpcOp::QUERY_VOLUMES, [this](RpcReader& args, RpcWriter& out) {
+        RpcReader peek = args;
+        peek.get_string();
+        auto order = peek.get_enum(VolumeOrder::EXPIRATION);
+        bool descending = peek.get_bool();
+        uint32_t limit = peek.get_le<uint32_t>();
+        if (!peek.ok()) return OperationResult::err(TMSError::INVALID_FORMAT, "Malformed QUERY_VOLUMES request");
+        auto volumes = gather_volumes(RpcOp::QUERY_VOLUMES, args.get_rest(), order, descending, limit);
+        if (!volumes) return OperationResult::err(volumes.error().code, volumes.error().message);
+        RpcCodec::write_volumes(out, volumes.value());
+        return OperationResult::ok();
+    });
+    server.handle(RpcOp::QUERY_DATASETS, [this](RpcReader& args, RpcWriter& out) {
+        RpcReader peek = args;
+        peek.get_string();
+        uint32_t limit = peek.get_le<uint32_t>();
+        if (!peek.ok()) return OperationResult::err(TMSError::INVALID_FORMAT, "Malformed QUERY_DATASETS request");
+        auto datasets = gather_datasets(args.get_rest(), limit);
+        if (!datasets) return OperationResult::err(datasets.error().code, datasets.error().message);
+        RpcCodec::write_datasets(out, datasets.value());
+        return OperationResult::ok();
+    });
+    server.handle(RpcOp::GET_STATISTICS, [this](RpcReader&, RpcWriter& out) {
+        auto stats = get_statistics();
+        if (!stats) return OperationResult::err(stats.error().code, stats.error().message);
+        RpcCodec::write_statistics(out, stats.value());
+        return OperationResult::ok();
+    });
+    server.handle(RpcOp::SAVE_CATALOG, [this](RpcReader&, RpcWriter&) { return save_catalog(); });
+}
+
+#endif // TMS_HAS_RPC
+
+} // namespace tms
+
+#endif // TMS_PARTITION_H
@@ -15,6 +15,7 @@
 
 #include "tms_types.h"
 #include "tms_utils.h"
+#include "tms_memory.h"
 #include <string>
 #include <vector>
 #include <map>
@@ -22,6 +23,10 @@
 #include <memory>
 #include <sstream>
 #include <regex>
+#include <optional>
+#include <cerrno>
+#include <cstdlib>
+#include <memory_resource>
 
 namespace tms {
 
@@ -223,12 +228,25 @@ public:
     static std::vector<std::string> get_operator_names();
     
 private:
-    bool evaluate_condition(const QueryCondition& cond, const TapeVolume& vol) const;
-    bool evaluate_condition(const QueryCondition& cond, const Dataset& ds) const;
-    std::string get_volume_field_value(const TapeVolume& vol, QueryField field) const;
-    std::string get_dataset_field_value(const Dataset& ds, QueryField field) const;
-    bool compare_values(const std::string& actual, const std::string& expected, 
-                        QueryOperator op) const;
+    // v3.4.0: Evaluation state for one query, allocated from its scratch
+    // arena. Expected values are upper-cased and regexes compiled once per
+    // query, and field values are written into one reused buffer.
+    struct PreparedCondition {
+        const QueryCondition* cond;
+        std::pmr::string expected;              ///< Upper-cased value
+        std::optional<long long> number;        ///< Value for GREATER_THAN / LESS_THAN
+        std::optional<std::regex> regex;        ///< Value for MATCHES
+    };
+    using PreparedConditions = std::pmr::vector<PreparedCondition>;
+    
+    static PreparedConditions prepare(const std::vector<QueryCondition>& conditions,
+                                      std::pmr::memory_resource* resource);
+    template<typename Record, typename WriteField>
+    static bool matches_all(const PreparedConditions& prepared, const Record& record,
+                            WriteField&& write_field, std::pmr::string& scratch);
+    static void write_volume_field(const TapeVolume& vol, QueryField field, std::pmr::string& out);
+    static void write_dataset_field(const Dataset& ds, QueryField field, std::pmr::string& out);
+    static bool compare_value(const PreparedCondition& prepared, std::pmr::string& actual);
     
     std::map<std::string, SavedQuery> saved_queries_;
 };
@@ -298,16 +316,13 @@ inline std::vector<TapeVolume> QueryEngine::query_volumes(
     std::vector<TapeVolume> result;
     auto volumes = get_volumes();
     
-    for (const auto& vol : volumes) {
-        bool match = true;
-        for (const auto& cond : conditions) {
-            if (!evaluate_condition(cond, vol)) {
-                match = false;
-                break;
-            }
-        }
-        if (match) {
-            result.push_back(vol);
+    ScratchArena arena(ArenaKind::QUERY);
+    auto prepared = prepare(conditions, arena.resource());
+    std::pmr::string scratch(arena.resource());
+    
+    for (auto& vol : volumes) {
+        if (matches_all(prepared, vol, write_volume_field, scratch)) {
+            result.push_back(std::move(vol));
         }
     }
     
@@ -329,16 +344,13 @@ inline std::vector<Dataset> QueryEngine::query_datasets(
     std::vector<Dataset> result;
     auto datasets = get_datasets();
     
-    for (const auto& ds : datasets) {
-        bool match = true;
-        for (const auto& cond : conditions) {
-            if (!evaluate_condition(cond, ds)) {
-                match = false;
-                break;
-            }
-        }
-        if (match) {
-            result.push_back(ds);
+    ScratchArena arena(ArenaKind::QUERY);
+    auto prepared = prepare(conditions, arena.resource());
+    std::pmr::string scratch(arena.resource());
+    
+    for (auto& ds : datasets) {
+        if (matches_all(prepared, ds, write_dataset_field, scratch)) {
+            result.push_back(std::move(ds));
         }
     }
     
@@ -408,73 +420,113 @@ inline std::vector<QueryCondition> QueryEngine::parse_query(const std::string& q
     return conditions;
 }
 
-inline bool QueryEngine::evaluate_condition(const QueryCondition& cond, const TapeVolume& vol) const {
-    std::string value = get_volume_field_value(vol, cond.field);
-    return compare_values(value, cond.value, cond.op);
+inline QueryEngine::PreparedConditions QueryEngine::prepare(
+    const std::vector<QueryCondition>& conditions, std::pmr::memory_resource* resource) {
+    
+    PreparedConditions prepared(resource);
+    prepared.reserve(conditions.size());
+    for (const auto& cond : conditions) {
+        PreparedCondition p{&cond, std::pmr::string(to_upper(cond.value), resource), std::nullopt, std::nullopt};
+        if (cond.op == QueryOperator::GREATER_THAN || cond.op == QueryOperator::LESS_THAN) {
+            try { p.number = std::stoll(cond.value); } catch (...) {}
+        } else if (cond.op == QueryOperator::MATCHES) {
+            try { p.regex.emplace(cond.value, std::regex::icase); } catch (...) {}
+        }
+        prepared.push_back(std::move(p));
+    }
+    return prepared;
 }
 
-inline bool QueryEngine::evaluate_condition(const QueryCondition& cond, const Dataset& ds) const {
-    std::string value = get_dataset_field_value(ds, cond.field);
-    return compare_values(value, cond.value, cond.op);
+template<typename Record, typename WriteField>
+inline bool QueryEngine::matches_all(const PreparedConditions& prepared, const Record& record,
+                                     WriteField&& write_field, std::pmr::string& scratch) {
+    for (const auto& p : prepared) {
+        scratch.clear();
+        write_field(record, p.cond->field, scratch);
+        if (!compare_value(p, scratch)) return false;
+    }
+    return true;
 }
 
-inline std::string QueryEngine::get_volume_field_value(const TapeVolume& vol, QueryField field) const {
+inline void QueryEngine::write_volume_field(const TapeVolume& vol, QueryField field, std::pmr::string& out) {
     switch (field) {
-        case QueryField::VOLSER: return vol.volser;
-        case QueryField::VOLUME_STATUS: return volume_status_to_string(vol.status);
-        case QueryField::VOLUME_DENSITY: return density_to_string(vol.density);
-        case QueryField::VOLUME_LOCATION: return vol.location;
-        case QueryField::VOLUME_POOL: return vol.pool;
-        case QueryField::VOLUME_OWNER: return vol.owner;
-        case QueryField::VOLUME_CAPACITY: return std::to_string(vol.capacity_bytes);
-        case QueryField::VOLUME_USED: return std::to_string(vol.used_bytes);
-        case QueryField::VOLUME_MOUNT_COUNT: return std::to_string(vol.mount_count);
+        case QueryField::VOLSER: out += vol.volser; break;
+        case QueryField::VOLUME_STATUS: out += volume_status_to_string(vol.status); break;
+        case QueryField::VOLUME_DENSITY: out += density_to_string(vol.density); break;
+        case QueryField::VOLUME_LOCATION: out += vol.location.view(); break;
+        case QueryField::VOLUME_POOL: out += vol.pool.view(); break;
+        case QueryField::VOLUME_OWNER: out += vol.owner.view(); break;
+        case QueryField::VOLUME_CAPACITY: out += std::to_string(vol.capacity_bytes); break;
+        case QueryField::VOLUME_USED: out += std::to_string(vol.used_bytes); break;
+        case QueryField::VOLUME_MOUNT_COUNT: out += std::to_string(vol.mount_count); break;
         case QueryField::ANY:
             // Concatenate searchable fields
-            return vol.volser + " " + vol.owner + " " + vol.pool + " " + vol.location;
-        default: return "";
+            out += vol.volser;
+            out += ' ';
+            out += vol.owner.view();
+            out += ' ';
+            out += vol.pool.view();
+            out += ' ';
+            out += vol.location.view();
+            break;
+        default: break;
     }
 }
 
-inline std::string QueryEngine::get_dataset_field_value(const Dataset& ds, QueryField field) const {
+inline void QueryEngine::write_dataset_field(const Dataset& ds, QueryField field, std::pmr::string& out) {
     switch (field) {
-        case QueryField::DATASET_NAME: return ds.name;
-        case QueryField::DATASET_VOLSER: return ds.volser;
-        case QueryField::DATASET_STATUS: return dataset_status_to_string(ds.status);
-        case QueryField::DATASET_SIZE: return std::to_string(ds.size_bytes);
-        case QueryField::DATASET_OWNER: return ds.owner;
+        case QueryField::DATASET_NAME: out += ds.name; break;
+        case QueryField::DATASET_VOLSER: out += ds.volser; break;
+        case QueryField::DATASET_STATUS: out += dataset_status_to_string(ds.status); break;
+        case QueryField::DATASET_SIZE: out += std::to_string(ds.size_bytes); break;
+        case QueryField::DATASET_OWNER: out += ds.owner.view(); break;
         case QueryField::ANY:
-            return ds.name + " " + ds.volser + " " + ds.owner;
-        default: return "";
+            out += ds.name;
+            out += ' ';
+            out += ds.volser;
+            out += ' ';
+            out += ds.owner.view();
+            break;
+        default: break;
     }
 }
 
-inline bool QueryEngine::compare_values(const std::string& actual, const std::string& expected,
-                                         QueryOperator op) const {
-    std::string act_upper = to_upper(actual);
-    std::string exp_upper = to_upper(expected);
+// Numeric and regex operators read the value as written; the others
+// compare case-insensitively, so @p actual is upper-cased in place
+inline bool QueryEngine::compare_value(const PreparedCondition& prepared, std::pmr::string& actual) {
+    const std::pmr::string& expected = prepared.expected;
     
-    switch (op) {
+    switch (prepared.cond->op) {
+        case QueryOperator::GREATER_THAN:
+        case QueryOperator::LESS_THAN: {
+            if (!prepared.number) return false;
+            errno = 0;
+            char* end = nullptr;
+            long long value = std::strtoll(actual.c_str(), &end, 10);
+            if (end == actual.c_str() || errno == ERANGE) return false;
+            return prepared.cond->op == QueryOperator::GREATER_THAN ? value > *prepared.number
+                                                                    : value < *prepared.number;
+        }
+        case QueryOperator::MATCHES:
+            return prepared.regex && std::regex_search(actual.begin(), actual.end(), *prepared.regex);
+        default:
+            break;
+    }
+    
+    std::transform(actual.begin(), actual.end(), actual.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+    switch (prepared.cond->op) {
         case QueryOperator::EQUALS:
-            return act_upper == exp_upper;
+            return actual == expected;
         case QueryOperator::NOT_EQUALS:
-            return act_upper != exp_upper;
+            return actual != expected;
         case QueryOperator::CONTAINS:
-            return act_upper.find(exp_upper) != std::string::npos;
+            return actual.find(expected) != std::pmr::string::npos;
         case QueryOperator::STARTS_WITH:
-            return act_upper.find(exp_upper) == 0;
+            return actual.compare(0, expected.size(), expected) == 0;
         case QueryOperator::ENDS_WITH:
-            return act_upper.length() >= exp_upper.length() &&
-                   act_upper.substr(act_upper.length() - exp_upper.length()) == exp_upper;
-        case QueryOperator::GREATER_THAN:
-            try { return std::stoll(actual) > std::stoll(expected); } catch (...) { return false; }
-        case QueryOperator::LESS_THAN:
-            try { return std::stoll(actual) < std::stoll(expected); } catch (...) { return false; }
-        case QueryOperator::MATCHES:
-            try {
-                std::regex re(expected, std::regex::icase);
-                return std::regex_search(actual, re);
-            } catch (...) { return false; }
+            return actual.size() >= expected.size() &&
+                   actual.compare(actual.size() - expected.size(), expected.size(), expected) == 0;
         default:
             return false;
     }
@@ -520,7 +572,7 @@ inline OperationResult QueryEngine::save_query(const SavedQuery& query) {
     }
     
     SavedQuery q = query;
-    q.created = std::chrono::system_clock::now();
+    q.created = current_time();
     saved_queries_[q.name] = q;
     
     return OperationResult::ok();
@@ -540,7 +592,7 @@ inline std::optional<SavedQuery> QueryEngine::get_query(const std::string& name)
     if (it == saved_queries_.end()) {
         return std::nullopt;
     }
-    it->second.last_used = std::chrono::system_clock::now();
+    it->second.last_used = current_time();
     it->second.use_count++;
     return it->second;
 }
@@ -0,0 +1,408 @@
+/**
+ * @file tms_rcu.h
+ * @brief TMS Tape Management System - Epoch-Based Record Publication
+ * @version 3.4.0
+ * @author Bennie Shearer
+ * @copyright Copyright (c) 2025 Bennie Shearer
+ * @license MIT License
+ *
+ * Point lookups dominate catalog traffic, and under the shared catalog lock
+ * every one of them writes the lock's reader count, so read throughput stops
+ * scaling once a few cores contend for that cache line. RcuMap publishes
+ * immutable copies of the records: a writer builds the replacement and swaps
+ * one pointer, and readers find records with plain atomic loads. Replaced
+ * records are freed by the process-wide EpochDomain once every reader that
+ * could still hold them has left its read-side section.
+ */
+
+#ifndef TMS_RCU_H
+#define TMS_RCU_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace tms {
+
+// ============================================================================
+// Epoch Domain
+// ============================================================================
+
+struct EpochStats {
+    uint64_t epoch = 0;
+    size_t readers = 0;             ///< Threads holding a reader slot
+    size_t pending = 0;             ///< Retired objects not yet freed
+    uint64_t reclaimed = 0;         ///< Retired objects freed so far
+};
+
+/**
+ * @brief Epoch-based reclamation for objects read without locks
+ *
+ * A reader pins the domain for the duration of a lookup, announcing the
+ * global epoch in its own cache-line-sized slot. Writers unlink an object
+ * and retire() it, which tags it with the epoch and advances the epoch; the
+ * object is freed once no pinned reader announced an epoch at or before
+ * its tag. Slots are claimed per thread on first use and released at
+ * thread exit. When all slots are taken the returned guard is inactive and
+ * the caller must use its locked path instead.
+ */
+class EpochDomain {
+    struct Slot;
+    
+public:
+    static constexpr size_t SLOTS = 256;
+    static constexpr uint64_t IDLE = std::numeric_limits<uint64_t>::max();
+    
+    static EpochDomain& instance() {
+        static EpochDomain domain;
+        return domain;
+    }
+    
+    /**
+     * @brief Read-side section; nests within one thread
+     */
+    class Guard {
+    public:
+        explicit Guard(EpochDomain& domain) {
+            ThreadState& state = local();
+            if (!state.slot) state.slot = domain.acquire_slot();
+            if (!state.slot) return;
+            slot_ = state.slot;
+            if (state.depth++ == 0) {
+                slot_->epoch.store(domain.epoch_.load(std::memory_order_acquire), std::memory_order_relaxed);
+                // Pairs with the fence in reclaim(): either the reclaimer sees
+                // this announcement or our loads see its unlinks
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+            }
+        }
+        ~Guard() {
+            if (slot_ && --local().depth == 0) slot_->epoch.store(IDLE, std::memory_order_release);
+        }
+        
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+        
+        bool active() const { return slot_ != nullptr; }
+    
+    private:
+        Slot* slot_ = nullptr;
+    };
+    
+    Guard pin() { return Guard(*this); }
+    
+    /// Free @p object once current readers are done with it
+    template<typename T>
+    void retire(const T* object) {
+        if (!object) return;
+        retire(object, [](const void* p) { delete static_cast<const T*>(p); });
+    }
+    
+    void retire(const void* object, void (*deleter)(const void*)) {
+        bool due;
+        {
+            std::lock_guard<std::mutex> lock(retired_mutex_);
+            retired_.push_back({object, deleter, epoch_.fetch_add(1, std::memory_order_acq_rel)});
+            due = retired_.size() >= next_reclaim_;
+        }
+        if (due) reclaim();
+    }
+    
+    /// Free every retired object no pinned reader can reach; returns the count
+    size_t reclaim() {
+        std::vector<Retired> ready;
+        {
+            std::lock_guard<std::mutex> lock(retired_mutex_);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            uint64_t oldest = oldest_pinned();
+            auto keep = std::partition(retired_.begin(), retired_.end(),
+                                       [oldest](const Retired& r) { return r.epoch >= oldest; });
+            ready.assign(keep, retired_.end());
+            retired_.erase(keep, retired_.end());
+            // Readers stuck in a long visit would otherwise make every
+            // retire rescan the whole list
+            next_reclaim_ = std::max<size_t>(RECLAIM_THRESHOLD, retired_.size() * 2);
+            reclaimed_ += ready.size();
+        }
+        for (const auto& r : ready) r.deleter(r.object);
+        return ready.size();
+    }
+    
+    /**
+     * @brief Wait until every reader pinned before the call has unpinned
+     *
+     * Must not be called from inside a read-side section.
+     */
+    void synchronize() {
+        uint64_t target = epoch_.fetch_add(1, std::memory_order_acq_rel) + 1;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        for (auto& slot : slots_) {
+            while (slot.epoch.load(std::memory_order_acquire) < target) std::this_thread::yield();
+        }
+    }
+    
+    EpochStats stats() const {
+        EpochStats s;
+        s.epoch = epoch_.load(std::memory_order_relaxed);
+        for (const auto& slot : slots_) {
+            if (slot.owned.load(std::memory_order_relaxed)) s.readers++;
+        }
+        std::lock_guard<std::mutex> lock(retired_mutex_);
+        s.pending = retired_.size();
+        s.reclaimed = reclaimed_;
+        return s;
+    }
+    
+private:
+    static constexpr size_t RECLAIM_THRESHOLD = 64;
+    
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> epoch{IDLE};
+        std::atomic<bool> owned{false};
+    };
+    
+    struct Retired {
+        const void* object;
+        void (*deleter)(const void*);
+        uint64_t epoch;
+    };
+    
+    // Released at thread exit so short-lived threads do not leak slots
+    struct ThreadState {
+        Slot* slot = nullptr;
+        uint32_t depth = 0;
+        ~ThreadState() {
+            if (!slot) return;
+            slot->epoch.store(IDLE, std::memory_order_release);
+            slot->owned.store(false, std::memory_order_release);
+        }
+    };
+    
+    static ThreadState& local() {
+        thread_local ThreadState state;
+        return state;
+    }
+    
+    EpochDomain() = default;
+    
+    ~EpochDomain() {
+        for (const auto& r : retired_) r.deleter(r.object);
+    }
+    
+    Slot* acquire_slot() {
+        for (auto& slot : slots_) {
+            bool expected = false;
+            if (!slot.owned.load(std::memory_order_relaxed) &&
+                slot.owned.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+                return &slot;
+            }
+        }
+        return nullptr;
+    }
+    
+    uint64_t oldest_pinned() const {
+        uint64_t oldest = IDLE;
+        for (const auto& slot : slots_) {
+            oldest = std::min(oldest, slot.epoch.load(std::memory_order_acquire));
+        }
+        return oldest;
+    }
+    
+    std::array<Slot, SLOTS> slots_;
+    std::atomic<uint64_t> epoch_{1};
+    mutable std::mutex retired_mutex_;
+    std::vector<Retired> retired_;
+    size_t next_reclaim_ = RECLAIM_THRESHOLD;
+    uint64_t reclaimed_ = 0;
+};
+
+// ============================================================================
+// Published Record Map
+// ============================================================================
+
+/**
+ * @brief Hash map of immutable records keyed by @p Key, read without locks
+ *
+ * Buckets are immutable arrays of record pointers; every change copies the
+ * affected bucket and swaps it in, and growing copies the bucket table.
+ * Writers must be serialised by the caller (TMSSystem holds its exclusive
+ * catalog lock). find() must be called inside an EpochDomain guard, and
+ * the record it returns stays valid until that guard ends.
+ */
+template<typename T, std::string T::*Key>
+class RcuMap {
+public:
+    RcuMap() : table_(new Table(MIN_BUCKETS)) {}
+    
+    ~RcuMap() {
+        const Table* table = table_.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < table->count; i++) {
+            if (const Bucket* bucket = table->buckets[i].load(std::memory_order_relaxed)) {
+                for (const T* record : bucket->records) delete record;
+            }
+        }
+        delete table;
+    }
+    
+    RcuMap(const RcuMap&) = delete;
+    RcuMap& operator=(const RcuMap&) = delete;
+    
+    const T* find(const std::string& key) const {
+        const Table* table = table_.load(std::memory_order_acquire);
+        const Bucket* bucket = table->bucket_for(key).load(std::memory_order_acquire);
+        if (!bucket) return nullptr;
+        for (const T* record : bucket->records) {
+            if (record->*Key == key) return record;
+        }
+        return nullptr;
+    }
+    
+    /// Publish a copy of @p record, replacing any record with its key
+    void publish(const T& record) {
+        const T* fresh = new T(record);
+        const Table* table = table_.load(std::memory_order_relaxed);
+        auto& slot = table->bucket_for(fresh->*Key);
+        const Bucket* old = slot.load(std::memory_order_relaxed);
+        auto* bucket = new Bucket;
+        const T* replaced = nullptr;
+        if (old) {
+            bucket->records.reserve(old->records.size() + 1);
+            for (const T* r : old->records) {
+                if (r->*Key == fresh->*Key) replaced = r;
+                else bucket->records.push_back(r);
+            }
+        }
+        bucket->records.push_back(fresh);
+        slot.store(bucket, std::memory_order_release);
+        auto& domain = EpochDomain::instance();
+        domain.retire(old);
+        if (replaced) domain.retire(replaced);
+        else if (++size_ > table->count * MAX_LOAD) grow();
+    }
+    
+    /// Withdraw the record for @p key, if published
+    void unpublish(const std::string& key) {
+        const Table* table = table_.load(std::memory_order_relaxed);
+        auto& slot = table->bucket_for(key);
+        const Bucket* old = slot.load(std::memory_order_relaxed);
+        if (!old) return;
+        auto it = std::find_if(old->records.begin(), old->records.end(),
+                               [&key](const T* r) { return r->*Key == key; });
+        if (it == old->records.end()) return;
+        const T* removed = *it;
+        Bucket* bucket = nullptr;
+        if (old->records.size() > 1) {
+            bucket = new Bucket;
+            bucket->records.reserve(old->records.size() - 1);
+            for (const T* r : old->records) {
+                if (r != removed) bucket->records.push_back(r);
+            }
+        }
+        slot.store(bucket, std::memory_order_release);
+        size_--;
+        auto& domain = EpochDomain::instance();
+        domain.retire(old);
+        domain.retire(removed);
+    }
+    
+    /// Replace the whole contents in one swap; readers see all old or all new
+    template<typename RecordMap>
+    void assign(const RecordMap& records) {
+        auto* table = new Table(bucket_count_for(records.size()));
+        std::vector<std::vector<const T*>> staged(table->count);
+        for (const auto& [key, record] : records) {
+            staged[table->index_of(key)].push_back(new T(record));
+        }
+        for (size_t i = 0; i < table->count; i++) {
+            if (staged[i].empty()) continue;
+            auto* bucket = new Bucket;
+            bucket->records = std::move(staged[i]);
+            table->buckets[i].store(bucket, std::memory_order_relaxed);
+        }
+        const Table* old = table_.exchange(table, std::memory_order_acq_rel);
+        size_ = records.size();
+        retire_table(old, true);
+    }
+    
+    void clear() { assign(std::map<std::string, T>{}); }
+    
+    size_t size() const { return size_; }
+    
+private:
+    static constexpr size_t MIN_BUCKETS = 64;
+    static constexpr size_t MAX_LOAD = 2;
+    
+    struct Bucket {
+        std::vector<const T*> records;
+    };
+    
+    struct Table {
+        explicit Table(size_t n) : count(n), buckets(new std::atomic<const Bucket*>[n]) {
+            for (size_t i = 0; i < n; i++) buckets[i].store(nullptr, std::memory_order_relaxed);
+        }
+        // Buckets are retired with the table; records are retired separately
+        ~Table() {
+            for (size_t i = 0; i < count; i++) delete buckets[i].load(std::memory_order_relaxed);
+        }
+        
+        size_t index_of(const std::string& key) const { return std::hash<std::string>{}(key) & (count - 1); }
+        std::atomic<const Bucket*>& bucket_for(const std::string& key) const { return buckets[index_of(key)]; }
+        
+        size_t count;
+        std::unique_ptr<std::atomic<const Bucket*>[]> buckets;
+    };
+    
+    static size_t bucket_count_for(size_t records) {
+        size_t n = MIN_BUCKETS;
+        while (n * MAX_LOAD < records) n *= 2;
+        return n;
+    }
+    
+    // Rehash the same record pointers into a table twice the size
+    void grow() {
+        const Table* old = table_.load(std::memory_order_relaxed);
+        auto* table = new Table(old->count * 2);
+        std::vector<std::vector<const T*>> staged(table->count);
+        for (size_t i = 0; i < old->count; i++) {
+            if (const Bucket* bucket = old->buckets[i].load(std::memory_order_relaxed)) {
+                for (const T* r : bucket->records) staged[table->index_of(r->*Key)].push_back(r);
+            }
+        }
+        for (size_t i = 0; i < table->count; i++) {
+            if (staged[i].empty()) continue;
+            auto* bucket = new Bucket;
+            bucket->records = std::move(staged[i]);
+            table->buckets[i].store(bucket, std::memory_order_relaxed);
+        }
+        table_.store(table, std::memory_order_release);
+        retire_table(old, false);
+    }
+    
+    void retire_table(const Table* table, bool with_records) {
+        auto& domain = EpochDomain::instance();
+        if (with_records) {
+            for (size_t i = 0; i < table->count; i++) {
+                if (const Bucket* bucket = table->buckets[i].load(std::memory_order_relaxed)) {
+                    for (const T* r : bucket->records) domain.retire(r);
+                }
+            }
+        }
+        domain.retire(table);
+    }
+    
+    std::atomic<const Table*> table_;
+    size_t size_ = 0;
+};
+
+} // namespace tms
+
+#endif // TMS_RCU_H
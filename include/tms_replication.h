@@ -0,0 +1,951 @@
+/**
+ * @file tms_replication.h
+ * @brief TMS Tape Management System - Hot-Standby Replication
+ * @version 3.4.0
+ * @author Bennie Shearer
+ * @copyright Copyright (c) 2025 Bennie Shearer
+ * @license MIT License
+ *
+ * Keeps a standby catalog in step with a primary by shipping the primary's
+ * change stream (tms_cdc.h). ReplicationPrimary serves the stream on a Unix
+ * socket in the RPC frame format. A follower names the log it follows and
+ * the next change it needs. If the primary still retains that change, the
+ * stream starts there; otherwise the primary first sends a snapshot of the
+ * catalog taken at a known sequence. ReplicationFollower applies the stream
+ * to its own TMSSystem, acknowledges each batch and reconnects when the
+ * stream breaks; a RESYNC marker, written when the primary reloads its
+ * catalog, sends it back for a fresh snapshot. An RpcServer attached to a follower serves reads only
+ * until the follower is promoted. Shipping is asynchronous: changes not
+ * yet received when the primary fails are not on the promoted follower.
+ * Linux-only, like the RPC server.
+ */
+
+#ifndef TMS_REPLICATION_H
+#define TMS_REPLICATION_H
+
+#include "tms_rpc.h"
+#include "tms_cdc.h"
+#include <string>
+#include <vector>
+#include <memory>
+#include <optional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <filesystem>
+#include <random>
+
+#if TMS_HAS_RPC
+    #include <poll.h>
+#endif
+
+namespace tms {
+
+// ============================================================================
+// Status
+// ============================================================================
+
+enum class ReplicationRole : uint8_t {
+    PRIMARY,        ///< Takes writes and ships its change stream
+    FOLLOWER        ///< Applies a primary's stream; read-only
+};
+
+inline const char* replication_role_to_string(ReplicationRole role) {
+    return role == ReplicationRole::PRIMARY ? "PRIMARY" : "FOLLOWER";
+}
+
+/**
+ * @brief Where a node stands in replication (REPLICATION_STATUS)
+ */
+struct ReplicationStatus {
+    ReplicationRole role = ReplicationRole::FOLLOWER;
+    bool connected = false;             ///< Follower: stream open
+    std::string primary;                ///< Follower: replication socket followed
+    std::string log_id;                 ///< Change log the sequences belong to
+    uint64_t applied_sequence = 0;      ///< Follower: newest change applied; primary: newest committed
+    uint64_t primary_sequence = 0;      ///< Newest change the primary has reported
+    uint64_t lag_records = 0;           ///< Follower: changes behind; primary: furthest-behind follower
+    int64_t apply_lag_ms = 0;           ///< Primary commit to follower apply, for the newest applied change
+    int64_t since_contact_ms = -1;      ///< Since the last frame from the primary; -1 before any
+    uint64_t records_applied = 0;
+    uint64_t snapshots = 0;             ///< Follower: installed; primary: sent
+    uint64_t reconnects = 0;
+    uint32_t followers = 0;             ///< Primary: followers connected
+};
+
+/**
+ * @brief Wire encoding of change records and replication status
+ *
+ * Records are shipped whole: the RpcCodec form followed by the server-kept
+ * state it leaves out, so a follower's copy matches the primary's.
+ */
+struct ReplicationCodec {
+    static void write_volume(RpcWriter& w, const TapeVolume& vol) {
+        RpcCodec::write_volume(w, vol);
+        w.put_le<uint32_t>(static_cast<uint32_t>(vol.location_history.size()));
+        for (const auto& entry : vol.location_history) {
+            w.put_string(entry.location.view());
+            w.put_time(entry.timestamp);
+            w.put_string(entry.moved_by);
+            w.put_string(entry.reason);
+        }
+        const VolumeHealthScore& health = vol.health_score;
+        w.put_double(health.overall_score);
+        w.put_le<uint8_t>(static_cast<uint8_t>(health.status));
+        w.put_double(health.error_rate_score);
+        w.put_double(health.age_score);
+        w.put_double(health.usage_score);
+        w.put_double(health.capacity_score);
+        w.put_time(health.last_calculated);
+        w.put_strings(health.recommendations);
+        w.put_bool(vol.encryption.encrypted);
+        w.put_le<uint8_t>(static_cast<uint8_t>(vol.encryption.algorithm));
+        w.put_string(vol.encryption.key_id);
+        w.put_string(vol.encryption.key_label);
+        w.put_time(vol.encryption.encrypted_date);
+        w.put_string(vol.encryption.encrypted_by);
+        w.put_time(vol.last_access_date);
+        w.put_time(vol.last_health_check);
+        w.put_le<int32_t>(vol.read_error_count);
+        w.put_le<int32_t>(vol.write_error_count);
+    }
+    
+    static TapeVolume read_volume(RpcReader& r) {
+        TapeVolume vol = RpcCodec::read_volume(r);
+        uint32_t moves = r.get_count(20);
+        for (uint32_t i = 0; i < moves && r.ok(); i++) {
+            LocationHistoryEntry entry;
+            entry.location = r.get_string();
+            entry.timestamp = r.get_time();
+            entry.moved_by = r.get_string();
+            entry.reason = r.get_string();
+            vol.location_history.push_back(std::move(entry));
+        }
+        VolumeHealthScore& health = vol.health_score;
+        health.overall_score = r.get_double();
+        health.status = r.get_enum(HealthStatus::CRITICAL);
+        health.error_rate_score = r.get_double();
+        health.age_score = r.get_double();
+        health.usage_score = r.get_double();
+        health.capacity_score = r.get_double();
+        health.last_calculated = r.get_time();
+        r.get_strings([&](std::string_view text) { health.recommendations.emplace_back(text); });
+        vol.encryption.encrypted = r.get_bool();
+        vol.encryption.algorithm = r.get_enum(EncryptionAlgorithm::TDES);
+        vol.encryption.key_id = r.get_string();
+        vol.encryption.key_label = r.get_string();
+        vol.encryption.encrypted_date = r.get_time();
+        vol.encryption.encrypted_by = r.get_string();
+        vol.last_access_date = r.get_time();
+        vol.last_health_check = r.get_time();
+        vol.read_error_count = r.get_le<int32_t>();
+        vol.write_error_count = r.get_le<int32_t>();
+        return vol;
+    }
+    
+    static void write_dataset(RpcWriter& w, const Dataset& ds) {
+        RpcCodec::write_dataset(w, ds);
+        w.put_bool(ds.compressed);
+        w.put_string(ds.compression_type);
+        w.put_le<uint64_t>(ds.original_size_bytes);
+        w.put_le<int32_t>(ds.access_count);
+    }
+    
+    static Dataset read_dataset(RpcReader& r) {
+        Dataset ds = RpcCodec::read_dataset(r);
+        ds.compressed = r.get_bool();
+        ds.compression_type = r.get_string();
+        ds.original_size_bytes = r.get_le<uint64_t>();
+        ds.access_count = r.get_le<int32_t>();
+        return ds;
+    }
+    
+    static void write_change(RpcWriter& w, const ChangeRecord& record) {
+        w.put_le<uint64_t>(record.sequence);
+        w.put_time(record.timestamp);
+        w.put_le<uint8_t>(static_cast<uint8_t>(record.entity));
+        w.put_le<uint8_t>(static_cast<uint8_t>(record.operation));
+        w.put_le<uint16_t>(static_cast<uint16_t>(record.event));
+        w.put_string(record.key);
+        w.put_bool(record.volume.has_value());
+        if (record.volume) write_volume(w, *record.volume);
+        w.put_bool(record.dataset.has_value());
+        if (record.dataset) write_dataset(w, *record.dataset);
+        w.put_string(record.user);
+        w.put_string(record.session_id);
+        w.put_string(record.request_id);
+    }
+    
+    static ChangeRecord read_change(RpcReader& r) {
+        ChangeRecord record;
+        record.sequence = r.get_le<uint64_t>();
+        record.timestamp = r.get_time();
+        record.entity = r.get_enum(ChangeEntity::CATALOG);
+        record.operation = r.get_enum(ChangeOperation::RESYNC);
+        record.event = static_cast<EventType>(r.get_le<uint16_t>());
+        record.key = r.get_string();
+        if (r.get_bool()) record.volume = read_volume(r);
+        if (r.get_bool()) record.dataset = read_dataset(r);
+        record.user = r.get_string();
+        record.session_id = r.get_string();
+        record.request_id = r.get_string();
+        return record;
+    }
+    
+    static void write_status(RpcWriter& w, const ReplicationStatus& s) {
+        w.put_le<uint8_t>(static_cast<uint8_t>(s.role));
+        w.put_bool(s.connected);
+        w.put_string(s.primary);
+        w.put_string(s.log_id);
+        w.put_le<uint64_t>(s.applied_sequence);
+        w.put_le<uint64_t>(s.primary_sequence);
+        w.put_le<uint64_t>(s.lag_records);
+        w.put_le<int64_t>(s.apply_lag_ms);
+        w.put_le<int64_t>(s.since_contact_ms);
+        w.put_le<uint64_t>(s.records_applied);
+        w.put_le<uint64_t>(s.snapshots);
+        w.put_le<uint64_t>(s.reconnects);
+        w.put_le<uint32_t>(s.followers);
+    }
+    
+    static ReplicationStatus read_status(RpcReader& r) {
+        ReplicationStatus s;
+        s.role = static_cast<ReplicationRole>(r.get_le<uint8_t>());
+        s.connected = r.get_bool();
+        s.primary = r.get_string();
+        s.log_id = r.get_string();
+        s.applied_sequence = r.get_le<uint64_t>();
+        s.primary_sequence = r.get_le<uint64_t>();
+        s.lag_records = r.get_le<uint64_t>();
+        s.apply_lag_ms = r.get_le<int64_t>();
+        s.since_contact_ms = r.get_le<int64_t>();
+        s.records_applied = r.get_le<uint64_t>();
+        s.snapshots = r.get_le<uint64_t>();
+        s.reconnects = r.get_le<uint64_t>();
+        s.followers = r.get_le<uint32_t>();
+        return s;
+    }
+};
+
+#if TMS_HAS_RPC
+
+// ============================================================================
+// Primary
+// ============================================================================
+
+struct ReplicationPrimaryOptions {
+    std::string socket_path;                        ///< Where followers connect
+    std::chrono::milliseconds heartbeat{100};       ///< Longest a follower goes without a frame
+    size_t batch_records = 1000;                    ///< Records per snapshot or change frame
+    size_t max_queued = 100000;                     ///< Unsent changes before a slow follower is dropped
+};
+
+/**
+ * @brief Ships a catalog's change stream to followers
+ *
+ * One thread accepts followers and each follower has a sender thread. A
+ * follower's changes are queued by the change log's flusher and sent in
+ * batches; a follower that falls max_queued changes behind is dropped and
+ * catches up from the retained log when it reconnects.
+ */
+class ReplicationPrimary {
+public:
+    explicit ReplicationPrimary(TMSSystem& system) : system_(system) {}
+    ~ReplicationPrimary() { stop(); }
+    
+    ReplicationPrimary(const ReplicationPrimary&) = delete;
+    ReplicationPrimary& operator=(const ReplicationPrimary&) = delete;
+    
+    /// Listen for followers; enables the change stream if it is off
+    OperationResult start(const ReplicationPrimaryOptions& options);
+    void stop();
+    
+    bool is_running() const { return running_.load(std::memory_order_acquire); }
+    const std::string& log_id() const { return log_id_; }
+    ReplicationStatus status() const;
+    
+    /// Serve REPLICATION_STATUS on @p server; call before server.start()
+    void attach(RpcServer& server);
+
+private:
+    struct Follower {
+        int fd = -1;                        ///< Closed by the sender thread
+        std::thread thread;
+        std::mutex mutex;                   ///< Guards the members below
+        std::condition_variable cv;
+        std::vector<ChangeRecord> queue;    ///< Delivered by the change log, not yet sent
+        bool overflow = false;
+        bool closing = false;
+        std::atomic<uint64_t> acked{0};
+        std::atomic<bool> finished{false};
+    };
+    using FollowerPtr = std::shared_ptr<Follower>;
+    
+    static std::string load_log_id(const std::string& directory);
+    void run_accept();
+    void serve(const FollowerPtr& follower);
+    bool stream(const FollowerPtr& follower, std::string& in);
+    bool read_acks(Follower& follower, std::string& in);
+    
+    TMSSystem& system_;
+    ReplicationPrimaryOptions options_;
+    std::shared_ptr<ChangeLog> log_;
+    std::string log_id_;
+    int listen_fd_ = -1;
+    int wake_fd_ = -1;
+    std::atomic<bool> running_{false};
+    std::thread accept_thread_;
+    
+    mutable std::mutex followers_mutex_;
+    std::vector<FollowerPtr> followers_;
+    std::atomic<uint64_t> snapshots_{0};
+};
+
+// ============================================================================
+// Follower
+// ============================================================================
+
+struct ReplicationFollowerOptions {
+    std::string primary_socket;                         ///< The primary's replication socket
+    std::chrono::milliseconds retry_interval{500};      ///< Between connection attempts
+    std::chrono::milliseconds timeout{2000};            ///< Silence after which the stream is reopened
+};
+
+/**
+ * @brief Applies a primary's change stream to a standby catalog
+ *
+ * A background thread holds the stream open. Each batch of changes is
+ * applied as one catalog write, so readers see whole commits. Promotion
+ * stops the thread for good; the catalog keeps what was applied.
+ */
+class ReplicationFollower {
+public:
+    explicit ReplicationFollower(TMSSystem& system) : system_(system) {}
+    ~ReplicationFollower() { stop(); }
+    
+    ReplicationFollower(const ReplicationFollower&) = delete;
+    ReplicationFollower& operator=(const ReplicationFollower&) = delete;
+    
+    OperationResult start(const ReplicationFollowerOptions& options);
+    
+    /// Stop following; start() resumes from the last applied change
+    void stop();
+    
+    /// Stop following for good; attached servers start taking writes
+    OperationResult promote();
+    bool is_promoted() const;
+    
+    ReplicationStatus status() const;
+    
+    /// Wait until synced with the primary through @p sequence; false on timeout
+    bool wait_for(uint64_t sequence, std::chrono::milliseconds timeout) const;
+    
+    /// Serve PROMOTE and REPLICATION_STATUS on @p server and keep it
+    /// read-only until promotion; call before server.start()
+    void attach(RpcServer& server);
+
+private:
+    void run();
+    void follow(RpcClient& client);
+    void acknowledge(RpcClient& client, uint64_t sequence);
+    
+    TMSSystem& system_;
+    ReplicationFollowerOptions options_;
+    std::thread thread_;
+    std::atomic<bool> stopping_{false};
+    
+    mutable std::mutex mutex_;              ///< Guards the members below
+    mutable std::condition_variable cv_;    ///< Progress, or stop requested
+    ReplicationStatus status_;
+    std::optional<std::chrono::steady_clock::time_point> last_contact_;
+    std::vector<RpcServer*> servers_;
+};
+
+/// Promote the follower serving @p client's daemon
+inline OperationResult promote_replica(RpcClient& client) {
+    auto response = client.call(RpcOp::PROMOTE);
+    if (!response) return OperationResult::err(response.error().code, response.error().message);
+    return response.value().result();
+}
+
+/// Replication status of @p client's daemon
+inline Result<ReplicationStatus> get_replication_status(RpcClient& client) {
+    auto response = client.call(RpcOp::REPLICATION_STATUS);
+    if (!response) return Result<ReplicationStatus>::err(response.error().code, response.error().message);
+    return response.value().decode<ReplicationStatus>(ReplicationCodec::read_status);
+}
+
+// ============================================================================
+// Primary Implementation
+// ============================================================================
+
+namespace detail {
+
+inline bool replication_send(int fd, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n > 0) {
+            sent += static_cast<size_t>(n);
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// Wait for one complete frame at the front of @p in; its size, or 0
+inline size_t replication_read_frame(int fd, std::string& in, std::chrono::milliseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (true) {
+        size_t size = rpc_frame_size(in);
+        if (size == RPC_BAD_FRAME) return 0;
+        if (size > 0) return size;
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+        if (left.count() <= 0) return 0;
+        pollfd p{fd, POLLIN, 0};
+        int ready = ::poll(&p, 1, static_cast<int>(left.count()));
+        if (ready < 0 && errno == EINTR) continue;
+        if (ready <= 0) return 0;
+        char buf[4096];
+        ssize_t n = ::recv(fd, buf, sizeof(buf), 0);
+        if (n <= 0) return 0;
+        in.append(buf, static_cast<size_t>(n));
+    }
+}
+
+}
+
+// The id names this catalog's log, so a follower of another primary, or
+// of this one before its log was reset, starts over from a snapshot
+inline std::string ReplicationPrimary::load_log_id(const std::string& directory) {
+    std::string path = (std::filesystem::path(directory) / "replication.id").string();
+    std::string id;
+    std::ifstream in(path);
+    if (in >> id && !id.empty()) return id;
+    
+    std::random_device rd;
+    std::mt19937_64 rng((static_cast<uint64_t>(rd()) << 32) ^ rd());
+    char buf[17];
+    std::snprintf(buf, sizeof(buf), "%016llx", static_cast<unsigned long long>(rng()));
+    id = buf;
+    std::ofstream(path) << id << "\n";
+    return id;
+}
+
+inline OperationResult ReplicationPrimary::start(const ReplicationPrimaryOptions& options) {
+    if (is_running()) return OperationResult::err(TMSError::INVALID_STATE, "Replication already running");
+    if (options.socket_path.empty()) {
+        return OperationResult::err(TMSError::INVALID_PARAMETER, "No replication socket path given");
+    }
+    options_ = options;
+    options_.batch_records = std::max<size_t>(options_.batch_records, 1);
+    
+    if (!system_.get_change_stream()) {
+        auto enabled = system_.enable_change_stream();
+        if (!enabled) return enabled;
+    }
+    log_ = system_.get_change_stream();
+    log_id_ = load_log_id(log_->options().directory);
+    
+    auto listening = rpc_listen_unix(options_.socket_path);
+    if (!listening) return OperationResult::err(listening.error_code(), listening.error().message);
+    listen_fd_ = listening.value();
+    wake_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wake_fd_ < 0) {
+        std::string reason = std::strerror(errno);
+        ::close(listen_fd_);
+        listen_fd_ = -1;
+        ::unlink(options_.socket_path.c_str());
+        return OperationResult::err(TMSError::SYSTEM_ERROR, "eventfd failed: " + reason);
+    }
+    
+    running_.store(true, std::memory_order_release);
+    accept_thread_ = std::thread([this] { run_accept(); });
+    TMS_LOG_INFO("Replication", "Shipping change log " + log_id_ + " on " + options_.socket_path);
+    return OperationResult::ok();
+}
+
+inline void ReplicationPrimary::stop() {
+    if (!running_.exchange(false, std::memory_order_acq_rel)) return;
+    uint64_t one = 1;
+    [[maybe_unused]] ssize_t n = ::write(wake_fd_, &one, sizeof(one));
+    accept_thread_.join();
+    
+    std::vector<FollowerPtr> followers;
+    {
+        std::lock_guard<std::mutex> lock(followers_mutex_);
+        followers.swap(followers_);
+    }
+    for (auto& follower : followers) {
+        {
+            // Unblocks a sender stuck in send() to a follower that stopped reading
+            std::lock_guard<std::mutex> lock(follower->mutex);
+            follower->closing = true;
+            if (follower->fd >= 0) ::shutdown(follower->fd, SHUT_RDWR);
+        }
+        follower->cv.notify_all();
+    }
+    for (auto& follower : followers) follower->thread.join();
+    
+    ::close(listen_fd_);
+    ::close(wake_fd_);
+    listen_fd_ = wake_fd_ = -1;
+    ::unlink(options_.socket_path.c_str());
+    TMS_LOG_INFO("Replication", "Stopped shipping change log " + log_id_);
+}
+
+inline ReplicationStatus ReplicationPrimary::status() const {
+    ReplicationStatus s;
+    s.role = ReplicationRole::PRIMARY;
+    s.connected = is_running();
+    s.log_id = log_id_;
+    s.applied_sequence = s.primary_sequence = log_ ? log_->last_sequence() : 0;
+    s.snapshots = snapshots_.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(followers_mutex_);
+    for (const auto& follower : followers_) {
+        if (follower->finished.load(std::memory_order_acquire)) continue;
+        s.followers++;
+        uint64_t acked = follower->acked.load(std::memory_order_relaxed);
+        s.lag_records = std::max(s.lag_records, s.primary_sequence > acked ? s.primary_sequence - acked : 0);
+    }
+    return s;
+}
+
+inline void ReplicationPrimary::attach(RpcServer& server) {
+    server.handle(RpcOp::REPLICATION_STATUS, [this](RpcReader&, RpcWriter& out) {
+        ReplicationCodec::write_status(out, status());
+        return OperationResult::ok();
+    });
+}
+
+inline void ReplicationPrimary::run_accept() {
+    while (true) {
+        pollfd fds[2] = {{listen_fd_, POLLIN, 0}, {wake_fd_, POLLIN, 0}};
+        if (::poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) continue;
+            TMS_LOG_ERROR("Replication", std::string("poll failed: ") + std::strerror(errno));
+            return;
+        }
+        if (fds[1].revents != 0) return;
+        int fd = ::accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0) continue;
+        
+        auto follower = std::make_shared<Follower>();
+        follower->fd = fd;
+        std::lock_guard<std::mutex> lock(followers_mutex_);
+        for (auto it = followers_.begin(); it != followers_.end();) {
+            if ((*it)->finished.load(std::memory_order_acquire)) {
+                (*it)->thread.join();
+                it = followers_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        follower->thread = std::thread([this, follower] { serve(follower); });
+        followers_.push_back(std::move(follower));
+    }
+}
+
+inline void ReplicationPrimary::serve(const FollowerPtr& follower) {
+    std::string in;
+    stream(follower, in);
+    {
+        std::lock_guard<std::mutex> lock(follower->mutex);
+        ::close(follower->fd);
+        follower->fd = -1;
+    }
+    follower->finished.store(true, std::memory_order_release);
+}
+
+// Handshake, snapshot if needed, then changes until the follower goes away
+inline bool ReplicationPrimary::stream(const FollowerPtr& follower, std::string& in) {
+    int fd = follower->fd;
+    size_t size = detail::replication_read_frame(fd, in, std::chrono::seconds(5));
+    if (size == 0) return false;
+    RpcFrame hello = rpc_decode_frame(std::string_view(in).substr(0, size));
+    RpcReader args(hello.payload);
+    std::string follower_log(args.get_string());
+    uint64_t next = args.get_le<uint64_t>();
+    uint32_t hello_id = hello.id;
+    bool valid = hello.op == RpcOp::REPLICATE && args.ok();
+    in.erase(0, size);
+    
+    RpcWriter out;
+    size_t at = out.begin_frame(hello_id, RpcOp::REPLICATE);
+    if (!valid) {
+        out.put_string("Expected a REPLICATE request");
+        out.end_frame(at, TMSError::INVALID_FORMAT);
+        detail::replication_send(fd, out.data());
+        return false;
+    }
+    
+    // Stream from the log when it still holds `next`; otherwise snapshot
+    uint64_t last = log_->last_sequence();
+    uint64_t first = log_->get_stats().first_sequence;
+    uint64_t retained = first > 0 ? first : last + 1;
+    bool snapshot = follower_log != log_id_ || next == 0 || next < retained || next > last + 1;
+    std::optional<CatalogSnapshot> image;
+    if (snapshot) {
+        auto taken = system_.snapshot_for_replication();
+        if (!taken) {
+            out.put_string(taken.error().message);
+            out.end_frame(at, taken.error_code());
+            detail::replication_send(fd, out.data());
+            return false;
+        }
+        image = std::move(taken.value());
+        next = image->sequence + 1;
+    }
+    out.put_string(log_id_);
+    out.put_le<uint64_t>(last);
+    out.put_bool(snapshot);
+    out.end_frame(at);
+    
+    // Subscribed before the snapshot goes out, so nothing after it is missed
+    size_t max_queued = options_.max_queued;
+    auto subscription = log_->subscribe("", [follower, max_queued](const std::vector<ChangeRecord>& batch) {
+        std::lock_guard<std::mutex> lock(follower->mutex);
+        if (follower->overflow || follower->closing) return;
+        if (follower->queue.size() + batch.size() > max_queued) {
+            follower->overflow = true;
+            follower->queue.clear();
+        } else {
+            follower->queue.insert(follower->queue.end(), batch.begin(), batch.end());
+        }
+        follower->cv.notify_one();
+    }, next);
+    struct Unsubscribe {
+        ChangeLog& log;
+        ChangeSubscriptionId id;
+        ~Unsubscribe() { log.unsubscribe(id); }
+    } unsubscribe{*log_, subscription};
+    
+    if (image) {
+        snapshots_.fetch_add(1, std::memory_order_relaxed);
+        const auto& volumes = image->volumes;
+        const auto& datasets = image->datasets;
+        size_t v = 0;
+        size_t d = 0;
+        do {
+            size_t nv = std::min(options_.batch_records, volumes.size() - v);
+            size_t nd = std::min(options_.batch_records - nv, datasets.size() - d);
+            at = out.begin_frame(0, RpcOp::REPL_SNAPSHOT);
+            out.put_le<uint64_t>(image->sequence);
+            out.put_le<uint32_t>(static_cast<uint32_t>(nv));
+            for (size_t i = 0; i < nv; i++) ReplicationCodec::write_volume(out, volumes[v++]);
+            out.put_le<uint32_t>(static_cast<uint32_t>(nd));
+            for (size_t i = 0; i < nd; i++) ReplicationCodec::write_dataset(out, datasets[d++]);
+            out.put_bool(v == volumes.size() && d == datasets.size());
+            out.end_frame(at);
+            if (!detail::replication_send(fd, out.data())) return false;
+            out.clear();
+        } while (v < volumes.size() || d < datasets.size());
+        image.reset();
+    } else if (!detail::replication_send(fd, out.data())) {
+        return false;
+    }
+    
+    std::vector<ChangeRecord> batch;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(follower->mutex);
+            follower->cv.wait_for(lock, options_.heartbeat, [&] {
+                return follower->closing || follower->overflow || !follower->queue.empty();
+            });
+            if (follower->closing) return false;
+            if (follower->overflow) {
+                TMS_LOG_WARNING("Replication", "Dropping a follower more than " +
+                                std::to_string(max_queued) + " changes behind");
+                return false;
+            }
+            batch.swap(follower->queue);
+        }
+        
+        out.clear();
+        uint64_t primary_sequence = log_->last_sequence();
+        if (batch.empty()) {
+            at = out.begin_frame(0, RpcOp::REPL_HEARTBEAT);
+            out.put_le<uint64_t>(primary_sequence);
+            out.end_frame(at);
+        }
+        for (size_t i = 0; i < batch.size(); i += options_.batch_records) {
+            size_t n = std::min(options_.batch_records, batch.size() - i);
+            at = out.begin_frame(0, RpcOp::REPL_CHANGES);
+            out.put_le<uint64_t>(primary_sequence);
+            out.put_le<uint32_t>(static_cast<uint32_t>(n));
+            for (size_t j = i; j < i + n; j++) ReplicationCodec::write_change(out, batch[j]);
+            out.end_frame(at);
+        }
+        batch.clear();
+        if (!detail::replication_send(fd, out.data()) || !read_acks(*follower, in)) return false;
+    }
+}
+
+/// Take the follower's acknowledgements; false once it has hung up
+inline bool ReplicationPrimary::read_acks(Follower& follower, std::string& in) {
+    char buf[4096];
+    while (true) {
+        ssize_t n = ::recv(follower.fd, buf, sizeof(buf), MSG_DONTWAIT);
+        if (n > 0) {
+            in.append(buf, static_cast<size_t>(n));
+            continue;
+        }
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        return false;
+    }
+    size_t used = 0;
+    while (true) {
+        size_t size = rpc_frame_size(std::string_view(in).substr(used));
+        if (size == RPC_BAD_FRAME) return false;
+        if (size == 0) break;
+        RpcFrame frame = rpc_decode_frame(std::string_view(in).substr(used, size));
+        used += size;
+        RpcReader r(frame.payload);
+        uint64_t acked = r.get_le<uint64_t>();
+        if (frame.op == RpcOp::REPL_ACK && r.ok()) follower.acked.store(acked, std::memory_order_relaxed);
+    }
+    in.erase(0, used);
+    return true;
+}
+
+// ============================================================================
+// Follower Implementation
+// ============================================================================
+
+inline OperationResult ReplicationFollower::start(const ReplicationFollowerOptions& options) {
+    if (options.primary_socket.empty()) {
+        return OperationResult::err(TMSError::INVALID_PARAMETER, "No primary replication socket given");
+    }
+    if (is_promoted()) return OperationResult::err(TMSError::INVALID_STATE, "Promoted; no longer a follower");
+    if (thread_.joinable()) return OperationResult::err(TMSError::INVALID_STATE, "Already following");
+    options_ = options;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        status_.primary = options_.primary_socket;
+    }
+    stopping_.store(false);
+    thread_ = std::thread([this] { run(); });
+    return OperationResult::ok();
+}
+
+inline void ReplicationFollower::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_.store(true);
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) thread_.join();
+}
+
+inline OperationResult ReplicationFollower::promote() {
+    stop();
+    std::vector<RpcServer*> servers;
+    uint64_t applied;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (status_.role == ReplicationRole::PRIMARY) return OperationResult::ok();
+        status_.role = ReplicationRole::PRIMARY;
+        status_.connected = false;
+        servers = servers_;
+        applied = status_.applied_sequence;
+    }
+    for (RpcServer* server : servers) server->set_read_only(false);
+    TMS_LOG_INFO("Replication", "Promoted after applying change " + std::to_string(applied));
+    return OperationResult::ok();
+}
+
+inline bool ReplicationFollower::is_promoted() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return status_.role == ReplicationRole::PRIMARY;
+}
+
+inline ReplicationStatus ReplicationFollower::status() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ReplicationStatus s = status_;
+    s.lag_records = s.primary_sequence > s.applied_sequence ? s.primary_sequence - s.applied_sequence : 0;
+    if (last_contact_) {
+        s.since_contact_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - *last_contact_).count();
+    }
+    return s;
+}
+
+inline bool ReplicationFollower::wait_for(uint64_t sequence, std::chrono::milliseconds timeout) const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return cv_.wait_for(lock, timeout, [&] {
+        return !status_.log_id.empty() && status_.applied_sequence >= sequence;
+    });
+}
+
+inline void ReplicationFollower::attach(RpcServer& server) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        servers_.push_back(&server);
+        server.set_read_only(status_.role == ReplicationRole::FOLLOWER);
+    }
+    server.handle(RpcOp::PROMOTE, [this](RpcReader&, RpcWriter&) { return promote(); });
+    server.handle(RpcOp::REPLICATION_STATUS, [this](RpcReader&, RpcWriter& out) {
+        ReplicationCodec::write_status(out, status());
+        return OperationResult::ok();
+    });
+}
+
+inline void ReplicationFollower::run() {
+    bool connected_before = false;
+    while (!stopping_.load()) {
+        RpcClient client;
+        if (client.connect_unix(options_.primary_socket)) {
+            if (connected_before) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                status_.reconnects++;
+            }
+            connected_before = true;
+            follow(client);
+        }
+        std::unique_lock<std::mutex> lock(mutex_);
+        status_.connected = false;
+        cv_.wait_for(lock, options_.retry_interval, [this] { return stopping_.load(); });
+    }
+}
+
+inline void ReplicationFollower::acknowledge(RpcClient& client, uint64_t sequence) {
+    client.notify(RpcOp::REPL_ACK, [sequence](RpcWriter& w) { w.put_le<uint64_t>(sequence); });
+}
+
+inline void ReplicationFollower::follow(RpcClient& client) {
+    using Clock = std::chrono::steady_clock;
+    std::string log_id;
+    uint64_t next;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        log_id = status_.log_id;
+        next = log_id.empty() ? 0 : status_.applied_sequence + 1;
+    }
+    client.set_receive_timeout(options_.timeout);
+    auto reply = client.call(RpcOp::REPLICATE, [&](RpcWriter& w) {
+        w.put_string(log_id);
+        w.put_le<uint64_t>(next);
+    });
+    if (!reply || !reply.value().is_success()) {
+        TMS_LOG_WARNING("Replication", "Primary refused to replicate: " +
+                        (reply ? reply.value().message() : reply.error().message));
+        return;
+    }
+    RpcReader hello(reply.value().payload);
+    std::string primary_log(hello.get_string());
+    uint64_t primary_sequence = hello.get_le<uint64_t>();
+    hello.get_bool();
+    if (!hello.ok()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        status_.connected = true;
+        status_.primary_sequence = primary_sequence;
+        last_contact_ = Clock::now();
+    }
+    
+    // Short waits so stop() is prompt; silence is timed separately
+    client.set_receive_timeout(std::chrono::milliseconds(100));
+    Clock::time_point contact = Clock::now();
+    CatalogSnapshot image;
+    std::vector<ChangeRecord> changes;
+    while (!stopping_.load()) {
+        auto frame = client.receive_stream();
+        if (!frame) {
+            if (frame.error_code() == TMSError::OPERATION_TIMEOUT && Clock::now() - contact < options_.timeout) continue;
+            TMS_LOG_WARNING("Replication", "Replication stream lost: " + frame.error().message);
+            return;
+        }
+        contact = Clock::now();
+        RpcReader r(frame.value().payload);
+        uint64_t applied = 0;
+        
+        if (frame.value().op == RpcOp::REPL_SNAPSHOT) {
+            uint64_t sequence = r.get_le<uint64_t>();
+            uint32_t volumes = r.get_count(1);
+            for (uint32_t i = 0; i < volumes && r.ok(); i++) image.volumes.push_back(ReplicationCodec::read_volume(r));
+            uint32_t datasets = r.get_count(1);
+            for (uint32_t i = 0; i < datasets && r.ok(); i++) image.datasets.push_back(ReplicationCodec::read_dataset(r));
+            bool last = r.get_bool();
+            if (!r.ok()) break;
+            if (last) {
+                image.sequence = sequence;
+                system_.install_replica_snapshot(std::move(image));
+                image = CatalogSnapshot();
+                std::lock_guard<std::mutex> lock(mutex_);
+                status_.log_id = primary_log;
+                status_.applied_sequence = applied = sequence;
+                status_.snapshots++;
+            }
+        } else if (frame.value().op == RpcOp::REPL_CHANGES) {
+            primary_sequence = r.get_le<uint64_t>();
+            uint32_t count = r.get_count(1);
+            changes.clear();
+            for (uint32_t i = 0; i < count && r.ok(); i++) changes.push_back(ReplicationCodec::read_change(r));
+            if (!r.ok()) break;
+            
+            // Changes already applied are skipped; a gap means the primary
+            // no longer had what this follower needed
+            uint64_t through;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                through = status_.applied_sequence;
+            }
+            changes.erase(changes.begin(), std::find_if(changes.begin(), changes.end(),
+                [through](const ChangeRecord& c) { return c.sequence > through; }));
+            if (!changes.empty() && changes.front().sequence != through + 1) {
+                TMS_LOG_WARNING("Replication", "Gap after change " + std::to_string(through) + "; resyncing");
+                std::lock_guard<std::mutex> lock(mutex_);
+                status_.log_id.clear();
+                return;
+            }
+            // The primary replaced its catalog (a reload): apply what came
+            // before, then start over from a snapshot
+            auto marker = std::find_if(changes.begin(), changes.end(),
+                [](const ChangeRecord& c) { return c.operation == ChangeOperation::RESYNC; });
+            bool resync = marker != changes.end();
+            changes.erase(marker, changes.end());
+            if (!changes.empty()) {
+                system_.apply_replicated_changes(changes);
+                auto committed = changes.back().timestamp;
+                std::lock_guard<std::mutex> lock(mutex_);
+                status_.applied_sequence = applied = changes.back().sequence;
+                status_.records_applied += changes.size();
+                status_.apply_lag_ms = std::max<int64_t>(0, std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::system_clock::now() - committed).count());
+            }
+            if (resync) {
+                TMS_LOG_INFO("Replication", "Primary reloaded its catalog; resyncing");
+                std::lock_guard<std::mutex> lock(mutex_);
+                status_.log_id.clear();
+                return;
+            }
+        } else if (frame.value().op == RpcOp::REPL_HEARTBEAT) {
+            primary_sequence = r.get_le<uint64_t>();
+        }
+        
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            status_.primary_sequence = std::max(primary_sequence, status_.applied_sequence);
+            last_contact_ = contact;
+        }
+        if (applied > 0) {
+            cv_.notify_all();
+            acknowledge(client, applied);
+        }
+    }
+    if (!stopping_.load()) TMS_LOG_WARNING("Replication", "Malformed replication frame; reconnecting");
+}
+
+#endif // TMS_HAS_RPC
+
+} // namespace tms
+
+#endif // TMS_REPLICATION_H
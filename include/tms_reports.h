@@ -8,6 +8,11 @@
  *
  * Provides multi-format report generation (Text, HTML, Markdown)
  * for volumes, datasets, pools, and system statistics.
+ *
+ * v3.4.0: Volume and dataset reports stream rows from a cursor to a
+ * ReportSink (file, stream, string or callback) through a bounded
+ * buffer; HTML reports can be paginated within one document or
+ * across files.
  */
 
 #ifndef TMS_REPORTS_H
@@ -21,6 +26,14 @@
 #include <iomanip>
 #include <fstream>
 #include <functional>
+#include <string_view>
+#include <memory>
+#include <optional>
+#include <charconv>
+#include <map>
+#include <mutex>
+#include <algorithm>
+#include <cstdio>
 
 namespace tms {
 
@@ -72,6 +85,185 @@ struct ReportOptions {
     std::string filter_owner;
     std::string filter_pool;
     std::optional<VolumeStatus> filter_status;
+    size_t page_rows = 0;  // v3.4.0: HTML rows per page (0 = single page)
+};
+
+// ============================================================================
+// v3.4.0: Report Sinks
+// ============================================================================
+
+/**
+ * @brief Destination for streamed report output
+ */
+class ReportSink {
+public:
+    virtual ~ReportSink() = default;
+    virtual void write(std::string_view data) = 0;
+    virtual void flush() {}
+    virtual bool good() const { return true; }
+};
+
+/**
+ * @brief Writes to an existing stream (std::cout, files, string streams)
+ */
+class StreamReportSink final : public ReportSink {
+public:
+    explicit StreamReportSink(std::ostream& os) : os_(os) {}
+    void write(std::string_view data) override { os_.write(data.data(), static_cast<std::streamsize>(data.size())); }
+    void flush() override { os_.flush(); }
+    bool good() const override { return os_.good(); }
+    
+private:
+    std::ostream& os_;
+};
+
+/**
+ * @brief Writes to a file it owns
+ */
+class FileReportSink final : public ReportSink {
+public:
+    explicit FileReportSink(const std::string& path) : file_(path, std::ios::binary) {}
+    bool is_open() const { return file_.is_open(); }
+    void write(std::string_view data) override { file_.write(data.data(), static_cast<std::streamsize>(data.size())); }
+    void flush() override { file_.flush(); }
+    bool good() const override { return file_.good(); }
+    
+private:
+    std::ofstream file_;
+};
+
+/**
+ * @brief Collects output in memory (used by the string-returning API)
+ */
+class StringReportSink final : public ReportSink {
+public:
+    void write(std::string_view data) override { data_.append(data.data(), data.size()); }
+    const std::string& str() const { return data_; }
+    std::string take() { return std::move(data_); }
+    
+private:
+    std::string data_;
+};
+
+/**
+ * @brief Hands each chunk to a callback, e.g. a socket or pipe writer
+ *
+ * The callback returns false to signal a write failure; the report
+ * writer then stops producing rows.
+ */
+class CallbackReportSink final : public ReportSink {
+public:
+    using WriteFn = std::function<bool(std::string_view data)>;
+    explicit CallbackReportSink(WriteFn fn) : fn_(std::move(fn)) {}
+    void write(std::string_view data) override { if (good_) good_ = fn_(data); }
+    bool good() const override { return good_; }
+    
+private:
+    WriteFn fn_;
+    bool good_ = true;
+};
+
+/**
+ * @brief Supplies the sink for each page of a paginated HTML report
+ */
+class ReportPager {
+public:
+    virtual ~ReportPager() = default;
+    /// Sink for 1-based @p page; the previous page is complete. nullptr on failure.
+    virtual ReportSink* open_page(size_t page) = 0;
+    /// href for @p page in navigation links
+    virtual std::string page_link(size_t page) const = 0;
+    /// True when every page is a standalone document
+    virtual bool separate_pages() const = 0;
+};
+
+/**
+ * @brief All pages in one document, linked by anchors
+ */
+class SingleSinkPager final : public ReportPager {
+public:
+    explicit SingleSinkPager(ReportSink& sink) : sink_(sink) {}
+    ReportSink* open_page(size_t) override { return &sink_; }
+    std::string page_link(size_t page) const override { return "#page-" + std::to_string(page); }
+    bool separate_pages() const override { return false; }
+    
+private:
+    ReportSink& sink_;
+};
+
+/**
+ * @brief One file per page: report.html, report_2.html, report_3.html, ...
+ */
+class FileReportPager final : public ReportPager {
+public:
+    explicit FileReportPager(std::string base_path) : base_path_(std::move(base_path)) {}
+    ReportSink* open_page(size_t page) override;
+    std::string page_link(size_t page) const override;
+    bool separate_pages() const override { return true; }
+    
+    std::string page_path(size_t page) const;
+    size_t page_count() const { return pages_; }
+    
+private:
+    std::string base_path_;
+    std::unique_ptr<FileReportSink> current_;
+    size_t pages_ = 0;
+};
+
+// ============================================================================
+// v3.4.0: Streaming Table Writer
+// ============================================================================
+
+/**
+ * @brief Report table column
+ */
+struct ReportColumn {
+    std::string_view header;
+    int width = 0;   ///< TEXT column width
+};
+
+/**
+ * @brief Formats table rows into one reusable buffer and streams it out
+ *
+ * Output is handed to the sink whenever the buffer passes FLUSH_BYTES,
+ * so memory stays bounded regardless of row count. For HTML with
+ * options.page_rows set, the table is split into pages with navigation
+ * links, either within one document or across files (see ReportPager).
+ */
+class ReportTableWriter {
+public:
+    static constexpr size_t FLUSH_BYTES = 64 * 1024;
+    
+    ReportTableWriter(ReportPager& pager, ReportFormat format,
+                      std::vector<ReportColumn> columns, const ReportOptions& options);
+    
+    void begin(const std::string& title);
+    void row(std::initializer_list<std::string_view> cells);
+    /// Write the summary ("Total: N <noun>") and footer; returns rows written
+    size_t end(const std::string& noun);
+    
+    size_t rows() const { return rows_; }
+    bool good() const { return sink_ != nullptr && sink_->good(); }
+    
+private:
+    void open_page();
+    void close_page(bool more);
+    void flush();
+    void put_cell(std::string_view cell, size_t index);
+    void put_html(std::string_view text);
+    void put_csv(std::string_view text);
+    
+    ReportPager& pager_;
+    ReportSink* sink_ = nullptr;
+    ReportFormat format_;
+    std::vector<ReportColumn> columns_;
+    const ReportOptions& options_;
+    std::string title_;
+    std::string buffer_;
+    size_t rows_ = 0;
+    size_t page_ = 0;
+    size_t page_fill_ = 0;
+    bool paged_ = false;
 };
 
 // ============================================================================
@@ -139,7 +331,35 @@ public:
     // File output
     bool write_to_file(const std::string& content, const std::string& path);
     
+    // v3.4.0: Streaming reports - rows are pulled from a cursor (nullptr
+    // ends the stream) and written to the sink in bounded chunks
+    using VolumeCursor = std::function<const TapeVolume*()>;
+    using DatasetCursor = std::function<const Dataset*()>;
+    
+    size_t write_volume_report(ReportSink& sink, const VolumeCursor& next,
+                               ReportFormat format,
+                               const ReportOptions& options = ReportOptions{});
+    size_t write_volume_report(ReportPager& pager, const VolumeCursor& next,
+                               ReportFormat format,
+                               const ReportOptions& options = ReportOptions{});
+    size_t write_dataset_report(ReportSink& sink, const DatasetCursor& next,
+                                ReportFormat format,
+                                const ReportOptions& options = ReportOptions{});
+    size_t write_dataset_report(ReportPager& pager, const DatasetCursor& next,
+                                ReportFormat format,
+                                const ReportOptions& options = ReportOptions{});
+    
+    /// Cursor over an in-memory list
+    template<typename Record>
+    static std::function<const Record*()> cursor_over(const std::vector<Record>& records) {
+        return [it = records.begin(), end = records.end()]() mutable -> const Record* {
+            return it == end ? nullptr : &*it++;
+        };
+    }
+    
 private:
+    friend class ReportTableWriter;
+    
     // Format helpers
     std::string text_header(const std::string& title, char underline = '=');
     std::string text_table_row(const std::vector<std::string>& cols,
@@ -159,10 +379,74 @@ private:
     
     std::string csv_row(const std::vector<std::string>& cols);
     std::string csv_escape(const std::string& str);
+    std::string format_percent(double value);
     
     std::string get_css_styles();
 };
 
+// ============================================================================
+// v3.4.0: Report Cache
+// ============================================================================
+
+/**
+ * @brief Report cache counters
+ */
+struct ReportCacheStats {
+    size_t hits = 0;
+    size_t misses = 0;       ///< Not cached, or built at an older catalog generation
+    size_t expired = 0;      ///< Current generation but older than its max age
+    size_t entries = 0;
+};
+
+/**
+ * @brief Materialized reports keyed by type, format and options
+ *
+ * Each entry records the catalog generation it was built from; the
+ * owner bumps that generation on every catalog write, so an entry is
+ * served only while nothing it could depend on has changed. Reports
+ * that depend on the clock, or print when they were generated, are
+ * stored with a max age as well. Entries are shared, so a hit never copies the report.
+ */
+class ReportCache {
+public:
+    using Content = std::shared_ptr<const std::string>;
+    
+    explicit ReportCache(size_t max_entries = 64) : max_entries_(max_entries) {}
+    
+    static std::string make_key(ReportType type, ReportFormat format,
+                                const ReportOptions& options = ReportOptions{});
+    
+    /// Entry for @p key if it was built at @p generation and is fresh
+    Content find(const std::string& key, uint64_t generation);
+    /// Store (replacing any older entry); max_age of zero means until invalidated
+    Content store(const std::string& key, uint64_t generation, std::string content,
+                  std::chrono::seconds max_age = std::chrono::seconds(0));
+    
+    /// Cached entry, or the result of @p build stored at @p generation
+    template<typename Build>
+    Content get_or_build(const std::string& key, uint64_t generation,
+                         std::chrono::seconds max_age, Build&& build) {
+        if (auto hit = find(key, generation)) return hit;
+        return store(key, generation, build(), max_age);
+    }
+    
+    void clear();
+    ReportCacheStats stats() const;
+    
+private:
+    struct Entry {
+        Content content;
+        uint64_t generation = 0;
+        std::chrono::system_clock::time_point built;    ///< Catalog clock, so simulated time expires entries
+        std::chrono::seconds max_age{0};
+    };
+    
+    mutable std::mutex mutex_;
+    std::map<std::string, Entry> entries_;
+    size_t max_entries_;
+    ReportCacheStats stats_;
+};
+
 // ============================================================================
 // Implementation
 // ============================================================================
@@ -172,130 +456,248 @@ inline std::string ReportGenerator::generate_volume_report(
     ReportFormat format,
     const ReportOptions& options) {
     
-    std::ostringstream oss;
-    std::string title = options.title.empty() ? "Volume Report" : options.title;
+    StringReportSink sink;
+    write_volume_report(sink, cursor_over(volumes), format, options);
+    return sink.take();
+}
+
+inline std::string ReportGenerator::generate_dataset_report(
+    const std::vector<Dataset>& datasets,
+    ReportFormat format,
+    const ReportOptions& options) {
     
+    StringReportSink sink;
+    write_dataset_report(sink, cursor_over(datasets), format, options);
+    return sink.take();
+}
+
+inline std::string ReportGenerator::generate_pool_report(
+    const std::vector<PoolStatistics>& pools,
+    ReportFormat format,
+    const ReportOptions& options) {
+    
+    StringReportSink sink;
+    SingleSinkPager pager(sink);
+    ReportTableWriter writer(pager, format,
+        {{"Pool", 12}, {"Volumes", 9}, {"Scratch", 9}, {"Private", 9}, {"Mounted", 9},
+         {"Reserved", 10}, {"Capacity", 12}, {"Used", 12}, {"Util%", 7}}, options);
+    writer.begin(options.title.empty() ? "Pool Report" : options.title);
+    
+    for (const auto& pool : pools) {
+        if (options.max_rows > 0 && writer.rows() >= static_cast<size_t>(options.max_rows)) break;
+        if (!options.filter_pool.empty() && pool.pool_name != options.filter_pool) continue;
+        writer.row({pool.pool_name,
+                    std::to_string(pool.total_volumes),
+                    std::to_string(pool.scratch_volumes),
+                    std::to_string(pool.private_volumes),
+                    std::to_string(pool.mounted_volumes),
+                    std::to_string(pool.reserved_volumes),
+                    format_bytes(pool.total_capacity),
+                    format_bytes(pool.used_capacity),
+                    format_percent(pool.get_utilization())});
+    }
+    
+    writer.end("pools");
+    return sink.take();
+}
+
+inline std::string ReportGenerator::generate_expiration_report(
+    const std::vector<TapeVolume>& volumes,
+    const std::vector<Dataset>& datasets,
+    ReportFormat format,
+    std::chrono::hours lookahead) {
+    
+    struct Entry {
+        std::chrono::system_clock::time_point expires;
+        const char* type;
+        const std::string* name;
+        const char* state;
+    };
+    
+    auto now = current_time();
+    auto threshold = now + lookahead;
+    std::vector<Entry> entries;
+    for (const auto& vol : volumes) {
+        if (vol.status == VolumeStatus::EXPIRED) {
+            entries.push_back({vol.expiration_date, "VOL", &vol.volser, "EXPIRED"});
+        } else if (vol.expiration_date > now && vol.expiration_date <= threshold) {
+            entries.push_back({vol.expiration_date, "VOL", &vol.volser, "EXPIRING"});
+        }
+    }
+    for (const auto& ds : datasets) {
+        if (ds.status == DatasetStatus::EXPIRED) {
+            entries.push_back({ds.expiration_date, "DS", &ds.name, "EXPIRED"});
+        } else if (ds.expiration_date > now && ds.expiration_date <= threshold) {
+            entries.push_back({ds.expiration_date, "DS", &ds.name, "EXPIRING"});
+        }
+    }
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return a.expires != b.expires ? a.expires < b.expires : *a.name < *b.name;
+    });
+    
+    ReportOptions options;
+    StringReportSink sink;
+    SingleSinkPager pager(sink);
+    ReportTableWriter writer(pager, format,
+        {{"Type", 6}, {"Name", 44}, {"State", 10}, {"Expires", 20}}, options);
+    writer.begin("Expiration Report");
+    
+    char expires[TimestampCodec::TEXT_LENGTH];
+    for (const auto& entry : entries) {
+        TimestampCodec::format(entry.expires, expires);
+        writer.row({entry.type, *entry.name, entry.state,
+                    std::string_view(expires, TimestampCodec::TEXT_LENGTH)});
+    }
+    
+    writer.end("entries");
+    return sink.take();
+}
+
+inline std::string ReportGenerator::generate_capacity_report(
+    const std::vector<TapeVolume>& volumes,
+    ReportFormat format) {
+    
+    // Fullest volumes first
+    std::vector<const TapeVolume*> sorted;
+    sorted.reserve(volumes.size());
+    for (const auto& vol : volumes) sorted.push_back(&vol);
+    std::sort(sorted.begin(), sorted.end(), [](const TapeVolume* a, const TapeVolume* b) {
+        double ua = a->get_usage_percent(), ub = b->get_usage_percent();
+        return ua != ub ? ua > ub : a->volser < b->volser;
+    });
+    
+    ReportOptions options;
+    StringReportSink sink;
+    SingleSinkPager pager(sink);
+    ReportTableWriter writer(pager, format,
+        {{"Volser", 8}, {"Pool", 12}, {"Capacity", 12}, {"Used", 12}, {"Util%", 7}}, options);
+    writer.begin("Capacity Report");
+    
+    for (const TapeVolume* vol : sorted) {
+        writer.row({vol->volser, vol->pool.view(), format_bytes(vol->capacity_bytes),
+                    format_bytes(vol->used_bytes), format_percent(vol->get_usage_percent())});
+    }
+    
+    writer.end("volumes");
+    return sink.take();
+}
+
+inline size_t ReportGenerator::write_volume_report(ReportSink& sink, const VolumeCursor& next,
+                                                   ReportFormat format, const ReportOptions& options) {
+    SingleSinkPager pager(sink);
+    return write_volume_report(pager, next, format, options);
+}
+
+inline size_t ReportGenerator::write_volume_report(ReportPager& pager, const VolumeCursor& next,
+                                                   ReportFormat format, const ReportOptions& options) {
+    std::vector<ReportColumn> columns;
     switch (format) {
-        case ReportFormat::TEXT: {
-            oss << text_header(title);
-            if (options.include_timestamp) {
-                oss << "Generated: " << get_timestamp() << "\n\n";
-            }
-            
-            std::vector<int> widths = {8, 10, 10, 12, 10, 12};
-            oss << text_table_row({"Volser", "Status", "Density", "Pool", "Owner", "Used"}, widths);
-            oss << text_separator(widths);
-            
-            int count = 0;
-            for (const auto& vol : volumes) {
-                if (options.max_rows > 0 && count >= options.max_rows) break;
-                if (!options.filter_owner.empty() && vol.owner != options.filter_owner) continue;
-                if (!options.filter_pool.empty() && vol.pool != options.filter_pool) continue;
-                if (options.filter_status && vol.status != *options.filter_status) continue;
-                
-                oss << text_table_row({
-                    vol.volser,
-                    volume_status_to_string(vol.status),
-                    density_to_string(vol.density),
-                    vol.pool,
-                    vol.owner,
-                    format_bytes(vol.used_bytes)
-                }, widths);
-                count++;
-            }
-            
-            if (options.include_summary) {
-                oss << "\nTotal: " << count << " volumes\n";
-            }
+        case ReportFormat::CSV:
+            columns = {{"Volser"}, {"Status"}, {"Density"}, {"Location"}, {"Pool"}, {"Owner"},
+                       {"MountCount"}, {"Capacity"}, {"Used"}, {"Created"}, {"Expires"}};
             break;
-        }
-        
-        case ReportFormat::HTML: {
-            oss << html_header(title, options.css_class);
-            if (options.include_timestamp) {
-                oss << "<p class=\"timestamp\">Generated: " << get_timestamp() << "</p>\n";
-            }
-            
-            oss << html_table_start({"Volser", "Status", "Density", "Pool", "Owner", "Used", "Datasets"});
-            
-            int count = 0;
-            for (const auto& vol : volumes) {
-                if (options.max_rows > 0 && count >= options.max_rows) break;
-                if (!options.filter_owner.empty() && vol.owner != options.filter_owner) continue;
-                
-                oss << html_table_row({
-                    vol.volser,
-                    volume_status_to_string(vol.status),
-                    density_to_string(vol.density),
-                    vol.pool,
-                    vol.owner,
-                    format_bytes(vol.used_bytes),
-                    std::to_string(vol.datasets.size())
-                });
-                count++;
-            }
-            
-            oss << html_table_end();
-            if (options.include_summary) {
-                oss << "<p class=\"summary\">Total: " << count << " volumes</p>\n";
-            }
-            oss << html_footer();
+        case ReportFormat::HTML:
+            columns = {{"Volser"}, {"Status"}, {"Density"}, {"Pool"}, {"Owner"}, {"Used"}, {"Datasets"}};
             break;
-        }
-        
-        case ReportFormat::MARKDOWN: {
-            oss << md_header(title);
-            if (options.include_timestamp) {
-                oss << "*Generated: " << get_timestamp() << "*\n\n";
-            }
-            
-            oss << md_table_header({"Volser", "Status", "Density", "Pool", "Owner", "Used"});
-            
-            int count = 0;
-            for (const auto& vol : volumes) {
-                if (options.max_rows > 0 && count >= options.max_rows) break;
-                
-                oss << md_table_row({
-                    vol.volser,
-                    volume_status_to_string(vol.status),
-                    density_to_string(vol.density),
-                    vol.pool,
-                    vol.owner,
-                    format_bytes(vol.used_bytes)
-                });
-                count++;
-            }
-            
-            if (options.include_summary) {
-                oss << "\n**Total:** " << count << " volumes\n";
-            }
+        default:
+            columns = {{"Volser", 8}, {"Status", 10}, {"Density", 10}, {"Pool", 12},
+                       {"Owner", 10}, {"Used", 12}};
             break;
+    }
+    
+    ReportTableWriter writer(pager, format, std::move(columns), options);
+    writer.begin(options.title.empty() ? "Volume Report" : options.title);
+    
+    char mounts[24], capacity[24], used[24], datasets[24];
+    char created[TimestampCodec::TEXT_LENGTH], expires[TimestampCodec::TEXT_LENGTH];
+    auto num = [](char* buf, size_t cap, auto value) {
+        return std::string_view(buf, static_cast<size_t>(std::to_chars(buf, buf + cap, value).ptr - buf));
+    };
+    auto stamp = [](char* buf, std::chrono::system_clock::time_point tp) {
+        TimestampCodec::format(tp, buf);
+        return std::string_view(buf, TimestampCodec::TEXT_LENGTH);
+    };
+    
+    while (const TapeVolume* vol = next()) {
+        if (options.max_rows > 0 && writer.rows() >= static_cast<size_t>(options.max_rows)) break;
+        if (!writer.good()) break;
+        if (!options.filter_owner.empty() && vol->owner != options.filter_owner) continue;
+        if (!options.filter_pool.empty() && vol->pool != options.filter_pool) continue;
+        if (options.filter_status && vol->status != *options.filter_status) continue;
+        
+        std::string status = volume_status_to_string(vol->status);
+        std::string density = density_to_string(vol->density);
+        switch (format) {
+            case ReportFormat::CSV:
+                writer.row({vol->volser, status, density, vol->location.view(), vol->pool.view(),
+                            vol->owner.view(),
+                            num(mounts, sizeof(mounts), vol->mount_count),
+                            num(capacity, sizeof(capacity), vol->capacity_bytes),
+                            num(used, sizeof(used), vol->used_bytes),
+                            stamp(created, vol->creation_date),
+                            stamp(expires, vol->expiration_date)});
+                break;
+            case ReportFormat::HTML:
+                writer.row({vol->volser, status, density, vol->pool.view(), vol->owner.view(),
+                            format_bytes(vol->used_bytes),
+                            num(datasets, sizeof(datasets), vol->datasets.size())});
+                break;
+            default:
+                writer.row({vol->volser, status, density, vol->pool.view(), vol->owner.view(),
+                            format_bytes(vol->used_bytes)});
+                break;
         }
+    }
+    
+    return writer.end("volumes");
+}
+
+inline size_t ReportGenerator::write_dataset_report(ReportSink& sink, const DatasetCursor& next,
+                                                    ReportFormat format, const ReportOptions& options) {
+    SingleSinkPager pager(sink);
+    return write_dataset_report(pager, next, format, options);
+}
+
+inline size_t ReportGenerator::write_dataset_report(ReportPager& pager, const DatasetCursor& next,
+                                                    ReportFormat format, const ReportOptions& options) {
+    std::vector<ReportColumn> columns;
+    if (format == ReportFormat::CSV) {
+        columns = {{"Name"}, {"Volser"}, {"Status"}, {"Size"}, {"Owner"}, {"JobName"},
+                   {"FileSeq"}, {"Created"}, {"Expires"}};
+    } else {
+        columns = {{"Name", 44}, {"Volser", 8}, {"Status", 10}, {"Size", 12}, {"Owner", 10}};
+    }
+    
+    ReportTableWriter writer(pager, format, std::move(columns), options);
+    writer.begin(options.title.empty() ? "Dataset Report" : options.title);
+    
+    char size[24], seq[24];
+    char created[TimestampCodec::TEXT_LENGTH], expires[TimestampCodec::TEXT_LENGTH];
+    auto num = [](char* buf, size_t cap, auto value) {
+        return std::string_view(buf, static_cast<size_t>(std::to_chars(buf, buf + cap, value).ptr - buf));
+    };
+    auto stamp = [](char* buf, std::chrono::system_clock::time_point tp) {
+        TimestampCodec::format(tp, buf);
+        return std::string_view(buf, TimestampCodec::TEXT_LENGTH);
+    };
+    
+    while (const Dataset* ds = next()) {
+        if (options.max_rows > 0 && writer.rows() >= static_cast<size_t>(options.max_rows)) break;
+        if (!writer.good()) break;
+        if (!options.filter_owner.empty() && ds->owner != options.filter_owner) continue;
         
-        case ReportFormat::CSV: {
-            oss << csv_row({"Volser", "Status", "Density", "Location", "Pool", "Owner",
-                            "MountCount", "Capacity", "Used", "Created", "Expires"});
-            
-            for (const auto& vol : volumes) {
-                oss << csv_row({
-                    vol.volser,
-                    volume_status_to_string(vol.status),
-                    density_to_string(vol.density),
-                    vol.location,
-                    vol.pool,
-                    vol.owner,
-                    std::to_string(vol.mount_count),
-                    std::to_string(vol.capacity_bytes),
-                    std::to_string(vol.used_bytes),
-                    format_time(vol.creation_date),
-                    format_time(vol.expiration_date)
-                });
-            }
-            break;
+        std::string status = dataset_status_to_string(ds->status);
+        if (format == ReportFormat::CSV) {
+            writer.row({ds->name, ds->volser, status, num(size, sizeof(size), ds->size_bytes),
+                        ds->owner.view(), ds->job_name.view(), num(seq, sizeof(seq), ds->file_sequence),
+                        stamp(created, ds->creation_date),
+                        stamp(expires, ds->expiration_date)});
+        } else {
+            writer.row({ds->name, ds->volser, status, format_bytes(ds->size_bytes), ds->owner.view()});
         }
     }
     
-    return oss.str();
+    return writer.end("datasets");
 }
 
 inline std::string ReportGenerator::generate_statistics_report(
@@ -611,6 +1013,12 @@ inline std::string ReportGenerator::csv_escape(const std::string& str) {
     return oss.str();
 }
 
+inline std::string ReportGenerator::format_percent(double value) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.1f", value);
+    return buf;
+}
+
 inline bool ReportGenerator::write_to_file(const std::string& content, const std::string& path) {
     std::ofstream file(path);
     if (!file.is_open()) return false;
@@ -639,9 +1047,324 @@ h2, h3 { color: #555; }
 .status.unhealthy { background: #f8d7da; color: #721c24; }
 .errors { background: #fff3cd; padding: 15px; border-radius: 8px; margin: 10px 0; }
 .warnings { background: #fff3cd; padding: 15px; border-radius: 8px; margin: 10px 0; }
+.pager { text-align: center; margin: 10px 0; }
 )";
 }
 
+// Streaming table writer
+inline ReportTableWriter::ReportTableWriter(ReportPager& pager, ReportFormat format,
+                                            std::vector<ReportColumn> columns,
+                                            const ReportOptions& options)
+    : pager_(pager), format_(format), columns_(std::move(columns)), options_(options),
+      paged_(format == ReportFormat::HTML && options.page_rows > 0) {
+    buffer_.reserve(FLUSH_BYTES + 1024);
+}
+
+inline void ReportTableWriter::begin(const std::string& title) {
+    title_ = title;
+    open_page();
+}
+
+inline void ReportTableWriter::open_page() {
+    page_++;
+    page_fill_ = 0;
+    sink_ = pager_.open_page(page_);
+    if (!sink_) return;
+    
+    ReportGenerator gen;
+    switch (format_) {
+        case ReportFormat::TEXT: {
+            buffer_ += gen.text_header(title_);
+            if (options_.include_timestamp) {
+                buffer_ += "Generated: " + get_timestamp() + "\n\n";
+            }
+            std::vector<int> widths;
+            for (size_t i = 0; i < columns_.size(); i++) {
+                put_cell(columns_[i].header, i);
+                widths.push_back(columns_[i].width);
+            }
+            buffer_ += '\n';
+            buffer_ += gen.text_separator(widths);
+            break;
+        }
+        
+        case ReportFormat::HTML: {
+            if (page_ == 1 || pager_.separate_pages()) {
+                std::string title = page_ > 1 ? title_ + " (page " + std::to_string(page_) + ")" : title_;
+                buffer_ += gen.html_header(title, options_.css_class);
+                if (options_.include_timestamp) {
+                    buffer_ += "<p class=\"timestamp\">Generated: " + get_timestamp() + "</p>\n";
+                }
+            }
+            if (paged_ && !pager_.separate_pages()) {
+                buffer_ += "<h2 id=\"page-" + std::to_string(page_) + "\">Page " +
+                           std::to_string(page_) + "</h2>\n";
+            }
+            buffer_ += "<table class=\"data-table\">\n<thead><tr>\n";
+            for (const auto& column : columns_) {
+                buffer_ += "<th>";
+                put_html(column.header);
+                buffer_ += "</th>\n";
+            }
+            buffer_ += "</tr></thead>\n<tbody>\n";
+            break;
+        }
+        
+        case ReportFormat::MARKDOWN: {
+            buffer_ += gen.md_header(title_);
+            if (options_.include_timestamp) {
+                buffer_ += "*Generated: " + get_timestamp() + "*\n\n";
+            }
+            buffer_ += '|';
+            for (size_t i = 0; i < columns_.size(); i++) put_cell(columns_[i].header, i);
+            buffer_ += "\n|";
+            for (size_t i = 0; i < columns_.size(); i++) buffer_ += "------|";
+            buffer_ += '\n';
+            break;
+        }
+        
+        case ReportFormat::CSV: {
+            for (size_t i = 0; i < columns_.size(); i++) put_cell(columns_[i].header, i);
+            buffer_ += '\n';
+            break;
+        }
+    }
+}
+
+inline void ReportTableWriter::close_page(bool more) {
+    buffer_ += "</tbody>\n</table>\n";
+    if (paged_) {
+        buffer_ += "<p class=\"pager\">";
+        if (page_ > 1) {
+            buffer_ += "<a href=\"" + pager_.page_link(page_ - 1) + "\">&laquo; Previous</a> ";
+        }
+        buffer_ += "Page " + std::to_string(page_);
+        if (more) {
+            buffer_ += " <a href=\"" + pager_.page_link(page_ + 1) + "\">Next &raquo;</a>";
+        }
+        buffer_ += "</p>\n";
+    }
+    if (more) {
+        if (pager_.separate_pages()) buffer_ += ReportGenerator().html_footer();
+        flush();
+    }
+}
+
+inline void ReportTableWriter::row(std::initializer_list<std::string_view> cells) {
+    if (!sink_) return;
+    if (paged_ && page_fill_ == options_.page_rows) {
+        close_page(true);
+        open_page();
+        if (!sink_) return;
+    }
+    
+    if (format_ == ReportFormat::HTML) buffer_ += "<tr>";
+    else if (format_ == ReportFormat::MARKDOWN) buffer_ += '|';
+    size_t index = 0;
+    for (std::string_view cell : cells) put_cell(cell, index++);
+    buffer_ += format_ == ReportFormat::HTML ? "</tr>\n" : "\n";
+    
+    rows_++;
+    page_fill_++;
+    if (buffer_.size() >= FLUSH_BYTES) flush();
+}
+
+inline size_t ReportTableWriter::end(const std::string& noun) {
+    if (!sink_) return rows_;
+    if (format_ == ReportFormat::HTML) close_page(false);
+    
+    if (options_.include_summary) {
+        std::string total = std::to_string(rows_) + " " + noun;
+        switch (format_) {
+            case ReportFormat::TEXT: buffer_ += "\nTotal: " + total + "\n"; break;
+            case ReportFormat::HTML: buffer_ += "<p class=\"summary\">Total: " + total + "</p>\n"; break;
+            case ReportFormat::MARKDOWN: buffer_ += "\n**Total:** " + total + "\n"; break;
+            case ReportFormat::CSV: break;
+        }
+    }
+    if (format_ == ReportFormat::HTML) buffer_ += ReportGenerator().html_footer();
+    
+    flush();
+    sink_->flush();
+    return rows_;
+}
+
+inline void ReportTableWriter::flush() {
+    if (sink_ && !buffer_.empty()) sink_->write(buffer_);
+    buffer_.clear();
+}
+
+inline void ReportTableWriter::put_cell(std::string_view cell, size_t index) {
+    switch (format_) {
+        case ReportFormat::TEXT: {
+            buffer_.append(cell.data(), cell.size());
+            int width = index < columns_.size() ? columns_[index].width : 0;
+            if (cell.size() < static_cast<size_t>(width)) {
+                buffer_.append(static_cast<size_t>(width) - cell.size(), ' ');
+            }
+            break;
+        }
+        case ReportFormat::HTML:
+            buffer_ += "<td>";
+            put_html(cell);
+            buffer_ += "</td>";
+            break;
+        case ReportFormat::MARKDOWN:
+            buffer_ += ' ';
+            for (char c : cell) {
+                if (c == '|') buffer_ += '\\';
+                buffer_ += c;
+            }
+            buffer_ += " |";
+            break;
+        case ReportFormat::CSV:
+            if (index > 0) buffer_ += ',';
+            put_csv(cell);
+            break;
+    }
+}
+
+inline void ReportTableWriter::put_html(std::string_view text) {
+    for (char c : text) {
+        switch (c) {
+            case '&': buffer_ += "&amp;"; break;
+            case '<': buffer_ += "&lt;"; break;
+            case '>': buffer_ += "&gt;"; break;
+            case '"': buffer_ += "&quot;"; break;
+            default: buffer_ += c;
+        }
+    }
+}
+
+inline void ReportTableWriter::put_csv(std::string_view text) {
+    if (text.find_first_of(",\"\r\n") == std::string_view::npos) {
+        buffer_.append(text.data(), text.size());
+        return;
+    }
+    buffer_ += '"';
+    for (char c : text) {
+        if (c == '"') buffer_ += '"';
+        buffer_ += c;
+    }
+    buffer_ += '"';
+}
+
+// File pager
+inline std::string FileReportPager::page_path(size_t page) const {
+    if (page <= 1) return base_path_;
+    size_t slash = base_path_.find_last_of("/\\");
+    size_t dot = base_path_.find_last_of('.');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+        return base_path_ + "_" + std::to_string(page);
+    }
+    return base_path_.substr(0, dot) + "_" + std::to_string(page) + base_path_.substr(dot);
+}
+
+inline std::string FileReportPager::page_link(size_t page) const {
+    std::string path = page_path(page);
+    size_t slash = path.find_last_of("/\\");
+    return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+inline ReportSink* FileReportPager::open_page(size_t page) {
+    current_.reset();
+    auto sink = std::make_unique<FileReportSink>(page_path(page));
+    if (!sink->is_open()) return nullptr;
+    current_ = std::move(sink);
+    pages_ = page;
+    return current_.get();
+}
+
+// Report cache
+inline std::string ReportCache::make_key(ReportType type, ReportFormat format,
+                                         const ReportOptions& options) {
+    const char sep = '\x1f';
+    std::string key;
+    key += std::to_string(static_cast<int>(type));
+    key += sep;
+    key += std::to_string(static_cast<int>(format));
+    key += sep;
+    key += options.title;
+    key += sep;
+    key += options.subtitle;
+    key += sep;
+    key += options.css_class;
+    key += sep;
+    key += options.filter_owner;
+    key += sep;
+    key += options.filter_pool;
+    key += sep;
+    key += options.filter_status ? std::to_string(static_cast<int>(*options.filter_status)) : "-";
+    key += sep;
+    key += std::to_string(options.max_rows);
+    key += sep;
+    key += std::to_string(options.page_rows);
+    key += sep;
+    key += options.include_header ? '1' : '0';
+    key += options.include_footer ? '1' : '0';
+    key += options.include_timestamp ? '1' : '0';
+    key += options.include_summary ? '1' : '0';
+    key += options.include_charts ? '1' : '0';
+    return key;
+}
+
+inline ReportCache::Content ReportCache::find(const std::string& key, uint64_t generation) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it == entries_.end() || it->second.generation != generation) {
+        stats_.misses++;
+        return nullptr;
+    }
+    const Entry& entry = it->second;
+    auto age = current_time() - entry.built;
+    if (entry.max_age.count() > 0 && (age > entry.max_age || age.count() < 0)) {
+        stats_.expired++;
+        return nullptr;
+    }
+    stats_.hits++;
+    return entry.content;
+}
+
+inline ReportCache::Content ReportCache::store(const std::string& key, uint64_t generation,
+                                               std::string content, std::chrono::seconds max_age) {
+    auto shared = std::make_shared<const std::string>(std::move(content));
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    if (entries_.size() >= max_entries_ && entries_.find(key) == entries_.end()) {
+        // Drop entries from older generations first, then the oldest build
+        for (auto it = entries_.begin(); it != entries_.end();) {
+            it = it->second.generation != generation ? entries_.erase(it) : std::next(it);
+        }
+        if (entries_.size() >= max_entries_) {
+            auto oldest = std::min_element(entries_.begin(), entries_.end(),
+                [](const auto& a, const auto& b) { return a.second.built < b.second.built; });
+            entries_.erase(oldest);
+        }
+    }
+    
+    Entry& entry = entries_[key];
+    if (entry.content && entry.generation > generation) {
+        return shared;  // A newer build won the race; keep it
+    }
+    entry.content = shared;
+    entry.generation = generation;
+    entry.built = current_time();
+    entry.max_age = max_age;
+    return shared;
+}
+
+inline void ReportCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+}
+
+inline ReportCacheStats ReportCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ReportCacheStats result = stats_;
+    result.entries = entries_.size();
+    return result;
+}
+
 } // namespace tms
 
 #endif // TMS_REPORTS_H
@@ -95,7 +95,7 @@ struct RetentionPolicy {
     
     /// Check if warning period is active
     bool is_in_warning_period(const std::chrono::system_clock::time_point& expiry) const {
-        auto now = std::chrono::system_clock::now();
+        auto now = current_time();
         auto warning_start = expiry - std::chrono::hours(24 * warning_days);
         return now >= warning_start && now < expiry;
     }
@@ -219,7 +219,7 @@ inline OperationResult RetentionPolicyManager::create_policy(const RetentionPoli
     }
     
     RetentionPolicy p = policy;
-    p.created = std::chrono::system_clock::now();
+    p.created = current_time();
     p.modified = p.created;
     policies_[p.name] = p;
     
@@ -257,7 +257,7 @@ inline OperationResult RetentionPolicyManager::update_policy(const RetentionPoli
     
     RetentionPolicy p = policy;
     p.created = it->second.created;
-    p.modified = std::chrono::system_clock::now();
+    p.modified = current_time();
     it->second = p;
     
     return OperationResult::ok();
@@ -0,0 +1,2109 @@
+/**
+ * @file tms_rpc.h
+ * @brief TMS Tape Management System - Catalog RPC Protocol, Server and Client
+ * @version 3.4.0
+ * @author Bennie Shearer
+ * @copyright Copyright (c) 2025 Bennie Shearer
+ * @license MIT License
+ *
+ * Lets batch jobs share one in-memory catalog: RpcServer exposes a
+ * TMSSystem over a Unix domain socket and/or loopback TCP, and RpcClient
+ * is the matching client. Messages are length-prefixed little-endian
+ * frames. A client may pipeline any number of frames before reading the
+ * responses, and a BATCH frame carries many requests in one round trip.
+ * One epoll thread owns all sockets and hands complete frames to a worker
+ * pool. A connection is served by one worker at a time, so its responses
+ * come back in request order. Each connection is a session: requests run
+ * under its OperationContext, and SET_SESSION names the session's user
+ * and how long a request may wait before it is answered OPERATION_TIMEOUT
+ * unexecuted. The server is Linux-only; the codec builds everywhere.
+ */
+
+#ifndef TMS_RPC_H
+#define TMS_RPC_H
+
+#include "tms_types.h"
+#include "tms_system.h"
+#include "tms_query.h"
+#include "error_codes.h"
+#include "logger.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <map>
+#include <unordered_map>
+#include <memory>
+#include <optional>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <bit>
+#include <type_traits>
+
+#if defined(__linux__)
+    #define TMS_HAS_RPC 1
+    #include <cerrno>
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <netinet/tcp.h>
+    #include <sys/epoll.h>
+    #include <sys/eventfd.h>
+    #include <sys/socket.h>
+    #include <sys/stat.h>
+    #include <sys/time.h>
+    #include <sys/un.h>
+    #include <unistd.h>
+#else
+    #define TMS_HAS_RPC 0
+#endif
+
+namespace tms {
+
+// ============================================================================
+// Protocol
+// ============================================================================
+
+/*
+ * Frame layout (both directions):
+ *
+ *   u32 length     bytes that follow this field (8 + payload)
+ *   u32 id         chosen by the client, echoed in the response
+ *   u16 op         RpcOp; the response carries the request's op
+ *   u16 status     0 in requests; the TMSError code in responses
+ *   ... payload
+ *
+ * A failed response's payload is the error message (string). Strings are
+ * a u32 byte count followed by the bytes, times are i64 microseconds since
+ * the Unix epoch, and lists are a u32 count followed by the items.
+ */
+
+constexpr uint16_t RPC_PROTOCOL_VERSION = 1;
+constexpr size_t RPC_HEADER_BYTES = 12;
+constexpr size_t RPC_MAX_FRAME_BYTES = 16 * 1024 * 1024;
+constexpr size_t RPC_BAD_FRAME = static_cast<size_t>(-1);
+
+/**
+ * @brief Request types (arguments -> success payload)
+ */
+enum class RpcOp : uint16_t {
+    PING = 1,               ///< () -> u16 protocol version
+    VOLUME_EXISTS = 2,      ///< (volser) -> bool
+    GET_VOLUME = 3,         ///< (volser) -> volume
+    ADD_VOLUME = 4,         ///< (volume) -> ()
+    PATCH_VOLUME = 5,       ///< (volser, volume patch) -> ()
+    DELETE_VOLUME = 6,      ///< (volser, bool force) -> ()
+    MOUNT_VOLUME = 7,       ///< (volser) -> ()
+    DISMOUNT_VOLUME = 8,    ///< (volser) -> ()
+    SCRATCH_VOLUME = 9,     ///< (volser) -> ()
+    ALLOCATE_SCRATCH = 10,  ///< (pool, u8 density or 0xFF for any) -> volser
+    DATASET_EXISTS = 11,    ///< (name) -> bool
+    GET_DATASET = 12,       ///< (name) -> dataset
+    ADD_DATASET = 13,       ///< (dataset) -> ()
+    PATCH_DATASET = 14,     ///< (name, dataset patch) -> ()
+    DELETE_DATASET = 15,    ///< (name) -> ()
+    GET_STATISTICS = 16,    ///< () -> statistics
+    SAVE_CATALOG = 17,      ///< () -> ()
+    SET_SESSION = 18,       ///< (user, u32 timeout ms or 0[, session id]) -> session id
+    PROMOTE = 19,           ///< () -> (); replicas only (tms_replication.h)
+    REPLICATION_STATUS = 20,///< () -> replication status
+    REPLICATE = 21,         ///< Replication socket: (log id, u64 next) -> (log id, u64 last, bool snapshot), then a stream
+    REPL_SNAPSHOT = 22,     ///< Stream: (u64 sequence, volumes, datasets, bool last)
+    REPL_CHANGES = 23,      ///< Stream: (u64 primary sequence, changes)
+    REPL_HEARTBEAT = 24,    ///< Stream: (u64 primary sequence)
+    REPL_ACK = 25,          ///< Follower to primary, unanswered: (u64 applied sequence)
+    LIST_VOLUMES = 26,      ///< (u8 status or 0xFF, string after, u32 limit or 0) -> volumes by volser
+    SEARCH_VOLUMES = 27,    ///< (search criteria) -> volumes by volser
+    QUERY_VOLUMES = 28,     ///< (query, u8 order, bool descending, u32 limit or 0) -> volumes in order
+    QUERY_DATASETS = 29,    ///< (query, u32 limit or 0) -> datasets by name
+    BATCH = 32              ///< (u32 n, n x (u16 op, string args)) -> (u32 n, n x (u16 status, string payload))
+};
+
+inline const char* rpc_op_to_string(RpcOp op) {
+    switch (op) {
+        case RpcOp::PING: return "PING";
+        case RpcOp::VOLUME_EXISTS: return "VOLUME_EXISTS";
+        case RpcOp::GET_VOLUME: return "GET_VOLUME";
+        case RpcOp::ADD_VOLUME: return "ADD_VOLUME";
+        case RpcOp::PATCH_VOLUME: return "PATCH_VOLUME";
+        case RpcOp::DELETE_VOLUME: return "DELETE_VOLUME";
+        case RpcOp::MOUNT_VOLUME: return "MOUNT_VOLUME";
+        case RpcOp::DISMOUNT_VOLUME: return "DISMOUNT_VOLUME";
+        case RpcOp::SCRATCH_VOLUME: return "SCRATCH_VOLUME";
+        case RpcOp::ALLOCATE_SCRATCH: return "ALLOCATE_SCRATCH";
+        case RpcOp::DATASET_EXISTS: return "DATASET_EXISTS";
+        case RpcOp::GET_DATASET: return "GET_DATASET";
+        case RpcOp::ADD_DATASET: return "ADD_DATASET";
+        case RpcOp::PATCH_DATASET: return "PATCH_DATASET";
+        case RpcOp::DELETE_DATASET: return "DELETE_DATASET";
+        case RpcOp::GET_STATISTICS: return "GET_STATISTICS";
+        case RpcOp::SAVE_CATALOG: return "SAVE_CATALOG";
+        case RpcOp::SET_SESSION: return "SET_SESSION";
+        case RpcOp::PROMOTE: return "PROMOTE";
+        case RpcOp::REPLICATION_STATUS: return "REPLICATION_STATUS";
+        case RpcOp::REPLICATE: return "REPLICATE";
+        case RpcOp::REPL_SNAPSHOT: return "REPL_SNAPSHOT";
+        case RpcOp::REPL_CHANGES: return "REPL_CHANGES";
+        case RpcOp::REPL_HEARTBEAT: return "REPL_HEARTBEAT";
+        case RpcOp::REPL_ACK: return "REPL_ACK";
+        case RpcOp::LIST_VOLUMES: return "LIST_VOLUMES";
+        case RpcOp::SEARCH_VOLUMES: return "SEARCH_VOLUMES";
+        case RpcOp::QUERY_VOLUMES: return "QUERY_VOLUMES";
+        case RpcOp::QUERY_DATASETS: return "QUERY_DATASETS";
+        case RpcOp::BATCH: return "BATCH";
+    }
+    return "UNKNOWN";
+}
+
+/// Operations a read-only server refuses
+inline bool rpc_op_writes(RpcOp op) {
+    switch (op) {
+        case RpcOp::ADD_VOLUME:
+        case RpcOp::PATCH_VOLUME:
+        case RpcOp::DELETE_VOLUME:
+        case RpcOp::MOUNT_VOLUME:
+        case RpcOp::DISMOUNT_VOLUME:
+        case RpcOp::SCRATCH_VOLUME:
+        case RpcOp::ALLOCATE_SCRATCH:
+        case RpcOp::ADD_DATASET:
+        case RpcOp::PATCH_DATASET:
+        case RpcOp::DELETE_DATASET:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Sort keys for QUERY_VOLUMES results
+ *
+ * Ties fall back to volser, so sorted results from several catalogs merge
+ * into the order one catalog holding all of them would return.
+ */
+enum class VolumeOrder : uint8_t {
+    VOLSER,
+    MOUNT_COUNT,
+    USED_BYTES,
+    LAST_USED,
+    ERROR_COUNT,
+    EXPIRATION
+};
+
+inline bool volume_order_before(const TapeVolume& a, const TapeVolume& b, VolumeOrder order, bool descending) {
+    auto ranked = [&](const auto& x, const auto& y) {
+        if (x != y) return descending ? y < x : x < y;
+        return a.volser < b.volser;
+    };
+    switch (order) {
+        case VolumeOrder::MOUNT_COUNT: return ranked(a.mount_count, b.mount_count);
+        case VolumeOrder::USED_BYTES: return ranked(a.used_bytes, b.used_bytes);
+        case VolumeOrder::LAST_USED: return ranked(a.last_used, b.last_used);
+        case VolumeOrder::ERROR_COUNT: return ranked(a.error_count, b.error_count);
+        case VolumeOrder::EXPIRATION: return ranked(a.expiration_date, b.expiration_date);
+        case VolumeOrder::VOLSER: break;
+    }
+    return descending ? b.volser < a.volser : a.volser < b.volser;
+}
+
+/// Sort @p items by @p before and keep the first @p limit (0: all)
+template<typename T, typename Before>
+void rpc_sort_and_limit(std::vector<T>& items, size_t limit, Before&& before) {
+    if (limit > 0 && limit < items.size()) {
+        std::partial_sort(items.begin(), items.begin() + static_cast<std::ptrdiff_t>(limit), items.end(), before);
+        items.resize(limit);
+    } else {
+        std::sort(items.begin(), items.end(), before);
+    }
+}
+
+// ============================================================================
+// Wire Encoding
+// ============================================================================
+
+/**
+ * @brief Appends little-endian values and frames to a byte buffer
+ */
+class RpcWriter {
+public:
+    void clear() { data_.clear(); }
+    size_t size() const { return data_.size(); }
+    bool empty() const { return data_.empty(); }
+    const std::string& data() const { return data_; }
+    
+    /// Drop everything written after @p size bytes
+    void truncate(size_t size) { data_.resize(size); }
+    
+    template<typename T>
+    void put_le(T value) {
+        auto u = static_cast<std::make_unsigned_t<T>>(value);
+        for (size_t i = 0; i < sizeof(T); i++) {
+            data_ += static_cast<char>((u >> (8 * i)) & 0xFF);
+        }
+    }
+    
+    /// Overwrite a value written earlier at offset @p at
+    template<typename T>
+    void patch_le(size_t at, T value) {
+        auto u = static_cast<std::make_unsigned_t<T>>(value);
+        for (size_t i = 0; i < sizeof(T); i++) {
+            data_[at + i] = static_cast<char>((u >> (8 * i)) & 0xFF);
+        }
+    }
+    
+    void put_bool(bool value) { put_le<uint8_t>(value ? 1 : 0); }
+    void put_double(double value) { put_le<uint64_t>(std::bit_cast<uint64_t>(value)); }
+    void put_bytes(std::string_view bytes) { data_.append(bytes.data(), bytes.size()); }
+    
+    void put_string(std::string_view s) {
+        put_le<uint32_t>(static_cast<uint32_t>(s.size()));
+        data_.append(s.data(), s.size());
+    }
+    
+    void put_time(std::chrono::system_clock::time_point tp) {
+        put_le<int64_t>(std::chrono::duration_cast<std::chrono::microseconds>(tp.time_since_epoch()).count());
+    }
+    
+    template<typename Range>
+    void put_strings(const Range& items) {
+        put_le<uint32_t>(static_cast<uint32_t>(items.size()));
+        for (const auto& item : items) put_string(std::string_view(item));
+    }
+    
+    /// Start a frame; everything written until end_frame() is its payload
+    size_t begin_frame(uint32_t id, RpcOp op) {
+        size_t at = data_.size();
+        put_le<uint32_t>(0);
+        put_le<uint32_t>(id);
+        put_le<uint16_t>(static_cast<uint16_t>(op));
+        put_le<uint16_t>(0);
+        return at;
+    }
+    
+    void end_frame(size_t at, TMSError status = TMSError::SUCCESS) {
+        patch_le<uint32_t>(at, static_cast<uint32_t>(data_.size() - at - 4));
+        patch_le<uint16_t>(at + 10, static_cast<uint16_t>(status));
+    }
+    
+private:
+    std::string data_;
+};
+
+/**
+ * @brief Reads values written by RpcWriter from a byte range
+ *
+ * Reading past the end yields zero values and clears ok(), so a decoder
+ * can read every field and check once at the end.
+ */
+class RpcReader {
+public:
+    explicit RpcReader(std::string_view data) : data_(data) {}
+    
+    bool ok() const { return !failed_; }
+    bool at_end() const { return pos_ == data_.size(); }
+    size_t remaining() const { return data_.size() - pos_; }
+    
+    template<typename T>
+    T get_le() {
+        if (remaining() < sizeof(T)) {
+            fail();
+            return T{};
+        }
+        std::make_unsigned_t<T> u = 0;
+        for (size_t i = 0; i < sizeof(T); i++) {
+            u |= static_cast<std::make_unsigned_t<T>>(static_cast<unsigned char>(data_[pos_ + i])) << (8 * i);
+        }
+        pos_ += sizeof(T);
+        return static_cast<T>(u);
+    }
+    
+    bool get_bool() { return get_le<uint8_t>() != 0; }
+    double get_double() { return std::bit_cast<double>(get_le<uint64_t>()); }
+    
+    /// Enum sent as one byte, rejected if past the enum's last value
+    template<typename E>
+    E get_enum(E last) {
+        uint8_t v = get_le<uint8_t>();
+        if (v > static_cast<uint8_t>(last)) {
+            fail();
+            return E{};
+        }
+        return static_cast<E>(v);
+    }
+    
+    /// As get_enum, with 0xFF meaning no value
+    template<typename E>
+    std::optional<E> get_optional_enum(E last) {
+        uint8_t v = get_le<uint8_t>();
+        if (v == 0xFF) return std::nullopt;
+        if (v > static_cast<uint8_t>(last)) {
+            fail();
+            return std::nullopt;
+        }
+        return static_cast<E>(v);
+    }
+    
+    /// View into the reader's buffer
+    std::string_view get_string() {
+        uint32_t n = get_le<uint32_t>();
+        if (failed_ || remaining() < n) {
+            fail();
+            return {};
+        }
+        std::string_view s = data_.substr(pos_, n);
+        pos_ += n;
+        return s;
+    }
+    
+    std::chrono::system_clock::time_point get_time() {
+        std::chrono::microseconds us(get_le<int64_t>());
+        return std::chrono::system_clock::time_point(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(us));
+    }
+    
+    /// List length, rejected if the items could not fit in what is left
+    uint32_t get_count(size_t min_item_bytes) {
+        uint32_t n = get_le<uint32_t>();
+        if (failed_ || static_cast<uint64_t>(n) * min_item_bytes > remaining()) {
+            fail();
+            return 0;
+        }
+        return n;
+    }
+    
+    template<typename Fn>
+    void get_strings(Fn&& fn) {
+        uint32_t n = get_count(4);
+        for (uint32_t i = 0; i < n && ok(); i++) fn(get_string());
+    }
+    
+    /// Everything not yet read, as when passing a request on unchanged
+    std::string_view get_rest() {
+        std::string_view rest = data_.substr(pos_);
+        pos_ = data_.size();
+        return rest;
+    }
+    
+private:
+    void fail() {
+        failed_ = true;
+        pos_ = data_.size();
+    }
+    
+    std::string_view data_;
+    size_t pos_ = 0;
+    bool failed_ = false;
+};
+
+/**
+ * @brief One decoded frame; the payload views the buffer it was cut from
+ */
+struct RpcFrame {
+    uint32_t id = 0;
+    RpcOp op = RpcOp::PING;
+    TMSError status = TMSError::SUCCESS;
+    std::string_view payload;
+};
+
+/**
+ * @brief Size of the complete frame at the front of @p buffer
+ * @return 0 if more bytes are needed, RPC_BAD_FRAME if the length field is
+ *         shorter than a header or larger than @p max_bytes
+ */
+inline size_t rpc_frame_size(std::string_view buffer, size_t max_bytes = RPC_MAX_FRAME_BYTES) {
+    if (buffer.size() < 4) return 0;
+    RpcReader reader(buffer.substr(0, 4));
+    size_t length = reader.get_le<uint32_t>();
+    if (length < RPC_HEADER_BYTES - 4 || length + 4 > max_bytes) return RPC_BAD_FRAME;
+    return buffer.size() >= length + 4 ? length + 4 : 0;
+}
+
+/// Decode a frame of exactly rpc_frame_size() bytes
+inline RpcFrame rpc_decode_frame(std::string_view bytes) {
+    RpcReader reader(bytes);
+    RpcFrame frame;
+    reader.get_le<uint32_t>();
+    frame.id = reader.get_le<uint32_t>();
+    frame.op = static_cast<RpcOp>(reader.get_le<uint16_t>());
+    frame.status = static_cast<TMSError>(reader.get_le<uint16_t>());
+    frame.payload = bytes.substr(RPC_HEADER_BYTES);
+    return frame;
+}
+
+// ============================================================================
+// Record Codec
+// ============================================================================
+
+/**
+ * @brief Binary forms of the records and arguments carried by RpcOp
+ *
+ * Volumes and datasets carry the fields of the JSON exchange format
+ * (TmsJsonConverter) plus the storage tier and media type; server-kept
+ * history such as location history, health and encryption metadata is not
+ * sent. Replication, which needs whole records, adds those in
+ * ReplicationCodec.
+ */
+class RpcCodec {
+public:
+    static void write_volume(RpcWriter& w, const TapeVolume& vol) {
+        w.put_string(vol.volser);
+        w.put_le<uint8_t>(static_cast<uint8_t>(vol.status));
+        w.put_le<uint8_t>(static_cast<uint8_t>(vol.density));
+        w.put_le<uint8_t>(static_cast<uint8_t>(vol.storage_tier));
+        w.put_string(vol.location.view());
+        w.put_string(vol.pool.view());
+        w.put_string(vol.owner.view());
+        w.put_string(vol.media_type.view());
+        w.put_le<int32_t>(vol.mount_count);
+        w.put_bool(vol.write_protected);
+        w.put_le<uint64_t>(vol.capacity_bytes);
+        w.put_le<uint64_t>(vol.used_bytes);
+        w.put_le<int32_t>(vol.error_count);
+        w.put_time(vol.creation_date);
+        w.put_time(vol.expiration_date);
+        w.put_time(vol.last_used);
+        w.put_string(vol.notes);
+        w.put_string(vol.reserved_by);
+        w.put_time(vol.reservation_expires);
+        w.put_le<uint32_t>(static_cast<uint32_t>(vol.tags.size()));
+        for (const auto& tag : vol.tags) w.put_string(tag.view());
+        w.put_strings(vol.datasets);
+    }
+    
+    static TapeVolume read_volume(RpcReader& r) {
+        TapeVolume vol;
+        vol.volser = r.get_string();
+        vol.status = r.get_enum(VolumeStatus::VOLUME_ERROR);
+        vol.density = r.get_enum(TapeDensity::DENSITY_LTO9);
+        vol.storage_tier = r.get_enum(StorageTier::ARCHIVE);
+        vol.location = r.get_string();
+        vol.pool = r.get_string();
+        vol.owner = r.get_string();
+        vol.media_type = r.get_string();
+        vol.mount_count = r.get_le<int32_t>();
+        vol.write_protected = r.get_bool();
+        vol.capacity_bytes = r.get_le<uint64_t>();
+        vol.used_bytes = r.get_le<uint64_t>();
+        vol.error_count = r.get_le<int32_t>();
+        vol.creation_date = r.get_time();
+        vol.expiration_date = r.get_time();
+        vol.last_used = r.get_time();
+        vol.notes = r.get_string();
+        vol.reserved_by = r.get_string();
+        vol.reservation_expires = r.get_time();
+        r.get_strings([&](std::string_view tag) { vol.tags.emplace(tag); });
+        r.get_strings([&](std::string_view name) { vol.datasets.emplace_back(name); });
+        return vol;
+    }
+    
+    static void write_dataset(RpcWriter& w, const Dataset& ds) {
+        w.put_string(ds.name);
+        w.put_string(ds.volser);
+        w.put_le<uint8_t>(static_cast<uint8_t>(ds.status));
+        w.put_le<uint64_t>(ds.size_bytes);
+        w.put_string(ds.owner.view());
+        w.put_string(ds.job_name.view());
+        w.put_le<int32_t>(ds.file_sequence);
+        w.put_le<int32_t>(ds.generation);
+        w.put_le<int32_t>(ds.version);
+        w.put_string(ds.record_format);
+        w.put_le<uint64_t>(ds.block_size);
+        w.put_le<uint64_t>(ds.record_length);
+        w.put_time(ds.creation_date);
+        w.put_time(ds.expiration_date);
+        w.put_time(ds.last_accessed);
+        w.put_string(ds.notes);
+        w.put_le<uint32_t>(static_cast<uint32_t>(ds.tags.size()));
+        for (const auto& tag : ds.tags) w.put_string(tag.view());
+    }
+    
+    static Dataset read_dataset(RpcReader& r) {
+        Dataset ds;
+        ds.name = r.get_string();
+        ds.volser = r.get_string();
+        ds.status = r.get_enum(DatasetStatus::PENDING);
+        ds.size_bytes = r.get_le<uint64_t>();
+        ds.owner = r.get_string();
+        ds.job_name = r.get_string();
+        ds.file_sequence = r.get_le<int32_t>();
+        ds.generation = r.get_le<int32_t>();
+        ds.version = r.get_le<int32_t>();
+        ds.record_format = r.get_string();
+        ds.block_size = r.get_le<uint64_t>();
+        ds.record_length = r.get_le<uint64_t>();
+        ds.creation_date = r.get_time();
+        ds.expiration_date = r.get_time();
+        ds.last_accessed = r.get_time();
+        ds.notes = r.get_string();
+        r.get_strings([&](std::string_view tag) { ds.tags.emplace(tag); });
+        return ds;
+    }
+    
+    // Patches: a u16 mask of the optional fields present, those fields in
+    // declaration order, then the add_tags and remove_tags lists
+    
+    static void write_volume_patch(RpcWriter& w, const VolumePatch& p) {
+        uint16_t mask = (p.status ? 1 : 0) | (p.pool ? 2 : 0) | (p.owner ? 4 : 0) |
+                        (p.expiration_date ? 8 : 0) | (p.write_protected ? 16 : 0) |
+                        (p.notes ? 32 : 0) | (p.media_type ? 64 : 0) | (p.storage_tier ? 128 : 0);
+        w.put_le<uint16_t>(mask);
+        if (p.status) w.put_le<uint8_t>(static_cast<uint8_t>(*p.status));
+        if (p.pool) w.put_string(*p.pool);
+        if (p.owner) w.put_string(*p.owner);
+        if (p.expiration_date) w.put_time(*p.expiration_date);
+        if (p.write_protected) w.put_bool(*p.write_protected);
+        if (p.notes) w.put_string(*p.notes);
+        if (p.media_type) w.put_string(*p.media_type);
+        if (p.storage_tier) w.put_le<uint8_t>(static_cast<uint8_t>(*p.storage_tier));
+        w.put_strings(p.add_tags);
+        w.put_strings(p.remove_tags);
+    }
+    
+    static VolumePatch read_volume_patch(RpcReader& r) {
+        VolumePatch p;
+        uint16_t mask = r.get_le<uint16_t>();
+        if (mask & 1) p.status = r.get_enum(VolumeStatus::VOLUME_ERROR);
+        if (mask & 2) p.pool = std::string(r.get_string());
+        if (mask & 4) p.owner = std::string(r.get_string());
+        if (mask & 8) p.expiration_date = r.get_time();
+        if (mask & 16) p.write_protected = r.get_bool();
+        if (mask & 32) p.notes = std::string(r.get_string());
+        if (mask & 64) p.media_type = std::string(r.get_string());
+        if (mask & 128) p.storage_tier = r.get_enum(StorageTier::ARCHIVE);
+        r.get_strings([&](std::string_view tag) { p.add_tags.emplace_back(tag); });
+        r.get_strings([&](std::string_view tag) { p.remove_tags.emplace_back(tag); });
+        return p;
+    }
+    
+    static void write_dataset_patch(RpcWriter& w, const DatasetPatch& p) {
+        uint16_t mask = (p.status ? 1 : 0) | (p.owner ? 2 : 0) | (p.job_name ? 4 : 0) |
+                        (p.expiration_date ? 8 : 0) | (p.notes ? 16 : 0);
+        w.put_le<uint16_t>(mask);
+        if (p.status) w.put_le<uint8_t>(static_cast<uint8_t>(*p.status));
+        if (p.owner) w.put_string(*p.owner);
+        if (p.job_name) w.put_string(*p.job_name);
+        if (p.expiration_date) w.put_time(*p.expiration_date);
+        if (p.notes) w.put_string(*p.notes);
+        w.put_strings(p.add_tags);
+        w.put_strings(p.remove_tags);
+    }
+    
+    static DatasetPatch read_dataset_patch(RpcReader& r) {
+        DatasetPatch p;
+        uint16_t mask = r.get_le<uint16_t>();
+        if (mask & 1) p.status = r.get_enum(DatasetStatus::PENDING);
+        if (mask & 2) p.owner = std::string(r.get_string());
+        if (mask & 4) p.job_name = std::string(r.get_string());
+        if (mask & 8) p.expiration_date = r.get_time();
+        if (mask & 16) p.notes = std::string(r.get_string());
+        r.get_strings([&](std::string_view tag) { p.add_tags.emplace_back(tag); });
+        r.get_strings([&](std::string_view tag) { p.remove_tags.emplace_back(tag); });
+        return p;
+    }
+    
+    /// Counters and pool sizes; uptime is not sent
+    static void write_statistics(RpcWriter& w, const SystemStatistics& s) {
+        for (uint64_t v : {s.total_volumes, s.scratch_volumes, s.private_volumes, s.mounted_volumes,
+                           s.expired_volumes, s.reserved_volumes, s.total_datasets, s.active_datasets,
+                           s.migrated_datasets, s.expired_datasets}) {
+            w.put_le<uint64_t>(v);
+        }
+        w.put_le<uint64_t>(s.total_capacity);
+        w.put_le<uint64_t>(s.used_capacity);
+        w.put_le<uint32_t>(static_cast<uint32_t>(s.pool_counts.size()));
+        for (const auto& [pool, count] : s.pool_counts) {
+            w.put_string(pool);
+            w.put_le<uint64_t>(count);
+        }
+    }
+    
+    static SystemStatistics read_statistics(RpcReader& r) {
+        SystemStatistics s;
+        for (size_t* field : {&s.total_volumes, &s.scratch_volumes, &s.private_volumes, &s.mounted_volumes,
+                              &s.expired_volumes, &s.reserved_volumes, &s.total_datasets, &s.active_datasets,
+                              &s.migrated_datasets, &s.expired_datasets}) {
+            *field = static_cast<size_t>(r.get_le<uint64_t>());
+        }
+        s.total_capacity = r.get_le<uint64_t>();
+        s.used_capacity = r.get_le<uint64_t>();
+        uint32_t pools = r.get_count(12);
+        for (uint32_t i = 0; i < pools && r.ok(); i++) {
+            std::string pool(r.get_string());
+            s.pool_counts[pool] = static_cast<size_t>(r.get_le<uint64_t>());
+        }
+        return s;
+    }
+    
+    static void write_criteria(RpcWriter& w, const SearchCriteria& c) {
+        auto put_text = [&](const std::optional<std::string>& v) {
+            w.put_bool(v.has_value());
+            if (v) w.put_string(*v);
+        };
+        auto put_int = [&](const std::optional<int>& v) {
+            w.put_bool(v.has_value());
+            if (v) w.put_le<int32_t>(*v);
+        };
+        w.put_string(c.pattern);
+        w.put_le<uint8_t>(static_cast<uint8_t>(c.mode));
+        w.put_le<uint8_t>(c.status ? static_cast<uint8_t>(*c.status) : 0xFF);
+        put_text(c.owner);
+        put_text(c.pool);
+        put_text(c.location);
+        put_text(c.tag);
+        w.put_bool(c.created_after.has_value());
+        if (c.created_after) w.put_time(*c.created_after);
+        w.put_bool(c.created_before.has_value());
+        if (c.created_before) w.put_time(*c.created_before);
+        w.put_le<uint32_t>(static_cast<uint32_t>(c.limit));
+        w.put_le<uint8_t>(c.min_health ? static_cast<uint8_t>(*c.min_health) : 0xFF);
+        put_int(c.max_errors);
+        put_int(c.min_mount_count);
+        put_int(c.max_mount_count);
+        w.put_le<uint32_t>(static_cast<uint32_t>(c.fuzzy_threshold));
+    }
+    
+    static SearchCriteria read_criteria(RpcReader& r) {
+        auto get_text = [&](std::optional<std::string>& v) {
+            if (r.get_bool()) v = std::string(r.get_string());
+        };
+        auto get_int = [&](std::optional<int>& v) {
+            if (r.get_bool()) v = r.get_le<int32_t>();
+        };
+        SearchCriteria c;
+        c.pattern = r.get_string();
+        c.mode = r.get_enum(SearchMode::FUZZY);
+        c.status = r.get_optional_enum(VolumeStatus::VOLUME_ERROR);
+        get_text(c.owner);
+        get_text(c.pool);
+        get_text(c.location);
+        get_text(c.tag);
+        if (r.get_bool()) c.created_after = r.get_time();
+        if (r.get_bool()) c.created_before = r.get_time();
+        c.limit = r.get_le<uint32_t>();
+        c.min_health = r.get_optional_enum(HealthStatus::CRITICAL);
+        get_int(c.max_errors);
+        get_int(c.min_mount_count);
+        get_int(c.max_mount_count);
+        c.fuzzy_threshold = r.get_le<uint32_t>();
+        return c;
+    }
+    
+    static void write_volumes(RpcWriter& w, const std::vector<TapeVolume>& volumes) {
+        w.put_le<uint32_t>(static_cast<uint32_t>(volumes.size()));
+        for (const auto& vol : volumes) write_volume(w, vol);
+    }
+    
+    static std::vector<TapeVolume> read_volumes(RpcReader& r) {
+        uint32_t n = r.get_count(64);
+        std::vector<TapeVolume> volumes;
+        volumes.reserve(n);
+        for (uint32_t i = 0; i < n && r.ok(); i++) volumes.push_back(read_volume(r));
+        return volumes;
+    }
+    
+    static void write_datasets(RpcWriter& w, const std::vector<Dataset>& datasets) {
+        w.put_le<uint32_t>(static_cast<uint32_t>(datasets.size()));
+        for (const auto& ds : datasets) write_dataset(w, ds);
+    }
+    
+    static std::vector<Dataset> read_datasets(RpcReader& r) {
+        uint32_t n = r.get_count(48);
+        std::vector<Dataset> datasets;
+        datasets.reserve(n);
+        for (uint32_t i = 0; i < n && r.ok(); i++) datasets.push_back(read_dataset(r));
+        return datasets;
+    }
+};
+
+// ============================================================================
+// Responses and Batches
+// ============================================================================
+
+/**
+ * @brief A decoded response (or one item of a batch response)
+ */
+struct RpcResponse {
+    uint32_t id = 0;
+    RpcOp op = RpcOp::PING;
+    TMSError status = TMSError::SUCCESS;
+    std::string payload;
+    
+    bool is_success() const { return status == TMSError::SUCCESS; }
+    
+    /// Error text of a failed response
+    std::string message() const {
+        RpcReader reader(payload);
+        std::string_view text = reader.get_string();
+        return reader.ok() ? std::string(text) : error_to_string(status);
+    }
+    
+    /// Typed payload of a successful response
+    template<typename T, typename Fn>
+    Result<T> decode(Fn&& read) const {
+        if (!is_success()) return Result<T>::err(status, message());
+        RpcReader reader(payload);
+        T value = read(reader);
+        if (!reader.ok()) {
+            return Result<T>::err(TMSError::INVALID_FORMAT,
+                                  std::string("Malformed ") + rpc_op_to_string(op) + " response");
+        }
+        return Result<T>::ok(std::move(value));
+    }
+    
+    OperationResult result() const {
+        return is_success() ? OperationResult::ok() : OperationResult::err(status, message());
+    }
+    
+    /// Items of a successful BATCH response, in request order
+    Result<std::vector<RpcResponse>> batch_items() const;
+};
+
+/**
+ * @brief Requests to send together in one BATCH frame
+ *
+ * Items run in order on the server; each succeeds or fails on its own,
+ * they are not applied as a transaction.
+ */
+class RpcBatch {
+public:
+    /// Append a request; @p write_args writes its arguments
+    template<typename Fn>
+    RpcBatch& add(RpcOp op, Fn&& write_args) {
+        args_.put_le<uint16_t>(static_cast<uint16_t>(op));
+        size_t at = args_.size();
+        args_.put_le<uint32_t>(0);
+        write_args(args_);
+        args_.patch_le<uint32_t>(at, static_cast<uint32_t>(args_.size() - at - 4));
+        ops_.push_back(op);
+        return *this;
+    }
+    
+    RpcBatch& add(RpcOp op) { return add(op, [](RpcWriter&) {}); }
+    
+    RpcBatch& volume_exists(const std::string& volser) {
+        return add(RpcOp::VOLUME_EXISTS, [&](RpcWriter& w) { w.put_string(volser); });
+    }
+    RpcBatch& get_volume(const std::string& volser) {
+        return add(RpcOp::GET_VOLUME, [&](RpcWriter& w) { w.put_string(volser); });
+    }
+    RpcBatch& add_volume(const TapeVolume& volume) {
+        return add(RpcOp::ADD_VOLUME, [&](RpcWriter& w) { RpcCodec::write_volume(w, volume); });
+    }
+    RpcBatch& patch_volume(const std::string& volser, const VolumePatch& patch) {
+        return add(RpcOp::PATCH_VOLUME, [&](RpcWriter& w) {
+            w.put_string(volser);
+            RpcCodec::write_volume_patch(w, patch);
+        });
+    }
+    RpcBatch& get_dataset(const std::string& name) {
+        return add(RpcOp::GET_DATASET, [&](RpcWriter& w) { w.put_string(name); });
+    }
+    RpcBatch& add_dataset(const Dataset& dataset) {
+        return add(RpcOp::ADD_DATASET, [&](RpcWriter& w) { RpcCodec::write_dataset(w, dataset); });
+    }
+    
+    size_t size() const { return ops_.size(); }
+    bool empty() const { return ops_.empty(); }
+    
+    void clear() {
+        args_.clear();
+        ops_.clear();
+    }
+    
+    /// BATCH payload: item count then the items
+    void write(RpcWriter& w) const {
+        w.put_le<uint32_t>(static_cast<uint32_t>(ops_.size()));
+        w.put_bytes(args_.data());
+    }
+    
+private:
+    RpcWriter args_;
+    std::vector<RpcOp> ops_;
+};
+
+inline Result<std::vector<RpcResponse>> RpcResponse::batch_items() const {
+    using R = Result<std::vector<RpcResponse>>;
+    if (!is_success()) return R::err(status, message());
+    RpcReader reader(payload);
+    uint32_t count = reader.get_count(8);
+    std::vector<RpcResponse> items;
+    items.reserve(count);
+    for (uint32_t i = 0; i < count && reader.ok(); i++) {
+        RpcResponse item;
+        item.id = id;
+        item.op = static_cast<RpcOp>(reader.get_le<uint16_t>());
+        item.status = static_cast<TMSError>(reader.get_le<uint16_t>());
+        item.payload = reader.get_string();
+        items.push_back(std::move(item));
+    }
+    if (!reader.ok() || !reader.at_end()) return R::err(TMSError::INVALID_FORMAT, "Malformed BATCH response");
+    return R::ok(std::move(items));
+}
+
+#if TMS_HAS_RPC
+
+// ============================================================================
+// Server
+// ============================================================================
+
+/// Serves an operation RpcServer does not implement itself; writes the
+/// success payload to the writer
+using RpcHandler = std::function<OperationResult(RpcReader& args, RpcWriter& out)>;
+
+struct RpcServerOptions {
+    std::string socket_path;                ///< Unix socket path; empty for none
+    int tcp_port = -1;                      ///< Loopback TCP port; -1 for none, 0 for any free port
+    size_t workers = 4;
+    size_t max_frame_bytes = RPC_MAX_FRAME_BYTES;
+    size_t max_pending_bytes = 4 * RPC_MAX_FRAME_BYTES;  ///< Stop reading a connection with this much queued or unsent
+};
+
+struct RpcServerStats {
+    uint64_t connections_accepted = 0;
+    uint64_t connections_open = 0;
+    uint64_t frames = 0;                    ///< Request frames
+    uint64_t requests = 0;                  ///< Operations, counting each batch item
+    uint64_t batches = 0;
+    uint64_t errors = 0;                    ///< Operations that returned an error status
+    uint64_t protocol_errors = 0;           ///< Connections dropped for malformed frames
+    uint64_t deadline_expired = 0;          ///< Frames answered OPERATION_TIMEOUT without running
+    uint64_t reads_paused = 0;              ///< Times a connection stopped being read until its backlog drained
+    uint64_t bytes_in = 0;
+    uint64_t bytes_out = 0;
+};
+
+/**
+ * @brief Serves a TMSSystem to RpcClient connections
+ *
+ * The event loop thread accepts connections, reads sockets and cuts the
+ * input into complete frames. A connection with frames waiting is queued
+ * for the worker pool. Its worker runs every waiting frame against the
+ * catalog, then writes all the responses with one send. Output the socket
+ * will not take yet is finished by the event loop.
+ */
+class RpcServer {
+public:
+    explicit RpcServer(TMSSystem& system) : system_(system) {}
+    ~RpcServer() { stop(); }
+    
+    RpcServer(const RpcServer&) = delete;
+    RpcServer& operator=(const RpcServer&) = delete;
+    
+    OperationResult start(const RpcServerOptions& options = RpcServerOptions());
+    
+    /// Close every connection and listener; requests not yet run are dropped
+    void stop();
+    
+    bool is_running() const { return running_.load(std::memory_order_acquire); }
+    
+    /// Bound TCP port (useful with tcp_port 0), or -1
+    int tcp_port() const { return tcp_port_; }
+    const std::string& socket_path() const { return options_.socket_path; }
+    
+    RpcServerStats stats() const;
+    
+    /// Refuse catalog writes (INVALID_STATE), as on a replica
+    void set_read_only(bool read_only) { read_only_.store(read_only, std::memory_order_release); }
+    bool is_read_only() const { return read_only_.load(std::memory_order_acquire); }
+    
+    /// Serve @p op with @p handler instead of the built-in operation;
+    /// register before start()
+    void handle(RpcOp op, RpcHandler handler) { handlers_[op] = std::move(handler); }
+
+private:
+    struct Connection {
+        int fd = -1;
+        std::string in;                     ///< Partial input (event loop only)
+        std::mutex mutex;                   ///< Guards the members below
+        std::string queued;                 ///< Complete frames not yet taken by a worker
+        bool scheduled = false;             ///< Queued for or held by a worker
+        std::string out;                    ///< Response bytes the socket has not taken
+        bool writing = false;               ///< EPOLLOUT armed
+        bool paused = false;                ///< EPOLLIN dropped until queued and out drain
+        bool eof = false;                   ///< Peer shut its write side; closed once drained
+        bool hungup = false;                ///< Peer gone entirely; out discarded, fd unwatched
+        bool closed = false;
+        std::vector<std::chrono::steady_clock::time_point> arrivals;   ///< When each queued frame arrived
+        
+        // Held by the connection's worker only; installed for every request
+        OperationContext session;
+        std::string own_session_id;             ///< Given at accept; back in force when SET_SESSION names none
+        std::chrono::milliseconds timeout{0};   ///< Per-request deadline after arrival; 0 for none
+    };
+    using ConnectionPtr = std::shared_ptr<Connection>;
+    
+    OperationResult listen_unix();
+    OperationResult listen_tcp();
+    void run_loop();
+    void run_worker();
+    void accept_all(int listen_fd);
+    bool read_from(const ConnectionPtr& conn, bool hangup);
+    void flush_out(Connection& conn);
+    void update_events(Connection& conn);
+    static bool drained(const Connection& conn);
+    void close_connection(const ConnectionPtr& conn);
+    void close_finished();
+    void close_fds();
+    void serve(Connection& conn, std::string_view frames,
+               const std::vector<std::chrono::steady_clock::time_point>& arrivals,
+               RpcWriter& out);
+    TMSError execute(Connection& conn, RpcOp op, RpcReader& args, RpcWriter& out, size_t depth = 0);
+    
+    TMSSystem& system_;
+    RpcServerOptions options_;
+    std::atomic<bool> read_only_{false};
+    std::map<RpcOp, RpcHandler> handlers_;  ///< Fixed while running
+    int epoll_fd_ = -1;
+    int wake_fd_ = -1;
+    int unix_fd_ = -1;
+    int tcp_fd_ = -1;
+    int tcp_port_ = -1;
+    bool owns_socket_file_ = false;
+    std::atomic<bool> running_{false};
+    std::thread loop_;
+    std::vector<std::thread> workers_;
+    std::unordered_map<int, ConnectionPtr> connections_;   ///< Event loop only
+    
+    std::mutex ready_mutex_;
+    std::condition_variable ready_cv_;
+    std::deque<ConnectionPtr> ready_;
+    std::vector<ConnectionPtr> finished_;   ///< Drained after EOF; closed by the event loop
+    bool stopping_ = false;
+    
+    struct Counters {
+        std::atomic<uint64_t> accepted{0};
+        std::atomic<uint64_t> open{0};
+        std::atomic<uint64_t> frames{0};
+        std::atomic<uint64_t> requests{0};
+        std::atomic<uint64_t> batches{0};
+        std::atomic<uint64_t> errors{0};
+        std::atomic<uint64_t> protocol_errors{0};
+        std::atomic<uint64_t> deadline_expired{0};
+        std::atomic<uint64_t> reads_paused{0};
+        std::atomic<uint64_t> bytes_in{0};
+        std::atomic<uint64_t> bytes_out{0};
+    } counters_;
+};
+
+// ============================================================================
+// Client
+// ============================================================================
+
+/**
+ * @brief Blocking client for RpcServer; not thread-safe (one per thread)
+ *
+ * call() does one round trip. For pipelining, enqueue() any number of
+ * requests, flush() them in one write, then receive() each response;
+ * responses arrive in request order.
+ */
+class RpcClient {
+public:
+    RpcClient() = default;
+    ~RpcClient() { close(); }
+    
+    RpcClient(const RpcClient&) = delete;
+    RpcClient& operator=(const RpcClient&) = delete;
+    
+    OperationResult connect_unix(const std::string& path);
+    OperationResult connect_tcp(const std::string& host, uint16_t port);
+    void close();
+    bool is_connected() const { return fd_ >= 0; }
+    
+    // Pipelining
+    
+    /// Queue a request without sending it; returns its id
+    template<typename Fn>
+    uint32_t enqueue(RpcOp op, Fn&& write_args) {
+        uint32_t id = next_id_++;
+        size_t at = out_.begin_frame(id, op);
+        write_args(out_);
+        out_.end_frame(at);
+        outstanding_++;
+        return id;
+    }
+    uint32_t enqueue(RpcOp op) { return enqueue(op, [](RpcWriter&) {}); }
+    uint32_t enqueue(const RpcBatch& batch) {
+        return enqueue(RpcOp::BATCH, [&](RpcWriter& w) { batch.write(w); });
+    }
+    
+    /// Send every queued request
+    OperationResult flush();
+    
+    /// Next response, waiting for it if needed (flushes queued requests first)
+    Result<RpcResponse> receive();
+    
+    /// Requests sent or queued whose responses have not been received
+    size_t outstanding() const { return outstanding_; }
+    
+    // Streams
+    
+    /// Send a frame the server does not answer
+    template<typename Fn>
+    OperationResult notify(RpcOp op, Fn&& write_args) {
+        size_t at = out_.begin_frame(0, op);
+        write_args(out_);
+        out_.end_frame(at);
+        return flush();
+    }
+    
+    /// Next frame the server sends unasked, as after REPLICATE
+    Result<RpcResponse> receive_stream();
+    
+    /// Bound each wait for input; a wait that runs out fails with
+    /// OPERATION_TIMEOUT and leaves the connection open
+    OperationResult set_receive_timeout(std::chrono::milliseconds timeout);
+    
+    // Round trips
+    
+    template<typename Fn>
+    Result<RpcResponse> call(RpcOp op, Fn&& write_args) {
+        if (outstanding_ > 0) {
+            return Result<RpcResponse>::err(TMSError::INVALID_STATE, "Pipelined responses not yet received");
+        }
+        enqueue(op, std::forward<Fn>(write_args));
+        return receive();
+    }
+    Result<RpcResponse> call(RpcOp op) { return call(op, [](RpcWriter&) {}); }
+    
+    /// Send @p batch as one frame; returns one response per item
+    Result<std::vector<RpcResponse>> call(const RpcBatch& batch);
+    
+    OperationResult ping();
+    Result<bool> volume_exists(const std::string& volser);
+    Result<TapeVolume> get_volume(const std::string& volser);
+    OperationResult add_volume(const TapeVolume& volume);
+    OperationResult patch_volume(const std::string& volser, const VolumePatch& patch);
+    OperationResult delete_volume(const std::string& volser, bool force = false);
+    OperationResult mount_volume(const std::string& volser);
+    OperationResult dismount_volume(const std::string& volser);
+    OperationResult scratch_volume(const std::string& volser);
+    Result<std::string> allocate_scratch_volume(const std::string& pool = "",
+                                                std::optional<TapeDensity> density = std::nullopt);
+    Result<bool> dataset_exists(const std::string& name);
+    Result<Dataset> get_dataset(const std::string& name);
+    OperationResult add_dataset(const Dataset& dataset);
+    OperationResult patch_dataset(const std::string& name, const DatasetPatch& patch);
+    OperationResult delete_dataset(const std::string& name);
+    Result<SystemStatistics> get_statistics();
+    OperationResult save_catalog();
+    
+    /// Volumes after @p after in volser order, at most @p limit (0: all)
+    Result<std::vector<TapeVolume>> list_volumes(std::optional<VolumeStatus> status = std::nullopt,
+                                                 const std::string& after = "", size_t limit = 0);
+    /// Matches in volser order; criteria.limit keeps the first ones
+    Result<std::vector<TapeVolume>> search_volumes(const SearchCriteria& criteria);
+    /// Matches of a tms_query.h query, first @p limit by @p order (0: all)
+    Result<std::vector<TapeVolume>> query_volumes(const std::string& query, VolumeOrder order = VolumeOrder::VOLSER,
+                                                  bool descending = false, size_t limit = 0);
+    Result<std::vector<Dataset>> query_datasets(const std::string& query, size_t limit = 0);
+    
+    /// Name the user for this connection's requests and bound how long a
+    /// request may wait in the server (0: unbounded); returns the session id
+    Result<std::string> set_session(const std::string& user,
+                                    std::chrono::milliseconds timeout = std::chrono::milliseconds(0));
+    
+private:
+    OperationResult status_of(const Result<RpcResponse>& response) const {
+        if (!response) return OperationResult::err(response.error().code, response.error().message);
+        return response.value().result();
+    }
+    
+    template<typename T, typename Fn>
+    Result<T> value_of(const Result<RpcResponse>& response, Fn&& read) const {
+        if (!response) return Result<T>::err(response.error().code, response.error().message);
+        return response.value().template decode<T>(std::forward<Fn>(read));
+    }
+    
+    OperationResult connect_to(int fd, const sockaddr* addr, socklen_t len, const std::string& where);
+    Result<RpcResponse> read_frame();
+    
+    int fd_ = -1;
+    RpcWriter out_;
+    std::string in_;
+    size_t in_pos_ = 0;
+    uint32_t next_id_ = 1;
+    size_t outstanding_ = 0;
+};
+
+// ============================================================================
+// Server Implementation
+// ============================================================================
+
+inline OperationResult RpcServer::start(const RpcServerOptions& options) {
+    if (is_running()) return OperationResult::err(TMSError::INVALID_STATE, "RPC server already running");
+    if (options.socket_path.empty() && options.tcp_port < 0) {
+        return OperationResult::err(TMSError::INVALID_PARAMETER, "No Unix socket path or TCP port given");
+    }
+    options_ = options;
+    options_.workers = std::max<size_t>(options_.workers, 1);
+    options_.max_frame_bytes = std::max(options_.max_frame_bytes, RPC_HEADER_BYTES);
+    options_.max_pending_bytes = std::max(options_.max_pending_bytes, options_.max_frame_bytes);
+    
+    epoll_fd_ = ::epoll_create1(EPOLL_CLOEXEC);
+    wake_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epoll_fd_ < 0 || wake_fd_ < 0) {
+        std::string reason = std::strerror(errno);
+        close_fds();
+        return OperationResult::err(TMSError::SYSTEM_ERROR, "epoll setup failed: " + reason);
+    }
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = wake_fd_;
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &ev);
+    
+    for (auto listen : {&RpcServer::listen_unix, &RpcServer::listen_tcp}) {
+        auto result = (this->*listen)();
+        if (!result) {
+            close_fds();
+            return result;
+        }
+    }
+    
+    stopping_ = false;
+    running_.store(true, std::memory_order_release);
+    for (size_t i = 0; i < options_.workers; i++) workers_.emplace_back([this] { run_worker(); });
+    loop_ = std::thread([this] { run_loop(); });
+    TMS_LOG_INFO("RpcServer", "Serving catalog" +
+                 (options_.socket_path.empty() ? std::string() : " on " + options_.socket_path) +
+                 (tcp_port_ < 0 ? std::string() : " on 127.0.0.1:" + std::to_string(tcp_port_)));
+    return OperationResult::ok();
+}
+
+/// Non-blocking listening socket at @p path
+inline Result<int> rpc_listen_unix(const std::string& path) {
+    sockaddr_un addr{};
+    if (path.size() >= sizeof(addr.sun_path)) {
+        return Result<int>::err(TMSError::INVALID_PARAMETER, "Socket path too long: " + path);
+    }
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+    
+    // A socket file left by a previous run would make bind fail; one that
+    // still accepts connections belongs to a running daemon
+    struct stat st{};
+    if (::stat(path.c_str(), &st) == 0 && S_ISSOCK(st.st_mode)) {
+        int probe = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        bool live = probe >= 0 && ::connect(probe, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0;
+        if (probe >= 0) ::close(probe);
+        if (live) return Result<int>::err(TMSError::INVALID_STATE, "Another server is listening on " + path);
+        ::unlink(path.c_str());
+    }
+    
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0 ||
+        ::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        ::listen(fd, SOMAXCONN) != 0) {
+        std::string reason = std::strerror(errno);
+        if (fd >= 0) ::close(fd);
+        return Result<int>::err(TMSError::SYSTEM_ERROR, "Cannot listen on " + path + ": " + reason);
+    }
+    return Result<int>::ok(fd);
+}
+
+inline OperationResult RpcServer::listen_unix() {
+    if (options_.socket_path.empty()) return OperationResult::ok();
+    auto listening = rpc_listen_unix(options_.socket_path);
+    if (!listening) return OperationResult::err(listening.error_code(), listening.error().message);
+    unix_fd_ = listening.value();
+    owns_socket_file_ = true;
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = unix_fd_;
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, unix_fd_, &ev);
+    return OperationResult::ok();
+}
+
+inline OperationResult RpcServer::listen_tcp() {
+    if (options_.tcp_port < 0) return OperationResult::ok();
+    if (options_.tcp_port > 65535) {
+        return OperationResult::err(TMSError::INVALID_PARAMETER, "Invalid TCP port " + std::to_string(options_.tcp_port));
+    }
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(static_cast<uint16_t>(options_.tcp_port));
+    
+    tcp_fd_ = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    int one = 1;
+    if (tcp_fd_ >= 0) ::setsockopt(tcp_fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    socklen_t len = sizeof(addr);
+    if (tcp_fd_ < 0 ||
+        ::bind(tcp_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        ::listen(tcp_fd_, SOMAXCONN) != 0 ||
+        ::getsockname(tcp_fd_, reinterpret_cast<sockaddr*>(&addr), &len) != 0) {
+        return OperationResult::err(TMSError::SYSTEM_ERROR,
+                                    "Cannot listen on TCP port " + std::to_string(options_.tcp_port) +
+                                    ": " + std::strerror(errno));
+    }
+    tcp_port_ = ntohs(addr.sin_port);
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = tcp_fd_;
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, tcp_fd_, &ev);
+    return OperationResult::ok();
+}
+
+inline void RpcServer::stop() {
+    if (!running_.exchange(false, std::memory_order_acq_rel)) return;
+    uint64_t one = 1;
+    [[maybe_unused]] ssize_t n = ::write(wake_fd_, &one, sizeof(one));
+    loop_.join();
+    {
+        std::lock_guard<std::mutex> lock(ready_mutex_);
+        stopping_ = true;
+        ready_.clear();
+        finished_.clear();
+    }
+    ready_cv_.notify_all();
+    for (auto& worker : workers_) worker.join();
+    workers_.clear();
+    for (auto& [fd, conn] : connections_) {
+        std::lock_guard<std::mutex> lock(conn->mutex);
+        conn->closed = true;
+        ::close(fd);
+    }
+    connections_.clear();
+    counters_.open.store(0, std::memory_order_relaxed);
+    close_fds();
+    TMS_LOG_INFO("RpcServer", "Stopped");
+}
+
+inline void RpcServer::close_fds() {
+    for (int* fd : {&unix_fd_, &tcp_fd_, &wake_fd_, &epoll_fd_}) {
+        if (*fd >= 0) ::close(*fd);
+        *fd = -1;
+    }
+    if (owns_socket_file_) ::unlink(options_.socket_path.c_str());
+    owns_socket_file_ = false;
+    tcp_port_ = -1;
+}
+
+inline RpcServerStats RpcServer::stats() const {
+    RpcServerStats s;
+    s.connections_accepted = counters_.accepted.load(std::memory_order_relaxed);
+    s.connections_open = counters_.open.load(std::memory_order_relaxed);
+    s.frames = counters_.frames.load(std::memory_order_relaxed);
+    s.requests = counters_.requests.load(std::memory_order_relaxed);
+    s.batches = counters_.batches.load(std::memory_order_relaxed);
+    s.errors = counters_.errors.load(std::memory_order_relaxed);
+    s.protocol_errors = counters_.protocol_errors.load(std::memory_order_relaxed);
+    s.deadline_expired = counters_.deadline_expired.load(std::memory_order_relaxed);
+    s.reads_paused = counters_.reads_paused.load(std::memory_order_relaxed);
+    s.bytes_in = counters_.bytes_in.load(std::memory_order_relaxed);
+    s.bytes_out = counters_.bytes_out.load(std::memory_order_relaxed);
+    return s;
+}
+
+inline void RpcServer::run_loop() {
+    epoll_event events[64];
+    while (true) {
+        int n = ::epoll_wait(epoll_fd_, events, 64, -1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            TMS_LOG_ERROR("RpcServer", std::string("epoll_wait failed: ") + std::strerror(errno));
+            return;
+        }
+        for (int i = 0; i < n; i++) {
+            int fd = events[i].data.fd;
+            if (fd == wake_fd_) {
+                if (!running_.load(std::memory_order_acquire)) return;
+                uint64_t count;
+                [[maybe_unused]] ssize_t n = ::read(wake_fd_, &count, sizeof(count));
+                close_finished();
+                continue;
+            }
+            if (fd == unix_fd_ || fd == tcp_fd_) {
+                accept_all(fd);
+                continue;
+            }
+            auto it = connections_.find(fd);
+            if (it == connections_.end()) continue;
+            ConnectionPtr conn = it->second;
+            if (events[i].events & EPOLLOUT) {
+                bool done;
+                {
+                    std::lock_guard<std::mutex> lock(conn->mutex);
+                    flush_out(*conn);
+                    done = drained(*conn);
+                }
+                if (done) {
+                    close_connection(conn);
+                    continue;
+                }
+            }
+            if ((events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) &&
+                !read_from(conn, events[i].events & (EPOLLHUP | EPOLLERR))) {
+                close_connection(conn);
+            }
+        }
+    }
+}
+
+inline void RpcServer::accept_all(int listen_fd) {
+    while (true) {
+        sockaddr_in peer{};
+        socklen_t peer_len = sizeof(peer);
+        int fd = ::accept4(listen_fd, reinterpret_cast<sockaddr*>(&peer), &peer_len, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                TMS_LOG_WARNING("RpcServer", std::string("accept failed: ") + std::strerror(errno));
+            }
+            return;
+        }
+        auto conn = std::make_shared<Connection>();
+        conn->fd = fd;
+        conn->own_session_id = "rpc-" + std::to_string(counters_.accepted.load(std::memory_order_relaxed) + 1);
+        conn->session.session_id = conn->own_session_id;
+        conn->session.source = "unix";
+        if (listen_fd == tcp_fd_) {
+            int one = 1;
+            ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+            char ip[INET_ADDRSTRLEN] = "";
+            ::inet_ntop(AF_INET, &peer.sin_addr, ip, sizeof(ip));
+            conn->session.source = "tcp:" + std::string(ip) + ":" + std::to_string(ntohs(peer.sin_port));
+        }
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.fd = fd;
+        ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev);
+        connections_.emplace(fd, std::move(conn));
+        counters_.accepted.fetch_add(1, std::memory_order_relaxed);
+        counters_.open.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+/// Read what the socket has and queue the complete frames; false to close.
+/// Frames that arrived before the peer shut its write side still run and
+/// are answered; the connection closes once they have.
+inline bool RpcServer::read_from(const ConnectionPtr& conn, bool hangup) {
+    char buf[64 * 1024];
+    bool open = true;
+    bool eof = false;
+    // Bounded so one busy client cannot starve the others
+    for (size_t total = 0; total < 1024 * 1024;) {
+        ssize_t n = ::recv(conn->fd, buf, sizeof(buf), 0);
+        if (n > 0) {
+            conn->in.append(buf, static_cast<size_t>(n));
+            total += static_cast<size_t>(n);
+            counters_.bytes_in.fetch_add(static_cast<uint64_t>(n), std::memory_order_relaxed);
+            continue;
+        }
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        if (n == 0) {
+            eof = true;
+        } else {
+            open = false;
+        }
+        break;
+    }
+    if (!open) return false;
+    
+    size_t used = 0;
+    size_t complete = 0;
+    while (true) {
+        size_t size = rpc_frame_size(std::string_view(conn->in).substr(used), options_.max_frame_bytes);
+        if (size == RPC_BAD_FRAME) {
+            counters_.protocol_errors.fetch_add(1, std::memory_order_relaxed);
+            TMS_LOG_WARNING("RpcServer", "Dropping connection after a malformed frame");
+            return false;
+        }
+        if (size == 0) break;
+        used += size;
+        complete++;
+        counters_.frames.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (used > 0) {
+        bool schedule = false;
+        {
+            std::lock_guard<std::mutex> lock(conn->mutex);
+            conn->arrivals.insert(conn->arrivals.end(), complete, std::chrono::steady_clock::now());
+            conn->queued.append(conn->in, 0, used);
+            schedule = !conn->scheduled;
+            conn->scheduled = true;
+            update_events(*conn);
+        }
+        conn->in.erase(0, used);
+        if (schedule) {
+            {
+                std::lock_guard<std::mutex> lock(ready_mutex_);
+                ready_.push_back(conn);
+            }
+            ready_cv_.notify_one();
+        }
+    }
+    if (!eof) return true;
+    
+    std::lock_guard<std::mutex> lock(conn->mutex);
+    conn->eof = true;
+    if (hangup && !conn->hungup) {
+        // Nothing can be sent either; stop watching so the hangup stops firing
+        conn->hungup = true;
+        conn->out.clear();
+        ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, conn->fd, nullptr);
+    }
+    update_events(*conn);
+    return !drained(*conn);
+}
+
+/// Send as much pending output as the socket takes; caller holds conn.mutex
+inline void RpcServer::flush_out(Connection& conn) {
+    size_t sent = 0;
+    while (sent < conn.out.size()) {
+        ssize_t n = ::send(conn.fd, conn.out.data() + sent, conn.out.size() - sent, MSG_NOSIGNAL);
+        if (n > 0) {
+            sent += static_cast<size_t>(n);
+            continue;
+        }
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        // Peer gone; the event loop sees the hangup and closes
+        sent = conn.out.size();
+    }
+    counters_.bytes_out.fetch_add(sent, std::memory_order_relaxed);
+    conn.out.erase(0, sent);
+    update_events(conn);
+}
+
+/// Watch for output room while responses are unsent, and stop reading while
+/// a client has more queued or unsent than max_pending_bytes, so one that
+/// pipelines without reading its answers cannot grow the buffers without
+/// bound; caller holds conn.mutex
+inline void RpcServer::update_events(Connection& conn) {
+    if (conn.closed || conn.hungup) return;
+    bool want_read = !conn.eof && conn.queued.size() + conn.out.size() < options_.max_pending_bytes;
+    bool want_write = !conn.out.empty();
+    if (want_read != conn.paused && want_write == conn.writing) return;
+    epoll_event ev{};
+    ev.events = (want_read ? EPOLLIN : 0u) | (want_write ? EPOLLOUT : 0u);
+    ev.data.fd = conn.fd;
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, conn.fd, &ev);
+    if (!want_read && !conn.paused && !conn.eof) counters_.reads_paused.fetch_add(1, std::memory_order_relaxed);
+    conn.paused = !want_read;
+    conn.writing = want_write;
+}
+
+/// Past EOF with every frame answered (or unanswerable); caller holds conn.mutex
+inline bool RpcServer::drained(const Connection& conn) {
+    return conn.eof && !conn.scheduled && conn.queued.empty() && (conn.out.empty() || conn.hungup);
+}
+
+inline void RpcServer::close_finished() {
+    std::vector<ConnectionPtr> finished;
+    {
+        std::lock_guard<std::mutex> lock(ready_mutex_);
+        finished.swap(finished_);
+    }
+    for (const auto& conn : finished) {
+        if (!conn->closed) close_connection(conn);
+    }
+}
+
+inline void RpcServer::close_connection(const ConnectionPtr& conn) {
+    int fd = conn->fd;
+    {
+        // Under the connection lock so no worker is mid-send on this fd
+        std::lock_guard<std::mutex> lock(conn->mutex);
+        conn->closed = true;
+        ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+        ::close(fd);
+    }
+    connections_.erase(fd);
+    counters_.open.fetch_sub(1, std::memory_order_relaxed);
+}
+
+inline void RpcServer::run_worker() {
+    RpcWriter out;
+    std::string frames;
+    std::vector<std::chrono::steady_clock::time_point> arrivals;
+    while (true) {
+        ConnectionPtr conn;
+        {
+            std::unique_lock<std::mutex> lock(ready_mutex_);
+            ready_cv_.wait(lock, [this] { return stopping_ || !ready_.empty(); });
+            if (stopping_) return;
+            conn = std::move(ready_.front());
+            ready_.pop_front();
+        }
+        // Keep the connection until it has nothing queued, so its frames
+        // run (and answer) in arrival order
+        while (true) {
+            {
+                std::lock_guard<std::mutex> lock(conn->mutex);
+                if (conn->closed || conn->queued.empty()) {
+                    conn->scheduled = false;
+                    if (!conn->closed && drained(*conn)) {
+                        // Only the event loop closes; hand it the connection
+                        {
+                            std::lock_guard<std::mutex> ready(ready_mutex_);
+                            finished_.push_back(conn);
+                        }
+                        uint64_t one = 1;
+                        [[maybe_unused]] ssize_t n = ::write(wake_fd_, &one, sizeof(one));
+                    }
+                    break;
+                }
+                frames.swap(conn->queued);
+                conn->queued.clear();
+                arrivals.swap(conn->arrivals);
+                conn->arrivals.clear();
+                update_events(*conn);
+            }
+            out.clear();
+            serve(*conn, frames, arrivals, out);
+            std::lock_guard<std::mutex> lock(conn->mutex);
+            if (conn->closed) continue;
+            conn->out.append(out.data());
+            if (conn->writing) {
+                update_events(*conn);
+            } else {
+                flush_out(*conn);
+            }
+        }
+    }
+}
+
+inline void RpcServer::serve(Connection& conn, std::string_view frames,
+                             const std::vector<std::chrono::steady_clock::time_point>& arrivals,
+                             RpcWriter& out) {
+    OperationContext& ctx = conn.session;
+    size_t pos = 0;
+    for (size_t n = 0; pos < frames.size(); n++) {
+        size_t size = rpc_frame_size(frames.substr(pos), frames.size());
+        RpcFrame frame = rpc_decode_frame(frames.substr(pos, size));
+        pos += size;
+        RpcReader args(frame.payload);
+        size_t at = out.begin_frame(frame.id, frame.op);
+        
+        // Each frame is timed from its own arrival, so time spent queued counts
+        ctx.request_id = std::to_string(frame.id);
+        if (conn.timeout.count() > 0) {
+            ctx.deadline = arrivals[n] + conn.timeout;
+        } else {
+            ctx.deadline.reset();
+        }
+        if (ctx.expired()) {
+            out.put_string("Deadline exceeded before execution");
+            counters_.deadline_expired.fetch_add(1, std::memory_order_relaxed);
+            out.end_frame(at, TMSError::OPERATION_TIMEOUT);
+            continue;
+        }
+        OperationScope scope(ctx);
+        TMSError status = execute(conn, frame.op, args, out);
+        out.end_frame(at, status);
+    }
+}
+
+inline TMSError RpcServer::execute(Connection& conn, RpcOp op, RpcReader& args, RpcWriter& out, size_t depth) {
+    size_t mark = out.size();
+    auto fail = [&](TMSError code, const std::string& message) {
+        out.truncate(mark);
+        out.put_string(message);
+        counters_.errors.fetch_add(1, std::memory_order_relaxed);
+        return code;
+    };
+    auto malformed = [&] {
+        return fail(TMSError::INVALID_FORMAT, std::string("Malformed ") + rpc_op_to_string(op) + " request");
+    };
+    auto finish = [&](const OperationResult& result) {
+        if (!args.ok()) return malformed();
+        return result ? TMSError::SUCCESS : fail(result.error_code(), result.error().message);
+    };
+    auto finish_list = [&] {
+        if (out.size() - mark + RPC_HEADER_BYTES > RPC_MAX_FRAME_BYTES) {
+            return fail(TMSError::INVALID_PARAMETER, "Result too large for one frame; give a limit");
+        }
+        return TMSError::SUCCESS;
+    };
+    if (op != RpcOp::BATCH) counters_.requests.fetch_add(1, std::memory_order_relaxed);
+    if (rpc_op_writes(op) && read_only_.load(std::memory_order_acquire)) {
+        return fail(TMSError::INVALID_STATE, "Read-only replica; promote it to accept writes");
+    }
+    if (!handlers_.empty()) {
+        auto handler = handlers_.find(op);
+        if (handler != handlers_.end()) return finish(handler->second(args, out));
+    }
+    
+    switch (op) {
+        case RpcOp::PING:
+            out.put_le<uint16_t>(RPC_PROTOCOL_VERSION);
+            return TMSError::SUCCESS;
+        case RpcOp::VOLUME_EXISTS: {
+            std::string volser(args.get_string());
+            if (!args.ok()) return malformed();
+            out.put_bool(system_.volume_exists(volser));
+            return TMSError::SUCCESS;
+        }
+        case RpcOp::GET_VOLUME: {
+            std::string volser(args.get_string());
+            if (!args.ok()) return malformed();
+            auto result = system_.get_volume(volser);
+            if (!result) return fail(result.error_code(), result.error().message);
+            RpcCodec::write_volume(out, result.value());
+            return TMSError::SUCCESS;
+        }
+        case RpcOp::ADD_VOLUME: {
+            TapeVolume vol = RpcCodec::read_volume(args);
+            if (!args.ok()) return malformed();
+            return finish(system_.add_volume(std::move(vol)));
+        }
+        case RpcOp::PATCH_VOLUME: {
+            std::string volser(args.get_string());
+            VolumePatch patch = RpcCodec::read_volume_patch(args);
+            if (!args.ok()) return malformed();
+            return finish(system_.patch_volume(volser, patch));
+        }
+        case RpcOp::DELETE_VOLUME: {
+            std::string volser(args.get_string());
+            bool force = args.get_bool();
+            if (!args.ok()) return malformed();
+            return finish(system_.delete_volume(volser, force));
+        }
+        case RpcOp::MOUNT_VOLUME:
+        case RpcOp::DISMOUNT_VOLUME:
+        case RpcOp::SCRATCH_VOLUME: {
+            std::string volser(args.get_string());
+            if (!args.ok()) return malformed();
+            if (op == RpcOp::MOUNT_VOLUME) return finish(system_.mount_volume(volser));
+            if (op == RpcOp::DISMOUNT_VOLUME) return finish(system_.dismount_volume(volser));
+            return finish(system_.scratch_volume(volser));
+        }
+        case RpcOp::ALLOCATE_SCRATCH: {
+            std::string pool(args.get_string());
+            std::optional<TapeDensity> wanted = args.get_optional_enum(TapeDensity::DENSITY_LTO9);
+            if (!args.ok()) return malformed();
+            auto result = system_.allocate_scratch_volume(pool, wanted);
+            if (!result) return fail(result.error_code(), result.error().message);
+            out.put_string(result.value());
+            return TMSError::SUCCESS;
+        }
+        case RpcOp::DATASET_EXISTS: {
+            std::string name(args.get_string());
+            if (!args.ok()) return malformed();
+            out.put_bool(system_.dataset_exists(name));
+            return TMSError::SUCCESS;
+        }
+        case RpcOp::GET_DATASET: {
+            std::string name(args.get_string());
+            if (!args.ok()) return malformed();
+            auto result = system_.get_dataset(name);
+            if (!result) return fail(result.error_code(), result.error().message);
+            RpcCodec::write_dataset(out, result.value());
+            return TMSError::SUCCESS;
+        }
+        case RpcOp::ADD_DATASET: {
+            Dataset ds = RpcCodec::read_dataset(args);
+            if (!args.ok()) return malformed();
+            return finish(system_.add_dataset(std::move(ds)));
+        }
+        case RpcOp::PATCH_DATASET: {
+            std::string name(args.get_string());
+            DatasetPatch patch = RpcCodec::read_dataset_patch(args);
+            if (!args.ok()) return malformed();
+            return finish(system_.patch_dataset(name, patch));
+        }
+        case RpcOp::DELETE_DATASET: {
+            std::string name(args.get_string());
+            if (!args.ok()) return malformed();
+            return finish(system_.delete_dataset(name));
+        }
+        case RpcOp::GET_STATISTICS:
+            RpcCodec::write_statistics(out, system_.get_statistics());
+            return TMSError::SUCCESS;
+        case RpcOp::SAVE_CATALOG:
+            return finish(system_.save_catalog());
+        case RpcOp::SET_SESSION: {
+            std::string user(args.get_string());
+            uint32_t timeout_ms = args.get_le<uint32_t>();
+            // A relay such as PartitionRouter names the session it acts for
+            std::string session_id(args.at_end() ? std::string_view() : args.get_string());
+            if (!args.ok()) return malformed();
+            conn.session.user = std::move(user);
+            conn.session.session_id = session_id.empty() ? conn.own_session_id : std::move(session_id);
+            conn.timeout = std::chrono::milliseconds(timeout_ms);
+            out.put_string(conn.session.session_id);
+            return TMSError::SUCCESS;
+        }
+        case RpcOp::BATCH: {
+            if (depth > 0) return fail(TMSError::INVALID_PARAMETER, "BATCH cannot be nested");
+            uint32_t count = args.get_count(6);
+            if (!args.ok()) return malformed();
+            counters_.batches.fetch_add(1, std::memory_order_relaxed);
+            out.put_le<uint32_t>(count);
+            for (uint32_t i = 0; i < count; i++) {
+                auto item_op = static_cast<RpcOp>(args.get_le<uint16_t>());
+                RpcReader item_args(args.get_string());
+                if (!args.ok()) return malformed();
+                out.put_le<uint16_t>(static_cast<uint16_t>(item_op));
+                size_t status_at = out.size();
+                out.put_le<uint16_t>(0);
+                out.put_le<uint32_t>(0);
+                TMSError status = execute(conn, item_op, item_args, out, depth + 1);
+                out.patch_le<uint16_t>(status_at, static_cast<uint16_t>(status));
+                out.patch_le<uint32_t>(status_at + 2, static_cast<uint32_t>(out.size() - status_at - 6));
+                // Each item is held under the frame limit, but together they may not be
+                if (out.size() - mark + RPC_HEADER_BYTES > RPC_MAX_FRAME_BYTES) {
+                    return fail(TMSError::INVALID_PARAMETER, "Batch result too large for one frame after " +
+                                std::to_string(i + 1) + " of " + std::to_string(count) + " items; split the batch");
+                }
+            }
+            return TMSError::SUCCESS;
+        }
+        case RpcOp::LIST_VOLUMES: {
+            std::optional<VolumeStatus> wanted = args.get_optional_enum(VolumeStatus::VOLUME_ERROR);
+            std::string after(args.get_string());
+            uint32_t limit = args.get_le<uint32_t>();
+            if (!args.ok()) return malformed();
+            auto volumes = system_.list_volumes(wanted);
+            volumes.erase(std::remove_if(volumes.begin(), volumes.end(),
+                [&](const TapeVolume& v) { return v.volser <= after; }), volumes.end());
+            rpc_sort_and_limit(volumes, limit, [](const TapeVolume& a, const TapeVolume& b) { return a.volser < b.volser; });
+            RpcCodec::write_volumes(out, volumes);
+            return finish_list();
+        }
+        case RpcOp::SEARCH_VOLUMES: {
+            SearchCriteria criteria = RpcCodec::read_criteria(args);
+            if (!args.ok()) return malformed();
+            // Sorted before the limit is applied, so every server returns its first matches by volser
+            size_t limit = criteria.limit;
+            criteria.limit = 0;
+            auto volumes = system_.search_volumes(criteria);
+            rpc_sort_and_limit(volumes, limit, [](const TapeVolume& a, const TapeVolume& b) { return a.volser < b.volser; });
+            RpcCodec::write_volumes(out, volumes);
+            return finish_list();
+        }
+        case RpcOp::QUERY_VOLUMES:
+        case RpcOp::QUERY_DATASETS: {
+            std::string query(args.get_string());
+            VolumeOrder order = VolumeOrder::VOLSER;
+            bool descending = false;
+            if (op == RpcOp::QUERY_VOLUMES) {
+                order = args.get_enum(VolumeOrder::EXPIRATION);
+                descending = args.get_bool();
+            }
+            uint32_t limit = args.get_le<uint32_t>();
+            if (!args.ok()) return malformed();
+            QueryEngine engine;
+            if (op == RpcOp::QUERY_DATASETS) {
+                std::vector<Dataset> datasets;
+                try {
+                    datasets = engine.query_datasets(engine.parse_query(query), [this] { return system_.list_datasets(); });
+                } catch (const std::regex_error& e) {
+                    return fail(TMSError::INVALID_PARAMETER, std::string("Bad query regex: ") + e.what());
+                }
+                rpc_sort_and_limit(datasets, limit, [](const Dataset& a, const Dataset& b) { return a.name < b.name; });
+                RpcCodec::write_datasets(out, datasets);
+                return finish_list();
+            }
+            std::vector<TapeVolume> volumes;
+            try {
+                volumes = engine.query_volumes(engine.parse_query(query), [this] { return system_.list_volumes(); });
+            } catch (const std::regex_error& e) {
+                return fail(TMSError::INVALID_PARAMETER, std::string("Bad query regex: ") + e.what());
+            }
+            rpc_sort_and_limit(volumes, limit, [order, descending](const TapeVolume& a, const TapeVolume& b) {
+                return volume_order_before(a, b, order, descending);
+            });
+            RpcCodec::write_volumes(out, volumes);
+            return finish_list();
+        }
+        case RpcOp::PROMOTE:
+        case RpcOp::REPLICATION_STATUS:
+        case RpcOp::REPLICATE:
+        case RpcOp::REPL_SNAPSHOT:
+        case RpcOp::REPL_CHANGES:
+        case RpcOp::REPL_HEARTBEAT:
+        case RpcOp::REPL_ACK:
+            return fail(TMSError::NOT_IMPLEMENTED, std::string(rpc_op_to_string(op)) + " is not served here");
+    }
+    return fail(TMSError::NOT_IMPLEMENTED,
+                "Unknown RPC operation " + std::to_string(static_cast<unsigned>(op)));
+}
+
+// ============================================================================
+// Client Implementation
+// ============================================================================
+
+inline OperationResult RpcClient::connect_unix(const std::string& path) {
+    close();
+    sockaddr_un addr{};
+    if (path.size() >= sizeof(addr.sun_path)) {
+        return OperationResult::err(TMSError::INVALID_PARAMETER, "Socket path too long: " + path);
+    }
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+    return connect_to(::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0),
+                      reinterpret_cast<sockaddr*>(&addr), sizeof(addr), path);
+}
+
+inline OperationResult RpcClient::connect_tcp(const std::string& host, uint16_t port) {
+    close();
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    std::string ip = host == "localhost" ? "127.0.0.1" : host;
+    if (::inet_pton(AF_INET, ip.c_str(), &addr.sin_addr) != 1) {
+        return OperationResult::err(TMSError::INVALID_PARAMETER, "Not an IPv4 address: " + host);
+    }
+    int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    auto result = connect_to(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr),
+                             host + ":" + std::to_string(port));
+    if (result) {
+        int one = 1;
+        ::setsockopt(fd_, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    }
+    return result;
+}
+
+inline OperationResult RpcClient::connect_to(int fd, const sockaddr* addr, socklen_t len,
+                                             const std::string& where) {
+    if (fd < 0 || ::connect(fd, addr, len) != 0) {
+        std::string reason = std::strerror(errno);
+        if (fd >= 0) ::close(fd);
+        return OperationResult::err(TMSError::SYSTEM_ERROR, "Cannot connect to " + where + ": " + reason);
+    }
+    fd_ = fd;
+    return OperationResult::ok();
+}
+
+inline void RpcClient::close() {
+    if (fd_ >= 0) ::close(fd_);
+    fd_ = -1;
+    out_.clear();
+    in_.clear();
+    in_pos_ = 0;
+    outstanding_ = 0;
+}
+
+inline OperationResult RpcClient::flush() {
+    if (fd_ < 0) return OperationResult::err(TMSError::INVALID_STATE, "Not connected");
+    const std::string& data = out_.data();
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = ::send(fd_, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n > 0) {
+            sent += static_cast<size_t>(n);
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else {
+            std::string reason = std::strerror(errno);
+            close();
+            return OperationResult::err(TMSError::SYSTEM_ERROR, "Send failed: " + reason);
+        }
+    }
+    out_.clear();
+    return OperationResult::ok();
+}
+
+inline Result<RpcResponse> RpcClient::receive() {
+    using R = Result<RpcResponse>;
+    if (outstanding_ == 0) return R::err(TMSError::INVALID_STATE, "No response outstanding");
+    if (!out_.empty()) {
+        auto sent = flush();
+        if (!sent) return R::err(sent.error_code(), sent.error().message);
+    }
+    auto response = read_frame();
+    if (response) outstanding_--;
+    return response;
+}
+
+inline Result<RpcResponse> RpcClient::receive_stream() {
+    if (fd_ < 0) return Result<RpcResponse>::err(TMSError::INVALID_STATE, "Not connected");
+    return read_frame();
+}
+
+inline OperationResult RpcClient::set_receive_timeout(std::chrono::milliseconds timeout) {
+    if (fd_ < 0) return OperationResult::err(TMSError::INVALID_STATE, "Not connected");
+    timeval tv{};
+    tv.tv_sec = static_cast<time_t>(timeout.count() / 1000);
+    tv.tv_usec = static_cast<suseconds_t>(timeout.count() % 1000 * 1000);
+    if (::setsockopt(fd_, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv)) != 0) {
+        return OperationResult::err(TMSError::SYSTEM_ERROR, std::string("SO_RCVTIMEO: ") + std::strerror(errno));
+    }
+    return OperationResult::ok();
+}
+
+inline Result<RpcResponse> RpcClient::read_frame() {
+    using R = Result<RpcResponse>;
+    while (true) {
+        std::string_view pending = std::string_view(in_).substr(in_pos_);
+        size_t size = rpc_frame_size(pending, static_cast<size_t>(UINT32_MAX) + 4);
+        if (size == RPC_BAD_FRAME) {
+            close();
+            return R::err(TMSError::INVALID_FORMAT, "Malformed response frame");
+        }
+        if (size > 0) {
+            RpcFrame frame = rpc_decode_frame(pending.substr(0, size));
+            RpcResponse response;
+            response.id = frame.id;
+            response.op = frame.op;
+            response.status = frame.status;
+            response.payload = frame.payload;
+            in_pos_ += size;
+            if (in_pos_ == in_.size()) {
+                in_.clear();
+                in_pos_ = 0;
+            }
+            return R::ok(std::move(response));
+        }
+        if (in_pos_ > 0) {
+            in_.erase(0, in_pos_);
+            in_pos_ = 0;
+        }
+        size_t have = in_.size();
+        in_.resize(have + 64 * 1024);
+        ssize_t n = ::recv(fd_, in_.data() + have, 64 * 1024, 0);
+        in_.resize(have + (n > 0 ? static_cast<size_t>(n) : 0));
+        if (n > 0) continue;
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return R::err(TMSError::OPERATION_TIMEOUT, "Receive timed out");
+        }
+        std::string reason = n == 0 ? "connection closed by server" : std::strerror(errno);
+        close();
+        return R::err(TMSError::SYSTEM_ERROR, "Receive failed: " + reason);
+    }
+}
+
+inline Result<std::vector<RpcResponse>> RpcClient::call(const RpcBatch& batch) {
+    auto response = call(RpcOp::BATCH, [&](RpcWriter& w) { batch.write(w); });
+    if (!response) return Result<std::vector<RpcResponse>>::err(response.error().code, response.error().message);
+    return response.value().batch_items();
+}
+
+inline OperationResult RpcClient::ping() {
+    return status_of(call(RpcOp::PING));
+}
+
+inline Result<bool> RpcClient::volume_exists(const std::string& volser) {
+    return value_of<bool>(call(RpcOp::VOLUME_EXISTS, [&](RpcWriter& w) { w.put_string(volser); }),
+                          [](RpcReader& r) { return r.get_bool(); });
+}
+
+inline Result<TapeVolume> RpcClient::get_volume(const std::string& volser) {
+    return value_of<TapeVolume>(call(RpcOp::GET_VOLUME, [&](RpcWriter& w) { w.put_string(volser); }),
+                                RpcCodec::read_volume);
+}
+
+inline OperationResult RpcClient::add_volume(const TapeVolume& volume) {
+    return status_of(call(RpcOp::ADD_VOLUME, [&](RpcWriter& w) { RpcCodec::write_volume(w, volume); }));
+}
+
+inline OperationResult RpcClient::patch_volume(const std::string& volser, const VolumePatch& patch) {
+    return status_of(call(RpcOp::PATCH_VOLUME, [&](RpcWriter& w) {
+        w.put_string(volser);
+        RpcCodec::write_volume_patch(w, patch);
+    }));
+}
+
+inline OperationResult RpcClient::delete_volume(const std::string& volser, bool force) {
+    return status_of(call(RpcOp::DELETE_VOLUME, [&](RpcWriter& w) {
+        w.put_string(volser);
+        w.put_bool(force);
+    }));
+}
+
+inline OperationResult RpcClient::mount_volume(const std::string& volser) {
+    return status_of(call(RpcOp::MOUNT_VOLUME, [&](RpcWriter& w) { w.put_string(volser); }));
+}
+
+inline OperationResult RpcClient::dismount_volume(const std::string& volser) {
+    return status_of(call(RpcOp::DISMOUNT_VOLUME, [&](RpcWriter& w) { w.put_string(volser); }));
+}
+
+inline OperationResult RpcClient::scratch_volume(const std::string& volser) {
+    return status_of(call(RpcOp::SCRATCH_VOLUME, [&](RpcWriter& w) { w.put_string(volser); }));
+}
+
+inline Result<std::string> RpcClient::allocate_scratch_volume(const std::string& pool,
+                                                              std::optional<TapeDensity> density) {
+    auto response = call(RpcOp::ALLOCATE_SCRATCH, [&](RpcWriter& w) {
+        w.put_string(pool);
+        w.put_le<uint8_t>(density ? static_cast<uint8_t>(*density) : 0xFF);
+    });
+    return value_of<std::string>(response, [](RpcReader& r) { return std::string(r.get_string()); });
+}
+
+inline Result<bool> RpcClient::dataset_exists(const std::string& name) {
+    return value_of<bool>(call(RpcOp::DATASET_EXISTS, [&](RpcWriter& w) { w.put_string(name); }),
+                          [](RpcReader& r) { return r.get_bool(); });
+}
+
+inline Result<Dataset> RpcClient::get_dataset(const std::string& name) {
+    return value_of<Dataset>(call(RpcOp::GET_DATASET, [&](RpcWriter& w) { w.put_string(name); }),
+                             RpcCodec::read_dataset);
+}
+
+inline OperationResult RpcClient::add_dataset(const Dataset& dataset) {
+    return status_of(call(RpcOp::ADD_DATASET, [&](RpcWriter& w) { RpcCodec::write_dataset(w, dataset); }));
+}
+
+inline OperationResult RpcClient::patch_dataset(const std::string& name, const DatasetPatch& patch) {
+    return status_of(call(RpcOp::PATCH_DATASET, [&](RpcWriter& w) {
+        w.put_string(name);
+        RpcCodec::write_dataset_patch(w, patch);
+    }));
+}
+
+inline OperationResult RpcClient::delete_dataset(const std::string& name) {
+    return status_of(call(RpcOp::DELETE_DATASET, [&](RpcWriter& w) { w.put_string(name); }));
+}
+
+inline Result<SystemStatistics> RpcClient::get_statistics() {
+    return value_of<SystemStatistics>(call(RpcOp::GET_STATISTICS), RpcCodec::read_statistics);
+}
+
+inline OperationResult RpcClient::save_catalog() {
+    return status_of(call(RpcOp::SAVE_CATALOG));
+}
+
+inline Result<std::vector<TapeVolume>> RpcClient::list_volumes(std::optional<VolumeStatus> status,
+                                                               const std::string& after, size_t limit) {
+    return value_of<std::vector<TapeVolume>>(call(RpcOp::LIST_VOLUMES, [&](RpcWriter& w) {
+        w.put_le<uint8_t>(status ? static_cast<uint8_t>(*status) : 0xFF);
+        w.put_string(after);
+        w.put_le<uint32_t>(static_cast<uint32_t>(limit));
+    }), RpcCodec::read_volumes);
+}
+
+inline Result<std::vector<TapeVolume>> RpcClient::search_volumes(const SearchCriteria& criteria) {
+    return value_of<std::vector<TapeVolume>>(call(RpcOp::SEARCH_VOLUMES, [&](RpcWriter& w) {
+        RpcCodec::write_criteria(w, criteria);
+    }), RpcCodec::read_volumes);
+}
+
+inline Result<std::vector<TapeVolume>> RpcClient::query_volumes(const std::string& query, VolumeOrder order,
+                                                                bool descending, size_t limit) {
+    return value_of<std::vector<TapeVolume>>(call(RpcOp::QUERY_VOLUMES, [&](RpcWriter& w) {
+        w.put_string(query);
+        w.put_le<uint8_t>(static_cast<uint8_t>(order));
+        w.put_bool(descending);
+        w.put_le<uint32_t>(static_cast<uint32_t>(limit));
+    }), RpcCodec::read_volumes);
+}
+
+inline Result<std::vector<Dataset>> RpcClient::query_datasets(const std::string& query, size_t limit) {
+    return value_of<std::vector<Dataset>>(call(RpcOp::QUERY_DATASETS, [&](RpcWriter& w) {
+        w.put_string(query);
+        w.put_le<uint32_t>(static_cast<uint32_t>(limit));
+    }), RpcCodec::read_datasets);
+}
+
+inline Result<std::string> RpcClient::set_session(const std::string& user, std::chrono::milliseconds timeout) {
+    auto response = call(RpcOp::SET_SESSION, [&](RpcWriter& w) {
+        w.put_string(user);
+        w.put_le<uint32_t>(static_cast<uint32_t>(std::max<int64_t>(timeout.count(), 0)));
+    });
+    return value_of<std::string>(response, [](RpcReader& r) { return std::string(r.get_string()); });
+}
+
+#endif // TMS_HAS_RPC
+
+} // namespace tms
+
+#endif // TMS_RPC_H
@@ -0,0 +1,190 @@
+/**
+ * @file tms_symbol.h
+ * @brief TMS Tape Management System - String Interning
+ * @version 3.4.0
+ * @author Bennie Shearer
+ * @copyright Copyright (c) 2025 Bennie Shearer
+ * @license MIT License
+ *
+ * Owners, pools, locations, tags, media types and job names take a few
+ * hundred distinct values across millions of records. Symbol stores one
+ * pointer to a process-wide interned copy instead of a std::string, so
+ * records shrink and equality between symbols is a pointer compare.
+ * Interned strings live until process exit. Ordering is by text, so sets
+ * and maps keyed by Symbol iterate exactly as their std::string versions.
+ */
+
+#ifndef TMS_SYMBOL_H
+#define TMS_SYMBOL_H
+
+#include <array>
+#include <atomic>
+#include <compare>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace tms {
+
+// ============================================================================
+// Symbol Table
+// ============================================================================
+
+/**
+ * @brief Interned string with a compact ID (0 is the empty string)
+ */
+struct SymbolEntry {
+    std::string text;
+    uint32_t id = 0;
+};
+
+/**
+ * @brief Concurrent intern table, sharded by hash
+ *
+ * Lookups of already-interned text take a shard's shared lock only; the
+ * entries themselves are immutable, so reading a symbol's text never locks.
+ */
+class SymbolTable {
+public:
+    static SymbolTable& instance() {
+        static SymbolTable table;
+        return table;
+    }
+    
+    static const SymbolEntry* empty_entry() {
+        static const SymbolEntry entry{};
+        return &entry;
+    }
+    
+    const SymbolEntry* intern(std::string_view text) {
+        if (text.empty()) return empty_entry();
+        size_t hash = std::hash<std::string_view>{}(text);
+        Shard& shard = shards_[hash % SHARDS];
+        {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            auto it = shard.index.find(text);
+            if (it != shard.index.end()) return it->second;
+        }
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.index.find(text);
+        if (it != shard.index.end()) return it->second;
+        // deque::emplace_back never moves existing entries, so the
+        // string_view keys stay valid
+        SymbolEntry& entry = shard.entries.emplace_back();
+        entry.text.assign(text);
+        entry.id = next_id_.fetch_add(1, std::memory_order_relaxed);
+        shard.index.emplace(entry.text, &entry);
+        bytes_.fetch_add(sizeof(SymbolEntry) + entry.text.capacity(), std::memory_order_relaxed);
+        return &entry;
+    }
+    
+    /// The entry for @p text if it has been interned; never adds
+    const SymbolEntry* find(std::string_view text) const {
+        if (text.empty()) return empty_entry();
+        const Shard& shard = shards_[std::hash<std::string_view>{}(text) % SHARDS];
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.index.find(text);
+        return it != shard.index.end() ? it->second : nullptr;
+    }
+    
+    size_t size() const { return next_id_.load(std::memory_order_relaxed) - 1; }
+    size_t memory_bytes() const { return bytes_.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr size_t SHARDS = 16;
+    
+    struct Shard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<std::string_view, const SymbolEntry*> index;
+        std::deque<SymbolEntry> entries;
+    };
+    
+    SymbolTable() = default;
+    
+    std::array<Shard, SHARDS> shards_;
+    std::atomic<uint32_t> next_id_{1};
+    std::atomic<size_t> bytes_{0};
+};
+
+// ============================================================================
+// Symbol
+// ============================================================================
+
+/**
+ * @brief Interned string value
+ *
+ * Converts implicitly from and to std::string so record fields can change
+ * type without touching their users.
+ */
+class Symbol {
+public:
+    Symbol() noexcept : entry_(SymbolTable::empty_entry()) {}
+    Symbol(std::string_view text) : entry_(SymbolTable::instance().intern(text)) {}
+    Symbol(const std::string& text) : Symbol(std::string_view(text)) {}
+    Symbol(const char* text) : Symbol(std::string_view(text)) {}
+    
+    /// Symbol for @p text only if already interned (so nothing can equal it otherwise)
+    static std::optional<Symbol> lookup(std::string_view text) {
+        const SymbolEntry* entry = SymbolTable::instance().find(text);
+        if (!entry) return std::nullopt;
+        return Symbol(entry);
+    }
+    
+    const std::string& str() const noexcept { return entry_->text; }
+    operator const std::string&() const noexcept { return entry_->text; }
+    std::string_view view() const noexcept { return entry_->text; }
+    const char* c_str() const noexcept { return entry_->text.c_str(); }
+    bool empty() const noexcept { return entry_->text.empty(); }
+    size_t size() const noexcept { return entry_->text.size(); }
+    size_t length() const noexcept { return entry_->text.size(); }
+    size_t find(std::string_view s, size_t pos = 0) const noexcept { return view().find(s, pos); }
+    uint32_t id() const noexcept { return entry_->id; }
+    
+    void clear() noexcept { entry_ = SymbolTable::empty_entry(); }
+    
+    friend bool operator==(const Symbol& a, const Symbol& b) noexcept { return a.entry_ == b.entry_; }
+    friend bool operator==(const Symbol& a, std::string_view b) noexcept { return a.view() == b; }
+    friend bool operator==(const Symbol& a, const std::string& b) noexcept { return a.view() == b; }
+    friend bool operator==(const Symbol& a, const char* b) noexcept { return a.view() == b; }
+    
+    friend std::strong_ordering operator<=>(const Symbol& a, const Symbol& b) noexcept {
+        if (a.entry_ == b.entry_) return std::strong_ordering::equal;
+        return a.view() <=> b.view();
+    }
+    friend std::strong_ordering operator<=>(const Symbol& a, std::string_view b) noexcept { return a.view() <=> b; }
+    friend std::strong_ordering operator<=>(const Symbol& a, const std::string& b) noexcept {
+        return a.view() <=> std::string_view(b);
+    }
+    friend std::strong_ordering operator<=>(const Symbol& a, const char* b) noexcept {
+        return a.view() <=> std::string_view(b);
+    }
+    
+    friend std::string operator+(const std::string& a, const Symbol& b) { return a + b.str(); }
+    friend std::string operator+(const Symbol& a, const std::string& b) { return a.str() + b; }
+    friend std::string operator+(const char* a, const Symbol& b) { return a + b.str(); }
+    friend std::string operator+(const Symbol& a, const char* b) { return a.str() + b; }
+    friend std::string operator+(const Symbol& a, char b) { return a.str() + b; }
+    
+    friend std::ostream& operator<<(std::ostream& os, const Symbol& s) { return os << s.str(); }
+
+private:
+    explicit Symbol(const SymbolEntry* entry) noexcept : entry_(entry) {}
+    
+    const SymbolEntry* entry_;
+};
+
+} // namespace tms
+
+template<>
+struct std::hash<tms::Symbol> {
+    size_t operator()(const tms::Symbol& s) const noexcept { return std::hash<uint32_t>{}(s.id()); }
+};
+
+#endif // TMS_SYMBOL_H
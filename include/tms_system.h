@@ -15,6 +15,17 @@
 #include "tms_utils.h"
 #include "error_codes.h"
 #include "logger.h"
+#include "tms_csv.h"
+#include "tms_export.h"
+#include "tms_reports.h"
+#include "tms_versions.h"
+#include "tms_workload.h"
+#include "tms_cdc.h"
+#include "tms_volume_table.h"
+#include "tms_rcu.h"
+#include "tms_memory.h"
+#include "tms_async.h"
+#include "tms_context.h"
 
 #include <map>
 #include <set>
@@ -22,6 +33,13 @@
 #include <optional>
 #include <functional>
 #include <deque>
+#include <atomic>
+#include <unordered_map>
+#include <memory>
+#include <charconv>
+#include <thread>
+#include <condition_variable>
+#include <exception>
 
 namespace tms {
 
@@ -32,13 +50,15 @@ namespace tms {
 template<typename KeyType = std::string>
 class SecondaryIndex {
 public:
-    void add(const std::string& attr_value, const KeyType& key) {
+    void add(const Symbol& attr_value, const KeyType& key) {
         if (!attr_value.empty()) {
             index_[attr_value].insert(key);
         }
     }
     
-    void remove(const std::string& attr_value, const KeyType& key) {
+    /// Accepts a Symbol or any string type; lookups never intern
+    template<typename Value>
+    void remove(const Value& attr_value, const KeyType& key) {
         auto it = index_.find(attr_value);
         if (it != index_.end()) {
             it->second.erase(key);
@@ -48,12 +68,13 @@ public:
         }
     }
     
-    void update(const std::string& old_value, const std::string& new_value, const KeyType& key) {
+    void update(const Symbol& old_value, const Symbol& new_value, const KeyType& key) {
         remove(old_value, key);
         add(new_value, key);
     }
     
-    std::set<KeyType> find(const std::string& attr_value) const {
+    template<typename Value>
+    std::set<KeyType> find(const Value& attr_value) const {
         auto it = index_.find(attr_value);
         if (it != index_.end()) {
             return it->second;
@@ -74,7 +95,7 @@ public:
     size_t size() const { return index_.size(); }
     
 private:
-    std::map<std::string, std::set<KeyType>> index_;
+    std::map<Symbol, std::set<KeyType>, std::less<>> index_;
 };
 
 // ============================================================================
@@ -97,7 +118,7 @@ public:
              const std::string& target, const std::string& details,
              bool success = true) {
         AuditRecord record;
-        record.timestamp = std::chrono::system_clock::now();
+        record.timestamp = current_time();
         record.operation = operation;
         record.user = user;
         record.target = target;
@@ -177,98 +198,330 @@ private:
 // v3.2.0: Snapshot Manager
 // ============================================================================
 
+/**
+ * @brief v3.4.0: Snapshot storage footprint
+ */
+struct SnapshotMemoryStats {
+    size_t snapshots = 0;
+    size_t shared_components = 0;   ///< Distinct dataset lists, tag sets and notes
+    size_t total_bytes = 0;         ///< Actual heap + record bytes
+    size_t unshared_bytes = 0;      ///< Bytes if every snapshot held deep copies
+};
+
+/**
+ * @brief Per-volume snapshot history
+ *
+ * v3.4.0: Snapshots live in fixed-capacity per-volume ring buffers keyed by
+ * integer IDs. Dataset lists, tag sets and notes are immutable and
+ * reference counted: a snapshot whose component equals the previous
+ * snapshot of the same volume shares it instead of copying, so hourly
+ * snapshots of a quiet volume cost little more than the fixed record.
+ * VolumeSnapshot values handed to callers are materialized on read.
+ */
 class SnapshotManager {
 public:
     explicit SnapshotManager(size_t max_snapshots = MAX_SNAPSHOT_HISTORY)
-        : max_snapshots_(max_snapshots) {}
+        : max_snapshots_(max_snapshots == 0 ? 1 : max_snapshots) {}
     
     VolumeSnapshot create_snapshot(const TapeVolume& vol, 
                                    const std::string& user,
                                    const std::string& description = "") {
         std::lock_guard<std::mutex> lock(mutex_);
         
-        VolumeSnapshot snap;
-        snap.snapshot_id = generate_snapshot_id(vol.volser);
-        snap.volser = vol.volser;
-        snap.created = std::chrono::system_clock::now();
+        auto ring_it = rings_.find(vol.volser);
+        if (ring_it == rings_.end()) {
+            ring_it = rings_.emplace(vol.volser, Ring{}).first;
+            ring_it->second.volser = &ring_it->first;
+        }
+        Ring& ring = ring_it->second;
+        const Stored* prev = ring.newest();
+        
+        Stored snap;
+        snap.id = next_id_++;
+        snap.created = current_time();
         snap.created_by = user;
         snap.description = description;
-        snap.status_at_snapshot = vol.status;
-        snap.datasets_at_snapshot = vol.datasets;
-        snap.used_bytes_at_snapshot = vol.used_bytes;
-        snap.mount_count_at_snapshot = vol.mount_count;
-        snap.tags_at_snapshot = vol.tags;
-        snap.notes_at_snapshot = vol.notes;
-        
-        snapshots_[snap.snapshot_id] = snap;
-        volume_snapshots_[vol.volser].push_back(snap.snapshot_id);
+        snap.status = vol.status;
+        snap.used_bytes = vol.used_bytes;
+        snap.mount_count = vol.mount_count;
+        snap.datasets = share(prev ? prev->datasets : nullptr, vol.datasets);
+        snap.tags = share(prev ? prev->tags : nullptr, vol.tags);
+        snap.notes = share(prev ? prev->notes : nullptr, vol.notes);
         
-        // Limit snapshots per volume
-        auto& vol_snaps = volume_snapshots_[vol.volser];
-        while (vol_snaps.size() > max_snapshots_) {
-            std::string oldest = vol_snaps.front();
-            vol_snaps.erase(vol_snaps.begin());
-            snapshots_.erase(oldest);
+        if (ring.slots.size() < max_snapshots_) {
+            ring.slots.push_back(std::move(snap));
+            index_[ring.slots.back().id] = &ring;
+        } else {
+            // Full: overwrite the oldest slot
+            Stored& oldest = ring.slots[ring.head];
+            index_.erase(oldest.id);
+            oldest = std::move(snap);
+            index_[oldest.id] = &ring;
+            ring.head = (ring.head + 1) % ring.slots.size();
         }
         
-        return snap;
+        return materialize(ring, *ring.newest());
     }
     
-    std::optional<VolumeSnapshot> get_snapshot(const std::string& snapshot_id) const {
+    std::optional<VolumeSnapshot> get_snapshot(uint64_t id) const {
         std::lock_guard<std::mutex> lock(mutex_);
-        auto it = snapshots_.find(snapshot_id);
-        if (it != snapshots_.end()) {
-            return it->second;
-        }
-        return std::nullopt;
+        const Ring* ring = nullptr;
+        const Stored* snap = locate(id, ring);
+        if (!snap) return std::nullopt;
+        return materialize(*ring, *snap);
+    }
+    
+    std::optional<VolumeSnapshot> get_snapshot(const std::string& snapshot_id) const {
+        uint64_t id = parse_snapshot_id(snapshot_id);
+        auto snap = id ? get_snapshot(id) : std::nullopt;
+        if (snap && snap->snapshot_id != snapshot_id) return std::nullopt;
+        return snap;
     }
     
+    /// Oldest first
     std::vector<VolumeSnapshot> get_volume_snapshots(const std::string& volser) const {
         std::lock_guard<std::mutex> lock(mutex_);
         std::vector<VolumeSnapshot> result;
-        auto it = volume_snapshots_.find(volser);
-        if (it != volume_snapshots_.end()) {
-            for (const auto& snap_id : it->second) {
-                auto snap_it = snapshots_.find(snap_id);
-                if (snap_it != snapshots_.end()) {
-                    result.push_back(snap_it->second);
-                }
+        auto it = rings_.find(volser);
+        if (it != rings_.end()) {
+            const Ring& ring = it->second;
+            result.reserve(ring.slots.size());
+            for (size_t i = 0; i < ring.slots.size(); i++) {
+                result.push_back(materialize(ring, ring.at(i)));
             }
         }
         return result;
     }
     
+    bool delete_snapshot(uint64_t id) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return erase_locked(id, nullptr);
+    }
+    
+    /// Lookup and removal happen under one lock so a concurrent eviction cannot interleave
     bool delete_snapshot(const std::string& snapshot_id) {
+        uint64_t id = parse_snapshot_id(snapshot_id);
+        if (id == 0) return false;
         std::lock_guard<std::mutex> lock(mutex_);
-        auto it = snapshots_.find(snapshot_id);
-        if (it != snapshots_.end()) {
-            auto& vol_snaps = volume_snapshots_[it->second.volser];
-            vol_snaps.erase(std::remove(vol_snaps.begin(), vol_snaps.end(), snapshot_id), 
-                           vol_snaps.end());
-            snapshots_.erase(it);
-            return true;
-        }
-        return false;
+        return erase_locked(id, &snapshot_id);
     }
     
     size_t count() const {
         std::lock_guard<std::mutex> lock(mutex_);
-        return snapshots_.size();
+        return index_.size();
     }
     
     void clear() {
         std::lock_guard<std::mutex> lock(mutex_);
-        snapshots_.clear();
-        volume_snapshots_.clear();
+        rings_.clear();
+        index_.clear();
+    }
+    
+    /// Bytes attributable to one snapshot (shared components split evenly)
+    size_t memory_usage(uint64_t id) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const Ring* ring = nullptr;
+        const Stored* snap = locate(id, ring);
+        if (!snap) return 0;
+        auto amortized = [](const auto& ptr) {
+            return ptr ? component_bytes(*ptr) / static_cast<size_t>(ptr.use_count()) : 0;
+        };
+        return record_bytes(*snap) + amortized(snap->datasets) + amortized(snap->tags) + amortized(snap->notes);
+    }
+    
+    SnapshotMemoryStats memory_stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        SnapshotMemoryStats stats;
+        std::set<const void*> seen;
+        auto add = [&](const auto& ptr) {
+            if (!ptr) return;
+            size_t bytes = component_bytes(*ptr);
+            stats.unshared_bytes += bytes;
+            if (seen.insert(ptr.get()).second) {
+                stats.total_bytes += bytes;
+                stats.shared_components++;
+            }
+        };
+        for (const auto& [volser, ring] : rings_) {
+            for (const auto& snap : ring.slots) {
+                stats.snapshots++;
+                stats.total_bytes += record_bytes(snap);
+                stats.unshared_bytes += record_bytes(snap);
+                add(snap.datasets);
+                add(snap.tags);
+                add(snap.notes);
+            }
+        }
+        return stats;
+    }
+    
+    /// "SNAP-<volser>-<id>" -> id (0 if malformed)
+    static uint64_t parse_snapshot_id(const std::string& snapshot_id) {
+        size_t dash = snapshot_id.rfind('-');
+        if (dash == std::string::npos || snapshot_id.compare(0, 5, "SNAP-") != 0) return 0;
+        uint64_t id = 0;
+        const char* first = snapshot_id.data() + dash + 1;
+        const char* last = snapshot_id.data() + snapshot_id.size();
+        auto [ptr, ec] = std::from_chars(first, last, id);
+        return (ec == std::errc() && ptr == last) ? id : 0;
     }
     
 private:
+    struct Stored {
+        uint64_t id = 0;
+        std::chrono::system_clock::time_point created;
+        std::string created_by;
+        std::string description;
+        VolumeStatus status = VolumeStatus::SCRATCH;
+        uint64_t used_bytes = 0;
+        int mount_count = 0;
+        std::shared_ptr<const std::vector<std::string>> datasets;
+        std::shared_ptr<const TagSet> tags;
+        std::shared_ptr<const std::string> notes;
+    };
+    
+    struct Ring {
+        const std::string* volser = nullptr;   // Key of this ring in rings_
+        std::vector<Stored> slots;             // Grows to max_snapshots_, then wraps
+        size_t head = 0;                       // Oldest slot once full
+        
+        Stored& at(size_t i) { return slots[(head + i) % slots.size()]; }
+        const Stored& at(size_t i) const { return slots[(head + i) % slots.size()]; }
+        const Stored* newest() const { return slots.empty() ? nullptr : &at(slots.size() - 1); }
+    };
+    
+    template<typename T>
+    static std::shared_ptr<const T> share(const std::shared_ptr<const T>& prev, const T& current) {
+        if (prev && *prev == current) return prev;
+        if (current.empty()) return nullptr;
+        return std::make_shared<const T>(current);
+    }
+    
+    const Stored* locate(uint64_t id, const Ring*& ring) const {
+        auto it = index_.find(id);
+        if (it == index_.end()) return nullptr;
+        ring = it->second;
+        for (const auto& snap : ring->slots) {
+            if (snap.id == id) return &snap;
+        }
+        return nullptr;
+    }
+    
+    /// Caller holds mutex_; when snapshot_id is given it must name the same volume
+    bool erase_locked(uint64_t id, const std::string* snapshot_id) {
+        auto it = index_.find(id);
+        if (it == index_.end()) return false;
+        Ring& ring = *it->second;
+        if (snapshot_id && *snapshot_id != "SNAP-" + *ring.volser + "-" + std::to_string(id)) {
+            return false;
+        }
+        index_.erase(it);
+        
+        // Rare: linearize the ring without the deleted entry
+        std::vector<Stored> kept;
+        kept.reserve(ring.slots.size());
+        for (size_t i = 0; i < ring.slots.size(); i++) {
+            if (ring.at(i).id != id) kept.push_back(std::move(ring.at(i)));
+        }
+        ring.slots = std::move(kept);
+        ring.head = 0;
+        if (ring.slots.empty()) {
+            std::string volser = *ring.volser;
+            rings_.erase(volser);
+        }
+        return true;
+    }
+    
+    static VolumeSnapshot materialize(const Ring& ring, const Stored& snap) {
+        VolumeSnapshot out;
+        out.id = snap.id;
+        out.snapshot_id = "SNAP-" + *ring.volser + "-" + std::to_string(snap.id);
+        out.volser = *ring.volser;
+        out.created = snap.created;
+        out.created_by = snap.created_by;
+        out.description = snap.description;
+        out.status_at_snapshot = snap.status;
+        if (snap.datasets) out.datasets_at_snapshot = *snap.datasets;
+        out.used_bytes_at_snapshot = snap.used_bytes;
+        out.mount_count_at_snapshot = snap.mount_count;
+        if (snap.tags) out.tags_at_snapshot = *snap.tags;
+        if (snap.notes) out.notes_at_snapshot = *snap.notes;
+        return out;
+    }
+    
+    static size_t record_bytes(const Stored& snap) {
+        return sizeof(Stored) + snap.created_by.capacity() + snap.description.capacity();
+    }
+    static size_t component_bytes(const std::vector<std::string>& v) {
+        size_t bytes = sizeof(v) + v.capacity() * sizeof(std::string);
+        for (const auto& s : v) bytes += s.capacity() > 15 ? s.capacity() : 0;
+        return bytes;
+    }
+    static size_t component_bytes(const TagSet& s) {
+        return sizeof(s) + s.size() * (4 * sizeof(void*) + sizeof(Symbol));
+    }
+    static size_t component_bytes(const std::string& s) {
+        return sizeof(s) + (s.capacity() > 15 ? s.capacity() : 0);
+    }
+    
     mutable std::mutex mutex_;
-    std::map<std::string, VolumeSnapshot> snapshots_;
-    std::map<std::string, std::vector<std::string>> volume_snapshots_;
+    std::map<std::string, Ring> rings_;
+    std::unordered_map<uint64_t, Ring*> index_;
+    uint64_t next_id_ = 1;
     size_t max_snapshots_;
 };
 
+// ============================================================================
+// v3.4.0: Catalog Cursor
+// ============================================================================
+
+/**
+ * @brief Key-ordered pull cursor over a catalog map
+ *
+ * Records are copied out in batches of @p batch_size, each under a short
+ * shared lock, so a long-running consumer (e.g. a report streaming to a
+ * slow socket) never blocks writers for the whole scan. Records changed
+ * between batches are seen in their latest state; the scan resumes after
+ * the last key returned.
+ */
+template<typename Record>
+class CatalogCursor {
+public:
+    using FetchFn = std::function<void(const std::string* after, size_t limit, std::vector<Record>& out)>;
+    using KeyFn = const std::string& (*)(const Record&);
+    
+    CatalogCursor(FetchFn fetch, KeyFn key, size_t batch_size)
+        : fetch_(std::move(fetch)), key_(key), batch_size_(batch_size == 0 ? 1 : batch_size) {}
+    
+    /// Next record, or nullptr at the end; valid until the following call
+    const Record* next() {
+        if (pos_ == batch_.size()) {
+            if (exhausted_) return nullptr;
+            bool first = fetched_ == 0;
+            std::string after = first ? std::string() : key_(batch_.back());
+            batch_.clear();
+            pos_ = 0;
+            fetch_(first ? nullptr : &after, batch_size_, batch_);
+            exhausted_ = batch_.size() < batch_size_;
+            if (batch_.empty()) return nullptr;
+        }
+        fetched_++;
+        return &batch_[pos_++];
+    }
+    
+    const Record* operator()() { return next(); }
+    size_t fetched() const { return fetched_; }
+    
+private:
+    FetchFn fetch_;
+    KeyFn key_;
+    size_t batch_size_;
+    std::vector<Record> batch_;
+    size_t pos_ = 0;
+    size_t fetched_ = 0;
+    bool exhausted_ = false;
+};
+
 // ============================================================================
 // TMSSystem Class
 // ============================================================================
@@ -287,9 +540,11 @@ public:
     // ========================================================================
     
     OperationResult add_volume(const TapeVolume& volume);
+    OperationResult add_volume(TapeVolume&& volume);
     OperationResult delete_volume(const std::string& volser, bool force = false);
     Result<TapeVolume> get_volume(const std::string& volser) const;
     OperationResult update_volume(const TapeVolume& volume);
+    OperationResult update_volume(TapeVolume&& volume);
     std::vector<TapeVolume> list_volumes(std::optional<VolumeStatus> status = std::nullopt) const;
     std::vector<TapeVolume> search_volumes(const SearchCriteria& criteria) const;
     size_t get_volume_count() const;
@@ -302,6 +557,15 @@ public:
                                             const std::string& pool, 
                                             const std::string& status_str) const;
     
+    // v3.4.0: Copy-free access. Visitors run under the shared catalog lock,
+    // so they must not call back into the catalog or keep the reference.
+    using VolumeVisitor = std::function<void(const TapeVolume&)>;
+    using DatasetVisitor = std::function<void(const Dataset&)>;
+    /// Call @p visit with the stored volume; false if there is none
+    bool read_volume(const std::string& volser, const VolumeVisitor& visit) const;
+    /// Change only the fields set in @p patch, in place
+    OperationResult patch_volume(const std::string& volser, const VolumePatch& patch);
+    
     // ========================================================================
     // Volume Batch Operations
     // ========================================================================
@@ -348,6 +612,110 @@ public:
     OperationResult delete_snapshot(const std::string& snapshot_id);
     OperationResult restore_from_snapshot(const std::string& snapshot_id);
     size_t get_snapshot_count() const;
+    // v3.4.0: Snapshot storage footprint (shared components counted once)
+    SnapshotMemoryStats get_snapshot_memory_stats() const { return snapshot_manager_.memory_stats(); }
+    size_t get_snapshot_memory_usage(uint64_t snapshot_id) const { return snapshot_manager_.memory_usage(snapshot_id); }
+    
+    // ========================================================================
+    // v3.4.0: Catalog Version History (time-travel reads)
+    // ========================================================================
+    
+    using TimePoint = std::chrono::system_clock::time_point;
+    
+    /**
+     * @brief Retain prior record versions for @p horizon (0 disables)
+     *
+     * History starts when retention is enabled; a background thread drops
+     * versions older than the horizon. Disabling discards all history.
+     */
+    void set_history_retention(std::chrono::seconds horizon);
+    std::chrono::seconds get_history_retention() const { return std::chrono::seconds(history_retention_.load()); }
+    size_t compact_history();
+    VersionHistoryStats get_history_stats() const;
+    
+    Result<TapeVolume> get_volume(const std::string& volser, TimePoint as_of) const;
+    Result<Dataset> get_dataset(const std::string& name, TimePoint as_of) const;
+    Result<std::vector<TapeVolume>> list_volumes(TimePoint as_of,
+                                                 std::optional<VolumeStatus> status = std::nullopt) const;
+    Result<std::vector<Dataset>> list_datasets(TimePoint as_of,
+                                               std::optional<DatasetStatus> status = std::nullopt) const;
+    Result<std::vector<TapeVolume>> search_volumes(const SearchCriteria& criteria, TimePoint as_of) const;
+    
+    // ========================================================================
+    // v3.4.0: Workload Capture and Replay
+    // ========================================================================
+    
+    /**
+     * @brief Record catalog operations to @p path until stopped
+     *
+     * Saves the catalog first and copies it to "<path>.base" so a replay
+     * can start from the state the capture started from.
+     */
+    OperationResult start_workload_capture(const std::string& path);
+    void stop_workload_capture();
+    bool is_capturing_workload() const { return capturing_.load(std::memory_order_relaxed); }
+    
+    /**
+     * @brief Drive this catalog with captured events
+     */
+    ReplayReport replay_workload(const std::vector<WorkloadEvent>& events,
+                                 const ReplayOptions& options = ReplayOptions());
+    LockContentionStats get_lock_contention_stats() const;
+    
+    // ========================================================================
+    // v3.4.0: Change Data Capture
+    // ========================================================================
+    
+    /**
+     * @brief Stream every committed volume and dataset change to a ChangeLog
+     *
+     * Changes are numbered in commit order and carry the record's after
+     * image; the directory defaults to "<data directory>/cdc".
+     */
+    OperationResult enable_change_stream(ChangeLogOptions options = ChangeLogOptions());
+    void disable_change_stream();
+    /// The active change log for subscribing or reading; nullptr when disabled
+    std::shared_ptr<ChangeLog> get_change_stream() const;
+    
+    // ========================================================================
+    // v3.4.0: Replication (see tms_replication.h)
+    // ========================================================================
+    
+    /**
+     * @brief Copy of the catalog and the change sequence it reflects
+     *
+     * Copied under the shared lock, so the image holds every change up to
+     * the returned sequence and none after it. Needs the change stream.
+     */
+    Result<CatalogSnapshot> snapshot_for_replication() const;
+    
+    /// Replace the whole catalog with a primary's snapshot
+    void install_replica_snapshot(CatalogSnapshot snapshot);
+    
+    /// Apply a primary's changes, in order, as one write
+    void apply_replicated_changes(const std::vector<ChangeRecord>& changes);
+    
+    /// Hot volume table used by catalog scans (see tms_volume_table.h)
+    VolumeTableStats get_volume_table_stats() const;
+    
+    // ========================================================================
+    // v3.4.0: Lock-Free Reads
+    // ========================================================================
+    
+    /**
+     * @brief Serve point lookups from published immutable records
+     *
+     * get_volume, volume_exists, get_volume_health, read_volume and their
+     * dataset counterparts then take no catalog lock. Each write publishes
+     * its records as it commits, so a thread always reads its own writes.
+     * Costs a second copy of every record (see tms_rcu.h).
+     */
+    void enable_lock_free_reads();
+    void disable_lock_free_reads();
+    bool lock_free_reads_enabled() const { return lock_free_reads_.load(std::memory_order_relaxed); }
+    
+    /// This catalog's node arena followed by the process-wide scratch arenas (see tms_memory.h)
+    std::vector<ArenaStats> get_arena_stats() const;
     
     // ========================================================================
     // v3.2.0: Volume Health
@@ -396,9 +764,13 @@ public:
     // ========================================================================
     
     OperationResult add_dataset(const Dataset& dataset);
+    OperationResult add_dataset(Dataset&& dataset);
     OperationResult delete_dataset(const std::string& name);
     Result<Dataset> get_dataset(const std::string& name) const;
     OperationResult update_dataset(const Dataset& dataset);
+    OperationResult update_dataset(Dataset&& dataset);
+    bool read_dataset(const std::string& name, const DatasetVisitor& visit) const;
+    OperationResult patch_dataset(const std::string& name, const DatasetPatch& patch);
     std::vector<Dataset> list_datasets(std::optional<DatasetStatus> status = std::nullopt) const;
     std::vector<Dataset> list_datasets_on_volume(const std::string& volser) const;
     std::vector<Dataset> search_datasets(const SearchCriteria& criteria) const;
@@ -478,6 +850,39 @@ public:
     Result<BatchResult> import_volumes_from_csv(const std::string& file_path);
     Result<BatchResult> import_datasets_from_csv(const std::string& file_path);
     
+    // v3.4.0: Bulk CSV import (parallel parse/validate, batched commit)
+    Result<CsvImportReport> bulk_import_volumes_csv(const std::string& file_path,
+                                                    const CsvImportOptions& options = CsvImportOptions());
+    Result<CsvImportReport> bulk_import_datasets_csv(const std::string& file_path,
+                                                     const CsvImportOptions& options = CsvImportOptions());
+    
+    /// Rejection callback for bulk adds: (index into input, reason)
+    using BulkRejectFn = std::function<void(size_t index, const std::string& message)>;
+    
+    /**
+     * @brief Add many volumes under a single catalog lock
+     *
+     * Applies the same defaults and checks as add_volume() but writes one
+     * summary audit record. Accepted entries are moved out of @p volumes;
+     * rejected entries are left intact and reported through @p on_reject.
+     */
+    BatchResult bulk_add_volumes(std::vector<TapeVolume>& volumes, const BulkRejectFn& on_reject = nullptr);
+    BatchResult bulk_add_datasets(std::vector<Dataset>& datasets, const BulkRejectFn& on_reject = nullptr);
+    
+    // v3.4.0: Parallel export engine (CSV, JSON Lines, binary)
+    using VolumeFilter = std::function<bool(const TapeVolume&)>;
+    using DatasetFilter = std::function<bool(const Dataset&)>;
+    Result<ExportReport> export_volumes(const std::string& file_path,
+                                        const ExportOptions& options = ExportOptions(),
+                                        const VolumeFilter& filter = nullptr) const;
+    Result<ExportReport> export_datasets(const std::string& file_path,
+                                         const ExportOptions& options = ExportOptions(),
+                                         const DatasetFilter& filter = nullptr) const;
+    
+    // v3.4.0: Streaming JSON catalog exchange (constant memory)
+    OperationResult export_to_json(const std::string& file_path) const;
+    Result<BatchResult> import_from_json(const std::string& file_path);
+    
     // ========================================================================
     // Reports
     // ========================================================================
@@ -489,6 +894,26 @@ public:
     void generate_expiration_report(std::ostream& os) const;
     void generate_health_report(std::ostream& os) const;  // v3.2.0
     
+    // v3.4.0: Streaming reports over a batched catalog cursor
+    CatalogCursor<TapeVolume> volume_cursor(size_t batch_size = 1024) const;
+    CatalogCursor<Dataset> dataset_cursor(size_t batch_size = 1024) const;
+    size_t write_volume_report(ReportSink& sink, ReportFormat format,
+                               const ReportOptions& options = ReportOptions{}) const;
+    size_t write_volume_report(ReportPager& pager, ReportFormat format,
+                               const ReportOptions& options = ReportOptions{}) const;
+    size_t write_dataset_report(ReportSink& sink, ReportFormat format,
+                                const ReportOptions& options = ReportOptions{}) const;
+    
+    // v3.4.0: Materialized reports, served from cache until the catalog changes
+    std::vector<PoolStatistics> get_all_pool_statistics() const;
+    Result<std::string> get_cached_report(ReportType type, ReportFormat format,
+                                          const ReportOptions& options = ReportOptions{}) const;
+    ReportCacheStats get_report_cache_stats() const { return report_cache_.stats(); }
+    void clear_report_cache() { report_cache_.clear(); }
+    /// Max age for clock-dependent reports (expiration, health, statistics)
+    void set_report_cache_max_age(std::chrono::seconds max_age) { report_cache_max_age_.store(max_age.count()); }
+    uint64_t catalog_generation() const { return catalog_generation_.load(std::memory_order_acquire); }
+    
     // ========================================================================
     // v3.3.0: Encryption Metadata
     // ========================================================================
@@ -568,6 +993,42 @@ public:
     RetryableResult retry_operation(std::function<OperationResult()> operation) const;
     SystemStatistics get_statistics() const;
     
+    // ========================================================================
+    // v3.4.0: Asynchronous API
+    // ========================================================================
+    
+    /**
+     * Each *_async call returns a lazy Task that runs on the system's
+     * executor when awaited (AsyncExecutor::shared() unless one is set).
+     * Catalog files are transferred with AsyncExecutor::read_file and
+     * write_file; calls without an asynchronous form run on the executor's
+     * I/O pool. The system must outlive the tasks it returns.
+     */
+    void set_executor(std::shared_ptr<AsyncExecutor> executor);
+    std::shared_ptr<AsyncExecutor> get_executor() const;
+    
+    Task<OperationResult> mount_volume_async(std::string volser);
+    Task<OperationResult> dismount_volume_async(std::string volser);
+    Task<OperationResult> save_catalog_async();
+    Task<OperationResult> load_catalog_async();
+    Task<OperationResult> backup_catalog_async(std::string path = "");
+    Task<Result<ExportReport>> export_volumes_async(std::string file_path,
+                                                    ExportOptions options = ExportOptions(),
+                                                    VolumeFilter filter = nullptr);
+    Task<Result<ExportReport>> export_datasets_async(std::string file_path,
+                                                     ExportOptions options = ExportOptions(),
+                                                     DatasetFilter filter = nullptr);
+    Task<OperationResult> export_to_json_async(std::string file_path);
+    Task<Result<BatchResult>> import_from_json_async(std::string file_path);
+    Task<Result<CsvImportReport>> bulk_import_volumes_csv_async(std::string file_path,
+                                                                CsvImportOptions options = CsvImportOptions());
+    Task<Result<CsvImportReport>> bulk_import_datasets_csv_async(std::string file_path,
+                                                                 CsvImportOptions options = CsvImportOptions());
+    
+    /// retry_operation() with the delays between attempts spent as executor timers
+    Task<RetryableResult> retry_operation_async(std::function<Task<OperationResult>()> operation);
+    Task<RetryableResult> retry_operation_async(std::function<OperationResult()> operation);
+    
     // ========================================================================
     // Audit
     // ========================================================================
@@ -593,8 +1054,12 @@ public:
     
     const std::string& get_data_directory() const { return data_directory_; }
     static bool ensure_directory_exists(const std::string& path);
-    void set_current_user(const std::string& user) { current_user_ = user; }
-    std::string get_current_user() const { return current_user_; }
+    /// Default user for calls whose OperationContext names none
+    void set_current_user(const std::string& user) {
+        default_user_.store(std::make_shared<const std::string>(user), std::memory_order_release);
+    }
+    /// User this thread's calls are attributed to
+    std::string get_current_user() const;
     size_t get_regex_cache_size() const { return RegexCache::instance().size(); }
     void clear_regex_cache() { RegexCache::instance().clear(); }
     
@@ -604,14 +1069,126 @@ private:
     void update_volume_dataset_list(const std::string& volser, const std::string& dataset_name, bool add);
     void rebuild_indices();
     
+    // v3.4.0: Catalog file format, shared by the blocking and async paths.
+    // The writers expect catalog_mutex_ held; the reader takes the write
+    // lock itself and skips a null stream.
+    void write_volume_catalog(std::ostream& out) const;
+    void write_dataset_catalog(std::ostream& out) const;
+    void read_catalog(std::istream* volumes_in, std::istream* datasets_in);
+    std::pair<std::string, std::string> backup_file_paths(const std::string& path) const;
+    
+    // v3.4.0: Exclusive catalog lock; hands the write's record changes to
+    // the change stream before releasing. A write left by an exception
+    // commits nothing: its noted changes are dropped, not published.
+    class CatalogWriteLock {
+    public:
+        CatalogWriteLock(TMSSystem& system, std::unique_lock<std::shared_mutex> lock)
+            : system_(&system), lock_(std::move(lock)), uncaught_(std::uncaught_exceptions()) {}
+        CatalogWriteLock(CatalogWriteLock&&) noexcept = default;
+        CatalogWriteLock& operator=(CatalogWriteLock&&) = delete;
+        ~CatalogWriteLock() {
+            if (!lock_.owns_lock()) return;
+            if (std::uncaught_exceptions() > uncaught_) {
+                system_->discard_changes();
+                lock_.unlock();
+                return;
+            }
+            // A destructor cannot report a failed commit; log it and drop the changes
+            try {
+                system_->commit_changes();
+            } catch (...) {
+                system_->discard_changes();
+                TMS_LOG_ERROR("TMSSystem", "Committing a catalog write failed; its changes were not published");
+            }
+            lock_.unlock();
+        }
+        
+        void unlock() {
+            if (!lock_.owns_lock()) return;
+            system_->commit_changes();
+            lock_.unlock();
+        }
+        bool owns_lock() const { return lock_.owns_lock(); }
+        
+    private:
+        TMSSystem* system_;
+        std::unique_lock<std::shared_mutex> lock_;
+        int uncaught_;
+    };
+    
+    // v3.4.0: Advances catalog_generation_ so cached reports built before
+    // this write are no longer served
+    CatalogWriteLock lock_for_write();
+    std::string cached_report_text(const std::string& key, std::chrono::seconds max_age,
+                                   const std::function<std::string()>& build) const;
+    
+    // v3.4.0: Version history; callers hold the write lock
+    void retire_volume(const std::string& volser, const TapeVolume* before) {
+        hot_dirty_.push_back(volser);
+        if (history_retention_.load(std::memory_order_relaxed) > 0) volume_history_.retire(volser, before, write_time_);
+        if (change_log_ || capturing_.load(std::memory_order_relaxed)) note_volume_change(volser, before);
+    }
+    void retire_dataset(const std::string& name, const Dataset* before) {
+        if (lock_free_reads_.load(std::memory_order_relaxed)) published_dirty_datasets_.push_back(name);
+        if (history_retention_.load(std::memory_order_relaxed) > 0) dataset_history_.retire(name, before, write_time_);
+        if (change_log_ || capturing_.load(std::memory_order_relaxed)) note_dataset_change(name, before);
+    }
+    OperationResult check_as_of(TimePoint as_of) const;
+    template<typename Fn> void for_each_volume_as_of(TimePoint as_of, Fn&& fn) const;
+    template<typename Fn> void for_each_dataset_as_of(TimePoint as_of, Fn&& fn) const;
+    bool volume_matches(const TapeVolume& vol, const SearchCriteria& criteria,
+                        const CriteriaSymbols& symbols) const;
+    void stop_history_compactor();
+    
+    // v3.4.0: Workload capture; no-ops unless a capture is running
+    void capture_event(WorkloadEvent event) const;
+    void capture_mutation(const std::string& operation, const std::string& target,
+                          const std::string& details, bool success);
+    std::optional<OperationResult> replay_event(const WorkloadEvent& event);
+    
+    // v3.4.0: Change data capture (also feeds workload capture); callers hold the write lock
+    void note_volume_change(const std::string& volser, const TapeVolume* before);
+    void note_dataset_change(const std::string& name, const Dataset* before);
+    void note_catalog_replaced();
+    void commit_changes();
+    void discard_changes() noexcept;
+    
+    // v3.4.0: Hot volume table; callers hold catalog_mutex_ (shared or exclusive)
+    const VolumeHotTable& hot_volumes() const;
+    void commit_hot_volumes();
+    
+    // v3.4.0: Lock-free reads. read_published() calls @p fn with the
+    // published record (nullptr if none) and returns its result, or nullopt
+    // when the caller must take the shared lock instead.
+    template<typename Map, typename Fn>
+    auto read_published(const Map& map, const std::string& key, Fn&& fn) const
+        -> std::optional<decltype(fn(nullptr))> {
+        if (!lock_free_reads_.load(std::memory_order_acquire)) return std::nullopt;
+        auto guard = EpochDomain::instance().pin();
+        if (!guard.active() || !lock_free_reads_.load(std::memory_order_acquire)) return std::nullopt;
+        return fn(map.find(key));
+    }
+    void publish_changes();
+    
+    // v3.4.0: Cursor batch fetch; copies up to @p limit records after @p after
+    void fetch_volumes(const std::string* after, size_t limit, std::vector<TapeVolume>& out) const;
+    void fetch_datasets(const std::string* after, size_t limit, std::vector<Dataset>& out) const;
+    
+    // v3.4.0: Export helpers; caller holds catalog_mutex_ (shared)
+    Result<ExportReport> export_volumes_locked(std::ostream& out, const ExportOptions& options,
+                                               const VolumeFilter& filter) const;
+    Result<ExportReport> export_datasets_locked(std::ostream& out, const ExportOptions& options,
+                                                const DatasetFilter& filter) const;
+    
     std::string data_directory_;
     std::string volume_catalog_path_;
     std::string dataset_catalog_path_;
-    std::string current_user_ = "SYSTEM";
+    std::atomic<std::shared_ptr<const std::string>> default_user_{std::make_shared<const std::string>("SYSTEM")};
     
     mutable std::shared_mutex catalog_mutex_;
-    std::map<std::string, TapeVolume> volumes_;
-    std::map<std::string, Dataset> datasets_;
+    CatalogArena catalog_arena_;                // Record map nodes; declared before the maps
+    std::pmr::map<std::string, TapeVolume> volumes_{catalog_arena_.resource()};
+    std::pmr::map<std::string, Dataset> datasets_{catalog_arena_.resource()};
     
     SecondaryIndex<std::string> volume_owner_index_;
     SecondaryIndex<std::string> volume_pool_index_;
@@ -629,6 +1206,52 @@ private:
     RetryPolicy retry_policy_;
     
     std::chrono::steady_clock::time_point start_time_;
+    
+    // v3.4.0 members
+    std::atomic<uint64_t> catalog_generation_{0};
+    mutable ReportCache report_cache_;
+    std::atomic<int64_t> report_cache_max_age_{60};
+    
+    TimePoint write_time_{};                    // Set by lock_for_write(); strictly increasing
+    VersionHistory<TapeVolume> volume_history_;
+    VersionHistory<Dataset> dataset_history_;
+    std::atomic<int64_t> history_retention_{0};
+    std::thread history_compactor_;
+    std::mutex compactor_mutex_;
+    std::condition_variable compactor_cv_;
+    bool compactor_stop_ = false;
+    
+    std::atomic<bool> capturing_{false};
+    std::atomic<std::shared_ptr<WorkloadWriter>> capture_writer_;
+    std::atomic<std::shared_ptr<AsyncExecutor>> executor_;
+    std::atomic<uint64_t> lock_acquisitions_{0};
+    std::atomic<uint64_t> lock_contended_{0};
+    std::atomic<uint64_t> lock_wait_ns_{0};
+    
+    // Record state before the current write, for change classification
+    struct PendingChange {
+        ChangeEntity entity;
+        std::string key;
+        bool existed = false;
+        int status = 0;
+        bool reserved = false;
+        size_t tags = 0;
+    };
+    std::shared_ptr<ChangeLog> change_log_;     // Guarded by catalog_mutex_
+    std::vector<PendingChange> pending_changes_;
+    std::set<std::pair<ChangeEntity, std::string>> pending_keys_;   // Records already in pending_changes_
+    
+    // Stale rows are rebuilt by the first scan under the shared lock;
+    // hot_volumes_mutex_ keeps concurrent readers from rebuilding twice
+    mutable VolumeHotTable hot_volumes_;
+    mutable std::mutex hot_volumes_mutex_;
+    std::vector<std::string> hot_dirty_;        // Volumes retired by the current write
+    
+    // Written only under the exclusive lock, as each write commits
+    std::atomic<bool> lock_free_reads_{false};
+    RcuMap<TapeVolume, &TapeVolume::volser> published_volumes_;
+    RcuMap<Dataset, &Dataset::name> published_datasets_;
+    std::vector<std::string> published_dirty_datasets_;
 };
 
 } // namespace tms
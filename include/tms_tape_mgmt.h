@@ -21,6 +21,21 @@
  *   - tms_history.h    - Statistics history (v3.0.0)
  *   - tms_integrity.h  - Integrity verification (v3.0.0)
  *   - tms_query.h      - Query language (v3.0.0)
+ *   - tms_csv.h        - CSV parsing and bulk import (v3.4.0)
+ *   - tms_export.h     - Parallel CSV/JSONL/binary export (v3.4.0)
+ *   - tms_versions.h   - Catalog version history (v3.4.0)
+ *   - tms_workload.h   - Workload capture and replay (v3.4.0)
+ *   - tms_clock.h      - Pluggable clock and simulated time (v3.4.0)
+ *   - tms_cdc.h        - Change data capture log (v3.4.0)
+ *   - tms_symbol.h     - String interning (v3.4.0)
+ *   - tms_volume_table.h - Hot volume scan table (v3.4.0)
+ *   - tms_rcu.h        - Epoch-based record publication (v3.4.0)
+ *   - tms_memory.h     - Memory arenas and allocation counters (v3.4.0)
+ *   - tms_rpc.h        - Catalog daemon RPC protocol, server and client (v3.4.0)
+ *   - tms_async.h      - Coroutine tasks and async executor (v3.4.0)
+ *   - tms_context.h    - Per-call operation context (v3.4.0)
+ *   - tms_replication.h - Hot-standby log shipping (v3.4.0)
+ *   - tms_partition.h  - Volser-range partitioned catalog (v3.4.0)
  */
 
 #ifndef TMS_TAPE_MGMT_H
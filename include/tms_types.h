@@ -11,11 +11,14 @@
 #ifndef TMS_TYPES_H
 #define TMS_TYPES_H
 
+#include "tms_clock.h"
+#include "tms_symbol.h"
 #include <string>
 #include <vector>
 #include <map>
 #include <set>
 #include <optional>
+#include <string_view>
 #include <chrono>
 #include <deque>
 #include <algorithm>
@@ -23,6 +26,10 @@
 
 namespace tms {
 
+/// Tag set; ordered by text, with heterogeneous lookup so probing for a tag
+/// never interns it
+using TagSet = std::set<Symbol, std::less<>>;
+
 // ============================================================================
 // Enumerations
 // ============================================================================
@@ -118,7 +125,7 @@ enum class LifecycleAction {
  * @brief v3.2.0: Location history entry for tracking volume movements
  */
 struct LocationHistoryEntry {
-    std::string location;                                   ///< Location value
+    Symbol location;                                        ///< Location value
     std::chrono::system_clock::time_point timestamp;        ///< When moved
     std::string moved_by;                                   ///< User who moved it
     std::string reason;                                     ///< Reason for move
@@ -157,6 +164,7 @@ struct VolumeHealthScore {
  */
 struct VolumeSnapshot {
     std::string snapshot_id;                                ///< Unique snapshot ID
+    uint64_t id = 0;                                        ///< v3.4.0: Numeric snapshot ID
     std::string volser;                                     ///< Source volume
     std::chrono::system_clock::time_point created;          ///< Creation time
     std::string created_by;                                 ///< Creator
@@ -165,7 +173,7 @@ struct VolumeSnapshot {
     std::vector<std::string> datasets_at_snapshot;          ///< Datasets present
     uint64_t used_bytes_at_snapshot = 0;                    ///< Used space
     int mount_count_at_snapshot = 0;                        ///< Mount count
-    std::set<std::string> tags_at_snapshot;                 ///< Tags present
+    TagSet tags_at_snapshot;                                ///< Tags present
     std::string notes_at_snapshot;                          ///< Notes
 };
 
@@ -315,6 +323,7 @@ struct RetryableResult {
     int total_delay_ms = 0;
     std::string last_error;
     std::vector<std::string> attempt_errors;
+    bool deadline_exceeded = false;     ///< v3.4.0: Stopped early for the caller's deadline
     
     bool required_retry() const { return attempts_made > 1; }
 };
@@ -449,9 +458,9 @@ struct TapeVolume {
     std::string volser;                                         ///< Volume serial (1-6 chars)
     VolumeStatus status = VolumeStatus::SCRATCH;                ///< Current status
     TapeDensity density = TapeDensity::DENSITY_LTO3;           ///< Tape density
-    std::string location;                                       ///< Physical location
-    std::string pool;                                           ///< Pool assignment
-    std::string owner;                                          ///< Owner ID
+    Symbol location;                                            ///< Physical location (interned)
+    Symbol pool;                                                ///< Pool assignment (interned)
+    Symbol owner;                                               ///< Owner ID (interned)
     std::chrono::system_clock::time_point creation_date;        ///< Creation timestamp
     std::chrono::system_clock::time_point expiration_date;      ///< Expiration timestamp
     std::chrono::system_clock::time_point last_used;            ///< Last used timestamp
@@ -461,7 +470,7 @@ struct TapeVolume {
     uint64_t used_bytes = 0;                                    ///< Used space
     int error_count = 0;                                        ///< Error counter
     std::vector<std::string> datasets;                          ///< Dataset names on volume
-    std::set<std::string> tags;                                 ///< Custom tags
+    TagSet tags;                                                ///< Custom tags (interned)
     std::string notes;                                          ///< Free-form notes
     std::string reserved_by;                                    ///< Reservation user
     std::chrono::system_clock::time_point reservation_expires;  ///< Reservation expiry
@@ -475,7 +484,7 @@ struct TapeVolume {
     StorageTier storage_tier = StorageTier::HOT;                ///< Storage tier
     std::chrono::system_clock::time_point last_access_date;     ///< Last access time
     std::chrono::system_clock::time_point last_health_check;    ///< Last health check
-    std::string media_type;                                     ///< Media type identifier
+    Symbol media_type;                                          ///< Media type identifier (interned)
     int read_error_count = 0;                                   ///< Read errors
     int write_error_count = 0;                                  ///< Write errors
     
@@ -491,23 +500,26 @@ struct TapeVolume {
     }
     
     /// Check if volume is expired
-    bool is_expired() const {
-        return expiration_date < std::chrono::system_clock::now();
+    bool is_expired() const { return is_expired(current_time()); }
+    bool is_expired(std::chrono::system_clock::time_point now) const {
+        return expiration_date < now;
     }
     
     /// Check if volume is currently reserved
-    bool is_reserved() const {
-        return !reserved_by.empty() && reservation_expires > std::chrono::system_clock::now();
+    bool is_reserved() const { return is_reserved(current_time()); }
+    bool is_reserved(std::chrono::system_clock::time_point now) const {
+        return !reserved_by.empty() && reservation_expires > now;
     }
     
     /// Check if volume has a specific tag
-    bool has_tag(const std::string& tag) const {
+    bool has_tag(std::string_view tag) const {
         return tags.find(tag) != tags.end();
     }
     
     /// Check if volume is available for scratch allocation
-    bool is_available_for_scratch() const {
-        return status == VolumeStatus::SCRATCH && !is_reserved() && !is_expired();
+    bool is_available_for_scratch() const { return is_available_for_scratch(current_time()); }
+    bool is_available_for_scratch(std::chrono::system_clock::time_point now) const {
+        return status == VolumeStatus::SCRATCH && !is_reserved(now) && !is_expired(now);
     }
     
     /// v3.2.0: Check if volume health is acceptable
@@ -521,8 +533,8 @@ struct TapeVolume {
     }
     
     /// v3.2.0: Get volume age in days
-    int get_age_days() const {
-        auto now = std::chrono::system_clock::now();
+    int get_age_days() const { return get_age_days(current_time()); }
+    int get_age_days(std::chrono::system_clock::time_point now) const {
         auto duration = std::chrono::duration_cast<std::chrono::hours>(now - creation_date);
         return static_cast<int>(duration.count() / 24);
     }
@@ -536,8 +548,8 @@ struct Dataset {
     std::string volser;                                         ///< Volume reference
     DatasetStatus status = DatasetStatus::ACTIVE;               ///< Current status
     size_t size_bytes = 0;                                      ///< Dataset size
-    std::string owner;                                          ///< Owner ID
-    std::string job_name;                                       ///< Creating job
+    Symbol owner;                                               ///< Owner ID (interned)
+    Symbol job_name;                                            ///< Creating job (interned)
     int file_sequence = 1;                                      ///< File sequence number
     int generation = 0;                                         ///< GDG generation
     int version = 0;                                            ///< GDG version
@@ -547,7 +559,7 @@ struct Dataset {
     std::chrono::system_clock::time_point creation_date;        ///< Creation timestamp
     std::chrono::system_clock::time_point expiration_date;      ///< Expiration timestamp
     std::chrono::system_clock::time_point last_accessed;        ///< Last access timestamp
-    std::set<std::string> tags;                                 ///< Custom tags
+    TagSet tags;                                                ///< Custom tags (interned)
     std::string notes;                                          ///< Free-form notes
     
     // v3.2.0: New fields
@@ -560,12 +572,13 @@ struct Dataset {
     bool is_gdg() const { return generation > 0; }
     
     /// Check if dataset is expired
-    bool is_expired() const { 
-        return expiration_date < std::chrono::system_clock::now(); 
+    bool is_expired() const { return is_expired(current_time()); }
+    bool is_expired(std::chrono::system_clock::time_point now) const {
+        return expiration_date < now;
     }
     
     /// Check if dataset has a specific tag
-    bool has_tag(const std::string& tag) const { 
+    bool has_tag(std::string_view tag) const { 
         return tags.find(tag) != tags.end(); 
     }
     
@@ -591,6 +604,7 @@ struct AuditRecord {
     bool success = true;                                ///< Success flag
     std::string source_ip;                              ///< Source IP address
     std::string session_id;                             ///< Session identifier
+    std::string request_id;                             ///< v3.4.0: Request within the session
 };
 
 /**
@@ -711,6 +725,59 @@ struct SearchCriteria {
     size_t fuzzy_threshold = 2;                                 ///< Max edit distance for fuzzy
 };
 
+/**
+ * @brief SearchCriteria equality filters resolved to symbols once per search
+ *
+ * Records then match by pointer compare. A value that was never interned
+ * cannot match any record, so the search can return without scanning.
+ */
+struct CriteriaSymbols {
+    std::optional<Symbol> owner;
+    std::optional<Symbol> pool;
+    std::optional<Symbol> tag;
+    bool unmatchable = false;                                   ///< Some filter can match nothing
+    
+    explicit CriteriaSymbols(const SearchCriteria& criteria) {
+        auto resolve = [this](const std::optional<std::string>& value, std::optional<Symbol>& out) {
+            if (!value) return;
+            out = Symbol::lookup(*value);
+            if (!out) unmatchable = true;
+        };
+        resolve(criteria.owner, owner);
+        resolve(criteria.pool, pool);
+        resolve(criteria.tag, tag);
+    }
+};
+
+/**
+ * @brief Field-level volume update; unset fields are left unchanged
+ */
+struct VolumePatch {
+    std::optional<VolumeStatus> status;
+    std::optional<std::string> pool;
+    std::optional<std::string> owner;
+    std::optional<std::chrono::system_clock::time_point> expiration_date;
+    std::optional<bool> write_protected;
+    std::optional<std::string> notes;
+    std::optional<std::string> media_type;
+    std::optional<StorageTier> storage_tier;
+    std::vector<std::string> add_tags;
+    std::vector<std::string> remove_tags;
+};
+
+/**
+ * @brief Field-level dataset update; unset fields are left unchanged
+ */
+struct DatasetPatch {
+    std::optional<DatasetStatus> status;
+    std::optional<std::string> owner;
+    std::optional<std::string> job_name;
+    std::optional<std::chrono::system_clock::time_point> expiration_date;
+    std::optional<std::string> notes;
+    std::vector<std::string> add_tags;
+    std::vector<std::string> remove_tags;
+};
+
 /**
  * @brief Health check result
  */
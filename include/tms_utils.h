@@ -24,6 +24,10 @@
 #include <cctype>
 #include <cmath>
 #include <vector>
+#include <string_view>
+#include <chrono>
+#include <ctime>
+#include <cstdint>
 
 namespace tms {
 
@@ -97,27 +101,222 @@ private:
 // Time Formatting Functions
 // ============================================================================
 
-inline std::string format_time(const std::chrono::system_clock::time_point& tp) {
-    auto time_t_val = std::chrono::system_clock::to_time_t(tp);
-    std::tm tm_buf{};
+/**
+ * @brief Fast local-time codec for "YYYY-MM-DD HH:MM:SS" timestamps (v3.4.0)
+ *
+ * Each thread keeps a small direct-mapped cache of UTC days with the
+ * local UTC offset that applies across the whole day. Timestamps on a
+ * cached day are converted with integer calendar arithmetic and
+ * hand-rolled digit routines; a miss costs two localtime calls. Days on
+ * which the offset changes (DST transitions) always go through the C
+ * library. Call reset_cache() on each thread after changing TZ.
+ */
+class TimestampCodec {
+public:
+    using time_point = std::chrono::system_clock::time_point;
+    
+    static constexpr size_t TEXT_LENGTH = 19;
+    
+    /// Write exactly TEXT_LENGTH characters (no terminator) to @p out
+    static void format(time_point tp, char* out);
+    static void append(std::string& out, time_point tp);
+    static std::string format(time_point tp);
+    
+    /// Parse local time; returns false (and leaves @p out) on malformed input
+    static bool parse(std::string_view text, time_point& out);
+    
+    /// Epoch-second encoding for binary formats
+    static int64_t to_epoch(time_point tp) {
+        return std::chrono::duration_cast<std::chrono::seconds>(tp.time_since_epoch()).count();
+    }
+    static time_point from_epoch(int64_t seconds) {
+        return time_point(std::chrono::duration_cast<time_point::duration>(std::chrono::seconds(seconds)));
+    }
+    
+    /// Days since 1970-01-01 for a proleptic Gregorian date
+    static int64_t days_from_civil(int64_t y, unsigned m, unsigned d);
+    static void civil_from_days(int64_t days, int64_t& y, unsigned& m, unsigned& d);
+    
+    static void reset_cache();
+
+private:
+    struct DayEntry {
+        int64_t day = INT64_MIN;    ///< UTC day number
+        int32_t offset = 0;         ///< Local offset in seconds
+        bool uniform = false;       ///< Offset constant for the whole day
+    };
+    static constexpr size_t CACHE_SIZE = 512;
+    
+    static DayEntry* cache() {
+        thread_local DayEntry entries[CACHE_SIZE];
+        return entries;
+    }
+    static const DayEntry& lookup(int64_t day);
+    static int64_t local_offset(std::time_t t, std::tm& tm);
+    static int64_t floor_div(int64_t a, int64_t b) { return a / b - ((a % b) < 0 ? 1 : 0); }
+    static void write_digits(char* out, unsigned value, int width) {
+        for (int i = width - 1; i >= 0; i--) {
+            out[i] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        }
+    }
+    static bool read_digits(const char* in, int width, unsigned& value) {
+        value = 0;
+        for (int i = 0; i < width; i++) {
+            unsigned digit = static_cast<unsigned>(in[i]) - '0';
+            if (digit > 9) return false;
+            value = value * 10 + digit;
+        }
+        return true;
+    }
+};
+
+inline int64_t TimestampCodec::days_from_civil(int64_t y, unsigned m, unsigned d) {
+    y -= m <= 2;
+    const int64_t era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(y - era * 400);
+    const unsigned doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<int64_t>(doe) - 719468;
+}
+
+inline void TimestampCodec::civil_from_days(int64_t days, int64_t& y, unsigned& m, unsigned& d) {
+    days += 719468;
+    const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    const unsigned doe = static_cast<unsigned>(days - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp = (5 * doy + 2) / 153;
+    d = doy - (153 * mp + 2) / 5 + 1;
+    m = mp < 10 ? mp + 3 : mp - 9;
+    y = static_cast<int64_t>(yoe) + era * 400 + (m <= 2);
+}
+
+inline int64_t TimestampCodec::local_offset(std::time_t t, std::tm& tm) {
 #if defined(_WIN32)
-    localtime_s(&tm_buf, &time_t_val);
+    localtime_s(&tm, &t);
 #else
-    localtime_r(&time_t_val, &tm_buf);
+    localtime_r(&t, &tm);
 #endif
-    std::ostringstream oss;
-    oss << std::put_time(&tm_buf, "%Y-%m-%d %H:%M:%S");
-    return oss.str();
+    int64_t local = days_from_civil(static_cast<int64_t>(tm.tm_year) + 1900,
+                                    static_cast<unsigned>(tm.tm_mon + 1),
+                                    static_cast<unsigned>(tm.tm_mday)) * 86400 +
+                    tm.tm_hour * 3600 + tm.tm_min * 60 + tm.tm_sec;
+    return local - static_cast<int64_t>(t);
+}
+
+inline const TimestampCodec::DayEntry& TimestampCodec::lookup(int64_t day) {
+    DayEntry& entry = cache()[static_cast<uint64_t>(day) % CACHE_SIZE];
+    if (entry.day != day) {
+        std::tm tm{};
+        int64_t first = local_offset(static_cast<std::time_t>(day * 86400), tm);
+        int64_t last = local_offset(static_cast<std::time_t>(day * 86400 + 86399), tm);
+        entry.day = day;
+        entry.offset = static_cast<int32_t>(first);
+        entry.uniform = first == last;
+    }
+    return entry;
+}
+
+inline void TimestampCodec::reset_cache() {
+    DayEntry* entries = cache();
+    for (size_t i = 0; i < CACHE_SIZE; i++) entries[i] = DayEntry();
+}
+
+inline void TimestampCodec::format(time_point tp, char* out) {
+    const int64_t t = static_cast<int64_t>(std::chrono::system_clock::to_time_t(tp));
+    const DayEntry& entry = lookup(floor_div(t, 86400));
+    
+    int64_t year;
+    unsigned month, day, secs;
+    if (entry.uniform) {
+        int64_t local = t + entry.offset;
+        int64_t local_day = floor_div(local, 86400);
+        civil_from_days(local_day, year, month, day);
+        secs = static_cast<unsigned>(local - local_day * 86400);
+    } else {
+        std::tm tm{};
+        local_offset(static_cast<std::time_t>(t), tm);
+        year = static_cast<int64_t>(tm.tm_year) + 1900;
+        month = static_cast<unsigned>(tm.tm_mon + 1);
+        day = static_cast<unsigned>(tm.tm_mday);
+        secs = static_cast<unsigned>(tm.tm_hour * 3600 + tm.tm_min * 60 + tm.tm_sec);
+    }
+    
+    write_digits(out, static_cast<unsigned>(year < 0 ? 0 : (year > 9999 ? 9999 : year)), 4);
+    out[4] = '-';
+    write_digits(out + 5, month, 2);
+    out[7] = '-';
+    write_digits(out + 8, day, 2);
+    out[10] = ' ';
+    write_digits(out + 11, secs / 3600, 2);
+    out[13] = ':';
+    write_digits(out + 14, (secs / 60) % 60, 2);
+    out[16] = ':';
+    write_digits(out + 17, secs % 60, 2);
+}
+
+inline void TimestampCodec::append(std::string& out, time_point tp) {
+    char buf[TEXT_LENGTH];
+    format(tp, buf);
+    out.append(buf, TEXT_LENGTH);
+}
+
+inline std::string TimestampCodec::format(time_point tp) {
+    char buf[TEXT_LENGTH];
+    format(tp, buf);
+    return std::string(buf, TEXT_LENGTH);
+}
+
+inline bool TimestampCodec::parse(std::string_view text, time_point& out) {
+    unsigned year, month, day, hh, mm, ss;
+    bool canonical = text.size() == TEXT_LENGTH &&
+                     text[4] == '-' && text[7] == '-' && text[10] == ' ' &&
+                     text[13] == ':' && text[16] == ':' &&
+                     read_digits(text.data(), 4, year) && read_digits(text.data() + 5, 2, month) &&
+                     read_digits(text.data() + 8, 2, day) && read_digits(text.data() + 11, 2, hh) &&
+                     read_digits(text.data() + 14, 2, mm) && read_digits(text.data() + 17, 2, ss);
+    
+    if (canonical && month >= 1 && month <= 12 && day >= 1 && hh < 24 && mm < 60 && ss < 60) {
+        static const unsigned month_days[] = {31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+        bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+        unsigned limit = (month == 2 && !leap) ? 28 : month_days[month - 1];
+        if (day <= limit) {
+            int64_t local = days_from_civil(year, month, day) * 86400 + hh * 3600 + mm * 60 + ss;
+            // Offset of the local day, then confirm it holds at the resulting instant
+            const DayEntry& guess = lookup(floor_div(local, 86400));
+            if (guess.uniform) {
+                int32_t offset = guess.offset;
+                int64_t t = local - offset;
+                const DayEntry& actual = lookup(floor_div(t, 86400));
+                if (actual.uniform && actual.offset == offset) {
+                    out = from_epoch(t);
+                    return true;
+                }
+            }
+        }
+    }
+    
+    // Non-canonical text, out-of-range fields or an offset change: C library
+    std::tm tm{};
+    std::istringstream iss{std::string(text)};
+    iss >> std::get_time(&tm, "%Y-%m-%d %H:%M:%S");
+    if (iss.fail()) return false;
+    tm.tm_isdst = -1;
+    out = std::chrono::system_clock::from_time_t(std::mktime(&tm));
+    return true;
 }
 
-inline std::chrono::system_clock::time_point parse_time(const std::string& str) {
-    std::tm tm = {};
-    std::istringstream ss(str);
-    ss >> std::get_time(&tm, "%Y-%m-%d %H:%M:%S");
-    if (ss.fail()) {
+inline std::string format_time(const std::chrono::system_clock::time_point& tp) {
+    return TimestampCodec::format(tp);
+}
+
+inline std::chrono::system_clock::time_point parse_time(std::string_view str) {
+    std::chrono::system_clock::time_point tp{};
+    if (!TimestampCodec::parse(str, tp)) {
         return std::chrono::system_clock::time_point{};
     }
-    return std::chrono::system_clock::from_time_t(std::mktime(&tm));
+    return tp;
 }
 
 inline std::string format_duration(std::chrono::seconds duration) {
@@ -139,7 +338,7 @@ inline std::string format_duration(std::chrono::seconds duration) {
 }
 
 inline std::string get_timestamp() {
-    return format_time(std::chrono::system_clock::now());
+    return format_time(current_time());
 }
 
 // ============================================================================
@@ -177,7 +376,7 @@ inline std::string volume_status_to_string(VolumeStatus status) {
     }
 }
 
-inline VolumeStatus string_to_volume_status(const std::string& str) {
+inline VolumeStatus string_to_volume_status(std::string_view str) {
     if (str == "SCRATCH") return VolumeStatus::SCRATCH;
     if (str == "PRIVATE") return VolumeStatus::PRIVATE;
     if (str == "ARCHIVED") return VolumeStatus::ARCHIVED;
@@ -201,7 +400,7 @@ inline std::string dataset_status_to_string(DatasetStatus status) {
     }
 }
 
-inline DatasetStatus string_to_dataset_status(const std::string& str) {
+inline DatasetStatus string_to_dataset_status(std::string_view str) {
     if (str == "ACTIVE") return DatasetStatus::ACTIVE;
     if (str == "MIGRATED") return DatasetStatus::MIGRATED;
     if (str == "EXPIRED") return DatasetStatus::EXPIRED;
@@ -232,7 +431,7 @@ inline std::string density_to_string(TapeDensity density) {
     }
 }
 
-inline TapeDensity string_to_density(const std::string& str) {
+inline TapeDensity string_to_density(std::string_view str) {
     if (str == "800BPI") return TapeDensity::DENSITY_800BPI;
     if (str == "1600BPI") return TapeDensity::DENSITY_1600BPI;
     if (str == "6250BPI") return TapeDensity::DENSITY_6250BPI;
@@ -497,11 +696,12 @@ inline bool matches_pattern(const std::string& text, const std::string& pattern,
 // ============================================================================
 
 /**
- * @brief Calculate health score for a volume
+ * @brief Calculate health score for a volume as of @p now
  */
-inline VolumeHealthScore calculate_health_score(const TapeVolume& vol) {
+inline VolumeHealthScore calculate_health_score(const TapeVolume& vol,
+                                                std::chrono::system_clock::time_point now) {
     VolumeHealthScore score;
-    score.last_calculated = std::chrono::system_clock::now();
+    score.last_calculated = now;
     
     // Error rate score (0-100)
     int total_errors = vol.get_total_errors();
@@ -518,7 +718,7 @@ inline VolumeHealthScore calculate_health_score(const TapeVolume& vol) {
     }
     
     // Age score (based on typical tape lifetime of 15-30 years)
-    int age_days = vol.get_age_days();
+    int age_days = vol.get_age_days(now);
     int age_years = age_days / 365;
     if (age_years < 5) {
         score.age_score = 100.0;
@@ -582,6 +782,10 @@ inline VolumeHealthScore calculate_health_score(const TapeVolume& vol) {
     return score;
 }
 
+inline VolumeHealthScore calculate_health_score(const TapeVolume& vol) {
+    return calculate_health_score(vol, current_time());
+}
+
 // ============================================================================
 // v3.2.0: Snapshot ID Generation
 // ============================================================================
@@ -590,7 +794,7 @@ inline VolumeHealthScore calculate_health_score(const TapeVolume& vol) {
  * @brief Generate unique snapshot ID
  */
 inline std::string generate_snapshot_id(const std::string& volser) {
-    auto now = std::chrono::system_clock::now();
+    auto now = current_time();
     auto time_t_val = std::chrono::system_clock::to_time_t(now);
     auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
         now.time_since_epoch()) % 1000;
@@ -133,6 +133,31 @@ constexpr bool FEATURE_STATS_AGGREGATION = true;
 constexpr bool FEATURE_PARALLEL_BATCH = true;
 constexpr bool FEATURE_ERROR_RECOVERY = true;
 
+// v3.4.0 features
+constexpr bool FEATURE_JSON_STREAMING = true;
+constexpr bool FEATURE_CSV_BULK_IMPORT = true;
+constexpr bool FEATURE_EXPORT_ENGINE = true;
+constexpr bool FEATURE_TIMESTAMP_CODEC = true;
+constexpr bool FEATURE_STREAMING_REPORTS = true;
+constexpr bool FEATURE_REPORT_CACHE = true;
+constexpr bool FEATURE_SHARED_SNAPSHOTS = true;
+constexpr bool FEATURE_CATALOG_HISTORY = true;
+constexpr bool FEATURE_CONFIG_SNAPSHOTS = true;
+constexpr bool FEATURE_WORKLOAD_REPLAY = true;
+constexpr bool FEATURE_SIMULATED_CLOCK = true;
+constexpr bool FEATURE_COARSE_CLOCK = true;
+constexpr bool FEATURE_CHANGE_STREAM = true;
+constexpr bool FEATURE_STRING_INTERNING = true;
+constexpr bool FEATURE_HOT_VOLUME_TABLE = true;
+constexpr bool FEATURE_MOVE_AWARE_API = true;
+constexpr bool FEATURE_LOCK_FREE_READS = true;
+constexpr bool FEATURE_MEMORY_ARENAS = true;
+constexpr bool FEATURE_RPC_DAEMON = true;
+constexpr bool FEATURE_ASYNC_API = true;
+constexpr bool FEATURE_OPERATION_CONTEXT = true;
+constexpr bool FEATURE_REPLICATION = true;
+constexpr bool FEATURE_PARTITIONED_CATALOG = true;
+
 // ============================================================================
 // Helper Functions
 // ============================================================================
@@ -191,6 +216,29 @@ inline std::vector<std::string> get_enabled_features() {
     if (FEATURE_STATS_AGGREGATION) features.push_back("Stats Aggregation");
     if (FEATURE_PARALLEL_BATCH) features.push_back("Parallel Batch");
     if (FEATURE_ERROR_RECOVERY) features.push_back("Error Recovery");
+    if (FEATURE_JSON_STREAMING) features.push_back("JSON Streaming");
+    if (FEATURE_CSV_BULK_IMPORT) features.push_back("CSV Bulk Import");
+    if (FEATURE_EXPORT_ENGINE) features.push_back("Parallel Export");
+    if (FEATURE_TIMESTAMP_CODEC) features.push_back("Timestamp Codec");
+    if (FEATURE_STREAMING_REPORTS) features.push_back("Streaming Reports");
+    if (FEATURE_REPORT_CACHE) features.push_back("Report Cache");
+    if (FEATURE_SHARED_SNAPSHOTS) features.push_back("Shared Snapshots");
+    if (FEATURE_CATALOG_HISTORY) features.push_back("Catalog History");
+    if (FEATURE_CONFIG_SNAPSHOTS) features.push_back("Config Snapshots");
+    if (FEATURE_WORKLOAD_REPLAY) features.push_back("Workload Replay");
+    if (FEATURE_SIMULATED_CLOCK) features.push_back("Simulated Clock");
+    if (FEATURE_COARSE_CLOCK) features.push_back("Coarse Clock");
+    if (FEATURE_CHANGE_STREAM) features.push_back("Change Data Capture");
+    if (FEATURE_STRING_INTERNING) features.push_back("String Interning");
+    if (FEATURE_HOT_VOLUME_TABLE) features.push_back("Hot Volume Table");
+    if (FEATURE_MOVE_AWARE_API) features.push_back("Move-Aware API");
+    if (FEATURE_LOCK_FREE_READS) features.push_back("Lock-Free Reads");
+    if (FEATURE_MEMORY_ARENAS) features.push_back("Memory Arenas");
+    if (FEATURE_RPC_DAEMON) features.push_back("RPC Daemon");
+    if (FEATURE_ASYNC_API) features.push_back("Async API");
+    if (FEATURE_OPERATION_CONTEXT) features.push_back("Operation Context");
+    if (FEATURE_REPLICATION) features.push_back("Replication");
+    if (FEATURE_PARTITIONED_CATALOG) features.push_back("Partitioned Catalog");
     return features;
 }
 
@@ -0,0 +1,166 @@
+/**
+ * @file tms_versions.h
+ * @brief TMS Tape Management System - Catalog Version History
+ * @version 3.4.0
+ * @author Bennie Shearer
+ * @copyright Copyright (c) 2025 Bennie Shearer
+ * @license MIT License
+ *
+ * MVCC-style history for catalog records. The live catalog always holds
+ * the current version of each record, so current reads are untouched;
+ * a write first retires the record's previous state into a per-key
+ * version chain stamped with the interval it was current. Reads with an
+ * as_of time consult the chain and fall back to the live record when
+ * nothing has changed since then. Versions that ended before the
+ * retention horizon are dropped by compact().
+ */
+
+#ifndef TMS_VERSIONS_H
+#define TMS_VERSIONS_H
+
+#include <string>
+#include <map>
+#include <deque>
+#include <memory>
+#include <chrono>
+#include <optional>
+#include <algorithm>
+
+namespace tms {
+
+// ============================================================================
+// Version History
+// ============================================================================
+
+/**
+ * @brief Catalog version history statistics
+ */
+struct VersionHistoryStats {
+    size_t keys = 0;            ///< Records with retained versions
+    size_t versions = 0;        ///< Retained versions (including "absent" markers)
+    size_t compacted = 0;       ///< Versions dropped by compaction so far
+    std::chrono::system_clock::time_point oldest;   ///< Earliest time still answerable
+};
+
+/**
+ * @brief Retired versions of one record type, keyed by record key
+ *
+ * Every retire() in one catalog write uses the same timestamp, so a
+ * record touched several times by a bulk operation is archived once.
+ * Not internally synchronized: retire() runs under the owner's exclusive
+ * catalog lock and lookups under its shared lock.
+ */
+template<typename Record>
+class VersionHistory {
+public:
+    using time_point = std::chrono::system_clock::time_point;
+    using Value = std::shared_ptr<const Record>;
+    
+    /**
+     * @brief Archive the state @p key had until @p now
+     * @param before Previous state, or nullptr if the record did not exist
+     */
+    void retire(const std::string& key, const Record* before, time_point now) {
+        auto& chain = chains_[key];
+        if (chain.started && chain.current_since == now) {
+            return;  // Already retired by this write; keep the pre-write state
+        }
+        Version version;
+        version.valid_from = chain.versions.empty() && !chain.started ? time_point::min() : chain.current_since;
+        version.valid_to = now;
+        if (before) version.value = std::make_shared<const Record>(*before);
+        chain.versions.push_back(std::move(version));
+        chain.current_since = now;
+        chain.started = true;
+        version_count_++;
+    }
+    
+    /**
+     * @brief State of @p key at @p as_of
+     * @return std::nullopt when the live record applies; otherwise the
+     *         retired state (nullptr if the record did not exist then)
+     */
+    std::optional<Value> find(const std::string& key, time_point as_of) const {
+        auto it = chains_.find(key);
+        if (it == chains_.end() || as_of >= it->second.current_since) return std::nullopt;
+        const auto& versions = it->second.versions;
+        // First version still current after as_of; zero-length versions never match
+        auto v = std::upper_bound(versions.begin(), versions.end(), as_of,
+            [](time_point t, const Version& ver) { return t < ver.valid_to; });
+        if (v == versions.end() || as_of < v->valid_from) return Value{};
+        return v->value;
+    }
+    
+    /// Keys with retained history, in key order
+    template<typename Fn>
+    void for_each_key(Fn&& fn) const {
+        for (const auto& [key, chain] : chains_) fn(key);
+    }
+    
+    /**
+     * @brief Drop versions that stopped being current before @p horizon
+     *
+     * The "absent" marker of a key created after the horizon is kept so
+     * as_of reads before its creation still see it as missing.
+     */
+    size_t compact(time_point horizon) {
+        size_t dropped = 0;
+        for (auto it = chains_.begin(); it != chains_.end();) {
+            auto& versions = it->second.versions;
+            while (!versions.empty() && versions.front().valid_to < horizon) {
+                versions.pop_front();
+                dropped++;
+            }
+            if (versions.empty() && it->second.current_since < horizon) {
+                it = chains_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        version_count_ -= dropped;
+        compacted_ += dropped;
+        if (dropped > 0 && horizon > oldest_) oldest_ = horizon;
+        return dropped;
+    }
+    
+    /// Forget all history; as_of reads before @p now are no longer answerable
+    void reset(time_point now) {
+        chains_.clear();
+        version_count_ = 0;
+        oldest_ = now;
+    }
+    
+    /// Earliest as_of time that can be answered exactly
+    time_point oldest() const { return oldest_; }
+    
+    VersionHistoryStats stats() const {
+        VersionHistoryStats s;
+        s.keys = chains_.size();
+        s.versions = version_count_;
+        s.compacted = compacted_;
+        s.oldest = oldest_;
+        return s;
+    }
+    
+private:
+    struct Version {
+        time_point valid_from;
+        time_point valid_to;
+        Value value;            // nullptr: record did not exist
+    };
+    
+    struct Chain {
+        std::deque<Version> versions;   // Ordered by valid_to
+        time_point current_since;       // When the live state became current
+        bool started = false;
+    };
+    
+    std::map<std::string, Chain> chains_;
+    size_t version_count_ = 0;
+    size_t compacted_ = 0;
+    time_point oldest_ = time_point::min();
+};
+
+} // namespace tms
+
+#endif // TMS_VERSIONS_H
@@ -0,0 +1,159 @@
+/**
+ * @file tms_volume_table.h
+ * @brief TMS Tape Management System - Hot Volume Table
+ * @version 3.4.0
+ * @author Bennie Shearer
+ * @copyright Copyright (c) 2025 Bennie Shearer
+ * @license MIT License
+ *
+ * A TapeVolume is several hundred bytes spread over a std::map node, a
+ * dataset list, tags, notes, location history and encryption metadata,
+ * yet statistics, scratch selection and expiration scans read a dozen
+ * scalar fields. VolumeHotTable keeps those fields in a contiguous array
+ * of 72-byte rows in volser order; each row points at its full record,
+ * which is only touched when a scan needs more than the hot fields.
+ */
+
+#ifndef TMS_VOLUME_TABLE_H
+#define TMS_VOLUME_TABLE_H
+
+#include "tms_types.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace tms {
+
+// ============================================================================
+// Hot Volume Record
+// ============================================================================
+
+/**
+ * @brief Scan-hot fields of one volume
+ */
+struct VolumeHotRecord {
+    using time_point = std::chrono::system_clock::time_point;
+    
+    enum Flags : uint8_t {
+        WRITE_PROTECTED = 1,
+        HAS_RESERVATION = 2,
+        ENCRYPTED = 4
+    };
+    
+    const TapeVolume* record = nullptr;         ///< Full record (cold fields)
+    Symbol pool;
+    Symbol owner;
+    time_point::rep expiration = 0;
+    time_point::rep reservation_expires = 0;
+    uint64_t capacity_bytes = 0;
+    uint64_t used_bytes = 0;
+    int32_t mount_count = 0;
+    int32_t total_errors = 0;
+    uint8_t status = 0;
+    uint8_t density = 0;
+    uint8_t tier = 0;
+    uint8_t flags = 0;
+    
+    VolumeHotRecord() = default;
+    explicit VolumeHotRecord(const TapeVolume& vol) { assign(vol); }
+    
+    void assign(const TapeVolume& vol) {
+        record = &vol;
+        pool = vol.pool;
+        owner = vol.owner;
+        expiration = vol.expiration_date.time_since_epoch().count();
+        reservation_expires = vol.reservation_expires.time_since_epoch().count();
+        capacity_bytes = vol.capacity_bytes;
+        used_bytes = vol.used_bytes;
+        mount_count = vol.mount_count;
+        total_errors = vol.get_total_errors();
+        status = static_cast<uint8_t>(vol.status);
+        density = static_cast<uint8_t>(vol.density);
+        tier = static_cast<uint8_t>(vol.storage_tier);
+        flags = static_cast<uint8_t>((vol.write_protected ? WRITE_PROTECTED : 0) |
+                                     (!vol.reserved_by.empty() ? HAS_RESERVATION : 0) |
+                                     (vol.encryption.is_encrypted() ? ENCRYPTED : 0));
+    }
+    
+    const std::string& volser() const { return record->volser; }
+    VolumeStatus get_status() const { return static_cast<VolumeStatus>(status); }
+    TapeDensity get_density() const { return static_cast<TapeDensity>(density); }
+    StorageTier get_tier() const { return static_cast<StorageTier>(tier); }
+    time_point expiration_date() const { return time_point(time_point::duration(expiration)); }
+    
+    double get_usage_percent() const {
+        return capacity_bytes > 0 ?
+            (100.0 * static_cast<double>(used_bytes) / static_cast<double>(capacity_bytes)) : 0.0;
+    }
+    
+    // Same rules as the TapeVolume predicates
+    bool is_expired(time_point now) const { return expiration < now.time_since_epoch().count(); }
+    bool is_reserved(time_point now) const {
+        return (flags & HAS_RESERVATION) && reservation_expires > now.time_since_epoch().count();
+    }
+    bool is_available_for_scratch(time_point now) const {
+        return get_status() == VolumeStatus::SCRATCH && !is_reserved(now) && !is_expired(now);
+    }
+};
+
+// ============================================================================
+// Hot Volume Table
+// ============================================================================
+
+struct VolumeTableStats {
+    size_t rows = 0;
+    size_t rebuilds = 0;            ///< Full rebuilds since the catalog opened
+    size_t memory_bytes = 0;
+};
+
+/**
+ * @brief Hot rows for every catalogued volume, in volser order
+ *
+ * Owned by TMSSystem and changed only under its exclusive catalog lock.
+ * In-place updates are applied as each write commits; adding or removing
+ * a volume marks the table stale, and the next scan rebuilds it in one
+ * pass, so a run of adds costs a single rebuild.
+ */
+class VolumeHotTable {
+public:
+    bool stale() const { return stale_.load(std::memory_order_acquire); }
+    void invalidate() { stale_.store(true, std::memory_order_release); }
+    
+    template<typename VolumeMap>
+    void rebuild(const VolumeMap& volumes) {
+        rows_.clear();
+        rows_.reserve(volumes.size());
+        for (const auto& [volser, vol] : volumes) rows_.emplace_back(vol);
+        rebuilds_++;
+        stale_.store(false, std::memory_order_release);
+    }
+    
+    /// Refresh the row of an existing record; false if it has none
+    bool refresh(const TapeVolume& vol) {
+        auto it = std::lower_bound(rows_.begin(), rows_.end(), vol.volser,
+            [](const VolumeHotRecord& row, const std::string& key) { return row.volser() < key; });
+        if (it == rows_.end() || it->record != &vol) return false;
+        it->assign(vol);
+        return true;
+    }
+    
+    const std::vector<VolumeHotRecord>& rows() const { return rows_; }
+    size_t size() const { return rows_.size(); }
+    
+    VolumeTableStats stats() const {
+        return {rows_.size(), rebuilds_, rows_.capacity() * sizeof(VolumeHotRecord)};
+    }
+    
+private:
+    std::vector<VolumeHotRecord> rows_;
+    std::atomic<bool> stale_{true};
+    size_t rebuilds_ = 0;
+};
+
+} // namespace tms
+
+#endif // TMS_VOLUME_TABLE_H
@@ -0,0 +1,376 @@
+/**
+ * @file tms_workload.h
+ * @brief TMS Tape Management System - Workload Capture and Replay
+ * @version 3.4.0
+ * @author Bennie Shearer
+ * @copyright Copyright (c) 2025 Bennie Shearer
+ * @license MIT License
+ *
+ * Capture files are JSON Lines: a header object followed by one event per
+ * catalog operation, stamped with microseconds since capture start. Events
+ * come from the audit trail (every mutation) plus the main lookups, with
+ * the arguments needed to repeat them; adds and updates carry the record
+ * as the write committed it, and bulk adds every record they wrote.
+ * TMSSystem::replay_workload() drives a catalog with the events and
+ * reports per-operation latency histograms and write-lock contention.
+ */
+
+#ifndef TMS_WORKLOAD_H
+#define TMS_WORKLOAD_H
+
+#include "tms_types.h"
+#include "tms_utils.h"
+#include "tms_json.h"
+#include "error_codes.h"
+#include <string>
+#include <vector>
+#include <map>
+#include <array>
+#include <optional>
+#include <fstream>
+#include <ostream>
+#include <iomanip>
+#include <sstream>
+#include <mutex>
+#include <chrono>
+#include <bit>
+#include <algorithm>
+
+namespace tms {
+
+// ============================================================================
+// Workload Events
+// ============================================================================
+
+/**
+ * @brief One captured catalog operation
+ */
+struct WorkloadEvent {
+    int64_t offset_us = 0;                          ///< Microseconds since capture start
+    std::string operation;                          ///< Audit operation name (or GET_/SEARCH_ read)
+    std::string target;                             ///< Volser, dataset name or pool
+    std::map<std::string, std::string> args;        ///< Operation arguments
+    std::optional<TapeVolume> volume;               ///< Record state for volume adds/updates
+    std::optional<Dataset> dataset;                 ///< Record state for dataset adds/updates
+    std::vector<TapeVolume> volumes;                ///< Records written by a bulk volume add
+    std::vector<Dataset> datasets;                  ///< Records written by a bulk dataset add
+    
+    std::string arg(const std::string& name, const std::string& default_val = "") const {
+        auto it = args.find(name);
+        return it != args.end() ? it->second : default_val;
+    }
+};
+
+/**
+ * @brief Appends events to a capture file; thread-safe
+ */
+class WorkloadWriter {
+public:
+    static constexpr int FORMAT_VERSION = 1;
+    
+    bool open(const std::string& path) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        out_.open(path, std::ios::trunc);
+        if (!out_.is_open()) return false;
+        start_ = std::chrono::steady_clock::now();
+        events_ = 0;
+        {
+            JsonWriter w(out_);
+            w.begin_object()
+                .field("tms_workload", FORMAT_VERSION)
+                .field("started", format_time(std::chrono::system_clock::now()))
+                .end_object();
+        }
+        out_ << '\n';
+        return out_.good();
+    }
+    
+    /// Stamps @p event with the current offset and writes it
+    void write(WorkloadEvent& event) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!out_.is_open()) return;
+        event.offset_us = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start_).count();
+        {
+            JsonWriter w(out_);
+            w.begin_object()
+                .field("t", event.offset_us)
+                .field("op", event.operation)
+                .field("target", event.target);
+            if (!event.args.empty()) {
+                w.key("args").begin_object();
+                for (const auto& [name, value] : event.args) w.field(name, value);
+                w.end_object();
+            }
+            if (event.volume) w.key("volume").value(TmsJsonConverter::volume_to_json(*event.volume));
+            if (event.dataset) w.key("dataset").value(TmsJsonConverter::dataset_to_json(*event.dataset));
+            if (!event.volumes.empty()) {
+                w.key("volumes").begin_array();
+                for (const auto& vol : event.volumes) TmsJsonConverter::write_volume(w, vol);
+                w.end_array();
+            }
+            if (!event.datasets.empty()) {
+                w.key("datasets").begin_array();
+                for (const auto& ds : event.datasets) TmsJsonConverter::write_dataset(w, ds);
+                w.end_array();
+            }
+            w.end_object();
+        }
+        out_ << '\n';
+        events_++;
+    }
+    
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (out_.is_open()) out_.close();
+    }
+    
+    size_t events() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return events_;
+    }
+    
+private:
+    mutable std::mutex mutex_;
+    std::ofstream out_;
+    std::chrono::steady_clock::time_point start_;
+    size_t events_ = 0;
+};
+
+/**
+ * @brief Reads a capture file written by WorkloadWriter
+ */
+class WorkloadReader {
+public:
+    static Result<std::vector<WorkloadEvent>> load(const std::string& path) {
+        using R = Result<std::vector<WorkloadEvent>>;
+        std::ifstream in(path);
+        if (!in.is_open()) return R::err(TMSError::FILE_OPEN_ERROR, "Cannot open workload capture: " + path);
+        
+        std::vector<WorkloadEvent> events;
+        std::string line;
+        size_t line_no = 0;
+        try {
+            while (std::getline(in, line)) {
+                line_no++;
+                if (line.empty()) continue;
+                JsonValue json = JsonSerializer::parse(line);
+                if (line_no == 1) {
+                    if (!json.contains("tms_workload")) {
+                        return R::err(TMSError::INVALID_PARAMETER, "Not a workload capture: " + path);
+                    }
+                    continue;
+                }
+                events.push_back(parse_event(json));
+            }
+        } catch (const std::exception& e) {
+            return R::err(TMSError::INVALID_PARAMETER,
+                          "Line " + std::to_string(line_no) + ": " + e.what());
+        }
+        return R::ok(std::move(events));
+    }
+    
+    static WorkloadEvent parse_event(const JsonValue& json) {
+        WorkloadEvent event;
+        event.offset_us = json["t"].as_int64();
+        event.operation = json["op"].as_string();
+        event.target = json["target"].as_string();
+        if (json.contains("args")) {
+            for (const auto& [name, value] : json["args"].as_object()) {
+                event.args[std::string(name)] = value.as_string();
+            }
+        }
+        if (json.contains("volume")) event.volume = TmsJsonConverter::json_to_volume(json["volume"]);
+        if (json.contains("dataset")) event.dataset = TmsJsonConverter::json_to_dataset(json["dataset"]);
+        if (json.contains("volumes")) {
+            for (const auto& vol : json["volumes"].as_array()) {
+                event.volumes.push_back(TmsJsonConverter::json_to_volume(vol));
+            }
+        }
+        if (json.contains("datasets")) {
+            for (const auto& ds : json["datasets"].as_array()) {
+                event.datasets.push_back(TmsJsonConverter::json_to_dataset(ds));
+            }
+        }
+        return event;
+    }
+};
+
+// ============================================================================
+// Replay Measurement
+// ============================================================================
+
+/**
+ * @brief Log-linear latency histogram (four sub-buckets per power of two)
+ *
+ * Percentiles are reported as bucket upper bounds, so they are within
+ * 25% of the true value.
+ */
+class LatencyHistogram {
+public:
+    static constexpr size_t SUB_BUCKETS = 4;
+    static constexpr size_t BUCKETS = 64 * SUB_BUCKETS;
+    
+    void record(uint64_t ns) {
+        counts_[bucket_of(ns)]++;
+        count_++;
+        sum_ += ns;
+        max_ = std::max(max_, ns);
+    }
+    
+    void merge(const LatencyHistogram& other) {
+        for (size_t i = 0; i < BUCKETS; i++) counts_[i] += other.counts_[i];
+        count_ += other.count_;
+        sum_ += other.sum_;
+        max_ = std::max(max_, other.max_);
+    }
+    
+    uint64_t count() const { return count_; }
+    uint64_t max() const { return max_; }
+    uint64_t mean() const { return count_ > 0 ? sum_ / count_ : 0; }
+    
+    /// Upper bound of the bucket holding the q-th percentile (0-100)
+    uint64_t percentile(double q) const {
+        if (count_ == 0) return 0;
+        auto rank = static_cast<uint64_t>(q / 100.0 * static_cast<double>(count_));
+        rank = std::clamp<uint64_t>(rank, 1, count_);
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKETS; i++) {
+            seen += counts_[i];
+            if (seen >= rank) return std::min(upper_bound(i), max_);
+        }
+        return max_;
+    }
+    
+    /// Non-empty buckets as (upper bound ns, count)
+    std::vector<std::pair<uint64_t, uint64_t>> buckets() const {
+        std::vector<std::pair<uint64_t, uint64_t>> out;
+        for (size_t i = 0; i < BUCKETS; i++) {
+            if (counts_[i] > 0) out.emplace_back(upper_bound(i), counts_[i]);
+        }
+        return out;
+    }
+    
+private:
+    static size_t bucket_of(uint64_t ns) {
+        if (ns < SUB_BUCKETS) return static_cast<size_t>(ns);
+        size_t log = static_cast<size_t>(std::bit_width(ns)) - 1;
+        size_t sub = static_cast<size_t>((ns >> (log - 2)) & (SUB_BUCKETS - 1));
+        return log * SUB_BUCKETS + sub;
+    }
+    
+    static uint64_t upper_bound(size_t bucket) {
+        if (bucket < SUB_BUCKETS) return bucket;
+        size_t log = bucket / SUB_BUCKETS;
+        uint64_t sub = bucket % SUB_BUCKETS;
+        return ((SUB_BUCKETS + sub + 1) << (log - 2)) - 1;
+    }
+    
+    std::array<uint64_t, BUCKETS> counts_{};
+    uint64_t count_ = 0;
+    uint64_t sum_ = 0;
+    uint64_t max_ = 0;
+};
+
+/**
+ * @brief Exclusive catalog lock statistics (see TMSSystem::get_lock_contention_stats)
+ */
+struct LockContentionStats {
+    uint64_t acquisitions = 0;  ///< Write locks taken
+    uint64_t contended = 0;     ///< Acquisitions that had to wait
+    uint64_t wait_ns = 0;       ///< Total time spent waiting
+};
+
+/**
+ * @brief Replay pacing
+ */
+enum class ReplayPacing {
+    ORIGINAL,       ///< Keep the captured inter-event timing
+    ACCELERATED,    ///< Captured timing divided by ReplayOptions::speed
+    MAX_SPEED       ///< No delays
+};
+
+struct ReplayOptions {
+    ReplayPacing pacing = ReplayPacing::MAX_SPEED;
+    double speed = 1.0;         ///< Speed-up factor for ACCELERATED
+    size_t threads = 1;         ///< Events are split by volume so each volume keeps its order
+};
+
+struct ReplayOperationStats {
+    LatencyHistogram latency;
+    uint64_t errors = 0;        ///< Calls that returned an error
+};
+
+/**
+ * @brief Replay results
+ */
+struct ReplayReport {
+    size_t events = 0;
+    size_t replayed = 0;
+    size_t failed = 0;
+    size_t skipped = 0;         ///< Operations with no replay mapping
+    double seconds = 0.0;
+    LockContentionStats lock;
+    std::map<std::string, ReplayOperationStats> operations;
+    
+    void write_json(std::ostream& os) const {
+        JsonWriter w(os);
+        w.begin_object()
+            .field("events", events)
+            .field("replayed", replayed)
+            .field("failed", failed)
+            .field("skipped", skipped)
+            .field("seconds", seconds)
+            .field("ops_per_sec", seconds > 0 ? static_cast<double>(replayed) / seconds : 0.0);
+        w.key("lock").begin_object()
+            .field("acquisitions", lock.acquisitions)
+            .field("contended", lock.contended)
+            .field("wait_ns", lock.wait_ns)
+            .end_object();
+        w.key("operations").begin_object();
+        for (const auto& [name, stats] : operations) {
+            const auto& h = stats.latency;
+            w.key(name).begin_object()
+                .field("count", h.count())
+                .field("errors", stats.errors)
+                .field("mean_ns", h.mean())
+                .field("p50_ns", h.percentile(50))
+                .field("p90_ns", h.percentile(90))
+                .field("p99_ns", h.percentile(99))
+                .field("max_ns", h.max());
+            w.key("histogram").begin_array();
+            for (const auto& [upper, count] : h.buckets()) {
+                w.begin_array().value(upper).value(count).end_array();
+            }
+            w.end_array().end_object();
+        }
+        w.end_object().end_object();
+    }
+    
+    std::string to_string() const {
+        std::ostringstream oss;
+        oss << "Replayed " << replayed << " of " << events << " events in "
+            << std::fixed << std::setprecision(3) << seconds << " s ("
+            << failed << " failed, " << skipped << " skipped)\n"
+            << "Write lock: " << lock.acquisitions << " acquisitions, " << lock.contended
+            << " contended, " << std::setprecision(1)
+            << static_cast<double>(lock.wait_ns) / 1e6 << " ms waiting\n\n"
+            << std::left << std::setw(22) << "operation" << std::right
+            << std::setw(9) << "count" << std::setw(8) << "errors"
+            << std::setw(11) << "p50 us" << std::setw(11) << "p90 us"
+            << std::setw(11) << "p99 us" << std::setw(11) << "max us" << "\n";
+        auto us = [](uint64_t ns) { return static_cast<double>(ns) / 1000.0; };
+        for (const auto& [name, stats] : operations) {
+            const auto& h = stats.latency;
+            oss << std::left << std::setw(22) << name << std::right
+                << std::setw(9) << h.count() << std::setw(8) << stats.errors
+                << std::setw(11) << us(h.percentile(50)) << std::setw(11) << us(h.percentile(90))
+                << std::setw(11) << us(h.percentile(99)) << std::setw(11) << us(h.max()) << "\n";
+        }
+        return oss.str();
+    }
+};
+
+} // namespace tms
+
+#endif // TMS_WORKLOAD_H
@@ -19,104 +19,255 @@
 
 namespace tms {
 
-Configuration::Configuration() {
-    set_defaults();
-}
+namespace {
 
-void Configuration::set_defaults() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    sections_.clear();
+ConfigSnapshot::SectionMap default_sections() {
+    ConfigSnapshot::SectionMap sections;
     
     // General settings
-    sections_["General"]["data_directory"] = "tms_data";
-    sections_["General"]["max_volumes"] = "100000";
-    sections_["General"]["max_datasets"] = "1000000";
-    sections_["General"]["auto_save"] = "true";
-    sections_["General"]["auto_save_interval"] = "300";
-    sections_["General"]["strict_validation"] = "true";
+    sections["General"]["data_directory"] = "tms_data";
+    sections["General"]["max_volumes"] = "100000";
+    sections["General"]["max_datasets"] = "1000000";
+    sections["General"]["auto_save"] = "true";
+    sections["General"]["auto_save_interval"] = "300";
+    sections["General"]["strict_validation"] = "true";
     
     // Catalog settings
-    sections_["Catalog"]["enable_compression"] = "false";
-    sections_["Catalog"]["enable_backup"] = "true";
-    sections_["Catalog"]["backup_retention_days"] = "30";
-    sections_["Catalog"]["backup_directory"] = "tms_data/backups";
+    sections["Catalog"]["enable_compression"] = "false";
+    sections["Catalog"]["enable_backup"] = "true";
+    sections["Catalog"]["backup_retention_days"] = "30";
+    sections["Catalog"]["backup_directory"] = "tms_data/backups";
     
     // Logging settings
-    sections_["Logging"]["log_level"] = "INFO";
-    sections_["Logging"]["log_to_file"] = "true";
-    sections_["Logging"]["log_file"] = "tms.log";
-    sections_["Logging"]["log_to_console"] = "true";
-    sections_["Logging"]["log_max_size"] = "10485760";
-    sections_["Logging"]["log_max_files"] = "5";
+    sections["Logging"]["log_level"] = "INFO";
+    sections["Logging"]["log_to_file"] = "true";
+    sections["Logging"]["log_file"] = "tms.log";
+    sections["Logging"]["log_to_console"] = "true";
+    sections["Logging"]["log_max_size"] = "10485760";
+    sections["Logging"]["log_max_files"] = "5";
     
     // Audit settings
-    sections_["Audit"]["enable_audit"] = "true";
-    sections_["Audit"]["retention_days"] = "90";
-    sections_["Audit"]["audit_file"] = "tms_audit.log";
+    sections["Audit"]["enable_audit"] = "true";
+    sections["Audit"]["retention_days"] = "90";
+    sections["Audit"]["audit_file"] = "tms_audit.log";
     
     // Performance settings
-    sections_["Performance"]["lock_timeout_ms"] = "5000";
-    sections_["Performance"]["retry_count"] = "3";
-    sections_["Performance"]["retry_delay_ms"] = "100";
-    sections_["Performance"]["batch_size"] = "100";
+    sections["Performance"]["lock_timeout_ms"] = "5000";
+    sections["Performance"]["retry_count"] = "3";
+    sections["Performance"]["retry_delay_ms"] = "100";
+    sections["Performance"]["batch_size"] = "100";
+    sections["Performance"]["clock_resolution_ms"] = "0";
+    sections["Performance"]["lock_free_reads"] = "false";
+    
+    // Daemon settings
+    sections["Daemon"]["socket_path"] = "tms_data/tms.sock";
+    sections["Daemon"]["tcp_port"] = "-1";
+    sections["Daemon"]["workers"] = "4";
+    
+    return sections;
 }
 
-bool Configuration::load_from_file(const std::string& path) {
-    std::lock_guard<std::mutex> lock(mutex_);
+// Value parsing shared by the generic getters and snapshot building
+std::string parse_string(const std::string* val, const std::string& default_val) {
+    return val ? *val : default_val;
+}
+
+int parse_int(const std::string* val, int default_val) {
+    if (!val || val->empty()) return default_val;
+    try { return std::stoi(*val); } catch (...) { return default_val; }
+}
+
+bool parse_bool(const std::string* val, bool default_val) {
+    if (!val || val->empty()) return default_val;
+    std::string v = *val;
+    std::transform(v.begin(), v.end(), v.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return v == "true" || v == "1" || v == "yes" || v == "on";
+}
+
+size_t parse_size(const std::string* val, size_t default_val) {
+    if (!val || val->empty()) return default_val;
+    try { return std::stoull(*val); } catch (...) { return default_val; }
+}
+
+// Per-thread reference to the last snapshot seen; refreshed only when the
+// generation moves, so the common read is an atomic load and a compare
+struct SnapshotCache {
+    const Configuration* owner = nullptr;
+    uint64_t generation = 0;
+    std::shared_ptr<const ConfigSnapshot> snapshot;
+};
+
+thread_local SnapshotCache tls_snapshot;
+
+} // namespace
+
+const std::string* ConfigSnapshot::find(const std::string& section, const std::string& key) const {
+    auto sit = sections.find(section);
+    if (sit == sections.end()) return nullptr;
+    auto kit = sit->second.find(key);
+    return kit != sit->second.end() ? &kit->second : nullptr;
+}
+
+Configuration::Configuration() {
+    publish(default_sections(), "");
+}
+
+const ConfigSnapshot& Configuration::current() const {
+    uint64_t generation = generation_.load(std::memory_order_acquire);
+    SnapshotCache& cache = tls_snapshot;
+    if (cache.owner != this || cache.generation != generation) {
+        cache.snapshot = snapshot_.load(std::memory_order_acquire);
+        cache.generation = generation;
+        cache.owner = this;
+    }
+    return *cache.snapshot;
+}
+
+void Configuration::publish(SectionMap sections, std::string config_path) {
+    auto snap = std::make_shared<ConfigSnapshot>();
+    snap->sections = std::move(sections);
+    snap->config_path = std::move(config_path);
+    snap->generation = generation_.load(std::memory_order_relaxed) + 1;
     
-    std::ifstream file(path);
-    if (!file.is_open()) return false;
+    // Precompute the well-known keys
+    auto find = [&](const char* section, const char* key) { return snap->find(section, key); };
+    snap->data_directory = parse_string(find("General", "data_directory"), "tms_data");
+    snap->max_volumes = parse_size(find("General", "max_volumes"), 100000);
+    snap->max_datasets = parse_size(find("General", "max_datasets"), 1000000);
+    snap->auto_save = parse_bool(find("General", "auto_save"), true);
+    snap->auto_save_interval = parse_int(find("General", "auto_save_interval"), 300);
+    snap->strict_validation = parse_bool(find("General", "strict_validation"), true);
     
-    config_path_ = path;
-    std::string current_section = "General";
-    std::string line;
+    snap->enable_compression = parse_bool(find("Catalog", "enable_compression"), false);
+    snap->enable_backup = parse_bool(find("Catalog", "enable_backup"), true);
+    snap->backup_retention_days = parse_int(find("Catalog", "backup_retention_days"), 30);
+    snap->backup_directory = parse_string(find("Catalog", "backup_directory"), "tms_data/backups");
     
-    while (std::getline(file, line)) {
-        // Trim whitespace
-        size_t start = line.find_first_not_of(" \t");
-        if (start == std::string::npos) continue;
-        size_t end = line.find_last_not_of(" \t\r\n");
-        line = line.substr(start, end - start + 1);
-        
-        // Skip empty lines and comments
-        if (line.empty() || line[0] == '#' || line[0] == ';') continue;
+    snap->log_level = parse_string(find("Logging", "log_level"), "INFO");
+    snap->log_to_file = parse_bool(find("Logging", "log_to_file"), true);
+    snap->log_file = parse_string(find("Logging", "log_file"), "tms.log");
+    snap->log_to_console = parse_bool(find("Logging", "log_to_console"), true);
+    snap->log_max_size = parse_size(find("Logging", "log_max_size"), 10485760);
+    snap->log_max_files = parse_size(find("Logging", "log_max_files"), 5);
+    
+    snap->enable_audit = parse_bool(find("Audit", "enable_audit"), true);
+    snap->audit_retention_days = parse_int(find("Audit", "retention_days"), 90);
+    snap->audit_file = parse_string(find("Audit", "audit_file"), "tms_audit.log");
+    
+    snap->lock_timeout_ms = parse_int(find("Performance", "lock_timeout_ms"), 5000);
+    snap->retry_count = parse_int(find("Performance", "retry_count"), 3);
+    snap->retry_delay_ms = parse_int(find("Performance", "retry_delay_ms"), 100);
+    snap->batch_size = parse_size(find("Performance", "batch_size"), 100);
+    snap->clock_resolution_ms = parse_int(find("Performance", "clock_resolution_ms"), 0);
+    snap->lock_free_reads = parse_bool(find("Performance", "lock_free_reads"), false);
+    
+    snap->daemon_socket_path = parse_string(find("Daemon", "socket_path"), "tms_data/tms.sock");
+    snap->daemon_tcp_port = parse_int(find("Daemon", "tcp_port"), -1);
+    snap->daemon_workers = parse_size(find("Daemon", "workers"), 4);
+    
+    // Store before bumping the generation so a reader that sees the new
+    // generation also sees this snapshot
+    snapshot_.store(std::move(snap), std::memory_order_release);
+    generation_.fetch_add(1, std::memory_order_release);
+}
+
+bool Configuration::update(const std::function<bool(SectionMap&, std::string&)>& edit) {
+    std::vector<std::pair<std::string, std::string>> changes;
+    std::vector<std::pair<ChangeCallback, size_t>> pending;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto old = snapshot_.load(std::memory_order_acquire);
+        SectionMap sections = old->sections;
+        std::string config_path = old->config_path;
+        if (!edit(sections, config_path)) return false;
         
-        // Section header
-        if (line[0] == '[' && line.back() == ']') {
-            current_section = line.substr(1, line.size() - 2);
-            continue;
+        // Collect changed or added keys for callbacks before publishing
+        for (const auto& [section, keys] : sections) {
+            for (const auto& [key, value] : keys) {
+                const std::string* before = old->find(section, key);
+                if ((before ? *before : std::string()) == value) continue;
+                auto cit = callbacks_.find(section + "." + key);
+                if (cit == callbacks_.end()) continue;
+                changes.emplace_back(cit->first, value);
+                for (const auto& cb : cit->second) pending.emplace_back(cb, changes.size() - 1);
+            }
         }
         
-        // Key=value pair
-        size_t eq_pos = line.find('=');
-        if (eq_pos != std::string::npos) {
-            std::string key = line.substr(0, eq_pos);
-            std::string value = line.substr(eq_pos + 1);
-            
-            // Trim key
-            size_t ks = key.find_first_not_of(" \t");
-            size_t ke = key.find_last_not_of(" \t");
-            if (ks != std::string::npos) key = key.substr(ks, ke - ks + 1);
+        publish(std::move(sections), std::move(config_path));
+    }
+    
+    // Callbacks run after publication and outside the writer lock, so they
+    // may read (or change) the configuration themselves
+    for (const auto& [cb, index] : pending) {
+        cb(changes[index].first, changes[index].second);
+    }
+    return true;
+}
+
+void Configuration::set_defaults() {
+    update([](SectionMap& sections, std::string&) {
+        sections = default_sections();
+        return true;
+    });
+}
+
+bool Configuration::load_from_file(const std::string& path) {
+    return update([&](SectionMap& sections, std::string& config_path) {
+        std::ifstream file(path);
+        if (!file.is_open()) return false;
+        
+        config_path = path;
+        std::string current_section = "General";
+        std::string line;
+        
+        while (std::getline(file, line)) {
+            // Trim whitespace
+            size_t start = line.find_first_not_of(" \t");
+            if (start == std::string::npos) continue;
+            size_t end = line.find_last_not_of(" \t\r\n");
+            line = line.substr(start, end - start + 1);
             
-            // Trim value
-            size_t vs = value.find_first_not_of(" \t");
-            size_t ve = value.find_last_not_of(" \t");
-            if (vs != std::string::npos) value = value.substr(vs, ve - vs + 1);
+            // Skip empty lines and comments
+            if (line.empty() || line[0] == '#' || line[0] == ';') continue;
             
-            // Remove quotes if present
-            if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
-                value = value.substr(1, value.size() - 2);
+            // Section header
+            if (line[0] == '[' && line.back() == ']') {
+                current_section = line.substr(1, line.size() - 2);
+                continue;
             }
             
-            sections_[current_section][key] = expand_env_vars(value);
+            // Key=value pair
+            size_t eq_pos = line.find('=');
+            if (eq_pos != std::string::npos) {
+                std::string key = line.substr(0, eq_pos);
+                std::string value = line.substr(eq_pos + 1);
+                
+                // Trim key
+                size_t ks = key.find_first_not_of(" \t");
+                size_t ke = key.find_last_not_of(" \t");
+                if (ks != std::string::npos) key = key.substr(ks, ke - ks + 1);
+                
+                // Trim value
+                size_t vs = value.find_first_not_of(" \t");
+                size_t ve = value.find_last_not_of(" \t");
+                if (vs != std::string::npos) value = value.substr(vs, ve - vs + 1);
+                
+                // Remove quotes if present
+                if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
+                    value = value.substr(1, value.size() - 2);
+                }
+                
+                sections[current_section][key] = expand_env_vars(value);
+            }
         }
-    }
-    
-    return true;
+        
+        return true;
+    });
 }
 
 bool Configuration::save_to_file(const std::string& path) const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    auto snap = snapshot();
     
     // Create parent directories if needed
     try {
@@ -135,7 +286,7 @@ bool Configuration::save_to_file(const std::string& path) const {
     file << "# Version " << VERSION_STRING << "\n";
     file << "# Generated: " << __DATE__ << " " << __TIME__ << "\n\n";
     
-    for (const auto& [section, keys] : sections_) {
+    for (const auto& [section, keys] : snap->sections) {
         file << "[" << section << "]\n";
         for (const auto& [key, value] : keys) {
             file << key << " = " << value << "\n";
@@ -147,10 +298,13 @@ bool Configuration::save_to_file(const std::string& path) const {
 }
 
 bool Configuration::reload() {
-    if (config_path_.empty()) return false;
-    return load_from_file(config_path_);
+    std::string path = get_config_path();
+    if (path.empty()) return false;
+    return load_from_file(path);
 }
 
+std::string Configuration::get_config_path() const { return current().config_path; }
+
 std::string Configuration::expand_env_vars(const std::string& value) const {
     std::string result = value;
     size_t pos = 0;
@@ -202,67 +356,60 @@ std::string Configuration::expand_env_vars(const std::string& value) const {
 // Generic getters
 std::string Configuration::get_string(const std::string& section, const std::string& key,
                                       const std::string& default_val) const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto sit = sections_.find(section);
-    if (sit != sections_.end()) {
-        auto kit = sit->second.find(key);
-        if (kit != sit->second.end()) return kit->second;
-    }
-    return default_val;
+    return parse_string(current().find(section, key), default_val);
 }
 
 int Configuration::get_int(const std::string& section, const std::string& key, int default_val) const {
-    std::string val = get_string(section, key, "");
-    if (val.empty()) return default_val;
-    try { return std::stoi(val); } catch (...) { return default_val; }
+    return parse_int(current().find(section, key), default_val);
 }
 
 bool Configuration::get_bool(const std::string& section, const std::string& key, bool default_val) const {
-    std::string val = get_string(section, key, "");
-    if (val.empty()) return default_val;
-    std::transform(val.begin(), val.end(), val.begin(),
-                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
-    return val == "true" || val == "1" || val == "yes" || val == "on";
+    return parse_bool(current().find(section, key), default_val);
 }
 
 size_t Configuration::get_size(const std::string& section, const std::string& key, size_t default_val) const {
-    std::string val = get_string(section, key, "");
-    if (val.empty()) return default_val;
-    try { return std::stoull(val); } catch (...) { return default_val; }
+    return parse_size(current().find(section, key), default_val);
 }
 
 // Specific getters - General
-std::string Configuration::get_data_directory() const { return get_string("General", "data_directory", "tms_data"); }
-size_t Configuration::get_max_volumes() const { return get_size("General", "max_volumes", 100000); }
-size_t Configuration::get_max_datasets() const { return get_size("General", "max_datasets", 1000000); }
-bool Configuration::get_auto_save() const { return get_bool("General", "auto_save", true); }
-int Configuration::get_auto_save_interval() const { return get_int("General", "auto_save_interval", 300); }
-bool Configuration::get_strict_validation() const { return get_bool("General", "strict_validation", true); }
+std::string Configuration::get_data_directory() const { return current().data_directory; }
+size_t Configuration::get_max_volumes() const { return current().max_volumes; }
+size_t Configuration::get_max_datasets() const { return current().max_datasets; }
+bool Configuration::get_auto_save() const { return current().auto_save; }
+int Configuration::get_auto_save_interval() const { return current().auto_save_interval; }
+bool Configuration::get_strict_validation() const { return current().strict_validation; }
 
 // Specific getters - Catalog
-bool Configuration::get_enable_compression() const { return get_bool("Catalog", "enable_compression", false); }
-bool Configuration::get_enable_backup() const { return get_bool("Catalog", "enable_backup", true); }
-int Configuration::get_backup_retention_days() const { return get_int("Catalog", "backup_retention_days", 30); }
-std::string Configuration::get_backup_directory() const { return get_string("Catalog", "backup_directory", "tms_data/backups"); }
+bool Configuration::get_enable_compression() const { return current().enable_compression; }
+bool Configuration::get_enable_backup() const { return current().enable_backup; }
+int Configuration::get_backup_retention_days() const { return current().backup_retention_days; }
+std::string Configuration::get_backup_directory() const { return current().backup_directory; }
 
 // Specific getters - Logging
-std::string Configuration::get_log_level() const { return get_string("Logging", "log_level", "INFO"); }
-bool Configuration::get_log_to_file() const { return get_bool("Logging", "log_to_file", true); }
-std::string Configuration::get_log_file() const { return get_string("Logging", "log_file", "tms.log"); }
-bool Configuration::get_log_to_console() const { return get_bool("Logging", "log_to_console", true); }
-size_t Configuration::get_log_max_size() const { return get_size("Logging", "log_max_size", 10485760); }
-size_t Configuration::get_log_max_files() const { return get_size("Logging", "log_max_files", 5); }
+std::string Configuration::get_log_level() const { return current().log_level; }
+bool Configuration::get_log_to_file() const { return current().log_to_file; }
+std::string Configuration::get_log_file() const { return current().log_file; }
+bool Configuration::get_log_to_console() const { return current().log_to_console; }
+size_t Configuration::get_log_max_size() const { return current().log_max_size; }
+size_t Configuration::get_log_max_files() const { return current().log_max_files; }
 
 // Specific getters - Audit
-bool Configuration::get_enable_audit() const { return get_bool("Audit", "enable_audit", true); }
-int Configuration::get_audit_retention_days() const { return get_int("Audit", "retention_days", 90); }
-std::string Configuration::get_audit_file() const { return get_string("Audit", "audit_file", "tms_audit.log"); }
+bool Configuration::get_enable_audit() const { return current().enable_audit; }
+int Configuration::get_audit_retention_days() const { return current().audit_retention_days; }
+std::string Configuration::get_audit_file() const { return current().audit_file; }
 
 // Specific getters - Performance
-int Configuration::get_lock_timeout_ms() const { return get_int("Performance", "lock_timeout_ms", 5000); }
-int Configuration::get_retry_count() const { return get_int("Performance", "retry_count", 3); }
-int Configuration::get_retry_delay_ms() const { return get_int("Performance", "retry_delay_ms", 100); }
-size_t Configuration::get_batch_size() const { return get_size("Performance", "batch_size", 100); }
+int Configuration::get_lock_timeout_ms() const { return current().lock_timeout_ms; }
+int Configuration::get_retry_count() const { return current().retry_count; }
+int Configuration::get_retry_delay_ms() const { return current().retry_delay_ms; }
+size_t Configuration::get_batch_size() const { return current().batch_size; }
+int Configuration::get_clock_resolution_ms() const { return current().clock_resolution_ms; }
+bool Configuration::get_lock_free_reads() const { return current().lock_free_reads; }
+
+// Specific getters - Daemon
+std::string Configuration::get_daemon_socket_path() const { return current().daemon_socket_path; }
+int Configuration::get_daemon_tcp_port() const { return current().daemon_tcp_port; }
+size_t Configuration::get_daemon_workers() const { return current().daemon_workers; }
 
 // Setters
 void Configuration::set_data_directory(const std::string& dir) {
@@ -274,12 +421,10 @@ void Configuration::set_log_level(const std::string& level) {
 }
 
 void Configuration::set_string(const std::string& section, const std::string& key, const std::string& value) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    std::string old_value = sections_[section][key];
-    sections_[section][key] = value;
-    if (old_value != value) {
-        notify_change(section + "." + key, value);
-    }
+    update([&](SectionMap& sections, std::string&) {
+        sections[section][key] = value;
+        return true;
+    });
 }
 
 void Configuration::set_int(const std::string& section, const std::string& key, int value) {
@@ -292,19 +437,18 @@ void Configuration::set_bool(const std::string& section, const std::string& key,
 
 // Section operations
 std::vector<std::string> Configuration::get_sections() const {
-    std::lock_guard<std::mutex> lock(mutex_);
     std::vector<std::string> result;
-    for (const auto& [section, _] : sections_) {
+    for (const auto& [section, _] : current().sections) {
         result.push_back(section);
     }
     return result;
 }
 
 std::vector<std::string> Configuration::get_keys(const std::string& section) const {
-    std::lock_guard<std::mutex> lock(mutex_);
     std::vector<std::string> result;
-    auto it = sections_.find(section);
-    if (it != sections_.end()) {
+    const auto& sections = current().sections;
+    auto it = sections.find(section);
+    if (it != sections.end()) {
         for (const auto& [key, _] : it->second) {
             result.push_back(key);
         }
@@ -313,28 +457,26 @@ std::vector<std::string> Configuration::get_keys(const std::string& section) con
 }
 
 bool Configuration::has_section(const std::string& section) const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return sections_.find(section) != sections_.end();
+    const auto& sections = current().sections;
+    return sections.find(section) != sections.end();
 }
 
 bool Configuration::has_key(const std::string& section, const std::string& key) const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto sit = sections_.find(section);
-    if (sit == sections_.end()) return false;
-    return sit->second.find(key) != sit->second.end();
+    return current().find(section, key) != nullptr;
 }
 
 void Configuration::remove_key(const std::string& section, const std::string& key) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto it = sections_.find(section);
-    if (it != sections_.end()) {
-        it->second.erase(key);
-    }
+    update([&](SectionMap& sections, std::string&) {
+        auto it = sections.find(section);
+        if (it == sections.end() || it->second.erase(key) == 0) return false;
+        return true;
+    });
 }
 
 void Configuration::remove_section(const std::string& section) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    sections_.erase(section);
+    update([&](SectionMap& sections, std::string&) {
+        return sections.erase(section) > 0;
+    });
 }
 
 void Configuration::register_callback(const std::string& key, ChangeCallback callback) {
@@ -347,16 +489,6 @@ void Configuration::unregister_callbacks(const std::string& key) {
     callbacks_.erase(key);
 }
 
-void Configuration::notify_change(const std::string& key, const std::string& value) {
-    // Note: mutex already held by caller
-    auto it = callbacks_.find(key);
-    if (it != callbacks_.end()) {
-        for (const auto& cb : it->second) {
-            cb(key, value);
-        }
-    }
-}
-
 std::vector<std::string> Configuration::validate() const {
     std::vector<std::string> errors;
     
@@ -390,11 +522,11 @@ std::vector<std::string> Configuration::validate() const {
 }
 
 std::string Configuration::to_string() const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    auto snap = snapshot();
     std::ostringstream oss;
     
     oss << "\n=== TMS CONFIGURATION ===\n";
-    for (const auto& [section, keys] : sections_) {
+    for (const auto& [section, keys] : snap->sections) {
         oss << "\n[" << section << "]\n";
         for (const auto& [key, value] : keys) {
             oss << "  " << key << " = " << value << "\n";
@@ -406,14 +538,15 @@ std::string Configuration::to_string() const {
 }
 
 void Configuration::merge_from(const Configuration& other) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    // Note: This is a simplified merge - in a real implementation,
-    // you'd need to handle the other's mutex as well
-    for (const auto& section : other.get_sections()) {
-        for (const auto& key : other.get_keys(section)) {
-            sections_[section][key] = other.get_string(section, key);
+    auto theirs = other.snapshot();
+    update([&](SectionMap& sections, std::string&) {
+        for (const auto& [section, keys] : theirs->sections) {
+            for (const auto& [key, value] : keys) {
+                sections[section][key] = value;
+            }
         }
-    }
+        return true;
+    });
 }
 
 } // namespace tms
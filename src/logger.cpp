@@ -8,6 +8,7 @@
  */
 
 #include "logger.h"
+#include "tms_utils.h"
 #include <iostream>
 #include <filesystem>
 #include <map>
@@ -119,21 +120,18 @@ void Logger::rotate_logs() {
 
 std::string Logger::get_timestamp() const {
     auto now = std::chrono::system_clock::now();
-    auto time_t_now = std::chrono::system_clock::to_time_t(now);
     auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
         now.time_since_epoch()) % 1000;
     
-    std::tm tm_buf{};
-#ifdef _WIN32
-    localtime_s(&tm_buf, &time_t_now);
-#else
-    localtime_r(&time_t_now, &tm_buf);
-#endif
-    
-    std::ostringstream oss;
-    oss << std::put_time(&tm_buf, "%Y-%m-%d %H:%M:%S")
-        << '.' << std::setfill('0') << std::setw(3) << ms.count();
-    return oss.str();
+    // v3.4.0: Cached-day codec instead of localtime + put_time per message
+    std::string out;
+    out.reserve(TimestampCodec::TEXT_LENGTH + 4);
+    TimestampCodec::append(out, now);
+    char frac[4] = {'.', static_cast<char>('0' + ms.count() / 100),
+                    static_cast<char>('0' + (ms.count() / 10) % 10),
+                    static_cast<char>('0' + ms.count() % 10)};
+    out.append(frac, sizeof(frac));
+    return out;
 }
 
 std::string Logger::get_color_code(Level level) const {
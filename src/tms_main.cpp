@@ -10,11 +10,18 @@
 #include "tms_tape_mgmt.h"
 #include "logger.h"
 #include "configuration.h"
+#include "tms_rpc.h"
+#include "tms_replication.h"
+#include "tms_partition.h"
 #include <iostream>
 #include <sstream>
 #include <algorithm>
 #include <iomanip>
 #include <cctype>
+#include <csignal>
+#include <cstdlib>
+#include <thread>
+#include <optional>
 
 using namespace tms;
 
@@ -84,7 +91,7 @@ void add_volume_interactive(TMSSystem& system) {
     volume.owner = to_upper(owner);
     volume.pool = to_upper(pool);
     volume.status = VolumeStatus::SCRATCH;
-    volume.creation_date = std::chrono::system_clock::now();
+    volume.creation_date = current_time();
     volume.expiration_date = volume.creation_date + std::chrono::hours(24 * 365);
     
     switch (density_choice) {
@@ -135,7 +142,7 @@ void add_dataset_interactive(TMSSystem& system) {
     dataset.status = DatasetStatus::ACTIVE;
     dataset.size_bytes = size_mb * 1024 * 1024;
     dataset.file_sequence = 1;
-    dataset.creation_date = std::chrono::system_clock::now();
+    dataset.creation_date = current_time();
     dataset.expiration_date = dataset.creation_date + std::chrono::hours(24 * 30);
     
     auto result = system.add_dataset(dataset);
@@ -297,21 +304,208 @@ void show_health_check(TMSSystem& system) {
     }
 }
 
+// ============================================================================
+// Daemon Mode
+// ============================================================================
+
+static volatile std::sig_atomic_t g_stop_requested = 0;
+
+extern "C" void request_stop(int) { g_stop_requested = 1; }
+
+struct DaemonOptions {
+    bool enabled = false;
+    std::string socket_path = Configuration::instance().get_daemon_socket_path();
+    int tcp_port = Configuration::instance().get_daemon_tcp_port();
+    size_t workers = Configuration::instance().get_daemon_workers();
+    std::string replicate_path;     ///< Ship the change log to followers here
+    std::string follow_path;        ///< Follow the primary shipping here; read-only
+    std::string route;              ///< Partition map; serve it instead of the local catalog
+    std::string command;            ///< "promote" or "replica-status" against socket_path
+};
+
+void print_usage() {
+    std::cerr << "Usage: tms [DATA_DIR] [--daemon [--socket PATH] [--tcp PORT] [--workers N]\n"
+              << "                          [--replicate PATH | --follow PATH | --route MAP]]\n"
+              << "       tms [--socket PATH] --promote | --replica-status\n"
+              << "  Without --daemon, runs the interactive console.\n"
+              << "  MAP is PATH[,LOWER=PATH...]: the daemon sockets owning each volser range.\n";
+}
+
+void print_replication_status(const ReplicationStatus& s) {
+    std::cout << "Role:             " << replication_role_to_string(s.role) << "\n"
+              << "Log id:           " << (s.log_id.empty() ? "-" : s.log_id) << "\n";
+    if (s.role == ReplicationRole::PRIMARY) {
+        std::cout << "Last sequence:    " << s.applied_sequence << "\n"
+                  << "Followers:        " << s.followers << "\n"
+                  << "Max lag:          " << s.lag_records << " changes\n"
+                  << "Snapshots sent:   " << s.snapshots << "\n";
+        return;
+    }
+    std::cout << "Primary:          " << s.primary << (s.connected ? " (connected)" : " (disconnected)") << "\n"
+              << "Applied:          " << s.applied_sequence << " of " << s.primary_sequence << "\n"
+              << "Lag:              " << s.lag_records << " changes, " << s.apply_lag_ms << " ms\n"
+              << "Last contact:     " << s.since_contact_ms << " ms ago\n"
+              << "Records applied:  " << s.records_applied << "\n"
+              << "Snapshots:        " << s.snapshots << "\n"
+              << "Reconnects:       " << s.reconnects << "\n";
+}
+
+/// Run --promote or --replica-status against a running daemon
+int run_replica_command(const DaemonOptions& daemon) {
+#if TMS_HAS_RPC
+    RpcClient client;
+    auto connected = client.connect_unix(daemon.socket_path);
+    if (!connected) {
+        std::cerr << "[FAIL] " << connected.error().message << "\n";
+        return 1;
+    }
+    if (daemon.command == "promote") {
+        auto promoted = promote_replica(client);
+        std::cout << (promoted ? "[OK] Promoted; now accepting writes" : "[FAIL] " + promoted.error().message) << "\n";
+        return promoted ? 0 : 1;
+    }
+    auto status = get_replication_status(client);
+    if (!status) {
+        std::cerr << "[FAIL] " << status.error().message << "\n";
+        return 1;
+    }
+    print_replication_status(status.value());
+    return 0;
+#else
+    (void)daemon;
+    std::cerr << "[FAIL] Replication is only available on Linux\n";
+    return 1;
+#endif
+}
+
+/// Serve the catalog until SIGINT/SIGTERM, then save it
+int run_daemon(TMSSystem& system, const DaemonOptions& daemon) {
+#if TMS_HAS_RPC
+    RpcServerOptions options;
+    options.socket_path = daemon.socket_path;
+    options.tcp_port = daemon.tcp_port;
+    options.workers = daemon.workers;
+    
+    // Declared before the server, whose handlers refer to them
+    std::optional<ReplicationPrimary> shipper;
+    std::optional<ReplicationFollower> follower;
+    std::optional<PartitionRouter> router;
+    RpcServer server(system);
+    if (!daemon.replicate_path.empty()) {
+        shipper.emplace(system);
+        ReplicationPrimaryOptions ship;
+        ship.socket_path = daemon.replicate_path;
+        auto shipping = shipper->start(ship);
+        if (!shipping) {
+            std::cerr << "[FAIL] " << shipping.error().message << "\n";
+            return 1;
+        }
+        shipper->attach(server);
+    } else if (!daemon.follow_path.empty()) {
+        follower.emplace(system);
+        follower->attach(server);
+    } else if (!daemon.route.empty()) {
+        auto map = PartitionMap::parse(daemon.route);
+        if (!map) {
+            std::cerr << "[FAIL] " << map.error().message << "\n";
+            return 1;
+        }
+        router.emplace(std::move(map.value()));
+        router->attach(server);
+    }
+    auto started = server.start(options);
+    if (!started) {
+        std::cerr << "[FAIL] " << started.error().message << "\n";
+        return 1;
+    }
+    if (follower) {
+        ReplicationFollowerOptions follow;
+        follow.primary_socket = daemon.follow_path;
+        follower->start(follow);
+    }
+    std::signal(SIGINT, request_stop);
+    std::signal(SIGTERM, request_stop);
+    
+    if (router) std::cout << "Serving a " << router->map().size() << "-partition catalog";
+    else std::cout << "Serving " << system.get_volume_count() << " volumes, "
+                   << system.get_dataset_count() << " datasets";
+    if (!options.socket_path.empty()) std::cout << " on " << options.socket_path;
+    if (server.tcp_port() >= 0) std::cout << " on 127.0.0.1:" << server.tcp_port();
+    std::cout << " (" << options.workers << " workers). Ctrl-C to stop.\n";
+    if (shipper) std::cout << "Shipping change log " << shipper->log_id() << " on " << daemon.replicate_path << "\n";
+    if (follower) std::cout << "Read-only follower of " << daemon.follow_path << " until promoted\n";
+    if (router) {
+        std::cout << "Partitions:";
+        for (const auto& partition : router->map().partitions()) {
+            std::cout << " [" << (partition.lower.empty() ? "*" : partition.lower) << "] " << partition.socket_path;
+        }
+        std::cout << "\n";
+    }
+    
+    while (!g_stop_requested) std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    
+    server.stop();
+    if (follower) follower->stop();
+    if (shipper) shipper->stop();
+    auto stats = server.stats();
+    std::cout << "Served " << stats.requests << " requests (" << stats.frames << " frames, "
+              << stats.batches << " batches) on " << stats.connections_accepted << " connections\n";
+    auto saved = system.save_catalog();
+    std::cout << (saved ? "[OK] Catalog saved" : "[FAIL] " + saved.error().message) << "\n";
+    return saved ? 0 : 1;
+#else
+    (void)system;
+    (void)daemon;
+    std::cerr << "[FAIL] Daemon mode is only available on Linux\n";
+    return 1;
+#endif
+}
+
 int main(int argc, char* argv[]) {
     // Configure logging
     Logger::instance().set_level(Logger::Level::WARNING);
     Logger::instance().enable_console(false);
     
-    print_banner();
-    
-    // Determine data directory
+    // Determine data directory and mode
     std::string data_dir = Configuration::instance().get_data_directory();
-    if (argc > 1) data_dir = argv[1];
+    DaemonOptions daemon;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--daemon") daemon.enabled = true;
+        else if (arg == "--socket" && has_value) daemon.socket_path = argv[++i];
+        else if (arg == "--tcp" && has_value) daemon.tcp_port = std::atoi(argv[++i]);
+        else if (arg == "--workers" && has_value) daemon.workers = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--replicate" && has_value) daemon.replicate_path = argv[++i];
+        else if (arg == "--follow" && has_value) daemon.follow_path = argv[++i];
+        else if (arg == "--route" && has_value) daemon.route = argv[++i];
+        else if (arg == "--promote") daemon.command = "promote";
+        else if (arg == "--replica-status") daemon.command = "replica-status";
+        else if (!arg.empty() && arg[0] != '-') data_dir = arg;
+        else {
+            print_usage();
+            return 2;
+        }
+    }
+    int modes = !daemon.replicate_path.empty() + !daemon.follow_path.empty() + !daemon.route.empty();
+    if ((modes > 0 && !daemon.enabled) || modes > 1) {
+        print_usage();
+        return 2;
+    }
+    if (!daemon.command.empty()) return run_replica_command(daemon);
+    
+    print_banner();
     
     std::cout << "Data directory: " << data_dir << "\n";
     std::cout << "Platform: " << PLATFORM_NAME << "\n";
     
+    int clock_resolution = Configuration::instance().get_clock_resolution_ms();
+    if (clock_resolution > 0) enable_coarse_clock(std::chrono::milliseconds(clock_resolution));
+    
     TMSSystem system(data_dir);
+    if (Configuration::instance().get_lock_free_reads()) system.enable_lock_free_reads();
+    
+    if (daemon.enabled) return run_daemon(system, daemon);
     
     // Offer to initialize sample data if empty
     if (system.get_volume_count() == 0) {
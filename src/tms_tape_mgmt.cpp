@@ -16,6 +16,9 @@
 #include <atomic>
 #include <functional>
 #include <cmath>
+#include <ranges>
+#include <charconv>
+#include <barrier>
 
 namespace tms {
 
@@ -74,6 +77,9 @@ TMSSystem::TMSSystem(const std::string& data_directory)
 }
 
 TMSSystem::~TMSSystem() {
+    stop_history_compactor();
+    stop_workload_capture();
+    disable_change_stream();
     save_catalog();
     TMS_LOG_INFO("TMSSystem", "TMS System shutdown complete");
 }
@@ -91,6 +97,12 @@ bool TMSSystem::ensure_directory_exists(const std::string& path) {
 }
 
 void TMSSystem::rebuild_indices() {
+    hot_volumes_.invalidate();
+    if (lock_free_reads_.load(std::memory_order_relaxed)) {
+        published_volumes_.assign(volumes_);
+        published_datasets_.assign(datasets_);
+    }
+    
     // Clear all indices
     volume_owner_index_.clear();
     volume_pool_index_.clear();
@@ -121,11 +133,15 @@ void TMSSystem::rebuild_indices() {
 // ============================================================================
 
 OperationResult TMSSystem::add_volume(const TapeVolume& volume) {
+    return add_volume(TapeVolume(volume));
+}
+
+OperationResult TMSSystem::add_volume(TapeVolume&& volume) {
     if (!validate_volser(volume.volser)) {
         return OperationResult::err(TMSError::INVALID_VOLSER, "Invalid volume serial: " + volume.volser);
     }
     
-    std::unique_lock<std::shared_mutex> lock(catalog_mutex_);
+    auto lock = lock_for_write();
     
     if (volumes_.size() >= Configuration::instance().get_max_volumes()) {
         return OperationResult::err(TMSError::VOLUME_LIMIT_REACHED, "Maximum volume limit reached");
@@ -135,9 +151,9 @@ OperationResult TMSSystem::add_volume(const TapeVolume& volume) {
         return OperationResult::err(TMSError::VOLUME_ALREADY_EXISTS, "Volume already exists: " + volume.volser);
     }
     
-    TapeVolume vol = volume;
+    TapeVolume& vol = volume;
     if (vol.creation_date == std::chrono::system_clock::time_point{}) {
-        vol.creation_date = std::chrono::system_clock::now();
+        vol.creation_date = current_time();
     }
     if (vol.expiration_date == std::chrono::system_clock::time_point{}) {
         vol.expiration_date = vol.creation_date + std::chrono::hours(24 * 365);
@@ -148,27 +164,30 @@ OperationResult TMSSystem::add_volume(const TapeVolume& volume) {
     
     // v3.2.0: Calculate initial health score
     vol.health_score = calculate_health_score(vol);
-    vol.last_health_check = std::chrono::system_clock::now();
+    vol.last_health_check = current_time();
     
     // Add to primary storage
-    volumes_[vol.volser] = vol;
+    retire_volume(vol.volser, nullptr);
+    const std::string volser = vol.volser;
+    const VolumeStatus status = vol.status;
+    const TapeVolume& stored = volumes_.emplace(volser, std::move(vol)).first->second;
     
     // Update secondary indices
-    volume_owner_index_.add(vol.owner, vol.volser);
-    volume_pool_index_.add(vol.pool, vol.volser);
-    for (const auto& tag : vol.tags) {
-        volume_tag_index_.add(tag, vol.volser);
+    volume_owner_index_.add(stored.owner, volser);
+    volume_pool_index_.add(stored.pool, volser);
+    for (const auto& tag : stored.tags) {
+        volume_tag_index_.add(tag, volser);
     }
     
     lock.unlock();
-    add_audit_record("ADD_VOLUME", vol.volser, "Status: " + volume_status_to_string(vol.status));
+    add_audit_record("ADD_VOLUME", volser, "Status: " + volume_status_to_string(status));
     PerformanceMetrics::instance().increment_counter("volumes_added");
     
     return OperationResult::ok();
 }
 
 OperationResult TMSSystem::delete_volume(const std::string& volser, bool force) {
-    std::unique_lock<std::shared_mutex> lock(catalog_mutex_);
+    auto lock = lock_for_write();
     
     auto it = volumes_.find(volser);
     if (it == volumes_.end()) {
@@ -204,11 +223,13 @@ OperationResult TMSSystem::delete_volume(const std::string& volser, bool force)
                 for (const auto& tag : ds_it->second.tags) {
                     dataset_tag_index_.remove(tag, ds_name);
                 }
+                retire_dataset(ds_name, &ds_it->second);
                 datasets_.erase(ds_it);
             }
         }
     }
     
+    retire_volume(volser, &it->second);
     volumes_.erase(it);
     
     lock.unlock();
@@ -219,6 +240,13 @@ OperationResult TMSSystem::delete_volume(const std::string& volser, bool force)
 }
 
 Result<TapeVolume> TMSSystem::get_volume(const std::string& volser) const {
+    if (capturing_.load(std::memory_order_relaxed)) capture_event({0, "GET_VOLUME", volser, {}, {}, {}, {}, {}});
+    if (auto published = read_published(published_volumes_, volser, [&volser](const TapeVolume* vol) {
+            return vol ? Result<TapeVolume>::ok(*vol)
+                       : Result<TapeVolume>::err(TMSError::VOLUME_NOT_FOUND, "Volume not found: " + volser);
+        })) {
+        return std::move(*published);
+    }
     std::shared_lock<std::shared_mutex> lock(catalog_mutex_);
     
     auto it = volumes_.find(volser);
@@ -230,7 +258,11 @@ Result<TapeVolume> TMSSystem::get_volume(const std::string& volser) const {
 }
 
 OperationResult TMSSystem::update_volume(const TapeVolume& volume) {
-    std::unique_lock<std::shared_mutex> lock(catalog_mutex_);
+    return update_volume(TapeVolume(volume));
+}
+
+OperationResult TMSSystem::update_volume(TapeVolume&& volume) {
+    auto lock = lock_for_write();
     
     auto it = volumes_.find(volume.volser);
     if (it == volumes_.end()) {
@@ -257,10 +289,80 @@ OperationResult TMSSystem::update_volume(const TapeVolume& volume) {
         }
     }
     
-    it->second = volume;
+    const std::string volser = it->first;
+    retire_volume(volser, &it->second);
+    it->second = std::move(volume);
+    
+    lock.unlock();
+    add_audit_record("UPDATE_VOLUME", volser, "Updated");
+    
+    return OperationResult::ok();
+}
+
+bool TMSSystem::read_volume(const std::string& volser, const VolumeVisitor& visit) const {
+    if (capturing_.load(std::memory_order_relaxed)) capture_event({0, "GET_VOLUME", volser, {}, {}, {}, {}, {}});
+    if (auto found = read_published(published_volumes_, volser, [&visit](const TapeVolume* vol) {
+            if (vol) visit(*vol);
+            return vol != nullptr;
+        })) {
+        return *found;
+    }
+    std::shared_lock<std::shared_mutex> lock(catalog_mutex_);
+    
+    auto it = volumes_.find(volser);
+    if (it == volumes_.end()) return false;
+    visit(it->second);
+    return true;
+}
+
+OperationResult TMSSystem::patch_volume(const std::string& volser, const VolumePatch& patch) {
+    auto lock = lock_for_write();
+    
+    auto it = volumes_.find(volser);
+    if (it == volumes_.end()) {
+        return OperationResult::err(TMSError::VOLUME_NOT_FOUND, "Volume not found: " + volser);
+    }
+    TapeVolume& vol = it->second;
+    retire_volume(volser, &vol);
+    
+    std::string changed;
+    auto note = [&changed](const char* field) {
+        if (!changed.empty()) changed += ",";
+        changed += field;
+    };
+    if (patch.status) { vol.status = *patch.status; note("status"); }
+    if (patch.pool) {
+        Symbol pool(*patch.pool);
+        volume_pool_index_.update(vol.pool, pool, volser);
+        vol.pool = pool;
+        note("pool");
+    }
+    if (patch.owner) {
+        Symbol owner(*patch.owner);
+        volume_owner_index_.update(vol.owner, owner, volser);
+        vol.owner = owner;
+        note("owner");
+    }
+    if (patch.expiration_date) { vol.expiration_date = *patch.expiration_date; note("expiration_date"); }
+    if (patch.write_protected) { vol.write_protected = *patch.write_protected; note("write_protected"); }
+    if (patch.notes) { vol.notes = *patch.notes; note("notes"); }
+    if (patch.media_type) { vol.media_type = *patch.media_type; note("media_type"); }
+    if (patch.storage_tier) { vol.storage_tier = *patch.storage_tier; note("storage_tier"); }
+    if (!patch.add_tags.empty() || !patch.remove_tags.empty()) {
+        for (const auto& tag : patch.remove_tags) {
+            auto tag_it = vol.tags.find(tag);
+            if (tag_it == vol.tags.end()) continue;
+            volume_tag_index_.remove(*tag_it, volser);
+            vol.tags.erase(tag_it);
+        }
+        for (const auto& tag : patch.add_tags) {
+            if (!tag.empty() && vol.tags.insert(tag).second) volume_tag_index_.add(tag, volser);
+        }
+        note("tags");
+    }
     
     lock.unlock();
-    add_audit_record("UPDATE_VOLUME", volume.volser, "Updated");
+    add_audit_record("UPDATE_VOLUME", volser, "Patched: " + changed);
     
     return OperationResult::ok();
 }
@@ -269,10 +371,13 @@ std::vector<TapeVolume> TMSSystem::list_volumes(std::optional<VolumeStatus> stat
     std::shared_lock<std::shared_mutex> lock(catalog_mutex_);
     
     std::vector<TapeVolume> result;
-    for (const auto& [volser, vol] : volumes_) {
-        if (!status.has_value() || vol.status == status.value()) {
-            result.push_back(vol);
-        }
+    if (!status.has_value()) {
+        result.reserve(volumes_.size());
+        for (const auto& [volser, vol] : volumes_) result.push_back(vol);
+        return result;
+    }
+    for (const auto& row : hot_volumes().rows()) {
+        if (row.get_status() == status.value()) result.push_back(*row.record);
     }
     return result;
 }
@@ -283,6 +388,10 @@ size_t TMSSystem::get_volume_count() const {
 }
 
 bool TMSSystem::volume_exists(const std::string& volser) const {
+    if (auto found = read_published(published_volumes_, volser,
+                                    [](const TapeVolume* vol) { return vol != nullptr; })) {
+        return *found;
+    }
     std::shared_lock<std::shared_mutex> lock(catalog_mutex_);
     return volumes_.count(volser) > 0;
 }
@@ -365,49 +474,32 @@ std::vector<TapeVolume> TMSSystem::search_volumes(const std::string& owner,
 }
 
 std::vector<TapeVolume> TMSSystem::search_volumes(const SearchCriteria& criteria) const {
+    if (capturing_.load(std::memory_order_relaxed)) {
+        WorkloadEvent event;
+        event.operation = "SEARCH_VOLUMES";
+        event.target = criteria.pattern;
+        event.args["mode"] = std::to_string(static_cast<int>(criteria.mode));
+        if (criteria.status) event.args["status"] = volume_status_to_string(*criteria.status);
+        if (criteria.owner) event.args["owner"] = *criteria.owner;
+        if (criteria.pool) event.args["pool"] = *criteria.pool;
+        if (criteria.location) event.args["location"] = *criteria.location;
+        if (criteria.tag) event.args["tag"] = *criteria.tag;
+        if (criteria.limit > 0) event.args["limit"] = std::to_string(criteria.limit);
+        capture_event(std::move(event));
+    }
+    const CriteriaSymbols symbols(criteria);
+    if (symbols.unmatchable) return {};
     std::shared_lock<std::shared_mutex> lock(catalog_mutex_);
     
     std::vector<TapeVolume> result;
     
-    for (const auto& [volser, vol] : volumes_) {
-        // Pattern matching (uses cached regex)
-        if (!criteria.pattern.empty()) {
-            if (!matches_pattern(volser, criteria.pattern, criteria.mode)) {
-                continue;
-            }
-        }
-        
-        // Filter by status
-        if (criteria.status.has_value() && vol.status != criteria.status.value()) {
-            continue;
-        }
-        
-        // Filter by owner
-        if (criteria.owner.has_value() && vol.owner != criteria.owner.value()) {
-            continue;
-        }
-        
-        // Filter by pool
-        if (criteria.pool.has_value() && vol.pool != criteria.pool.value()) {
-            continue;
-        }
-        
-        // Filter by location
-        if (criteria.location.has_value() && 
-            vol.location.find(criteria.location.value()) == std::string::npos) {
-            continue;
-        }
-        
-        // Filter by tag
-        if (criteria.tag.has_value() && !vol.has_tag(criteria.tag.value())) {
-            continue;
-        }
-        
-        // Filter by creation date
-        if (criteria.created_after.has_value() && vol.creation_date < criteria.created_after.value()) {
-            continue;
-        }
-        if (criteria.created_before.has_value() && vol.creation_date > criteria.created_before.value()) {
+    // Equality filters on the hot row first; only candidates touch the full record
+    for (const auto& row : hot_volumes().rows()) {
+        if (criteria.status.has_value() && row.get_status() != criteria.status.value()) continue;
+        if (symbols.owner.has_value() && row.owner != symbols.owner.value()) continue;
+        if (symbols.pool.has_value() && row.pool != symbols.pool.value()) continue;
+        const TapeVolume& vol = *row.record;
+        if (!volume_matches(vol, criteria, symbols)) {
             continue;
         }
         
@@ -422,16 +514,52 @@ std::vector<TapeVolume> TMSSystem::search_volumes(const SearchCriteria& criteria
     return result;
 }
 
+bool TMSSystem::volume_matches(const TapeVolume& vol, const SearchCriteria& criteria,
+                               const CriteriaSymbols& symbols) const {
+    // Pattern matching (uses cached regex)
+    if (!criteria.pattern.empty() && !matches_pattern(vol.volser, criteria.pattern, criteria.mode)) {
+        return false;
+    }
+    
+    // Filter by status, owner, pool
+    if (criteria.status.has_value() && vol.status != criteria.status.value()) return false;
+    if (symbols.owner.has_value() && vol.owner != symbols.owner.value()) return false;
+    if (symbols.pool.has_value() && vol.pool != symbols.pool.value()) return false;
+    
+    // Filter by location
+    if (criteria.location.has_value() && 
+        vol.location.find(criteria.location.value()) == std::string::npos) {
+        return false;
+    }
+    
+    // Filter by tag
+    if (symbols.tag.has_value() && vol.tags.count(symbols.tag.value()) == 0) return false;
+    
+    // Filter by creation date
+    if (criteria.created_after.has_value() && vol.creation_date < criteria.created_after.value()) {
+        return false;
+    }
+    if (criteria.created_before.has_value() && vol.creation_date > criteria.created_before.value()) {
+        return false;
+    }
+    
+    return true;
+}
+
 // ============================================================================
 // Dataset Management
 // ============================================================================
 
 OperationResult TMSSystem::add_dataset(const Dataset& dataset) {
+    return add_dataset(Dataset(dataset));
+}
+
+OperationResult TMSSystem::add_dataset(Dataset&& dataset) {
     if (!validate_dataset_name(dataset.name)) {
         return OperationResult::err(TMSError::INVALID_DATASET_NAME, "Invalid dataset name: " + dataset.name);
     }
     
-    std::unique_lock<std::shared_mutex> lock(catalog_mutex_);
+    auto lock = lock_for_write();
     
     if (datasets_.size() >= Configuration::instance().get_max_datasets()) {
         return OperationResult::err(TMSError::DATASET_LIMIT_REACHED, "Maximum dataset limit reached");
@@ -446,16 +574,17 @@ OperationResult TMSSystem::add_dataset(const Dataset& dataset) {
         return OperationResult::err(TMSError::VOLUME_NOT_FOUND, "Volume not found: " + dataset.volser);
     }
     
-    Dataset ds = dataset;
-    if (ds.creation_date == std::chrono::system_clock::time_point{}) {
-        ds.creation_date = std::chrono::system_clock::now();
+    if (dataset.creation_date == std::chrono::system_clock::time_point{}) {
+        dataset.creation_date = current_time();
     }
-    if (ds.expiration_date == std::chrono::system_clock::time_point{}) {
-        ds.expiration_date = ds.creation_date + std::chrono::hours(24 * 30);
+    if (dataset.expiration_date == std::chrono::system_clock::time_point{}) {
+        dataset.expiration_date = dataset.creation_date + std::chrono::hours(24 * 30);
     }
     
     // Add to primary storage
-    datasets_[ds.name] = ds;
+    retire_dataset(dataset.name, nullptr);
+    std::string name = dataset.name;
+    const Dataset& ds = datasets_.emplace(name, std::move(dataset)).first->second;
     
     // Update secondary indices
     dataset_owner_index_.add(ds.owner, ds.name);
@@ -464,21 +593,23 @@ OperationResult TMSSystem::add_dataset(const Dataset& dataset) {
     }
     
     // Update volume
+    retire_volume(vol_it->first, &vol_it->second);
     vol_it->second.datasets.push_back(ds.name);
     vol_it->second.used_bytes += ds.size_bytes;
     if (vol_it->second.status == VolumeStatus::SCRATCH) {
         vol_it->second.status = VolumeStatus::PRIVATE;
     }
     
+    std::string volser = ds.volser;
     lock.unlock();
-    add_audit_record("ADD_DATASET", ds.name, "Volume: " + ds.volser);
+    add_audit_record("ADD_DATASET", name, "Volume: " + volser);
     PerformanceMetrics::instance().increment_counter("datasets_added");
     
     return OperationResult::ok();
 }
 
 OperationResult TMSSystem::delete_dataset(const std::string& name) {
-    std::unique_lock<std::shared_mutex> lock(catalog_mutex_);
+    auto lock = lock_for_write();
     
     auto it = datasets_.find(name);
     if (it == datasets_.end()) {
@@ -488,6 +619,7 @@ OperationResult TMSSystem::delete_dataset(const std::string& name) {
     // Update volume
     auto vol_it = volumes_.find(it->second.volser);
     if (vol_it != volumes_.end()) {
+        retire_volume(vol_it->first, &vol_it->second);
         auto& ds_list = vol_it->second.datasets;
         ds_list.erase(std::remove(ds_list.begin(), ds_list.end(), name), ds_list.end());
         
@@ -508,6 +640,7 @@ OperationResult TMSSystem::delete_dataset(const std::string& name) {
         dataset_tag_index_.remove(tag, name);
     }
     
+    retire_dataset(name, &it->second);
     datasets_.erase(it);
     
     lock.unlock();
@@ -518,6 +651,13 @@ OperationResult TMSSystem::delete_dataset(const std::string& name) {
 }
 
 Result<Dataset> TMSSystem::get_dataset(const std::string& name) const {
+    if (capturing_.load(std::memory_order_relaxed)) capture_event({0, "GET_DATASET", name, {}, {}, {}, {}, {}});
+    if (auto published = read_published(published_datasets_, name, [&name](const Dataset* ds) {
+            return ds ? Result<Dataset>::ok(*ds)
+                      : Result<Dataset>::err(TMSError::DATASET_NOT_FOUND, "Dataset not found: " + name);
+        })) {
+        return std::move(*published);
+    }
     std::shared_lock<std::shared_mutex> lock(catalog_mutex_);
     
     auto it = datasets_.find(name);
@@ -529,7 +669,11 @@ Result<Dataset> TMSSystem::get_dataset(const std::string& name) const {
 }
 
 OperationResult TMSSystem::update_dataset(const Dataset& dataset) {
-    std::unique_lock<std::shared_mutex> lock(catalog_mutex_);
+    return update_dataset(Dataset(dataset));
+}
+
+OperationResult TMSSystem::update_dataset(Dataset&& dataset) {
+    auto lock = lock_for_write();
     
     auto it = datasets_.find(dataset.name);
     if (it == datasets_.end()) {
@@ -553,10 +697,72 @@ OperationResult TMSSystem::update_dataset(const Dataset& dataset) {
         }
     }
     
-    it->second = dataset;
+    const std::string name = it->first;
+    retire_dataset(name, &it->second);
+    it->second = std::move(dataset);
+    
+    lock.unlock();
+    add_audit_record("UPDATE_DATASET", name, "Updated");
+    
+    return OperationResult::ok();
+}
+
+bool TMSSystem::read_dataset(const std::string& name, const DatasetVisitor& visit) const {
+    if (capturing_.load(std::memory_order_relaxed)) capture_event({0, "GET_DATASET", name, {}, {}, {}, {}, {}});
+    if (auto found = read_published(published_datasets_, name, [&visit](const Dataset* ds) {
+            if (ds) visit(*ds);
+            return ds != nullptr;
+        })) {
+        return *found;
+    }
+    std::shared_lock<std::shared_mutex> lock(catalog_mutex_);
+    
+    auto it = datasets_.find(name);
+    if (it == datasets_.end()) return false;
+    visit(it->second);
+    return true;
+}
+
+OperationResult TMSSystem::patch_dataset(const std::string& name, const DatasetPatch& patch) {
+    auto lock = lock_for_write();
+    
+    auto it = datasets_.find(name);
+    if (it == datasets_.end()) {
+        return OperationResult::err(TMSError::DATASET_NOT_FOUND, "Dataset not found: " + name);
+    }
+    Dataset& ds = it->second;
+    retire_dataset(name, &ds);
+    
+    std::string changed;
+    auto note = [&changed](const char* field) {
+        if (!changed.empty()) changed += ",";
+        changed += field;
+    };
+    if (patch.status) { ds.status = *patch.status; note("status"); }
+    if (patch.owner) {
+        Symbol owner(*patch.owner);
+        dataset_owner_index_.update(ds.owner, owner, name);
+        ds.owner = owner;
+        note("owner");
+    }
+    if (patch.job_name) { ds.job_name = *patch.job_name; note("job_name"); }
+    if (patch.expiration_date) { ds.expiration_date = *patch.expiration_date; note("expiration_date"); }
+    if (patch.notes) { ds.notes = *patch.notes; note("notes"); }
+    if (!patch.add_tags.empty() || !patch.remove_tags.empty()) {
+        for (const auto& tag : patch.remove_tags) {
+            auto tag_it = ds.tags.find(tag);
+            if (tag_it == ds.tags.end()) continue;
+            dataset_tag_index_.remove(*tag_it, name);
+            ds.tags.erase(tag_it);
+        }
+        for (const auto& tag : patch.add_tags) {
+            if (!tag.empty() && ds.tags.insert(tag).second) dataset_tag_index_.add(tag, name);
+        }
+        note("tags");
+    }
     
     lock.unlock();
-    add_audit_record("UPDATE_DATASET", dataset.name, "Updated");
+    add_audit_record("UPDATE_DATASET", name, "Patched: " + changed);
     
     return OperationResult::ok();
 }
@@ -586,6 +792,8 @@ std::vector<Dataset> TMSSystem::list_datasets_on_volume(const std::string& volse
 }
 
 std::vector<Dataset> TMSSystem::search_datasets(const SearchCriteria& criteria) const {
+    const CriteriaSymbols symbols(criteria);
+    if (symbols.unmatchable) return {};
     std::shared_lock<std::shared_mutex> lock(catalog_mutex_);
     
     std::vector<Dataset> result;
@@ -597,11 +805,11 @@ std::vector<Dataset> TMSSystem::search_datasets(const SearchCriteria& criteria)
             }
         }
         
-        if (criteria.owner.has_value() && ds.owner != criteria.owner.value()) {
+        if (symbols.owner.has_value() && ds.owner != symbols.owner.value()) {
             continue;
         }
         
-        if (criteria.tag.has_value() && !ds.has_tag(criteria.tag.value())) {
+        if (symbols.tag.has_value() && ds.tags.count(symbols.tag.value()) == 0) {
             continue;
         }
         
@@ -628,6 +836,10 @@ size_t TMSSystem::get_dataset_count() const {
 }
 
 bool TMSSystem::dataset_exists(const std::string& name) const {
+    if (auto found = read_published(published_datasets_, name,
+                                    [](const Dataset* ds) { return ds != nullptr; })) {
+        return *found;
+    }
     std::shared_lock<std::shared_mutex> lock(catalog_mutex_);
     return datasets_.count(name) > 0;
 }
@@ -655,13 +867,14 @@ OperationResult TMSSystem::add_volume_tag(const std::string& volser, const std::
         return OperationResult::err(TMSError::INVALID_TAG, "Invalid tag: " + tag);
     }
     
-    std::unique_lock<std::shared_mutex> lock(catalog_mutex_);
+    auto lock = lock_for_write();
     
     auto it = volumes_.find(volser);
     if (it == volumes_.end()) {
         return OperationResult::err(TMSError::VOLUME_NOT_FOUND, "Volume not found: " + volser);
     }
     
+    retire_volume(volser, &it->second);
     it->second.tags.insert(tag);
     volume_tag_index_.add(tag, volser);
     
@@ -672,13 +885,14 @@ OperationResult TMSSystem::add_volume_tag(const std::string& volser, const std::
 }
 
 OperationResult TMSSystem::remove_volume_tag(const std::string& volser, const std::string& tag) {
-    std::unique_lock<std::shared_mutex> lock(catalog_mutex_);
+    auto lock = lock_for_write();
     
     auto it = volumes_.find(volser);
     if (it == volumes_.end()) {
         return OperationResult::err(TMSError::VOLUME_NOT_FOUND, "Volume not found: " + volser);
     }
     
+    retire_volume(volser, &it->second);
     it->second.tags.erase(tag);
     volume_tag_index_.remove(tag, volser);
     
@@ -721,30 +935,38 @@ OperationResult TMSSystem::add_dataset_tag(const std::string& name, const std::s
         return OperationResult::err(TMSError::INVALID_TAG, "Invalid tag: " + tag);
     }
     
-    std::unique_lock<std::shared_mutex> lock(catalog_mutex_);
+    auto lock = lock_for_write();
     
     auto it = datasets_.find(name);
     if (it == datasets_.end()) {
         return OperationResult::err(TMSError::DATASET_NOT_FOUND, "Dataset not found: " + name);
     }
     
+    retire_dataset(name, &it->second);
     it->second.tags.insert(tag);
     dataset_tag_index_.add(tag, name);
     
+    lock.unlock();
+    add_audit_record("ADD_DATASET_TAG", name, "Tag: " + tag);
+    
     return OperationResult::ok();
 }
 
 OperationResult TMSSystem::remove_dataset_tag(const std::string& name, const std::string& tag) {
-    std::unique_lock<std::shared_mutex> lock(catalog_mutex_);
+    auto lock = lock_for_write();
     
     auto it = datasets_.find(name);
     if (it == datasets_.end()) {
         return OperationResult::err(TMSError::DATASET_NOT_FOUND, "Dataset not found: " + name);
     }
     
+    retire_dataset(name, &it->second);
     it->second.tags.erase(tag);
     dataset_tag_index_.remove(tag, name);
     
+    lock.unlock();
+    add_audit_record("REMOVE_DATASET_TAG", name, "Tag: " + tag);
+    
     return OperationResult::ok();
 }
 
@@ -778,7 +1000,7 @@ std::set<std::string> TMSSystem::get_all_dataset_tags() const {
 
 OperationResult TMSSystem::reserve_volume(const std::string& volser, const std::string& user,
                                           std::chrono::seconds duration) {
-    std::unique_lock<std::shared_mutex> lock(catalog_mutex_);
+    auto lock = lock_for_write();
     
     auto it = volumes_.find(volser);
     if (it == volumes_.end()) {
@@ -790,8 +1012,9 @@ OperationResult TMSSystem::reserve_volume(const std::string& volser, const std::
             "Volume reserved by: " + it->second.reserved_by);
     }
     
+    retire_volume(volser, &it->second);
     it->second.reserved_by = user;
-    it->second.reservation_expires = std::chrono::system_clock::now() + duration;
+    it->second.reservation_expires = current_time() + duration;
     
     lock.unlock();
     add_audit_record("RESERVE_VOLUME", volser, "User: " + user + ", Duration: " + std::to_string(duration.count()) + "s");
@@ -800,7 +1023,7 @@ OperationResult TMSSystem::reserve_volume(const std::string& volser, const std::
 }
 
 OperationResult TMSSystem::release_volume(const std::string& volser, const std::string& user) {
-    std::unique_lock<std::shared_mutex> lock(catalog_mutex_);
+    auto lock = lock_for_write();
     
     auto it = volumes_.find(volser);
     if (it == volumes_.end()) {
@@ -816,6 +1039,7 @@ OperationResult TMSSystem::release_volume(const std::string& volser, const std::
             "Cannot release: reserved by " + it->second.reserved_by);
     }
     
+    retire_volume(volser, &it->second);
     it->second.reserved_by.clear();
     it->second.reservation_expires = std::chrono::system_clock::time_point{};
     
@@ -827,7 +1051,7 @@ OperationResult TMSSystem::release_volume(const std::string& volser, const std::
 
 OperationResult TMSSystem::extend_reservation(const std::string& volser, const std::string& user,
                                               std::chrono::seconds additional_time) {
-    std::unique_lock<std::shared_mutex> lock(catalog_mutex_);
+    auto lock = lock_for_write();
     
     auto it = volumes_.find(volser);
     if (it == volumes_.end()) {
@@ -838,6 +1062,7 @@ OperationResult TMSSystem::extend_reservation(const std::string& volser, const s
         return OperationResult::err(TMSError::ACCESS_DENIED, "Cannot extend: not your reservation");
     }
     
+    retire_volume(volser, &it->second);
     it->second.reservation_expires += additional_time;
     
     lock.unlock();
@@ -850,8 +1075,9 @@ std::vector<TapeVolume> TMSSystem::list_reserved_volumes() const {
     std::shared_lock<std::shared_mutex> lock(catalog_mutex_);
     
     std::vector<TapeVolume> result;
+    const auto now = current_time();
     for (const auto& [volser, vol] : volumes_) {
-        if (vol.is_reserved()) {
+        if (vol.is_reserved(now)) {
             result.push_back(vol);
         }
     }
@@ -859,13 +1085,14 @@ std::vector<TapeVolume> TMSSystem::list_reserved_volumes() const {
 }
 
 size_t TMSSystem::cleanup_expired_reservations() {
-    std::unique_lock<std::shared_mutex> lock(catalog_mutex_);
+    auto lock = lock_for_write();
     
     size_t count = 0;
-    auto now = std::chrono::system_clock::now();
+    auto now = current_time();
     
     for (auto& [volser, vol] : volumes_) {
         if (!vol.reserved_by.empty() && vol.reservation_expires <= now) {
+            retire_volume(volser, &vol);
             vol.reserved_by.clear();
             vol.reservation_expires = std::chrono::system_clock::time_point{};
             count++;
@@ -885,7 +1112,7 @@ size_t TMSSystem::cleanup_expired_reservations() {
 // ============================================================================
 
 OperationResult TMSSystem::mount_volume(const std::string& volser) {
-    std::unique_lock<std::shared_mutex> lock(catalog_mutex_);
+    auto lock = lock_for_write();
     
     auto it = volumes_.find(volser);
     if (it == volumes_.end()) {
@@ -900,9 +1127,10 @@ OperationResult TMSSystem::mount_volume(const std::string& volser) {
         return OperationResult::err(TMSError::VOLUME_OFFLINE, "Volume is offline");
     }
     
+    retire_volume(volser, &it->second);
     it->second.status = VolumeStatus::MOUNTED;
     it->second.mount_count++;
-    it->second.last_used = std::chrono::system_clock::now();
+    it->second.last_used = current_time();
     
     lock.unlock();
     add_audit_record("MOUNT_VOLUME", volser, "Mount count: " + std::to_string(it->second.mount_count));
@@ -911,7 +1139,7 @@ OperationResult TMSSystem::mount_volume(const std::string& volser) {
 }
 
 OperationResult TMSSystem::dismount_volume(const std::string& volser) {
-    std::unique_lock<std::shared_mutex> lock(catalog_mutex_);
+    auto lock = lock_for_write();
     
     auto it = volumes_.find(volser);
     if (it == volumes_.end()) {
@@ -922,8 +1150,9 @@ OperationResult TMSSystem::dismount_volume(const std::string& volser) {
         return OperationResult::err(TMSError::VOLUME_NOT_MOUNTED, "Volume not mounted");
     }
     
+    retire_volume(volser, &it->second);
     it->second.status = it->second.datasets.empty() ? VolumeStatus::SCRATCH : VolumeStatus::PRIVATE;
-    it->second.last_used = std::chrono::system_clock::now();
+    it->second.last_used = current_time();
     
     lock.unlock();
     add_audit_record("DISMOUNT_VOLUME", volser, "");
@@ -932,7 +1161,7 @@ OperationResult TMSSystem::dismount_volume(const std::string& volser) {
 }
 
 OperationResult TMSSystem::scratch_volume(const std::string& volser) {
-    std::unique_lock<std::shared_mutex> lock(catalog_mutex_);
+    auto lock = lock_for_write();
     
     auto it = volumes_.find(volser);
     if (it == volumes_.end()) {
@@ -951,10 +1180,12 @@ OperationResult TMSSystem::scratch_volume(const std::string& volser) {
             for (const auto& tag : ds_it->second.tags) {
                 dataset_tag_index_.remove(tag, ds_name);
             }
+            retire_dataset(ds_name, &ds_it->second);
             datasets_.erase(ds_it);
         }
     }
     
+    retire_volume(volser, &it->second);
     it->second.datasets.clear();
     it->second.used_bytes = 0;
     it->second.status = VolumeStatus::SCRATCH;
@@ -966,7 +1197,7 @@ OperationResult TMSSystem::scratch_volume(const std::string& volser) {
 }
 
 OperationResult TMSSystem::migrate_dataset(const std::string& name) {
-    std::unique_lock<std::shared_mutex> lock(catalog_mutex_);
+    auto lock = lock_for_write();
     
     auto it = datasets_.find(name);
     if (it == datasets_.end()) {
@@ -977,6 +1208,7 @@ OperationResult TMSSystem::migrate_dataset(const std::string& name) {
         return OperationResult::err(TMSError::DATASET_MIGRATED, "Dataset already migrated");
     }
     
+    retire_dataset(name, &it->second);
     it->second.status = DatasetStatus::MIGRATED;
     
     lock.unlock();
@@ -986,7 +1218,7 @@ OperationResult TMSSystem::migrate_dataset(const std::string& name) {
 }
 
 OperationResult TMSSystem::recall_dataset(const std::string& name) {
-    std::unique_lock<std::shared_mutex> lock(catalog_mutex_);
+    auto lock = lock_for_write();
     
     auto it = datasets_.find(name);
     if (it == datasets_.end()) {
@@ -997,8 +1229,9 @@ OperationResult TMSSystem::recall_dataset(const std::string& name) {
         return OperationResult::err(TMSError::INVALID_STATE, "Dataset not migrated");
     }
     
+    retire_dataset(name, &it->second);
     it->second.status = DatasetStatus::RECALLED;
-    it->second.last_accessed = std::chrono::system_clock::now();
+    it->second.last_accessed = current_time();
     
     lock.unlock();
     add_audit_record("RECALL_DATASET", name, "");
@@ -1007,7 +1240,7 @@ OperationResult TMSSystem::recall_dataset(const std::string& name) {
 }
 
 OperationResult TMSSystem::set_volume_offline(const std::string& volser) {
-    std::unique_lock<std::shared_mutex> lock(catalog_mutex_);
+    auto lock = lock_for_write();
     
     auto it = volumes_.find(volser);
     if (it == volumes_.end()) {
@@ -1018,6 +1251,7 @@ OperationResult TMSSystem::set_volume_offline(const std::string& volser) {
         return OperationResult::err(TMSError::VOLUME_MOUNTED, "Cannot take mounted volume offline");
     }
     
+    retire_volume(volser, &it->second);
     it->second.status = VolumeStatus::OFFLINE;
     
     lock.unlock();
@@ -1027,7 +1261,7 @@ OperationResult TMSSystem::set_volume_offline(const std::string& volser) {
 }
 
 OperationResult TMSSystem::set_volume_online(const std::string& volser) {
-    std::unique_lock<std::shared_mutex> lock(catalog_mutex_);
+    auto lock = lock_for_write();
     
     auto it = volumes_.find(volser);
     if (it == volumes_.end()) {
@@ -1038,6 +1272,7 @@ OperationResult TMSSystem::set_volume_online(const std::string& volser) {
         return OperationResult::err(TMSError::INVALID_STATE, "Volume not offline");
     }
     
+    retire_volume(volser, &it->second);
     it->second.status = it->second.datasets.empty() ? VolumeStatus::SCRATCH : VolumeStatus::PRIVATE;
     
     lock.unlock();
@@ -1052,15 +1287,20 @@ OperationResult TMSSystem::set_volume_online(const std::string& volser) {
 
 Result<std::string> TMSSystem::allocate_scratch_volume(const std::string& pool,
                                                         std::optional<TapeDensity> density) {
-    std::unique_lock<std::shared_mutex> lock(catalog_mutex_);
-    
-    for (auto& [volser, vol] : volumes_) {
-        if (vol.is_available_for_scratch()) {
-            if (!pool.empty() && vol.pool != pool) continue;
-            if (density.has_value() && vol.density != density.value()) continue;
+    auto lock = lock_for_write();
+    
+    // Scan the hot rows; nothing has been modified yet under this lock
+    const auto now = current_time();
+    for (const auto& row : hot_volumes().rows()) {
+        if (row.is_available_for_scratch(now)) {
+            if (!pool.empty() && row.pool != pool) continue;
+            if (density.has_value() && row.get_density() != density.value()) continue;
             
+            const std::string volser = row.volser();
+            TapeVolume& vol = volumes_.find(volser)->second;
+            retire_volume(volser, &vol);
             vol.status = VolumeStatus::PRIVATE;
-            vol.last_used = std::chrono::system_clock::now();
+            vol.last_used = now;
             
             lock.unlock();
             add_audit_record("ALLOCATE_SCRATCH", volser, "Pool: " + pool);
@@ -1076,10 +1316,11 @@ std::vector<std::string> TMSSystem::get_scratch_pool(size_t count, const std::st
     std::shared_lock<std::shared_mutex> lock(catalog_mutex_);
     
     std::vector<std::string> result;
-    for (const auto& [volser, vol] : volumes_) {
-        if (vol.is_available_for_scratch()) {
-            if (pool.empty() || vol.pool == pool) {
-                result.push_back(volser);
+    const auto now = current_time();
+    for (const auto& row : hot_volumes().rows()) {
+        if (row.is_available_for_scratch(now)) {
+            if (pool.empty() || row.pool == pool) {
+                result.push_back(row.volser());
                 if (count > 0 && result.size() >= count) break;
             }
         }
@@ -1091,11 +1332,23 @@ std::vector<std::string> TMSSystem::get_scratch_pool(size_t count, const std::st
 std::pair<size_t, size_t> TMSSystem::get_scratch_pool_stats(const std::string& pool) const {
     std::shared_lock<std::shared_mutex> lock(catalog_mutex_);
     
+    if (pool.empty()) {
+        size_t available = 0;
+        const auto now = current_time();
+        for (const auto& row : hot_volumes().rows()) {
+            if (row.is_available_for_scratch(now)) available++;
+        }
+        return {available, volumes_.size()};
+    }
+    auto symbol = Symbol::lookup(pool);
+    if (!symbol) return {0, 0};
+    
     size_t available = 0, total = 0;
-    for (const auto& [volser, vol] : volumes_) {
-        if (pool.empty() || vol.pool == pool) {
+    const auto now = current_time();
+    for (const auto& row : hot_volumes().rows()) {
+        if (row.pool == *symbol) {
             total++;
-            if (vol.is_available_for_scratch()) available++;
+            if (row.is_available_for_scratch(now)) available++;
         }
     }
     
@@ -1112,21 +1365,24 @@ PoolStatistics TMSSystem::get_pool_statistics(const std::string& pool) const {
     
     PoolStatistics stats;
     stats.pool_name = pool;
+    auto symbol = Symbol::lookup(pool);
+    if (!symbol || symbol->empty()) return stats;
     
-    for (const auto& [volser, vol] : volumes_) {
-        if (vol.pool == pool) {
+    const auto now = current_time();
+    for (const auto& vol : hot_volumes().rows()) {
+        if (vol.pool == *symbol) {
             stats.total_volumes++;
             stats.total_capacity += vol.capacity_bytes;
             stats.used_capacity += vol.used_bytes;
             
-            switch (vol.status) {
+            switch (vol.get_status()) {
                 case VolumeStatus::SCRATCH: stats.scratch_volumes++; break;
                 case VolumeStatus::PRIVATE: stats.private_volumes++; break;
                 case VolumeStatus::MOUNTED: stats.mounted_volumes++; break;
                 default: break;
             }
             
-            if (vol.is_reserved()) stats.reserved_volumes++;
+            if (vol.is_reserved(now)) stats.reserved_volumes++;
         }
     }
     
@@ -1226,14 +1482,15 @@ BatchResult TMSSystem::delete_datasets_batch(const std::vector<std::string>& nam
 // ============================================================================
 
 size_t TMSSystem::process_expirations(bool dry_run) {
-    std::unique_lock<std::shared_mutex> lock(catalog_mutex_);
+    auto lock = lock_for_write();
     
     size_t count = 0;
-    auto now = std::chrono::system_clock::now();
+    auto now = current_time();
     
     for (auto& [volser, vol] : volumes_) {
         if (vol.status != VolumeStatus::EXPIRED && vol.expiration_date < now) {
             if (!dry_run) {
+                retire_volume(volser, &vol);
                 vol.status = VolumeStatus::EXPIRED;
             }
             count++;
@@ -1243,6 +1500,7 @@ size_t TMSSystem::process_expirations(bool dry_run) {
     for (auto& [name, ds] : datasets_) {
         if (ds.status != DatasetStatus::EXPIRED && ds.expiration_date < now) {
             if (!dry_run) {
+                retire_dataset(name, &ds);
                 ds.status = DatasetStatus::EXPIRED;
             }
             count++;
@@ -1261,9 +1519,9 @@ std::vector<std::string> TMSSystem::list_expired_volumes() const {
     std::shared_lock<std::shared_mutex> lock(catalog_mutex_);
     
     std::vector<std::string> result;
-    for (const auto& [volser, vol] : volumes_) {
-        if (vol.status == VolumeStatus::EXPIRED) {
-            result.push_back(volser);
+    for (const auto& row : hot_volumes().rows()) {
+        if (row.get_status() == VolumeStatus::EXPIRED) {
+            result.push_back(row.volser());
         }
     }
     return result;
@@ -1285,13 +1543,13 @@ std::vector<std::string> TMSSystem::list_expiring_soon(std::chrono::hours within
     std::shared_lock<std::shared_mutex> lock(catalog_mutex_);
     
     std::vector<std::string> result;
-    auto now = std::chrono::system_clock::now();
+    auto now = current_time();
     auto threshold = now + within;
     
-    for (const auto& [volser, vol] : volumes_) {
-        if (vol.status != VolumeStatus::EXPIRED && 
-            vol.expiration_date > now && vol.expiration_date <= threshold) {
-            result.push_back("VOL:" + volser);
+    for (const auto& row : hot_volumes().rows()) {
+        if (row.get_status() != VolumeStatus::EXPIRED &&
+            row.expiration_date() > now && row.expiration_date() <= threshold) {
+            result.push_back("VOL:" + row.volser());
         }
     }
     
@@ -1317,7 +1575,24 @@ OperationResult TMSSystem::save_catalog() {
     if (!vol_file.is_open()) {
         return OperationResult::err(TMSError::FILE_OPEN_ERROR, "Cannot open volume catalog");
     }
+    write_volume_catalog(vol_file);
+    vol_file.close();
+    
+    // Save datasets
+    std::ofstream ds_file(dataset_catalog_path_);
+    if (!ds_file.is_open()) {
+        return OperationResult::err(TMSError::FILE_OPEN_ERROR, "Cannot open dataset catalog");
+    }
+    write_dataset_catalog(ds_file);
+    ds_file.close();
+    
+    TMS_LOG_DEBUG("TMSSystem", "Catalog saved: " + std::to_string(volumes_.size()) + " volumes, " +
+                  std::to_string(datasets_.size()) + " datasets");
     
+    return OperationResult::ok();
+}
+
+void TMSSystem::write_volume_catalog(std::ostream& vol_file) const {
     vol_file << "# TMS Volume Catalog v" << CATALOG_VERSION << "\n";
     vol_file << "# Generated: " << get_timestamp() << "\n";
     
@@ -1335,14 +1610,9 @@ OperationResult TMSSystem::save_catalog() {
                  << format_time(vol.creation_date) << "|"
                  << format_time(vol.expiration_date) << "\n";
     }
-    vol_file.close();
-    
-    // Save datasets
-    std::ofstream ds_file(dataset_catalog_path_);
-    if (!ds_file.is_open()) {
-        return OperationResult::err(TMSError::FILE_OPEN_ERROR, "Cannot open dataset catalog");
-    }
-    
+}
+
+void TMSSystem::write_dataset_catalog(std::ostream& ds_file) const {
     ds_file << "# TMS Dataset Catalog v" << CATALOG_VERSION << "\n";
     ds_file << "# Generated: " << get_timestamp() << "\n";
     
@@ -1357,117 +1627,119 @@ OperationResult TMSSystem::save_catalog() {
                 << format_time(ds.creation_date) << "|"
                 << format_time(ds.expiration_date) << "\n";
     }
-    ds_file.close();
-    
-    TMS_LOG_DEBUG("TMSSystem", "Catalog saved: " + std::to_string(volumes_.size()) + " volumes, " +
-                  std::to_string(datasets_.size()) + " datasets");
-    
-    return OperationResult::ok();
 }
 
+namespace {
+
+// Splits one catalog line into views of its '|'-separated fields
+void split_catalog_line(std::string_view line, std::pmr::vector<std::string_view>& fields) {
+    fields.clear();
+    size_t start = 0;
+    while (true) {
+        size_t bar = line.find('|', start);
+        fields.push_back(line.substr(start, bar - start));
+        if (bar == std::string_view::npos) break;
+        start = bar + 1;
+    }
+}
+
+template<typename T>
+void parse_catalog_number(std::string_view field, T& out) {
+    std::from_chars(field.data(), field.data() + field.size(), out);
+}
+
+} // namespace
+
 OperationResult TMSSystem::load_catalog() {
-    std::unique_lock<std::shared_mutex> lock(catalog_mutex_);
+    std::ifstream vol_file(volume_catalog_path_);
+    std::ifstream ds_file(dataset_catalog_path_);
+    read_catalog(vol_file.is_open() ? &vol_file : nullptr, ds_file.is_open() ? &ds_file : nullptr);
+    return OperationResult::ok();
+}
+
+void TMSSystem::read_catalog(std::istream* vol_file, std::istream* ds_file) {
+    auto lock = lock_for_write();
+    
+    // v3.4.0: Reloaded records have no usable history
+    volume_history_.reset(write_time_);
+    dataset_history_.reset(write_time_);
     
     volumes_.clear();
     datasets_.clear();
     
+    // v3.4.0: Lines are parsed in place; the line and field buffers live in
+    // one arena for the whole load
+    ScratchArena arena(ArenaKind::LOAD);
+    std::pmr::string line(arena.resource());
+    std::pmr::vector<std::string_view> fields(arena.resource());
+    auto field = [&fields](size_t i) { return i < fields.size() ? fields[i] : std::string_view(); };
+    
     // Load volumes
-    std::ifstream vol_file(volume_catalog_path_);
-    if (vol_file.is_open()) {
-        std::string line;
-        while (std::getline(vol_file, line)) {
+    if (vol_file) {
+        while (std::getline(*vol_file, line)) {
             if (line.empty() || line[0] == '#') continue;
             
-            std::istringstream iss(line);
-            std::string type;
-            std::getline(iss, type, '|');
-            
-            if (type == "VOLUME") {
+            split_catalog_line(line, fields);
+            if (fields[0] == "VOLUME") {
                 TapeVolume vol;
-                std::string status_str, density_str, wp_str, cap_str, used_str, create_str, exp_str;
-                std::string mount_str;
+                vol.volser = field(1);
+                vol.status = string_to_volume_status(field(2));
+                vol.density = string_to_density(field(3));
+                vol.location = field(4);
+                vol.pool = field(5);
+                vol.owner = field(6);
+                parse_catalog_number(field(7), vol.mount_count);
+                vol.write_protected = (field(8) == "1");
+                parse_catalog_number(field(9), vol.capacity_bytes);
+                parse_catalog_number(field(10), vol.used_bytes);
+                vol.creation_date = parse_time(field(11));
+                vol.expiration_date = parse_time(field(12));
                 
-                std::getline(iss, vol.volser, '|');
-                std::getline(iss, status_str, '|');
-                std::getline(iss, density_str, '|');
-                std::getline(iss, vol.location, '|');
-                std::getline(iss, vol.pool, '|');
-                std::getline(iss, vol.owner, '|');
-                std::getline(iss, mount_str, '|');
-                std::getline(iss, wp_str, '|');
-                std::getline(iss, cap_str, '|');
-                std::getline(iss, used_str, '|');
-                std::getline(iss, create_str, '|');
-                std::getline(iss, exp_str, '|');
-                
-                vol.status = string_to_volume_status(status_str);
-                vol.density = string_to_density(density_str);
-                try { vol.mount_count = std::stoi(mount_str); } catch (...) {}
-                vol.write_protected = (wp_str == "1");
-                try { vol.capacity_bytes = std::stoull(cap_str); } catch (...) {}
-                try { vol.used_bytes = std::stoull(used_str); } catch (...) {}
-                vol.creation_date = parse_time(create_str);
-                vol.expiration_date = parse_time(exp_str);
-                
-                volumes_[vol.volser] = vol;
+                std::string key = vol.volser;
+                volumes_.insert_or_assign(std::move(key), std::move(vol));
             }
         }
-        vol_file.close();
     }
     
     // Load datasets
-    std::ifstream ds_file(dataset_catalog_path_);
-    if (ds_file.is_open()) {
-        std::string line;
-        while (std::getline(ds_file, line)) {
+    if (ds_file) {
+        while (std::getline(*ds_file, line)) {
             if (line.empty() || line[0] == '#') continue;
             
-            std::istringstream iss(line);
-            std::string type;
-            std::getline(iss, type, '|');
-            
-            if (type == "DATASET") {
+            split_catalog_line(line, fields);
+            if (fields[0] == "DATASET") {
                 Dataset ds;
-                std::string status_str, size_str, seq_str, create_str, exp_str;
-                
-                std::getline(iss, ds.name, '|');
-                std::getline(iss, ds.volser, '|');
-                std::getline(iss, status_str, '|');
-                std::getline(iss, size_str, '|');
-                std::getline(iss, ds.owner, '|');
-                std::getline(iss, ds.job_name, '|');
-                std::getline(iss, seq_str, '|');
-                std::getline(iss, create_str, '|');
-                std::getline(iss, exp_str, '|');
-                
-                ds.status = string_to_dataset_status(status_str);
-                try { ds.size_bytes = std::stoull(size_str); } catch (...) {}
-                try { ds.file_sequence = std::stoi(seq_str); } catch (...) {}
-                ds.creation_date = parse_time(create_str);
-                ds.expiration_date = parse_time(exp_str);
-                
-                datasets_[ds.name] = ds;
+                ds.name = field(1);
+                ds.volser = field(2);
+                ds.status = string_to_dataset_status(field(3));
+                parse_catalog_number(field(4), ds.size_bytes);
+                ds.owner = field(5);
+                ds.job_name = field(6);
+                parse_catalog_number(field(7), ds.file_sequence);
+                ds.creation_date = parse_time(field(8));
+                ds.expiration_date = parse_time(field(9));
                 
                 // Update volume's dataset list
                 auto vol_it = volumes_.find(ds.volser);
                 if (vol_it != volumes_.end()) {
                     vol_it->second.datasets.push_back(ds.name);
                 }
+                
+                std::string key = ds.name;
+                datasets_.insert_or_assign(std::move(key), std::move(ds));
             }
         }
-        ds_file.close();
     }
     
     // Rebuild secondary indices
     rebuild_indices();
+    note_catalog_replaced();
     
     TMS_LOG_INFO("TMSSystem", "Catalog loaded: " + std::to_string(volumes_.size()) + " volumes, " +
                  std::to_string(datasets_.size()) + " datasets");
-    
-    return OperationResult::ok();
 }
 
-OperationResult TMSSystem::backup_catalog(const std::string& path) const {
+std::pair<std::string, std::string> TMSSystem::backup_file_paths(const std::string& path) const {
     std::string backup_dir = path.empty() ? data_directory_ + PATH_SEP_STR + "backups" : path;
     ensure_directory_exists(backup_dir);
     
@@ -1475,8 +1747,12 @@ OperationResult TMSSystem::backup_catalog(const std::string& path) const {
     std::replace(timestamp.begin(), timestamp.end(), ' ', '_');
     std::replace(timestamp.begin(), timestamp.end(), ':', '-');
     
-    std::string vol_backup = backup_dir + PATH_SEP_STR + "volumes_" + timestamp + ".dat";
-    std::string ds_backup = backup_dir + PATH_SEP_STR + "datasets_" + timestamp + ".dat";
+    return {backup_dir + PATH_SEP_STR + "volumes_" + timestamp + ".dat",
+            backup_dir + PATH_SEP_STR + "datasets_" + timestamp + ".dat"};
+}
+
+OperationResult TMSSystem::backup_catalog(const std::string& path) const {
+    auto [vol_backup, ds_backup] = backup_file_paths(path);
     
     try {
         fs::copy_file(volume_catalog_path_, vol_backup, fs::copy_options::overwrite_existing);
@@ -1503,250 +1779,1786 @@ OperationResult TMSSystem::restore_catalog(const std::string& backup_path) {
 
 OperationResult TMSSystem::export_to_csv(const std::string& volumes_file, 
                                           const std::string& datasets_file) const {
-    std::shared_lock<std::shared_mutex> lock(catalog_mutex_);
-    
-    // Export volumes
-    std::ofstream vol_out(volumes_file);
+    std::ofstream vol_out(volumes_file, std::ios::binary);
     if (!vol_out.is_open()) {
         return OperationResult::err(TMSError::FILE_OPEN_ERROR, "Cannot create: " + volumes_file);
     }
-    
-    vol_out << "Volser,Status,Density,Location,Pool,Owner,MountCount,Capacity,Used,Created,Expires\n";
-    for (const auto& [volser, vol] : volumes_) {
-        vol_out << vol.volser << ","
-                << volume_status_to_string(vol.status) << ","
-                << density_to_string(vol.density) << ","
-                << "\"" << vol.location << "\","
-                << vol.pool << ","
-                << vol.owner << ","
-                << vol.mount_count << ","
-                << vol.capacity_bytes << ","
-                << vol.used_bytes << ","
-                << format_time(vol.creation_date) << ","
-                << format_time(vol.expiration_date) << "\n";
-    }
-    vol_out.close();
-    
-    // Export datasets
-    std::ofstream ds_out(datasets_file);
+    std::ofstream ds_out(datasets_file, std::ios::binary);
     if (!ds_out.is_open()) {
         return OperationResult::err(TMSError::FILE_OPEN_ERROR, "Cannot create: " + datasets_file);
     }
     
-    ds_out << "Name,Volser,Status,Size,Owner,JobName,FileSeq,Created,Expires\n";
-    for (const auto& [name, ds] : datasets_) {
-        ds_out << ds.name << ","
-               << ds.volser << ","
-               << dataset_status_to_string(ds.status) << ","
-               << ds.size_bytes << ","
-               << ds.owner << ","
-               << ds.job_name << ","
-               << ds.file_sequence << ","
-               << format_time(ds.creation_date) << ","
-               << format_time(ds.expiration_date) << "\n";
-    }
-    ds_out.close();
+    // v3.4.0: Both files come from one consistent view of the catalog
+    ExportOptions vol_opts;
+    vol_opts.columns = {"Volser", "Status", "Density", "Location", "Pool", "Owner",
+                        "MountCount", "Capacity", "Used", "Created", "Expires"};
+    ExportOptions ds_opts;
+    ds_opts.columns = {"Name", "Volser", "Status", "Size", "Owner", "JobName",
+                       "FileSeq", "Created", "Expires"};
+    
+    std::shared_lock<std::shared_mutex> lock(catalog_mutex_);
+    auto vol_result = export_volumes_locked(vol_out, vol_opts, nullptr);
+    if (!vol_result.is_success()) {
+        return OperationResult::err(vol_result.error().code, vol_result.error().message);
+    }
+    auto ds_result = export_datasets_locked(ds_out, ds_opts, nullptr);
+    if (!ds_result.is_success()) {
+        return OperationResult::err(ds_result.error().code, ds_result.error().message);
+    }
     
     return OperationResult::ok();
 }
 
-Result<BatchResult> TMSSystem::import_volumes_from_csv(const std::string& file_path) {
-    std::ifstream file(file_path);
-    if (!file.is_open()) {
-        return Result<BatchResult>::err(TMSError::FILE_NOT_FOUND, "Cannot open: " + file_path);
+Result<ExportReport> TMSSystem::export_volumes(const std::string& file_path,
+                                               const ExportOptions& options,
+                                               const VolumeFilter& filter) const {
+    std::ofstream out(file_path, std::ios::binary);
+    if (!out.is_open()) {
+        return Result<ExportReport>::err(TMSError::FILE_OPEN_ERROR, "Cannot create: " + file_path);
+    }
+    
+    std::shared_lock<std::shared_mutex> lock(catalog_mutex_);
+    auto result = export_volumes_locked(out, options, filter);
+    lock.unlock();
+    
+    if (result.is_success()) {
+        PerformanceMetrics::instance().record_operation("export_volumes", result.value().duration.count());
+    }
+    return result;
+}
+
+Result<ExportReport> TMSSystem::export_datasets(const std::string& file_path,
+                                                const ExportOptions& options,
+                                                const DatasetFilter& filter) const {
+    std::ofstream out(file_path, std::ios::binary);
+    if (!out.is_open()) {
+        return Result<ExportReport>::err(TMSError::FILE_OPEN_ERROR, "Cannot create: " + file_path);
+    }
+    
+    std::shared_lock<std::shared_mutex> lock(catalog_mutex_);
+    auto result = export_datasets_locked(out, options, filter);
+    lock.unlock();
+    
+    if (result.is_success()) {
+        PerformanceMetrics::instance().record_operation("export_datasets", result.value().duration.count());
+    }
+    return result;
+}
+
+// Filters run here, so unselected records are never formatted or copied
+Result<ExportReport> TMSSystem::export_volumes_locked(std::ostream& out, const ExportOptions& options,
+                                                     const VolumeFilter& filter) const {
+    std::vector<const TapeVolume*> records;
+    records.reserve(filter ? 0 : volumes_.size());
+    for (const auto& [volser, vol] : volumes_) {
+        if (!filter || filter(vol)) records.push_back(&vol);
+    }
+    ExportEngine<TapeVolume> engine(volume_export_columns());
+    return engine.run(records, out, options);
+}
+
+Result<ExportReport> TMSSystem::export_datasets_locked(std::ostream& out, const ExportOptions& options,
+                                                      const DatasetFilter& filter) const {
+    std::vector<const Dataset*> records;
+    records.reserve(filter ? 0 : datasets_.size());
+    for (const auto& [name, ds] : datasets_) {
+        if (!filter || filter(ds)) records.push_back(&ds);
+    }
+    ExportEngine<Dataset> engine(dataset_export_columns());
+    return engine.run(records, out, options);
+}
+
+// v3.4.0: Legacy entry points now run on the bulk import pipeline
+namespace {
+
+BatchResult csv_report_to_batch(const CsvImportReport& report) {
+    BatchResult result;
+    result.total = report.rows;
+    result.succeeded = report.imported;
+    result.failed = report.failed;
+    result.duration = report.duration;
+    for (const auto& e : report.errors) {
+        result.failures.emplace_back(e.key, "Row " + std::to_string(e.row) + ": " + e.message);
+    }
+    return result;
+}
+
+template<typename T>
+bool parse_csv_number(std::string_view field, T& out) {
+    if (field.empty()) return true;  // keep the default
+    auto [ptr, ec] = std::from_chars(field.data(), field.data() + field.size(), out);
+    return ec == std::errc() && ptr == field.data() + field.size();
+}
+
+bool parse_csv_time(std::string_view field, std::chrono::system_clock::time_point& out) {
+    if (field.empty()) return true;
+    out = parse_time(std::string(field));
+    return out != std::chrono::system_clock::time_point{};
+}
+
+bool parse_volume_row(const CsvRow& row, TapeVolume& vol, std::string& error) {
+    vol.volser = row.get("volser");
+    if (!validate_volser(vol.volser)) {
+        error = "Invalid volume serial: " + vol.volser;
+        return false;
+    }
+    
+    std::string status(row.get("status"));
+    if (!status.empty()) {
+        vol.status = string_to_volume_status(status);
+        if (volume_status_to_string(vol.status) != status) {
+            error = "Invalid status: " + status;
+            return false;
+        }
+    }
+    std::string density(row.get("density"));
+    if (!density.empty()) {
+        vol.density = string_to_density(density);
+        if (density_to_string(vol.density) != density) {
+            error = "Invalid density: " + density;
+            return false;
+        }
+    }
+    
+    vol.location = row.get("location");
+    vol.pool = row.get("pool");
+    vol.owner = row.get("owner");
+    if (!vol.owner.empty() && !validate_owner(vol.owner)) {
+        error = "Invalid owner: " + vol.owner;
+        return false;
+    }
+    
+    // Used bytes are not read: they are rebuilt as datasets are linked
+    if (!parse_csv_number(row.get("mountcount"), vol.mount_count) || vol.mount_count < 0) {
+        error = "Invalid mount count: " + std::string(row.get("mountcount"));
+        return false;
+    }
+    if (!parse_csv_number(row.get("capacity"), vol.capacity_bytes)) {
+        error = "Invalid capacity: " + std::string(row.get("capacity"));
+        return false;
+    }
+    if (!parse_csv_time(row.get("created"), vol.creation_date) ||
+        !parse_csv_time(row.get("expires"), vol.expiration_date)) {
+        error = "Invalid date";
+        return false;
+    }
+    return true;
+}
+
+bool parse_dataset_row(const CsvRow& row, Dataset& ds, std::string& error) {
+    ds.name = row.get("name");
+    if (!validate_dataset_name(ds.name)) {
+        error = "Invalid dataset name: " + ds.name;
+        return false;
+    }
+    ds.volser = row.get("volser");
+    if (!validate_volser(ds.volser)) {
+        error = "Invalid volume serial: " + ds.volser;
+        return false;
+    }
+    
+    std::string status(row.get("status"));
+    if (!status.empty()) {
+        ds.status = string_to_dataset_status(status);
+        if (dataset_status_to_string(ds.status) != status) {
+            error = "Invalid status: " + status;
+            return false;
+        }
+    }
+    
+    ds.owner = row.get("owner");
+    if (!ds.owner.empty() && !validate_owner(ds.owner)) {
+        error = "Invalid owner: " + ds.owner;
+        return false;
+    }
+    ds.job_name = row.get("jobname");
+    
+    if (!parse_csv_number(row.get("size"), ds.size_bytes)) {
+        error = "Invalid size: " + std::string(row.get("size"));
+        return false;
+    }
+    if (!parse_csv_number(row.get("fileseq"), ds.file_sequence) || ds.file_sequence < 1) {
+        error = "Invalid file sequence: " + std::string(row.get("fileseq"));
+        return false;
+    }
+    if (!parse_csv_time(row.get("created"), ds.creation_date) ||
+        !parse_csv_time(row.get("expires"), ds.expiration_date)) {
+        error = "Invalid date";
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+Result<BatchResult> TMSSystem::import_volumes_from_csv(const std::string& file_path) {
+    auto report = bulk_import_volumes_csv(file_path);
+    if (!report.is_success()) {
+        return Result<BatchResult>::err(report.error().code, report.error().message);
+    }
+    return Result<BatchResult>::ok(csv_report_to_batch(report.value()));
+}
+
+Result<BatchResult> TMSSystem::import_datasets_from_csv(const std::string& file_path) {
+    auto report = bulk_import_datasets_csv(file_path);
+    if (!report.is_success()) {
+        return Result<BatchResult>::err(report.error().code, report.error().message);
+    }
+    return Result<BatchResult>::ok(csv_report_to_batch(report.value()));
+}
+
+Result<CsvImportReport> TMSSystem::bulk_import_volumes_csv(const std::string& file_path,
+                                                           const CsvImportOptions& options) {
+    CsvImportPipeline<TapeVolume> pipeline(
+        parse_volume_row,
+        [this](std::vector<TapeVolume>& batch, const CsvImportPipeline<TapeVolume>::RejectFn& reject) {
+            bulk_add_volumes(batch, reject);
+        },
+        [](const TapeVolume& vol) { return vol.volser; },
+        options);
+    
+    auto result = pipeline.run_file(file_path);
+    if (result.is_success()) {
+        const auto& report = result.value();
+        add_audit_record("IMPORT_VOLUMES_CSV", file_path,
+                         "Rows: " + std::to_string(report.rows) +
+                         ", Imported: " + std::to_string(report.imported) +
+                         ", Failed: " + std::to_string(report.failed));
+        PerformanceMetrics::instance().record_operation("import_volumes_csv", report.duration.count());
+    }
+    return result;
+}
+
+Result<CsvImportReport> TMSSystem::bulk_import_datasets_csv(const std::string& file_path,
+                                                            const CsvImportOptions& options) {
+    CsvImportPipeline<Dataset> pipeline(
+        parse_dataset_row,
+        [this](std::vector<Dataset>& batch, const CsvImportPipeline<Dataset>::RejectFn& reject) {
+            bulk_add_datasets(batch, reject);
+        },
+        [](const Dataset& ds) { return ds.name; },
+        options);
+    
+    auto result = pipeline.run_file(file_path);
+    if (result.is_success()) {
+        const auto& report = result.value();
+        add_audit_record("IMPORT_DATASETS_CSV", file_path,
+                         "Rows: " + std::to_string(report.rows) +
+                         ", Imported: " + std::to_string(report.imported) +
+                         ", Failed: " + std::to_string(report.failed));
+        PerformanceMetrics::instance().record_operation("import_datasets_csv", report.duration.count());
+    }
+    return result;
+}
+
+BatchResult TMSSystem::bulk_add_volumes(std::vector<TapeVolume>& volumes, const BulkRejectFn& on_reject) {
+    auto start = std::chrono::steady_clock::now();
+    BatchResult result;
+    result.total = volumes.size();
+    
+    auto reject = [&](size_t index, const std::string& message) {
+        result.failed++;
+        result.failures.emplace_back(volumes[index].volser, message);
+        if (on_reject) on_reject(index, message);
+    };
+    
+    const size_t max_volumes = Configuration::instance().get_max_volumes();
+    const auto now = current_time();
+    
+    {
+        auto lock = lock_for_write();
+        
+        for (size_t i = 0; i < volumes.size(); i++) {
+            TapeVolume& vol = volumes[i];
+            if (!validate_volser(vol.volser)) {
+                reject(i, "Invalid volume serial: " + vol.volser);
+                continue;
+            }
+            if (volumes_.size() >= max_volumes) {
+                reject(i, "Maximum volume limit reached");
+                continue;
+            }
+            if (volumes_.count(vol.volser) > 0) {
+                reject(i, "Volume already exists: " + vol.volser);
+                continue;
+            }
+            
+            if (vol.creation_date == std::chrono::system_clock::time_point{}) {
+                vol.creation_date = now;
+            }
+            if (vol.expiration_date == std::chrono::system_clock::time_point{}) {
+                vol.expiration_date = vol.creation_date + std::chrono::hours(24 * 365);
+            }
+            if (vol.capacity_bytes == 0) {
+                vol.capacity_bytes = get_density_capacity(vol.density);
+            }
+            vol.health_score = calculate_health_score(vol, now);
+            vol.last_health_check = now;
+            
+            volume_owner_index_.add(vol.owner, vol.volser);
+            volume_pool_index_.add(vol.pool, vol.volser);
+            for (const auto& tag : vol.tags) {
+                volume_tag_index_.add(tag, vol.volser);
+            }
+            std::string key = vol.volser;
+            retire_volume(key, nullptr);
+            volumes_.emplace(std::move(key), std::move(vol));
+            result.succeeded++;
+        }
+    }
+    
+    if (result.succeeded > 0) {
+        add_audit_record("BULK_ADD_VOLUMES", std::to_string(result.succeeded) + " volumes",
+                         "Rejected: " + std::to_string(result.failed));
+        PerformanceMetrics::instance().increment_counter("volumes_added", result.succeeded);
+    }
+    
+    result.duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+    return result;
+}
+
+BatchResult TMSSystem::bulk_add_datasets(std::vector<Dataset>& datasets, const BulkRejectFn& on_reject) {
+    auto start = std::chrono::steady_clock::now();
+    BatchResult result;
+    result.total = datasets.size();
+    
+    auto reject = [&](size_t index, const std::string& message) {
+        result.failed++;
+        result.failures.emplace_back(datasets[index].name, message);
+        if (on_reject) on_reject(index, message);
+    };
+    
+    const size_t max_datasets = Configuration::instance().get_max_datasets();
+    const auto now = current_time();
+    
+    {
+        auto lock = lock_for_write();
+        
+        for (size_t i = 0; i < datasets.size(); i++) {
+            Dataset& ds = datasets[i];
+            if (!validate_dataset_name(ds.name)) {
+                reject(i, "Invalid dataset name: " + ds.name);
+                continue;
+            }
+            if (datasets_.size() >= max_datasets) {
+                reject(i, "Maximum dataset limit reached");
+                continue;
+            }
+            if (datasets_.count(ds.name) > 0) {
+                reject(i, "Dataset already exists: " + ds.name);
+                continue;
+            }
+            auto vol_it = volumes_.find(ds.volser);
+            if (vol_it == volumes_.end()) {
+                reject(i, "Volume not found: " + ds.volser);
+                continue;
+            }
+            
+            if (ds.creation_date == std::chrono::system_clock::time_point{}) {
+                ds.creation_date = now;
+            }
+            if (ds.expiration_date == std::chrono::system_clock::time_point{}) {
+                ds.expiration_date = ds.creation_date + std::chrono::hours(24 * 30);
+            }
+            
+            dataset_owner_index_.add(ds.owner, ds.name);
+            for (const auto& tag : ds.tags) {
+                dataset_tag_index_.add(tag, ds.name);
+            }
+            
+            TapeVolume& vol = vol_it->second;
+            retire_volume(vol_it->first, &vol);
+            vol.datasets.push_back(ds.name);
+            vol.used_bytes += ds.size_bytes;
+            if (vol.status == VolumeStatus::SCRATCH) {
+                vol.status = VolumeStatus::PRIVATE;
+            }
+            
+            std::string key = ds.name;
+            retire_dataset(key, nullptr);
+            datasets_.emplace(std::move(key), std::move(ds));
+            result.succeeded++;
+        }
+    }
+    
+    if (result.succeeded > 0) {
+        add_audit_record("BULK_ADD_DATASETS", std::to_string(result.succeeded) + " datasets",
+                         "Rejected: " + std::to_string(result.failed));
+        PerformanceMetrics::instance().increment_counter("datasets_added", result.succeeded);
+    }
+    
+    result.duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+    return result;
+}
+
+// v3.4.0: Streams straight from the catalog maps through a buffered writer
+OperationResult TMSSystem::export_to_json(const std::string& file_path) const {
+    std::ofstream out(file_path, std::ios::binary);
+    if (!out.is_open()) {
+        return OperationResult::err(TMSError::FILE_OPEN_ERROR, "Cannot create: " + file_path);
+    }
+    
+    std::shared_lock<std::shared_mutex> lock(catalog_mutex_);
+    JsonWriter writer(out);
+    TmsJsonConverter::write_catalog(writer, std::views::values(volumes_),
+                                    std::views::values(datasets_));
+    writer.flush();
+    
+    if (!writer.good()) {
+        return OperationResult::err(TMSError::FILE_WRITE_ERROR, "Write failed: " + file_path);
+    }
+    return OperationResult::ok();
+}
+
+// v3.4.0: Pull-parses one record at a time; never holds the whole document
+Result<BatchResult> TMSSystem::import_from_json(const std::string& file_path) {
+    std::ifstream in(file_path, std::ios::binary);
+    if (!in.is_open()) {
+        return Result<BatchResult>::err(TMSError::FILE_NOT_FOUND, "Cannot open: " + file_path);
+    }
+    
+    auto start = std::chrono::steady_clock::now();
+    BatchResult result;
+    
+    try {
+        JsonReader reader(in);
+        TmsJsonConverter::read_catalog(reader,
+            [&](TapeVolume&& vol) {
+                result.total++;
+                // add_dataset() relinks datasets and their space on the volume
+                if (!vol.datasets.empty()) {
+                    vol.datasets.clear();
+                    vol.used_bytes = 0;
+                }
+                std::string volser = vol.volser;
+                auto op = add_volume(std::move(vol));
+                if (op.is_success()) {
+                    result.succeeded++;
+                } else {
+                    result.failed++;
+                    result.failures.emplace_back(volser, op.error().message);
+                }
+            },
+            [&](Dataset&& ds) {
+                result.total++;
+                std::string name = ds.name;
+                auto op = add_dataset(std::move(ds));
+                if (op.is_success()) {
+                    result.succeeded++;
+                } else {
+                    result.failed++;
+                    result.failures.emplace_back(name, op.error().message);
+                }
+            });
+    } catch (const std::exception& e) {
+        return Result<BatchResult>::err(TMSError::FILE_READ_ERROR,
+            std::string("JSON import failed: ") + e.what());
+    }
+    
+    result.duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+    return Result<BatchResult>::ok(result);
+}
+
+// ============================================================================
+// Reports
+// ============================================================================
+
+void TMSSystem::generate_volume_report(std::ostream& os, std::optional<VolumeStatus> status) const {
+    std::shared_lock<std::shared_mutex> lock(catalog_mutex_);
+    
+    os << "\n=== VOLUME REPORT ===\n";
+    os << "Generated: " << get_timestamp() << "\n\n";
+    os << std::left << std::setw(8) << "Volser" 
+       << std::setw(10) << "Status"
+       << std::setw(10) << "Density"
+       << std::setw(15) << "Pool"
+       << std::setw(10) << "Owner"
+       << std::setw(12) << "Used"
+       << "\n";
+    os << std::string(65, '-') << "\n";
+    
+    for (const auto& [volser, vol] : volumes_) {
+        if (status.has_value() && vol.status != status.value()) continue;
+        
+        os << std::left << std::setw(8) << vol.volser
+           << std::setw(10) << volume_status_to_string(vol.status)
+           << std::setw(10) << density_to_string(vol.density)
+           << std::setw(15) << vol.pool
+           << std::setw(10) << vol.owner
+           << std::setw(12) << format_bytes(vol.used_bytes)
+           << "\n";
+    }
+    
+    os << "\nTotal: " << volumes_.size() << " volumes\n";
+}
+
+void TMSSystem::generate_dataset_report(std::ostream& os, const std::string& volser) const {
+    std::shared_lock<std::shared_mutex> lock(catalog_mutex_);
+    
+    os << "\n=== DATASET REPORT ===\n";
+    os << "Generated: " << get_timestamp() << "\n\n";
+    os << std::left << std::setw(30) << "Name"
+       << std::setw(8) << "Volser"
+       << std::setw(10) << "Status"
+       << std::setw(12) << "Size"
+       << std::setw(10) << "Owner"
+       << "\n";
+    os << std::string(70, '-') << "\n";
+    
+    for (const auto& [name, ds] : datasets_) {
+        if (!volser.empty() && ds.volser != volser) continue;
+        
+        os << std::left << std::setw(30) << ds.name
+           << std::setw(8) << ds.volser
+           << std::setw(10) << dataset_status_to_string(ds.status)
+           << std::setw(12) << format_bytes(ds.size_bytes)
+           << std::setw(10) << ds.owner
+           << "\n";
+    }
+    
+    os << "\nTotal: " << datasets_.size() << " datasets\n";
+}
+
+void TMSSystem::generate_pool_report(std::ostream& os) const {
+    os << cached_report_text("pool-report", std::chrono::seconds(report_cache_max_age_.load()), [this] {
+        std::ostringstream oss;
+        oss << "\n=== POOL REPORT ===\n";
+        oss << "Generated: " << get_timestamp() << "\n\n";
+        
+        for (const auto& stats : get_all_pool_statistics()) {
+            oss << "Pool: " << stats.pool_name << "\n";
+            oss << "  Total: " << stats.total_volumes << ", "
+                << "Scratch: " << stats.scratch_volumes << ", "
+                << "Private: " << stats.private_volumes << "\n";
+            oss << "  Capacity: " << format_bytes(stats.total_capacity)
+                << ", Used: " << format_bytes(stats.used_capacity)
+                << " (" << std::fixed << std::setprecision(1) << stats.get_utilization() << "%)\n\n";
+        }
+        return oss.str();
+    });
+}
+
+void TMSSystem::generate_statistics(std::ostream& os) const {
+    auto stats = get_statistics();
+    
+    os << "\n=== SYSTEM STATISTICS ===\n";
+    os << "Generated: " << get_timestamp() << "\n";
+    os << "Uptime: " << stats.get_uptime() << "\n\n";
+    
+    os << "Volumes:\n";
+    os << "  Total: " << stats.total_volumes << "\n";
+    os << "  Scratch: " << stats.scratch_volumes << "\n";
+    os << "  Private: " << stats.private_volumes << "\n";
+    os << "  Mounted: " << stats.mounted_volumes << "\n";
+    os << "  Expired: " << stats.expired_volumes << "\n";
+    os << "  Reserved: " << stats.reserved_volumes << "\n\n";
+    
+    os << "Datasets:\n";
+    os << "  Total: " << stats.total_datasets << "\n";
+    os << "  Active: " << stats.active_datasets << "\n";
+    os << "  Migrated: " << stats.migrated_datasets << "\n";
+    os << "  Expired: " << stats.expired_datasets << "\n\n";
+    
+    os << "Capacity:\n";
+    os << "  Total: " << format_bytes(stats.total_capacity) << "\n";
+    os << "  Used: " << format_bytes(stats.used_capacity) << "\n";
+    os << "  Utilization: " << std::fixed << std::setprecision(1) 
+       << stats.get_utilization() << "%\n\n";
+    
+    os << "Cache:\n";
+    os << "  Regex patterns: " << RegexCache::instance().size() << "\n";
+    os << "  Audit pruned: " << audit_log_.pruned_count() << "\n";
+}
+
+void TMSSystem::generate_expiration_report(std::ostream& os) const {
+    os << cached_report_text("expiration-report", std::chrono::seconds(report_cache_max_age_.load()), [this] {
+        std::ostringstream oss;
+        oss << "\n=== EXPIRATION REPORT ===\n";
+        oss << "Generated: " << get_timestamp() << "\n\n";
+        
+        auto expired_vols = list_expired_volumes();
+        auto expired_ds = list_expired_datasets();
+        auto expiring = list_expiring_soon();
+        
+        oss << "Expired Volumes: " << expired_vols.size() << "\n";
+        for (const auto& v : expired_vols) {
+            oss << "  " << v << "\n";
+        }
+        
+        oss << "\nExpired Datasets: " << expired_ds.size() << "\n";
+        for (const auto& d : expired_ds) {
+            oss << "  " << d << "\n";
+        }
+        
+        oss << "\nExpiring Soon (7 days): " << expiring.size() << "\n";
+        for (const auto& e : expiring) {
+            oss << "  " << e << "\n";
+        }
+        return oss.str();
+    });
+}
+
+// v3.4.0: Streaming reports. Rows are copied out in cursor batches so the
+// catalog lock is never held while output is written to the sink.
+void TMSSystem::fetch_volumes(const std::string* after, size_t limit, std::vector<TapeVolume>& out) const {
+    std::shared_lock<std::shared_mutex> lock(catalog_mutex_);
+    auto it = after ? volumes_.upper_bound(*after) : volumes_.begin();
+    out.reserve(limit);
+    for (; it != volumes_.end() && out.size() < limit; ++it) {
+        out.push_back(it->second);
+    }
+}
+
+void TMSSystem::fetch_datasets(const std::string* after, size_t limit, std::vector<Dataset>& out) const {
+    std::shared_lock<std::shared_mutex> lock(catalog_mutex_);
+    auto it = after ? datasets_.upper_bound(*after) : datasets_.begin();
+    out.reserve(limit);
+    for (; it != datasets_.end() && out.size() < limit; ++it) {
+        out.push_back(it->second);
+    }
+}
+
+CatalogCursor<TapeVolume> TMSSystem::volume_cursor(size_t batch_size) const {
+    return CatalogCursor<TapeVolume>(
+        [this](const std::string* after, size_t limit, std::vector<TapeVolume>& out) {
+            fetch_volumes(after, limit, out);
+        },
+        [](const TapeVolume& v) -> const std::string& { return v.volser; },
+        batch_size);
+}
+
+CatalogCursor<Dataset> TMSSystem::dataset_cursor(size_t batch_size) const {
+    return CatalogCursor<Dataset>(
+        [this](const std::string* after, size_t limit, std::vector<Dataset>& out) {
+            fetch_datasets(after, limit, out);
+        },
+        [](const Dataset& ds) -> const std::string& { return ds.name; },
+        batch_size);
+}
+
+size_t TMSSystem::write_volume_report(ReportSink& sink, ReportFormat format,
+                                      const ReportOptions& options) const {
+    SingleSinkPager pager(sink);
+    return write_volume_report(pager, format, options);
+}
+
+size_t TMSSystem::write_volume_report(ReportPager& pager, ReportFormat format,
+                                      const ReportOptions& options) const {
+    auto start = std::chrono::steady_clock::now();
+    auto cursor = volume_cursor();
+    size_t rows = ReportGenerator().write_volume_report(pager, [&cursor] { return cursor.next(); },
+                                                        format, options);
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+    PerformanceMetrics::instance().record_operation("write_volume_report", elapsed.count());
+    return rows;
+}
+
+size_t TMSSystem::write_dataset_report(ReportSink& sink, ReportFormat format,
+                                       const ReportOptions& options) const {
+    auto start = std::chrono::steady_clock::now();
+    auto cursor = dataset_cursor();
+    size_t rows = ReportGenerator().write_dataset_report(sink, [&cursor] { return cursor.next(); },
+                                                         format, options);
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+    PerformanceMetrics::instance().record_operation("write_dataset_report", elapsed.count());
+    return rows;
+}
+
+// v3.4.0: Materialized reports
+TMSSystem::CatalogWriteLock TMSSystem::lock_for_write() {
+    std::unique_lock<std::shared_mutex> lock(catalog_mutex_, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        auto wait_start = std::chrono::steady_clock::now();
+        lock.lock();
+        lock_contended_.fetch_add(1, std::memory_order_relaxed);
+        lock_wait_ns_.fetch_add(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - wait_start).count()), std::memory_order_relaxed);
+    }
+    lock_acquisitions_.fetch_add(1, std::memory_order_relaxed);
+    catalog_generation_.fetch_add(1, std::memory_order_acq_rel);
+    // One timestamp per write keeps version chains ordered even if the clock steps back
+    write_time_ = std::max(current_time(),
+                           write_time_ + std::chrono::system_clock::duration(1));
+    return CatalogWriteLock(*this, std::move(lock));
+}
+
+// The generation is read before building, so a write that lands mid-build
+// only makes the stored entry miss; it can never tag stale content as current.
+std::string TMSSystem::cached_report_text(const std::string& key, std::chrono::seconds max_age,
+                                          const std::function<std::string()>& build) const {
+    uint64_t generation = catalog_generation_.load(std::memory_order_acquire);
+    return *report_cache_.get_or_build(key, generation, max_age, build);
+}
+
+std::vector<PoolStatistics> TMSSystem::get_all_pool_statistics() const {
+    std::shared_lock<std::shared_mutex> lock(catalog_mutex_);
+    
+    // Keyed by symbol so each row costs a pointer-hash lookup; the map
+    // below restores name order
+    std::unordered_map<Symbol, PoolStatistics> by_pool;
+    const auto now = current_time();
+    for (const auto& vol : hot_volumes().rows()) {
+        if (vol.pool.empty()) continue;
+        auto& stats = by_pool[vol.pool];
+        stats.total_volumes++;
+        stats.total_capacity += vol.capacity_bytes;
+        stats.used_capacity += vol.used_bytes;
+        
+        switch (vol.get_status()) {
+            case VolumeStatus::SCRATCH: stats.scratch_volumes++; break;
+            case VolumeStatus::PRIVATE: stats.private_volumes++; break;
+            case VolumeStatus::MOUNTED: stats.mounted_volumes++; break;
+            default: break;
+        }
+        
+        if (vol.is_reserved(now)) stats.reserved_volumes++;
+    }
+    lock.unlock();
+    
+    std::map<std::string, PoolStatistics> pools;
+    for (auto& [pool, stats] : by_pool) pools.emplace(pool.str(), std::move(stats));
+    
+    std::vector<PoolStatistics> result;
+    result.reserve(pools.size());
+    for (auto& [name, stats] : pools) {
+        stats.pool_name = name;
+        result.push_back(std::move(stats));
+    }
+    return result;
+}
+
+Result<std::string> TMSSystem::get_cached_report(ReportType type, ReportFormat format,
+                                                 const ReportOptions& options) const {
+    // Every report prints its generation time, so none is served past the max age
+    const std::chrono::seconds max_age(report_cache_max_age_.load());
+    std::string key = ReportCache::make_key(type, format, options);
+    
+    switch (type) {
+        case ReportType::VOLUME_SUMMARY:
+            return Result<std::string>::ok(cached_report_text(key, max_age, [&] {
+                StringReportSink sink;
+                write_volume_report(sink, format, options);
+                return sink.take();
+            }));
+        
+        case ReportType::DATASET_SUMMARY:
+            return Result<std::string>::ok(cached_report_text(key, max_age, [&] {
+                StringReportSink sink;
+                write_dataset_report(sink, format, options);
+                return sink.take();
+            }));
+        
+        case ReportType::POOL_SUMMARY:
+            return Result<std::string>::ok(cached_report_text(key, max_age, [&] {
+                return ReportGenerator().generate_pool_report(get_all_pool_statistics(), format, options);
+            }));
+        
+        case ReportType::CAPACITY_REPORT:
+            return Result<std::string>::ok(cached_report_text(key, max_age, [&] {
+                return ReportGenerator().generate_capacity_report(list_volumes(), format);
+            }));
+        
+        case ReportType::EXPIRATION_REPORT:
+            return Result<std::string>::ok(cached_report_text(key, max_age, [&] {
+                // Copy only candidates; the generator applies the exact window
+                auto threshold = current_time() + std::chrono::hours(168);
+                std::vector<TapeVolume> vols;
+                std::vector<Dataset> dss;
+                std::shared_lock<std::shared_mutex> lock(catalog_mutex_);
+                for (const auto& [volser, vol] : volumes_) {
+                    if (vol.status == VolumeStatus::EXPIRED || vol.expiration_date <= threshold) {
+                        vols.push_back(vol);
+                    }
+                }
+                for (const auto& [name, ds] : datasets_) {
+                    if (ds.status == DatasetStatus::EXPIRED || ds.expiration_date <= threshold) {
+                        dss.push_back(ds);
+                    }
+                }
+                lock.unlock();
+                return ReportGenerator().generate_expiration_report(vols, dss, format);
+            }));
+        
+        case ReportType::HEALTH_REPORT:
+            return Result<std::string>::ok(cached_report_text(key, max_age, [&] {
+                return ReportGenerator().generate_health_report(perform_health_check(), format);
+            }));
+        
+        case ReportType::SYSTEM_STATISTICS:
+            return Result<std::string>::ok(cached_report_text(key, max_age, [&] {
+                return ReportGenerator().generate_statistics_report(get_statistics(), format, options);
+            }));
+        
+        default:
+            return Result<std::string>::err(TMSError::OPERATION_NOT_SUPPORTED,
+                                            "Report type is not cached");
+    }
+}
+
+// ============================================================================
+// v3.4.0: Catalog Version History
+// ============================================================================
+
+void TMSSystem::set_history_retention(std::chrono::seconds horizon) {
+    {
+        std::unique_lock<std::shared_mutex> lock(catalog_mutex_);
+        bool was_enabled = history_retention_.load() > 0;
+        if (horizon.count() <= 0 || !was_enabled) {
+            auto now = current_time();
+            volume_history_.reset(now);
+            dataset_history_.reset(now);
+        }
+        history_retention_.store(std::max<int64_t>(0, horizon.count()));
+    }
+    
+    if (horizon.count() <= 0) {
+        stop_history_compactor();
+        return;
+    }
+    
+    std::lock_guard<std::mutex> guard(compactor_mutex_);
+    if (history_compactor_.joinable()) {
+        compactor_cv_.notify_all();  // Pick up the new interval
+        return;
+    }
+    compactor_stop_ = false;
+    history_compactor_ = std::thread([this] {
+        std::unique_lock<std::mutex> wait_lock(compactor_mutex_);
+        while (!compactor_stop_) {
+            auto interval = std::clamp(std::chrono::seconds(history_retention_.load() / 8),
+                                       std::chrono::seconds(1), std::chrono::seconds(60));
+            compactor_cv_.wait_for(wait_lock, interval);
+            if (compactor_stop_) break;
+            wait_lock.unlock();
+            compact_history();
+            wait_lock.lock();
+        }
+    });
+}
+
+void TMSSystem::stop_history_compactor() {
+    std::thread compactor;
+    {
+        std::lock_guard<std::mutex> guard(compactor_mutex_);
+        compactor_stop_ = true;
+        compactor = std::move(history_compactor_);
+    }
+    compactor_cv_.notify_all();
+    if (compactor.joinable()) compactor.join();
+}
+
+size_t TMSSystem::compact_history() {
+    int64_t retention = history_retention_.load();
+    if (retention <= 0) return 0;
+    auto horizon = current_time() - std::chrono::seconds(retention);
+    
+    // History only; the live catalog is unchanged, so no generation bump
+    std::unique_lock<std::shared_mutex> lock(catalog_mutex_);
+    return volume_history_.compact(horizon) + dataset_history_.compact(horizon);
+}
+
+VersionHistoryStats TMSSystem::get_history_stats() const {
+    std::shared_lock<std::shared_mutex> lock(catalog_mutex_);
+    VersionHistoryStats stats = volume_history_.stats();
+    VersionHistoryStats ds = dataset_history_.stats();
+    stats.keys += ds.keys;
+    stats.versions += ds.versions;
+    stats.compacted += ds.compacted;
+    stats.oldest = std::max(stats.oldest, ds.oldest);
+    return stats;
+}
+
+OperationResult TMSSystem::check_as_of(TimePoint as_of) const {
+    if (history_retention_.load() <= 0) {
+        return OperationResult::err(TMSError::OPERATION_NOT_SUPPORTED, "Version history is disabled");
+    }
+    if (as_of < volume_history_.oldest() || as_of < dataset_history_.oldest()) {
+        return OperationResult::err(TMSError::INVALID_PARAMETER,
+                                    "Time is outside the history retention window: " + format_time(as_of));
+    }
+    return OperationResult::ok();
+}
+
+// Merge-walks the live map and the history keys (both key-ordered) so
+// records deleted since as_of are included and output stays sorted
+template<typename Fn>
+void TMSSystem::for_each_volume_as_of(TimePoint as_of, Fn&& fn) const {
+    auto live = volumes_.begin();
+    volume_history_.for_each_key([&](const std::string& key) {
+        while (live != volumes_.end() && live->first < key) fn((live++)->second);
+        const TapeVolume* current = nullptr;
+        if (live != volumes_.end() && live->first == key) current = &(live++)->second;
+        auto past = volume_history_.find(key, as_of);
+        const TapeVolume* vol = past ? past->get() : current;
+        if (vol) fn(*vol);
+    });
+    while (live != volumes_.end()) fn((live++)->second);
+}
+
+template<typename Fn>
+void TMSSystem::for_each_dataset_as_of(TimePoint as_of, Fn&& fn) const {
+    auto live = datasets_.begin();
+    dataset_history_.for_each_key([&](const std::string& key) {
+        while (live != datasets_.end() && live->first < key) fn((live++)->second);
+        const Dataset* current = nullptr;
+        if (live != datasets_.end() && live->first == key) current = &(live++)->second;
+        auto past = dataset_history_.find(key, as_of);
+        const Dataset* ds = past ? past->get() : current;
+        if (ds) fn(*ds);
+    });
+    while (live != datasets_.end()) fn((live++)->second);
+}
+
+Result<TapeVolume> TMSSystem::get_volume(const std::string& volser, TimePoint as_of) const {
+    std::shared_lock<std::shared_mutex> lock(catalog_mutex_);
+    auto check = check_as_of(as_of);
+    if (!check.is_success()) {
+        return Result<TapeVolume>::err(check.error().code, check.error().message);
+    }
+    
+    if (auto past = volume_history_.find(volser, as_of)) {
+        if (*past) return Result<TapeVolume>::ok(**past);
+    } else {
+        auto it = volumes_.find(volser);
+        if (it != volumes_.end()) return Result<TapeVolume>::ok(it->second);
+    }
+    return Result<TapeVolume>::err(TMSError::VOLUME_NOT_FOUND,
+                                   "Volume not found at " + format_time(as_of) + ": " + volser);
+}
+
+Result<Dataset> TMSSystem::get_dataset(const std::string& name, TimePoint as_of) const {
+    std::shared_lock<std::shared_mutex> lock(catalog_mutex_);
+    auto check = check_as_of(as_of);
+    if (!check.is_success()) {
+        return Result<Dataset>::err(check.error().code, check.error().message);
+    }
+    
+    if (auto past = dataset_history_.find(name, as_of)) {
+        if (*past) return Result<Dataset>::ok(**past);
+    } else {
+        auto it = datasets_.find(name);
+        if (it != datasets_.end()) return Result<Dataset>::ok(it->second);
+    }
+    return Result<Dataset>::err(TMSError::DATASET_NOT_FOUND,
+                                "Dataset not found at " + format_time(as_of) + ": " + name);
+}
+
+Result<std::vector<TapeVolume>> TMSSystem::list_volumes(TimePoint as_of,
+                                                        std::optional<VolumeStatus> status) const {
+    std::shared_lock<std::shared_mutex> lock(catalog_mutex_);
+    auto check = check_as_of(as_of);
+    if (!check.is_success()) {
+        return Result<std::vector<TapeVolume>>::err(check.error().code, check.error().message);
+    }
+    
+    std::vector<TapeVolume> result;
+    for_each_volume_as_of(as_of, [&](const TapeVolume& vol) {
+        if (!status.has_value() || vol.status == status.value()) result.push_back(vol);
+    });
+    return Result<std::vector<TapeVolume>>::ok(std::move(result));
+}
+
+Result<std::vector<Dataset>> TMSSystem::list_datasets(TimePoint as_of,
+                                                      std::optional<DatasetStatus> status) const {
+    std::shared_lock<std::shared_mutex> lock(catalog_mutex_);
+    auto check = check_as_of(as_of);
+    if (!check.is_success()) {
+        return Result<std::vector<Dataset>>::err(check.error().code, check.error().message);
+    }
+    
+    std::vector<Dataset> result;
+    for_each_dataset_as_of(as_of, [&](const Dataset& ds) {
+        if (!status.has_value() || ds.status == status.value()) result.push_back(ds);
+    });
+    return Result<std::vector<Dataset>>::ok(std::move(result));
+}
+
+Result<std::vector<TapeVolume>> TMSSystem::search_volumes(const SearchCriteria& criteria,
+                                                          TimePoint as_of) const {
+    std::shared_lock<std::shared_mutex> lock(catalog_mutex_);
+    auto check = check_as_of(as_of);
+    if (!check.is_success()) {
+        return Result<std::vector<TapeVolume>>::err(check.error().code, check.error().message);
+    }
+    
+    std::vector<TapeVolume> result;
+    const CriteriaSymbols symbols(criteria);
+    if (symbols.unmatchable) return Result<std::vector<TapeVolume>>::ok(std::move(result));
+    for_each_volume_as_of(as_of, [&](const TapeVolume& vol) {
+        if (criteria.limit > 0 && result.size() >= criteria.limit) return;
+        if (volume_matches(vol, criteria, symbols)) result.push_back(vol);
+    });
+    return Result<std::vector<TapeVolume>>::ok(std::move(result));
+}
+
+// ============================================================================
+// v3.4.0: Workload Capture and Replay
+// ============================================================================
+
+OperationResult TMSSystem::start_workload_capture(const std::string& path) {
+    stop_workload_capture();
+    
+    // Baseline: the catalog as the first captured event will find it
+    auto saved = save_catalog();
+    if (!saved.is_success()) return saved;
+    std::string base = path + ".base";
+    try {
+        fs::create_directories(base);
+        fs::copy_file(volume_catalog_path_, base + PATH_SEP_STR + "volumes.dat",
+                      fs::copy_options::overwrite_existing);
+        fs::copy_file(dataset_catalog_path_, base + PATH_SEP_STR + "datasets.dat",
+                      fs::copy_options::overwrite_existing);
+    } catch (const std::exception& e) {
+        return OperationResult::err(TMSError::FILE_WRITE_ERROR, "Cannot write capture baseline: " + std::string(e.what()));
+    }
+    
+    auto writer = std::make_shared<WorkloadWriter>();
+    if (!writer->open(path)) {
+        return OperationResult::err(TMSError::FILE_OPEN_ERROR, "Cannot open workload capture: " + path);
+    }
+    capture_writer_.store(std::move(writer));
+    capturing_.store(true);
+    TMS_LOG_INFO("TMSSystem", "Workload capture started: " + path);
+    return OperationResult::ok();
+}
+
+void TMSSystem::stop_workload_capture() {
+    capturing_.store(false);
+    auto writer = capture_writer_.exchange(nullptr);
+    if (writer) {
+        writer->close();
+        TMS_LOG_INFO("TMSSystem", "Workload capture stopped: " + std::to_string(writer->events()) + " events");
+    }
+}
+
+void TMSSystem::capture_event(WorkloadEvent event) const {
+    auto writer = capture_writer_.load();
+    if (writer) writer->write(event);
+}
+
+namespace {
+
+// Text of an audit detail field: what follows @p label, up to @p stop
+std::string audit_field(const std::string& details, const std::string& label, const std::string& stop = "") {
+    size_t pos = details.find(label);
+    if (pos == std::string::npos) return "";
+    pos += label.size();
+    size_t end = stop.empty() ? std::string::npos : details.find(stop, pos);
+    return details.substr(pos, end == std::string::npos ? std::string::npos : end - pos);
+}
+
+// After images of the records the calling thread's writes committed,
+// stashed by commit_changes() under the write lock and taken by the audit
+// record that follows the write
+struct CapturedImages {
+    const TMSSystem* owner = nullptr;
+    std::vector<TapeVolume> volumes;
+    std::vector<Dataset> datasets;
+};
+thread_local CapturedImages tls_captured;
+
+} // namespace
+
+// Called after the mutation has released the catalog lock; recovers the
+// arguments from the audit details and takes the committed records from
+// tls_captured, so a later writer cannot change what is recorded
+void TMSSystem::capture_mutation(const std::string& operation, const std::string& target,
+                                 const std::string& details, bool success) {
+    CapturedImages images;
+    if (tls_captured.owner == this) images = std::move(tls_captured);
+    tls_captured = CapturedImages{};
+    if (!success) return;
+    
+    WorkloadEvent event;
+    event.operation = operation;
+    event.target = target;
+    for (auto& vol : images.volumes) {
+        if (vol.volser == target) event.volume = std::move(vol);
+    }
+    for (auto& ds : images.datasets) {
+        if (ds.name == target) event.dataset = std::move(ds);
+    }
+    
+    if (operation == "BULK_ADD_VOLUMES") {
+        event.volumes = std::move(images.volumes);
+    } else if (operation == "BULK_ADD_DATASETS") {
+        event.datasets = std::move(images.datasets);
+    } else if (operation == "DELETE_VOLUME") {
+        event.args["force"] = audit_field(details, "Force: ");
+    } else if (operation == "ADD_TAG" || operation == "REMOVE_TAG" ||
+               operation == "ADD_DATASET_TAG" || operation == "REMOVE_DATASET_TAG") {
+        event.args["tag"] = audit_field(details, "Tag: ");
+    } else if (operation == "RESERVE_VOLUME") {
+        event.args["user"] = audit_field(details, "User: ", ",");
+        event.args["duration"] = audit_field(details, "Duration: ", "s");
+    } else if (operation == "RELEASE_VOLUME") {
+        event.args["user"] = audit_field(details, "User: ");
+    } else if (operation == "EXTEND_RESERVATION") {
+        event.args["additional"] = audit_field(details, "Additional: ", "s");
+        if (event.volume) event.args["user"] = event.volume->reserved_by;
+    } else if (operation == "ALLOCATE_SCRATCH") {
+        event.args["pool"] = audit_field(details, "Pool: ");
+    } else if (operation == "UPDATE_LOCATION") {
+        event.args["location"] = audit_field(details, " To: ");
+    } else if (operation == "MOVE_TO_POOL") {
+        event.args["pool"] = audit_field(details, " To: ");
+    } else if (operation == "CLONE_VOLUME") {
+        event.args["source"] = audit_field(details, "Cloned from ");
+    } else if (operation == "RENAME_POOL") {
+        event.args["pool"] = audit_field(details, "Renamed to ", ", ");
+    } else if (operation == "MERGE_POOLS") {
+        event.args["pool"] = audit_field(details, "Merged into ", ", ");
+    } else if (operation == "SET_TIER") {
+        event.args["tier"] = audit_field(details, " To: ");
+    } else if (operation == "SET_ENCRYPTION" && event.volume) {
+        // The JSON record image does not carry encryption metadata
+        const EncryptionMetadata& enc = event.volume->encryption;
+        event.args["encrypted"] = enc.encrypted ? "yes" : "no";
+        event.args["algorithm"] = encryption_algorithm_to_string(enc.algorithm);
+        event.args["key_id"] = enc.key_id;
+        event.args["key_label"] = enc.key_label;
+        event.args["encrypted_by"] = enc.encrypted_by;
+        event.args["encrypted_date"] = format_time(enc.encrypted_date);
+    }
+    
+    capture_event(std::move(event));
+}
+
+// nullopt: the operation has no replay mapping
+std::optional<OperationResult> TMSSystem::replay_event(const WorkloadEvent& event) {
+    const std::string& op = event.operation;
+    const std::string& target = event.target;
+    auto status_of = [](const auto& result) {
+        return result.is_success() ? OperationResult::ok()
+                                   : OperationResult::err(result.error().code, result.error().message);
+    };
+    
+    if (op == "GET_VOLUME") return status_of(get_volume(target));
+    if (op == "GET_DATASET") return status_of(get_dataset(target));
+    if (op == "SEARCH_VOLUMES") {
+        SearchCriteria criteria;
+        criteria.pattern = target;
+        criteria.mode = static_cast<SearchMode>(std::atoi(event.arg("mode", "3").c_str()));
+        if (event.args.count("status")) criteria.status = string_to_volume_status(event.arg("status"));
+        if (event.args.count("owner")) criteria.owner = event.arg("owner");
+        if (event.args.count("pool")) criteria.pool = event.arg("pool");
+        if (event.args.count("location")) criteria.location = event.arg("location");
+        if (event.args.count("tag")) criteria.tag = event.arg("tag");
+        criteria.limit = std::strtoull(event.arg("limit", "0").c_str(), nullptr, 10);
+        search_volumes(criteria);
+        return OperationResult::ok();
+    }
+    
+    if (op == "ADD_VOLUME" && event.volume) return add_volume(*event.volume);
+    if (op == "UPDATE_VOLUME" && event.volume) return update_volume(*event.volume);
+    if (op == "DELETE_VOLUME") return delete_volume(target, event.arg("force") == "yes");
+    if (op == "ADD_DATASET" && event.dataset) return add_dataset(*event.dataset);
+    if (op == "UPDATE_DATASET" && event.dataset) return update_dataset(*event.dataset);
+    if (op == "DELETE_DATASET") return delete_dataset(target);
+    if (op == "ADD_TAG") return add_volume_tag(target, event.arg("tag"));
+    if (op == "REMOVE_TAG") return remove_volume_tag(target, event.arg("tag"));
+    if (op == "RESERVE_VOLUME") {
+        auto seconds = std::strtoll(event.arg("duration", "3600").c_str(), nullptr, 10);
+        return reserve_volume(target, event.arg("user"), std::chrono::seconds(seconds));
+    }
+    if (op == "RELEASE_VOLUME") return release_volume(target, event.arg("user"));
+    if (op == "MOUNT_VOLUME") return mount_volume(target);
+    if (op == "DISMOUNT_VOLUME") return dismount_volume(target);
+    if (op == "SCRATCH_VOLUME") return scratch_volume(target);
+    if (op == "MIGRATE_DATASET") return migrate_dataset(target);
+    if (op == "RECALL_DATASET") return recall_dataset(target);
+    if (op == "SET_OFFLINE") return set_volume_offline(target);
+    if (op == "SET_ONLINE") return set_volume_online(target);
+    if (op == "ALLOCATE_SCRATCH") return status_of(allocate_scratch_volume(event.arg("pool")));
+    if (op == "UPDATE_LOCATION") return update_volume_location(target, event.arg("location"));
+    if (op == "MOVE_TO_POOL") return move_volume_to_pool(target, event.arg("pool"));
+    if (op == "EXTEND_RESERVATION") {
+        auto seconds = std::strtoll(event.arg("additional", "0").c_str(), nullptr, 10);
+        return extend_reservation(target, event.arg("user"), std::chrono::seconds(seconds));
+    }
+    if (op == "ADD_DATASET_TAG") return add_dataset_tag(target, event.arg("tag"));
+    if (op == "REMOVE_DATASET_TAG") return remove_dataset_tag(target, event.arg("tag"));
+    if (op == "CLONE_VOLUME") return status_of(clone_volume(event.arg("source"), target));
+    if (op == "RENAME_POOL") return rename_pool(target, event.arg("pool"));
+    if (op == "MERGE_POOLS") return merge_pools(target, event.arg("pool"));
+    if (op == "SET_TIER") return set_volume_tier(target, string_to_storage_tier(event.arg("tier")));
+    if (op == "SET_ENCRYPTION") {
+        EncryptionMetadata enc;
+        enc.encrypted = event.arg("encrypted") == "yes";
+        enc.algorithm = string_to_encryption_algorithm(event.arg("algorithm"));
+        enc.key_id = event.arg("key_id");
+        enc.key_label = event.arg("key_label");
+        enc.encrypted_by = event.arg("encrypted_by");
+        enc.encrypted_date = parse_time(event.arg("encrypted_date"));
+        return set_volume_encryption(target, enc);
+    }
+    if (op == "RESTORE_SNAPSHOT" && event.volume) {
+        // Snapshot ids differ between catalogs; apply the restored fields
+        auto current = get_volume(target);
+        if (!current.is_success()) return status_of(current);
+        TapeVolume restored = std::move(current.value());
+        restored.status = event.volume->status;
+        restored.tags = event.volume->tags;
+        restored.notes = event.volume->notes;
+        return update_volume(std::move(restored));
+    }
+    if (op == "BULK_ADD_VOLUMES" || op == "BULK_ADD_DATASETS") {
+        BatchResult batch;
+        if (op == "BULK_ADD_VOLUMES") {
+            std::vector<TapeVolume> volumes = event.volumes;
+            batch = bulk_add_volumes(volumes);
+        } else {
+            std::vector<Dataset> datasets = event.datasets;
+            batch = bulk_add_datasets(datasets);
+        }
+        if (batch.failed == 0) return OperationResult::ok();
+        return OperationResult::err(TMSError::BATCH_PARTIAL_FAILURE,
+                                    std::to_string(batch.failed) + " of " + std::to_string(batch.total) + " rejected");
+    }
+    // Summaries: the records they wrote were captured by their own
+    // BULK_ADD_* and ADD_TAG/REMOVE_TAG events
+    if (op == "IMPORT_VOLUMES_CSV" || op == "IMPORT_DATASETS_CSV" ||
+        op == "BULK_ADD_TAG" || op == "BULK_REMOVE_TAG") {
+        return OperationResult::ok();
+    }
+    if (op == "PROCESS_EXPIRATIONS") {
+        process_expirations();
+        return OperationResult::ok();
+    }
+    if (op == "CLEANUP_RESERVATIONS") {
+        cleanup_expired_reservations();
+        return OperationResult::ok();
+    }
+    return std::nullopt;
+}
+
+ReplayReport TMSSystem::replay_workload(const std::vector<WorkloadEvent>& events, const ReplayOptions& options) {
+    ReplayReport report;
+    report.events = events.size();
+    if (events.empty()) return report;
+    
+    // Events are grouped by volume: a dataset's events share its volume's
+    // lane, so an add never overtakes the volume it lands on. Operations
+    // that span volumes are barriers that run alone once every lane has
+    // reached them. Each phase is the lanes' work up to the next barrier.
+    size_t threads = std::max<size_t>(1, options.threads);
+    struct Phase {
+        std::vector<std::vector<const WorkloadEvent*>> lanes;
+        const WorkloadEvent* barrier = nullptr;
+    };
+    std::vector<Phase> phases(1);
+    phases.back().lanes.resize(threads);
+    
+    std::unordered_map<std::string, std::string> dataset_volume;
+    auto volume_of_dataset = [&](const WorkloadEvent& event) -> std::string {
+        auto it = dataset_volume.find(event.target);
+        if (it != dataset_volume.end()) return it->second;
+        std::string volser;
+        if (event.dataset) {
+            volser = event.dataset->volser;
+        } else {
+            std::shared_lock<std::shared_mutex> lock(catalog_mutex_);
+            auto ds = datasets_.find(event.target);
+            volser = ds != datasets_.end() ? ds->second.volser : event.target;
+        }
+        return dataset_volume[event.target] = volser;
+    };
+    
+    std::hash<std::string> hasher;
+    for (const auto& event : events) {
+        const std::string& op = event.operation;
+        bool spans_volumes = op.rfind("BULK_", 0) == 0 || op.rfind("IMPORT_", 0) == 0 ||
+                             op == "CLONE_VOLUME" || op == "RENAME_POOL" || op == "MERGE_POOLS" ||
+                             op == "ALLOCATE_SCRATCH" || op == "PROCESS_EXPIRATIONS" ||
+                             op == "CLEANUP_RESERVATIONS";
+        for (const auto& ds : event.datasets) dataset_volume[ds.name] = ds.volser;
+        
+        std::string key = event.target;
+        if (!spans_volumes && op.find("DATASET") != std::string::npos) {
+            key = volume_of_dataset(event);
+            if (event.dataset && event.dataset->volser != key) {
+                // Moved to another volume: touches both lanes
+                dataset_volume[event.target] = event.dataset->volser;
+                spans_volumes = true;
+            }
+        }
+        
+        if (spans_volumes) {
+            phases.back().barrier = &event;
+            phases.emplace_back().lanes.resize(threads);
+        } else {
+            phases.back().lanes[key.empty() ? 0 : hasher(key) % threads].push_back(&event);
+        }
+    }
+    
+    struct LaneResult {
+        std::map<std::string, ReplayOperationStats> operations;
+        size_t replayed = 0;
+        size_t failed = 0;
+        size_t skipped = 0;
+    };
+    std::vector<LaneResult> results(threads);
+    
+    int64_t first_offset = events.front().offset_us;
+    for (const auto& event : events) first_offset = std::min(first_offset, event.offset_us);
+    double speed = options.pacing == ReplayPacing::ACCELERATED && options.speed > 0 ? options.speed : 1.0;
+    
+    auto lock_before = get_lock_contention_stats();
+    auto start = std::chrono::steady_clock::now();
+    
+    auto run_event = [&](LaneResult& out, const WorkloadEvent* event) {
+        if (options.pacing != ReplayPacing::MAX_SPEED) {
+            auto delay = static_cast<double>(event->offset_us - first_offset) / speed;
+            std::this_thread::sleep_until(start + std::chrono::microseconds(static_cast<int64_t>(delay)));
+        }
+        auto op_start = std::chrono::steady_clock::now();
+        auto result = replay_event(*event);
+        auto elapsed = std::chrono::steady_clock::now() - op_start;
+        if (!result) {
+            out.skipped++;
+            return;
+        }
+        auto& stats = out.operations[event->operation];
+        stats.latency.record(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+        out.replayed++;
+        if (!result->is_success()) {
+            stats.errors++;
+            out.failed++;
+        }
+    };
+    
+    std::barrier sync(static_cast<std::ptrdiff_t>(threads));
+    auto run_lane = [&](size_t lane) {
+        for (const Phase& phase : phases) {
+            for (const WorkloadEvent* event : phase.lanes[lane]) run_event(results[lane], event);
+            if (!phase.barrier) continue;
+            sync.arrive_and_wait();
+            if (lane == 0) run_event(results[0], phase.barrier);
+            sync.arrive_and_wait();
+        }
+    };
+    
+    std::vector<std::thread> workers;
+    for (size_t lane = 1; lane < threads; lane++) workers.emplace_back(run_lane, lane);
+    run_lane(0);
+    for (auto& worker : workers) worker.join();
+    
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    auto lock_after = get_lock_contention_stats();
+    report.lock.acquisitions = lock_after.acquisitions - lock_before.acquisitions;
+    report.lock.contended = lock_after.contended - lock_before.contended;
+    report.lock.wait_ns = lock_after.wait_ns - lock_before.wait_ns;
+    
+    for (const auto& lane : results) {
+        report.replayed += lane.replayed;
+        report.failed += lane.failed;
+        report.skipped += lane.skipped;
+        for (const auto& [name, stats] : lane.operations) {
+            auto& merged = report.operations[name];
+            merged.latency.merge(stats.latency);
+            merged.errors += stats.errors;
+        }
+    }
+    return report;
+}
+
+LockContentionStats TMSSystem::get_lock_contention_stats() const {
+    LockContentionStats stats;
+    stats.acquisitions = lock_acquisitions_.load(std::memory_order_relaxed);
+    stats.contended = lock_contended_.load(std::memory_order_relaxed);
+    stats.wait_ns = lock_wait_ns_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+// ============================================================================
+// v3.4.0: Change Data Capture
+// ============================================================================
+
+OperationResult TMSSystem::enable_change_stream(ChangeLogOptions options) {
+    disable_change_stream();
+    if (options.directory.empty()) options.directory = data_directory_ + PATH_SEP_STR + "cdc";
+    
+    auto log = std::make_shared<ChangeLog>();
+    auto opened = log->open(options);
+    if (!opened.is_success()) return opened;
+    
+    std::unique_lock<std::shared_mutex> lock(catalog_mutex_);
+    change_log_ = std::move(log);
+    lock.unlock();
+    TMS_LOG_INFO("TMSSystem", "Change stream enabled: " + options.directory);
+    return OperationResult::ok();
+}
+
+void TMSSystem::disable_change_stream() {
+    std::shared_ptr<ChangeLog> log;
+    {
+        std::unique_lock<std::shared_mutex> lock(catalog_mutex_);
+        log.swap(change_log_);
+        pending_changes_.clear();
+        pending_keys_.clear();
+    }
+    // Closing drains the queue; subscribers may call back into the catalog
+    if (log) log->close();
+}
+
+std::shared_ptr<ChangeLog> TMSSystem::get_change_stream() const {
+    std::shared_lock<std::shared_mutex> lock(catalog_mutex_);
+    return change_log_;
+}
+
+// A write can touch a record more than once; the first call holds the
+// state before the write
+void TMSSystem::note_volume_change(const std::string& volser, const TapeVolume* before) {
+    if (!pending_keys_.emplace(ChangeEntity::VOLUME, volser).second) return;
+    PendingChange change{ChangeEntity::VOLUME, volser};
+    if (before) {
+        change.existed = true;
+        change.status = static_cast<int>(before->status);
+        change.reserved = !before->reserved_by.empty();
+        change.tags = before->tags.size();
+    }
+    pending_changes_.push_back(std::move(change));
+}
+
+void TMSSystem::note_dataset_change(const std::string& name, const Dataset* before) {
+    if (!pending_keys_.emplace(ChangeEntity::DATASET, name).second) return;
+    PendingChange change{ChangeEntity::DATASET, name};
+    if (before) {
+        change.existed = true;
+        change.status = static_cast<int>(before->status);
+        change.tags = before->tags.size();
+    }
+    pending_changes_.push_back(std::move(change));
+}
+
+// Records changed one by one can't describe a wholesale replacement, so the
+// log gets a RESYNC marker and its consumers re-read the catalog
+void TMSSystem::note_catalog_replaced() {
+    pending_changes_.clear();
+    pending_keys_.clear();
+    if (!change_log_) return;
+    ChangeRecord record;
+    record.timestamp = write_time_;
+    record.entity = ChangeEntity::CATALOG;
+    record.operation = ChangeOperation::RESYNC;
+    record.event = EventType::CATALOG_LOADED;
+    record.user = get_current_user();
+    if (const OperationContext* ctx = current_operation_context()) {
+        record.session_id = ctx->session_id;
+        record.request_id = ctx->request_id;
+    }
+    change_log_->append(std::move(record));
+}
+
+namespace {
+
+EventType classify_volume_change(int before_status, bool before_reserved, size_t before_tags,
+                                 const TapeVolume& after) {
+    auto before = static_cast<VolumeStatus>(before_status);
+    if (after.status != before) {
+        if (after.status == VolumeStatus::MOUNTED) return EventType::VOLUME_MOUNTED;
+        if (before == VolumeStatus::MOUNTED) return EventType::VOLUME_DISMOUNTED;
+        if (after.status == VolumeStatus::SCRATCH) return EventType::VOLUME_SCRATCHED;
+        if (after.status == VolumeStatus::EXPIRED) return EventType::VOLUME_EXPIRED;
+    }
+    bool reserved = !after.reserved_by.empty();
+    if (reserved != before_reserved) return reserved ? EventType::VOLUME_RESERVED : EventType::VOLUME_RELEASED;
+    if (after.tags.size() > before_tags) return EventType::VOLUME_TAGGED;
+    if (after.tags.size() < before_tags) return EventType::VOLUME_UNTAGGED;
+    return EventType::VOLUME_UPDATED;
+}
+
+EventType classify_dataset_change(int before_status, size_t before_tags, const Dataset& after) {
+    if (after.status != static_cast<DatasetStatus>(before_status)) {
+        if (after.status == DatasetStatus::MIGRATED) return EventType::DATASET_MIGRATED;
+        if (after.status == DatasetStatus::RECALLED) return EventType::DATASET_RECALLED;
+        if (after.status == DatasetStatus::EXPIRED) return EventType::DATASET_EXPIRED;
+    }
+    if (after.tags.size() > before_tags) return EventType::DATASET_TAGGED;
+    return EventType::DATASET_UPDATED;
+}
+
+} // namespace
+
+// Called by CatalogWriteLock before it releases, so sequence numbers follow
+// commit order and the after images are exactly what this write committed
+void TMSSystem::commit_changes() {
+    if (lock_free_reads_.load(std::memory_order_relaxed)) publish_changes();
+    commit_hot_volumes();
+    if (pending_changes_.empty()) return;
+    if (capturing_.load(std::memory_order_relaxed)) {
+        if (tls_captured.owner != this) tls_captured = CapturedImages{this, {}, {}};
+        for (const auto& change : pending_changes_) {
+            if (change.entity == ChangeEntity::VOLUME) {
+                auto it = volumes_.find(change.key);
+                if (it != volumes_.end()) tls_captured.volumes.push_back(it->second);
+            } else {
+                auto it = datasets_.find(change.key);
+                if (it != datasets_.end()) tls_captured.datasets.push_back(it->second);
+            }
+        }
+    }
+    if (!change_log_) {
+        pending_changes_.clear();
+        pending_keys_.clear();
+        return;
+    }
+    
+    // v3.4.0: The writer's context, resolved once for the whole commit
+    const OperationContext* ctx = current_operation_context();
+    std::string user = get_current_user();
+    for (const auto& change : pending_changes_) {
+        ChangeRecord record;
+        record.timestamp = write_time_;
+        record.entity = change.entity;
+        record.key = change.key;
+        record.user = user;
+        if (ctx) {
+            record.session_id = ctx->session_id;
+            record.request_id = ctx->request_id;
+        }
+        
+        if (change.entity == ChangeEntity::VOLUME) {
+            auto it = volumes_.find(change.key);
+            if (it == volumes_.end()) {
+                if (!change.existed) continue;
+                record.operation = ChangeOperation::DELETE;
+                record.event = EventType::VOLUME_DELETED;
+            } else if (!change.existed) {
+                record.operation = ChangeOperation::INSERT;
+                record.event = EventType::VOLUME_ADDED;
+                record.volume = it->second;
+            } else {
+                record.event = classify_volume_change(change.status, change.reserved, change.tags, it->second);
+                record.volume = it->second;
+            }
+        } else {
+            auto it = datasets_.find(change.key);
+            if (it == datasets_.end()) {
+                if (!change.existed) continue;
+                record.operation = ChangeOperation::DELETE;
+                record.event = EventType::DATASET_DELETED;
+            } else if (!change.existed) {
+                record.operation = ChangeOperation::INSERT;
+                record.event = EventType::DATASET_ADDED;
+                record.dataset = it->second;
+            } else {
+                record.event = classify_dataset_change(change.status, change.tags, it->second);
+                record.dataset = it->second;
+            }
+        }
+        change_log_->append(std::move(record));
+    }
+    pending_changes_.clear();
+    pending_keys_.clear();
+}
+
+// For a write that failed part way: what it changed is not committed anywhere
+void TMSSystem::discard_changes() noexcept {
+    pending_changes_.clear();
+    pending_keys_.clear();
+    hot_dirty_.clear();
+    published_dirty_datasets_.clear();
+}
+
+// ============================================================================
+// v3.4.0: Replication
+// ============================================================================
+
+Result<CatalogSnapshot> TMSSystem::snapshot_for_replication() const {
+    std::shared_lock<std::shared_mutex> lock(catalog_mutex_);
+    if (!change_log_) {
+        return Result<CatalogSnapshot>::err(TMSError::INVALID_STATE, "Change stream is not enabled");
     }
     
-    BatchResult result;
-    std::string line;
-    bool header = true;
-    
-    while (std::getline(file, line)) {
-        if (header) { header = false; continue; }
-        if (line.empty()) continue;
+    // Sequences are assigned under the write lock, so none can move past us
+    CatalogSnapshot snapshot;
+    snapshot.sequence = change_log_->last_sequence();
+    snapshot.volumes.reserve(volumes_.size());
+    for (const auto& [volser, vol] : volumes_) snapshot.volumes.push_back(vol);
+    snapshot.datasets.reserve(datasets_.size());
+    for (const auto& [name, ds] : datasets_) snapshot.datasets.push_back(ds);
+    return Result<CatalogSnapshot>::ok(std::move(snapshot));
+}
+
+void TMSSystem::install_replica_snapshot(CatalogSnapshot snapshot) {
+    size_t volume_count = snapshot.volumes.size();
+    size_t dataset_count = snapshot.datasets.size();
+    {
+        auto lock = lock_for_write();
         
-        result.total++;
-        // Parse CSV and create volume... (simplified)
-        TapeVolume vol;
-        std::istringstream iss(line);
-        std::getline(iss, vol.volser, ',');
+        // As with a reload, earlier versions no longer describe this catalog
+        volume_history_.reset(write_time_);
+        dataset_history_.reset(write_time_);
         
-        auto op = add_volume(vol);
-        if (op.is_success()) {
-            result.succeeded++;
-        } else {
-            result.failed++;
-            result.failures.emplace_back(vol.volser, op.error().message);
+        volumes_.clear();
+        datasets_.clear();
+        for (auto& vol : snapshot.volumes) {
+            std::string key = vol.volser;
+            volumes_.insert_or_assign(std::move(key), std::move(vol));
+        }
+        for (auto& ds : snapshot.datasets) {
+            std::string key = ds.name;
+            datasets_.insert_or_assign(std::move(key), std::move(ds));
         }
+        rebuild_indices();
+        note_catalog_replaced();
     }
-    
-    return Result<BatchResult>::ok(result);
+    add_audit_record("INSTALL_SNAPSHOT", "", std::to_string(volume_count) + " volumes, " +
+                     std::to_string(dataset_count) + " datasets at sequence " +
+                     std::to_string(snapshot.sequence));
 }
 
-Result<BatchResult> TMSSystem::import_datasets_from_csv(const std::string& file_path) {
-    std::ifstream file(file_path);
-    if (!file.is_open()) {
-        return Result<BatchResult>::err(TMSError::FILE_NOT_FOUND, "Cannot open: " + file_path);
-    }
+void TMSSystem::apply_replicated_changes(const std::vector<ChangeRecord>& changes) {
+    if (changes.empty()) return;
+    auto lock = lock_for_write();
     
-    BatchResult result;
-    std::string line;
-    bool header = true;
-    
-    while (std::getline(file, line)) {
-        if (header) { header = false; continue; }
-        if (line.empty()) continue;
-        
-        result.total++;
-        Dataset ds;
-        std::istringstream iss(line);
-        std::getline(iss, ds.name, ',');
-        std::getline(iss, ds.volser, ',');
-        
-        auto op = add_dataset(ds);
-        if (op.is_success()) {
-            result.succeeded++;
+    // Each change carries the record's full after image, so a record is
+    // unindexed, replaced (or erased) and indexed again
+    for (const auto& change : changes) {
+        if (change.entity == ChangeEntity::CATALOG) continue;
+        if (change.entity == ChangeEntity::VOLUME) {
+            auto it = volumes_.find(change.key);
+            if (it != volumes_.end()) {
+                volume_owner_index_.remove(it->second.owner, change.key);
+                volume_pool_index_.remove(it->second.pool, change.key);
+                for (const auto& tag : it->second.tags) volume_tag_index_.remove(tag, change.key);
+            }
+            retire_volume(change.key, it != volumes_.end() ? &it->second : nullptr);
+            if (!change.volume) {
+                if (it != volumes_.end()) volumes_.erase(it);
+                continue;
+            }
+            if (it == volumes_.end()) {
+                it = volumes_.emplace(change.key, *change.volume).first;
+            } else {
+                it->second = *change.volume;
+            }
+            volume_owner_index_.add(it->second.owner, change.key);
+            volume_pool_index_.add(it->second.pool, change.key);
+            for (const auto& tag : it->second.tags) volume_tag_index_.add(tag, change.key);
         } else {
-            result.failed++;
-            result.failures.emplace_back(ds.name, op.error().message);
+            auto it = datasets_.find(change.key);
+            if (it != datasets_.end()) {
+                dataset_owner_index_.remove(it->second.owner, change.key);
+                for (const auto& tag : it->second.tags) dataset_tag_index_.remove(tag, change.key);
+            }
+            retire_dataset(change.key, it != datasets_.end() ? &it->second : nullptr);
+            if (!change.dataset) {
+                if (it != datasets_.end()) datasets_.erase(it);
+                continue;
+            }
+            if (it == datasets_.end()) {
+                it = datasets_.emplace(change.key, *change.dataset).first;
+            } else {
+                it->second = *change.dataset;
+            }
+            dataset_owner_index_.add(it->second.owner, change.key);
+            for (const auto& tag : it->second.tags) dataset_tag_index_.add(tag, change.key);
         }
     }
-    
-    return Result<BatchResult>::ok(result);
 }
 
 // ============================================================================
-// Reports
+// v3.4.0: Hot Volume Table
 // ============================================================================
 
-void TMSSystem::generate_volume_report(std::ostream& os, std::optional<VolumeStatus> status) const {
-    std::shared_lock<std::shared_mutex> lock(catalog_mutex_);
-    
-    os << "\n=== VOLUME REPORT ===\n";
-    os << "Generated: " << get_timestamp() << "\n\n";
-    os << std::left << std::setw(8) << "Volser" 
-       << std::setw(10) << "Status"
-       << std::setw(10) << "Density"
-       << std::setw(15) << "Pool"
-       << std::setw(10) << "Owner"
-       << std::setw(12) << "Used"
-       << "\n";
-    os << std::string(65, '-') << "\n";
-    
-    for (const auto& [volser, vol] : volumes_) {
-        if (status.has_value() && vol.status != status.value()) continue;
-        
-        os << std::left << std::setw(8) << vol.volser
-           << std::setw(10) << volume_status_to_string(vol.status)
-           << std::setw(10) << density_to_string(vol.density)
-           << std::setw(15) << vol.pool
-           << std::setw(10) << vol.owner
-           << std::setw(12) << format_bytes(vol.used_bytes)
-           << "\n";
+// Updates refresh their row in place; an add or delete leaves the table to
+// the next scan. Deleted records are checked for first because their rows
+// still point at the freed nodes.
+void TMSSystem::commit_hot_volumes() {
+    if (hot_dirty_.empty()) return;
+    if (!hot_volumes_.stale()) {
+        bool structural = hot_volumes_.size() != volumes_.size();
+        for (const auto& volser : hot_dirty_) {
+            if (structural) break;
+            structural = volumes_.count(volser) == 0;
+        }
+        for (const auto& volser : hot_dirty_) {
+            if (structural) break;
+            structural = !hot_volumes_.refresh(volumes_.find(volser)->second);
+        }
+        if (structural) hot_volumes_.invalidate();
     }
-    
-    os << "\nTotal: " << volumes_.size() << " volumes\n";
+    hot_dirty_.clear();
 }
 
-void TMSSystem::generate_dataset_report(std::ostream& os, const std::string& volser) const {
-    std::shared_lock<std::shared_mutex> lock(catalog_mutex_);
-    
-    os << "\n=== DATASET REPORT ===\n";
-    os << "Generated: " << get_timestamp() << "\n\n";
-    os << std::left << std::setw(30) << "Name"
-       << std::setw(8) << "Volser"
-       << std::setw(10) << "Status"
-       << std::setw(12) << "Size"
-       << std::setw(10) << "Owner"
-       << "\n";
-    os << std::string(70, '-') << "\n";
-    
-    for (const auto& [name, ds] : datasets_) {
-        if (!volser.empty() && ds.volser != volser) continue;
-        
-        os << std::left << std::setw(30) << ds.name
-           << std::setw(8) << ds.volser
-           << std::setw(10) << dataset_status_to_string(ds.status)
-           << std::setw(12) << format_bytes(ds.size_bytes)
-           << std::setw(10) << ds.owner
-           << "\n";
+// A stale table can only be seen by readers once the writer that staled it
+// has released the exclusive lock, and none can stale it again while any
+// reader holds the shared lock, so one rebuild under the mutex is enough.
+const VolumeHotTable& TMSSystem::hot_volumes() const {
+    if (hot_volumes_.stale()) {
+        std::lock_guard<std::mutex> guard(hot_volumes_mutex_);
+        if (hot_volumes_.stale()) hot_volumes_.rebuild(volumes_);
     }
-    
-    os << "\nTotal: " << datasets_.size() << " datasets\n";
+    return hot_volumes_;
 }
 
-void TMSSystem::generate_pool_report(std::ostream& os) const {
+VolumeTableStats TMSSystem::get_volume_table_stats() const {
     std::shared_lock<std::shared_mutex> lock(catalog_mutex_);
-    
-    os << "\n=== POOL REPORT ===\n";
-    os << "Generated: " << get_timestamp() << "\n\n";
-    
-    auto pools = volume_pool_index_.get_all_values();
-    for (const auto& pool : pools) {
-        auto stats = get_pool_statistics(pool);
-        os << "Pool: " << pool << "\n";
-        os << "  Total: " << stats.total_volumes << ", "
-           << "Scratch: " << stats.scratch_volumes << ", "
-           << "Private: " << stats.private_volumes << "\n";
-        os << "  Capacity: " << format_bytes(stats.total_capacity)
-           << ", Used: " << format_bytes(stats.used_capacity)
-           << " (" << std::fixed << std::setprecision(1) << stats.get_utilization() << "%)\n\n";
-    }
+    std::lock_guard<std::mutex> guard(hot_volumes_mutex_);
+    return hot_volumes_.stats();
 }
 
-void TMSSystem::generate_statistics(std::ostream& os) const {
-    auto stats = get_statistics();
-    
-    os << "\n=== SYSTEM STATISTICS ===\n";
-    os << "Generated: " << get_timestamp() << "\n";
-    os << "Uptime: " << stats.get_uptime() << "\n\n";
-    
-    os << "Volumes:\n";
-    os << "  Total: " << stats.total_volumes << "\n";
-    os << "  Scratch: " << stats.scratch_volumes << "\n";
-    os << "  Private: " << stats.private_volumes << "\n";
-    os << "  Mounted: " << stats.mounted_volumes << "\n";
-    os << "  Expired: " << stats.expired_volumes << "\n";
-    os << "  Reserved: " << stats.reserved_volumes << "\n\n";
-    
-    os << "Datasets:\n";
-    os << "  Total: " << stats.total_datasets << "\n";
-    os << "  Active: " << stats.active_datasets << "\n";
-    os << "  Migrated: " << stats.migrated_datasets << "\n";
-    os << "  Expired: " << stats.expired_datasets << "\n\n";
-    
-    os << "Capacity:\n";
-    os << "  Total: " << format_bytes(stats.total_capacity) << "\n";
-    os << "  Used: " << format_bytes(stats.used_capacity) << "\n";
-    os << "  Utilization: " << std::fixed << std::setprecision(1) 
-       << stats.get_utilization() << "%\n\n";
-    
-    os << "Cache:\n";
-    os << "  Regex patterns: " << RegexCache::instance().size() << "\n";
-    os << "  Audit pruned: " << audit_log_.pruned_count() << "\n";
+// ============================================================================
+// v3.4.0: Lock-Free Reads
+// ============================================================================
+
+void TMSSystem::enable_lock_free_reads() {
+    std::unique_lock<std::shared_mutex> lock(catalog_mutex_);
+    if (lock_free_reads_.load(std::memory_order_relaxed)) return;
+    published_volumes_.assign(volumes_);
+    published_datasets_.assign(datasets_);
+    lock_free_reads_.store(true, std::memory_order_release);
+    lock.unlock();
+    TMS_LOG_INFO("TMSSystem", "Lock-free reads enabled");
 }
 
-void TMSSystem::generate_expiration_report(std::ostream& os) const {
-    os << "\n=== EXPIRATION REPORT ===\n";
-    os << "Generated: " << get_timestamp() << "\n\n";
-    
-    auto expired_vols = list_expired_volumes();
-    auto expired_ds = list_expired_datasets();
-    auto expiring = list_expiring_soon();
-    
-    os << "Expired Volumes: " << expired_vols.size() << "\n";
-    for (const auto& v : expired_vols) {
-        os << "  " << v << "\n";
+// Readers that saw the flag set may still be inside the published maps, so
+// they are waited out before the maps are emptied
+void TMSSystem::disable_lock_free_reads() {
+    std::unique_lock<std::shared_mutex> lock(catalog_mutex_);
+    if (!lock_free_reads_.exchange(false, std::memory_order_acq_rel)) return;
+    published_dirty_datasets_.clear();
+    EpochDomain::instance().synchronize();
+    published_volumes_.clear();
+    published_datasets_.clear();
+}
+
+// Called from commit_changes() before the hot table consumes hot_dirty_
+void TMSSystem::publish_changes() {
+    for (const auto& volser : hot_dirty_) {
+        auto it = volumes_.find(volser);
+        if (it != volumes_.end()) published_volumes_.publish(it->second);
+        else published_volumes_.unpublish(volser);
     }
-    
-    os << "\nExpired Datasets: " << expired_ds.size() << "\n";
-    for (const auto& d : expired_ds) {
-        os << "  " << d << "\n";
+    for (const auto& name : published_dirty_datasets_) {
+        auto it = datasets_.find(name);
+        if (it != datasets_.end()) published_datasets_.publish(it->second);
+        else published_datasets_.unpublish(name);
     }
-    
-    os << "\nExpiring Soon (7 days): " << expiring.size() << "\n";
-    for (const auto& e : expiring) {
-        os << "  " << e << "\n";
+    published_dirty_datasets_.clear();
+}
+
+// ============================================================================
+// v3.4.0: Memory Arenas
+// ============================================================================
+
+std::vector<ArenaStats> TMSSystem::get_arena_stats() const {
+    std::vector<ArenaStats> stats;
+    {
+        std::shared_lock<std::shared_mutex> lock(catalog_mutex_);
+        stats.push_back(catalog_arena_.stats());
     }
+    auto scratch = get_scratch_arena_stats();
+    stats.insert(stats.end(), scratch.begin(), scratch.end());
+    return stats;
 }
 
 SystemStatistics TMSSystem::get_statistics() const {
@@ -1757,11 +3569,13 @@ SystemStatistics TMSSystem::get_statistics() const {
     stats.total_volumes = volumes_.size();
     stats.total_datasets = datasets_.size();
     
-    for (const auto& [volser, vol] : volumes_) {
+    const auto now = current_time();
+    std::unordered_map<Symbol, size_t> pool_counts;
+    for (const auto& vol : hot_volumes().rows()) {
         stats.total_capacity += vol.capacity_bytes;
         stats.used_capacity += vol.used_bytes;
         
-        switch (vol.status) {
+        switch (vol.get_status()) {
             case VolumeStatus::SCRATCH: stats.scratch_volumes++; break;
             case VolumeStatus::PRIVATE: stats.private_volumes++; break;
             case VolumeStatus::MOUNTED: stats.mounted_volumes++; break;
@@ -1769,12 +3583,13 @@ SystemStatistics TMSSystem::get_statistics() const {
             default: break;
         }
         
-        if (vol.is_reserved()) stats.reserved_volumes++;
+        if (vol.is_reserved(now)) stats.reserved_volumes++;
         
         if (!vol.pool.empty()) {
-            stats.pool_counts[vol.pool]++;
+            pool_counts[vol.pool]++;
         }
     }
+    for (const auto& [pool, count] : pool_counts) stats.pool_counts[pool] = count;
     
     for (const auto& [name, ds] : datasets_) {
         switch (ds.status) {
@@ -1792,9 +3607,31 @@ SystemStatistics TMSSystem::get_statistics() const {
 // Audit
 // ============================================================================
 
+std::string TMSSystem::get_current_user() const {
+    const OperationContext* ctx = current_operation_context();
+    if (ctx && !ctx->user.empty()) return ctx->user;
+    return *default_user_.load(std::memory_order_acquire);
+}
+
 void TMSSystem::add_audit_record(const std::string& operation, const std::string& target,
                                   const std::string& details, bool success) {
-    audit_log_.add(operation, current_user_, target, details, success);
+    // v3.4.0: Attributed to the calling thread's OperationContext
+    AuditRecord record;
+    record.timestamp = current_time();
+    record.operation = operation;
+    record.user = get_current_user();
+    record.target = target;
+    record.details = details;
+    record.success = success;
+    if (const OperationContext* ctx = current_operation_context()) {
+        record.source_ip = ctx->source;
+        record.session_id = ctx->session_id;
+        record.request_id = ctx->request_id;
+    }
+    audit_log_.add(record);
+    if (capturing_.load(std::memory_order_relaxed)) {
+        capture_mutation(operation, target, details, success);
+    }
 }
 
 std::vector<AuditRecord> TMSSystem::get_audit_log(size_t count) const {
@@ -1827,8 +3664,9 @@ HealthCheckResult TMSSystem::perform_health_check() const {
     
     // Check scratch pool
     size_t scratch_count = 0;
+    const auto now = current_time();
     for (const auto& [volser, vol] : volumes_) {
-        if (vol.is_available_for_scratch()) scratch_count++;
+        if (vol.is_available_for_scratch(now)) scratch_count++;
     }
     
     if (scratch_count == 0) {
@@ -1966,7 +3804,7 @@ Result<TapeVolume> TMSSystem::clone_volume(const std::string& source_volser, con
         return Result<TapeVolume>::err(TMSError::INVALID_VOLSER, "Invalid new volume serial: " + new_volser);
     }
     
-    std::unique_lock<std::shared_mutex> lock(catalog_mutex_);
+    auto lock = lock_for_write();
     
     auto source_it = volumes_.find(source_volser);
     if (source_it == volumes_.end()) {
@@ -1984,12 +3822,13 @@ Result<TapeVolume> TMSSystem::clone_volume(const std::string& source_volser, con
     cloned.used_bytes = 0;
     cloned.mount_count = 0;
     cloned.status = VolumeStatus::SCRATCH;
-    cloned.creation_date = std::chrono::system_clock::now();
+    cloned.creation_date = current_time();
     cloned.expiration_date = cloned.creation_date + std::chrono::hours(24 * 365);
     cloned.reserved_by.clear();
     cloned.reservation_expires = std::chrono::system_clock::time_point{};
     
     // Add to catalog
+    retire_volume(new_volser, nullptr);
     volumes_[new_volser] = cloned;
     
     // Update indices
@@ -2011,7 +3850,7 @@ Result<TapeVolume> TMSSystem::clone_volume(const std::string& source_volser, con
 // ============================================================================
 
 OperationResult TMSSystem::update_volume_location(const std::string& volser, const std::string& new_location) {
-    std::unique_lock<std::shared_mutex> lock(catalog_mutex_);
+    auto lock = lock_for_write();
     
     auto it = volumes_.find(volser);
     if (it == volumes_.end()) {
@@ -2023,10 +3862,11 @@ OperationResult TMSSystem::update_volume_location(const std::string& volser, con
     // Record location history entry
     LocationHistoryEntry entry;
     entry.location = old_location;
-    entry.timestamp = std::chrono::system_clock::now();
-    entry.moved_by = current_user_;
+    entry.timestamp = current_time();
+    entry.moved_by = get_current_user();
     entry.reason = "Location update";
     
+    retire_volume(volser, &it->second);
     it->second.location_history.push_back(entry);
     
     // Keep only last MAX_LOCATION_HISTORY entries
@@ -2051,11 +3891,12 @@ OperationResult TMSSystem::rename_pool(const std::string& old_name, const std::s
         return OperationResult::err(TMSError::INVALID_PARAMETER, "Pool names cannot be empty");
     }
     
-    std::unique_lock<std::shared_mutex> lock(catalog_mutex_);
+    auto lock = lock_for_write();
     
     size_t updated = 0;
     for (auto& [volser, vol] : volumes_) {
         if (vol.pool == old_name) {
+            retire_volume(volser, &vol);
             volume_pool_index_.update(old_name, new_name, volser);
             vol.pool = new_name;
             updated++;
@@ -2081,11 +3922,12 @@ OperationResult TMSSystem::merge_pools(const std::string& source_pool, const std
         return OperationResult::err(TMSError::INVALID_PARAMETER, "Source and target pools must be different");
     }
     
-    std::unique_lock<std::shared_mutex> lock(catalog_mutex_);
+    auto lock = lock_for_write();
     
     size_t merged = 0;
     for (auto& [volser, vol] : volumes_) {
         if (vol.pool == source_pool) {
+            retire_volume(volser, &vol);
             volume_pool_index_.update(source_pool, target_pool, volser);
             vol.pool = target_pool;
             merged++;
@@ -2117,7 +3959,7 @@ Result<VolumeSnapshot> TMSSystem::create_volume_snapshot(const std::string& vols
         return Result<VolumeSnapshot>::err(TMSError::VOLUME_NOT_FOUND, "Volume not found: " + volser);
     }
     
-    auto snapshot = snapshot_manager_.create_snapshot(it->second, current_user_, description);
+    auto snapshot = snapshot_manager_.create_snapshot(it->second, get_current_user(), description);
     
     lock.unlock();
     add_audit_record("CREATE_SNAPSHOT", volser, "Snapshot: " + snapshot.snapshot_id);
@@ -2149,13 +3991,14 @@ OperationResult TMSSystem::restore_from_snapshot(const std::string& snapshot_id)
     
     const auto& snap = snap_opt.value();
     
-    std::unique_lock<std::shared_mutex> lock(catalog_mutex_);
+    auto lock = lock_for_write();
     
     auto it = volumes_.find(snap.volser);
     if (it == volumes_.end()) {
         return OperationResult::err(TMSError::VOLUME_NOT_FOUND, "Volume not found: " + snap.volser);
     }
     
+    retire_volume(snap.volser, &it->second);
     it->second.status = snap.status_at_snapshot;
     it->second.tags = snap.tags_at_snapshot;
     it->second.notes = snap.notes_at_snapshot;
@@ -2175,6 +4018,11 @@ size_t TMSSystem::get_snapshot_count() const {
 // ============================================================================
 
 VolumeHealthScore TMSSystem::get_volume_health(const std::string& volser) const {
+    if (auto health = read_published(published_volumes_, volser, [](const TapeVolume* vol) {
+            return vol ? vol->health_score : VolumeHealthScore{};
+        })) {
+        return *health;
+    }
     std::shared_lock<std::shared_mutex> lock(catalog_mutex_);
     
     auto it = volumes_.find(volser);
@@ -2186,15 +4034,16 @@ VolumeHealthScore TMSSystem::get_volume_health(const std::string& volser) const
 }
 
 OperationResult TMSSystem::recalculate_volume_health(const std::string& volser) {
-    std::unique_lock<std::shared_mutex> lock(catalog_mutex_);
+    auto lock = lock_for_write();
     
     auto it = volumes_.find(volser);
     if (it == volumes_.end()) {
         return OperationResult::err(TMSError::VOLUME_NOT_FOUND, "Volume not found: " + volser);
     }
     
+    retire_volume(volser, &it->second);
     it->second.health_score = calculate_health_score(it->second);
-    it->second.last_health_check = std::chrono::system_clock::now();
+    it->second.last_health_check = current_time();
     
     return OperationResult::ok();
 }
@@ -2203,13 +4052,15 @@ BatchResult TMSSystem::recalculate_all_health() {
     auto start = std::chrono::steady_clock::now();
     BatchResult result;
     
-    std::unique_lock<std::shared_mutex> lock(catalog_mutex_);
+    auto lock = lock_for_write();
     
     result.total = volumes_.size();
     
+    const auto now = current_time();
     for (auto& [volser, vol] : volumes_) {
-        vol.health_score = calculate_health_score(vol);
-        vol.last_health_check = std::chrono::system_clock::now();
+        retire_volume(volser, &vol);
+        vol.health_score = calculate_health_score(vol, now);
+        vol.last_health_check = now;
         result.succeeded++;
     }
     
@@ -2237,6 +4088,7 @@ std::vector<LifecycleRecommendation> TMSSystem::get_lifecycle_recommendations()
     
     std::vector<LifecycleRecommendation> recommendations;
     
+    const auto now = current_time();
     for (const auto& [volser, vol] : volumes_) {
         LifecycleRecommendation rec;
         rec.volser = volser;
@@ -2260,7 +4112,7 @@ std::vector<LifecycleRecommendation> TMSSystem::get_lifecycle_recommendations()
             continue;
         }
         
-        if (vol.is_expired()) {
+        if (vol.is_expired(now)) {
             rec.action = LifecycleAction::SCRATCH;
             rec.reason = "Volume expired";
             rec.priority = 5;
@@ -2347,7 +4199,7 @@ std::vector<Dataset> TMSSystem::fuzzy_search_datasets(const std::string& pattern
 // ============================================================================
 
 OperationResult TMSSystem::move_volume_to_pool(const std::string& volser, const std::string& target_pool) {
-    std::unique_lock<std::shared_mutex> lock(catalog_mutex_);
+    auto lock = lock_for_write();
     
     auto it = volumes_.find(volser);
     if (it == volumes_.end()) {
@@ -2355,6 +4207,7 @@ OperationResult TMSSystem::move_volume_to_pool(const std::string& volser, const
     }
     
     std::string old_pool = it->second.pool;
+    retire_volume(volser, &it->second);
     volume_pool_index_.update(old_pool, target_pool, volser);
     it->second.pool = target_pool;
     
@@ -2407,43 +4260,47 @@ std::vector<LocationHistoryEntry> TMSSystem::get_location_history(const std::str
 // ============================================================================
 
 void TMSSystem::generate_health_report(std::ostream& os) const {
-    os << "TMS Health Report - " << get_timestamp() << "\n";
-    os << std::string(70, '=') << "\n\n";
-    
-    auto unhealthy = get_unhealthy_volumes();
-    os << "Unhealthy Volumes: " << unhealthy.size() << "\n\n";
-    
-    if (!unhealthy.empty()) {
-        os << std::left << std::setw(8) << "Volser"
-           << std::setw(10) << "Status"
-           << std::setw(8) << "Score"
-           << std::setw(15) << "Health"
-           << "Recommendations\n";
-        os << std::string(70, '-') << "\n";
+    os << cached_report_text("health-report", std::chrono::seconds(report_cache_max_age_.load()), [this] {
+        std::ostringstream oss;
+        oss << "TMS Health Report - " << get_timestamp() << "\n";
+        oss << std::string(70, '=') << "\n\n";
+        
+        auto unhealthy = get_unhealthy_volumes();
+        oss << "Unhealthy Volumes: " << unhealthy.size() << "\n\n";
         
-        for (const auto& vol : unhealthy) {
-            os << std::left << std::setw(8) << vol.volser
-               << std::setw(10) << volume_status_to_string(vol.status)
-               << std::setw(8) << std::fixed << std::setprecision(0) << vol.health_score.overall_score
-               << std::setw(15) << health_status_to_string(vol.health_score.status);
+        if (!unhealthy.empty()) {
+            oss << std::left << std::setw(8) << "Volser"
+                << std::setw(10) << "Status"
+                << std::setw(8) << "Score"
+                << std::setw(15) << "Health"
+                << "Recommendations\n";
+            oss << std::string(70, '-') << "\n";
             
-            for (const auto& rec : vol.health_score.recommendations) {
-                os << rec << "; ";
+            for (const auto& vol : unhealthy) {
+                oss << std::left << std::setw(8) << vol.volser
+                    << std::setw(10) << volume_status_to_string(vol.status)
+                    << std::setw(8) << std::fixed << std::setprecision(0) << vol.health_score.overall_score
+                    << std::setw(15) << health_status_to_string(vol.health_score.status);
+                
+                for (const auto& rec : vol.health_score.recommendations) {
+                    oss << rec << "; ";
+                }
+                oss << "\n";
             }
-            os << "\n";
         }
-    }
-    
-    os << "\nLifecycle Recommendations:\n";
-    os << std::string(50, '-') << "\n";
-    
-    auto recommendations = get_lifecycle_recommendations();
-    for (const auto& rec : recommendations) {
-        os << "  " << rec.volser << ": " 
-           << lifecycle_action_to_string(rec.action) 
-           << " (Priority: " << rec.priority << ") - " 
-           << rec.reason << "\n";
-    }
+        
+        oss << "\nLifecycle Recommendations:\n";
+        oss << std::string(50, '-') << "\n";
+        
+        auto recommendations = get_lifecycle_recommendations();
+        for (const auto& rec : recommendations) {
+            oss << "  " << rec.volser << ": " 
+                << lifecycle_action_to_string(rec.action) 
+                << " (Priority: " << rec.priority << ") - " 
+                << rec.reason << "\n";
+        }
+        return oss.str();
+    });
 }
 // ============================================================================
 // v3.3.0: Encryption Metadata
@@ -2451,13 +4308,14 @@ void TMSSystem::generate_health_report(std::ostream& os) const {
 
 OperationResult TMSSystem::set_volume_encryption(const std::string& volser, 
                                                   const EncryptionMetadata& encryption) {
-    std::unique_lock<std::shared_mutex> lock(catalog_mutex_);
+    auto lock = lock_for_write();
     
     auto it = volumes_.find(volser);
     if (it == volumes_.end()) {
         return OperationResult::err(TMSError::VOLUME_NOT_FOUND, "Volume not found: " + volser);
     }
     
+    retire_volume(volser, &it->second);
     it->second.encryption = encryption;
     
     lock.unlock();
@@ -2509,7 +4367,7 @@ std::vector<TapeVolume> TMSSystem::get_unencrypted_volumes() const {
 // ============================================================================
 
 OperationResult TMSSystem::set_volume_tier(const std::string& volser, StorageTier tier) {
-    std::unique_lock<std::shared_mutex> lock(catalog_mutex_);
+    auto lock = lock_for_write();
     
     auto it = volumes_.find(volser);
     if (it == volumes_.end()) {
@@ -2517,6 +4375,7 @@ OperationResult TMSSystem::set_volume_tier(const std::string& volser, StorageTie
     }
     
     StorageTier old_tier = it->second.storage_tier;
+    retire_volume(volser, &it->second);
     it->second.storage_tier = tier;
     
     lock.unlock();
@@ -2542,9 +4401,9 @@ std::vector<TapeVolume> TMSSystem::get_volumes_by_tier(StorageTier tier) const {
     std::shared_lock<std::shared_mutex> lock(catalog_mutex_);
     
     std::vector<TapeVolume> result;
-    for (const auto& [volser, vol] : volumes_) {
-        if (vol.storage_tier == tier) {
-            result.push_back(vol);
+    for (const auto& row : hot_volumes().rows()) {
+        if (row.get_tier() == tier) {
+            result.push_back(*row.record);
         }
     }
     
@@ -2555,19 +4414,21 @@ BatchResult TMSSystem::auto_tier_volumes(int days_inactive) {
     auto start = std::chrono::steady_clock::now();
     BatchResult result;
     
-    std::unique_lock<std::shared_mutex> lock(catalog_mutex_);
+    auto lock = lock_for_write();
     
-    auto now = std::chrono::system_clock::now();
+    auto now = current_time();
     auto threshold = now - std::chrono::hours(24 * days_inactive);
     
     for (auto& [volser, vol] : volumes_) {
         result.total++;
         
         if (vol.last_access_date < threshold && vol.storage_tier == StorageTier::HOT) {
+            retire_volume(volser, &vol);
             vol.storage_tier = StorageTier::WARM;
             result.succeeded++;
         } else if (vol.last_access_date < threshold - std::chrono::hours(24 * days_inactive) && 
                    vol.storage_tier == StorageTier::WARM) {
+            retire_volume(volser, &vol);
             vol.storage_tier = StorageTier::COLD;
             result.succeeded++;
         } else {
@@ -2715,14 +4576,6 @@ std::string TMSSystem::export_audit_log(AuditExportFormat format) const {
     auto records = audit_log_.get_recent(MAX_AUDIT_ENTRIES);
     std::ostringstream oss;
     
-    // Helper to format timestamp
-    auto format_ts = [](const std::chrono::system_clock::time_point& tp) -> std::string {
-        auto time = std::chrono::system_clock::to_time_t(tp);
-        std::ostringstream ss;
-        ss << std::put_time(std::localtime(&time), "%Y-%m-%d %H:%M:%S");
-        return ss.str();
-    };
-    
     switch (format) {
         case AuditExportFormat::JSON: {
             oss << "[\n";
@@ -2730,10 +4583,13 @@ std::string TMSSystem::export_audit_log(AuditExportFormat format) const {
             for (const auto& entry : records) {
                 if (!first) oss << ",\n";
                 first = false;
-                oss << "  {\"timestamp\": \"" << format_ts(entry.timestamp) << "\", "
+                oss << "  {\"timestamp\": \"" << format_time(entry.timestamp) << "\", "
                     << "\"operation\": \"" << entry.operation << "\", "
                     << "\"target\": \"" << entry.target << "\", "
                     << "\"user\": \"" << entry.user << "\", "
+                    << "\"session\": \"" << entry.session_id << "\", "
+                    << "\"source\": \"" << entry.source_ip << "\", "
+                    << "\"request\": \"" << entry.request_id << "\", "
                     << "\"details\": \"" << entry.details << "\"}";
             }
             oss << "\n]";
@@ -2742,7 +4598,7 @@ std::string TMSSystem::export_audit_log(AuditExportFormat format) const {
         case AuditExportFormat::CSV: {
             oss << "Timestamp,Operation,Target,User,Details\n";
             for (const auto& entry : records) {
-                oss << format_ts(entry.timestamp) << ","
+                oss << format_time(entry.timestamp) << ","
                     << entry.operation << ","
                     << entry.target << ","
                     << entry.user << ","
@@ -2753,7 +4609,7 @@ std::string TMSSystem::export_audit_log(AuditExportFormat format) const {
         case AuditExportFormat::TEXT:
         default: {
             for (const auto& entry : records) {
-                oss << format_ts(entry.timestamp) << " | "
+                oss << format_time(entry.timestamp) << " | "
                     << std::setw(20) << entry.operation << " | "
                     << std::setw(8) << entry.target << " | "
                     << std::setw(8) << entry.user << " | "
@@ -2866,8 +4722,8 @@ StatisticsAggregation TMSSystem::aggregate_volume_capacity() const {
     std::vector<double> values;
     values.reserve(volumes_.size());
     
-    for (const auto& [volser, vol] : volumes_) {
-        values.push_back(static_cast<double>(vol.capacity_bytes));
+    for (const auto& row : hot_volumes().rows()) {
+        values.push_back(static_cast<double>(row.capacity_bytes));
     }
     
     return calculate_statistics(values);
@@ -2879,8 +4735,8 @@ StatisticsAggregation TMSSystem::aggregate_volume_usage() const {
     std::vector<double> values;
     values.reserve(volumes_.size());
     
-    for (const auto& [volser, vol] : volumes_) {
-        values.push_back(vol.get_usage_percent());
+    for (const auto& row : hot_volumes().rows()) {
+        values.push_back(row.get_usage_percent());
     }
     
     return calculate_statistics(values);
@@ -2905,8 +4761,8 @@ StatisticsAggregation TMSSystem::aggregate_mount_counts() const {
     std::vector<double> values;
     values.reserve(volumes_.size());
     
-    for (const auto& [volser, vol] : volumes_) {
-        values.push_back(static_cast<double>(vol.mount_count));
+    for (const auto& row : hot_volumes().rows()) {
+        values.push_back(static_cast<double>(row.mount_count));
     }
     
     return calculate_statistics(values);
@@ -2918,8 +4774,8 @@ StatisticsAggregation TMSSystem::aggregate_error_counts() const {
     std::vector<double> values;
     values.reserve(volumes_.size());
     
-    for (const auto& [volser, vol] : volumes_) {
-        values.push_back(static_cast<double>(vol.get_total_errors()));
+    for (const auto& row : hot_volumes().rows()) {
+        values.push_back(static_cast<double>(row.total_errors));
     }
     
     return calculate_statistics(values);
@@ -3105,6 +4961,16 @@ RetryPolicy TMSSystem::get_retry_policy() const {
     return retry_policy_;
 }
 
+namespace {
+
+// v3.4.0: True when the caller's deadline passes within @p delay_ms
+bool deadline_within(int delay_ms) {
+    const OperationContext* ctx = current_operation_context();
+    return ctx && ctx->expired(OperationContext::Clock::now() + std::chrono::milliseconds(delay_ms));
+}
+
+} // namespace
+
 RetryableResult TMSSystem::retry_operation(std::function<OperationResult()> operation) const {
     RetryableResult result;
     RetryPolicy policy = get_retry_policy();
@@ -3124,6 +4990,10 @@ RetryableResult TMSSystem::retry_operation(std::function<OperationResult()> oper
         
         if (attempt < policy.max_attempts) {
             int delay = calculate_retry_delay(policy, static_cast<int>(attempt));
+            if (deadline_within(delay)) {
+                result.deadline_exceeded = true;
+                break;
+            }
             result.total_delay_ms += delay;
             std::this_thread::sleep_for(std::chrono::milliseconds(delay));
         }
@@ -3133,5 +5003,167 @@ RetryableResult TMSSystem::retry_operation(std::function<OperationResult()> oper
     return result;
 }
 
+// ============================================================================
+// v3.4.0: Asynchronous API
+// ============================================================================
+
+void TMSSystem::set_executor(std::shared_ptr<AsyncExecutor> executor) {
+    executor_.store(std::move(executor), std::memory_order_release);
+}
+
+std::shared_ptr<AsyncExecutor> TMSSystem::get_executor() const {
+    auto executor = executor_.load(std::memory_order_acquire);
+    return executor ? executor : AsyncExecutor::shared();
+}
+
+Task<OperationResult> TMSSystem::mount_volume_async(std::string volser) {
+    auto executor = get_executor();
+    co_await executor->schedule();
+    co_return mount_volume(volser);
+}
+
+Task<OperationResult> TMSSystem::dismount_volume_async(std::string volser) {
+    auto executor = get_executor();
+    co_await executor->schedule();
+    co_return dismount_volume(volser);
+}
+
+Task<OperationResult> TMSSystem::save_catalog_async() {
+    auto executor = get_executor();
+    co_await executor->schedule();
+    
+    // Render under the shared lock, write after releasing it
+    std::ostringstream vol_out;
+    std::ostringstream ds_out;
+    size_t volume_count = 0;
+    size_t dataset_count = 0;
+    {
+        std::shared_lock<std::shared_mutex> lock(catalog_mutex_);
+        write_volume_catalog(vol_out);
+        write_dataset_catalog(ds_out);
+        volume_count = volumes_.size();
+        dataset_count = datasets_.size();
+    }
+    
+    auto result = co_await executor->write_file(volume_catalog_path_, std::move(vol_out).str());
+    if (!result.is_success()) co_return result;
+    result = co_await executor->write_file(dataset_catalog_path_, std::move(ds_out).str());
+    if (!result.is_success()) co_return result;
+    
+    TMS_LOG_DEBUG("TMSSystem", "Catalog saved: " + std::to_string(volume_count) + " volumes, " +
+                  std::to_string(dataset_count) + " datasets");
+    co_return OperationResult::ok();
+}
+
+Task<OperationResult> TMSSystem::load_catalog_async() {
+    auto executor = get_executor();
+    co_await executor->schedule();
+    
+    // Like load_catalog(), a catalog file that cannot be read is skipped
+    auto vol_data = co_await executor->read_file(volume_catalog_path_);
+    auto ds_data = co_await executor->read_file(dataset_catalog_path_);
+    std::optional<std::istringstream> vol_in;
+    std::optional<std::istringstream> ds_in;
+    if (vol_data.is_success()) vol_in.emplace(std::move(vol_data.value()));
+    if (ds_data.is_success()) ds_in.emplace(std::move(ds_data.value()));
+    read_catalog(vol_in ? &*vol_in : nullptr, ds_in ? &*ds_in : nullptr);
+    co_return OperationResult::ok();
+}
+
+Task<OperationResult> TMSSystem::backup_catalog_async(std::string path) {
+    auto executor = get_executor();
+    co_await executor->schedule();
+    
+    auto [vol_backup, ds_backup] = backup_file_paths(path);
+    const std::pair<const std::string*, std::string> copies[] = {
+        {&volume_catalog_path_, vol_backup},
+        {&dataset_catalog_path_, ds_backup}
+    };
+    for (const auto& [source, target] : copies) {
+        auto data = co_await executor->read_file(*source);
+        if (!data.is_success()) {
+            co_return OperationResult::err(TMSError::FILE_WRITE_ERROR, "Backup failed: " + data.error().message);
+        }
+        auto written = co_await executor->write_file(target, std::move(data.value()));
+        if (!written.is_success()) {
+            co_return OperationResult::err(TMSError::FILE_WRITE_ERROR, "Backup failed: " + written.error().message);
+        }
+    }
+    co_return OperationResult::ok();
+}
+
+Task<Result<ExportReport>> TMSSystem::export_volumes_async(std::string file_path, ExportOptions options,
+                                                           VolumeFilter filter) {
+    auto executor = get_executor();
+    co_return co_await executor->blocking([&] { return export_volumes(file_path, options, filter); });
+}
+
+Task<Result<ExportReport>> TMSSystem::export_datasets_async(std::string file_path, ExportOptions options,
+                                                            DatasetFilter filter) {
+    auto executor = get_executor();
+    co_return co_await executor->blocking([&] { return export_datasets(file_path, options, filter); });
+}
+
+Task<OperationResult> TMSSystem::export_to_json_async(std::string file_path) {
+    auto executor = get_executor();
+    co_return co_await executor->blocking([&] { return export_to_json(file_path); });
+}
+
+Task<Result<BatchResult>> TMSSystem::import_from_json_async(std::string file_path) {
+    auto executor = get_executor();
+    co_return co_await executor->blocking([&] { return import_from_json(file_path); });
+}
+
+Task<Result<CsvImportReport>> TMSSystem::bulk_import_volumes_csv_async(std::string file_path,
+                                                                       CsvImportOptions options) {
+    auto executor = get_executor();
+    co_return co_await executor->blocking([&] { return bulk_import_volumes_csv(file_path, options); });
+}
+
+Task<Result<CsvImportReport>> TMSSystem::bulk_import_datasets_csv_async(std::string file_path,
+                                                                        CsvImportOptions options) {
+    auto executor = get_executor();
+    co_return co_await executor->blocking([&] { return bulk_import_datasets_csv(file_path, options); });
+}
+
+Task<RetryableResult> TMSSystem::retry_operation_async(std::function<Task<OperationResult>()> operation) {
+    auto executor = get_executor();
+    co_await executor->schedule();
+    
+    RetryableResult result;
+    RetryPolicy policy = get_retry_policy();
+    
+    for (size_t attempt = 1; attempt <= policy.max_attempts; ++attempt) {
+        result.attempts_made = static_cast<int>(attempt);
+        
+        auto op = co_await operation();
+        
+        if (op.is_success()) {
+            result.success = true;
+            co_return result;
+        }
+        
+        result.last_error = op.error().message;
+        result.attempt_errors.push_back(op.error().message);
+        
+        if (attempt < policy.max_attempts) {
+            int delay = calculate_retry_delay(policy, static_cast<int>(attempt));
+            if (deadline_within(delay)) {
+                result.deadline_exceeded = true;
+                break;
+            }
+            result.total_delay_ms += delay;
+            co_await executor->sleep_for(std::chrono::milliseconds(delay));
+        }
+    }
+    
+    result.success = false;
+    co_return result;
+}
+
+Task<RetryableResult> TMSSystem::retry_operation_async(std::function<OperationResult()> operation) {
+    return retry_operation_async(std::function<Task<OperationResult>()>(
+        [operation = std::move(operation)]() -> Task<OperationResult> { co_return operation(); }));
+}
 
 } // namespace tms
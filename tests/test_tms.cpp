@@ -8,6 +8,9 @@
  */
 
 #include "tms_tape_mgmt.h"
+#include "tms_rpc.h"
+#include "tms_replication.h"
+#include "tms_partition.h"
 #include "logger.h"
 #include "configuration.h"
 #include <iostream>
@@ -68,6 +71,31 @@ void test_statistics_aggregation();
 void test_parallel_batch();
 void test_error_recovery();
 
+// Forward declarations for v3.4.0 tests
+void test_json_streaming();
+void test_json_compact_value();
+void test_csv_bulk_import();
+void test_export_engine();
+void test_timestamp_codec();
+void test_streaming_reports();
+void test_report_cache();
+void test_snapshot_sharing();
+void test_time_travel();
+void test_config_snapshots();
+void test_workload_replay();
+void test_simulated_clock();
+void test_change_stream();
+void test_string_interning();
+void test_hot_volume_table();
+void test_move_aware_api();
+void test_lock_free_reads();
+void test_memory_arenas();
+void test_rpc_daemon();
+void test_async_api();
+void test_operation_context();
+void test_replication();
+void test_partitioned_catalog();
+
 void test_validation() {
     TEST_SECTION("Validation Tests");
     
@@ -704,6 +732,31 @@ int main() {
     test_parallel_batch();
     test_error_recovery();
     
+    // v3.4.0 Feature Tests
+    test_json_streaming();
+    test_json_compact_value();
+    test_csv_bulk_import();
+    test_export_engine();
+    test_timestamp_codec();
+    test_streaming_reports();
+    test_report_cache();
+    test_snapshot_sharing();
+    test_time_travel();
+    test_config_snapshots();
+    test_workload_replay();
+    test_simulated_clock();
+    test_change_stream();
+    test_string_interning();
+    test_hot_volume_table();
+    test_move_aware_api();
+    test_lock_free_reads();
+    test_memory_arenas();
+    test_rpc_daemon();
+    test_async_api();
+    test_operation_context();
+    test_replication();
+    test_partitioned_catalog();
+    
     auto end = std::chrono::steady_clock::now();
     auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
     
@@ -1786,3 +1839,2468 @@ void test_error_recovery() {
     
     cleanup("test_retry");
 }
+
+// ============================================================================
+// v3.4.0 Feature Tests
+// ============================================================================
+
+void test_json_streaming() {
+    TEST_SECTION("Streaming JSON Tests");
+    
+    // Writer output is valid JSON for the DOM parser
+    std::ostringstream oss;
+    {
+        JsonWriter w(oss);
+        w.begin_object();
+        w.field("name", "A\"B\n");
+        w.field("count", 42);
+        w.field("big", 18000000000000000000ULL);
+        w.field("ratio", 0.25);
+        w.field("flag", true);
+        w.key("list").begin_array().value(1).value("x").null_value().end_array();
+        w.key("empty").begin_object().end_object();
+        w.end_object();
+    }
+    JsonValue dom = JsonSerializer::parse(oss.str());
+    TEST(dom["name"].as_string() == "A\"B\n", "Writer escapes strings");
+    TEST(dom["count"].as_int() == 42, "Writer integer value");
+    TEST(oss.str().find("18000000000000000000") != std::string::npos, "Writer exact uint64");
+    TEST(dom["ratio"].as_number() == 0.25, "Writer double value");
+    TEST(dom["list"].size() == 3 && dom["list"][2].is_null(), "Writer nested array");
+    
+    // Pull parser tokens
+    JsonReader r(std::string_view(R"({"k": [1, -2.5e1, "s\u00e9"], "t": false})"));
+    TEST(r.next() == JsonToken::BeginObject, "Reader begin object");
+    TEST(r.next() == JsonToken::Key && r.string_value() == "k", "Reader key token");
+    TEST(r.next() == JsonToken::BeginArray, "Reader begin array");
+    TEST(r.next() == JsonToken::Number && r.int_value() == 1, "Reader integer via from_chars");
+    TEST(r.next() == JsonToken::Number && r.number_value() == -25.0, "Reader exponent number");
+    TEST(r.next() == JsonToken::String && r.string_value() == "s\xc3\xa9", "Reader decodes \\u escape");
+    TEST(r.next() == JsonToken::EndArray, "Reader end array");
+    TEST(r.next() == JsonToken::Key && r.next() == JsonToken::Boolean && !r.bool_value(),
+         "Reader boolean value");
+    TEST(r.next() == JsonToken::EndObject && r.next() == JsonToken::EndOfInput, "Reader end of input");
+    
+    bool threw = false;
+    try {
+        JsonReader bad(std::string_view("[1,]"));
+        while (bad.next() != JsonToken::EndOfInput) {}
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    TEST(threw, "Reader rejects trailing comma");
+    
+    for (const char* malformed : {"[1-2]", "[1.2.3]"}) {
+        threw = false;
+        try {
+            JsonReader bad(std::string_view{malformed});
+            while (bad.next() != JsonToken::EndOfInput) {
+                if (bad.token() == JsonToken::Number) (void)bad.number_value();
+            }
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        TEST(threw, std::string("Reader rejects partial number ") + malformed);
+    }
+    auto integer_rejected = [](const char* json, bool as_unsigned) {
+        try {
+            JsonReader bad(std::string_view{json});
+            bad.next();
+            bad.next();
+            if (as_unsigned) (void)bad.uint_value(); else (void)bad.int_value();
+        } catch (const std::runtime_error&) {
+            return true;
+        }
+        return false;
+    };
+    TEST(integer_rejected("[1e300]", false) && integer_rejected("[1e25]", true) &&
+         integer_rejected("[-1]", true) && integer_rejected("[2.5]", false), "Reader rejects unrepresentable integers");
+    {
+        JsonReader ok(std::string_view("[1e3, 4.0]"));
+        ok.next();
+        TEST(ok.next() == JsonToken::Number && ok.int_value() == 1000 && ok.next() == JsonToken::Number &&
+             ok.uint_value() == 4, "Reader accepts integral exponent forms");
+    }
+    {
+        std::ostringstream big;
+        JsonWriter w(big);
+        w.begin_array().value(1e300).value(-1e300).end_array();
+        w.flush();
+        TEST(JsonSerializer::parse(big.str())[0].as_number() == 1e300, "Writer handles out-of-range double");
+    }
+    
+    // Volume round trip through a small stream window
+    TapeVolume vol;
+    vol.volser = "STRM01";
+    vol.pool = "POOL_A";
+    vol.owner = "ADMIN";
+    vol.capacity_bytes = 400ULL * 1024 * 1024 * 1024;
+    vol.tags = {"alpha", "beta"};
+    vol.notes = "long note with \"quotes\" that spans several refills";
+    std::stringstream vs;
+    {
+        JsonWriter w(vs);
+        TmsJsonConverter::write_volume(w, vol);
+    }
+    JsonReader vr(vs, 7);
+    TapeVolume back = TmsJsonConverter::read_volume(vr);
+    TEST(back.volser == "STRM01" && back.pool == "POOL_A", "Streamed volume round trip");
+    TEST(back.capacity_bytes == vol.capacity_bytes, "Streamed capacity preserved");
+    TEST(back.tags.size() == 2 && back.notes == vol.notes, "Streamed tags and notes preserved");
+    
+    // Catalog export/import through TMSSystem
+    cleanup("test_json_stream");
+    cleanup("test_json_stream2");
+    std::string path = "test_json_stream_catalog.json";
+    {
+        TMSSystem sys("test_json_stream");
+        for (int i = 0; i < 20; i++) {
+            TapeVolume v;
+            v.volser = "JS" + std::to_string(1000 + i);
+            v.status = VolumeStatus::SCRATCH;
+            v.pool = "POOL_J";
+            sys.add_volume(v);
+        }
+        Dataset ds;
+        ds.name = "JSON.STREAM.DS";
+        ds.volser = "JS1000";
+        ds.size_bytes = 1024;
+        sys.add_dataset(ds);
+        TEST(sys.export_to_json(path).is_success(), "Streaming catalog export");
+    }
+    JsonValue exported = JsonSerializer::parse_file(path);
+    TEST(exported["volumes"].size() == 20, "Exported catalog parses with DOM parser");
+    {
+        TMSSystem sys2("test_json_stream2");
+        auto imported = sys2.import_from_json(path);
+        TEST(imported.is_success() && imported.value().succeeded == 21, "Streaming catalog import");
+        auto v = sys2.get_volume("JS1000");
+        TEST(v.is_success() && v.value().datasets.size() == 1 && v.value().used_bytes == 1024,
+             "Imported dataset relinked to volume");
+    }
+    std::remove(path.c_str());
+    cleanup("test_json_stream");
+    cleanup("test_json_stream2");
+}
+
+void test_json_compact_value() {
+    TEST_SECTION("Compact JsonValue Tests");
+    
+    TEST(sizeof(JsonValue) <= 24, "JsonValue is at most 24 bytes");
+    
+    JsonValue small("SCRATCH");
+    JsonValue large(std::string(100, 'x'));
+    TEST(small.as_string() == "SCRATCH", "Inline small string");
+    TEST(large.as_string().size() == 100, "Heap long string");
+    
+    JsonValue moved(std::move(large));
+    TEST(moved.as_string().size() == 100 && large.is_null(), "Move steals payload");
+    
+    JsonValue copy(moved);
+    TEST(copy.as_string() == moved.as_string(), "Copy is deep");
+    
+    // Flat object keeps key order and map-style assignment
+    JsonObject obj;
+    obj["zeta"] = 1;
+    obj["alpha"] = 2;
+    obj["mid"] = 3;
+    obj["alpha"] = 4;
+    TEST(obj.size() == 3 && obj.begin()->first == "alpha", "Object sorted by key");
+    TEST(obj.find("alpha")->second.as_int() == 4, "Object assignment replaces value");
+    TEST(obj.count("missing") == 0, "Object count for missing key");
+    
+    JsonValue auto_obj;
+    auto_obj["k"] = "v";
+    TEST(auto_obj.is_object() && auto_obj["k"].as_string() == "v", "Null promotes to object on write");
+    
+    // Duplicate keys in input: last one wins
+    JsonValue dup = JsonSerializer::parse(R"({"a": 1, "b": 2, "a": 3})");
+    TEST(dup.size() == 2 && dup["a"].as_int() == 3, "Parser keeps last duplicate key");
+    
+    // Arena-backed document
+    std::vector<TapeVolume> vols;
+    for (int i = 0; i < 50; i++) {
+        TapeVolume v;
+        v.volser = "AR" + std::to_string(1000 + i);
+        v.notes = "Arena allocated volume notes field " + std::to_string(i);
+        vols.push_back(v);
+    }
+    std::string text = JsonSerializer::serialize(TmsJsonConverter::catalog_to_json(vols, {}));
+    JsonDocument doc;
+    doc.parse(text);
+    TEST(doc.root()["volumes"].size() == 50, "Document parses catalog");
+    TEST(doc.root().in_arena() && doc.memory_used() > 0, "Document nodes use arena");
+    TEST(doc.root()["volumes"][10]["volser"].as_string() == "AR1010", "Arena value lookup");
+    
+    JsonValue detached = doc.root()["volumes"][0];
+    TEST(!detached.in_arena() && detached["volser"].as_string() == "AR1000",
+         "Copy out of document is heap owned");
+}
+
+void test_csv_bulk_import() {
+    TEST_SECTION("CSV Bulk Import Tests");
+    cleanup("test_bulk");
+    fs::create_directories("test_bulk");
+    
+    // RFC 4180 parsing: quoted delimiters, doubled quotes, embedded newline
+    std::vector<std::string> fields = CsvParser::split("a,\"b,c\",\"say \"\"hi\"\"\",\"x\ny\",");
+    TEST(fields.size() == 5, "Parser field count");
+    TEST(fields[1] == "b,c" && fields[2] == "say \"hi\"", "Parser unescapes quoted fields");
+    TEST(fields[3] == "x\ny" && fields[4].empty(), "Parser keeps embedded newline");
+    TEST(CsvParser::escape("a\"b") == "\"a\"\"b\"" && CsvParser::escape("ab") == "ab",
+         "Escape quotes only when needed");
+    
+    {
+        std::ofstream out("test_bulk/volumes.csv", std::ios::binary);
+        out << "Volser,Status,Density,Location,Pool,Owner,Mount_Count\r\n";
+        out << "BLK001,PRIVATE,LTO-8,\"Rack 1, \"\"A\"\"\nShelf 2\",POOLA,OPS,5\r\n";
+        out << "BLK002,SCRATCH,LTO-9,Vault,POOLB,OPS,0\r\n";
+        out << "\r\n";
+        out << "BAD-VOL,SCRATCH,LTO-9,Vault,POOLB,OPS,0\r\n";
+        out << "BLK003,\"PRI\"VATE,LTO-9,Vault,POOLB,OPS,0\r\n";
+        out << "BLK004,SCRATCH,LTO-42,Vault,POOLB,OPS,0\r\n";
+        out << "BLK001,SCRATCH,LTO-9,Vault,POOLB,OPS,0\r\n";
+        out << "BLK005,SCRATCH,LTO-9,Vault,POOLB,OPS,7";
+    }
+    
+    TMSSystem sys("test_bulk");
+    auto report = sys.bulk_import_volumes_csv("test_bulk/volumes.csv");
+    TEST(report.is_success(), "Bulk volume import runs");
+    const auto& r = report.value();
+    TEST(r.rows == 7 && r.imported == 3 && r.failed == 4, "Bulk import row counts");
+    TEST(r.errors.size() == 4 && r.errors[0].row == 5 && r.errors[0].key == "BAD-VOL",
+         "Invalid volser reported with row number");
+    TEST(r.errors[1].row == 6 && r.errors[1].message.find("Malformed") != std::string::npos,
+         "Malformed row reported");
+    TEST(r.errors[2].row == 7 && r.errors[3].row == 8 &&
+         r.errors[3].message.find("already exists") != std::string::npos,
+         "Validation and duplicate failures in row order");
+    
+    auto vol = sys.get_volume("BLK001");
+    TEST(vol.is_success() && vol.value().location == "Rack 1, \"A\"\nShelf 2", "Quoted field imported");
+    TEST(vol.value().density == TapeDensity::DENSITY_LTO8 && vol.value().mount_count == 5,
+         "Typed columns imported");
+    TEST(sys.get_volume("BLK005").value().mount_count == 7, "Unterminated last row imported");
+    
+    // Many small blocks across several workers commit in input order
+    {
+        std::ofstream out("test_bulk/many.csv");
+        out << "Volser,Pool,Owner\n";
+        for (int i = 0; i < 2000; i++) {
+            out << "M" << std::setw(5) << std::setfill('0') << i << ",\"P,"
+                << (i % 4) << "\",OWNER" << (i % 3) << "\n";
+        }
+        out << "M00010,POOL,OWNER\n";
+    }
+    CsvImportOptions options;
+    options.threads = 4;
+    options.block_size = 256;
+    options.max_in_flight = 3;
+    auto many = sys.bulk_import_volumes_csv("test_bulk/many.csv", options);
+    TEST(many.is_success() && many.value().imported == 2000, "Multithreaded import commits all rows");
+    TEST(many.value().failed == 1 && many.value().errors[0].row == 2002,
+         "Row numbers stable across blocks");
+    TEST(sys.get_volume("M01999").value().pool == "P,3", "Quoted pool across blocks");
+    
+    // Datasets link to imported volumes in a single batch
+    {
+        std::ofstream out("test_bulk/datasets.csv");
+        out << "Name,Volser,Status,Size,Owner,JobName,FileSeq\n";
+        out << "BULK.DS.ONE,BLK002,ACTIVE,4096,OPS,JOB1,1\n";
+        out << "BULK.DS.TWO,NOVOL,ACTIVE,1,OPS,JOB1,1\n";
+        out << "BULK.DS.THREE,BLK002,ACTIVE,abc,OPS,JOB1,1\n";
+    }
+    auto ds_report = sys.import_datasets_from_csv("test_bulk/datasets.csv");
+    TEST(ds_report.is_success() && ds_report.value().succeeded == 1 && ds_report.value().failed == 2,
+         "Legacy dataset import uses pipeline");
+    TEST(ds_report.value().failures[0].second.rfind("Row 3: Volume not found", 0) == 0,
+         "Legacy failures carry row number");
+    auto linked = sys.get_volume("BLK002");
+    TEST(linked.value().status == VolumeStatus::PRIVATE && linked.value().used_bytes == 4096,
+         "Bulk dataset add links volume");
+    
+    // Export -> import round trip
+    TEST(sys.export_to_csv("test_bulk/out_vol.csv", "test_bulk/out_ds.csv").is_success(),
+         "Export for round trip");
+    TMSSystem copy("test_bulk/copy");
+    auto vol_back = copy.import_volumes_from_csv("test_bulk/out_vol.csv");
+    auto ds_back = copy.import_datasets_from_csv("test_bulk/out_ds.csv");
+    TEST(vol_back.is_success() && vol_back.value().all_succeeded() &&
+         vol_back.value().succeeded == sys.get_statistics().total_volumes, "Round trip volumes");
+    TEST(ds_back.is_success() && ds_back.value().succeeded == 1, "Round trip datasets");
+    TEST(copy.get_volume("BLK001").value().location == "Rack 1, \"A\"\nShelf 2", "Round trip quoted field");
+    TEST(copy.get_volume("BLK002").value().used_bytes == 4096, "Round trip used bytes relinked");
+    
+    auto missing = sys.bulk_import_volumes_csv("test_bulk/none.csv");
+    TEST(!missing.is_success(), "Missing file reported");
+    
+    cleanup("test_bulk");
+}
+
+void test_export_engine() {
+    TEST_SECTION("Export Engine Tests");
+    cleanup("test_export");
+    TMSSystem sys("test_export");
+    
+    auto base = std::chrono::system_clock::now();
+    for (int i = 0; i < 500; i++) {
+        TapeVolume v;
+        v.volser = "EX" + std::to_string(1000 + i);
+        v.pool = (i % 2 == 0) ? "EVEN" : "ODD";
+        v.owner = "OPS";
+        v.location = (i == 7) ? "Rack \"7\", top" : "Vault";
+        v.mount_count = i;
+        v.creation_date = base - std::chrono::hours(24 * i + i);
+        sys.add_volume(v);
+    }
+    
+    // CSV subset with filter pushdown, formatted by several workers
+    ExportOptions csv;
+    csv.columns = {"volser", "mount_count", "Location", "created"};
+    csv.threads = 4;
+    csv.partition_records = 16;
+    csv.max_in_flight = 3;
+    auto report = sys.export_volumes("test_export/even.csv", csv,
+                                     [](const TapeVolume& v) { return v.pool == "EVEN"; });
+    TEST(report.is_success() && report.value().records == 250, "Filtered CSV export");
+    TEST(report.value().partitions == 16 && report.value().bytes > 0, "Export report partitions and bytes");
+    {
+        std::ifstream in("test_export/even.csv");
+        std::string line;
+        std::getline(in, line);
+        TEST(line == "Volser,MountCount,Location,Created", "Selected columns in header");
+        std::getline(in, line);
+        auto first = sys.get_volume("EX1000").value();
+        TEST(line == "EX1000,0,Vault," + format_time(first.creation_date), "First CSV row");
+        size_t rows = 1;
+        bool ordered = true;
+        std::string prev = "EX1000";
+        while (std::getline(in, line)) {
+            rows++;
+            std::string volser = line.substr(0, line.find(','));
+            ordered = ordered && volser > prev;
+            prev = volser;
+        }
+        TEST(rows == 250 && ordered, "Partitions written in order");
+    }
+    
+    // JSON Lines
+    ExportOptions jsonl;
+    jsonl.format = ExportFormat::JSON_LINES;
+    jsonl.threads = 2;
+    jsonl.partition_records = 50;
+    auto jreport = sys.export_volumes("test_export/volumes.jsonl", jsonl);
+    TEST(jreport.is_success() && jreport.value().records == 500, "JSON Lines export");
+    {
+        std::ifstream in("test_export/volumes.jsonl");
+        std::string line;
+        size_t lines = 0;
+        bool parsed = true;
+        while (std::getline(in, line)) {
+            JsonValue v = JsonSerializer::parse(line);
+            if (lines == 7) {
+                parsed = parsed && v["location"].as_string() == "Rack \"7\", top" &&
+                         v["mount_count"].as_int() == 7 && v["write_protected"].is_bool();
+            }
+            lines++;
+        }
+        TEST(lines == 500 && parsed, "JSON Lines records parse");
+    }
+    
+    // Binary round trip
+    ExportOptions bin;
+    bin.format = ExportFormat::BINARY;
+    bin.columns = {"volser", "location", "capacity_bytes", "created", "write_protected"};
+    auto breport = sys.export_volumes("test_export/volumes.bin", bin);
+    TEST(breport.is_success(), "Binary export");
+    {
+        std::ifstream in("test_export/volumes.bin", std::ios::binary);
+        BinaryExportReader reader(in);
+        TEST(reader.columns().size() == 5 && reader.columns()[3].type == ExportColumnType::TIMESTAMP,
+             "Binary header columns");
+        std::vector<ExportField> fields;
+        size_t n = 0;
+        bool match = true;
+        while (reader.next(fields)) {
+            if (n == 7) {
+                auto vol = sys.get_volume("EX1007").value();
+                match = fields[0].text == "EX1007" && fields[1].text == vol.location &&
+                        fields[2].uinteger == vol.capacity_bytes &&
+                        std::chrono::system_clock::to_time_t(fields[3].time) ==
+                            std::chrono::system_clock::to_time_t(vol.creation_date);
+            }
+            n++;
+        }
+        TEST(n == 500 && reader.record_count() == 500 && match, "Binary records round trip");
+    }
+    
+    // Legacy CSV export keeps its columns
+    TEST(sys.export_to_csv("test_export/v.csv", "test_export/d.csv").is_success(), "Legacy CSV export");
+    {
+        std::ifstream in("test_export/v.csv");
+        std::string line;
+        std::getline(in, line);
+        TEST(line == "Volser,Status,Density,Location,Pool,Owner,MountCount,Capacity,Used,Created,Expires",
+             "Legacy CSV header");
+    }
+    
+    ExportOptions bad;
+    bad.columns = {"no_such_column"};
+    auto bad_report = sys.export_datasets("test_export/bad.csv", bad);
+    TEST(!bad_report.is_success() && bad_report.error().code == TMSError::INVALID_PARAMETER,
+         "Unknown column rejected");
+    
+    cleanup("test_export");
+}
+
+void test_timestamp_codec() {
+    TEST_SECTION("Timestamp Codec Tests");
+    
+    // Calendar arithmetic
+    bool civil_ok = true;
+    for (int64_t d = -800000; d <= 800000 && civil_ok; d += 997) {
+        int64_t y;
+        unsigned m, day;
+        TimestampCodec::civil_from_days(d, y, m, day);
+        civil_ok = TimestampCodec::days_from_civil(y, m, day) == d;
+    }
+    TEST(civil_ok, "Civil date round trip");
+    TEST(TimestampCodec::days_from_civil(2000, 3, 1) == 11017, "Known day number");
+    
+    // Epoch encoding
+    auto now = std::chrono::system_clock::now();
+    auto secs = TimestampCodec::to_epoch(now);
+    TEST(TimestampCodec::to_epoch(TimestampCodec::from_epoch(secs)) == secs, "Epoch round trip");
+    
+    // Matches the C library and round-trips through text, across DST changes
+    auto check_zone = [&]() {
+        bool format_ok = true, parse_ok = true;
+        for (int h = 0; h < 24 * 800 && format_ok && parse_ok; h += 5) {
+            auto tp = TimestampCodec::from_epoch(secs - int64_t(h) * 3600 - h % 61);
+            std::time_t t = std::chrono::system_clock::to_time_t(tp);
+            std::tm tm{};
+#if defined(_WIN32)
+            localtime_s(&tm, &t);
+#else
+            localtime_r(&t, &tm);
+#endif
+            char expected[32];
+            std::strftime(expected, sizeof(expected), "%Y-%m-%d %H:%M:%S", &tm);
+            std::string text = format_time(tp);
+            format_ok = text == expected;
+            parse_ok = format_time(parse_time(text)) == text;
+        }
+        return format_ok && parse_ok;
+    };
+    TEST(check_zone(), "Codec matches localtime");
+    
+#if !defined(_WIN32)
+    std::string saved_tz = std::getenv("TZ") ? std::getenv("TZ") : "";
+    bool had_tz = std::getenv("TZ") != nullptr;
+    setenv("TZ", "America/New_York", 1);
+    tzset();
+    TimestampCodec::reset_cache();
+    TEST(check_zone(), "Codec matches localtime with DST");
+    auto summer = parse_time("2025-07-01 12:00:00");
+    TEST(format_time(summer) == "2025-07-01 12:00:00", "Summer time parses to same wall clock");
+    if (had_tz) setenv("TZ", saved_tz.c_str(), 1); else unsetenv("TZ");
+    tzset();
+    TimestampCodec::reset_cache();
+#endif
+    
+    // Parsing edge cases
+    TEST(parse_time("not a time") == std::chrono::system_clock::time_point{}, "Malformed text rejected");
+    TEST(parse_time("") == std::chrono::system_clock::time_point{}, "Empty text rejected");
+    TEST(format_time(parse_time("2024-02-29 23:59:59")) == "2024-02-29 23:59:59", "Leap day parses");
+    TEST(format_time(parse_time("2024-3-5 7:08:09")) == "2024-03-05 07:08:09", "Non-padded fields fall back");
+    std::chrono::system_clock::time_point unchanged{};
+    TEST(!TimestampCodec::parse("2024-13-01 00:00:00", unchanged) &&
+         unchanged == std::chrono::system_clock::time_point{}, "Invalid month rejected");
+}
+
+void test_streaming_reports() {
+    TEST_SECTION("Streaming Report Tests");
+    cleanup("test_stream_rpt");
+    TMSSystem sys("test_stream_rpt");
+    
+    for (int i = 0; i < 2500; i++) {
+        TapeVolume v;
+        v.volser = "SR" + std::to_string(1000 + i);
+        v.pool = (i % 5 == 0) ? "FIVE" : "OTHER";
+        v.owner = (i % 2 == 0) ? "EVEN" : "ODD";
+        v.location = (i == 3) ? "Bay <3>, \"A\"" : "Vault";
+        sys.add_volume(v);
+    }
+    
+    // Cursor walks the whole catalog in key order across batches
+    auto cursor = sys.volume_cursor(100);
+    size_t seen = 0;
+    bool ordered = true;
+    std::string prev;
+    while (const TapeVolume* v = cursor.next()) {
+        ordered = ordered && v->volser > prev;
+        prev = v->volser;
+        seen++;
+    }
+    TEST(seen == 2500 && ordered && cursor.next() == nullptr, "Cursor visits every volume in order");
+    
+    // Bounded chunks through a callback sink (socket/pipe stand-in)
+    size_t chunks = 0, largest = 0, bytes = 0;
+    std::string streamed;
+    CallbackReportSink callback([&](std::string_view data) {
+        chunks++;
+        largest = std::max(largest, data.size());
+        bytes += data.size();
+        streamed.append(data);
+        return true;
+    });
+    ReportOptions all;
+    size_t rows = sys.write_volume_report(callback, ReportFormat::CSV, all);
+    TEST(rows == 2500 && chunks > 1, "Report streamed in several chunks");
+    TEST(largest < ReportTableWriter::FLUSH_BYTES + 1024, "Chunks bounded by flush threshold");
+    TEST(streamed.find("\"Bay <3>, \"\"A\"\"\"") != std::string::npos, "CSV cells escaped");
+    
+    // String-returning API produces the same output as the streaming path
+    std::vector<TapeVolume> volumes = sys.list_volumes();
+    ReportGenerator gen;
+    TEST(gen.generate_volume_report(volumes, ReportFormat::CSV) == streamed, "Vector report matches streamed report");
+    
+    // Filters apply to every format
+    ReportOptions filtered;
+    filtered.filter_pool = "FIVE";
+    filtered.filter_owner = "EVEN";
+    filtered.include_timestamp = false;
+    StringReportSink md;
+    TEST(sys.write_volume_report(md, ReportFormat::MARKDOWN, filtered) == 250, "Filters applied to Markdown");
+    TEST(md.str().find("**Total:** 250 volumes") != std::string::npos, "Markdown summary");
+    filtered.max_rows = 10;
+    TEST(gen.write_volume_report(md, ReportGenerator::cursor_over(volumes), ReportFormat::TEXT, filtered) == 10,
+         "max_rows limits streamed rows");
+    
+    // Paginated HTML in one document, linked by anchors
+    ReportOptions paged;
+    paged.page_rows = 1000;
+    StringReportSink html;
+    sys.write_volume_report(html, ReportFormat::HTML, paged);
+    TEST(html.str().find("id=\"page-3\"") != std::string::npos &&
+         html.str().find("id=\"page-4\"") == std::string::npos, "HTML split into pages");
+    TEST(html.str().find("href=\"#page-2\">Next") != std::string::npos, "Anchor navigation");
+    
+    // Paginated HTML across files
+    {
+        FileReportPager pager("test_stream_rpt/volumes.html");
+        TEST(sys.write_volume_report(pager, ReportFormat::HTML, paged) == 2500, "Paged report rows");
+        TEST(pager.page_count() == 3, "Three page files");
+        TEST(pager.page_path(2) == "test_stream_rpt/volumes_2.html", "Page file naming");
+    }
+    {
+        std::ifstream in("test_stream_rpt/volumes_2.html");
+        std::string page((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        TEST(page.find("href=\"volumes.html\">&laquo; Previous") != std::string::npos &&
+             page.find("href=\"volumes_3.html\">Next") != std::string::npos, "File page navigation");
+        TEST(page.find("</html>") != std::string::npos, "Each page is a complete document");
+    }
+    
+    // A failing sink stops the report early
+    size_t calls = 0;
+    CallbackReportSink broken([&](std::string_view) { return ++calls < 2; });
+    sys.write_volume_report(broken, ReportFormat::CSV, all);
+    TEST(!broken.good() && calls == 2, "Write failure stops streaming");
+    
+    // Dataset report over the dataset cursor
+    for (int i = 0; i < 20; i++) {
+        Dataset ds;
+        ds.name = "SR.DS" + std::to_string(100 + i);
+        ds.volser = "SR1000";
+        ds.owner = "EVEN";
+        sys.add_dataset(ds);
+    }
+    StringReportSink ds_text;
+    TEST(sys.write_dataset_report(ds_text, ReportFormat::TEXT) == 20, "Dataset report streamed");
+    TEST(ds_text.str().find("Total: 20 datasets") != std::string::npos, "Dataset summary");
+    
+    cleanup("test_stream_rpt");
+}
+
+void test_report_cache() {
+    TEST_SECTION("Materialized Report Tests");
+    cleanup("test_rpt_cache");
+    TMSSystem sys("test_rpt_cache");
+    
+    for (int i = 0; i < 300; i++) {
+        TapeVolume v;
+        v.volser = "RC" + std::to_string(1000 + i);
+        v.pool = "POOL" + std::to_string(i % 3);
+        v.capacity_bytes = 1000000;
+        v.used_bytes = static_cast<uint64_t>(i) * 1000;
+        sys.add_volume(v);
+    }
+    
+    // One-pass pool statistics match the per-pool query
+    auto pools = sys.get_all_pool_statistics();
+    TEST(pools.size() == 3, "Statistics for every pool");
+    auto single = sys.get_pool_statistics("POOL1");
+    TEST(pools[1].pool_name == "POOL1" && pools[1].total_volumes == single.total_volumes &&
+         pools[1].used_capacity == single.used_capacity, "One-pass pool statistics");
+    
+    // Repeated requests are served from cache
+    auto first = sys.get_cached_report(ReportType::POOL_SUMMARY, ReportFormat::CSV);
+    auto second = sys.get_cached_report(ReportType::POOL_SUMMARY, ReportFormat::CSV);
+    TEST(first.is_success() && first.value() == second.value(), "Cached pool report");
+    TEST(first.value().find("POOL2,100,100") != std::string::npos, "Pool report rows");
+    auto stats = sys.get_report_cache_stats();
+    TEST(stats.hits == 1 && stats.misses == 1 && stats.entries == 1, "Second request is a hit");
+    
+    // Different format or options is a different entry
+    ReportOptions only_pool0;
+    only_pool0.filter_pool = "POOL0";
+    auto filtered = sys.get_cached_report(ReportType::POOL_SUMMARY, ReportFormat::CSV, only_pool0);
+    TEST(filtered.value().find("POOL1") == std::string::npos, "Options are part of the key");
+    TEST(sys.get_report_cache_stats().entries == 2, "Separate entry per options");
+    
+    // Any catalog write invalidates
+    uint64_t generation = sys.catalog_generation();
+    sys.scratch_volume("RC1001");
+    sys.mount_volume("RC1004");
+    TEST(sys.catalog_generation() > generation, "Writes advance the catalog generation");
+    generation = sys.catalog_generation();
+    Quota quota;
+    quota.max_volumes = 1000;
+    sys.set_pool_quota("POOL0", quota);
+    sys.set_retry_policy(sys.get_retry_policy());
+    TEST(sys.catalog_generation() == generation, "Quota and policy changes keep cached reports");
+    auto refreshed = sys.get_cached_report(ReportType::POOL_SUMMARY, ReportFormat::CSV);
+    TEST(refreshed.value() != first.value(), "Report rebuilt after change");
+    TEST(refreshed.value().find("POOL1,100,99") != std::string::npos, "Rebuilt report reflects change");
+    
+    // Capacity report lists the fullest volumes first
+    auto capacity = sys.get_cached_report(ReportType::CAPACITY_REPORT, ReportFormat::CSV);
+    std::string cap = capacity.value();
+    TEST(cap.find("RC1299") < cap.find("RC1000"), "Capacity report sorted by utilization");
+    
+    // Expiration and health reports
+    TapeVolume soon;
+    soon.volser = "RCEXP1";
+    soon.expiration_date = std::chrono::system_clock::now() + std::chrono::hours(48);
+    sys.add_volume(soon);
+    auto expiring = sys.get_cached_report(ReportType::EXPIRATION_REPORT, ReportFormat::TEXT);
+    TEST(expiring.value().find("RCEXP1") != std::string::npos &&
+         expiring.value().find("EXPIRING") != std::string::npos, "Expiration report");
+    TEST(sys.get_cached_report(ReportType::HEALTH_REPORT, ReportFormat::HTML).value().find("<html>") !=
+         std::string::npos, "Health report cached");
+    TEST(!sys.get_cached_report(ReportType::AUDIT_REPORT, ReportFormat::TEXT).is_success(),
+         "Unsupported report type rejected");
+    
+    // Legacy stream reports share the cache
+    std::ostringstream a, b;
+    sys.generate_pool_report(a);
+    size_t hits = sys.get_report_cache_stats().hits;
+    sys.generate_pool_report(b);
+    TEST(a.str() == b.str() && sys.get_report_cache_stats().hits == hits + 1, "Stream pool report cached");
+    TEST(a.str().find("Pool: POOL2") != std::string::npos, "Stream pool report content");
+    
+    // Reports print when they were generated, so even a quiet catalog's expire
+    sys.set_report_cache_max_age(std::chrono::seconds(1));
+    sys.get_cached_report(ReportType::VOLUME_SUMMARY, ReportFormat::TEXT);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    size_t expired = sys.get_report_cache_stats().expired;
+    sys.get_cached_report(ReportType::VOLUME_SUMMARY, ReportFormat::TEXT);
+    TEST(sys.get_report_cache_stats().expired == expired + 1, "Summary report expires with its timestamp");
+    
+    sys.clear_report_cache();
+    TEST(sys.get_report_cache_stats().entries == 0, "Cache cleared");
+    
+    cleanup("test_rpt_cache");
+}
+
+void test_snapshot_sharing() {
+    TEST_SECTION("Snapshot Sharing Tests");
+    
+    TapeVolume vol;
+    vol.volser = "COW001";
+    vol.notes = "Long-lived volume notes that exceed the small string buffer";
+    vol.tags = {"prod", "offsite"};
+    for (int i = 0; i < 200; i++) vol.datasets.push_back("COW.DATASET.NUMBER." + std::to_string(i));
+    
+    SnapshotManager mgr(24);
+    auto first = mgr.create_snapshot(vol, "OPER", "hour 0");
+    TEST(first.id == 1 && first.snapshot_id == "SNAP-COW001-1", "Integer snapshot IDs");
+    TEST(SnapshotManager::parse_snapshot_id(first.snapshot_id) == 1, "Snapshot ID round trip");
+    
+    // Unchanged components are shared between consecutive snapshots
+    for (int h = 1; h < 10; h++) mgr.create_snapshot(vol, "OPER", "hour " + std::to_string(h));
+    auto stats = mgr.memory_stats();
+    TEST(stats.snapshots == 10 && stats.shared_components == 3, "Unchanged components shared");
+    TEST(stats.total_bytes * 5 < stats.unshared_bytes, "Sharing saves memory");
+    TEST(mgr.memory_usage(first.id) * 5 < stats.unshared_bytes / 10, "Per-snapshot usage amortized");
+    
+    // A change allocates only the changed component
+    vol.tags.insert("audit");
+    auto changed = mgr.create_snapshot(vol, "OPER", "tagged");
+    TEST(mgr.memory_stats().shared_components == 4, "Only changed component copied");
+    TEST(changed.tags_at_snapshot.count("audit") == 1 && changed.datasets_at_snapshot.size() == 200,
+         "Snapshot materialized on read");
+    TEST(mgr.get_snapshot(first.snapshot_id)->tags_at_snapshot.count("audit") == 0,
+         "Older snapshot unaffected");
+    
+    // Ring buffer keeps the newest snapshots in order
+    for (int h = 0; h < 30; h++) mgr.create_snapshot(vol, "OPER", "wrap " + std::to_string(h));
+    auto history = mgr.get_volume_snapshots("COW001");
+    TEST(history.size() == 24 && mgr.count() == 24, "Ring capacity enforced");
+    TEST(history.front().description == "wrap 6" && history.back().description == "wrap 29",
+         "Oldest first after wrap");
+    TEST(!mgr.get_snapshot(first.snapshot_id).has_value(), "Evicted snapshot gone");
+    
+    // Delete from the middle keeps the order
+    TEST(mgr.delete_snapshot(history[5].snapshot_id), "Delete by string ID");
+    TEST(!mgr.delete_snapshot("SNAP-OTHER-" + std::to_string(history[6].id)), "Volser must match ID");
+    history = mgr.get_volume_snapshots("COW001");
+    TEST(history.size() == 23 && history[5].description == "wrap 12", "Order kept after delete");
+    mgr.create_snapshot(vol, "OPER", "after delete");
+    TEST(mgr.get_volume_snapshots("COW001").back().description == "after delete", "Append after delete");
+}
+
+void test_time_travel() {
+    TEST_SECTION("Catalog Time Travel Tests");
+    cleanup("test_time_travel");
+    TMSSystem sys("test_time_travel");
+    auto tick = [] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        return std::chrono::system_clock::now();
+    };
+    
+    TEST(!sys.get_volume("TT0001", std::chrono::system_clock::now()).is_success(),
+         "as_of reads need retention");
+    sys.set_history_retention(std::chrono::hours(1));
+    auto t0 = tick();
+    
+    for (int i = 0; i < 3; i++) {
+        TapeVolume v;
+        v.volser = "TT000" + std::to_string(i);
+        v.pool = "GOLD";
+        v.owner = "OPER";
+        sys.add_volume(v);
+    }
+    auto t1 = tick();
+    
+    // Change one volume, delete another, add a third after t1
+    auto live = sys.get_volume("TT0000").value();
+    live.pool = "SILVER";
+    live.status = VolumeStatus::PRIVATE;
+    sys.update_volume(live);
+    sys.delete_volume("TT0001", true);
+    TapeVolume late;
+    late.volser = "TT0009";
+    late.pool = "GOLD";
+    sys.add_volume(late);
+    
+    auto past = sys.get_volume("TT0000", t1);
+    TEST(past.is_success() && past.value().pool == "GOLD" &&
+         past.value().status == VolumeStatus::SCRATCH, "Old version as of t1");
+    TEST(sys.get_volume("TT0000").value().pool == "SILVER", "Current read unchanged");
+    TEST(sys.get_volume("TT0001", t1).is_success(), "Deleted volume visible in the past");
+    TEST(!sys.get_volume("TT0009", t1).is_success(), "Later volume absent in the past");
+    TEST(!sys.get_volume("TT0002", t0).is_success(), "Volume absent before it was added");
+    
+    auto listed = sys.list_volumes(t1, std::nullopt);
+    TEST(listed.is_success() && listed.value().size() == 3, "List as of t1");
+    TEST(listed.value()[1].volser == "TT0001", "Listing stays key ordered");
+    TEST(sys.list_volumes().size() == 3, "Current list unaffected");
+    
+    SearchCriteria criteria;
+    criteria.pool = "GOLD";
+    auto gold = sys.search_volumes(criteria, t1);
+    TEST(gold.is_success() && gold.value().size() == 3, "Search as of t1");
+    TEST(sys.search_volumes(criteria).size() == 2, "Current search unaffected");
+    
+    // Bulk insert records one version per volume touched
+    auto before = sys.get_history_stats().versions;
+    std::vector<Dataset> batch;
+    for (int i = 0; i < 20; i++) {
+        Dataset ds;
+        ds.name = "TT.BULK.DS" + std::to_string(i);
+        ds.volser = "TT0002";
+        batch.push_back(ds);
+    }
+    TEST(sys.bulk_add_datasets(batch).succeeded == 20, "Bulk add datasets");
+    TEST(sys.get_history_stats().versions == before + 21, "One version per record written");
+    auto t2 = tick();
+    TEST(sys.list_datasets(t1, std::nullopt).value().empty(), "No datasets as of t1");
+    TEST(sys.list_datasets(t2, std::nullopt).value().size() == 20, "Datasets as of t2");
+    
+    // Compaction drops versions that fell out of the horizon
+    sys.set_history_retention(std::chrono::seconds(1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    sys.compact_history();  // The background compactor may already have run
+    TEST(sys.get_history_stats().compacted > 0, "Expired versions compacted");
+    TEST(!sys.get_volume("TT0000", t1).is_success(), "as_of outside retention rejected");
+    
+    sys.set_history_retention(std::chrono::seconds(0));
+    TEST(sys.get_history_stats().versions == 0, "Disabling drops history");
+    
+    cleanup("test_time_travel");
+}
+
+void test_config_snapshots() {
+    TEST_SECTION("Configuration Snapshot Tests");
+    auto& config = Configuration::instance();
+    
+    auto before = config.snapshot();
+    TEST(before->max_volumes == config.get_max_volumes(), "Typed value precomputed");
+    
+    // Callbacks run after publication and may read the configuration
+    std::string seen;
+    size_t seen_max = 0;
+    config.register_callback("General.max_volumes", [&](const std::string& key, const std::string& value) {
+        seen = key + "=" + value;
+        seen_max = Configuration::instance().get_max_volumes();
+    });
+    config.set_int("General", "max_volumes", 1234);
+    TEST(seen == "General.max_volumes=1234" && seen_max == 1234, "Callback sees published snapshot");
+    TEST(config.get_max_volumes() == 1234 && config.get_size("General", "max_volumes") == 1234,
+         "Readers see new value");
+    TEST(before->max_volumes == 100000 && before->generation < config.snapshot()->generation,
+         "Held snapshot unchanged");
+    
+    // Reload publishes a new snapshot from the file
+    cleanup("test_config_snap");
+    fs::create_directories("test_config_snap");
+    {
+        std::ofstream ini("test_config_snap/tms.ini");
+        ini << "[General]\nmax_volumes = 4321\n[Performance]\nbatch_size = 7\n";
+    }
+    TEST(config.load_from_file("test_config_snap/tms.ini"), "Load from file");
+    TEST(config.get_max_volumes() == 4321 && config.get_batch_size() == 7, "Loaded values published");
+    TEST(seen == "General.max_volumes=4321", "Load notifies changed keys");
+    config.set_int("Performance", "batch_size", 50);
+    TEST(config.reload() && config.get_batch_size() == 7, "Reload restores file values");
+    
+    // Readers running alongside a writer only ever see whole values
+    std::atomic<bool> stop{false};
+    std::atomic<int> torn{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; t++) {
+        readers.emplace_back([&] {
+            while (!stop.load()) {
+                size_t v = config.get_max_volumes();
+                if (v != 1000 && v != 2000 && v != 4321) torn++;
+            }
+        });
+    }
+    for (int i = 0; i < 200; i++) config.set_int("General", "max_volumes", i % 2 ? 1000 : 2000);
+    stop = true;
+    for (auto& r : readers) r.join();
+    TEST(torn.load() == 0, "Concurrent reads consistent");
+    
+    config.unregister_callbacks("General.max_volumes");
+    config.set_defaults();
+    TEST(config.get_max_volumes() == 100000 && config.get_batch_size() == 100, "Defaults restored");
+    cleanup("test_config_snap");
+}
+
+void test_workload_replay() {
+    TEST_SECTION("Workload Capture and Replay Tests");
+    cleanup("test_capture");
+    cleanup("test_replay");
+    fs::create_directories("test_capture");
+    std::string capture = "test_capture/workload.jsonl";
+    
+    {
+        TMSSystem sys("test_capture/catalog");
+        TapeVolume base;
+        base.volser = "WL0000";
+        base.pool = "BASE";
+        sys.add_volume(base);
+        
+        TEST(sys.start_workload_capture(capture).is_success(), "Start capture");
+        TEST(fs::exists(capture + ".base/volumes.dat"), "Baseline catalog saved");
+        for (int i = 1; i <= 20; i++) {
+            TapeVolume v;
+            v.volser = "WL" + std::to_string(1000 + i);
+            v.pool = "REPLAY";
+            v.tags = {"captured"};
+            sys.add_volume(v);
+            sys.get_volume(v.volser);
+        }
+        Dataset single;
+        single.name = "WL.SINGLE";
+        single.volser = "WL1020";
+        sys.add_dataset(single);
+        sys.add_volume_tag("WL1001", "hot");
+        sys.mount_volume("WL1002");
+        sys.reserve_volume("WL1003", "OPER", std::chrono::seconds(600));
+        sys.update_volume_location("WL1004", "VAULT");
+        sys.delete_volume("WL1005", true);
+        SearchCriteria criteria;
+        criteria.pool = "REPLAY";
+        sys.search_volumes(criteria);
+        sys.rename_pool("REPLAY", "RENAMED");
+        std::vector<TapeVolume> bulk(3);
+        for (int i = 0; i < 3; i++) bulk[i].volser = "WL" + std::to_string(2001 + i);
+        sys.bulk_add_volumes(bulk);
+        std::vector<Dataset> files(6);
+        for (int i = 0; i < 6; i++) {
+            files[i].name = "WL.BULK.D" + std::to_string(i);
+            files[i].volser = "WL" + std::to_string(2001 + i % 3);
+        }
+        sys.bulk_add_datasets(files);
+        sys.add_dataset_tag("WL.BULK.D0", "keep");
+        sys.migrate_dataset("WL.BULK.D1");
+        sys.clone_volume("WL2001", "WL2004");
+        EncryptionMetadata enc;
+        enc.encrypted = true;
+        enc.algorithm = EncryptionAlgorithm::AES_256;
+        enc.key_id = "KEY-7";
+        sys.set_volume_encryption("WL2002", enc);
+        sys.set_volume_tier("WL2003", StorageTier::COLD);
+        sys.create_volume_snapshot("WL1007");  // No replay mapping
+        sys.stop_workload_capture();
+        sys.add_volume_tag("WL1006", "after");  // Not captured
+    }
+    
+    auto loaded = WorkloadReader::load(capture);
+    TEST(loaded.is_success() && loaded.value().size() == 56, "Capture holds every operation");
+    const auto& events = loaded.value();
+    TEST(events[0].operation == "ADD_VOLUME" && events[0].volume && events[0].volume->has_tag("captured"),
+         "Adds carry the record");
+    TEST(events[1].operation == "GET_VOLUME" && events[1].offset_us >= events[0].offset_us, "Reads captured in order");
+    auto reserve = std::find_if(events.begin(), events.end(),
+                                [](const WorkloadEvent& e) { return e.operation == "RESERVE_VOLUME"; });
+    TEST(reserve != events.end() && reserve->arg("user") == "OPER" && reserve->arg("duration") == "600",
+         "Arguments recovered from audit details");
+    
+    // Replay from the baseline on four threads
+    fs::create_directories("test_replay");
+    fs::copy_file(capture + ".base/volumes.dat", "test_replay/volumes.dat");
+    fs::copy_file(capture + ".base/datasets.dat", "test_replay/datasets.dat");
+    {
+        TMSSystem sys("test_replay");
+        ReplayOptions options;
+        options.threads = 4;
+        auto report = sys.replay_workload(events, options);
+        TEST(report.replayed == 55 && report.skipped == 1 && report.failed == 0, "Replay counts");
+        TEST(report.operations["ADD_VOLUME"].latency.count() == 20, "Per-operation histogram");
+        TEST(report.operations["GET_VOLUME"].latency.percentile(99) > 0, "Latency percentiles");
+        TEST(report.lock.acquisitions >= 25, "Lock acquisitions counted");
+        TEST(sys.get_volume("WL0000").is_success() && !sys.get_volume("WL1005").is_success(),
+             "Replay reproduces the catalog");
+        TEST(sys.get_volume("WL1001").value().has_tag("hot") &&
+             sys.get_volume("WL1004").value().location == "VAULT", "Arguments replayed");
+        TEST(sys.get_volume("WL2003").value().datasets.size() == 2 && sys.dataset_exists("WL.SINGLE") &&
+             sys.get_dataset("WL.BULK.D0").value().tags.count("keep") == 1 &&
+             sys.get_dataset("WL.BULK.D1").value().status == DatasetStatus::MIGRATED,
+             "Bulk adds and dataset tags replayed");
+        TEST(sys.get_volume("WL2004").is_success() && sys.get_volume("WL1002").value().pool == "RENAMED",
+             "Clone and pool rename replayed");
+        TEST(sys.get_volume_encryption("WL2002").key_id == "KEY-7" &&
+             sys.get_volume_tier("WL2003") == StorageTier::COLD, "Encryption and tier replayed");
+        
+        std::ostringstream json;
+        report.write_json(json);
+        TEST(JsonSerializer::parse(json.str())["operations"]["MOUNT_VOLUME"]["count"].as_int() == 1,
+             "Report as JSON");
+    }
+    
+    // Accelerated pacing keeps the captured spacing, scaled down
+    std::vector<WorkloadEvent> paced(2);
+    paced[0].operation = paced[1].operation = "GET_VOLUME";
+    paced[0].target = paced[1].target = "WL0000";
+    paced[1].offset_us = 40000;
+    {
+        TMSSystem sys("test_replay");
+        ReplayOptions options;
+        options.pacing = ReplayPacing::ACCELERATED;
+        options.speed = 2.0;
+        auto report = sys.replay_workload(paced, options);
+        TEST(report.seconds >= 0.019, "Accelerated replay paced");
+    }
+    
+    LatencyHistogram h;
+    for (uint64_t ns = 1; ns <= 1000; ns++) h.record(ns);
+    TEST(h.count() == 1000 && h.max() == 1000, "Histogram totals");
+    TEST(h.percentile(50) >= 500 && h.percentile(50) <= 640, "Histogram percentile bound");
+    
+    cleanup("test_capture");
+    cleanup("test_replay");
+}
+
+void test_simulated_clock() {
+    TEST_SECTION("Simulated Clock Tests");
+    cleanup("test_clock");
+    using hours = std::chrono::hours;
+    const auto day = hours(24);
+    
+    auto start = std::chrono::system_clock::from_time_t(1700000000);
+    SimulatedClock clock(start);
+    {
+        ScopedClock scope(clock);
+        TEST(current_time() == start, "Installed clock drives current_time");
+        
+        TMSSystem sys("test_clock");
+        TapeVolume vol;
+        vol.volser = "CLK001";
+        vol.status = VolumeStatus::PRIVATE;
+        vol.expiration_date = start + day * 30;
+        sys.add_volume(vol);
+        sys.reserve_volume("CLK001", "OPER", std::chrono::seconds(3600));
+        TEST(sys.get_volume("CLK001").value().creation_date == start, "Creation date from simulated clock");
+        TEST(sys.get_volume("CLK001").value().is_reserved(), "Reserved at start");
+        
+        clock.advance(hours(2));
+        TEST(!sys.get_volume("CLK001").value().is_reserved(), "Reservation lapses when time advances");
+        TEST(sys.cleanup_expired_reservations() == 1, "Lapsed reservation cleaned up");
+        
+        // Three years of weekly expiration runs over staggered volumes
+        for (int i = 0; i < 50; i++) {
+            TapeVolume v;
+            v.volser = "CLS" + std::to_string(100 + i);
+            v.status = VolumeStatus::PRIVATE;
+            v.expiration_date = clock.now() + day * (20 * (i + 1));
+            sys.add_volume(v);
+        }
+        size_t expired = 0;
+        for (int week = 0; week < 3 * 52 + 1; week++) {
+            clock.advance(day * 7);
+            expired += sys.process_expirations();
+        }
+        TEST(expired == 51, "Multi-year simulation expires every volume");
+        TEST(sys.get_volume("CLS149").value().status == VolumeStatus::EXPIRED, "Last volume expired");
+        TEST(sys.get_volume("CLK001").value().get_age_days() >= 3 * 365, "Age follows simulated time");
+        
+        StatisticsHistory history;
+        history.record_snapshot(SystemStatistics{});
+        clock.advance(day * 10);
+        history.record_snapshot(SystemStatistics{});
+        TEST(history.get_recent_snapshots(5).size() == 1, "History windows use simulated time");
+        
+        BackupInfo backup;
+        backup.timestamp = clock.now();
+        clock.advance(day * 2);
+        TEST(backup.is_expired(day), "Backup age uses simulated time");
+        
+        RetentionPolicy policy;
+        policy.warning_days = 7;
+        TEST(policy.is_in_warning_period(clock.now() + day * 3), "Retention warning uses simulated time");
+        
+        SimulatedClock nested(start);
+        {
+            ScopedClock inner(nested);
+            TEST(current_time() == start, "Scoped clocks nest");
+        }
+        TEST(current_time() == clock.now(), "Outer clock restored");
+    }
+    TEST(get_clock() == nullptr, "System clock restored");
+    auto drift = std::chrono::system_clock::now() - current_time();
+    TEST(drift < std::chrono::seconds(5) && drift > -std::chrono::seconds(5), "System clock in use");
+    
+    // Coarse clock: one atomic load per read, refreshed by the ticker
+    enable_coarse_clock(std::chrono::milliseconds(5));
+    TEST(get_clock() == &coarse_clock() && coarse_clock().running(), "Coarse clock installed");
+    auto first = current_time();
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    TEST(current_time() > first, "Coarse clock advances");
+    drift = std::chrono::system_clock::now() - current_time();
+    TEST(drift >= std::chrono::seconds(0) && drift < std::chrono::seconds(1), "Coarse clock tracks system time");
+    {
+        ScopedClock scope(clock);
+        TEST(current_time() == clock.now(), "Simulated clock overrides coarse clock");
+    }
+    TEST(get_clock() == &coarse_clock(), "Scope restores coarse clock");
+    disable_coarse_clock();
+    TEST(get_clock() == nullptr && !coarse_clock().running(), "Coarse clock disabled");
+    set_clock(&clock);
+    disable_coarse_clock();
+    TEST(get_clock() == &clock, "Disabling leaves another installed clock alone");
+    set_clock(nullptr);
+    
+    cleanup("test_clock");
+}
+
+void test_change_stream() {
+    TEST_SECTION("Change Data Capture Tests");
+    cleanup("test_cdc");
+    
+    ChangeLogOptions options;
+    options.segment_records = 5;
+    options.max_segments = 3;
+    options.flush_interval = std::chrono::milliseconds(1);
+    
+    std::vector<ChangeRecord> received;
+    std::atomic<int> mounted_events{0};
+    auto bus_id = EventBus::instance().subscribe(EventType::VOLUME_MOUNTED,
+        [&](const Event& e) { if (e.data.count("cdc_sequence")) mounted_events++; });
+    
+    uint64_t last_before_restart = 0;
+    {
+        TMSSystem sys("test_cdc");
+        TEST(sys.get_change_stream() == nullptr, "Change stream off by default");
+        TEST(sys.enable_change_stream(options).is_success(), "Enable change stream");
+        auto log = sys.get_change_stream();
+        TEST(log != nullptr && fs::exists("test_cdc/cdc"), "Log in data directory");
+        log->subscribe("monitor", [&](const std::vector<ChangeRecord>& batch) {
+            received.insert(received.end(), batch.begin(), batch.end());
+        });
+        
+        for (int i = 1; i <= 3; i++) {
+            TapeVolume v;
+            v.volser = "CDC00" + std::to_string(i);
+            v.status = VolumeStatus::PRIVATE;
+            sys.add_volume(v);
+        }
+        sys.mount_volume("CDC001");
+        sys.add_volume_tag("CDC002", "hot");
+        Dataset ds;
+        ds.name = "CDC.TEST.DATA";
+        ds.volser = "CDC002";
+        sys.add_dataset(ds);
+        sys.migrate_dataset("CDC.TEST.DATA");
+        sys.delete_volume("CDC003", true);
+        sys.get_volume("CDC001");   // Reads emit nothing
+        log->flush();
+        
+        bool ordered = !received.empty() && received.front().sequence == 1;
+        for (size_t i = 1; i < received.size(); i++) {
+            ordered = ordered && received[i].sequence == received[i - 1].sequence + 1;
+        }
+        TEST(ordered, "Sequence numbers contiguous from 1");
+        TEST(received.size() >= 8, "Every mutation emitted");
+        TEST(received[0].operation == ChangeOperation::INSERT && received[0].event == EventType::VOLUME_ADDED &&
+             received[0].volume && received[0].volume->volser == "CDC001", "Insert carries after image");
+        auto find_event = [&](EventType type) {
+            return std::find_if(received.begin(), received.end(),
+                [type](const ChangeRecord& r) { return r.event == type; }) != received.end();
+        };
+        TEST(find_event(EventType::VOLUME_MOUNTED), "Mount classified");
+        TEST(find_event(EventType::VOLUME_TAGGED), "Tag classified");
+        TEST(find_event(EventType::DATASET_MIGRATED), "Migration classified");
+        TEST(received.back().operation == ChangeOperation::DELETE && !received.back().volume &&
+             received.back().key == "CDC003", "Delete without after image");
+        TEST(mounted_events == 1, "Republished on EventBus");
+        TEST(log->committed_offset("monitor") == received.back().sequence, "Consumer offset committed");
+        
+        std::vector<TapeVolume> bulk;
+        for (int i = 0; i < 20; i++) {
+            TapeVolume v;
+            v.volser = "CDB" + std::to_string(100 + i);
+            bulk.push_back(v);
+        }
+        sys.bulk_add_volumes(bulk);
+        log->flush();
+        auto stats = log->get_stats();
+        TEST(stats.segments <= 3 && stats.first_sequence > 1, "Log bounded to max segments");
+        TEST(stats.batches < stats.written, "Changes written in batches");
+        last_before_restart = stats.last_sequence;
+        
+        auto tail = log->read(stats.last_sequence - 2);
+        TEST(tail.size() == 3 && tail.back().sequence == stats.last_sequence, "Read from offset");
+        
+        // Alternating volume/dataset touches still yield one record per entity
+        received.clear();
+        std::vector<Dataset> files;
+        for (int i = 0; i < 4; i++) {
+            Dataset d;
+            d.name = "CDC.BULK.D" + std::to_string(i);
+            d.volser = "CDB100";
+            files.push_back(d);
+        }
+        sys.bulk_add_datasets(files);
+        log->flush();
+        auto volume_records = std::count_if(received.begin(), received.end(),
+            [](const ChangeRecord& r) { return r.key == "CDB100"; });
+        TEST(volume_records == 1 && received.size() == 5, "Bulk write emits one record per entity");
+        last_before_restart = log->last_sequence();
+    }
+    
+    // Torn final write: repaired on open instead of being appended onto
+    {
+        std::string newest;
+        for (const auto& entry : fs::directory_iterator("test_cdc/cdc")) {
+            std::string name = entry.path().filename().string();
+            if (name.rfind("changes-", 0) == 0 && entry.path().string() > newest) newest = entry.path().string();
+        }
+        std::ofstream torn(newest, std::ios::app);
+        torn << "{\"seq\": " << last_before_restart + 1 << ", \"ts\"";
+    }
+    
+    // Restart: numbering continues and named consumers resume
+    received.clear();
+    {
+        TMSSystem sys("test_cdc");
+        sys.enable_change_stream(options);
+        auto log = sys.get_change_stream();
+        TEST(log->get_stats().last_sequence == last_before_restart, "Sequence survives restart");
+        log->subscribe("monitor", [&](const std::vector<ChangeRecord>& batch) {
+            received.insert(received.end(), batch.begin(), batch.end());
+        });
+        std::vector<ChangeRecord> replayed;
+        auto first = log->get_stats().first_sequence;
+        log->subscribe("", [&](const std::vector<ChangeRecord>& batch) {
+            replayed.insert(replayed.end(), batch.begin(), batch.end());
+        }, first);
+        
+        sys.update_volume_location("CDC002", "VAULT");
+        log->flush();
+        TEST(received.size() == 1 && received[0].sequence == last_before_restart + 1,
+             "Consumer resumes after committed offset");
+        auto after_torn = log->read(last_before_restart + 1);
+        TEST(after_torn.size() == 1 && after_torn[0].key == "CDC002", "Append after torn write is readable");
+        TEST(!replayed.empty() && replayed.front().sequence == first &&
+             replayed.back().sequence == last_before_restart + 1, "Subscriber catches up from retained log");
+        
+        sys.disable_change_stream();
+        TEST(sys.get_change_stream() == nullptr, "Change stream disabled");
+    }
+    
+    EventBus::instance().unsubscribe(bus_id);
+    cleanup("test_cdc");
+
+    // A subscriber resuming before the oldest retained change is told so
+    cleanup("test_cdc_gap");
+    {
+        TMSSystem sys("test_cdc_gap");
+        ChangeLogOptions small = options;
+        small.segment_records = 3;
+        small.max_segments = 2;
+        sys.enable_change_stream(small);
+        auto log = sys.get_change_stream();
+        for (int i = 0; i < 10; i++) {
+            TapeVolume v;
+            v.volser = "GAP00" + std::to_string(i);
+            sys.add_volume(v);
+        }
+        log->flush();
+        uint64_t first = log->get_stats().first_sequence;
+        std::vector<ChangeRecord> resumed;
+        log->subscribe("", [&](const std::vector<ChangeRecord>& batch) {
+            resumed.insert(resumed.end(), batch.begin(), batch.end());
+        }, 1);
+        sys.mount_volume("GAP000");
+        log->flush();
+        TEST(first == 7 && resumed.size() == 6 && resumed[0].operation == ChangeOperation::RESYNC &&
+             resumed[0].entity == ChangeEntity::CATALOG && resumed[0].sequence == first - 1 &&
+             resumed[1].sequence == first && resumed.back().sequence == 11, "Lost changes reported as a resync marker");
+
+        // A write left by an exception publishes nothing; the lock is released
+        std::vector<TapeVolume> bulk(2);
+        bulk[0].volser = "GAPX01";
+        bulk[1].volser = "bad volser";
+        bool thrown = false;
+        try {
+            sys.bulk_add_volumes(bulk, [](size_t, const std::string&) { throw std::runtime_error("stop"); });
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        TapeVolume after;
+        after.volser = "GAPX02";
+        sys.add_volume(after);
+        log->flush();
+        auto tail = log->read(12);
+        TEST(thrown && tail.size() == 1 && tail[0].key == "GAPX02", "Unwound write not streamed");
+    }
+    cleanup("test_cdc_gap");
+}
+
+void test_string_interning() {
+    TEST_SECTION("String Interning Tests");
+    cleanup("test_intern");
+    
+    Symbol a("POOL-INTERN"), b(std::string("POOL-INTERN")), c("POOL-OTHER");
+    TEST(a == b && a.id() == b.id() && a.c_str() == b.c_str(), "Equal text shares one entry");
+    TEST(a != c && a.id() != c.id(), "Distinct text gets distinct ids");
+    TEST(Symbol().id() == 0 && Symbol("").empty(), "Empty string is symbol 0");
+    TEST(a == "POOL-INTERN" && a < c && a.str() + "!" == "POOL-INTERN!", "Compares with strings by text");
+    
+    size_t interned = SymbolTable::instance().size();
+    TEST(!Symbol::lookup("INTERN-NEVER-SEEN") && SymbolTable::instance().size() == interned,
+         "Lookup does not intern");
+    TEST(Symbol::lookup("POOL-INTERN") == a, "Lookup finds interned text");
+    
+    TagSet tags{"B-TAG", "A-TAG"};
+    TEST(tags.begin()->str() == "A-TAG", "Tag set ordered by text");
+    TEST(tags.count(std::string_view("B-TAG")) == 1 && tags.count(std::string_view("C-TAG-PROBE")) == 0 &&
+         !Symbol::lookup("C-TAG-PROBE"), "Tag probe without interning");
+    
+    std::vector<std::thread> threads;
+    std::vector<std::vector<uint32_t>> ids(4);
+    for (size_t t = 0; t < ids.size(); t++) {
+        threads.emplace_back([&ids, t] {
+            for (int i = 0; i < 200; i++) ids[t].push_back(Symbol("CONCURRENT-" + std::to_string(i)).id());
+        });
+    }
+    for (auto& th : threads) th.join();
+    bool consistent = true;
+    for (const auto& v : ids) consistent = consistent && v == ids[0];
+    TEST(consistent, "Concurrent interning agrees on ids");
+    
+    {
+        TMSSystem sys("test_intern");
+        TapeVolume vol;
+        vol.volser = "SYM001";
+        vol.owner = "INTERN-OWNER";
+        vol.pool = "INTERN-POOL";
+        vol.location = "INTERN-SLOT";
+        vol.media_type = "LTO-9";
+        sys.add_volume(vol);
+        sys.add_volume_tag("SYM001", "INTERN-TAG");
+        
+        SearchCriteria criteria;
+        criteria.owner = "INTERN-OWNER";
+        criteria.tag = "INTERN-TAG";
+        TEST(sys.search_volumes(criteria).size() == 1, "Search matches interned filters");
+        criteria.owner = "INTERN-NOBODY";
+        TEST(sys.search_volumes(criteria).empty() && !Symbol::lookup("INTERN-NOBODY"),
+             "Unknown filter value matches nothing");
+        TEST(sys.get_volumes_by_pool("INTERN-POOL").size() == 1, "Secondary index keyed by symbol");
+        sys.save_catalog();
+    }
+    {
+        TMSSystem sys("test_intern");
+        auto vol = sys.get_volume("SYM001");
+        TEST(vol.is_success() && vol.value().owner == Symbol("INTERN-OWNER") &&
+             vol.value().pool == "INTERN-POOL" && vol.value().location == "INTERN-SLOT",
+             "Symbol fields survive save and load");
+    }
+    
+    cleanup("test_intern");
+}
+
+void test_hot_volume_table() {
+    TEST_SECTION("Hot Volume Table Tests");
+    cleanup("test_hot");
+    
+    TEST(sizeof(VolumeHotRecord) <= 72, "Hot record is compact");
+    
+    TMSSystem sys("test_hot");
+    std::vector<TapeVolume> volumes;
+    for (int i = 0; i < 10; i++) {
+        TapeVolume v;
+        v.volser = "HOT" + std::to_string(100 + i);
+        v.pool = i < 6 ? "HOTPOOL" : "COLDPOOL";
+        v.notes = "note " + std::to_string(i);
+        volumes.push_back(v);
+    }
+    sys.bulk_add_volumes(volumes);
+    
+    auto stats = sys.get_statistics();
+    TEST(stats.scratch_volumes == 10 && stats.pool_counts["HOTPOOL"] == 6, "Statistics from hot rows");
+    auto table = sys.get_volume_table_stats();
+    TEST(table.rows == 10 && table.rebuilds == 1, "Bulk add costs one rebuild");
+    
+    auto allocated = sys.allocate_scratch_volume("COLDPOOL");
+    TEST(allocated.is_success() && allocated.value() == "HOT106", "Allocation scans in volser order");
+    auto cold = sys.get_scratch_pool_stats("COLDPOOL");
+    TEST(cold.first == 3 && cold.second == 4, "Allocation refreshes the row");
+    
+    auto vol = sys.get_volume("HOT101").value();
+    vol.status = VolumeStatus::EXPIRED;
+    sys.update_volume(vol);
+    auto expired = sys.list_expired_volumes();
+    TEST(expired.size() == 1 && expired[0] == "HOT101", "Update visible to scans");
+    TEST(sys.get_volume_table_stats().rebuilds == 1, "Updates refresh rows in place");
+    
+    auto private_vols = sys.list_volumes(VolumeStatus::PRIVATE);
+    TEST(private_vols.size() == 1 && private_vols[0].notes == "note 6", "Scan materializes full records");
+    
+    sys.delete_volume("HOT102");
+    stats = sys.get_statistics();
+    TEST(stats.total_volumes == 9 && stats.scratch_volumes == 7 && stats.pool_counts["HOTPOOL"] == 5,
+         "Delete visible to scans");
+    TEST(sys.get_volume_table_stats().rebuilds == 2, "Delete rebuilds on next scan");
+    
+    sys.save_catalog();
+    sys.load_catalog();
+    auto pools = sys.get_all_pool_statistics();
+    TEST(pools.size() == 2 && pools[0].pool_name == "COLDPOOL" && pools[0].private_volumes == 1 &&
+         pools[1].total_volumes == 5, "Reload rebuilds hot rows");
+    
+    cleanup("test_hot");
+}
+
+void test_move_aware_api() {
+    TEST_SECTION("Move-Aware API Tests");
+    cleanup("test_move_api");
+    
+    TMSSystem sys("test_move_api");
+    TapeVolume vol;
+    vol.volser = "MOV001";
+    vol.pool = "MOVEPOOL";
+    vol.notes = "keep me";
+    vol.tags = {"OLDTAG"};
+    TEST(sys.add_volume(std::move(vol)).is_success(), "Add volume by move");
+    
+    Dataset ds;
+    ds.name = "MOVE.DATA.SET";
+    ds.volser = "MOV001";
+    ds.owner = "MOVER";
+    TEST(sys.add_dataset(std::move(ds)).is_success(), "Add dataset by move");
+    
+    std::string seen;
+    TEST(sys.read_volume("MOV001", [&](const TapeVolume& v) { seen = v.notes + "/" + v.pool.str(); }) &&
+         seen == "keep me/MOVEPOOL", "Visitor reads stored volume");
+    TEST(!sys.read_volume("NOPE01", [](const TapeVolume&) {}), "Visitor reports missing volume");
+    
+    VolumePatch patch;
+    patch.pool = "PATCHPOOL";
+    patch.status = VolumeStatus::ARCHIVED;
+    patch.add_tags = {"NEWTAG"};
+    patch.remove_tags = {"OLDTAG", "ABSENT"};
+    TEST(sys.patch_volume("MOV001", patch).is_success(), "Patch volume");
+    auto patched = sys.get_volume("MOV001").value();
+    TEST(patched.pool == "PATCHPOOL" && patched.status == VolumeStatus::ARCHIVED &&
+         patched.notes == "keep me" && patched.has_tag("NEWTAG") && !patched.has_tag("OLDTAG"),
+         "Patch changes only the set fields");
+    TEST(sys.get_volumes_by_pool("PATCHPOOL").size() == 1 && sys.get_volumes_by_pool("MOVEPOOL").empty() &&
+         sys.find_volumes_by_tag("NEWTAG").size() == 1 && sys.find_volumes_by_tag("OLDTAG").empty(),
+         "Patch maintains indexes");
+    auto audit = sys.get_audit_log(1);
+    TEST(!audit.empty() && audit.back().operation == "UPDATE_VOLUME" &&
+         audit.back().details == "Patched: status,pool,tags", "Patch audited as update");
+    
+    auto missing = sys.patch_volume("NOPE01", patch);
+    TEST(!missing.is_success() && missing.error().code == TMSError::VOLUME_NOT_FOUND, "Patch missing volume fails");
+    
+    DatasetPatch ds_patch;
+    ds_patch.owner = "NEWOWNER";
+    ds_patch.job_name = "JOB42";
+    TEST(sys.patch_dataset("MOVE.DATA.SET", ds_patch).is_success(), "Patch dataset");
+    TEST(sys.get_datasets_by_owner("NEWOWNER").size() == 1 && sys.get_datasets_by_owner("MOVER").empty() &&
+         sys.read_dataset("MOVE.DATA.SET", [&](const Dataset& d) { seen = d.job_name.str(); }) && seen == "JOB42",
+         "Dataset patch maintains owner index");
+    
+    auto copy = sys.get_volume("MOV001").value();
+    copy.notes = "replaced";
+    TEST(sys.update_volume(std::move(copy)).is_success() && sys.get_volume("MOV001").value().notes == "replaced",
+         "Update volume by move");
+    
+    cleanup("test_move_api");
+}
+
+void test_lock_free_reads() {
+    TEST_SECTION("Lock-Free Read Tests");
+    cleanup("test_rcu");
+    
+    TMSSystem sys("test_rcu");
+    TapeVolume vol;
+    vol.volser = "RCU001";
+    vol.notes = "v0";
+    sys.add_volume(vol);
+    Dataset ds;
+    ds.name = "RCU.DATA.SET";
+    ds.volser = "RCU001";
+    sys.add_dataset(ds);
+    
+    TEST(!sys.lock_free_reads_enabled(), "Lock-free reads off by default");
+    sys.enable_lock_free_reads();
+    TEST(sys.lock_free_reads_enabled(), "Lock-free reads enabled");
+    TEST(sys.volume_exists("RCU001") && sys.get_volume("RCU001").value().notes == "v0" &&
+         sys.dataset_exists("RCU.DATA.SET"), "Existing records published on enable");
+    TEST(!sys.volume_exists("NOPE01") && !sys.get_volume("NOPE01").is_success() &&
+         sys.get_volume("NOPE01").error().code == TMSError::VOLUME_NOT_FOUND, "Missing volume not found");
+    
+    VolumePatch patch;
+    patch.notes = "v1";
+    sys.patch_volume("RCU001", patch);
+    TEST(sys.get_volume("RCU001").value().notes == "v1", "Write visible to the writing thread");
+    sys.recalculate_volume_health("RCU001");
+    TEST(sys.get_volume_health("RCU001").overall_score == sys.get_volume("RCU001").value().health_score.overall_score,
+         "Health served from published record");
+    
+    TapeVolume added;
+    added.volser = "RCU002";
+    sys.add_volume(added);
+    TEST(sys.volume_exists("RCU002"), "Added volume published");
+    sys.delete_volume("RCU002");
+    TEST(!sys.volume_exists("RCU002") && !sys.read_volume("RCU002", [](const TapeVolume&) {}),
+         "Deleted volume withdrawn");
+    DatasetPatch ds_patch;
+    ds_patch.job_name = "RCUJOB";
+    sys.patch_dataset("RCU.DATA.SET", ds_patch);
+    std::string job;
+    TEST(sys.read_dataset("RCU.DATA.SET", [&](const Dataset& d) { job = d.job_name.str(); }) && job == "RCUJOB",
+         "Dataset write published");
+    
+    // Enough volumes to force the published table to grow
+    for (int i = 0; i < 300; i++) {
+        TapeVolume v;
+        v.volser = std::to_string(100000 + i);
+        sys.add_volume(std::move(v));
+    }
+    bool all_found = true;
+    for (int i = 0; i < 300; i++) all_found = all_found && sys.volume_exists(std::to_string(100000 + i));
+    TEST(all_found && sys.volume_exists("RCU001"), "Lookups survive table growth");
+    
+    // Readers never see a torn or missing record while a writer churns it
+    patch.notes = "startv";
+    sys.patch_volume("RCU001", patch);
+    std::atomic<bool> stop{false};
+    std::atomic<int> bad{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 3; t++) {
+        readers.emplace_back([&] {
+            while (!stop.load()) {
+                bool ok = sys.read_volume("RCU001", [&](const TapeVolume& v) {
+                    if (v.notes.empty() || v.notes.back() != 'v') bad++;
+                });
+                if (!ok) bad++;
+            }
+        });
+    }
+    for (int i = 0; i < 500; i++) {
+        patch.notes = std::to_string(i) + "v";
+        sys.patch_volume("RCU001", patch);
+    }
+    stop = true;
+    for (auto& r : readers) r.join();
+    TEST(bad.load() == 0, "Concurrent readers see whole records");
+    EpochDomain::instance().reclaim();
+    TEST(EpochDomain::instance().stats().reclaimed > 0, "Replaced records reclaimed");
+    
+    sys.disable_lock_free_reads();
+    TEST(!sys.lock_free_reads_enabled() && sys.get_volume("RCU001").value().notes == "499v",
+         "Locked path after disable");
+    
+    cleanup("test_rcu");
+}
+
+void test_memory_arenas() {
+    TEST_SECTION("Memory Arena Tests");
+    cleanup("test_arena");
+    
+    auto scratch_count = [](ArenaKind kind) {
+        return get_scratch_arena_stats()[static_cast<size_t>(kind)].arenas;
+    };
+    
+    {
+        TMSSystem sys("test_arena");
+        for (int i = 0; i < 200; i++) {
+            TapeVolume v;
+            v.volser = std::to_string(200000 + i);
+            v.pool = (i % 4 == 0) ? "ARENA_A" : "ARENA_B";
+            v.mount_count = i;
+            sys.add_volume(std::move(v));
+        }
+        Dataset ds;
+        ds.name = "ARENA.DATA.SET";
+        ds.volser = "200000";
+        sys.add_dataset(ds);
+        
+        auto stats = sys.get_arena_stats();
+        TEST(stats.size() == 1 + static_cast<size_t>(ArenaKind::COUNT) && stats[0].name == "catalog",
+             "Catalog arena listed first");
+        TEST(stats[0].allocations >= 201 && stats[0].upstream_allocations < stats[0].allocations,
+             "Catalog nodes served from pooled blocks");
+        TEST(stats[0].bytes_in_use > 0, "Catalog arena holds its blocks");
+        
+        QueryEngine engine;
+        auto get_volumes = [&]() { return sys.list_volumes(); };
+        auto queries_before = scratch_count(ArenaKind::QUERY);
+        TEST(engine.query_volumes("pool:eq:arena_a", get_volumes).size() == 50, "Equals query unchanged");
+        TEST(engine.query_volumes("pool:contains:ENA_B", get_volumes).size() == 150, "Contains query unchanged");
+        TEST(engine.query_volumes(QueryBuilder().field(QueryField::VOLUME_MOUNT_COUNT).greater_than("189").build(),
+                                  get_volumes).size() == 10, "Numeric query unchanged");
+        TEST(engine.query_volumes(QueryBuilder().field(QueryField::VOLSER).matches("^2001[0-9]{2}$").build(),
+                                  get_volumes).size() == 100, "Regex query unchanged");
+        TEST(scratch_count(ArenaKind::QUERY) == queries_before + 4, "One query arena per query");
+        
+        auto checks_before = scratch_count(ArenaKind::INTEGRITY);
+        IntegrityChecker checker;
+        auto result = checker.check_integrity([&]() { return sys.list_volumes(); },
+                                              [&]() { return sys.list_datasets(); });
+        TEST(result.passed && result.volumes_checked == 200 && result.datasets_checked == 1,
+             "Integrity check through arena indexes");
+        TEST(scratch_count(ArenaKind::INTEGRITY) == checks_before + 1, "Integrity arena used");
+        sys.save_catalog();
+    }
+    
+    auto loads_before = scratch_count(ArenaKind::LOAD);
+    TMSSystem reloaded("test_arena");
+    TEST(scratch_count(ArenaKind::LOAD) > loads_before, "Load arena used");
+    TEST(reloaded.get_volume("200007").value().mount_count == 7 &&
+         reloaded.get_volume("200008").value().pool == "ARENA_A", "Records survive arena-parsed reload");
+    TEST(reloaded.dataset_exists("ARENA.DATA.SET"), "Dataset survives reload");
+    
+    cleanup("test_arena");
+}
+
+void test_rpc_daemon() {
+    TEST_SECTION("RPC Daemon Tests");
+    
+    // Codec round trip, independent of sockets
+    TapeVolume vol;
+    vol.volser = "RPC001";
+    vol.status = VolumeStatus::PRIVATE;
+    vol.pool = "RPCPOOL";
+    vol.owner = "RPCUSER";
+    vol.capacity_bytes = 400ULL * 1024 * 1024 * 1024;
+    vol.expiration_date = parse_time("2031-06-01 12:00:00") + std::chrono::microseconds(250);
+    vol.tags.emplace("rpc");
+    vol.notes = "wire";
+    RpcWriter writer;
+    RpcCodec::write_volume(writer, vol);
+    RpcReader reader(writer.data());
+    TapeVolume decoded = RpcCodec::read_volume(reader);
+    TEST(reader.ok() && reader.at_end() && decoded.volser == "RPC001" && decoded.pool == "RPCPOOL" &&
+         decoded.has_tag("rpc") && decoded.expiration_date == vol.expiration_date, "Volume codec round trip");
+    RpcReader truncated(std::string_view(writer.data()).substr(0, writer.size() - 3));
+    RpcCodec::read_volume(truncated);
+    TEST(!truncated.ok(), "Truncated record rejected");
+    std::string bad_status = writer.data();
+    bad_status[4 + vol.volser.size()] = 99;
+    RpcReader out_of_range(bad_status);
+    RpcCodec::read_volume(out_of_range);
+    RpcWriter criteria_writer;
+    RpcCodec::write_criteria(criteria_writer, SearchCriteria{});
+    std::string bad_mode = criteria_writer.data();
+    bad_mode[4] = 42;
+    RpcReader bad_criteria(bad_mode);
+    RpcCodec::read_criteria(bad_criteria);
+    TEST(!out_of_range.ok() && !bad_criteria.ok(), "Out-of-range enum bytes rejected");
+    TEST(rpc_frame_size(std::string_view("\x02\x00\x00\x00", 4)) == RPC_BAD_FRAME &&
+         rpc_frame_size(std::string_view("\x08\x00", 2)) == 0, "Frame length validation");
+
+#if TMS_HAS_RPC
+    cleanup("test_rpc");
+    TMSSystem sys("test_rpc");
+    RpcServer server(sys);
+    RpcServerOptions options;
+    options.socket_path = "test_rpc/tms.sock";
+    options.tcp_port = 0;
+    options.workers = 2;
+    TEST(server.start(options).is_success() && server.is_running() && server.tcp_port() > 0, "Server started");
+    RpcServer second(sys);
+    TEST(second.start(options).error_code() == TMSError::INVALID_STATE, "Live socket not taken over");
+    
+    RpcClient client;
+    TEST(client.connect_unix("test_rpc/tms.sock").is_success() && client.ping().is_success(), "Unix socket ping");
+    TEST(client.add_volume(vol).is_success(), "Remote add_volume");
+    TEST(client.volume_exists("RPC001").value_or(false) && !client.volume_exists("NOPE01").value_or(true),
+         "Remote volume_exists");
+    auto fetched = client.get_volume("RPC001");
+    TEST(fetched.is_success() && fetched.value().notes == "wire" && fetched.value().owner == "RPCUSER",
+         "Remote get_volume");
+    auto missing = client.get_volume("NOPE01");
+    TEST(missing.error_code() == TMSError::VOLUME_NOT_FOUND && !missing.error().message.empty(),
+         "Remote error carries code and message");
+    VolumePatch patch;
+    patch.notes = "patched";
+    TEST(client.patch_volume("RPC001", patch).is_success() && sys.get_volume("RPC001").value().notes == "patched",
+         "Remote patch applied to shared catalog");
+    TEST(client.call(RpcOp::GET_VOLUME).value().status == TMSError::INVALID_FORMAT, "Malformed arguments rejected");
+    
+    Dataset ds;
+    ds.name = "RPC.DATA.SET";
+    ds.volser = "RPC001";
+    ds.size_bytes = 4096;
+    TEST(client.add_dataset(ds).is_success() && client.get_dataset("RPC.DATA.SET").value().size_bytes == 4096,
+         "Remote dataset add and get");
+    TEST(client.get_statistics().value().total_datasets == 1, "Remote statistics");
+    
+    // Pipelined requests come back in order
+    std::vector<uint32_t> ids;
+    for (int i = 0; i < 200; i++) {
+        ids.push_back(client.enqueue(RpcOp::VOLUME_EXISTS, [&](RpcWriter& w) {
+            w.put_string(i % 2 == 0 ? "RPC001" : "NOPE01");
+        }));
+    }
+    bool in_order = client.flush().is_success();
+    for (int i = 0; i < 200 && in_order; i++) {
+        auto response = client.receive();
+        in_order = response.is_success() && response.value().id == ids[static_cast<size_t>(i)] &&
+                   response.value().decode<bool>([](RpcReader& r) { return r.get_bool(); }).value() == (i % 2 == 0);
+    }
+    TEST(in_order && client.outstanding() == 0, "Pipelined responses in request order");
+    
+    RpcBatch batch;
+    TapeVolume added;
+    added.volser = "RPC002";
+    batch.get_volume("RPC001").get_volume("NOPE01").add_volume(added).volume_exists("RPC002");
+    auto items = client.call(batch);
+    TEST(items.is_success() && items.value().size() == 4 &&
+         items.value()[0].decode<TapeVolume>(RpcCodec::read_volume).value().volser == "RPC001" &&
+         items.value()[1].status == TMSError::VOLUME_NOT_FOUND && items.value()[2].is_success() &&
+         items.value()[3].decode<bool>([](RpcReader& r) { return r.get_bool(); }).value(),
+         "Batch items succeed or fail independently");
+    TEST(client.call(RpcOp::ALLOCATE_SCRATCH, [](RpcWriter& w) {
+        w.put_string("RPCPOOL");
+        w.put_le<uint8_t>(42);
+    }).value().status == TMSError::INVALID_FORMAT, "Unknown density filter rejected");
+    TEST(client.call(RpcOp::LIST_VOLUMES, [](RpcWriter& w) {
+        w.put_le<uint8_t>(42);
+        w.put_string("");
+        w.put_le<uint32_t>(0);
+    }).value().status == TMSError::INVALID_FORMAT, "Unknown status filter rejected");
+    
+    RpcClient tcp;
+    TEST(tcp.connect_tcp("127.0.0.1", static_cast<uint16_t>(server.tcp_port())).is_success() &&
+         tcp.volume_exists("RPC002").value_or(false), "Loopback TCP client");
+    
+    // Several clients share the catalog
+    std::vector<std::thread> clients;
+    std::atomic<int> failures{0};
+    for (int t = 0; t < 4; t++) {
+        clients.emplace_back([&, t] {
+            RpcClient c;
+            if (!c.connect_unix("test_rpc/tms.sock")) {
+                failures++;
+                return;
+            }
+            for (int i = 0; i < 50; i++) {
+                TapeVolume v;
+                v.volser = std::to_string(300000 + t * 100 + i);
+                if (!c.add_volume(v) || !c.volume_exists(v.volser).value_or(false)) failures++;
+            }
+        });
+    }
+    for (auto& c : clients) c.join();
+    TEST(failures.load() == 0 && sys.get_volume_count() == 202, "Concurrent clients");
+    
+    // Every record fits a frame, but together they would not
+    TapeVolume big;
+    big.volser = "RPCBIG";
+    big.notes.assign(64 * 1024, 'n');
+    sys.add_volume(big);
+    RpcBatch lists;
+    for (int i = 0; i < 300; i++) {
+        lists.add(RpcOp::GET_VOLUME, [](RpcWriter& w) { w.put_string("RPCBIG"); });
+    }
+    TEST(client.call(lists).error_code() == TMSError::INVALID_PARAMETER && client.ping().is_success(),
+         "Batch result held to one frame");
+    
+    // A client that pipelines faster than it is served stops being read until its backlog drains
+    RpcServer throttled(sys);
+    RpcServerOptions small;
+    small.socket_path = "test_rpc/small.sock";
+    small.workers = 1;
+    small.max_frame_bytes = 1024;
+    small.max_pending_bytes = 1024;
+    throttled.start(small);
+    RpcClient pipelined;
+    pipelined.connect_unix("test_rpc/small.sock");
+    std::vector<uint32_t> pipelined_ids;
+    for (int i = 0; i < 5000; i++) {
+        pipelined_ids.push_back(pipelined.enqueue(RpcOp::VOLUME_EXISTS, [](RpcWriter& w) { w.put_string("RPC001"); }));
+    }
+    bool answered = pipelined.flush().is_success();
+    for (size_t i = 0; i < pipelined_ids.size() && answered; i++) {
+        auto response = pipelined.receive();
+        answered = response.is_success() && response.value().id == pipelined_ids[i];
+    }
+    TEST(answered && throttled.stats().reads_paused > 0, "Reads paused under backpressure and resumed");
+    pipelined.close();
+    throttled.stop();
+    
+    // A frame shorter than its header drops the connection
+    int raw = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strcpy(addr.sun_path, "test_rpc/tms.sock");
+    bool dropped = false;
+    if (raw >= 0 && ::connect(raw, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0) {
+        const char bad[] = {2, 0, 0, 0, 0, 0};
+        [[maybe_unused]] ssize_t n = ::send(raw, bad, sizeof(bad), MSG_NOSIGNAL);
+        char buf[16];
+        dropped = ::recv(raw, buf, sizeof(buf), 0) == 0;
+    }
+    if (raw >= 0) ::close(raw);
+
+    // Requests sent before the client shuts its write side still run and are answered
+    raw = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    size_t answers = 0;
+    bool all_ok = true, closed_after = false;
+    if (raw >= 0 && ::connect(raw, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0) {
+        RpcWriter frames;
+        for (uint32_t i = 0; i < 20; i++) {
+            TapeVolume half;
+            half.volser = "HC" + std::to_string(1000 + i);
+            size_t at = frames.begin_frame(i + 1, RpcOp::ADD_VOLUME);
+            RpcCodec::write_volume(frames, half);
+            frames.end_frame(at);
+        }
+        [[maybe_unused]] ssize_t n = ::send(raw, frames.data().data(), frames.data().size(), MSG_NOSIGNAL);
+        ::shutdown(raw, SHUT_WR);
+        std::string replies;
+        char buf[4096];
+        ssize_t got;
+        while ((got = ::recv(raw, buf, sizeof(buf), 0)) > 0) replies.append(buf, static_cast<size_t>(got));
+        closed_after = got == 0;
+        for (size_t pos = 0, size; (size = rpc_frame_size(std::string_view(replies).substr(pos))) > 0 &&
+                                   size != RPC_BAD_FRAME; pos += size) {
+            RpcFrame frame = rpc_decode_frame(std::string_view(replies).substr(pos, size));
+            all_ok = all_ok && frame.id == ++answers && frame.status == TMSError::SUCCESS;
+        }
+    }
+    if (raw >= 0) ::close(raw);
+    TEST(closed_after && answers == 20 && all_ok && sys.volume_exists("HC1019"),
+         "Half-closed connection answered before closing");
+    raw = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (raw >= 0 && ::connect(raw, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0) {
+        RpcWriter frame;
+        TapeVolume gone;
+        gone.volser = "HC2000";
+        size_t at = frame.begin_frame(1, RpcOp::ADD_VOLUME);
+        RpcCodec::write_volume(frame, gone);
+        frame.end_frame(at);
+        [[maybe_unused]] ssize_t n = ::send(raw, frame.data().data(), frame.data().size(), MSG_NOSIGNAL);
+    }
+    if (raw >= 0) ::close(raw);
+    for (int i = 0; i < 200 && !sys.volume_exists("HC2000"); i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    TEST(sys.volume_exists("HC2000"), "Request sent before a hangup still runs");
+
+    auto stats = server.stats();
+    TEST(dropped && stats.protocol_errors == 1, "Malformed frame drops connection");
+    TEST(stats.batches == 2 && stats.requests >= 400 && stats.errors >= 3, "Server statistics");
+    
+    server.stop();
+    TEST(!server.is_running() && !fs::exists("test_rpc/tms.sock"), "Server stopped and socket removed");
+    TEST(!client.ping().is_success(), "Client sees closed connection");
+    cleanup("test_rpc");
+#endif
+}
+
+static Task<int> async_add(AsyncExecutor& executor, int a, int b) {
+    co_await executor.schedule();
+    co_return a + b;
+}
+
+static Task<int> async_fail() {
+    throw std::runtime_error("async failure");
+    co_return 0;
+}
+
+static Task<std::string> async_nap(AsyncExecutor& executor, std::string name) {
+    co_await executor.sleep_for(std::chrono::milliseconds(50));
+    co_return name;
+}
+
+void test_async_api() {
+    TEST_SECTION("Async API Tests");
+    
+    AsyncExecutorOptions options;
+    options.workers = 1;
+    options.io_threads = 1;
+    auto executor = std::make_shared<AsyncExecutor>(options);
+    TEST(sync_wait(async_add(*executor, 2, 3)) == 5, "Task result through sync_wait");
+    bool rethrown = false;
+    try {
+        sync_wait(async_fail());
+    } catch (const std::runtime_error&) {
+        rethrown = true;
+    }
+    TEST(rethrown, "Task exception rethrown to awaiter");
+    
+    // Three 50ms sleeps overlap on a single worker
+    auto start = std::chrono::steady_clock::now();
+    auto naps = [&]() -> Task<std::string> {
+        auto a = async_nap(*executor, "a");
+        auto b = async_nap(*executor, "b");
+        auto c = async_nap(*executor, "c");
+        std::atomic<int> done{0};
+        executor->spawn([](Task<std::string> t, std::atomic<int>& n) -> Task<void> {
+            co_await t;
+            n++;
+        }(std::move(b), done));
+        executor->spawn([](Task<std::string> t, std::atomic<int>& n) -> Task<void> {
+            co_await t;
+            n++;
+        }(std::move(c), done));
+        std::string first = co_await a;
+        while (done.load() < 2) co_await executor->sleep_for(std::chrono::milliseconds(5));
+        co_return first;
+    };
+    std::string first = sync_wait(naps());
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    TEST(first == "a" && elapsed.count() < 140, "Sleeps are timers, not blocked threads");
+    
+    int offloaded = sync_wait([&]() -> Task<int> {
+        co_return co_await executor->blocking([] { return 42; });
+    }());
+    TEST(offloaded == 42 && executor->stats().blocking_calls >= 1, "Blocking call runs on the I/O pool");
+    
+    cleanup("test_async");
+    fs::create_directories("test_async");
+    std::string payload(3 * 1024 * 1024 + 17, 'x');
+    payload[12345] = 'y';
+    auto io = [&]() -> Task<bool> {
+        auto written = co_await executor->write_file("test_async/blob.bin", payload);
+        auto read = co_await executor->read_file("test_async/blob.bin");
+        auto missing = co_await executor->read_file("test_async/none.bin");
+        co_return written.is_success() && read.is_success() && read.value() == payload &&
+                  missing.error_code() == TMSError::FILE_NOT_FOUND;
+    };
+    TEST(sync_wait(io()), "File round trip through " + executor->stats().io_backend);
+    TEST(executor->stats().file_bytes >= 2 * payload.size(), "File I/O counted");
+    
+    {
+        TMSSystem sys("test_async/catalog");
+        sys.set_executor(executor);
+        TEST(sys.get_executor() == executor, "System executor set");
+        for (int i = 0; i < 20; i++) {
+            TapeVolume v;
+            v.volser = std::to_string(100000 + i);
+            v.pool = "ASYNC";
+            sys.add_volume(v);
+        }
+        Dataset ds;
+        ds.name = "ASYNC.DATA.SET";
+        ds.volser = "100000";
+        sys.add_dataset(ds);
+        TEST(sync_wait(sys.mount_volume_async("100001")).is_success() &&
+             sys.get_volume("100001").value().status == VolumeStatus::MOUNTED, "mount_volume_async");
+        TEST(sync_wait(sys.dismount_volume_async("100001")).is_success(), "dismount_volume_async");
+        TEST(sync_wait(sys.save_catalog_async()).is_success(), "save_catalog_async");
+        TEST(sync_wait(sys.backup_catalog_async("test_async/backups")).is_success() &&
+             std::distance(fs::directory_iterator("test_async/backups"), fs::directory_iterator()) == 2,
+             "backup_catalog_async");
+        auto exported = sync_wait(sys.export_volumes_async("test_async/volumes.csv"));
+        TEST(exported.is_success() && exported.value().records == 20, "export_volumes_async");
+        
+        RetryPolicy policy;
+        policy.max_attempts = 3;
+        policy.initial_delay_ms = 20;
+        sys.set_retry_policy(policy);
+        int calls = 0;
+        auto retried = sync_wait(sys.retry_operation_async([&calls]() {
+            return ++calls < 3 ? OperationResult::err(TMSError::OPERATION_TIMEOUT, "busy") : OperationResult::ok();
+        }));
+        TEST(retried.success && retried.attempts_made == 3 && retried.total_delay_ms == 60 &&
+             retried.attempt_errors.size() == 2, "retry_operation_async succeeds after timed retries");
+        auto exhausted = sync_wait(sys.retry_operation_async([&sys]() { return sys.mount_volume_async("NOPE01"); }));
+        TEST(!exhausted.success && exhausted.attempts_made == 3, "retry_operation_async gives up");
+    }
+    {
+        TMSSystem reloaded("test_async/catalog");
+        reloaded.set_executor(executor);
+        TEST(sync_wait(reloaded.load_catalog_async()).is_success() && reloaded.get_volume_count() == 20 &&
+             reloaded.get_dataset_count() == 1, "load_catalog_async reads the async save");
+    }
+    TEST(executor->stats().timers >= 5 && executor->stats().resumptions > 0, "Executor statistics");
+    executor.reset();
+    cleanup("test_async");
+}
+
+void test_operation_context() {
+    TEST_SECTION("Operation Context Tests");
+    cleanup("test_ctx");
+    
+    TMSSystem sys("test_ctx");
+    TEST(current_operation_context() == nullptr && sys.get_current_user() == "SYSTEM", "No context by default");
+    ChangeLogOptions cdc;
+    cdc.flush_interval = std::chrono::milliseconds(1);
+    sys.enable_change_stream(cdc);
+    std::vector<ChangeRecord> changes;
+    sys.get_change_stream()->subscribe("", [&](const std::vector<ChangeRecord>& batch) {
+        changes.insert(changes.end(), batch.begin(), batch.end());
+    });
+    
+    // Concurrent callers each see only their own identity
+    std::atomic<int> mismatches{0};
+    auto caller = [&](const std::string& user, const std::string& prefix) {
+        OperationContext ctx = OperationContext::for_user(user, user + "-S");
+        ctx.source = "test";
+        for (int i = 0; i < 50; i++) {
+            ctx.request_id = std::to_string(i);
+            OperationScope scope(ctx);
+            if (sys.get_current_user() != user) mismatches++;
+            TapeVolume v;
+            v.volser = prefix + std::to_string(100 + i);
+            sys.add_volume(v);
+        }
+    };
+    std::thread alice(caller, "ALICE", "CTA");
+    std::thread bob(caller, "BOB", "CTB");
+    sys.set_current_user("ADMIN");
+    alice.join();
+    bob.join();
+    TEST(mismatches == 0 && sys.get_current_user() == "ADMIN", "Scopes isolate concurrent callers");
+    int attributed = 0;
+    int misattributed = 0;
+    for (const auto& r : sys.get_audit_log(1000)) {
+        if (r.target.rfind("CTA", 0) == 0 || r.target.rfind("CTB", 0) == 0) {
+            std::string expected = r.target[2] == 'A' ? "ALICE" : "BOB";
+            bool ok = r.user == expected && r.session_id == expected + "-S" && r.source_ip == "test" &&
+                      r.target == r.target.substr(0, 3) + std::to_string(100 + std::stoi(r.request_id));
+            (ok ? attributed : misattributed)++;
+        }
+    }
+    TEST(attributed == 100 && misattributed == 0, "Audit records carry each caller's context");
+    
+    {
+        OperationScope outer(OperationContext::for_user("OUTER"));
+        {
+            OperationScope inner(std::make_shared<const OperationContext>(OperationContext::for_user("INNER")));
+            TEST(sys.get_current_user() == "INNER", "Inner scope wins");
+        }
+        TEST(sys.get_current_user() == "OUTER", "Scope restores the enclosing context");
+    }
+    TEST(current_operation_context() == nullptr, "Scope cleared on exit");
+    
+    sys.get_change_stream()->flush();
+    auto change = std::find_if(changes.begin(), changes.end(),
+                               [](const ChangeRecord& r) { return r.key == "CTB107"; });
+    TEST(change != changes.end() && change->user == "BOB" && change->session_id == "BOB-S" &&
+         change->request_id == "7", "Change records carry the context");
+    auto stored = change != changes.end() ? sys.get_change_stream()->read(change->sequence, 1)
+                                          : std::vector<ChangeRecord>{};
+    TEST(stored.size() == 1 && stored[0].user == "BOB" && stored[0].session_id == "BOB-S" &&
+         stored[0].request_id == "7", "Context survives the change log encoding");
+    
+    // Retries stop rather than sleep past the caller's deadline
+    RetryPolicy policy;
+    policy.max_attempts = 5;
+    policy.initial_delay_ms = 100;
+    policy.backoff_multiplier = 1.0;
+    sys.set_retry_policy(policy);
+    {
+        OperationContext ctx;
+        ctx.with_timeout(std::chrono::milliseconds(250));
+        OperationScope scope(ctx);
+        auto start = std::chrono::steady_clock::now();
+        auto result = sys.retry_operation([] { return OperationResult::err(TMSError::OPERATION_TIMEOUT, "busy"); });
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        TEST(!result.success && result.deadline_exceeded && result.attempts_made == 3 &&
+             elapsed < std::chrono::milliseconds(250), "Retry gives up at the deadline");
+    }
+    
+    // Context follows a coroutine across executor threads
+    AsyncExecutorOptions options;
+    options.workers = 1;
+    options.io_threads = 1;
+    AsyncExecutor executor(options);
+    auto identity = [&]() -> Task<std::string> {
+        co_await executor.sleep_for(std::chrono::milliseconds(5));
+        std::string after_sleep = sys.get_current_user();
+        std::string in_blocking = co_await executor.blocking([&sys] { return sys.get_current_user(); });
+        co_return after_sleep + "/" + in_blocking;
+    };
+    std::string seen;
+    {
+        OperationScope scope(OperationContext::for_user("CAROL"));
+        seen = sync_wait(identity());
+    }
+    TEST(seen == "CAROL/CAROL", "Context propagates through sleep_for and blocking");
+
+#if TMS_HAS_RPC
+    RpcServer server(sys);
+    RpcServerOptions rpc_options;
+    rpc_options.socket_path = "test_ctx/tms.sock";
+    rpc_options.workers = 1;
+    server.start(rpc_options);
+    RpcClient client;
+    client.connect_unix("test_ctx/tms.sock");
+    auto session = client.set_session("DAVE", std::chrono::milliseconds(5000));
+    TapeVolume remote;
+    remote.volser = "CTR001";
+    TEST(session.is_success() && session.value().rfind("rpc-", 0) == 0 &&
+         client.add_volume(remote).is_success(), "RPC session opened");
+    auto remote_audit = sys.get_audit_log(1).front();
+    TEST(remote_audit.target == "CTR001" && remote_audit.user == "DAVE" &&
+         remote_audit.session_id == session.value() && remote_audit.source_ip == "unix" &&
+         !remote_audit.request_id.empty(), "RPC requests attributed to the session");
+    TEST(server.stats().deadline_expired == 0, "No request outlived its deadline");
+    client.close();
+    server.stop();
+    
+    // Frames queued behind a slow one are each timed from their own arrival
+    RpcServer slow(sys);
+    rpc_options.socket_path = "test_ctx/slow.sock";
+    slow.start(rpc_options);
+    RpcClient patient;
+    patient.connect_unix("test_ctx/slow.sock");
+    patient.set_session("ERIN", std::chrono::milliseconds(400));
+    std::atomic<bool> holding{false};
+    std::thread writer([&] {
+        // Holds the write lock for 600ms from inside the reject callback
+        std::vector<TapeVolume> duplicate(1);
+        duplicate[0].volser = "CTR001";
+        sys.bulk_add_volumes(duplicate, [&](size_t, const std::string&) {
+            holding = true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(600));
+        });
+    });
+    while (!holding) std::this_thread::yield();
+    TapeVolume queued;
+    queued.volser = "CTR002";
+    auto exists = [](RpcWriter& w) { w.put_string("CTR001"); };
+    patient.enqueue(RpcOp::ADD_VOLUME, [&queued](RpcWriter& w) { RpcCodec::write_volume(w, queued); });
+    patient.flush();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    patient.enqueue(RpcOp::VOLUME_EXISTS, exists);
+    patient.flush();
+    std::this_thread::sleep_for(std::chrono::milliseconds(480));
+    patient.enqueue(RpcOp::VOLUME_EXISTS, exists);
+    patient.flush();
+    auto slow_add = patient.receive();
+    auto stale = patient.receive();
+    auto fresh = patient.receive();
+    writer.join();
+    TEST(slow_add.is_success() && slow_add.value().is_success() &&
+         stale.is_success() && stale.value().status == TMSError::OPERATION_TIMEOUT &&
+         fresh.is_success() && fresh.value().is_success(), "Queued frames keep their own deadlines");
+    patient.close();
+    slow.stop();
+#endif
+    
+    sys.disable_change_stream();
+    cleanup("test_ctx");
+}
+
+void test_replication() {
+    TEST_SECTION("Replication Tests");
+    
+    ChangeRecord change;
+    change.sequence = 42;
+    change.entity = ChangeEntity::DATASET;
+    change.operation = ChangeOperation::DELETE;
+    change.event = EventType::DATASET_DELETED;
+    change.key = "REPL.GONE";
+    change.user = "ERIN";
+    RpcWriter writer;
+    ReplicationCodec::write_change(writer, change);
+    RpcReader reader(writer.data());
+    ChangeRecord decoded = ReplicationCodec::read_change(reader);
+    TEST(reader.ok() && reader.at_end() && decoded.sequence == 42 && decoded.key == "REPL.GONE" &&
+         decoded.operation == ChangeOperation::DELETE && !decoded.volume && !decoded.dataset &&
+         decoded.user == "ERIN", "Change record codec round trip");
+
+#if TMS_HAS_RPC
+    cleanup("test_repl_p");
+    cleanup("test_repl_f");
+    TMSSystem primary("test_repl_p");
+    ChangeLogOptions cdc;
+    cdc.flush_interval = std::chrono::milliseconds(1);
+    primary.enable_change_stream(cdc);
+    for (int i = 0; i < 3; i++) {
+        TapeVolume vol;
+        vol.volser = "REP00" + std::to_string(i);
+        vol.status = VolumeStatus::SCRATCH;
+        vol.pool = "REPL";
+        primary.add_volume(vol);
+    }
+    
+    // Server-kept state the client codec leaves out still has to reach the follower
+    auto add_full = [&](const std::string& volser, const std::string& dataset) {
+        TapeVolume vol;
+        vol.volser = volser;
+        vol.error_count = 4;
+        vol.read_error_count = 3;
+        vol.write_error_count = 2;
+        vol.last_access_date = parse_time("2030-02-03 04:05:06");
+        vol.encryption.encrypted = true;
+        vol.encryption.algorithm = EncryptionAlgorithm::AES_256;
+        vol.encryption.key_id = "KEY-" + volser;
+        vol.encryption.encrypted_by = "ERIN";
+        primary.add_volume(vol);
+        primary.update_volume_location(volser, "VAULT");
+        Dataset full;
+        full.name = dataset;
+        full.volser = volser;
+        full.size_bytes = 1000;
+        full.compressed = true;
+        full.compression_type = "ZSTD";
+        full.original_size_bytes = 4000;
+        full.access_count = 9;
+        primary.add_dataset(full);
+    };
+    ReplicationPrimary shipper(primary);
+    ReplicationPrimaryOptions ship;
+    ship.socket_path = "test_repl_p/repl.sock";
+    ship.heartbeat = std::chrono::milliseconds(20);
+    TEST(shipper.start(ship).is_success() && shipper.log_id().size() == 16, "Primary ships its change log");
+    
+    TMSSystem standby("test_repl_f");
+    add_full("REP005", "REPL.SNAP");
+    // Times cross the wire in microseconds
+    auto same_time = [](std::chrono::system_clock::time_point a, std::chrono::system_clock::time_point b) {
+        return std::chrono::floor<std::chrono::microseconds>(a) == std::chrono::floor<std::chrono::microseconds>(b);
+    };
+    auto same_state = [&](const std::string& volser, const std::string& dataset) {
+        auto a = primary.get_volume(volser);
+        auto b = standby.get_volume(volser);
+        auto c = primary.get_dataset(dataset);
+        auto d = standby.get_dataset(dataset);
+        if (!a || !b || !c || !d) return false;
+        const TapeVolume& p = a.value();
+        const TapeVolume& f = b.value();
+        const Dataset& pd = c.value();
+        const Dataset& fd = d.value();
+        return f.location_history.size() == 1 && f.location_history[0].moved_by == p.location_history[0].moved_by &&
+               same_time(f.location_history[0].timestamp, p.location_history[0].timestamp) &&
+               f.health_score.overall_score == p.health_score.overall_score && p.health_score.overall_score < 100.0 &&
+               f.health_score.status == p.health_score.status &&
+               f.health_score.recommendations == p.health_score.recommendations &&
+               f.encryption.is_encrypted() && f.encryption.algorithm == EncryptionAlgorithm::AES_256 &&
+               f.encryption.key_id == "KEY-" + volser && f.encryption.encrypted_by == "ERIN" &&
+               f.last_access_date == p.last_access_date && same_time(f.last_health_check, p.last_health_check) &&
+               f.read_error_count == 3 && f.write_error_count == 2 &&
+               fd.compressed && fd.compression_type == "ZSTD" && fd.original_size_bytes == 4000 && fd.access_count == 9 &&
+               pd.access_count == fd.access_count;
+    };
+    RpcServer server(standby);
+    RpcServerOptions rpc_options;
+    rpc_options.socket_path = "test_repl_f/tms.sock";
+    rpc_options.workers = 1;
+    ReplicationFollower follower(standby);
+    follower.attach(server);
+    server.start(rpc_options);
+    ReplicationFollowerOptions follow;
+    follow.primary_socket = ship.socket_path;
+    follow.retry_interval = std::chrono::milliseconds(50);
+    TEST(follower.start(follow).is_success(), "Follower started");
+    
+    auto primary_last = [&] { return primary.get_change_stream()->last_sequence(); };
+    TEST(follower.wait_for(primary_last(), std::chrono::seconds(5)) &&
+         standby.volume_exists("REP002") && follower.status().snapshots == 1, "Follower seeded from a snapshot");
+    TEST(same_state("REP005", "REPL.SNAP"), "Snapshot carries whole records");
+    
+    // Live changes arrive in commit order
+    primary.add_volume_tag("REP000", "offsite");
+    primary.mount_volume("REP001");
+    Dataset ds;
+    ds.name = "REPL.DATA";
+    ds.volser = "REP001";
+    ds.owner = "REPLUSER";
+    primary.add_dataset(ds);
+    primary.delete_volume("REP002");
+    TEST(follower.wait_for(primary_last(), std::chrono::seconds(5)), "Follower caught up");
+    auto tagged = standby.find_volumes_by_tag("offsite");
+    TEST(tagged.size() == 1 && tagged[0].volser == "REP000", "Tag index maintained on the follower");
+    TEST(standby.get_volume("REP001").value().status == primary.get_volume("REP001").value().status &&
+         standby.dataset_exists("REPL.DATA") && !standby.volume_exists("REP002"), "Updates, inserts and deletes applied");
+    add_full("REP006", "REPL.LIVE");
+    TEST(follower.wait_for(primary_last(), std::chrono::seconds(5)) && same_state("REP006", "REPL.LIVE"),
+         "Changes carry whole records");
+    
+    // Read back from a segment, as for a follower catching up, the record is still whole
+    primary.get_change_stream()->flush();
+    auto logged = primary.get_change_stream()->read(primary_last() - 3, 4);
+    auto last_for = [&](const std::string& key) {
+        auto it = std::find_if(logged.rbegin(), logged.rend(), [&](const ChangeRecord& r) { return r.key == key; });
+        return it != logged.rend() ? *it : ChangeRecord{};
+    };
+    ChangeRecord logged_ds = last_for("REPL.LIVE");
+    ChangeRecord logged_vol = last_for("REP006");
+    TEST(logged_ds.dataset && logged_ds.dataset->compression_type == "ZSTD" &&
+         logged_ds.dataset->original_size_bytes == 4000 && logged_ds.dataset->access_count == 9,
+         "Change log keeps whole records");
+    TEST(logged_vol.volume && logged_vol.volume->location_history.size() == 1 &&
+         logged_vol.volume->encryption.key_id == "KEY-REP006" && logged_vol.volume->read_error_count == 3 &&
+         logged_vol.volume->health_score.overall_score == primary.get_volume("REP006").value().health_score.overall_score,
+         "Change log keeps server-kept volume state");
+    
+    RpcClient client;
+    client.connect_unix("test_repl_f/tms.sock");
+    TapeVolume rejected;
+    rejected.volser = "REP100";
+    TEST(client.add_volume(rejected).error_code() == TMSError::INVALID_STATE &&
+         client.get_volume("REP000").is_success(), "Follower serves reads and rejects writes");
+    auto remote = get_replication_status(client);
+    TEST(remote.is_success() && remote.value().role == ReplicationRole::FOLLOWER && remote.value().connected &&
+         remote.value().log_id == shipper.log_id() && remote.value().lag_records == 0 &&
+         remote.value().records_applied >= 5, "Replication status reports lag");
+    TEST(shipper.status().followers == 1, "Primary counts its follower");
+    
+    // A restarted follower resumes from the log rather than a new snapshot
+    follower.stop();
+    TapeVolume later;
+    later.volser = "REP010";
+    primary.add_volume(later);
+    follower.start(follow);
+    TEST(follower.wait_for(primary_last(), std::chrono::seconds(5)) && standby.volume_exists("REP010") &&
+         follower.status().snapshots == 1, "Follower resumes from its last applied change");
+    
+    // A reload replaces the catalog without per-record changes, so the follower starts over
+    TEST(primary.save_catalog().is_success(), "Primary catalog saved");
+    TapeVolume unsaved;
+    unsaved.volser = "REP011";
+    primary.add_volume(unsaved);
+    TEST(follower.wait_for(primary_last(), std::chrono::seconds(5)) && standby.volume_exists("REP011"),
+         "Unsaved volume replicated");
+    primary.load_catalog();
+    primary.get_change_stream()->flush();
+    auto marker = primary.get_change_stream()->read(primary_last(), 1);
+    TEST(marker.size() == 1 && marker[0].operation == ChangeOperation::RESYNC &&
+         marker[0].entity == ChangeEntity::CATALOG, "Reload writes a resync marker");
+    TEST(follower.wait_for(primary_last(), std::chrono::seconds(5)) && !standby.volume_exists("REP011") &&
+         standby.volume_exists("REP010") && follower.status().snapshots == 2, "Follower resyncs after a reload");
+    
+    TEST(promote_replica(client).is_success() && follower.is_promoted() &&
+         client.add_volume(rejected).is_success() && standby.volume_exists("REP100"), "Promotion accepts writes");
+    TEST(get_replication_status(client).value().role == ReplicationRole::PRIMARY, "Promoted node reports PRIMARY");
+    
+    client.close();
+    server.stop();
+    shipper.stop();
+    primary.disable_change_stream();
+    cleanup("test_repl_p");
+    cleanup("test_repl_f");
+#endif
+}
+
+void test_partitioned_catalog() {
+    TEST_SECTION("Partitioned Catalog Tests");
+    
+    auto parsed = PartitionMap::parse("p0.sock, m=p1.sock ,T=p2.sock");
+    TEST(parsed.is_success() && parsed.value().size() == 3 && parsed.value().to_string() == "p0.sock,M=p1.sock,T=p2.sock",
+         "Partition map parsed");
+    const PartitionMap& ranges = parsed.value();
+    TEST(ranges.owner_of("A00001") == 0 && ranges.owner_of("M00000") == 1 && ranges.owner_of("SZZZZZ") == 1 &&
+         ranges.owner_of("T") == 2 && ranges.owner_of("Z99999") == 2, "Volsers map to their ranges");
+    TEST(!PartitionMap::parse("a.sock,T=b.sock,M=c.sock") && !PartitionMap::parse("A=a.sock") &&
+         !PartitionMap::parse("a.sock,b.sock") && !PartitionMap::parse(""), "Bad partition maps rejected");
+
+#if TMS_HAS_RPC
+    std::vector<std::unique_ptr<TMSSystem>> partitions;
+    std::vector<std::unique_ptr<RpcServer>> servers;
+    for (int i = 0; i < 3; i++) {
+        std::string dir = "test_part" + std::to_string(i);
+        cleanup(dir);
+        partitions.push_back(std::make_unique<TMSSystem>(dir));
+        servers.push_back(std::make_unique<RpcServer>(*partitions.back()));
+        RpcServerOptions options;
+        options.socket_path = dir + "/tms.sock";
+        options.workers = 1;
+        servers.back()->start(options);
+    }
+    PartitionRouter router(PartitionMap::parse("test_part0/tms.sock,J=test_part1/tms.sock,S=test_part2/tms.sock").value());
+    
+    bool added = true;
+    int n = 0;
+    for (char prefix : std::string("ABJKSZ")) {
+        for (int i = 0; i < 3; i++, n++) {
+            TapeVolume vol;
+            vol.volser = std::string(1, prefix) + "0000" + std::to_string(i);
+            vol.status = VolumeStatus::SCRATCH;
+            vol.pool = "PART";
+            vol.mount_count = (n * 7) % 11;
+            added = router.add_volume(vol).is_success() && added;
+        }
+    }
+    TEST(added && partitions[0]->get_volume_count() == 6 && partitions[1]->get_volume_count() == 6 &&
+         partitions[2]->get_volume_count() == 6, "Volumes land on their owning partition");
+    TEST(router.mount_volume("K00001").is_success() &&
+         partitions[1]->get_volume("K00001").value().status == VolumeStatus::MOUNTED &&
+         router.get_volume("Z00002").value().volser == "Z00002" &&
+         router.get_volume("Q00000").error_code() == TMSError::VOLUME_NOT_FOUND, "Point operations routed");
+    
+    Dataset ds;
+    ds.name = "PART.DATA.ONE";
+    ds.volser = "S00000";
+    TEST(router.add_dataset(ds).is_success() && partitions[2]->dataset_exists("PART.DATA.ONE") &&
+         router.get_dataset("PART.DATA.ONE").value().volser == "S00000", "Dataset stored beside its volume");
+    ds.volser = "A00000";
+    TEST(router.add_dataset(ds).error_code() == TMSError::DATASET_ALREADY_EXISTS &&
+         !partitions[0]->dataset_exists("PART.DATA.ONE"), "Dataset names stay unique across partitions");
+    ds.name = "PART.DATA.TWO";
+    router.add_dataset(ds);
+    auto datasets = router.query_datasets("name:starts:PART");
+    TEST(datasets.is_success() && datasets.value().size() == 2 && datasets.value()[0].name == "PART.DATA.ONE",
+         "Dataset query merged by name");
+    TEST(router.delete_dataset("PART.DATA.ONE").is_success() && router.dataset_exists("PART.DATA.ONE").is_success() &&
+         !router.dataset_exists("PART.DATA.ONE").value() &&
+         router.get_dataset("PART.DATA.ONE").error_code() == TMSError::DATASET_NOT_FOUND, "Dataset deleted where held");
+    
+    // A dataset's partition is remembered; a stale entry falls back to asking all
+    uint64_t frames1 = servers[1]->stats().frames, frames2 = servers[2]->stats().frames;
+    TEST(router.get_dataset("PART.DATA.TWO").is_success() && router.dataset_exists("PART.DATA.TWO").value() &&
+         servers[1]->stats().frames == frames1 && servers[2]->stats().frames == frames2,
+         "Dataset lookups go to the cached holder only");
+    Dataset moved = partitions[0]->get_dataset("PART.DATA.TWO").value();
+    partitions[0]->delete_dataset("PART.DATA.TWO");
+    moved.volser = "S00001";
+    partitions[2]->add_dataset(moved);
+    TEST(router.get_dataset("PART.DATA.TWO").value().volser == "S00001" &&
+         router.patch_dataset("PART.DATA.TWO", DatasetPatch{}).is_success(), "Stale cached holder refreshed");
+    
+    // Routed requests act for the caller
+    {
+        OperationScope scope(OperationContext::for_user("dave", "sess-dave"));
+        router.mount_volume("B00001");
+    }
+    auto audited = partitions[0]->get_audit_log(1);
+    TEST(!audited.empty() && audited.back().user == "dave" && audited.back().session_id == "sess-dave",
+         "Partition audits the caller's user and session");
+    router.dismount_volume("B00001");
+    audited = partitions[0]->get_audit_log(1);
+    TEST(!audited.empty() && audited.back().user == partitions[0]->get_current_user() &&
+         audited.back().session_id != "sess-dave", "Pooled connection does not keep an earlier caller");
+    {
+        OperationContext late = OperationContext::for_user("dave");
+        late.deadline = OperationContext::Clock::now() - std::chrono::milliseconds(1);
+        OperationScope scope(late);
+        TEST(router.get_volume("A00000").error_code() == TMSError::OPERATION_TIMEOUT &&
+             router.list_volumes().error_code() == TMSError::OPERATION_TIMEOUT, "Expired caller not routed");
+    }
+    
+    // Scatter-gather: merged order, paging and top K
+    auto all = router.list_volumes();
+    TEST(all.is_success() && all.value().size() == 18 &&
+         std::is_sorted(all.value().begin(), all.value().end(),
+                        [](const TapeVolume& a, const TapeVolume& b) { return a.volser < b.volser; }),
+         "List merged in volser order");
+    std::vector<std::string> paged;
+    std::string after;
+    while (true) {
+        auto page = router.list_volumes(std::nullopt, after, 5);
+        if (!page || page.value().empty()) break;
+        for (const auto& vol : page.value()) paged.push_back(vol.volser);
+        after = paged.back();
+    }
+    TEST(paged.size() == 18 && paged.front() == "A00000" && paged.back() == "Z00002", "Paging crosses partitions");
+    
+    auto expected = all.value();
+    std::sort(expected.begin(), expected.end(), [](const TapeVolume& a, const TapeVolume& b) {
+        return volume_order_before(a, b, VolumeOrder::MOUNT_COUNT, true);
+    });
+    auto top = router.query_volumes("pool:eq:PART", VolumeOrder::MOUNT_COUNT, true, 4);
+    TEST(top.is_success() && top.value().size() == 4 && top.value()[0].volser == expected[0].volser &&
+         top.value()[3].volser == expected[3].volser, "Top K by mount count across partitions");
+    SearchCriteria criteria;
+    criteria.pool = "PART";
+    criteria.limit = 4;
+    auto found = router.search_volumes(criteria);
+    TEST(found.is_success() && found.value().size() == 4 && found.value()[3].volser == "B00000", "Search limited after merging");
+    auto stats = router.get_statistics();
+    TEST(stats.is_success() && stats.value().total_volumes == 18 && stats.value().mounted_volumes == 1 &&
+         stats.value().pool_counts["PART"] == 18, "Statistics summed over partitions");
+    
+    // The router behind an ordinary RPC server
+    cleanup("test_part_router");
+    TMSSystem front("test_part_router");
+    RpcServer router_server(front);
+    router.attach(router_server);
+    RpcServerOptions options;
+    options.socket_path = "test_part_router/tms.sock";
+    options.workers = 2;
+    router_server.start(options);
+    RpcClient client;
+    client.connect_unix("test_part_router/tms.sock");
+    TapeVolume remote;
+    remote.volser = "T00009";
+    TEST(client.add_volume(remote).is_success() && partitions[2]->volume_exists("T00009") &&
+         front.get_volume_count() == 0, "RPC clients reach partitions through the router");
+    auto session = client.set_session("carol", std::chrono::milliseconds(5000));
+    remote.volser = "T00010";
+    client.add_volume(remote);
+    audited = partitions[2]->get_audit_log(1);
+    TEST(session.is_success() && !audited.empty() && audited.back().user == "carol" &&
+         audited.back().session_id == session.value(), "Router forwards the client's session");
+    auto remote_top = client.query_volumes("", VolumeOrder::MOUNT_COUNT, true, 1);
+    TEST(client.list_volumes().value().size() == 20 && remote_top.is_success() &&
+         remote_top.value()[0].volser == expected[0].volser && client.get_statistics().value().total_volumes == 20,
+         "Routed list, query and statistics");
+    
+    // An unreachable partition fails only the calls that need it
+    servers[1]->stop();
+    auto lost = router.get_volume("K00001");
+    TEST(lost.is_error() && lost.error().message.find("Partition 1") != std::string::npos &&
+         router.list_volumes().is_error() && router.get_volume("A00000").is_success(), "Partition outage reported");
+    
+    client.close();
+    router_server.stop();
+    for (auto& server : servers) server->stop();
+    cleanup("test_part_router");
+    for (int i = 0; i < 3; i++) cleanup("test_part" + std::to_string(i));
+#endif
+}